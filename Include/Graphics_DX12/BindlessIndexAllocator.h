@@ -0,0 +1,142 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Bindless descriptor index allocator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_BINDLESS_INDEX_ALLOCATOR
+#define M_BINDLESS_INDEX_ALLOCATOR
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// バインドレスディスクリプタを指すハンドル
+    /// Generationが0のハンドルは無効
+    struct BindlessHandle final
+    {
+      uint32_t Index;
+      uint32_t Generation;
+
+      static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+      constexpr BindlessHandle()
+        : Index(INVALID_INDEX)
+        , Generation(0)
+      { }
+
+      constexpr BindlessHandle(uint32_t index, uint32_t generation)
+        : Index(index)
+        , Generation(generation)
+      { }
+
+      bool IsValid(void) const;
+    };
+
+    inline bool BindlessHandle::IsValid() const
+    {
+      return (Index != INVALID_INDEX) && (Generation != 0);
+    }
+
+    inline bool operator==(const BindlessHandle& lhs, const BindlessHandle& rhs)
+    {
+      return (lhs.Index == rhs.Index) && (lhs.Generation == rhs.Generation);
+    }
+
+    inline bool operator!=(const BindlessHandle& lhs, const BindlessHandle& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+    /// @brief
+    /// ディスクリプタヒープのインデックスを払い出すアロケーター
+    /// 解放時に世代カウンターを進めるため、解放済みハンドルの使用を検出できる
+    /// GPUが参照している可能性のあるインデックスはフェンス値が完了するまで再利用しない
+    class BindlessIndexAllocator final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(BindlessIndexAllocator)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param capacity 払い出せるインデックスの最大数
+        /// @return 成功したらtrue
+        bool Init(uint32_t capacity);
+
+        /// @brief
+        /// 空いているインデックスを一つ払い出す(小さいインデックスから順に)
+        /// @return 空きがない場合は無効なハンドル
+        BindlessHandle Allocate(void);
+
+        /// @brief
+        /// ハンドルを解放する
+        /// 世代はすぐ進めるが、インデックスはretireFenceValueが完了するまで再利用しない
+        /// @param handle 解放するハンドル
+        /// @param retireFenceValue GPUがこのインデックスを最後に使うフェンス値(0なら即時再利用)
+        /// @return ハンドルが生きていて解放できたらtrue
+        bool Free(BindlessHandle handle, uint64_t retireFenceValue = 0);
+
+        /// @brief
+        /// 完了したフェンス値までに解放待ちのインデックスを再利用可能にする
+        /// @param completedFenceValue GPUが完了したフェンス値
+        void ReleaseRetired(uint64_t completedFenceValue);
+
+        /// @brief
+        /// ハンドルがまだ生きているか(世代が一致しているか)を調べる
+        bool IsAlive(BindlessHandle handle) const;
+
+        uint32_t GetCapacity(void) const;
+        uint32_t GetAliveCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct RetiredIndex
+        {
+          uint32_t Index;
+          uint64_t FenceValue;
+        };
+
+      private:
+        std::vector<uint32_t> m_generations;
+        std::vector<uint8_t> m_aliveFlags;
+        std::vector<uint32_t> m_freeIndices;
+        std::vector<RetiredIndex> m_retiredIndices;
+        uint32_t m_capacity;
+        uint32_t m_aliveCount;
+        mutable std::mutex m_mutex;
+    };
+
+    inline uint32_t BindlessIndexAllocator::GetCapacity() const
+    {
+      return m_capacity;
+    }
+
+    inline uint32_t BindlessIndexAllocator::GetAliveCount() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_aliveCount;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,101 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Bindless resource table (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_BINDLESS_RESOURCE_TABLE
+#define M_DX12_BINDLESS_RESOURCE_TABLE
+
+#include "GraphicsClassBaseInclude.h"
+
+#include <Graphics_DX12/DescriptorHeap.h>
+#include <Graphics_DX12/BindlessIndexAllocator.h>
+
+struct ID3D12Device;
+struct ID3D12Resource;
+struct ID3D12GraphicsCommandList;
+
+struct D3D12_SHADER_RESOURCE_VIEW_DESC;
+struct D3D12_CONSTANT_BUFFER_VIEW_DESC;
+struct D3D12_UNORDERED_ACCESS_VIEW_DESC;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// SRV/CBV/UAVをすべて一つの大きなシェーダーから見えるヒープに置き、
+    /// テクスチャやバッファーに安定したインデックスを払い出すテーブル
+    /// ヒープはフレームに一回だけセットすればよい
+    class BindlessResourceTable final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(BindlessResourceTable)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param device デバイス
+        /// @param numDesc ヒープに置けるディスクリプタの最大数
+        bool Init(ID3D12Device* device, size_t numDesc);
+
+        /// @brief
+        /// ビューを作らずにスロットだけ確保する(既存のCreate(..., DescriptorHandle, ...)に渡す用)
+        BindlessHandle Allocate(void);
+        BindlessHandle CreateShaderResourceView(ID3D12Resource*, const D3D12_SHADER_RESOURCE_VIEW_DESC*);
+        BindlessHandle CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC*);
+        BindlessHandle CreateUnorderedAccessView(ID3D12Resource*, ID3D12Resource* counter, const D3D12_UNORDERED_ACCESS_VIEW_DESC*);
+
+        /// @brief
+        /// スロットを解放する
+        /// @param handle 解放するハンドル
+        /// @param retireFenceValue GPUが最後に参照するフェンス値(0なら即時再利用)
+        void Release(BindlessHandle handle, UINT64 retireFenceValue = 0);
+        void ReleaseRetired(UINT64 completedFenceValue);
+
+        /// @brief
+        /// ハンドルが指すディスクリプタを取得する
+        /// 解放済みのハンドルの場合は空のハンドルを返す
+        DescriptorHandle GetHandle(BindlessHandle handle) const;
+        bool IsAlive(BindlessHandle handle) const;
+
+        /// @brief
+        /// ヒープをコマンドリストにセットする(フレームに一回)
+        void Bind(ID3D12GraphicsCommandList*) const;
+
+        ID3D12DescriptorHeap* GetHeap(void) const;
+        GPUDescHandle GetTableStart(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        DescriptorHeap m_heap;
+        BindlessIndexAllocator m_allocator;
+        ID3D12Device* m_device;
+    };
+
+    inline ID3D12DescriptorHeap* BindlessResourceTable::GetHeap() const
+    {
+      return m_heap.Get();
+    }
+
+    inline bool BindlessResourceTable::IsAlive(BindlessHandle handle) const
+    {
+      return m_allocator.IsAlive(handle);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Ordered command list batch (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_COMMAND_BATCH
+#define M_COMMAND_BATCH
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <vector>
+#include <mutex>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    class CommandList;
+
+    /// @brief
+    /// 複数スレッドで記録したコマンドリストを、呼び出し側が決めた順番で一回にまとめてサブミットするためのバッチ
+    /// 追加順ではなくorderの昇順で実行される(同じorderは追加順)
+    class CommandBatch final
+    {
+      GENERATE_CLASS_NO_COPY(CommandBatch)
+
+      public:
+        struct Entry
+        {
+          uint32_t Order;
+          uint32_t Sequence;
+          CommandList* List;
+        };
+
+      public:
+        /// @brief
+        /// コマンドリストを追加する(スレッドセーフ)
+        /// @param order 実行順(小さいほど先)
+        /// @param list クローズ済みのコマンドリスト
+        void Add(uint32_t order, CommandList* list);
+
+        /// @brief
+        /// 実行順に並べた結果を取得する
+        const std::vector<Entry>& Sort(void);
+
+        void Clear(void);
+        size_t GetCount(void) const;
+
+      private:
+        std::vector<Entry> m_entries;
+        uint32_t m_sequence;
+        mutable std::mutex m_mutex;
+    };
+  }
+}
+
+#endif
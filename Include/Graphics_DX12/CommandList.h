@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : DirectX12 CommandList Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/06 Create
+                2026/10/19 Add resource state tracking and batched barriers
+                2026/10/19 Flush barriers before draws, dispatches and copies
 
 Version : alpha_1.0.0
 
@@ -19,14 +21,10 @@ Encoding : UTF-8
 #define M_DX12_COMMANDLIST
 
 #include "GraphicsClassBaseInclude.h"
-#include <vector>
-
-struct ID3D12Device;
-struct ID3D12GraphicsCommandList;
-struct ID3D12CommandAllocator;
-struct ID3D12PipelineState;
+#include <Graphics_DX12/ResourceStateTracker.h>
 
-enum D3D12_COMMAND_LIST_TYPE;
+#include <d3d12.h>
+#include <vector>
 
 namespace MFramework
 {
@@ -37,29 +35,80 @@ namespace MFramework
       GENERATE_CLASS_NO_COPY(CommandList)
 
       public:
-        void Init(ID3D12Device*, D3D12_COMMAND_LIST_TYPE, size_t);
+        void Init(ID3D12Device*, D3D12_COMMAND_LIST_TYPE, size_t, ResourceStateRegistry* = nullptr);
         void Reset(int, ID3D12PipelineState* = nullptr);
+        /// @brief
+        /// 溜めたバリアを発行してからクローズする
+        void Close(void);
+
+      // リソース状態追跡
+      #pragma region Resource state
+      public:
+        /// @brief
+        /// リソースの遷移を記録する(バリアはFlushBarriersかCloseでまとめて発行される)
+        void Transition(ID3D12Resource*, D3D12_RESOURCE_STATES, UINT subresource = ALL_SUBRESOURCES);
+        void BeginSplitTransition(ID3D12Resource*, D3D12_RESOURCE_STATES, UINT subresource = ALL_SUBRESOURCES);
+        void EndSplitTransition(ID3D12Resource*, UINT subresource = ALL_SUBRESOURCES);
+        /// @brief
+        /// 溜めたバリアを一回のResourceBarrierで発行する
+        void FlushBarriers(void);
+        /// @brief
+        /// サブミット直前に呼ぶ。このリストより前に実行すべきバリアを取得する
+        /// @return 追加したバリア数
+        size_t ResolvePendingStates(std::vector<ResourceTransition>& outBarriers);
+        ResourceStateTracker& GetStateTracker(void);
+
+        /// @brief
+        /// バリア配列を一回のResourceBarrierで記録する
+        static void RecordBarriers(ID3D12GraphicsCommandList*, const std::vector<ResourceTransition>&);
+      #pragma endregion Resource state
+
+      // 作業の記録
+      // 溜めたバリアを先に発行してから記録する(遷移した状態を使う作業より後にバリアが来ないように)
+      #pragma region Work
+      public:
+        void DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation);
+        void DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation);
+        void Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ);
+        void CopyResource(ID3D12Resource* dstResource, ID3D12Resource* srcResource);
+        void CopyBufferRegion(ID3D12Resource* dstBuffer, UINT64 dstOffset, ID3D12Resource* srcBuffer, UINT64 srcOffset, UINT64 numBytes);
+        void CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* dst, UINT dstX, UINT dstY, UINT dstZ, const D3D12_TEXTURE_COPY_LOCATION* src, const D3D12_BOX* srcBox);
+        void ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE renderTargetView, const FLOAT colorRGBA[4], UINT numRects, const D3D12_RECT* rects);
+        void ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView, D3D12_CLEAR_FLAGS clearFlags, FLOAT depth, UINT8 stencil, UINT numRects, const D3D12_RECT* rects);
+      #pragma endregion Work
 
       public:
         void Dispose(void) noexcept override;
 
       public:
+        /// @brief
+        /// 生のリストを取得する(バリアは発行しないので、作業の記録には上のラッパーを使うこと)
         ID3D12GraphicsCommandList* Get(void) const;
-        ID3D12GraphicsCommandList* operator->() const noexcept;
+        /// @brief
+        /// 溜めたバリアを発行してから生のリストを返す(->で記録した作業もバリアより後になる)
+        ID3D12GraphicsCommandList* operator->();
 
       private:
         ComPtr<ID3D12GraphicsCommandList> m_commandList;
         std::vector<ComPtr<ID3D12CommandAllocator>> m_commandAllocators;
+        ResourceStateTracker m_stateTracker;
+        std::vector<ResourceTransition> m_flushBarriers;
 
     };
 
+    inline ResourceStateTracker& CommandList::GetStateTracker(void)
+    {
+      return m_stateTracker;
+    }
+
     inline ID3D12GraphicsCommandList* CommandList::Get(void) const
     {
       return m_commandList.Get();
     }
 
-    inline ID3D12GraphicsCommandList* CommandList::operator->() const noexcept
+    inline ID3D12GraphicsCommandList* CommandList::operator->()
     {
+      FlushBarriers();
       return m_commandList.Get();
     }
 
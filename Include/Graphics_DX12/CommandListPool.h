@@ -0,0 +1,85 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Command list pool for parallel recording (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Share retire and reuse logic through FencedPool
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_COMMAND_LIST_POOL
+#define M_DX12_COMMAND_LIST_POOL
+
+#include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/CommandList.h>
+#include <FencedPool.hpp>
+
+struct ID3D12Device;
+struct ID3D12PipelineState;
+
+enum D3D12_COMMAND_LIST_TYPE;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// ワーカースレッドごとにコマンドリストとアロケーターを払い出すプール
+    /// 一つのリストは専用のアロケーターを一つ持ち、フレーム内では一つのスレッドだけが記録する
+    /// サブミットしたリストはフェンス値と一緒に退役させ、GPUが完了してから再利用する
+    /// 
+    /// 使い方:
+    ///   BeginFrame(完了済みフェンス値) -> 各スレッドでAcquire/記録/Close -> CommandBatchに追加
+    ///   -> CommandQueue::Execute(batch) -> EndFrame(シグナルしたフェンス値)
+    class CommandListPool final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(CommandListPool)
+
+      public:
+        /// @brief
+        /// 初期化する(AcquireやDisposeと同時に呼ばないこと)
+        /// @param device デバイス
+        /// @param type コマンドリストの種類
+        /// @param stateRegistry リストの状態追跡で使うレジストリ
+        bool Init(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, ResourceStateRegistry* stateRegistry = nullptr);
+
+        /// @brief
+        /// GPUが完了したリストを再利用できるように戻す
+        /// @param completedFenceValue 完了済みのフェンス値
+        void BeginFrame(UINT64 completedFenceValue);
+
+        /// @brief
+        /// 記録可能な状態のリストを取得する(スレッドセーフ)
+        /// 空きがなければ新しく作る
+        CommandList* Acquire(ID3D12PipelineState* pipelineState = nullptr);
+
+        /// @brief
+        /// このフレームで取得したすべてのリストを退役させる
+        /// @param signaledFenceValue サブミット後にシグナルしたフェンス値
+        void EndFrame(UINT64 signaledFenceValue);
+
+        size_t GetCreatedCount(void) const;
+        size_t GetAvailableCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        ID3D12Device* m_device;
+        UINT m_type;      // D3D12_COMMAND_LIST_TYPE
+        ResourceStateRegistry* m_stateRegistry;
+        FencedPool<CommandList> m_lists;
+    };
+  }
+}
+
+#endif
@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : DirectX12 CommandQueue Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/06 Create
+                2026/10/19 Add ordered batch submission
+                2026/10/19 Always resolve pending states on batch submission
            
 Version : alpha_1.0.0
 
@@ -19,6 +21,8 @@ Encoding : UTF-8
 #define M_DX12_COMMAND_QUEUE
 
 #include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/ResourceStateTracker.h>
+#include <vector>
 
 struct ID3D12Device;
 struct ID3D12CommandQueue;
@@ -30,6 +34,9 @@ namespace MFramework
 {
   inline namespace MGraphics_DX12
   {
+    class CommandBatch;
+    class CommandListPool;
+
     class CommandQueue final : public IDisposable
     {
       GENERATE_CLASS_NO_COPY(CommandQueue)
@@ -40,6 +47,13 @@ namespace MFramework
         /// @param  
         void Init(ID3D12Device*, D3D12_COMMAND_LIST_TYPE);
         void Execute(int, ID3D12CommandList* const*);
+        /// @brief
+        /// バッチのリストをorder順に一回のExecuteCommandListsでサブミットする
+        /// 各リストの保留状態を順番に解決し、必要なバリアはbarrierPoolから取ったリストに記録して直前に挟む
+        /// @param batch クローズ済みのリストを集めたバッチ(サブミット後にクリアされる)
+        /// @param barrierPool バリア用のリストを取得するプール(リストの開始状態は必ずここで解決する)
+        /// @return サブミットしたリスト数
+        size_t Execute(CommandBatch& batch, CommandListPool& barrierPool);
 
       public:
         void Dispose(void) noexcept override;
@@ -49,6 +63,8 @@ namespace MFramework
         ID3D12CommandQueue* operator->() const noexcept;
       private:
         ComPtr<ID3D12CommandQueue> m_commandQueue;
+        std::vector<ID3D12CommandList*> m_submitLists;
+        std::vector<ResourceTransition> m_pendingBarriers;
     };
   }
   // MGraphics_DX12
@@ -0,0 +1,49 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : FXC shader compiler (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_D3D_SHADER_COMPILER
+#define M_DX12_D3D_SHADER_COMPILER
+
+#include "GraphicsClassBaseInclude.h"
+#include <Interfaces/IShaderCompiler.h>
+
+struct ID3D10Blob;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// D3DCompileFromFileによるコンパイラー
+    /// インクルードはShaderPreprocessorと同じ規則で探すため、キャッシュキーとコンパイル結果が一致する
+    class D3DShaderCompiler final : public IShaderCompiler
+    {
+      public:
+        const char* GetName(void) const override;
+        bool Compile(const ShaderCompileDesc& desc, const PreprocessedShader& preprocessed, std::vector<uint8_t>& outBytecode, std::string& outError) const override;
+
+        /// @brief
+        /// 設定どおりにファイルをコンパイルする
+        /// @param desc コンパイル設定
+        /// @param outBlob バイトコード
+        /// @param outError エラーメッセージ(nullptr可)
+        static HRESULT CompileToBlob(const ShaderCompileDesc& desc, ID3D10Blob** outBlob, ID3D10Blob** outError);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DirectX12 instanced draw backend (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Sort draws through DrawPacketQueue
+                2026/10/19 Bindless materials
+                2026/10/19 Share root signatures by layout hash
+                2026/10/19 Encode root signature in sort keys
+                2026/10/19 Compare serialized layouts when sharing root signatures
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_INSTANCE_DRAW_BACKEND
+#define M_DX12_INSTANCE_DRAW_BACKEND
+
+#include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/DescriptorHandle.h>
+#include <Interfaces/IDrawPacketBackend.h>
+#include <Interfaces/IInstanceDrawBackend.h>
+#include <RenderSystem/DrawPacketQueue.h>
+
+#include <d3d12.h>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    class CommandList;
+    class RootSignature;
+
+    /// @brief
+    /// InstanceBatcherのDX12バックエンド
+    /// 永続マップしたアップロードバッファーをインスタンスデータのリングとして使い、
+    /// 描画ごとにまとまりの先頭アドレスをルートSRVに設定してDrawIndexedInstancedを記録する
+    /// 描画はすぐには記録せずDrawPacketQueueにためておき、EndRecordingでソートキーの順に並べてから記録する
+    /// (ルートシグネチャー、パイプラインステート、マテリアル、メッシュは直前と変わったときだけ設定する)
+    /// パイプラインステート、メッシュ、マテリアルは登録順のIDで表す
+    /// テクスチャなどはシェーダーがバインドレスヒープからインスタンスデータのインデックスで引くので、マテリアルごとには何もバインドしない
+    /// (ヒープ全体のテーブルとフレームの定数はルートシグネチャーを設定するたびに設定し直す)
+    class DX12InstanceDrawBackend final : public IInstanceDrawBackend, public IDrawPacketBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(DX12InstanceDrawBackend)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param device デバイス
+        /// @param instanceCapacity インスタンスデータのリングのサイズ
+        /// @param instanceRootParameter インスタンスデータを渡すルートSRVのパラメーター番号
+        /// @param bindlessRootParameter バインドレスヒープ全体を見せるディスクリプタテーブルのパラメーター番号
+        /// @param frameConstantsRootParameter フレームの定数バッファーのインデックスを渡すルート定数のパラメーター番号
+        /// @param threadPool 描画パケットを並列に並べ替えるスレッドプール(nullptrなら記録するスレッドで並べ替える)
+        bool Init(ID3D12Device* device, uint64_t instanceCapacity, uint32_t instanceRootParameter, uint32_t bindlessRootParameter, uint32_t frameConstantsRootParameter, ThreadPool* threadPool = nullptr);
+
+        /// @brief
+        /// パイプラインステートを登録する(レイアウトのハッシュが同じルートシグネチャーは一つのIDにまとめる)
+        /// ルートシグネチャーはどれもInitで指定したパラメーター番号を同じ種類で持つこと
+        /// ソートキーに入るので、ルートシグネチャーは2^DrawSortKey::ROOT_SIGNATURE_BITS種類、パイプラインステートは2^DrawSortKey::PIPELINE_STATE_BITS個まで
+        /// @return パイプラインステートID
+        uint32_t RegisterPipelineState(const RootSignature& rootSignature, ID3D12PipelineState* pipelineState);
+
+        /// @brief
+        /// メッシュを登録する
+        /// @return メッシュID
+        uint32_t RegisterMesh(const D3D12_VERTEX_BUFFER_VIEW& vertexView, const D3D12_INDEX_BUFFER_VIEW& indexView, uint32_t indexCount);
+
+        /// @brief
+        /// マテリアルを登録する
+        /// @param pipelineState RegisterPipelineStateで登録したパイプラインステートID
+        /// @param bucket 不透明か半透明か(半透明は不透明の後に描く)
+        /// ソートキーに入るので、2^DrawSortKey::MATERIAL_BITS個まで
+        /// @return マテリアルID
+        uint32_t RegisterMaterial(uint32_t pipelineState, DrawBucket bucket = DrawBucket::Opaque);
+
+        /// @brief
+        /// 記録先のリストとフレームで共通のルートの引数を設定する(ディスクリプタヒープは設定済みであること)
+        /// @param bindlessTable バインドレスヒープの先頭
+        /// @param frameConstantBufferIndex フレームの定数バッファーのバインドレスインデックス
+        void BeginRecording(CommandList* cmdList, GPUDescHandle bindlessTable, uint32_t frameConstantBufferIndex);
+        /// @brief
+        /// ためた描画を並べ替えてリストに記録する
+        void EndRecording(void);
+
+      public:
+        uint8_t* GetInstanceMemory(void) const override;
+        uint64_t GetInstanceCapacity(void) const override;
+        void DrawInstanced(const InstanceDrawCommand& command) override;
+
+      public:
+        void SetRootSignature(uint32_t rootSignature) override;
+        void SetPipelineState(uint32_t pipelineState) override;
+        void SetMaterial(uint32_t material) override;
+        void SetMesh(uint32_t mesh) override;
+        void Draw(uint32_t instanceCount, uint64_t instanceDataOffset) override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Mesh
+        {
+          D3D12_VERTEX_BUFFER_VIEW VertexView;
+          D3D12_INDEX_BUFFER_VIEW IndexView;
+          uint32_t IndexCount;
+        };
+
+        struct RootSignatureEntry
+        {
+          uint64_t Hash;
+          std::vector<uint8_t> SerializedLayout;
+          ID3D12RootSignature* RootSignature;
+        };
+
+        struct PipelineState
+        {
+          uint32_t RootSignature;
+          ID3D12PipelineState* State;
+        };
+
+        struct Material
+        {
+          uint32_t PipelineState;
+          DrawBucket Bucket;
+        };
+
+      private:
+        ComPtr<ID3D12Resource> m_instanceBuffer;
+        uint8_t* m_instanceMemory;
+        uint64_t m_instanceCapacity;
+        uint32_t m_instanceRootParameter;
+        uint32_t m_bindlessRootParameter;
+        uint32_t m_frameConstantsRootParameter;
+        std::vector<RootSignatureEntry> m_rootSignatures;
+        std::vector<PipelineState> m_pipelineStates;
+        std::vector<Mesh> m_meshes;
+        std::vector<Material> m_materials;
+        DrawPacketQueue m_packetQueue;
+        ThreadPool* m_threadPool;
+        CommandList* m_recordingList;
+        GPUDescHandle m_bindlessTable;
+        uint32_t m_frameConstantBufferIndex;
+        // Drawで使う、SetMeshで設定したメッシュ
+        uint32_t m_currentMesh;
+    };
+  }
+}
+
+#endif
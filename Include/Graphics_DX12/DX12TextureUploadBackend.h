@@ -0,0 +1,106 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture upload backend of texture streamer (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add texture to texture copy for mip streaming
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_TEXTURE_UPLOAD_BACKEND
+#define M_DX12_TEXTURE_UPLOAD_BACKEND
+
+#include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/CommandBatch.h>
+#include <Graphics_DX12/DescriptorHandle.h>
+#include <Interfaces/ITextureUploadBackend.h>
+
+#include <unordered_map>
+#include <vector>
+
+struct ID3D12Device;
+struct ID3D12Resource;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    class CommandList;
+    class CommandListPool;
+    class CommandQueue;
+    class Fence;
+    class ResourceStateRegistry;
+
+    /// @brief
+    /// TextureStreamerのDX12バックエンド
+    /// 永続マップしたアップロードバッファーをステージングリングとして使い、
+    /// 一回のUpdateで記録したコピーはプールのリスト一つにまとめて描画と同じキューにサブミットする
+    /// テクスチャIDはID3D12Resourceのアドレス
+    class DX12TextureUploadBackend final : public ITextureUploadBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(DX12TextureUploadBackend)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param device デバイス
+        /// @param cmdQueue サブミット先(描画と同じキュー)
+        /// @param cmdListPool コピー用のリストを取得するプール
+        /// @param fence サブミット後にシグナルするフェンス
+        /// @param stateRegistry 作ったテクスチャを登録するレジストリ
+        /// @param stagingCapacity ステージングリングのサイズ
+        bool Init(ID3D12Device* device, CommandQueue* cmdQueue, CommandListPool* cmdListPool, Fence* fence, ResourceStateRegistry* stateRegistry, uint64_t stagingCapacity);
+
+        ID3D12Resource* GetResource(uint64_t texture) const;
+
+        /// @brief
+        /// テクスチャのすべてのミップを参照するSRVを作る
+        void CreateShaderResourceView(uint64_t texture, CPUDescHandle handle) const;
+
+      public:
+        uint8_t* GetStagingMemory(void) const override;
+        uint64_t GetStagingCapacity(void) const override;
+        uint64_t CreateTexture(const TextureDesc& desc) override;
+        void DestroyTexture(uint64_t texture) override;
+        void CopyToTexture(uint64_t texture, uint32_t subresource, const SubresourceFootprint& footprint) override;
+        void CopyTextureSubresource(uint64_t dstTexture, uint32_t dstSubresource, uint64_t srcTexture, uint32_t srcSubresource) override;
+        uint64_t Submit(void) override;
+        uint64_t GetCompletedFenceValue(void) const override;
+        uint64_t GetSubmittedFenceValue(void) const override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        bool beginRecording(void);
+        void addCopiedTexture(ID3D12Resource* resource);
+
+      private:
+        ID3D12Device* m_device;
+        CommandQueue* m_cmdQueue;
+        CommandListPool* m_cmdListPool;
+        Fence* m_fence;
+        ResourceStateRegistry* m_stateRegistry;
+        ComPtr<ID3D12Resource> m_stagingBuffer;
+        uint8_t* m_stagingMemory;
+        uint64_t m_stagingCapacity;
+        std::unordered_map<uint64_t, ComPtr<ID3D12Resource>> m_textures;
+        // 記録中のリスト(最初のコピーで取得する)
+        CommandList* m_recordingList;
+        // コピー先とコピー元(サブミット前にシェーダーリソースの状態へ戻す)
+        std::vector<ID3D12Resource*> m_copiedTextures;
+        CommandBatch m_batch;
+    };
+  }
+}
+
+#endif
@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : D3D12 Fence Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/09/19 Create
+                2026/10/19 Add Signal and completed value query
 
 Version : alpha_1.0.0
 
@@ -35,6 +36,14 @@ namespace MFramework
       public:
         void Init(ID3D12Device*);
         void Wait(ID3D12CommandQueue*, UINT32 = INFINITE);
+        /// @brief
+        /// 待たずにシグナルだけする
+        /// @return シグナルしたフェンス値(失敗時は0)
+        UINT64 Signal(ID3D12CommandQueue*);
+        /// @brief
+        /// GPUが完了したフェンス値を取得する
+        UINT64 GetCompletedValue(void) const;
+        UINT64 GetLastSignaledValue(void) const;
 
       public:
         void Dispose(void) noexcept override;
@@ -46,6 +55,11 @@ namespace MFramework
         bool m_isDisposed : 1;
         bool m_isInitialized : 1;
     };
+
+    inline UINT64 Fence::GetLastSignaledValue() const
+    {
+      return m_fenceCount;
+    }
   }
 }
 #endif
\ No newline at end of file
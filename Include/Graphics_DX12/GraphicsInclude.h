@@ -7,6 +7,15 @@ Description : DirectX12 Graphics System Include List (Graphics API: DirectX12)
 
 Update History: 2024/11/12 Create
                 2024/11/19 Add include Texture.h
+                2026/10/19 Add include BindlessResourceTable.h
+                           Add include ResourceStateTracker.h
+                           Add include CommandListPool.h, CommandBatch.h
+                           Add include PipelineStateCache.h
+                           Add include RootSignatureLayout.h, RootSignatureCache.h
+                           Add include ShaderCompileCache.h
+                           Add include ShaderLibrary.h
+                           Add include DX12TextureUploadBackend.h, WICTextureDecoder.h
+                           Add include DX12InstanceDrawBackend.h
 
 Version : alpha_1.0.0
 
@@ -31,19 +40,31 @@ Encoding : UTF-8
 // wrapper class header include
 #include <Graphics_DX12/DX12Device.h>
 #include <Graphics_DX12/DX12DXGIFactory.h>
+#include <Graphics_DX12/ResourceStateTracker.h>
 #include <Graphics_DX12/CommandList.h>
+#include <Graphics_DX12/CommandListPool.h>
+#include <Graphics_DX12/CommandBatch.h>
 #include <Graphics_DX12/CommandQueue.h>
+#include <Graphics_DX12/RootSignatureLayout.h>
 #include <Graphics_DX12/RootSignature.h>
+#include <Graphics_DX12/RootSignatureCache.h>
 #include <Graphics_DX12/PipelineState.h>
+#include <Graphics_DX12/PipelineStateCache.h>
 #include <Graphics_DX12/DX12SwapChain.h>
 #include <Graphics_DX12/Fence.h>
 #include <Graphics_DX12/VertexBufferContainer.h>
 #include <Graphics_DX12/IndexBufferContainer.h>
 #include <Graphics_DX12/DescriptorHandle.h>
 #include <Graphics_DX12/DescriptorHeap.h>
+#include <Graphics_DX12/BindlessResourceTable.h>
 #include <Graphics_DX12/ConstantBuffer.h>
 #include <Graphics_DX12/RenderTarget.h>
+#include <Graphics_DX12/ShaderLibrary.h>
 #include <Graphics_DX12/ShaderResBlob.h>
+#include <Graphics_DX12/ShaderCompileCache.h>
 #include <Graphics_DX12/Texture.h>
+#include <Graphics_DX12/DX12TextureUploadBackend.h>
+#include <Graphics_DX12/WICTextureDecoder.h>
+#include <Graphics_DX12/DX12InstanceDrawBackend.h>
 
 #endif
@@ -23,6 +23,10 @@ Encoding : UTF-8
 #include <Color.h>
 
 #include <Graphics_DX12/GraphicsInclude.h>
+#include <RenderSystem/InstanceBatcher.h>
+#include <RenderSystem/RenderGraph.h>
+#include <RenderSystem/TextureStreamer.h>
+#include <ThreadPool.h>
 
 class IGraphics
 {
@@ -55,27 +59,54 @@ namespace MFramework
         void Terminate(void) noexcept override;
     #pragma endregion Interface implementation
     // endregion of Interface implementation
+      private:
+        void renderMainPass(UINT backBufferIndex);
+
     // Private変数
     #pragma region private variables
       private:
         DX12DXGIFactory m_dxgiFactory;
         DX12Device m_device;
+        ResourceStateRegistry m_stateRegistry;
         CommandList m_cmdList;
+        // ワーカースレッド用とサブミット時のバリア用のリストを払い出すプール
+        CommandListPool m_cmdListPool;
+        CommandBatch m_cmdBatch;
+        RenderGraph m_renderGraph;
         CommandQueue m_cmdQueue;
         SwapChain m_swapChain;
         DescriptorHeap m_rtvHeap;
-        DescriptorHeap m_texHeap;
+        BindlessResourceTable m_resourceTable;
         std::vector<RenderTarget> m_renderTargets;
         Fence m_fence;
         ConstantBuffer m_constBuffer;
         VertexBufferContainer m_vertBuffer;
         IndexBufferContainer m_idxBuffer;
+        // 描画はメッシュとマテリアルでまとめ、まとまりごとに一回のインスタンス描画にする
+        DX12InstanceDrawBackend m_instanceDrawer;
+        InstanceBatcher m_instanceBatcher;
+        uint32_t m_quadMesh;
+        uint32_t m_quadMaterial;
+        // シェーダーより先に宣言する(バイトコードはマップしたメモリを直接指す)
+        ShaderLibrary m_shaderLibrary;
         ShaderResBlob m_vertShader;
         ShaderResBlob m_pixelShader;
+        ShaderCompileCache m_shaderCache;
+        // ルートシグネチャーはレイアウトのハッシュで共有する(m_rootSigより先に宣言する)
+        RootSignatureCache m_rootSigCache;
         RootSignature m_rootSig;
-        PipelineState m_pipelineState;
+        PipelineStateCache m_psoCache;
+        // m_psoCacheが所有する
+        ID3D12PipelineState* m_pipelineState;
+        // テクスチャのデコードなどのバックグラウンド処理用
+        ThreadPool m_threadPool;
+        WICTextureDecoder m_textureDecoder;
+        DX12TextureUploadBackend m_textureUploader;
+        TextureStreamer m_textureStreamer;
         // TODO Temp
-        Texture m_texture;
+        StreamingTextureHandle m_texture;
+        BindlessHandle m_textureSlot;
+        BindlessHandle m_constBufferSlot;
 
         D3D12_VIEWPORT m_viewPort;
         D3D12_RECT  m_scissorRect;
@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : PipelineState Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/12 Create
+                2026/10/19 Build from PipelineStateDesc
 
 Version : alpha_1.0.0
 
@@ -31,6 +32,7 @@ namespace MFramework
   inline namespace MGraphics_DX12
   {
     class ShaderResBlob;
+    struct PipelineStateDesc;
   }
 }
 
@@ -51,8 +53,16 @@ namespace MFramework
                     ShaderResBlob* pixelShader,
                     D3D12_BLEND_DESC*
                   );
+        /// @brief
+        /// 状態記述から作成する
+        void Init(ID3D12Device*, const PipelineStateDesc&);
         ID3D12PipelineState* Get(void) const;
 
+        /// @brief
+        /// 状態記述からパイプラインステートを作成する(PipelineStateCacheからも使う)
+        /// @param cachedBlob ドライバーのキャッシュブロブ(なければnullptr)
+        static HRESULT Create(ID3D12Device*, const PipelineStateDesc&, const void* cachedBlob, size_t cachedBlobSize, ID3D12PipelineState** outPipelineState);
+
       public:
         void Dispose(void) noexcept override;
 
@@ -0,0 +1,71 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Pipeline state cached blob store (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_PIPELINE_STATE_BLOB_STORE
+#define M_PIPELINE_STATE_BLOB_STORE
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// パイプラインステートのキー(ハッシュ値)とドライバーのキャッシュブロブの組を保持し、ファイルに保存する
+    /// ファイル形式: ヘッダー(マジック, バージョン, 件数) + [キー, サイズ, データ] * 件数
+    class PipelineStateBlobStore final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(PipelineStateBlobStore)
+
+      public:
+        /// @brief
+        /// ファイルから読み込む(存在しない・壊れている場合は空のまま)
+        /// @return 読み込めたらtrue
+        bool LoadFromFile(const std::string& filePath);
+        /// @brief
+        /// ファイルに書き出す(変更がなければ何もしない)
+        bool SaveToFile(const std::string& filePath);
+
+        /// @brief
+        /// ブロブを取得する
+        /// @param outBlob コピー先
+        /// @return 見つかったらtrue
+        bool Find(uint64_t key, std::vector<uint8_t>& outBlob) const;
+        void Store(uint64_t key, const void* data, size_t size);
+        void Remove(uint64_t key);
+
+        size_t GetCount(void) const;
+        bool IsDirty(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        std::unordered_map<uint64_t, std::vector<uint8_t>> m_blobs;
+        bool m_isDirty;
+        mutable std::mutex m_mutex;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Pipeline state object cache (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Compare serialized descriptions on hash hits
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_PIPELINE_STATE_CACHE
+#define M_DX12_PIPELINE_STATE_CACHE
+
+#include "GraphicsClassBaseInclude.h"
+
+#include <Graphics_DX12/PipelineStateDesc.h>
+#include <Graphics_DX12/PipelineStateBlobStore.h>
+#include <LockFreeHashTable.hpp>
+#include <ThreadPool.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+struct ID3D12Device;
+struct ID3D12PipelineState;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// キャッシュ内のパイプラインステート一つ分
+    /// コンパイルが終わるまではGetがnullptrを返す
+    class PipelineStateEntry final
+    {
+      GENERATE_CLASS_NO_COPY(PipelineStateEntry)
+
+      public:
+        enum class Status : uint8_t
+        {
+          Compiling,
+          Ready,
+          Failed,
+        };
+
+      public:
+        ID3D12PipelineState* Get(void) const;
+        Status GetStatus(void) const;
+        uint64_t GetHash(void) const;
+        bool IsReady(void) const;
+        /// @brief
+        /// コンパイルが終わるまで待つ
+        void Wait(void) const;
+
+      private:
+        friend class PipelineStateCache;
+
+        ComPtr<ID3D12PipelineState> m_pipelineState;
+        std::atomic<Status> m_status;
+        uint64_t m_hash;
+        // ハッシュの元になった記述の正規形(ハッシュが衝突していないかを確かめる)
+        std::vector<uint8_t> m_serializedDesc;
+    };
+
+    /// @brief
+    /// 状態記述のハッシュ値をキーにしたパイプラインステートのキャッシュ
+    /// 検索はロックを取らず、見つからなければバックグラウンドでコンパイルする
+    /// エントリーは記述の正規形を持ち、Requestではハッシュが一致しても正規形が違えば別の記述として扱う
+    /// ドライバーのキャッシュブロブはキーと一緒にファイルへ保存し、次回起動時に再利用する
+    class PipelineStateCache final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(PipelineStateCache)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param device デバイス
+        /// @param cacheFilePath ブロブの保存先(空なら保存しない)
+        /// @param compileThreadCount コンパイル用のスレッド数
+        /// @param capacity 最大パイプラインステート数
+        bool Init(ID3D12Device* device, const std::string& cacheFilePath = "", uint32_t compileThreadCount = 2, size_t capacity = 4096);
+
+        /// @brief
+        /// パイプラインステートを要求する(待たない)
+        /// 初めてのキーならバックグラウンドでコンパイルを始める
+        /// バイトコードとルートシグネチャーはコンパイル用にコピー・参照を取るため、呼び出し後に解放してよい
+        /// @return エントリー(満杯、またはハッシュが同じで記述の違うエントリーがあればnullptr)
+        PipelineStateEntry* Request(const PipelineStateDesc& desc);
+
+        /// @brief
+        /// パイプラインステートを取得する(コンパイル中なら終わるまで待つ)
+        ID3D12PipelineState* GetOrCreate(const PipelineStateDesc& desc);
+
+        /// @brief
+        /// キーから探す(ロックなし)
+        /// 毎フレーム同じ記述を使う場合はRequestで得たエントリーのGetHashを覚えておいてこちらを使う
+        /// (記述の比較はしないので、一度Requestで確かめたキーに使う)
+        PipelineStateEntry* Find(uint64_t hash) const;
+
+        /// @brief
+        /// 実行中のコンパイルがすべて終わるまで待つ
+        void WaitIdle(void);
+
+        /// @brief
+        /// ブロブをファイルに保存する
+        bool SaveToFile(void);
+
+        size_t GetCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        void submitCompile(const PipelineStateDesc& desc, PipelineStateEntry* entry);
+        void compile(const PipelineStateDesc& desc, PipelineStateEntry* entry);
+
+      private:
+        ID3D12Device* m_device;
+        std::string m_cacheFilePath;
+        LockFreeHashTable<PipelineStateEntry> m_entries;
+        PipelineStateBlobStore m_blobStore;
+        ThreadPool m_compileThreads;
+    };
+
+    inline PipelineStateEntry::Status PipelineStateEntry::GetStatus() const
+    {
+      return m_status.load(std::memory_order_acquire);
+    }
+
+    inline uint64_t PipelineStateEntry::GetHash() const
+    {
+      return m_hash;
+    }
+
+    inline bool PipelineStateEntry::IsReady() const
+    {
+      return GetStatus() == Status::Ready;
+    }
+
+    inline PipelineStateEntry* PipelineStateCache::Find(uint64_t hash) const
+    {
+      return m_entries.Find(hash);
+    }
+
+    inline size_t PipelineStateCache::GetCount() const
+    {
+      return m_entries.GetCount();
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Hashable pipeline state description (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Input layout from vertex layout
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_PIPELINE_STATE_DESC
+#define M_PIPELINE_STATE_DESC
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ID3D12RootSignature;
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    struct VertexLayout;
+  }
+
+  inline namespace MGraphics_DX12
+  {
+    // 列挙値はすべてD3D12/DXGIと同じ値で持つ(デバイスなしでハッシュできるように)
+    constexpr uint32_t MAX_PIPELINE_RENDER_TARGETS = 8;         // D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT
+    constexpr uint32_t APPEND_ALIGNED_ELEMENT = 0xffffffff;     // D3D12_APPEND_ALIGNED_ELEMENT
+
+    /// @brief
+    /// シェーダーバイトコードの参照とその内容のハッシュ値
+    struct ShaderBytecode final
+    {
+      const void* Data;
+      size_t Size;
+      uint64_t Hash;
+
+      ShaderBytecode()
+        : Data(nullptr)
+        , Size(0)
+        , Hash(0)
+      { }
+
+      /// @brief
+      /// バイトコードの内容からハッシュ値を求めて作る
+      static ShaderBytecode Create(const void* data, size_t size);
+    };
+
+    /// @brief
+    /// 入力レイアウトの要素一つ分
+    struct InputElement final
+    {
+      std::string SemanticName;
+      uint32_t SemanticIndex;
+      uint32_t Format;                // DXGI_FORMAT
+      uint32_t InputSlot;
+      uint32_t AlignedByteOffset;
+      bool IsPerInstance;             // D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA
+      uint32_t InstanceDataStepRate;
+
+      /// @brief
+      /// 頂点レイアウトから頂点ごとの入力レイアウトを作る(オフセットはレイアウトの値をそのまま使う)
+      static std::vector<InputElement> CreateFromVertexLayout(const VertexLayout& layout, uint32_t inputSlot = 0);
+    };
+
+    /// @brief
+    /// レンダーターゲット一つ分のブレンド設定
+    struct RenderTargetBlendState final
+    {
+      bool BlendEnable = false;
+      uint8_t SrcBlend = 2;           // D3D12_BLEND_ONE
+      uint8_t DestBlend = 1;          // D3D12_BLEND_ZERO
+      uint8_t BlendOp = 1;            // D3D12_BLEND_OP_ADD
+      uint8_t SrcBlendAlpha = 2;      // D3D12_BLEND_ONE
+      uint8_t DestBlendAlpha = 1;     // D3D12_BLEND_ZERO
+      uint8_t BlendOpAlpha = 1;       // D3D12_BLEND_OP_ADD
+      uint8_t WriteMask = 0x0f;       // D3D12_COLOR_WRITE_ENABLE_ALL
+    };
+
+    struct BlendState final
+    {
+      bool AlphaToCoverageEnable = false;
+      bool IndependentBlendEnable = false;
+      RenderTargetBlendState RenderTargets[MAX_PIPELINE_RENDER_TARGETS];
+    };
+
+    struct RasterizerState final
+    {
+      uint8_t FillMode = 3;           // D3D12_FILL_MODE_SOLID
+      uint8_t CullMode = 1;           // D3D12_CULL_MODE_NONE
+      bool FrontCounterClockwise = false;
+      int32_t DepthBias = 0;
+      float DepthBiasClamp = 0.0f;
+      float SlopeScaledDepthBias = 0.0f;
+      bool DepthClipEnable = true;
+      bool ConservativeRaster = false;
+    };
+
+    struct DepthStencilState final
+    {
+      bool DepthEnable = false;
+      bool DepthWriteEnable = true;   // D3D12_DEPTH_WRITE_MASK_ALL
+      uint8_t DepthFunc = 2;          // D3D12_COMPARISON_FUNC_LESS
+      bool StencilEnable = false;
+    };
+
+    /// @brief
+    /// パイプラインステートを表すハッシュ可能な記述
+    /// バイトコードとルートシグネチャーはハッシュ値だけがキーに含まれる
+    struct PipelineStateDesc final
+    {
+      ID3D12RootSignature* RootSignature = nullptr;
+      uint64_t RootSignatureHash = 0;
+      ShaderBytecode VS;
+      ShaderBytecode PS;
+      std::vector<InputElement> InputLayout;
+      BlendState Blend;
+      RasterizerState Rasterizer;
+      DepthStencilState DepthStencil;
+      uint32_t SampleMask = 0xffffffff;
+      uint8_t PrimitiveTopologyType = 3;                  // D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE
+      uint32_t NumRenderTargets = 1;
+      uint32_t RTVFormats[MAX_PIPELINE_RENDER_TARGETS] = { 29 };  // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+      uint32_t DSVFormat = 40;                            // DXGI_FORMAT_D32_FLOAT
+      uint32_t SampleCount = 1;
+      uint32_t SampleQuality = 0;
+
+      /// @brief
+      /// キーに含まれる値を決まった順序・幅で書き出す(パディングやポインターを含まない)
+      void Serialize(std::vector<uint8_t>& outBytes) const;
+
+      /// @brief
+      /// キーとなるハッシュ値を求める
+      uint64_t ComputeHash(void) const;
+    };
+  }
+}
+
+#endif
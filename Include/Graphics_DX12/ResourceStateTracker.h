@@ -0,0 +1,205 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Resource state tracker (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Merge only barriers with no recorded work between them
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_RESOURCE_STATE_TRACKER
+#define M_RESOURCE_STATE_TRACKER
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+struct ID3D12Resource;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    // D3D12_RESOURCE_STATESと同じビット配置
+    ALIAS(uint32_t, ResourceStates);
+
+    constexpr uint32_t ALL_SUBRESOURCES = 0xffffffff;   // D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES
+    constexpr ResourceStates UNKNOWN_RESOURCE_STATE = 0xffffffff;
+
+    /// @brief
+    /// 分割バリアの種類
+    enum class BarrierSplit : uint8_t
+    {
+      None,
+      BeginOnly,
+      EndOnly,
+    };
+
+    /// @brief
+    /// 遷移バリア一つ分の情報
+    struct ResourceTransition final
+    {
+      ID3D12Resource* Resource;
+      uint32_t Subresource;
+      ResourceStates Before;
+      ResourceStates After;
+      BarrierSplit Split;
+    };
+
+    /// @brief
+    /// キュー上で確定したリソースの状態(全コマンドリスト共通)
+    class ResourceStateRegistry final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ResourceStateRegistry)
+
+      public:
+        /// @brief
+        /// リソースを登録する
+        /// @param resource リソース
+        /// @param subresourceCount サブリソース数(ミップ数 * 配列数 * プレーン数)
+        /// @param initialState 作成時の状態
+        void Register(ID3D12Resource* resource, uint32_t subresourceCount, ResourceStates initialState);
+        void Unregister(ID3D12Resource* resource);
+
+        bool IsRegistered(ID3D12Resource* resource) const;
+        uint32_t GetSubresourceCount(ID3D12Resource* resource) const;
+        ResourceStates GetState(ID3D12Resource* resource, uint32_t subresource) const;
+        void SetState(ID3D12Resource* resource, uint32_t subresource, ResourceStates state);
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        std::unordered_map<ID3D12Resource*, std::vector<ResourceStates>> m_states;
+        mutable std::mutex m_mutex;
+    };
+
+    /// @brief
+    /// コマンドリスト一つ分のサブリソース単位の状態追跡
+    /// 最初に使われた状態は「保留」として記録し、サブミット時にレジストリと照合してバリアを解決する
+    /// リスト内の遷移はキューに溜めて、重複を統合してからまとめて発行する
+    /// 統合するのはキューに残っている(間に作業が記録されていない)バリア同士だけなので、
+    /// 描画やコピーなどの作業を記録する前には必ずFlushBarriersで取り出すこと(CommandListのラッパーが行う)
+    class ResourceStateTracker final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ResourceStateTracker)
+
+      public:
+        void Init(ResourceStateRegistry* registry);
+
+        /// @brief
+        /// 検証モードを切り替える(エラーはGetValidationErrorsで取得)
+        void SetValidationMode(bool enable);
+
+        /// @brief
+        /// リソースを指定状態に遷移させる
+        void Transition(ID3D12Resource* resource, ResourceStates after, uint32_t subresource = ALL_SUBRESOURCES);
+
+        /// @brief
+        /// 分割バリアを開始する(BEGIN_ONLY)
+        /// EndSplitTransitionまでの間、そのサブリソースは使用できない
+        void BeginSplitTransition(ID3D12Resource* resource, ResourceStates after, uint32_t subresource = ALL_SUBRESOURCES);
+        /// @brief
+        /// 分割バリアを終了する(END_ONLY)
+        void EndSplitTransition(ID3D12Resource* resource, uint32_t subresource = ALL_SUBRESOURCES);
+
+        /// @brief
+        /// 溜めたバリアを取り出す(一回のResourceBarrierで発行する用)
+        /// @param outBarriers 追加先
+        /// @return 取り出したバリア数
+        size_t FlushBarriers(std::vector<ResourceTransition>& outBarriers);
+        bool HasQueuedBarriers(void) const;
+
+        /// @brief
+        /// サブミット時に呼ぶ
+        /// 保留状態をレジストリと照合し、このリストの前に実行すべきバリアを返す
+        /// その後、リスト終了時の状態をレジストリに書き込む
+        /// @param outBarriers 追加先
+        /// @return 追加したバリア数
+        size_t ResolvePendingStates(std::vector<ResourceTransition>& outBarriers);
+
+        /// @brief
+        /// 記録内容を破棄する(コマンドリストのReset時)
+        void Reset(void);
+
+        const std::vector<std::string>& GetValidationErrors(void) const;
+        ResourceStateRegistry* GetRegistry(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        // サブリソースごとの状態(全サブリソースが同じ間は展開しない)
+        struct SubresourceStates
+        {
+          bool IsUniform;
+          ResourceStates UniformState;
+          std::vector<ResourceStates> States;
+
+          ResourceStates Get(uint32_t subresource) const;
+          void Set(uint32_t subresource, ResourceStates state, uint32_t subresourceCount);
+          void SetAll(ResourceStates state);
+        };
+
+        // 開始済みで未終了の分割バリア
+        struct ActiveSplit
+        {
+          uint32_t Subresource;
+          ResourceStates Before;
+          ResourceStates After;
+        };
+
+        struct TrackedResource
+        {
+          uint32_t SubresourceCount;
+          SubresourceStates Current;
+          SubresourceStates Pending;
+          std::vector<ActiveSplit> Splits;
+        };
+
+      private:
+        TrackedResource& track(ID3D12Resource*);
+        void transitionSubresource(ID3D12Resource*, TrackedResource&, uint32_t, ResourceStates);
+        bool isSplitting(const TrackedResource&, uint32_t) const;
+        void queueBarrier(ID3D12Resource*, uint32_t, ResourceStates, ResourceStates, BarrierSplit);
+        void reportError(const char* message, ID3D12Resource*, uint32_t);
+
+      private:
+        ResourceStateRegistry* m_registry;
+        std::unordered_map<ID3D12Resource*, TrackedResource> m_resources;
+        std::vector<ResourceTransition> m_queuedBarriers;
+        std::vector<std::string> m_validationErrors;
+        bool m_isValidationMode;
+    };
+
+    inline bool ResourceStateTracker::HasQueuedBarriers() const
+    {
+      return !m_queuedBarriers.empty();
+    }
+
+    inline const std::vector<std::string>& ResourceStateTracker::GetValidationErrors() const
+    {
+      return m_validationErrors;
+    }
+
+    inline ResourceStateRegistry* ResourceStateTracker::GetRegistry() const
+    {
+      return m_registry;
+    }
+  }
+}
+
+#endif
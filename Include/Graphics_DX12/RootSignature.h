@@ -6,6 +6,12 @@ Author : MAI ZHICONG
 Description : DirectX12 RootSignature Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/07 Create
+                2026/10/19 Keep serialized blob hash for pipeline state keys
+                           Build from RootSignatureLayout
+                2026/10/19 Root SRV for instance data
+                2026/10/19 Bindless descriptor table
+                2026/10/19 Create through RootSignatureCache
+                2026/10/19 Keep serialized layout to tell hash collisions apart
            
 Version : alpha_1.0.0
 
@@ -19,6 +25,10 @@ Encoding : UTF-8
 #define M_DX12_ROOTSIGNATURE
 
 #include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/RootSignatureLayout.h>
+
+#include <cstdint>
+#include <vector>
 
 struct ID3D12Device;
 struct ID3D12RootSignature;
@@ -29,12 +39,27 @@ namespace MFramework
 {
   inline namespace MGraphics_DX12
   {
+    class RootSignatureCache;
+
     class RootSignature final : public IDisposable
     {
       GENERATE_CLASS_NO_COPY(RootSignature)
 
       public:
-        void Init(ID3D12Device*, D3D12_FILTER);
+        /// @brief
+        /// 描画に使うバインドレスのレイアウトをキャッシュから取得する
+        bool Init(RootSignatureCache&, D3D12_FILTER);
+        /// @brief
+        /// レイアウトのハッシュでキャッシュから取得する(同じレイアウトは同じオブジェクトを共有する)
+        bool Init(RootSignatureCache&, const RootSignatureLayout&);
+        /// @brief
+        /// レイアウトから作成する(キャッシュを通さない)
+        bool Init(ID3D12Device*, const RootSignatureLayout&);
+
+        /// @brief
+        /// レイアウトからルートシグネチャーを作成する(RootSignatureCacheからも使う)
+        /// 上限を超えるレイアウトは作らず、高速パスを超える場合はデバッグ出力に警告を出す
+        static HRESULT Create(ID3D12Device*, const RootSignatureLayout&, ID3D12RootSignature** outRootSignature);
 
       public:
         void Dispose(void) noexcept override;
@@ -42,9 +67,19 @@ namespace MFramework
       public:
         ID3D12RootSignature* Get(void) const;
         ID3D12RootSignature* operator->() const noexcept;
+        /// @brief
+        /// レイアウトの正規形のハッシュ値(パイプラインステートのキーに使う)
+        uint64_t GetHash(void) const;
+        /// @brief
+        /// レイアウトの正規形(ハッシュが同じでもレイアウトが違うものを見分ける)
+        const std::vector<uint8_t>& GetSerializedLayout(void) const;
+        uint32_t GetSizeInDWords(void) const;
 
       private:
         ComPtr<ID3D12RootSignature> m_rootSignature;
+        uint64_t m_hash;
+        std::vector<uint8_t> m_serializedLayout;
+        uint32_t m_sizeInDWords;
 
     };
 
@@ -57,6 +92,21 @@ namespace MFramework
     {
       return m_rootSignature.Get();
     }
+
+    inline uint64_t RootSignature::GetHash(void) const
+    {
+      return m_hash;
+    }
+
+    inline const std::vector<uint8_t>& RootSignature::GetSerializedLayout(void) const
+    {
+      return m_serializedLayout;
+    }
+
+    inline uint32_t RootSignature::GetSizeInDWords(void) const
+    {
+      return m_sizeInDWords;
+    }
   }
 }
 
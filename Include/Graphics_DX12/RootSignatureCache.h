@@ -0,0 +1,86 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Root signature cache (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Compare serialized layouts on hash hits
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DX12_ROOT_SIGNATURE_CACHE
+#define M_DX12_ROOT_SIGNATURE_CACHE
+
+#include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/RootSignatureLayout.h>
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct ID3D12Device;
+struct ID3D12RootSignature;
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// レイアウトの正規形のハッシュでルートシグネチャーを共有するキャッシュ
+    /// 同じ内容のレイアウトからは同じオブジェクトを返す
+    /// ハッシュが同じでも正規形が違うレイアウトは共有しない(衝突として失敗させる)
+    class RootSignatureCache final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(RootSignatureCache)
+
+      public:
+        bool Init(ID3D12Device* device);
+
+        /// @brief
+        /// レイアウトに対応するルートシグネチャーを取得する(なければ作成する)
+        /// @param layout レイアウト
+        /// @param outHash レイアウトのハッシュ値(パイプラインステートのキーに使う)
+        /// @return 作成に失敗したか、ハッシュが衝突したらnullptr(所有権はキャッシュが持つ)
+        ID3D12RootSignature* GetOrCreate(const RootSignatureLayout& layout, uint64_t* outHash = nullptr);
+
+        /// @brief
+        /// 作成済みのルートシグネチャーを探す
+        ID3D12RootSignature* Find(uint64_t hash) const;
+
+        /// @brief
+        /// ルートシグネチャーのサイズ(DWORD)を取得する(見つからなければ0)
+        uint32_t GetSizeInDWords(uint64_t hash) const;
+
+        size_t GetCount(void) const;
+        uint64_t GetHitCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Entry
+        {
+          ComPtr<ID3D12RootSignature> RootSignature;
+          std::vector<uint8_t> SerializedLayout;
+          uint32_t SizeInDWords;
+        };
+
+      private:
+        ID3D12Device* m_device;
+        std::unordered_map<uint64_t, Entry> m_entries;
+        uint64_t m_hitCount;
+        mutable std::mutex m_mutex;
+    };
+  }
+}
+
+#endif
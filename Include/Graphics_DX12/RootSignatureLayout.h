@@ -0,0 +1,171 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Data-driven root signature layout and builder (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Unbounded descriptor ranges
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ROOT_SIGNATURE_LAYOUT
+#define M_ROOT_SIGNATURE_LAYOUT
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    // 列挙値はすべてD3D12と同じ値で持つ(デバイスなしで扱えるように)
+    constexpr uint32_t MAX_ROOT_SIGNATURE_DWORDS = 64;          // D3D12の上限
+    // これを超えるとドライバーがルート引数の一部をメモリに逃がすため、切り替えが遅くなる目安
+    constexpr uint32_t ROOT_SIGNATURE_FAST_PATH_DWORDS = 16;
+    constexpr uint32_t DESCRIPTOR_RANGE_OFFSET_APPEND = 0xffffffff;   // D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND
+    // ヒープの終わりまで続くレンジ(バインドレス用、後ろにAPPENDのレンジは置けない)
+    constexpr uint32_t DESCRIPTOR_RANGE_UNBOUNDED = 0xffffffff;
+
+    enum class RootParameterType : uint8_t
+    {
+      DescriptorTable = 0,      // D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE
+      Constants = 1,            // D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS
+      CBV = 2,                  // D3D12_ROOT_PARAMETER_TYPE_CBV
+      SRV = 3,                  // D3D12_ROOT_PARAMETER_TYPE_SRV
+      UAV = 4,                  // D3D12_ROOT_PARAMETER_TYPE_UAV
+    };
+
+    enum class DescriptorRangeType : uint8_t
+    {
+      SRV = 0,                  // D3D12_DESCRIPTOR_RANGE_TYPE_SRV
+      UAV = 1,                  // D3D12_DESCRIPTOR_RANGE_TYPE_UAV
+      CBV = 2,                  // D3D12_DESCRIPTOR_RANGE_TYPE_CBV
+      Sampler = 3,              // D3D12_DESCRIPTOR_RANGE_TYPE_SAMPLER
+    };
+
+    enum class ShaderVisibility : uint8_t
+    {
+      All = 0,                  // D3D12_SHADER_VISIBILITY_ALL
+      Vertex = 1,
+      Hull = 2,
+      Domain = 3,
+      Geometry = 4,
+      Pixel = 5,
+    };
+
+    struct DescriptorRange final
+    {
+      DescriptorRangeType Type;
+      uint32_t NumDescriptors;
+      uint32_t BaseShaderRegister;
+      uint32_t RegisterSpace = 0;
+      uint32_t OffsetInDescriptorsFromTableStart = DESCRIPTOR_RANGE_OFFSET_APPEND;
+    };
+
+    struct RootParameter final
+    {
+      RootParameterType Type;
+      ShaderVisibility Visibility;
+      uint32_t ShaderRegister;        // テーブル以外
+      uint32_t RegisterSpace;         // テーブル以外
+      uint32_t Num32BitValues;        // Constantsのみ
+      std::vector<DescriptorRange> Ranges;   // DescriptorTableのみ
+    };
+
+    struct StaticSampler final
+    {
+      uint32_t Filter = 0x15;         // D3D12_FILTER_MIN_MAG_MIP_LINEAR
+      uint8_t AddressU = 1;           // D3D12_TEXTURE_ADDRESS_MODE_WRAP
+      uint8_t AddressV = 1;
+      uint8_t AddressW = 1;
+      float MipLODBias = 0.0f;
+      uint32_t MaxAnisotropy = 1;
+      uint8_t ComparisonFunc = 1;     // D3D12_COMPARISON_FUNC_NEVER
+      uint8_t BorderColor = 0;        // D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK
+      float MinLOD = 0.0f;
+      float MaxLOD = 3.402823466e+38f; // D3D12_FLOAT32_MAX
+      uint32_t ShaderRegister = 0;
+      uint32_t RegisterSpace = 0;
+      ShaderVisibility Visibility = ShaderVisibility::Pixel;
+    };
+
+    /// @brief
+    /// ルートシグネチャーの構成
+    struct RootSignatureLayout final
+    {
+      std::vector<RootParameter> Parameters;
+      std::vector<StaticSampler> StaticSamplers;
+      uint32_t Flags = 0;             // D3D12_ROOT_SIGNATURE_FLAGS
+
+      /// @brief
+      /// 正規形に直して書き出す
+      /// テーブルのAPPENDは実際のオフセットに解決し、静的サンプラーはレジスター順に並べる
+      /// (意味が同じレイアウトは同じバイト列になる)
+      void Serialize(std::vector<uint8_t>& outBytes) const;
+      uint64_t ComputeHash(void) const;
+
+      /// @brief
+      /// ルート引数のサイズ(DWORD単位)
+      /// 定数は値の数、ルートディスクリプタは2、テーブルは1
+      uint32_t GetSizeInDWords(void) const;
+
+      /// @brief
+      /// 上限や高速パスを超えていないか調べる
+      /// @param outMessages 警告・エラーメッセージの追加先(nullptr可)
+      /// @return 作成できない(上限超え)ならfalse
+      bool Validate(std::vector<std::string>* outMessages = nullptr) const;
+    };
+
+    /// @brief
+    /// ルートシグネチャーの構成を組み立てる
+    class RootSignatureBuilder final
+    {
+      public:
+        RootSignatureBuilder();
+
+        RootSignatureBuilder& AddConstants(uint32_t num32BitValues, uint32_t shaderRegister, uint32_t registerSpace = 0, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddConstantBufferView(uint32_t shaderRegister, uint32_t registerSpace = 0, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddShaderResourceView(uint32_t shaderRegister, uint32_t registerSpace = 0, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddUnorderedAccessView(uint32_t shaderRegister, uint32_t registerSpace = 0, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddDescriptorTable(std::initializer_list<DescriptorRange> ranges, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddDescriptorTable(const std::vector<DescriptorRange>& ranges, ShaderVisibility visibility = ShaderVisibility::All);
+        RootSignatureBuilder& AddStaticSampler(const StaticSampler& sampler);
+        RootSignatureBuilder& SetFlags(uint32_t flags);
+
+        const RootSignatureLayout& GetLayout(void) const;
+        /// @brief
+        /// 次に追加するパラメーターのインデックス(SetGraphicsRoot*に渡す番号)
+        uint32_t GetNextParameterIndex(void) const;
+
+      private:
+        RootSignatureBuilder& addRootDescriptor(RootParameterType, uint32_t, uint32_t, ShaderVisibility);
+
+      private:
+        RootSignatureLayout m_layout;
+    };
+
+    inline const RootSignatureLayout& RootSignatureBuilder::GetLayout() const
+    {
+      return m_layout;
+    }
+
+    inline uint32_t RootSignatureBuilder::GetNextParameterIndex() const
+    {
+      return static_cast<uint32_t>(m_layout.Parameters.size());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : On-disk shader compilation cache (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_COMPILE_CACHE
+#define M_SHADER_COMPILE_CACHE
+
+#include <ClassBaseInc.h>
+#include <Graphics_DX12/ShaderPreprocessor.h>
+#include <Graphics_DX12/ShaderIncludeGraph.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// シェーダーのコンパイル設定
+    struct ShaderCompileDesc final
+    {
+      std::string SourcePath;
+      std::string EntryPoint;
+      std::string Target;                     // "vs_5_1"など
+      std::vector<ShaderDefine> Defines;
+      std::vector<std::string> IncludeDirs;
+      uint32_t Flags;                         // D3DCOMPILE_*
+    };
+
+    /// @brief
+    /// コンパイル済みシェーダーをディスクに保存するキャッシュ
+    /// キーは展開・正規化したソース、定義、エントリーポイント、ターゲット、フラグのハッシュ値
+    /// インクルードファイルが変わればキーも変わるので、影響を受けるシェーダーだけが再コンパイルされる
+    /// 一件を一ファイル(<キー>.shc)として保存する
+    class ShaderCompileCache final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ShaderCompileCache)
+
+      public:
+        /// @brief
+        /// キャッシュディレクトリを指定する(なければ作る)
+        bool Init(const std::string& cacheDirectory);
+
+        /// @brief
+        /// ソースを前処理してキーを求め、依存グラフを更新する
+        /// @param desc コンパイル設定
+        /// @param outKey キー
+        /// @param outShader 前処理結果(nullptr可)
+        /// @param outError 失敗時のメッセージ(nullptr可)
+        bool PrepareKey(const ShaderCompileDesc& desc, uint64_t& outKey, PreprocessedShader* outShader = nullptr, std::string* outError = nullptr);
+
+        /// @brief
+        /// 前処理済みソースのハッシュ値と設定からキーを求める
+        static uint64_t ComputeKey(const ShaderCompileDesc& desc, uint64_t sourceHash);
+
+        /// @brief
+        /// バイトコードを取得する
+        /// @return 見つかり、内容が壊れていなければtrue
+        bool Find(uint64_t key, std::vector<uint8_t>& outBytecode);
+        bool Store(uint64_t key, const void* data, size_t size);
+
+        /// @brief
+        /// 変更されたファイルの影響を受けるシェーダーを求める
+        size_t CollectAffected(const std::string& changedPath, std::vector<std::string>& outSources) const;
+
+        const ShaderIncludeGraph& GetIncludeGraph(void) const;
+        const std::string& GetDirectory(void) const;
+        uint64_t GetHitCount(void) const;
+        uint64_t GetMissCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        std::string makeFilePath(uint64_t key) const;
+
+      private:
+        std::string m_directory;
+        ShaderIncludeGraph m_includeGraph;
+        std::atomic<uint64_t> m_hitCount;
+        std::atomic<uint64_t> m_missCount;
+    };
+
+    inline const ShaderIncludeGraph& ShaderCompileCache::GetIncludeGraph() const
+    {
+      return m_includeGraph;
+    }
+
+    inline const std::string& ShaderCompileCache::GetDirectory() const
+    {
+      return m_directory;
+    }
+
+    inline uint64_t ShaderCompileCache::GetHitCount() const
+    {
+      return m_hitCount.load(std::memory_order_relaxed);
+    }
+
+    inline uint64_t ShaderCompileCache::GetMissCount() const
+    {
+      return m_missCount.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+#endif
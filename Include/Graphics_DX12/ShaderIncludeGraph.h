@@ -0,0 +1,72 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Shader include dependency graph (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_INCLUDE_GRAPH
+#define M_SHADER_INCLUDE_GRAPH
+
+#include <ClassBaseInc.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// シェーダーソースとインクルードファイルの依存関係
+    /// ファイルが変更されたとき、再コンパイルが必要なシェーダーだけを求める
+    class ShaderIncludeGraph final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ShaderIncludeGraph)
+
+      public:
+        /// @brief
+        /// シェーダーの依存ファイルを置き換える(前処理のたびに呼ぶ)
+        /// @param sourcePath シェーダーファイル(正規化したパス)
+        /// @param dependencies 展開したすべてのインクルードファイル
+        void Update(const std::string& sourcePath, const std::vector<std::string>& dependencies);
+        void Remove(const std::string& sourcePath);
+
+        /// @brief
+        /// 変更されたファイルの影響を受けるシェーダーを求める
+        /// @param changedPath 変更されたファイル(シェーダー自身でもよい)
+        /// @param outSources 追加先
+        /// @return 追加した数
+        size_t CollectAffected(const std::string& changedPath, std::vector<std::string>& outSources) const;
+
+        bool GetDependencies(const std::string& sourcePath, std::vector<std::string>& outDependencies) const;
+        size_t GetSourceCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        void unlink(const std::string& sourcePath);
+
+      private:
+        std::unordered_map<std::string, std::vector<std::string>> m_dependencies;         // シェーダー -> インクルード
+        std::unordered_map<std::string, std::unordered_set<std::string>> m_dependents;    // インクルード -> シェーダー
+        mutable std::mutex m_mutex;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,97 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Memory-mapped packed shader library reader (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_LIBRARY
+#define M_SHADER_LIBRARY
+
+#include <ClassBaseInc.h>
+#include <Graphics_DX12/ShaderLibraryFormat.h>
+#include <MappedFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// ライブラリ内のバイトコードを指すビュー(マップしたメモリを直接指す)
+    struct ShaderBytecodeView final
+    {
+      const void* Data;
+      size_t Size;
+
+      bool IsValid(void) const
+      {
+        return Data != nullptr;
+      }
+    };
+
+    /// @brief
+    /// ShaderLibraryBuilderが書き出したライブラリをメモリマップで読む
+    /// 検索はキー順インデックスの二分探索で、バイトコードはコピーせずにポインターを返す
+    /// 返したポインターはDisposeまで有効
+    class ShaderLibrary final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ShaderLibrary)
+
+      public:
+        /// @brief
+        /// ファイルをマップしてヘッダーとインデックスを検証する
+        /// @param filePath ライブラリファイル
+        /// @param isVerifyBytecode バイトコードのハッシュも検証する(全体を読むので遅い)
+        bool Open(const std::string& filePath, bool isVerifyBytecode = false);
+
+        /// @brief
+        /// キーでバイトコードを探す
+        /// @return 見つからなければ無効なビュー
+        ShaderBytecodeView Find(uint64_t key) const;
+        /// @brief
+        /// シェーダー名・エントリーポイント・定義でバイトコードを探す
+        ShaderBytecodeView Find(const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines = {}) const;
+
+        bool IsOpen(void) const;
+        uint32_t GetCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        bool validate(bool isVerifyBytecode) const;
+
+      private:
+        MappedFile m_file;
+        const ShaderLibraryEntry* m_entries;
+        uint32_t m_entryCount;
+    };
+
+    inline bool ShaderLibrary::IsOpen() const
+    {
+      return m_entries != nullptr;
+    }
+
+    inline uint32_t ShaderLibrary::GetCount() const
+    {
+      return m_entryCount;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed shader library file format (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_LIBRARY_FORMAT
+#define M_SHADER_LIBRARY_FORMAT
+
+#include <Graphics_DX12/ShaderPreprocessor.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    // ファイル形式
+    // [ヘッダー][キー順に並べたインデックス][アライメントしたバイトコード...]
+    // ポインターを含まないので、マップしたメモリをそのまま参照できる
+    constexpr uint32_t SHADER_LIBRARY_MAGIC = 0x424c534d;       // "MSLB"
+    constexpr uint32_t SHADER_LIBRARY_VERSION = 1;
+    constexpr uint32_t SHADER_LIBRARY_BLOB_ALIGNMENT = 64;      // キャッシュライン
+
+    struct ShaderLibraryHeader final
+    {
+      uint32_t Magic;
+      uint32_t Version;
+      uint32_t EntryCount;
+      uint32_t BlobAlignment;
+      uint64_t IndexOffset;
+      uint64_t FileSize;
+    };
+
+    struct ShaderLibraryEntry final
+    {
+      uint64_t Key;             // ShaderLibraryFormat::ComputeKey
+      uint64_t Offset;          // ファイル先頭から
+      uint64_t Size;
+      uint64_t BytecodeHash;    // 破損検出用
+    };
+
+    static_assert(sizeof(ShaderLibraryHeader) == 32, "ShaderLibraryHeader size must be fixed");
+    static_assert(sizeof(ShaderLibraryEntry) == 32, "ShaderLibraryEntry size must be fixed");
+
+    class ShaderLibraryFormat final
+    {
+      public:
+        /// @brief
+        /// ライブラリ内でシェーダーを引くキーを求める
+        /// 実行時にわかる情報だけで作るので、ソースの内容は含めない
+        /// @param shaderName シェーダー名(拡張子なしのファイル名)
+        /// @param entryPoint エントリーポイント
+        /// @param defines 定義(順不同)
+        static uint64_t ComputeKey(const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines);
+
+      private:
+        ShaderLibraryFormat() = delete;
+    };
+  }
+}
+
+#endif
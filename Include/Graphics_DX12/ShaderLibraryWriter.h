@@ -0,0 +1,66 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed shader library writer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_LIBRARY_WRITER
+#define M_SHADER_LIBRARY_WRITER
+
+#include <ClassBaseInc.h>
+#include <Graphics_DX12/ShaderLibraryFormat.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// バイトコードを集めて一つのライブラリファイルに書き出す
+    class ShaderLibraryWriter final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ShaderLibraryWriter)
+
+      public:
+        /// @brief
+        /// バイトコードを追加する
+        /// @return 同じキーで内容が異なるものが既にあればfalse
+        bool Add(uint64_t key, const void* data, size_t size);
+
+        /// @brief
+        /// キー順のインデックスとアライメントしたバイトコードを書き出す
+        bool WriteToFile(const std::string& filePath) const;
+
+        size_t GetCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        // キー順に並べておく
+        std::map<uint64_t, std::vector<uint8_t>> m_blobs;
+    };
+
+    inline size_t ShaderLibraryWriter::GetCount() const
+    {
+      return m_blobs.size();
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline shader permutation builder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_PERMUTATION_BUILDER
+#define M_SHADER_PERMUTATION_BUILDER
+
+#include <ClassBaseInc.h>
+#include <Graphics_DX12/ShaderCompileCache.h>
+#include <Graphics_DX12/ShaderLibraryWriter.h>
+#include <Interfaces/IShaderCompiler.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+  }
+
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// シェーダーファイル内のエントリーポイント宣言
+    /// //! shader <エントリーポイント> <ターゲット>
+    struct ShaderEntryDecl final
+    {
+      std::string EntryPoint;
+      std::string Target;
+    };
+
+    /// @brief
+    /// パーミュテーションの軸(一つの定義が取りうる値)
+    /// //! permutation <名前> <値> [<値> ...]
+    struct ShaderPermutationAxis final
+    {
+      std::string Name;
+      std::vector<std::string> Values;
+    };
+
+    /// @brief
+    /// 宣言を読み取ったシェーダーファイル
+    struct ShaderSourceInfo final
+    {
+      std::string SourcePath;
+      std::string ShaderName;       // 拡張子なしのファイル名(ライブラリのキーに使う)
+      std::vector<ShaderEntryDecl> Entries;
+      std::vector<ShaderPermutationAxis> Axes;
+    };
+
+    struct ShaderLibraryBuildStats final
+    {
+      uint32_t SourceCount;
+      uint32_t PermutationCount;
+      uint32_t CompiledCount;
+      uint32_t CacheHitCount;
+      uint32_t FailedCount;
+    };
+
+    /// @brief
+    /// ディレクトリ内のシェーダーを走査し、定義の組み合わせをすべて並列にコンパイルしてライブラリにまとめる
+    /// コンパイラーはIShaderCompilerで差し替えられる(Linuxでは代替コンパイラーで動かす)
+    class ShaderPermutationBuilder final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ShaderPermutationBuilder)
+
+      public:
+        /// @brief
+        /// ディレクトリ以下の.hlslを走査する(宣言のないファイルは無視する)
+        bool ScanDirectory(const std::string& directory);
+
+        /// @brief
+        /// シェーダーファイルを一つ追加する
+        /// @return 宣言が不正ならfalse(宣言がないだけならtrue)
+        bool AddSource(const std::string& sourcePath);
+
+        void SetIncludeDirs(const std::vector<std::string>& includeDirs);
+        void SetCompileFlags(uint32_t flags);
+        /// @brief
+        /// コンパイル結果のキャッシュを使う(nullptrで使わない)
+        void SetCache(ShaderCompileCache* cache);
+
+        /// @brief
+        /// すべてのパーミュテーションをコンパイルしてライブラリに追加する
+        /// @param compiler コンパイラー(スレッドセーフであること)
+        /// @param threadPool 並列化に使うスレッドプール(nullptrなら呼び出したスレッドのみ)
+        /// @param outWriter 追加先
+        /// @return すべて成功したらtrue
+        bool Build(const IShaderCompiler& compiler, ThreadPool* threadPool, ShaderLibraryWriter& outWriter);
+
+        /// @brief
+        /// ソース中の//!宣言を読み取る
+        /// @return 書式が不正ならfalse
+        static bool ParseAnnotations(const std::string& source, std::vector<ShaderEntryDecl>& outEntries, std::vector<ShaderPermutationAxis>& outAxes, std::string* outError = nullptr);
+
+        /// @brief
+        /// 軸の直積を列挙する(軸がなければ空の組み合わせ一つ)
+        static void ExpandPermutations(const std::vector<ShaderPermutationAxis>& axes, std::vector<std::vector<ShaderDefine>>& outPermutations);
+
+        const std::vector<ShaderSourceInfo>& GetSources(void) const;
+        const std::vector<std::string>& GetErrors(void) const;
+        const ShaderLibraryBuildStats& GetStats(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct PermutationJob
+        {
+          size_t SourceIndex;
+          ShaderCompileDesc Desc;
+          uint64_t LibraryKey;
+        };
+
+        struct JobResult
+        {
+          std::vector<uint8_t> Bytecode;
+          std::string Error;
+          bool IsSucceeded;
+          bool IsCacheHit;
+        };
+
+      private:
+        std::vector<ShaderSourceInfo> m_sources;
+        std::vector<std::string> m_includeDirs;
+        std::vector<std::string> m_errors;
+        ShaderCompileCache* m_cache;
+        ShaderLibraryBuildStats m_stats;
+        uint32_t m_compileFlags;
+    };
+
+    inline const std::vector<ShaderSourceInfo>& ShaderPermutationBuilder::GetSources() const
+    {
+      return m_sources;
+    }
+
+    inline const std::vector<std::string>& ShaderPermutationBuilder::GetErrors() const
+    {
+      return m_errors;
+    }
+
+    inline const ShaderLibraryBuildStats& ShaderPermutationBuilder::GetStats() const
+    {
+      return m_stats;
+    }
+  }
+}
+
+#endif
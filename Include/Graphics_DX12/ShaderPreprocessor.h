@@ -0,0 +1,98 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : HLSL include expander for shader cache keys (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_SHADER_PREPROCESSOR
+#define M_SHADER_PREPROCESSOR
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// シェーダーの#define一つ分
+    struct ShaderDefine final
+    {
+      std::string Name;
+      std::string Value;
+    };
+
+    /// @brief
+    /// ソース中の#include一つ分
+    struct ShaderIncludeDirective final
+    {
+      std::string Name;
+      bool IsSystem;      // <...>ならtrue
+      uint32_t Line;      // 1始まり
+    };
+
+    /// @brief
+    /// インクルードを展開し正規化したソース
+    struct PreprocessedShader final
+    {
+      std::string Source;                     // インクルード展開・コメント除去・空白正規化済み
+      std::vector<std::string> Dependencies;  // 展開したインクルードファイル(正規化したパス、出現順)
+      uint64_t SourceHash;                    // Sourceのハッシュ値
+    };
+
+    /// @brief
+    /// キャッシュキーを求めるための軽量なプリプロセッサ
+    /// #includeの展開と、コメント・空白の正規化だけを行う(#if等のマクロ評価はしない)
+    /// そのため結果は保守的で、無効な分岐の変更でも再コンパイルになるが古いバイナリを使うことはない
+    class ShaderPreprocessor final
+    {
+      public:
+        /// @brief
+        /// ファイルを読み込んでインクルードを展開する
+        /// @param sourcePath シェーダーファイル
+        /// @param includeDirs <...>および見つからない"..."を探すディレクトリ
+        /// @param outShader 結果
+        /// @param outError 失敗時のメッセージ(nullptr可)
+        /// @return インクルードが見つからない・循環している場合はfalse
+        static bool Preprocess(const std::string& sourcePath, const std::vector<std::string>& includeDirs, PreprocessedShader& outShader, std::string* outError = nullptr);
+
+        /// @brief
+        /// ソース中の#includeを列挙する(コメント内は無視する)
+        static void ScanIncludes(const std::string& source, std::vector<ShaderIncludeDirective>& outIncludes);
+
+        /// @brief
+        /// コメントを除去し、空白を一つにまとめ、空行を取り除く
+        static std::string Normalize(const std::string& source);
+
+        /// @brief
+        /// インクルードファイルを探す(コンパイラー側のインクルードハンドラーもこれを使い、キーと結果を一致させる)
+        /// @param name #includeに書かれた名前
+        /// @param isSystem <...>ならtrue("..."はcurrentDirを先に探す)
+        /// @param currentDir インクルードしたファイルのディレクトリ
+        /// @param includeDirs 追加のディレクトリ
+        /// @param outPath 見つかったパス
+        static bool ResolveInclude(const std::string& name, bool isSystem, const std::string& currentDir, const std::vector<std::string>& includeDirs, std::string& outPath);
+
+        /// @brief
+        /// ファイルを丸ごと読み込む
+        static bool ReadFile(const std::string& filePath, std::string& outText);
+
+      private:
+        ShaderPreprocessor() = delete;
+    };
+  }
+}
+
+#endif
@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : Shader Blob Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/10 Create
+                2026/10/19 Compile through ShaderCompileCache
+                           Replace per-shader .cso lookup with ShaderLibrary
 
 Version : alpha_1.0.0
 
@@ -19,6 +21,11 @@ Encoding : UTF-8
 #define M_DX12_SHADER_RES
 
 #include "GraphicsClassBaseInclude.h"
+#include <Graphics_DX12/ShaderLibrary.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
 
 struct ID3D10Blob;
 
@@ -26,29 +33,71 @@ namespace MFramework
 {
   inline namespace MGraphics_DX12
   {
+    struct ShaderCompileDesc;
+    class ShaderCompileCache;
+
+    /// @brief
+    /// シェーダーのバイトコード
+    /// ライブラリから読み込んだ場合はマップしたメモリを直接指す(ライブラリより先に破棄すること)
     class ShaderResBlob final : public IDisposable
     {
       GENERATE_CLASS_NO_COPY(ShaderResBlob)
 
       public:
-        bool InitFromCSO(const wchar_t* fileName);
+        /// @brief
+        /// パック済みライブラリから取得する(コピーしない)
+        /// @param library 開いたライブラリ
+        /// @param shaderName シェーダー名(拡張子なしのファイル名)
+        /// @param entryPoint エントリーポイント
+        /// @param defines パーミュテーションの定義
+        bool InitFromLibrary(const ShaderLibrary& library, const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines = {});
         bool InitFromFile(const wchar_t* fileName, 
                           const char* entryPoint,
                           const char* shaderModel 
                          );
+        /// @brief
+        /// キャッシュを通してコンパイルする
+        /// キャッシュにあればコンパイルせずに読み込み、なければコンパイルして保存する
+        /// @param desc コンパイル設定
+        /// @param cache キャッシュ(nullptrなら毎回コンパイルする)
+        bool InitFromFile(const ShaderCompileDesc& desc, ShaderCompileCache* cache);
+        /// @brief
+        /// バイトコードをコピーして作成する
+        bool InitFromMemory(const void* data, size_t size);
+
+        /// @brief
+        /// ビルド構成に合わせたコンパイルフラグ(D3DCOMPILE_*)
+        static uint32_t GetDefaultCompileFlags(void);
+
+      public:
+        /// @brief
+        /// コンパイルした場合のブロブ(ライブラリから取得した場合はnullptr)
         ID3D10Blob* Get(void) const;
+        const void* GetBufferPointer(void) const;
+        size_t GetBufferSize(void) const;
 
       public:
         void Dispose(void) noexcept override;
 
       private:
         ComPtr<ID3D10Blob> m_shaderBlob;
+        ShaderBytecodeView m_bytecode;
     };
 
     inline ID3D10Blob* ShaderResBlob::Get() const
     {
       return m_shaderBlob.Get();
     }
+
+    inline const void* ShaderResBlob::GetBufferPointer() const
+    {
+      return m_bytecode.Data;
+    }
+
+    inline size_t ShaderResBlob::GetBufferSize() const
+    {
+      return m_bytecode.Size;
+    }
   }
 }
 
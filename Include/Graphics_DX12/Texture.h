@@ -19,6 +19,7 @@ Encoding : UTF-8
 
 #include "GraphicsClassBaseInclude.h"
 #include <Graphics_DX12/DescriptorHandle.h>
+#include <Graphics_DX12/ResourceStateTracker.h>
 
 struct ID3D12Resource;
 struct ID3D12Device;
@@ -59,6 +60,7 @@ namespace MFramework
       private:
         ComPtr<ID3D12Resource> m_tex;
         DescriptorHandle m_handle;
+        ResourceStateRegistry* m_stateRegistry;
     };
 
     inline ID3D12Resource* Texture::Get() const
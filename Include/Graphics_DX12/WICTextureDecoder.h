@@ -0,0 +1,62 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : WIC texture decoder of texture streamer (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Generate mip chains at import
+                2026/10/19 Read cooked textures (.mtex) without WIC
+                2026/10/19 Read block-compressed textures from DDS files
+                2026/10/19 Parse DDS files without DirectXTex when possible
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_WIC_TEXTURE_DECODER
+#define M_WIC_TEXTURE_DECODER
+
+#include "GraphicsClassBaseInclude.h"
+#include <Interfaces/ITextureDecoder.h>
+#include <RenderSystem/MipGenerator.h>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// DirectXTexのLoadFromWICFileでPNG/JPEGなどをデコードする
+    /// パスはFileUtility::SearchFilePathと同じ規則で探す
+    /// ワーカースレッドごとにCOMを初期化してから呼ぶ
+    /// ミップ生成を有効にすると、ミップを一つしか持たない画像はRGBAに変換してミップチェーンを生成する
+    /// 拡張子が.mtexのファイルはTextureCookerの出力としてWICを通さずに読む
+    /// 拡張子が.ddsのファイルはDdsTextureDecoderで読み、変換が必要な旧形式だけLoadFromDDSFileを使う
+    class WICTextureDecoder final : public ITextureDecoder
+    {
+      public:
+        WICTextureDecoder();
+
+        /// @brief
+        /// ミップ生成を有効にする(Decodeを呼ぶ前に設定する)
+        /// @param desc 生成の設定
+        /// @param threadPool 縮小を分担するスレッドプール(nullptrならデコードしたスレッドだけで処理する)
+        void EnableMipGeneration(const MipGenerateDesc& desc, ThreadPool* threadPool);
+
+      public:
+        bool Decode(const std::string& path, TextureData& outData, std::string& outError) const override;
+
+      private:
+        MipGenerateDesc m_mipDesc;
+        ThreadPool* m_threadPool;
+        bool m_isGenerateMips;
+    };
+  }
+}
+
+#endif
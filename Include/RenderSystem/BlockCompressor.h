@@ -0,0 +1,104 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU block compression encoder (BC1/BC3/BC5/BC7) (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 BC7 modes 4 and 5
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_BLOCK_COMPRESSOR
+#define M_BLOCK_COMPRESSOR
+
+#include <RenderSystem/TextureData.h>
+
+#include <cstdint>
+#include <string>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+  }
+
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 圧縮フォーマット
+    enum class BlockCompressFormat : uint8_t
+    {
+      BC1,      // RGB(1bitアルファ) 4bpp
+      BC3,      // RGBA 8bpp(アルファはBC4と同じ形式)
+      BC5,      // RG 8bpp(法線マップ向け)
+      BC7,      // RGBA 8bpp(1サブセットのモード4/5/6をブロックごとに選ぶ)
+    };
+
+    /// @brief
+    /// 品質と速度のプリセット
+    enum class BlockCompressQuality : uint8_t
+    {
+      Fast,     // 範囲の両端を端点にする(BC7はモード6のみ)
+      Normal,   // 主成分分析で端点を求め、最小二乗法で一回補正する(BC7はモード5/6)
+      High,     // Normalに加えて補正を繰り返し、端点の候補を広く探す(BC7はモード4/5/6とすべてのローテーション)
+    };
+
+    /// @brief
+    /// 圧縮の設定
+    struct BlockCompressDesc final
+    {
+      BlockCompressFormat Format;
+      BlockCompressQuality Quality;
+      bool IsSRGB;                      // _SRGBフォーマットで出力する(元が_SRGBなら常にそうする、BC5は無視)
+    };
+
+    /// @brief
+    /// 4x4ブロック単位でテクスチャを圧縮する
+    /// 対応する元フォーマットはR8G8B8A8/B8G8R8A8(UNORM/SRGB)の2Dテクスチャまたは2D配列
+    /// スレッドプールを渡すとブロック行ごとにワーカーで分担する
+    class BlockCompressor final
+    {
+      public:
+        static bool IsSupportedSourceFormat(uint32_t format);
+
+        /// @brief
+        /// 出力するDXGI_FORMATを取得する
+        static uint32_t GetCompressedFormat(BlockCompressFormat format, bool isSRGB);
+
+        /// @brief
+        /// すべてのサブリソースを圧縮する
+        /// @param src 元データ(ミップ0の幅と高さは4の倍数であること)
+        /// @param desc 設定
+        /// @param outData 出力先(行は詰めて並べる)
+        /// @param outError 失敗した理由
+        /// @param threadPool nullptrなら呼び出したスレッドだけで処理する
+        static bool Compress(const TextureData& src, const BlockCompressDesc& desc, TextureData& outData, std::string& outError, ThreadPool* threadPool = nullptr);
+
+        /// @brief
+        /// R8G8B8A8に展開する(BC1/BC3/BC5と、BC7はモード4/5/6のブロックだけ)
+        static bool Decompress(const TextureData& src, TextureData& outData, std::string& outError);
+
+        /// @brief
+        /// 圧縮前と展開後を比べたPSNR(dB)を求める
+        /// フォーマットが持つチャンネルだけを比べる(BC1はRGB、BC5はRG)
+        /// @param reference 圧縮前のデータ
+        /// @param compressed Compressの出力
+        /// @param outPSNR 誤差がなければ無限大
+        static bool ComputePSNR(const TextureData& reference, const TextureData& compressed, double& outPSNR, std::string& outError);
+
+      private:
+        BlockCompressor() = delete;
+    };
+  }
+}
+
+#endif
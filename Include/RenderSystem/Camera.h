@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : Camera
 
 Update History: 2024/11/11 Create
+                2026/10/19 Perspective camera and frustum planes
 
 Version : alpha_1.0.0
 
@@ -18,15 +19,64 @@ Encoding : UTF-8
 #ifndef M_CAMERA
 #define M_CAMERA
 
+#include <cstdint>
+
 namespace MGameEngine
 {
   inline namespace CoreModule
   {
+    constexpr uint32_t CAMERA_FRUSTUM_PLANE_COUNT = 6;
+
+    /// @brief
+    /// 透視投影のカメラ(左手系、深度は0～1でDirectXMathのLH関数と同じ行列になる)
+    /// 行列は行優先・行ベクトル(v * M)で、そのままXMMATRIXに読み込める
     class Camera final
     {
+      public:
+        Camera();
+
+        /// @brief
+        /// 位置と注視点から向きを決める
+        void SetLookAt(const float eye[3], const float target[3], const float up[3]);
+
+        /// @brief
+        /// 投影を決める
+        /// @param fovY 縦の画角(ラジアン)
+        void SetPerspective(float fovY, float aspectRatio, float nearZ, float farZ);
+
+        const float* GetPosition(void) const;
+        const float* GetForward(void) const;
+        const float* GetRight(void) const;
+        const float* GetUp(void) const;
+        float GetFovY(void) const;
+        float GetAspectRatio(void) const;
+        float GetNearZ(void) const;
+        float GetFarZ(void) const;
+
+        void GetViewMatrix(float outMatrix[16]) const;
+        void GetProjectionMatrix(float outMatrix[16]) const;
+        void GetViewProjectionMatrix(float outMatrix[16]) const;
+
+        /// @brief
+        /// 視錐台の6平面(近、遠、左、右、下、上の順)
+        /// 平面は(nx, ny, nz, d)で法線は内向きの単位ベクトル、dot(n, p) + d >= 0なら内側
+        void GetFrustumPlanes(float outPlanes[CAMERA_FRUSTUM_PLANE_COUNT][4]) const;
+
+        /// @brief
+        /// 距離1にある長さ1がスクリーン上で何ピクセルになるか(距離で割ると投影後の大きさになる)
+        float GetProjectionScale(float viewportHeight) const;
 
+      private:
+        float m_position[3];
+        float m_forward[3];
+        float m_right[3];
+        float m_up[3];
+        float m_fovY;
+        float m_aspectRatio;
+        float m_nearZ;
+        float m_farZ;
     };
   }
 }
 
-#endif
\ No newline at end of file
+#endif
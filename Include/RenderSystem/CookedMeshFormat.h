@@ -0,0 +1,170 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked mesh file format (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Quantized vertex formats
+                2026/10/19 Meshlets
+                2026/10/19 LOD chain
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_COOKED_MESH_FORMAT
+#define M_COOKED_MESH_FORMAT
+
+#include <RenderSystem/MeshData.h>
+#include <RenderSystem/MeshletBuilder.h>
+#include <RenderSystem/MeshSimplifier.h>
+#include <RenderSystem/VertexFormat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    // ファイル形式(.mmsh)
+    // [ヘッダー][メッシュ表 x メッシュ数][文字列表][パディング][データ]
+    // データにはメッシュごとに頂点(ヘッダーのVertexFormatの形)とインデックスが並ぶ
+    // 頂点が65536個未満のメッシュは16bitインデックスで持つ(DXGI_FORMAT_R16_UINTでそのまま使える)
+    // 位置をUNorm16x4で持つ場合はメッシュのバウンディングボックスが量子化パラメーターになる(VertexQuantizer::CreateQuantization)
+    // メッシュレットがある場合はMeshletOffsetから[Meshlet x 数][MeshletBounds x 数][頂点番号(uint32)][三角形(uint8 x 3)]が並ぶ
+    // LODはLodOffsetからCookedMeshLodの表が並び、0番は元のインデックスを指す(どのレベルも同じ頂点を使う)
+    constexpr uint32_t COOKED_MESH_MAGIC = 0x48534d4d;          // "MMSH"
+    constexpr uint32_t COOKED_MESH_VERSION = 4;
+    constexpr uint32_t COOKED_MESH_DATA_ALIGNMENT = 16;
+
+    struct CookedMeshHeader final
+    {
+      uint32_t Magic;
+      uint32_t Version;
+      uint32_t MeshCount;
+      uint32_t VertexStride;          // VertexLayout::Stride
+      uint8_t PositionFormat;         // VertexElementFormat
+      uint8_t NormalFormat;
+      uint8_t TexCoordFormat;
+      uint8_t Reserved0;
+      uint32_t Reserved1;
+      uint64_t MeshTableOffset;       // ファイル先頭から
+      uint64_t StringTableOffset;     // ファイル先頭から
+      uint64_t StringTableSize;
+      uint64_t DataOffset;            // ファイル先頭から(COOKED_MESH_DATA_ALIGNMENTの倍数)
+      uint64_t DataSize;
+      uint64_t DataHash;              // 破損検出用
+    };
+
+    struct CookedMeshEntry final
+    {
+      uint64_t VertexOffset;          // データの先頭から
+      uint64_t IndexOffset;           // データの先頭から
+      uint32_t VertexCount;
+      uint32_t IndexCount;
+      uint32_t IndexStride;           // 2か4
+      uint32_t NameOffset;            // 文字列表の先頭から
+      uint32_t NameLength;
+      uint32_t MaterialNameOffset;
+      uint32_t MaterialNameLength;
+      float BoundsMin[3];
+      float BoundsMax[3];
+      uint32_t MeshletCount;          // 0ならメッシュレットなし
+      uint64_t MeshletOffset;         // データの先頭から
+      uint32_t MeshletVertexIndexCount;
+      uint32_t MeshletPrimitiveIndexCount;
+      uint32_t LodCount;              // 元のメッシュを含む(1以上)
+      uint32_t Reserved;
+      uint64_t LodOffset;             // データの先頭から
+    };
+
+    /// @brief
+    /// LOD一つのインデックス(形はCookedMeshEntry::IndexStride)
+    struct CookedMeshLod final
+    {
+      uint64_t IndexOffset;           // データの先頭から
+      uint32_t IndexCount;
+      float Error;                    // 元の面からのずれ(メッシュの座標、MeshLodSelectorに渡す)
+    };
+
+    static_assert(sizeof(CookedMeshHeader) == 72, "CookedMeshHeader size must be fixed");
+    static_assert(sizeof(CookedMeshEntry) == 104, "CookedMeshEntry size must be fixed");
+    static_assert(sizeof(CookedMeshLod) == 16, "CookedMeshLod size must be fixed");
+
+    /// @brief
+    /// マップしたファイルを指すビュー(コピーしない)
+    struct CookedMeshView final
+    {
+      const CookedMeshHeader* Header;
+      const CookedMeshEntry* Meshes;
+      const char* Strings;
+      const uint8_t* Data;
+      VertexLayout Layout;
+    };
+
+    class CookedMeshFormat final
+    {
+      public:
+        /// @brief
+        /// メッシュをファイルの内容に変換する
+        /// @param meshes 最適化済みのメッシュ
+        /// @param meshlets メッシュごとのメッシュレット(空ならメッシュレットなし)
+        /// @param lods メッシュごとの元のメッシュを除いたLOD(空ならLODなし)
+        /// @param vertexFormat 頂点の持ち方
+        /// @param outFile ファイルの内容
+        /// @param outError 失敗した理由
+        static bool Serialize(const std::vector<MeshData>& meshes, const std::vector<MeshletData>& meshlets, const std::vector<std::vector<MeshLod>>& lods, const VertexFormatDesc& vertexFormat, std::vector<uint8_t>& outFile, std::string& outError);
+
+        /// @brief
+        /// ファイルに書き出す(一時ファイルに書いてから置き換える)
+        static bool WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file);
+
+        /// @brief
+        /// ファイルの内容を検証してビューを作る
+        /// @param data ファイルの先頭
+        /// @param size バイト数
+        /// @param outView ビュー(dataが有効な間だけ使える)
+        /// @param outError 失敗した理由
+        /// @param isVerifyData データのハッシュとインデックス(メッシュレットとLODを含む)の範囲も確認する
+        static bool Parse(const uint8_t* data, size_t size, CookedMeshView& outView, std::string& outError, bool isVerifyData = false);
+
+        static std::string_view GetName(const CookedMeshView& view, uint32_t meshIndex);
+        static std::string_view GetMaterialName(const CookedMeshView& view, uint32_t meshIndex);
+
+        /// @brief
+        /// 位置の量子化パラメーター(シェーダーに渡して戻す)
+        static VertexQuantization GetQuantization(const CookedMeshView& view, uint32_t meshIndex);
+
+        /// @brief
+        /// メッシュ一つをMeshDataに展開する(頂点は量子化を戻し、インデックスは32bitになる)
+        static void ReadMesh(const CookedMeshView& view, uint32_t meshIndex, MeshData& outMesh);
+
+        /// @brief
+        /// LOD一つの位置と誤差(0番は元のメッシュ)
+        static CookedMeshLod GetLod(const CookedMeshView& view, uint32_t meshIndex, uint32_t lodIndex);
+
+        /// @brief
+        /// LOD一つのインデックスを32bitにして読み出す
+        static void ReadLodIndices(const CookedMeshView& view, uint32_t meshIndex, uint32_t lodIndex, std::vector<uint32_t>& outIndices);
+
+        /// @brief
+        /// メッシュ一つのメッシュレットをコピーする(なければ空になる)
+        static void ReadMeshlets(const CookedMeshView& view, uint32_t meshIndex, MeshletData& outMeshlets);
+
+      private:
+        CookedMeshFormat() = delete;
+    };
+  }
+}
+
+#endif
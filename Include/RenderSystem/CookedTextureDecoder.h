@@ -0,0 +1,45 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked texture (.mtex) decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_COOKED_TEXTURE_DECODER
+#define M_COOKED_TEXTURE_DECODER
+
+#include <Interfaces/ITextureDecoder.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// TextureCookerが書き出した.mtexを読み込む
+    /// ピクセルはアップロード時の配置のまま返すので、サブリソースごとのコピーは一回のmemcpyになる
+    class CookedTextureDecoder final : public ITextureDecoder
+    {
+      public:
+        bool Decode(const std::string& path, TextureData& outData, std::string& outError) const override;
+
+        /// @brief
+        /// メモリ上の.mtexをデコードする
+        static bool DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError);
+    };
+  }
+}
+
+#endif
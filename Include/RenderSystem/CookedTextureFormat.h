@@ -0,0 +1,96 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked texture file format (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_COOKED_TEXTURE_FORMAT
+#define M_COOKED_TEXTURE_FORMAT
+
+#include <RenderSystem/TextureData.h>
+#include <RenderSystem/TextureFootprint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    // ファイル形式(.mtex)
+    // [ヘッダー][フットプリント x サブリソース数][パディング][データ]
+    // データはGetCopyableFootprintsの配置(オフセット0から、行ピッチ256、サブリソース先頭512)のまま並ぶので、
+    // アップロードバッファーの先頭へそのままコピー(またはファイルから直接読み込み)すればCopyTextureRegionに渡せる
+    constexpr uint32_t COOKED_TEXTURE_MAGIC = 0x5845544d;       // "MTEX"
+    constexpr uint32_t COOKED_TEXTURE_VERSION = 1;
+
+    struct CookedTextureHeader final
+    {
+      uint32_t Magic;
+      uint32_t Version;
+      TextureDesc Desc;
+      uint32_t SubresourceCount;
+      uint32_t Reserved;
+      uint64_t FootprintOffset;     // ファイル先頭から
+      uint64_t DataOffset;          // ファイル先頭から(TEXTURE_DATA_PLACEMENT_ALIGNMENTの倍数)
+      uint64_t DataSize;            // アップロードバッファーに必要なサイズ
+      uint64_t DataHash;            // 破損検出用
+    };
+
+    static_assert(sizeof(TextureDesc) == 24, "TextureDesc size must be fixed");
+    static_assert(sizeof(SubresourceFootprint) == 40, "SubresourceFootprint size must be fixed");
+    static_assert(sizeof(CookedTextureHeader) == 72, "CookedTextureHeader size must be fixed");
+
+    /// @brief
+    /// マップしたファイルを指すビュー(コピーしない)
+    struct CookedTextureView final
+    {
+      const CookedTextureHeader* Header;
+      const SubresourceFootprint* Footprints;     // オフセットはデータの先頭から
+      const uint8_t* Data;
+    };
+
+    class CookedTextureFormat final
+    {
+      public:
+        /// @brief
+        /// テクスチャをファイルの内容に変換する
+        /// @param src 元データ(行は任意のピッチでよい)
+        /// @param outFile ファイルの内容
+        /// @param outError 失敗した理由
+        static bool Serialize(const TextureData& src, std::vector<uint8_t>& outFile, std::string& outError);
+
+        /// @brief
+        /// ファイルに書き出す(一時ファイルに書いてから置き換える)
+        static bool WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file);
+
+        /// @brief
+        /// ファイルの内容を検証してビューを作る
+        /// フットプリントが今の計算結果と一致することを確認するため、GPUにそのまま渡せる
+        /// @param data ファイルの先頭
+        /// @param size バイト数
+        /// @param outView ビュー(dataが有効な間だけ使える)
+        /// @param outError 失敗した理由
+        /// @param isVerifyData データのハッシュも確認する
+        static bool Parse(const uint8_t* data, size_t size, CookedTextureView& outView, std::string& outError, bool isVerifyData = false);
+
+      private:
+        CookedTextureFormat() = delete;
+    };
+  }
+}
+
+#endif
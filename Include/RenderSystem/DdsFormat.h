@@ -0,0 +1,123 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DDS file format (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Parse DDS files without DirectXTex
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DDS_FORMAT
+#define M_DDS_FORMAT
+
+#include <RenderSystem/TextureData.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    // ファイル形式
+    // ["DDS "][DdsHeader][DdsHeaderDX10][サブリソースを配列 -> ミップの順に、行を詰めて並べたもの]
+    // 書き出すときは常にDX10拡張ヘッダーを付ける(sRGBとBC7を表せるため)
+    constexpr uint32_t DDS_MAGIC = 0x20534444;              // "DDS "
+    constexpr uint32_t DDS_FOURCC_DX10 = 0x30315844;        // "DX10"
+
+    struct DdsPixelFormat final
+    {
+      uint32_t Size;
+      uint32_t Flags;
+      uint32_t FourCC;
+      uint32_t RGBBitCount;
+      uint32_t RBitMask;
+      uint32_t GBitMask;
+      uint32_t BBitMask;
+      uint32_t ABitMask;
+    };
+
+    struct DdsHeader final
+    {
+      uint32_t Size;
+      uint32_t Flags;
+      uint32_t Height;
+      uint32_t Width;
+      uint32_t PitchOrLinearSize;
+      uint32_t Depth;
+      uint32_t MipMapCount;
+      uint32_t Reserved1[11];
+      DdsPixelFormat PixelFormat;
+      uint32_t Caps;
+      uint32_t Caps2;
+      uint32_t Caps3;
+      uint32_t Caps4;
+      uint32_t Reserved2;
+    };
+
+    struct DdsHeaderDX10 final
+    {
+      uint32_t DxgiFormat;
+      uint32_t ResourceDimension;     // D3D10_RESOURCE_DIMENSION(TextureDesc::Dimensionと同じ値)
+      uint32_t MiscFlag;
+      uint32_t ArraySize;
+      uint32_t MiscFlags2;
+    };
+
+    static_assert(sizeof(DdsPixelFormat) == 32, "DdsPixelFormat size must be fixed");
+    static_assert(sizeof(DdsHeader) == 124, "DdsHeader size must be fixed");
+    static_assert(sizeof(DdsHeaderDX10) == 20, "DdsHeaderDX10 size must be fixed");
+
+    /// @brief
+    /// マップしたファイルを指すビュー(ピクセルはコピーしない)
+    struct DdsTextureView final
+    {
+      TextureDesc Desc;                               // キューブマップは面を配列要素として数える
+      bool IsCubemap;
+      const uint8_t* Data;                            // 最初のサブリソースの先頭
+      uint64_t DataSize;
+      std::vector<SubresourceData> Subresources;      // オフセットはDataから、行は詰めて並ぶ
+    };
+
+    class DdsFormat final
+    {
+      public:
+        /// @brief
+        /// テクスチャをDDSファイルの内容に変換する(DirectXTexのLoadFromDDSFileで読める)
+        /// @param src 元データ(TextureFootprintが対応するフォーマット)
+        /// @param outFile ファイルの内容
+        /// @param outError 失敗した理由
+        static bool Serialize(const TextureData& src, std::vector<uint8_t>& outFile, std::string& outError);
+
+        /// @brief
+        /// ファイルに書き出す(一時ファイルに書いてから置き換える)
+        static bool WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file);
+
+        /// @brief
+        /// ファイルの内容を検証してビューを作る
+        /// DX10拡張ヘッダーと、よく使われる旧形式(DXT1-5/ATI1/ATI2、RGBA8/BGRA8など)に対応する
+        /// 24bitRGBなど変換が必要な形式は未対応としてfalseを返す(呼び出し側でDirectXTexに任せる)
+        /// @param data ファイルの先頭
+        /// @param size バイト数
+        /// @param outView ビュー(dataが有効な間だけ使える)
+        /// @param outError 失敗した理由
+        static bool Parse(const uint8_t* data, size_t size, DdsTextureView& outView, std::string& outError);
+
+      private:
+        DdsFormat() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DDS texture decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DDS_TEXTURE_DECODER
+#define M_DDS_TEXTURE_DECODER
+
+#include <Interfaces/ITextureDecoder.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// DDSをマップして読み込む(DirectXTexやWICを使わない)
+    /// 圧縮済み・ミップ生成済みのファイルはデコードせず、データの塊を一回コピーするだけになる
+    class DdsTextureDecoder final : public ITextureDecoder
+    {
+      public:
+        bool Decode(const std::string& path, TextureData& outData, std::string& outError) const override;
+
+        /// @brief
+        /// メモリ上のDDSをデコードする
+        static bool DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Sorted draw packet queue with 64 bit sort keys (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Encode root signature in sort keys
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DRAW_PACKET_QUEUE
+#define M_DRAW_PACKET_QUEUE
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IDrawPacketBackend.h>
+#include <RadixSort.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+  }
+
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// パスの中での描画の分類(不透明を先に描く)
+    enum class DrawBucket : uint8_t
+    {
+      Opaque = 0,
+      Transparent = 1,
+    };
+
+    /// @brief
+    /// 描画パケットの並び順を表す64ビットのキー(小さいものから描く)
+    /// 上位から
+    ///   不透明 : パス(4) | 分類(2) | ルートシグネチャー(6) | パイプラインステート(12) | マテリアル(16) | 深度(24、手前から)
+    ///   半透明 : パス(4) | 分類(2) | 深度(24、奥から) | ルートシグネチャー(6) | パイプラインステート(12) | マテリアル(16)
+    /// 不透明は状態の切り替えが少ない順、半透明は正しく重なる順を優先する
+    /// 切り替えの重いルートシグネチャーをパイプラインステートより上に置く
+    /// IDは各フィールドの下位ビットだけを使う
+    class DrawSortKey final
+    {
+      public:
+        static constexpr uint32_t PASS_BITS = 4;
+        static constexpr uint32_t BUCKET_BITS = 2;
+        static constexpr uint32_t ROOT_SIGNATURE_BITS = 6;
+        static constexpr uint32_t PIPELINE_STATE_BITS = 12;
+        static constexpr uint32_t MATERIAL_BITS = 16;
+        static constexpr uint32_t DEPTH_BITS = 24;
+
+      public:
+        /// @brief
+        /// キーを作る
+        /// @param depth 0(近クリップ面)から1(遠クリップ面)に正規化した深度
+        static uint64_t Make(uint32_t pass, DrawBucket bucket, uint32_t rootSignature, uint32_t pipelineState, uint32_t material, float depth);
+
+        /// @brief
+        /// 正規化した深度をDEPTH_BITSビットにする(範囲外は端に寄せる)
+        static uint32_t QuantizeDepth(float depth);
+
+        static uint32_t GetPass(uint64_t key);
+        static DrawBucket GetBucket(uint64_t key);
+
+      private:
+        DrawSortKey() = delete;
+    };
+
+    static_assert(DrawSortKey::PASS_BITS + DrawSortKey::BUCKET_BITS + DrawSortKey::ROOT_SIGNATURE_BITS + DrawSortKey::PIPELINE_STATE_BITS + DrawSortKey::MATERIAL_BITS + DrawSortKey::DEPTH_BITS == 64, "DrawSortKey fields must fill 64 bits");
+
+    /// @brief
+    /// 描画一回分の命令の材料
+    struct DrawPacket final
+    {
+      uint32_t RootSignature;
+      uint32_t PipelineState;
+      uint32_t Material;
+      uint32_t Mesh;
+      uint32_t InstanceCount;
+      uint32_t Reserved;
+      uint64_t InstanceDataOffset;    // インスタンスデータのリング先頭からのオフセット
+    };
+
+    struct DrawPacketStats final
+    {
+      uint32_t PacketCount;
+      uint32_t RootSignatureChangeCount;
+      uint32_t PipelineStateChangeCount;
+      uint32_t MaterialChangeCount;
+      uint32_t MeshChangeCount;
+    };
+
+    /// @brief
+    /// 描画パケットをためてキーの順に並べ、直前と変わった状態だけを設定しながらバックエンドの命令にする
+    /// 並べ替えはLSD基数ソートで、パケットが多ければスレッドプールで並列に行う
+    /// スレッドセーフではない
+    /// 
+    /// 使い方:
+    ///   Submit... -> Sort -> Translate(バックエンド) -> Clear
+    class DrawPacketQueue final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(DrawPacketQueue)
+
+      public:
+        void Reserve(size_t packetCount);
+
+        /// @brief
+        /// パケットを一つ追加する
+        /// @param sortKey DrawSortKey::Makeで作ったキー
+        void Submit(uint64_t sortKey, const DrawPacket& packet);
+
+        /// @brief
+        /// キーの順に並べ替える(同じキーはSubmitした順のまま)
+        /// @param threadPool 並列に並べ替えるスレッドプール(nullptrなら呼び出したスレッドだけで処理する)
+        void Sort(ThreadPool* threadPool = nullptr);
+
+        /// @brief
+        /// 並んでいる順にバックエンドの命令にする(Sortを呼んでいなければSubmitした順)
+        /// ルートシグネチャーを変えた後はマテリアルも設定し直す(ルートの引数は引き継がれないため)
+        DrawPacketStats Translate(IDrawPacketBackend& backend) const;
+
+        void Clear(void);
+        size_t GetPacketCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        std::vector<DrawPacket> m_packets;
+        // キーとm_packetsの番号
+        std::vector<RadixSortItem> m_items;
+        std::vector<RadixSortItem> m_tempItems;
+    };
+
+    inline size_t DrawPacketQueue::GetPacketCount() const
+    {
+      return m_packets.size();
+    }
+  }
+}
+
+#endif
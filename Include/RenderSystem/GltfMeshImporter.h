@@ -0,0 +1,41 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : glTF 2.0 mesh importer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_GLTF_MESH_IMPORTER
+#define M_GLTF_MESH_IMPORTER
+
+#include <Interfaces/IMeshImporter.h>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// glTF 2.0(.gltfと.glb)のメッシュを読み込む
+    /// プリミティブ(三角形リスト)一つを一つのメッシュにし、POSITION / NORMAL / TEXCOORD_0とインデックスを使う
+    /// バッファーはdata URI(base64)、外部ファイル、GLBのBINチャンクに対応する(スパースアクセサーは未対応)
+    /// ノードの変換は適用せず、メッシュのローカル空間のまま返す
+    /// 右手座標系(反時計回りが表)から左手座標系(時計回りが表)へ、Zの反転と巻き順の反転で変換する
+    class GltfMeshImporter final : public IMeshImporter
+    {
+      public:
+        bool Import(const std::string& path, std::vector<MeshData>& outMeshes, std::string& outError) const override;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Instanced draw batching by mesh and material (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_INSTANCE_BATCHER
+#define M_INSTANCE_BATCHER
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IInstanceDrawBackend.h>
+#include <RenderSystem/StagingRing.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// シェーダーが読むインスタンスごとのデータ(StructuredBuffer<InstanceData>と同じ並び)
+    struct InstanceData final
+    {
+      float World[16];                // ワールド行列(XMMATRIXと同じ並び)
+      uint32_t MaterialIndex;         // マテリアルのパラメーターの番号(バインドレスヒープのテクスチャのインデックスなど)
+      uint32_t Reserved[3];
+    };
+
+    static_assert(sizeof(InstanceData) == 80, "InstanceData must match the shader layout");
+
+    struct InstanceBatchStats final
+    {
+      uint32_t SubmittedCount;        // Submitしたインスタンス数
+      uint32_t DrawCount;             // 記録した描画の回数
+      uint32_t DroppedCount;          // リングに入らず描画しなかったインスタンス数
+    };
+
+    /// @brief
+    /// 描画するオブジェクトをメッシュとマテリアルでまとめ、まとまりごとに一回のインスタンス描画にする
+    /// まとまりはSubmitの時点で振り分け、Flushでは数え上げで並べるのでオブジェクト数に比例する時間で済む
+    /// インスタンスデータはバックエンドのリングにまとまりごとに連続して書き込み、フェンスが完了するまで上書きしない
+    /// スレッドセーフではない
+    /// 
+    /// 使い方:
+    ///   BeginFrame(完了済みフェンス値) -> Submit... -> Flush(描画を記録) -> EndFrame(シグナルしたフェンス値)
+    class InstanceBatcher final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(InstanceBatcher)
+
+      public:
+        bool Init(IInstanceDrawBackend* backend);
+
+        /// @brief
+        /// GPUが完了したフレームのインスタンスデータの領域を再利用できるように戻す
+        void BeginFrame(uint64_t completedFenceValue);
+
+        /// @brief
+        /// 描画するオブジェクトを一つ追加する
+        /// @param mesh バックエンドに登録したメッシュID
+        /// @param material バックエンドに登録したマテリアルID
+        /// @param world ワールド行列
+        /// @param materialIndex シェーダーに渡すマテリアルのパラメーターの番号
+        void Submit(uint32_t mesh, uint32_t material, const float world[16], uint32_t materialIndex);
+
+        /// @brief
+        /// 追加したオブジェクトをまとめてバックエンドに描画させる
+        /// まとまりはメッシュ、マテリアルの順に並び、同じまとまりの中はSubmitした順になる
+        InstanceBatchStats Flush(void);
+
+        /// @brief
+        /// 前回のEndFrame以降に書き込んだ領域を、フェンス値の完了まで使用中にする
+        void EndFrame(uint64_t signaledFenceValue);
+
+        size_t GetPendingCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        uint32_t findGroup(uint64_t key);
+        void clearSubmissions(void);
+
+      private:
+        struct Group
+        {
+          uint64_t Key;                 // 上位32ビットがメッシュ、下位32ビットがマテリアル
+          uint32_t InstanceCount;
+          uint32_t FirstOrder;          // m_orderの中の先頭
+        };
+
+      private:
+        IInstanceDrawBackend* m_backend;
+        StagingRing m_ring;
+        std::vector<InstanceData> m_instances;
+        // インスタンスごとのまとまりの番号(m_groupsの番号)
+        std::vector<uint32_t> m_instanceGroups;
+        std::vector<Group> m_groups;
+        // キーからまとまりを引くオープンアドレス法のハッシュ表(大きさは2のべき乗、空きはINVALID_GROUP)
+        std::vector<uint64_t> m_slotKeys;
+        std::vector<uint32_t> m_slotGroups;
+        // まとまりの順に並べたインスタンスの番号
+        std::vector<uint32_t> m_order;
+        std::vector<uint32_t> m_sortedGroups;
+        // 直前にSubmitしたまとまり(同じものが続く場合は探さない)
+        uint64_t m_lastKey;
+        uint32_t m_lastGroup;
+    };
+
+    inline size_t InstanceBatcher::GetPendingCount() const
+    {
+      return m_instances.size();
+    }
+  }
+}
+
+#endif
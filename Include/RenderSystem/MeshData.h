@@ -0,0 +1,53 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Imported mesh data (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESH_DATA
+#define M_MESH_DATA
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// インポート直後の頂点(量子化する前の形)
+    struct MeshVertex final
+    {
+      float Position[3];
+      float Normal[3];
+      float TexCoord[2];
+    };
+
+    static_assert(sizeof(MeshVertex) == 32, "MeshVertex size must be fixed");
+
+    /// @brief
+    /// 一つのマテリアルで描く三角形リスト
+    struct MeshData final
+    {
+      std::string Name;
+      std::string MaterialName;
+      std::vector<MeshVertex> Vertices;
+      std::vector<uint32_t> Indices;      // 3つで一つの三角形(表面は時計回り)
+      bool HasNormals;                    // falseならMeshOptimizer::ComputeNormalsで求める
+    };
+  }
+}
+
+#endif
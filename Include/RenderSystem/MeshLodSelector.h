@@ -0,0 +1,64 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Screen space error based mesh LOD selection (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESH_LOD_SELECTOR
+#define M_MESH_LOD_SELECTOR
+
+#include <cstdint>
+
+namespace MGameEngine
+{
+  inline namespace CoreModule
+  {
+    class Camera;
+  }
+}
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// カメラから見たずれのピクセル数でLODを選ぶ
+    class MeshLodSelector final
+    {
+      public:
+        // 既定で許容するずれ(ピクセル)
+        static constexpr float DEFAULT_MAX_PIXEL_ERROR = 1.0f;
+
+      public:
+        /// @brief
+        /// ずれをスクリーン上のピクセル数にする(バウンディングスフィアのカメラに最も近い点での値で、実際より大きめになる)
+        /// @param error メッシュの座標でのずれ(MeshLod::Error)
+        /// @param center バウンディングスフィアの中心(カメラと同じ座標系に変換した位置)
+        /// @param radius バウンディングスフィアの半径(メッシュの座標)
+        /// @param scale メッシュの座標からカメラの座標系への拡大率(ワールド行列の最大の拡大率)
+        static float ComputeScreenError(float error, const float center[3], float radius, float scale, const MGameEngine::Camera& camera, float viewportHeight);
+
+        /// @brief
+        /// ずれがmaxPixelError以下になる最も粗いレベルを選ぶ
+        /// @param lodErrors レベルごとのずれ(細かい順、0番は元のメッシュで0)
+        /// @return レベルの番号(どのレベルも超える場合は0)
+        static uint32_t Select(const float* lodErrors, uint32_t lodCount, const float center[3], float radius, float scale, const MGameEngine::Camera& camera, float viewportHeight, float maxPixelError = DEFAULT_MAX_PIXEL_ERROR);
+
+      private:
+        MeshLodSelector() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,94 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Mesh vertex cache, overdraw and vertex fetch optimizer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESH_OPTIMIZER
+#define M_MESH_OPTIMIZER
+
+#include <RenderSystem/MeshData.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 頂点キャッシュの効率
+    struct VertexCacheStats final
+    {
+      float ACMR;         // 三角形あたりの頂点シェーダー実行回数(0.5に近いほど良い、最悪は3)
+      float ATVR;         // 頂点あたりの頂点シェーダー実行回数(1が最良)
+    };
+
+    /// @brief
+    /// インデックス付き三角形リストの最適化
+    /// 推奨の順番はDeduplicateVertices -> OptimizeVertexCache -> OptimizeOverdraw -> OptimizeVertexFetch
+    /// どの関数もメッシュ一つを呼び出したスレッドだけで処理するので、メッシュ単位で並列に呼んでよい
+    class MeshOptimizer final
+    {
+      public:
+        // 頂点キャッシュの最適化で想定するLRUキャッシュの大きさ
+        static constexpr uint32_t DEFAULT_CACHE_SIZE = 32;
+
+        // ACMRを計測するときのFIFOキャッシュの大きさ(古いGPUに合わせる)
+        static constexpr uint32_t DEFAULT_FIFO_CACHE_SIZE = 16;
+
+        // 描画順の入れ替えで許容するACMRの悪化(1.05なら5%まで)
+        static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+
+      public:
+        /// @brief
+        /// 内容がビット単位で同じ頂点をハッシュでまとめ、インデックスを付け直す(-0と+0は同じとみなす)
+        /// @return まとめた後の頂点数
+        static size_t DeduplicateVertices(MeshData& mesh);
+
+        /// @brief
+        /// 頂点キャッシュに当たりやすい順に三角形を並べ替える(Forsythの線形時間アルゴリズム)
+        /// @param indices 三角形リスト(上書きする)
+        /// @param vertexCount 頂点数
+        static void OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+        /// @brief
+        /// 頂点キャッシュの効率をほぼ保ったまま、外向きの面のかたまりを先に描く順へ並べ替える
+        /// キャッシュが空になる位置で三角形をクラスターに分け、メッシュの中心から見て外を向くクラスターから描く
+        /// (Sander et al. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"のクラスター分割と並べ替え)
+        /// OptimizeVertexCacheの後に呼ぶ
+        /// @param threshold クラスターのACMRがこの倍率以内に収まる位置でだけ分割する
+        static void OptimizeOverdraw(MeshData& mesh, uint32_t cacheSize = DEFAULT_FIFO_CACHE_SIZE, float threshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+        /// @brief
+        /// 頂点を初めて使われる順に並べ替え、使われていない頂点を取り除く(頂点フェッチの局所性を上げる)
+        /// @return 並べ替えた後の頂点数
+        static size_t OptimizeVertexFetch(MeshData& mesh);
+
+        /// @brief
+        /// 面の法線を面積で重み付けして頂点の法線を求める(HasNormalsがfalseのメッシュ用)
+        /// 同じ位置でもテクスチャ座標が違う頂点は別々に求まるので、DeduplicateVerticesの後に呼ぶ
+        static void ComputeNormals(MeshData& mesh);
+
+        /// @brief
+        /// FIFOキャッシュでのシェーダー実行回数を数える
+        static VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize = DEFAULT_FIFO_CACHE_SIZE);
+
+      private:
+        MeshOptimizer() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Quadric error metric mesh simplifier (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Record measured deviation as the LOD error
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESH_SIMPLIFIER
+#define M_MESH_SIMPLIFIER
+
+#include <RenderSystem/MeshData.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 詳細度を下げたインデックス一つ(頂点は元のメッシュと共有する)
+    struct MeshLod final
+    {
+      std::vector<uint32_t> Indices;
+      float Error;                    // 元の面からのずれの上限として使う値(メッシュの座標の単位、細かいレベルより小さくならない)
+    };
+
+    struct MeshLodOptions final
+    {
+      uint32_t MaxLodCount;           // 元のメッシュを除いたレベル数の上限
+      float Reduction;                // 一つ前のレベルに対する三角形数の割合
+      float MaxError;                 // 許容するずれ(バウンディングボックスの対角線に対する割合)
+      uint32_t MinTriangleCount;      // これより少なくなるレベルは作らない
+    };
+
+    /// @brief
+    /// 二次誤差(QEM、Garland and Heckbert)による辺の縮約で三角形を減らす
+    /// 頂点は動かさずに既存の頂点へ寄せる(half edge collapse)ので、どのレベルも元の頂点バッファをそのまま使える
+    /// 開いた縁は縁に沿ってだけ縮約し、テクスチャ座標や法線が切り替わる継ぎ目(同じ位置に複数の頂点がある場所)は動かさない
+    /// メッシュ一つを呼び出したスレッドだけで処理するので、メッシュ単位で並列に呼んでよい
+    class MeshSimplifier final
+    {
+      public:
+        static constexpr MeshLodOptions DEFAULT_LOD_OPTIONS = { 4, 0.5f, 0.05f, 64 };
+
+      public:
+        /// @brief
+        /// 三角形を減らす
+        /// @param targetIndexCount 目標のインデックス数(ずれがmaxErrorを超える場合や縮約できる辺がない場合は届かない)
+        /// @param maxError 許容するずれ(メッシュの座標の単位)
+        /// @param outIndices 減らした三角形リスト
+        /// @return 結果のずれ(二次誤差の見積もりとMeasureDeviationで測ったずれの大きい方)
+        static float Simplify(const MeshData& mesh, size_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices);
+
+        /// @brief
+        /// 三角形数をReductionずつ減らしたレベルを順に作る(一度の縮約の途中で各レベルを取り出すので、誤差は元のメッシュに対する値になる)
+        /// 三角形数がほとんど減らなくなったらそこで止める
+        /// 二次誤差は距離の二乗の和なので、実際のずれより小さくなることがある
+        /// MeshLod::Errorには二次誤差の見積もり、MeasureDeviationで測ったずれ、一つ前のレベルの値のうち最大のものを入れる
+        /// (MeshLodSelectorがこの値を画面上のずれの上限として使うため)
+        /// @param outLods 細かい順(元のメッシュは含まない)
+        static void BuildLods(const MeshData& mesh, const MeshLodOptions& options, std::vector<MeshLod>& outLods);
+
+        /// @brief
+        /// 元のメッシュの頂点から減らした三角形までの距離の最大値を求める(品質の確認用)
+        static float MeasureDeviation(const MeshData& mesh, const uint32_t* indices, size_t indexCount);
+
+      private:
+        MeshSimplifier() = delete;
+    };
+  }
+}
+
+#endif
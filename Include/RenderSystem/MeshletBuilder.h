@@ -0,0 +1,98 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Meshlet builder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESHLET_BUILDER
+#define M_MESHLET_BUILDER
+
+#include <RenderSystem/MeshData.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    // メッシュシェーダーの出力上限に合わせた既定値(頂点64、三角形124で出力が16KB以内に収まる)
+    constexpr uint32_t MESHLET_MAX_VERTEX_COUNT = 64;
+    constexpr uint32_t MESHLET_MAX_TRIANGLE_COUNT = 124;
+
+    /// @brief
+    /// メッシュの三角形のかたまり一つ
+    struct Meshlet final
+    {
+      uint32_t VertexOffset;          // MeshletData::VertexIndicesの位置
+      uint32_t PrimitiveOffset;       // MeshletData::PrimitiveIndicesの位置(三角形ごとに3つ)
+      uint32_t VertexCount;
+      uint32_t TriangleCount;
+    };
+
+    /// @brief
+    /// カリング用の境界
+    /// 裏面の判定: dot(Center - cameraPosition, ConeAxis) >= ConeCutoff * length(Center - cameraPosition) + Radius
+    /// なら全ての三角形がカメラに裏を向けている(ConeCutoffが1の場合は判定しない)
+    struct MeshletBounds final
+    {
+      float Center[3];
+      float Radius;
+      float ConeAxis[3];              // 面の法線(表側)の平均
+      float ConeCutoff;               // sin(法線の広がりの半角)
+    };
+
+    static_assert(sizeof(Meshlet) == 16, "Meshlet size must be fixed");
+    static_assert(sizeof(MeshletBounds) == 32, "MeshletBounds size must be fixed");
+
+    struct MeshletData final
+    {
+      std::vector<Meshlet> Meshlets;
+      std::vector<MeshletBounds> Bounds;
+      std::vector<uint32_t> VertexIndices;       // メッシュの頂点番号
+      std::vector<uint8_t> PrimitiveIndices;     // メッシュレット内の頂点番号(表面は時計回り)
+    };
+
+    class MeshletBuilder final
+    {
+      public:
+        // 三角形を選ぶときに法線の向きのずれに掛ける重み(大きいほど裏面カリングが効き、頂点の共有は減る)
+        static constexpr float DEFAULT_CONE_WEIGHT = 0.5f;
+
+      public:
+        /// @brief
+        /// 三角形リストをメッシュレットに分ける
+        /// 隣接する三角形のうち新しい頂点が少なく法線の向きが揃うものを貪欲に加え、入らなくなったら次のメッシュレットにする
+        /// OptimizeVertexCacheの後に呼ぶと、隣接する三角形がない場合に選ぶ三角形も近くなる
+        /// メッシュ一つを呼び出したスレッドだけで処理するので、メッシュ単位で並列に呼んでよい
+        /// @param maxVertexCount 3～255
+        /// @param maxTriangleCount 1以上
+        static void Build(const MeshData& mesh, MeshletData& outData, uint32_t maxVertexCount = MESHLET_MAX_VERTEX_COUNT, uint32_t maxTriangleCount = MESHLET_MAX_TRIANGLE_COUNT, float coneWeight = DEFAULT_CONE_WEIGHT);
+
+        /// @brief
+        /// メッシュレットの境界を求める(Buildは全てのメッシュレットに対して呼ぶ)
+        static MeshletBounds ComputeBounds(const MeshData& mesh, const MeshletData& data, const Meshlet& meshlet);
+
+        /// @brief
+        /// 選んだメッシュレットの三角形をメッシュの頂点番号のインデックスとして足す(カリング結果を通常の描画で使う場合)
+        static void AppendIndices(const MeshletData& data, const uint32_t* meshletIndices, size_t meshletCount, std::vector<uint32_t>& outIndices);
+
+      private:
+        MeshletBuilder() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU meshlet culling (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MESHLET_CULLER
+#define M_MESHLET_CULLER
+
+#include <cstdint>
+#include <vector>
+
+namespace MGameEngine
+{
+  inline namespace CoreModule
+  {
+    class Camera;
+  }
+}
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    struct MeshletData;
+
+    constexpr uint32_t MESHLET_CULL_BATCH_SIZE = 4;
+
+    /// @brief
+    /// 4つのメッシュレットの境界を成分ごとに並べたもの(SIMDで4つずつ判定する)
+    struct alignas(16) MeshletCullBatch final
+    {
+      float CenterX[MESHLET_CULL_BATCH_SIZE];
+      float CenterY[MESHLET_CULL_BATCH_SIZE];
+      float CenterZ[MESHLET_CULL_BATCH_SIZE];
+      float Radius[MESHLET_CULL_BATCH_SIZE];
+      float AxisX[MESHLET_CULL_BATCH_SIZE];
+      float AxisY[MESHLET_CULL_BATCH_SIZE];
+      float AxisZ[MESHLET_CULL_BATCH_SIZE];
+      float Cutoff[MESHLET_CULL_BATCH_SIZE];
+    };
+
+    /// @brief
+    /// カリング用に並べ替えた境界(メッシュを読み込んだときに一度だけ作る)
+    struct MeshletCullData final
+    {
+      std::vector<MeshletCullBatch> Batches;
+      std::vector<uint32_t> TriangleCounts;
+      uint32_t MeshletCount;
+    };
+
+    struct MeshletCullStats final
+    {
+      uint32_t TestedCount;
+      uint32_t FrustumCulledCount;
+      uint32_t BackfaceCulledCount;
+      uint32_t VisibleCount;
+      uint64_t VisibleTriangleCount;
+    };
+
+    /// @brief
+    /// 視錐台と法線の円錐でメッシュレットを選ぶ
+    class MeshletCuller final
+    {
+      public:
+        /// @brief
+        /// 境界をカリング用の並びにする
+        static void Prepare(const MeshletData& data, MeshletCullData& outCullData);
+
+        /// @brief
+        /// 見える可能性のあるメッシュレットの番号を求める
+        /// 座標はメッシュの座標系(ワールド行列がある場合はカメラを逆変換して渡す)
+        /// @param outVisibleIndices 結果で置き換える
+        static MeshletCullStats Cull(const MeshletCullData& cullData, const MGameEngine::Camera& camera, std::vector<uint32_t>& outVisibleIndices);
+
+      private:
+        MeshletCuller() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU mip chain generator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MIP_GENERATOR
+#define M_MIP_GENERATOR
+
+#include <RenderSystem/TextureData.h>
+
+#include <cstdint>
+#include <string>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+  }
+
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 縮小フィルター
+    enum class MipFilter : uint8_t
+    {
+      Box,        // 覆う範囲の平均(2x2平均を奇数サイズにも拡張したもの)
+      Kaiser,     // カイザー窓付きsinc(シャープだがリンギングが出る)
+    };
+
+    /// @brief
+    /// ミップ生成の設定
+    struct MipGenerateDesc final
+    {
+      MipFilter Filter;
+      uint32_t MipLevels;               // 生成するミップ数(0なら1x1まで)
+      bool IsSRGB;                      // 8bitの色をsRGBとして扱い、線形空間で縮小する(_SRGBフォーマットは常にそうする)
+      bool IsPreserveAlphaCoverage;     // アルファテストで残るピクセルの割合をミップ0と揃える
+      float AlphaReference;             // アルファテストの閾値(0なら0.5)
+      float KaiserWidth;                // カイザーフィルターの半径(縮小先のピクセル単位、0なら3)
+      float KaiserAlpha;                // カイザー窓の形状パラメーター(0なら4)
+    };
+
+    /// @brief
+    /// ミップ0からミップチェーンをCPUで生成する
+    /// 対応フォーマットはR8G8B8A8/B8G8R8A8(UNORM/SRGB)、R16G16B16A16_FLOAT、R32G32B32A32_FLOAT
+    /// 各レベルは一つ上のレベルから、RGBAのfloatに展開して横 -> 縦の分離フィルターで縮小する
+    /// スレッドプールを渡すと行の帯ごとにワーカーで分担する
+    class MipGenerator final
+    {
+      public:
+        static bool IsSupportedFormat(uint32_t format);
+
+        /// @brief
+        /// 1x1までのミップ数を求める
+        static uint32_t GetFullMipCount(uint32_t width, uint32_t height);
+
+        /// @brief
+        /// ミップチェーンを生成する(元データのミップ0以外は使わない)
+        /// 出力のミップ0は元データをそのままコピーし、行は詰めて並べる
+        /// @param src 元データ(2Dテクスチャまたは2D配列)
+        /// @param desc 設定
+        /// @param outData 出力先(srcと同じものは渡せない)
+        /// @param outError 失敗した理由
+        /// @param threadPool nullptrなら呼び出したスレッドだけで処理する
+        static bool Generate(const TextureData& src, const MipGenerateDesc& desc, TextureData& outData, std::string& outError, ThreadPool* threadPool = nullptr);
+
+      private:
+        MipGenerator() = delete;
+    };
+  }
+}
+
+#endif
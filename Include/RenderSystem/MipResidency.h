@@ -0,0 +1,165 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Mip residency policy of texture streaming (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MIP_RESIDENCY
+#define M_MIP_RESIDENCY
+
+#include <ClassBaseInc.h>
+#include <RenderSystem/TextureData.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 常駐ミップの変更指示
+    /// TargetMipが今より小さければ細かいミップの読み込み、大きければ追い出し
+    struct MipResidencyAction final
+    {
+      uint32_t ID;
+      uint32_t TargetMip;
+    };
+
+    /// @brief
+    /// テクスチャごとの常駐ミップをメモリ予算の中で決めるポリシー(デバイスには触れない)
+    /// 画面上のサイズから求めた必要なミップに向かって一段ずつ読み込み、
+    /// 予算を超える場合は最近使われていないテクスチャの細かいミップから一段ずつ追い出す
+    /// テールミップ(指定サイズ以下のミップ)は常に常駐し、予算を超えても追い出さない
+    class MipResidency final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(MipResidency)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param budgetBytes 常駐ミップの合計サイズの上限
+        /// @param maxStreamInPerPlan 一回のPlanで読み込むテクスチャ数の上限
+        bool Init(uint64_t budgetBytes, uint32_t maxStreamInPerPlan);
+
+        /// @brief
+        /// テクスチャを登録する
+        /// @param id 呼び出し側が決めるID(小さい連番を想定)
+        /// @param desc 全ミップを持つテクスチャの情報
+        /// @param tailMip 常に常駐する最初のミップ
+        /// @param residentMip 現在常駐している最初のミップ
+        void Register(uint32_t id, const TextureDesc& desc, uint32_t tailMip, uint32_t residentMip);
+        void Unregister(uint32_t id);
+
+        /// @brief
+        /// 必要なミップを報告する(このフレームで使われたことにもなる)
+        void Request(uint32_t id, uint32_t wantedMip, uint64_t frameIndex);
+
+        /// @brief
+        /// 指示したミップの変更が完了した
+        void SetResidentMip(uint32_t id, uint32_t residentMip);
+
+        /// @brief
+        /// 指示したミップの変更を実行できなかった
+        void CancelPending(uint32_t id);
+
+        /// @brief
+        /// 予算に収まるように変更を決める
+        /// 指示したテクスチャはSetResidentMipかCancelPendingまで次の指示の対象にならない
+        /// @param outActions 変更指示
+        void Plan(std::vector<MipResidencyAction>& outActions);
+
+        uint32_t GetResidentMip(uint32_t id) const;
+        uint32_t GetWantedMip(uint32_t id) const;
+        bool IsPending(uint32_t id) const;
+
+        /// @brief
+        /// 指定ミップ以降を常駐させたときのサイズ
+        uint64_t GetMipChainSize(uint32_t id, uint32_t firstMip) const;
+
+        /// @brief
+        /// 現在の常駐サイズ(変更中のものは変更後のサイズで数える)
+        uint64_t GetCommittedBytes(void) const;
+        uint64_t GetBudget(void) const;
+        void SetBudget(uint64_t budgetBytes);
+        uint64_t GetEvictionCount(void) const;
+
+        /// @brief
+        /// 画面上のサイズ(ピクセル)から必要な最初のミップを求める
+        /// @param desc テクスチャ情報
+        /// @param screenSize 画面上の大きい方の辺のピクセル数
+        static uint32_t ComputeWantedMip(const TextureDesc& desc, float screenSize);
+
+        /// @brief
+        /// 大きい方の辺がtailSize以下になる最初のミップを求める
+        static uint32_t ComputeTailMip(const TextureDesc& desc, uint32_t tailSize);
+
+        /// @brief
+        /// 画面上のサイズ(ピクセル)を見積もる
+        /// @param worldSize テクスチャを貼った面のワールド空間での大きさ
+        /// @param distance カメラからの距離
+        /// @param verticalFov 垂直画角(ラジアン)
+        /// @param viewportHeight ビューポートの高さ(ピクセル)
+        static float EstimateScreenSize(float worldSize, float distance, float verticalFov, float viewportHeight);
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct TextureState
+        {
+          bool IsRegistered;
+          uint32_t TailMip;
+          uint32_t ResidentMip;
+          uint32_t PendingMip;    // 変更中でなければResidentMipと同じ
+          uint32_t WantedMip;
+          uint64_t LastUsedFrame;
+          std::vector<uint64_t> ChainSizes;   // [mip] = mip以降を常駐させたときのサイズ
+        };
+
+      private:
+        bool isEvictable(const TextureState& state) const;
+        void evictOneLevel(uint32_t id, std::vector<MipResidencyAction>& outActions);
+
+      private:
+        std::vector<TextureState> m_textures;
+        uint64_t m_budgetBytes;
+        uint64_t m_committedBytes;
+        uint64_t m_evictionCount;
+        uint32_t m_maxStreamInPerPlan;
+    };
+
+    inline uint64_t MipResidency::GetCommittedBytes() const
+    {
+      return m_committedBytes;
+    }
+
+    inline uint64_t MipResidency::GetBudget() const
+    {
+      return m_budgetBytes;
+    }
+
+    inline void MipResidency::SetBudget(uint64_t budgetBytes)
+    {
+      m_budgetBytes = budgetBytes;
+    }
+
+    inline uint64_t MipResidency::GetEvictionCount() const
+    {
+      return m_evictionCount;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,134 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null command list pool for parallel recording (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Share retire and reuse logic through FencedPool
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_NULL_COMMAND_LIST_POOL
+#define M_NULL_COMMAND_LIST_POOL
+
+#include <ClassBaseInc.h>
+#include <FencedPool.hpp>
+#include <Interfaces/IDrawPacketBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// GPUを使わないコマンドリスト
+    /// 設定と描画を固定長の命令としてCPUのメモリに書き込むだけ(ドライバーが命令を書き込む分の負荷の代わり)
+    /// Resetしてもメモリは解放しないので、再利用したリストは確保なしで記録できる
+    class NullCommandList final : public IDrawPacketBackend
+    {
+      GENERATE_CLASS_NO_COPY(NullCommandList)
+
+      public:
+        /// @brief
+        /// 記録した命令を捨てて記録可能な状態にする
+        void Reset(void);
+        void Close(void);
+
+        /// @brief
+        /// 記録した命令の数と大きさ
+        size_t GetCommandCount(void) const;
+        size_t GetSizeInBytes(void) const;
+        uint64_t GetDrawCount(void) const;
+        bool IsClosed(void) const;
+
+      public:
+        void SetRootSignature(uint32_t rootSignature) override;
+        void SetPipelineState(uint32_t pipelineState) override;
+        void SetMaterial(uint32_t material) override;
+        void SetMesh(uint32_t mesh) override;
+        void Draw(uint32_t instanceCount, uint64_t instanceDataOffset) override;
+
+      private:
+        struct Command
+        {
+          uint32_t Type;
+          uint32_t Arguments[3];
+        };
+
+      private:
+        void write(uint32_t type, uint32_t argument0, uint32_t argument1 = 0, uint32_t argument2 = 0);
+
+      private:
+        std::vector<Command> m_commands;
+        uint64_t m_drawCount;
+        bool m_isClosed;
+    };
+
+    /// @brief
+    /// CommandListPoolと同じ仕組みでNullCommandListを払い出すプール
+    /// リストはフレーム内では一つのスレッドだけが記録し、退役させたフェンス値が完了してから再利用する
+    /// ツールやヘッドレスで並列記録のスケーリングを計測するのに使う
+    class NullCommandListPool final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(NullCommandListPool)
+
+      public:
+        /// @brief
+        /// GPUが完了したリストを再利用できるように戻す
+        /// @param completedFenceValue 完了済みのフェンス値
+        void BeginFrame(uint64_t completedFenceValue);
+
+        /// @brief
+        /// 記録可能な状態のリストを取得する(スレッドセーフ)
+        /// 空きがなければ新しく作る
+        NullCommandList* Acquire(void);
+
+        /// @brief
+        /// このフレームで取得したすべてのリストを退役させる
+        /// @param signaledFenceValue サブミット後にシグナルしたフェンス値
+        void EndFrame(uint64_t signaledFenceValue);
+
+        size_t GetCreatedCount(void) const;
+        size_t GetAvailableCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        FencedPool<NullCommandList> m_lists;
+    };
+
+    inline size_t NullCommandList::GetCommandCount() const
+    {
+      return m_commands.size();
+    }
+
+    inline size_t NullCommandList::GetSizeInBytes() const
+    {
+      return m_commands.size() * sizeof(Command);
+    }
+
+    inline uint64_t NullCommandList::GetDrawCount() const
+    {
+      return m_drawCount;
+    }
+
+    inline bool NullCommandList::IsClosed() const
+    {
+      return m_isClosed;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null instanced draw backend (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Draw packet backend
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_NULL_INSTANCE_DRAW_BACKEND
+#define M_NULL_INSTANCE_DRAW_BACKEND
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IDrawPacketBackend.h>
+#include <Interfaces/IInstanceDrawBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// GPUを使わない描画バックエンド
+    /// インスタンスデータのリングはヒープメモリで、描画は回数と状態の切り替えを数えるだけ
+    /// DrawPacketQueueのバックエンドとしても使え、設定された回数をそのまま数える
+    /// ツールやヘッドレスでのバッチングや描画の並べ替えの計測に使う
+    class NullInstanceDrawBackend final : public IInstanceDrawBackend, public IDrawPacketBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(NullInstanceDrawBackend)
+
+      public:
+        bool Init(uint64_t instanceCapacity);
+
+        uint64_t GetDrawCount(void) const;
+        uint64_t GetInstanceCount(void) const;
+        /// @brief
+        /// 直前の描画とメッシュやマテリアルが変わった回数(実際のバックエンドで設定し直す回数)
+        uint64_t GetMeshChangeCount(void) const;
+        uint64_t GetMaterialChangeCount(void) const;
+        uint64_t GetRootSignatureChangeCount(void) const;
+        uint64_t GetPipelineStateChangeCount(void) const;
+        void ResetCounters(void);
+
+      public:
+        uint8_t* GetInstanceMemory(void) const override;
+        uint64_t GetInstanceCapacity(void) const override;
+        void DrawInstanced(const InstanceDrawCommand& command) override;
+
+      public:
+        void SetRootSignature(uint32_t rootSignature) override;
+        void SetPipelineState(uint32_t pipelineState) override;
+        void SetMaterial(uint32_t material) override;
+        void SetMesh(uint32_t mesh) override;
+        void Draw(uint32_t instanceCount, uint64_t instanceDataOffset) override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        std::vector<uint8_t> m_instanceMemory;
+        uint64_t m_drawCount;
+        uint64_t m_instanceCount;
+        uint64_t m_meshChangeCount;
+        uint64_t m_materialChangeCount;
+        uint64_t m_rootSignatureChangeCount;
+        uint64_t m_pipelineStateChangeCount;
+        uint32_t m_currentMesh;
+        uint32_t m_currentMaterial;
+        bool m_hasCurrent;
+    };
+
+    inline uint64_t NullInstanceDrawBackend::GetDrawCount() const
+    {
+      return m_drawCount;
+    }
+
+    inline uint64_t NullInstanceDrawBackend::GetInstanceCount() const
+    {
+      return m_instanceCount;
+    }
+
+    inline uint64_t NullInstanceDrawBackend::GetMeshChangeCount() const
+    {
+      return m_meshChangeCount;
+    }
+
+    inline uint64_t NullInstanceDrawBackend::GetMaterialChangeCount() const
+    {
+      return m_materialChangeCount;
+    }
+
+    inline uint64_t NullInstanceDrawBackend::GetRootSignatureChangeCount() const
+    {
+      return m_rootSignatureChangeCount;
+    }
+
+    inline uint64_t NullInstanceDrawBackend::GetPipelineStateChangeCount() const
+    {
+      return m_pipelineStateChangeCount;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,115 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null texture upload backend (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add texture to texture copy
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_NULL_TEXTURE_UPLOAD_BACKEND
+#define M_NULL_TEXTURE_UPLOAD_BACKEND
+
+#include <ClassBaseInc.h>
+#include <Interfaces/ITextureUploadBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// GPUを使わないアップロードバックエンド
+    /// ステージングはヒープメモリ、テクスチャはCPU上のバッファーで、コピーはmemcpyで行う
+    /// ツールやヘッドレスでのストリーミングの検証に使う
+    class NullTextureUploadBackend final : public ITextureUploadBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(NullTextureUploadBackend)
+
+      public:
+        bool Init(uint64_t stagingCapacity);
+
+        /// @brief
+        /// trueならサブミットと同時に完了する(既定)
+        /// falseならCompleteFenceValueを呼ぶまで完了しない
+        void SetAutoComplete(bool isAutoComplete);
+        void CompleteFenceValue(uint64_t fenceValue);
+
+        /// @brief
+        /// テクスチャの中身(サブリソースはTextureFootprint::Computeの配置で並ぶ)
+        const std::vector<uint8_t>* GetTextureData(uint64_t texture) const;
+        const TextureDesc* GetTextureDesc(uint64_t texture) const;
+        size_t GetTextureCount(void) const;
+        uint64_t GetCopyCount(void) const;
+
+      public:
+        uint8_t* GetStagingMemory(void) const override;
+        uint64_t GetStagingCapacity(void) const override;
+        uint64_t CreateTexture(const TextureDesc& desc) override;
+        void DestroyTexture(uint64_t texture) override;
+        void CopyToTexture(uint64_t texture, uint32_t subresource, const SubresourceFootprint& footprint) override;
+        void CopyTextureSubresource(uint64_t dstTexture, uint32_t dstSubresource, uint64_t srcTexture, uint32_t srcSubresource) override;
+        uint64_t Submit(void) override;
+        uint64_t GetCompletedFenceValue(void) const override;
+        uint64_t GetSubmittedFenceValue(void) const override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct NullTexture
+        {
+          TextureDesc Desc;
+          std::vector<SubresourceFootprint> Footprints;
+          std::vector<uint8_t> Data;
+        };
+
+        struct PendingCopy
+        {
+          uint64_t Texture;
+          uint32_t Subresource;
+          SubresourceFootprint Footprint;   // SrcTextureが0のときのステージング内の配置
+          uint64_t SrcTexture;
+          uint32_t SrcSubresource;
+        };
+
+      private:
+        void copyRows(NullTexture& dst, uint32_t dstSubresource, const uint8_t* src, const SubresourceFootprint& srcFootprint);
+
+      private:
+        std::vector<uint8_t> m_staging;
+        std::unordered_map<uint64_t, NullTexture> m_textures;
+        std::vector<PendingCopy> m_pendingCopies;
+        uint64_t m_nextTextureID;
+        uint64_t m_submittedValue;
+        uint64_t m_completedValue;
+        uint64_t m_copyCount;
+        bool m_isAutoComplete;
+    };
+
+    inline size_t NullTextureUploadBackend::GetTextureCount() const
+    {
+      return m_textures.size();
+    }
+
+    inline uint64_t NullTextureUploadBackend::GetCopyCount() const
+    {
+      return m_copyCount;
+    }
+  }
+}
+
+#endif
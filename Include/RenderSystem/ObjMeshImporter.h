@@ -0,0 +1,47 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Wavefront OBJ mesh importer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_OBJ_MESH_IMPORTER
+#define M_OBJ_MESH_IMPORTER
+
+#include <Interfaces/IMeshImporter.h>
+
+#include <cstddef>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// Wavefront OBJを読み込む(v / vt / vn / f / o / g / usemtl)
+    /// o、g、usemtlが変わるたびに別のメッシュにし、多角形は扇状に三角形へ分割する
+    /// 右手座標系(反時計回りが表)から左手座標系(時計回りが表)へ、Zの反転と巻き順の反転で変換する
+    /// テクスチャ座標は左下原点なのでVを反転する
+    class ObjMeshImporter final : public IMeshImporter
+    {
+      public:
+        bool Import(const std::string& path, std::vector<MeshData>& outMeshes, std::string& outError) const override;
+
+        /// @brief
+        /// メモリ上のOBJを読み込む
+        /// @param text 内容(終端文字は不要)
+        static bool ImportMemory(const char* text, size_t size, std::vector<MeshData>& outMeshes, std::string& outError);
+    };
+  }
+}
+
+#endif
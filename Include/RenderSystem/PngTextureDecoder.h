@@ -0,0 +1,46 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : PNG texture decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_PNG_TEXTURE_DECODER
+#define M_PNG_TEXTURE_DECODER
+
+#include <Interfaces/ITextureDecoder.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// WICを使わずにPNGをデコードする(オフラインツールやWindows以外で使う)
+    /// すべてのカラータイプ・ビット深度・インターレースに対応し、R8G8B8A8_UNORMで出力する
+    /// 16bitのチャンネルは上位8bitを使う
+    class PngTextureDecoder final : public ITextureDecoder
+    {
+      public:
+        bool Decode(const std::string& path, TextureData& outData, std::string& outError) const override;
+
+        /// @brief
+        /// メモリ上のPNGをデコードする
+        static bool DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,275 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Render graph (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Flush barriers before each pass
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_RENDER_GRAPH
+#define M_RENDER_GRAPH
+
+#include <ClassBaseInc.h>
+#include <Graphics_DX12/ResourceStateTracker.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct ID3D12Resource;
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// グラフ内の仮想リソースを指すハンドル
+    struct RenderGraphResourceHandle final
+    {
+      static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+      uint32_t Index;
+
+      RenderGraphResourceHandle()
+        : Index(INVALID_INDEX)
+      { }
+
+      explicit RenderGraphResourceHandle(uint32_t index)
+        : Index(index)
+      { }
+
+      bool IsValid() const
+      {
+        return Index != INVALID_INDEX;
+      }
+    };
+
+    /// @brief
+    /// グラフ内のパスを指すハンドル
+    struct RenderGraphPassHandle final
+    {
+      static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+      uint32_t Index;
+
+      RenderGraphPassHandle()
+        : Index(INVALID_INDEX)
+      { }
+
+      explicit RenderGraphPassHandle(uint32_t index)
+        : Index(index)
+      { }
+
+      bool IsValid() const
+      {
+        return Index != INVALID_INDEX;
+      }
+    };
+
+    /// @brief
+    /// グラフが寿命を管理する一時リソースの情報
+    /// サイズとアライメントはGetResourceAllocationInfoの結果を入れる
+    struct TransientResourceDesc final
+    {
+      uint64_t SizeInBytes;
+      uint64_t Alignment;
+      uint32_t Width;
+      uint32_t Height;
+      uint32_t Format;      // DXGI_FORMAT
+    };
+
+    /// @brief
+    /// パスの前に発行するバリア
+    struct RenderGraphBarrier final
+    {
+      enum class Type : uint8_t
+      {
+        Transition,
+        Aliasing,
+      };
+
+      Type BarrierType;
+      RenderGraphResourceHandle Resource;
+      RenderGraphResourceHandle AliasedBefore;    // Aliasingのみ(同じメモリを直前まで使っていたリソース)
+      ResourceStates Before;
+      ResourceStates After;
+    };
+
+    /// @brief
+    /// 一時リソースのヒープ内配置
+    struct TransientAllocation final
+    {
+      RenderGraphResourceHandle Resource;
+      uint64_t Offset;
+      uint64_t SizeInBytes;
+      ResourceStates InitialState;    // 最初に使われる状態(この状態で配置リソースを作る)
+      uint32_t FirstPassOrder;
+      uint32_t LastPassOrder;
+    };
+
+    /// @brief
+    /// コンパイル済みのパス
+    struct CompiledRenderPass final
+    {
+      uint32_t PassIndex;
+      std::vector<RenderGraphBarrier> Barriers;   // パスの実行前に発行する
+    };
+
+    /// @brief
+    /// コンパイル結果(CPUのみで求めたもの)
+    struct CompiledRenderGraph final
+    {
+      std::vector<CompiledRenderPass> Passes;
+      std::vector<RenderGraphBarrier> FinalBarriers;            // 最後のパスの後に発行する(インポートしたリソースを最終状態に戻す)
+      std::vector<TransientAllocation> TransientAllocations;
+      uint64_t TransientHeapSize;
+      uint32_t CulledPassCount;
+      uint32_t BarrierCount;
+      uint64_t Hash;
+    };
+
+    /// @brief
+    /// パスが読み書きするリソースを宣言し、
+    /// コンパイル時に実行順序・不要パスの削除・バリア・一時リソースのメモリ共有を決めるレンダーグラフ
+    /// 毎フレームReset -> 宣言 -> Compile -> Executeの順で使う
+    /// 構造がフレーム間で変わらなければCompileは前回の結果をそのまま使う
+    class RenderGraph final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(RenderGraph)
+
+      public:
+        ALIAS(std::function<void(void)>, ExecuteFunc);
+        ALIAS(std::function<void(const RenderGraphBarrier&)>, BarrierFunc);
+        ALIAS(std::function<void(void)>, FlushFunc);
+
+      public:
+        /// @brief
+        /// 外部リソースを取り込む(バックバッファなど)
+        /// インポートしたリソースへの書き込みは出力とみなし、そのパスは削除されない
+        /// @param name デバッグ用の名前
+        /// @param resource リソース(構造のハッシュには含めない)
+        /// @param initialState グラフ開始時の状態
+        /// @param finalState グラフ終了時に戻す状態(UNKNOWN_RESOURCE_STATEなら戻さない)
+        RenderGraphResourceHandle ImportResource(const std::string& name, ID3D12Resource* resource, ResourceStates initialState, ResourceStates finalState = UNKNOWN_RESOURCE_STATE);
+
+        /// @brief
+        /// 一時リソースを作る(実体は呼び出し側がコンパイル結果の配置に従って作る)
+        RenderGraphResourceHandle CreateTransient(const std::string& name, const TransientResourceDesc& desc);
+
+        /// @brief
+        /// パスを追加する
+        /// @param name デバッグ用の名前
+        /// @param execute 実行時に呼ばれる関数
+        RenderGraphPassHandle AddPass(const std::string& name, ExecuteFunc execute);
+
+        /// @brief
+        /// パスが指定状態でリソースを読むことを宣言する
+        void Read(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, ResourceStates state);
+        /// @brief
+        /// パスが指定状態でリソースに書き込むことを宣言する
+        void Write(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, ResourceStates state);
+
+        /// @brief
+        /// 出力がなくても削除しないパスにする(リードバックなど)
+        void SetSideEffect(RenderGraphPassHandle pass);
+
+        /// @brief
+        /// 宣言を元にグラフをコンパイルする
+        /// 構造が前回と同じならキャッシュを使う
+        /// @return 宣言が不正ならfalse
+        bool Compile(void);
+
+        /// @brief
+        /// コンパイル結果の順にバリアとパスを実行する
+        /// @param onBarrier バリアを発行する関数(積むだけでよい)
+        /// @param onFlush 積んだバリアをコマンドリストに記録する関数
+        ///                各パスの実行直前と最終バリアの後に呼ばれる
+        void Execute(const BarrierFunc& onBarrier, const FlushFunc& onFlush) const;
+
+        /// @brief
+        /// 宣言を破棄する(コンパイル結果のキャッシュは残す)
+        void Reset(void);
+
+        ID3D12Resource* GetImportedResource(RenderGraphResourceHandle resource) const;
+        const std::string& GetPassName(RenderGraphPassHandle pass) const;
+        const std::string& GetResourceName(RenderGraphResourceHandle resource) const;
+        const CompiledRenderGraph& GetCompiled(void) const;
+        bool IsCompiled(void) const;
+        uint64_t GetCacheHitCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct ResourceNode
+        {
+          std::string Name;
+          bool IsImported;
+          ID3D12Resource* Imported;
+          ResourceStates InitialState;
+          ResourceStates FinalState;
+          TransientResourceDesc Desc;
+        };
+
+        struct PassAccess
+        {
+          uint32_t Resource;
+          ResourceStates State;
+          bool IsWrite;
+        };
+
+        struct PassNode
+        {
+          std::string Name;
+          std::vector<PassAccess> Accesses;
+          bool HasSideEffect;
+          ExecuteFunc Execute;
+        };
+
+      private:
+        void addAccess(RenderGraphPassHandle, RenderGraphResourceHandle, ResourceStates, bool isWrite);
+        uint64_t computeHash(void) const;
+        void buildDependencies(std::vector<std::vector<uint32_t>>& outPredecessors) const;
+        uint32_t cullPasses(const std::vector<std::vector<uint32_t>>& predecessors, std::vector<uint8_t>& outAlive) const;
+        bool sortPasses(const std::vector<std::vector<uint32_t>>& predecessors, const std::vector<uint8_t>& alive, std::vector<uint32_t>& outOrder) const;
+        void allocateTransients(const std::vector<uint32_t>& order, CompiledRenderGraph& outCompiled) const;
+        void planBarriers(const std::vector<uint32_t>& order, CompiledRenderGraph& outCompiled) const;
+
+      private:
+        std::vector<ResourceNode> m_resources;
+        std::vector<PassNode> m_passes;
+        CompiledRenderGraph m_compiled;
+        bool m_isCompiled;
+        bool m_hasCache;
+        uint64_t m_cacheHitCount;
+    };
+
+    inline const CompiledRenderGraph& RenderGraph::GetCompiled() const
+    {
+      return m_compiled;
+    }
+
+    inline bool RenderGraph::IsCompiled() const
+    {
+      return m_isCompiled;
+    }
+
+    inline uint64_t RenderGraph::GetCacheHitCount() const
+    {
+      return m_cacheHitCount;
+    }
+  }
+}
+
+#endif
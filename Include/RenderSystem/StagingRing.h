@@ -0,0 +1,95 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Staging ring allocator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_STAGING_RING
+#define M_STAGING_RING
+
+#include <ClassBaseInc.h>
+
+#include <cstdint>
+#include <deque>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// アップロードバッファーを先頭から順に使い回すリングアロケーター(オフセットのみ管理する)
+    /// Allocateした範囲はCommitでフェンス値と結び付け、そのフェンスが完了したらReleaseで再利用する
+    /// スレッドセーフではない
+    class StagingRing final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(StagingRing)
+
+      public:
+        static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+      public:
+        bool Init(uint64_t capacity);
+
+        /// @brief
+        /// 領域を確保する
+        /// 末尾に収まらなければ先頭に戻る(末尾の余りは次の解放まで使われない)
+        /// @param size サイズ
+        /// @param alignment アラインメント(2のべき乗)
+        /// @return 先頭からのオフセット(空きがなければINVALID_OFFSET)
+        uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+        /// @brief
+        /// 前回のCommit以降に確保した領域を、フェンス値の完了まで使用中にする
+        void Commit(uint64_t fenceValue);
+
+        /// @brief
+        /// 完了したフェンス値までの領域を解放する
+        void Release(uint64_t completedFenceValue);
+
+        uint64_t GetCapacity(void) const;
+        uint64_t GetUsedSize(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Retirement
+        {
+          uint64_t FenceValue;
+          uint64_t Head;        // Commit時点の先頭(解放後の末尾)
+          uint64_t Size;        // パディングを含むサイズ
+        };
+
+      private:
+        uint64_t m_capacity;
+        uint64_t m_head;                // 次に確保する位置
+        uint64_t m_tail;                // 最も古い使用中の位置
+        uint64_t m_usedSize;
+        uint64_t m_uncommittedSize;
+        std::deque<Retirement> m_retirements;
+    };
+
+    inline uint64_t StagingRing::GetCapacity() const
+    {
+      return m_capacity;
+    }
+
+    inline uint64_t StagingRing::GetUsedSize() const
+    {
+      return m_usedSize;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,67 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Decoded texture data (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_TEXTURE_DATA
+#define M_TEXTURE_DATA
+
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    // D3D12_RESOURCE_DIMENSIONと同じ値
+    constexpr uint32_t TEXTURE_DIMENSION_TEXTURE1D = 2;
+    constexpr uint32_t TEXTURE_DIMENSION_TEXTURE2D = 3;
+    constexpr uint32_t TEXTURE_DIMENSION_TEXTURE3D = 4;
+
+    /// @brief
+    /// テクスチャリソースの情報(D3D12_RESOURCE_DESCのテクスチャ部分)
+    struct TextureDesc final
+    {
+      uint32_t Width;
+      uint32_t Height;
+      uint32_t DepthOrArraySize;
+      uint32_t MipLevels;
+      uint32_t Format;        // DXGI_FORMAT
+      uint32_t Dimension;     // D3D12_RESOURCE_DIMENSION
+    };
+
+    /// @brief
+    /// サブリソース一つ分のピクセルの位置
+    /// ブロック圧縮フォーマットではRowPitchは4x4ブロック一行分のバイト数
+    struct SubresourceData final
+    {
+      uint64_t Offset;        // Pixelsの先頭からのオフセット
+      uint64_t RowPitch;
+      uint64_t SlicePitch;
+    };
+
+    /// @brief
+    /// デコード済みのテクスチャ
+    /// サブリソースはD3D12のサブリソース番号順(mip + arrayIndex * MipLevels)に並ぶ
+    struct TextureData final
+    {
+      TextureDesc Desc;
+      std::vector<uint8_t> Pixels;
+      std::vector<SubresourceData> Subresources;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture footprint calculation (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add GetMipDesc
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_TEXTURE_FOOTPRINT
+#define M_TEXTURE_FOOTPRINT
+
+#include <ClassBaseInc.h>
+#include <RenderSystem/TextureData.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    constexpr uint64_t TEXTURE_DATA_PITCH_ALIGNMENT = 256;        // D3D12_TEXTURE_DATA_PITCH_ALIGNMENT
+    constexpr uint64_t TEXTURE_DATA_PLACEMENT_ALIGNMENT = 512;    // D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+
+    /// @brief
+    /// フォーマットのメモリ上のサイズ
+    /// 非圧縮フォーマットはBlockWidth = BlockHeight = 1
+    struct TextureFormatInfo final
+    {
+      uint32_t BytesPerBlock;
+      uint32_t BlockWidth;
+      uint32_t BlockHeight;
+
+      bool IsValid() const
+      {
+        return BytesPerBlock != 0;
+      }
+
+      bool IsBlockCompressed() const
+      {
+        return BlockWidth > 1;
+      }
+    };
+
+    /// @brief
+    /// アップロードバッファー内のサブリソース一つ分の配置
+    /// (D3D12_PLACED_SUBRESOURCE_FOOTPRINTとGetCopyableFootprintsの行数・行サイズを合わせたもの)
+    struct SubresourceFootprint final
+    {
+      uint64_t Offset;
+      uint32_t Format;          // DXGI_FORMAT
+      uint32_t Width;
+      uint32_t Height;
+      uint32_t Depth;
+      uint32_t RowPitch;
+      uint32_t NumRows;
+      uint64_t RowSizeInBytes;
+    };
+
+    /// @brief
+    /// デバイスなしでID3D12Device::GetCopyableFootprintsと同じ配置を計算する
+    /// オフラインツールやヘッドレス環境のアップロード処理で使う
+    class TextureFootprint final
+    {
+      public:
+        /// @brief
+        /// フォーマットのブロックサイズを取得する(未対応ならIsValid() == false)
+        static TextureFormatInfo GetFormatInfo(uint32_t format);
+
+        /// @brief
+        /// サブリソース数を取得する(3Dテクスチャは配列を持たない)
+        static uint32_t GetSubresourceCount(const TextureDesc& desc);
+
+        /// @brief
+        /// ミップレベルのサイズを取得する(最小1)
+        static uint32_t GetMipDimension(uint32_t size, uint32_t mipLevel);
+
+        /// @brief
+        /// firstMip以降のミップだけを持つテクスチャの情報を取得する(ミップストリーミング用)
+        static TextureDesc GetMipDesc(const TextureDesc& desc, uint32_t firstMip);
+
+        /// @brief
+        /// サブリソースの配置を計算する
+        /// @param desc テクスチャ情報
+        /// @param firstSubresource 最初のサブリソース番号
+        /// @param subresourceCount サブリソース数
+        /// @param baseOffset 最初のサブリソースのオフセット(512の倍数であること)
+        /// @param outFootprints 配置
+        /// @param outTotalBytes 必要なバッファーサイズ(最後の行のパディングは含まない)
+        /// @return 未対応のフォーマットや範囲外ならfalse
+        static bool Compute(const TextureDesc& desc, uint32_t firstSubresource, uint32_t subresourceCount, uint64_t baseOffset, std::vector<SubresourceFootprint>& outFootprints, uint64_t* outTotalBytes = nullptr);
+
+        /// @brief
+        /// すべてのサブリソースの配置を計算する
+        static bool Compute(const TextureDesc& desc, std::vector<SubresourceFootprint>& outFootprints, uint64_t* outTotalBytes = nullptr);
+
+        /// @brief
+        /// 詰めて並べたピクセルから配置どおりに行単位でコピーする
+        /// @param dst 配置の基準アドレス(footprint.Offsetを足した位置に書き込む)
+        /// @param footprint コピー先の配置
+        /// @param src コピー元の先頭
+        /// @param srcRowPitch コピー元の行ピッチ
+        /// @param srcSlicePitch コピー元のスライスピッチ
+        static void CopySubresource(uint8_t* dst, const SubresourceFootprint& footprint, const uint8_t* src, uint64_t srcRowPitch, uint64_t srcSlicePitch);
+
+      private:
+        TextureFootprint() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,302 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Asynchronous texture streamer (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add mip streaming with residency budget
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_TEXTURE_STREAMER
+#define M_TEXTURE_STREAMER
+
+#include <ClassBaseInc.h>
+#include <RenderSystem/MipResidency.h>
+#include <RenderSystem/StagingRing.h>
+#include <RenderSystem/TextureData.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+  }
+
+  inline namespace RenderSystem
+  {
+    class ITextureDecoder;
+    class ITextureUploadBackend;
+
+    /// @brief
+    /// ストリーミング中のテクスチャの状態
+    enum class TextureStreamingState : uint8_t
+    {
+      Queued,       // デコード待ち
+      Decoding,     // ワーカーでデコード中
+      Decoded,      // アップロード待ち
+      Uploading,    // コピーをサブミット済み(GPUの完了待ち)
+      Resident,     // 使用可能
+      Failed,
+    };
+
+    /// @brief
+    /// ストリーミングテクスチャを指すハンドル
+    struct StreamingTextureHandle final
+    {
+      static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+      uint32_t Index;
+
+      StreamingTextureHandle()
+        : Index(INVALID_INDEX)
+      { }
+
+      explicit StreamingTextureHandle(uint32_t index)
+        : Index(index)
+      { }
+
+      bool IsValid() const
+      {
+        return Index != INVALID_INDEX;
+      }
+    };
+
+    /// @brief
+    /// ストリーマーの設定
+    struct TextureStreamerDesc final
+    {
+      uint64_t MaxUploadBytesPerUpdate;   // 一回のUpdateでアップロードする上限(最低一枚はアップロードする)
+      uint32_t MaxDecodesInFlight;        // 同時にデコードする数(0ならワーカー数 * 2)
+      uint64_t ResidencyBudgetBytes;      // 常駐ミップの予算(0ならミップストリーミングせず全ミップを常駐させる)
+      uint32_t TailMipSize;               // これ以下の大きさのミップは常に常駐させる(0なら64)
+      uint32_t MaxMipStreamInPerUpdate;   // 一回のUpdateで細かくするテクスチャ数(0なら4)
+    };
+
+    struct TextureStreamerStats final
+    {
+      uint64_t DecodedCount;
+      uint64_t FailedCount;
+      uint64_t UploadedCount;
+      uint64_t UploadedBytes;
+      uint64_t SubmitCount;
+      uint64_t MipStreamInCount;
+      uint64_t MipEvictionCount;
+    };
+
+    /// @brief
+    /// テクスチャを非同期に読み込むストリーマー
+    /// 要求は優先度の高い順にワーカーでデコードし、ステージングリングを通して一回のサブミットにまとめてアップロードする
+    /// アップロードが完了するまではプレースホルダーのテクスチャを返す
+    /// デバイスには触れないため、ヌルバックエンドと組み合わせればヘッドレスで動かせる
+    /// 
+    /// ミップストリーミングが有効な場合は最初にテールミップだけをアップロードし、
+    /// ReportScreenSizeで報告された画面上のサイズに合わせて細かいミップを一段ずつ読み込む
+    /// 予算を超えるときは最近使われていないテクスチャの細かいミップから追い出す
+    /// ミップを入れ替えるときは新しい大きさのテクスチャを作り、残すミップはGPU上でコピーしてから差し替える
+    /// (デコード済みのデータはCPU側に残す)
+    /// 
+    /// Request / Update / Get系はすべてメインスレッドから呼ぶ
+    class TextureStreamer final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(TextureStreamer)
+
+      public:
+        ALIAS(std::function<void(StreamingTextureHandle, uint64_t)>, ResidentFunc);
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param desc 設定
+        /// @param decoder デコーダー(ワーカーから呼ばれる)
+        /// @param backend アップロード先
+        /// @param threadPool デコードに使うプール(nullptrならUpdate内で同期的にデコードする)
+        bool Init(const TextureStreamerDesc& desc, ITextureDecoder* decoder, ITextureUploadBackend* backend, ThreadPool* threadPool = nullptr);
+
+        /// @brief
+        /// プレースホルダーを作ってすぐにサブミットする
+        /// (描画と同じキューでサブミットするバックエンドなら、以降の描画より先にコピーが終わる)
+        bool CreatePlaceholder(const TextureData& data);
+
+        /// @brief
+        /// テクスチャを要求する
+        /// 同じパスの要求は同じハンドルを返し、優先度は高い方を使う
+        /// @param path ファイルパス(UTF-8)
+        /// @param priority 優先度(大きいほど先)
+        StreamingTextureHandle Request(const std::string& path, float priority);
+
+        /// @brief
+        /// 優先度を変更する(デコード前とアップロード前の順番に反映される)
+        void SetPriority(StreamingTextureHandle handle, float priority);
+
+        /// @brief
+        /// 画面上の大きさを報告する(ミップストリーミングの要求と最終使用フレームの更新)
+        /// @param handle テクスチャ
+        /// @param screenSize 画面上の大きい方の辺のピクセル数(MipResidency::EstimateScreenSizeで見積もる)
+        void ReportScreenSize(StreamingTextureHandle handle, float screenSize);
+
+        /// @brief
+        /// テクスチャが差し替わったときに呼ばれる関数(SRVの差し替えなど)
+        /// 最初のアップロードの完了とミップの入れ替えの完了で呼ばれる
+        void SetResidentCallback(ResidentFunc onResident);
+
+        /// @brief
+        /// フレームに一回呼ぶ
+        /// 完了したアップロードの確定 -> デコードの発行 -> デコード結果の回収 -> ミップの入れ替え -> まとめてサブミット
+        void Update(void);
+
+        TextureStreamingState GetState(StreamingTextureHandle handle) const;
+
+        /// @brief
+        /// 使用するテクスチャを取得する(常駐していなければプレースホルダー)
+        uint64_t GetTexture(StreamingTextureHandle handle) const;
+
+        const std::string& GetError(StreamingTextureHandle handle) const;
+
+        /// @brief
+        /// 常駐している最初のミップ(元のテクスチャのミップ番号)
+        uint32_t GetResidentMip(StreamingTextureHandle handle) const;
+
+        /// @brief
+        /// すべての要求が常駐か失敗になったか
+        bool IsIdle(void) const;
+
+        uint64_t GetPlaceholder(void) const;
+        size_t GetCount(void) const;
+        const TextureStreamerStats& GetStats(void) const;
+        bool IsMipStreamingEnabled(void) const;
+        const MipResidency& GetResidency(void) const;
+
+      public:
+        /// @brief
+        /// デコード中のタスクを待ってからテクスチャを破棄する(GPUが使っていないこと)
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Entry
+        {
+          std::string Path;
+          float Priority;
+          TextureStreamingState State;
+          uint64_t Texture;
+          uint64_t UploadFenceValue;
+          std::unique_ptr<TextureData> Data;    // ミップストリーミング中は元データとして残す
+          std::string Error;
+          uint32_t ResidentMip;
+          // ミップの入れ替え中のテクスチャ
+          uint64_t PendingTexture;
+          uint32_t PendingMip;
+        };
+
+        struct QueueItem
+        {
+          float Priority;
+          uint32_t Sequence;
+          uint32_t Index;
+        };
+
+        struct DecodeResult
+        {
+          uint32_t Index;
+          std::unique_ptr<TextureData> Data;
+          std::string Error;
+        };
+
+        struct RetiredTexture
+        {
+          uint64_t Texture;
+          uint64_t FenceValue;
+        };
+
+      private:
+        void pushQueue(uint32_t index);
+        void retireUploads(void);
+        void dispatchDecodes(void);
+        void collectDecodes(void);
+        void uploadDecoded(void);
+        void streamMips(void);
+        bool changeResidentMip(uint32_t index, uint32_t targetMip);
+        void submitUploads(void);
+        uint64_t computeStagingSize(const TextureData& data, uint32_t firstMip, uint32_t endMip, uint32_t textureFirstMip) const;
+        void stageMips(const TextureData& data, uint32_t firstMip, uint32_t endMip, uint64_t texture, uint32_t textureFirstMip, uint64_t stagingOffset) const;
+        void fail(uint32_t index, const std::string& error);
+        DecodeResult decode(uint32_t index, const std::string& path) const;
+
+      private:
+        TextureStreamerDesc m_desc;
+        ITextureDecoder* m_decoder;
+        ITextureUploadBackend* m_backend;
+        ThreadPool* m_threadPool;
+        StagingRing m_ring;
+        std::vector<Entry> m_entries;
+        std::unordered_map<std::string, uint32_t> m_pathToIndex;
+        std::vector<QueueItem> m_queue;               // 優先度のヒープ(変更前の古い要素は取り出し時に捨てる)
+        uint32_t m_sequence;
+        std::vector<uint32_t> m_decoded;
+        std::vector<uint32_t> m_uploading;
+        // このUpdateで記録したコピー(一回のサブミットにまとめる)
+        std::vector<uint32_t> m_recordedUploads;
+        std::vector<uint32_t> m_recordedMipChanges;
+        uint64_t m_recordedBytes;
+        // ミップの入れ替え
+        MipResidency m_residency;
+        std::vector<MipResidencyAction> m_mipActions;
+        std::vector<uint32_t> m_mipChanging;
+        std::vector<RetiredTexture> m_retiredTextures;
+        uint64_t m_frameIndex;
+        uint32_t m_decodesInFlight;
+        // ワーカーから返ってきた結果
+        std::vector<DecodeResult> m_completedDecodes;
+        uint32_t m_runningDecodeCount;
+        std::mutex m_completedMutex;
+        std::condition_variable m_completedCondition;
+        uint64_t m_placeholder;
+        ResidentFunc m_onResident;
+        TextureStreamerStats m_stats;
+    };
+
+    inline uint64_t TextureStreamer::GetPlaceholder() const
+    {
+      return m_placeholder;
+    }
+
+    inline size_t TextureStreamer::GetCount() const
+    {
+      return m_entries.size();
+    }
+
+    inline const TextureStreamerStats& TextureStreamer::GetStats() const
+    {
+      return m_stats;
+    }
+
+    inline bool TextureStreamer::IsMipStreamingEnabled() const
+    {
+      return m_desc.ResidencyBudgetBytes != 0;
+    }
+
+    inline const MipResidency& TextureStreamer::GetResidency() const
+    {
+      return m_residency;
+    }
+  }
+}
+
+#endif
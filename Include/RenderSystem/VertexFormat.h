@@ -0,0 +1,126 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Vertex format description (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_VERTEX_FORMAT
+#define M_VERTEX_FORMAT
+
+#include <cstdint>
+#include <string>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    enum class VertexSemantic : uint8_t
+    {
+      Position,
+      Normal,
+      TexCoord,
+    };
+
+    constexpr uint32_t VERTEX_SEMANTIC_COUNT = 3;
+
+    /// @brief
+    /// 頂点要素の持ち方(値はファイルに書くので変えない)
+    enum class VertexElementFormat : uint8_t
+    {
+      None = 0,                       // 持たない
+      Float2 = 1,                     // R32G32_FLOAT
+      Float3 = 2,                     // R32G32B32_FLOAT
+      Half2 = 3,                      // R16G16_FLOAT
+      UNorm16x4 = 4,                  // R16G16B16A16_UNORM(位置専用: xyz * Scale + Bias、wは0)
+      OctahedralSNorm16x2 = 5,        // R16G16_SNORM(法線専用: 八面体マッピング)
+    };
+
+    /// @brief
+    /// 属性ごとの持ち方
+    struct VertexFormatDesc final
+    {
+      VertexElementFormat Position;
+      VertexElementFormat Normal;
+      VertexElementFormat TexCoord;
+    };
+
+    // 量子化しない形(MeshVertexと同じ32バイト)
+    constexpr VertexFormatDesc VERTEX_FORMAT_FULL = { VertexElementFormat::Float3, VertexElementFormat::Float3, VertexElementFormat::Float2 };
+    // 座標とUVだけの形(2Dの板ポリゴンなど)
+    constexpr VertexFormatDesc VERTEX_FORMAT_POSITION_TEXCOORD = { VertexElementFormat::Float3, VertexElementFormat::None, VertexElementFormat::Float2 };
+    // 量子化した形(16バイト)
+    constexpr VertexFormatDesc VERTEX_FORMAT_COMPACT = { VertexElementFormat::UNorm16x4, VertexElementFormat::OctahedralSNorm16x2, VertexElementFormat::Half2 };
+
+    struct VertexElement final
+    {
+      VertexSemantic Semantic;
+      VertexElementFormat Format;
+      uint32_t Offset;                // 頂点の先頭から
+    };
+
+    /// @brief
+    /// VertexFormatDescから求めた頂点のレイアウト(要素はPosition、Normal、TexCoordの順に詰める)
+    struct VertexLayout final
+    {
+      VertexFormatDesc Desc;
+      VertexElement Elements[VERTEX_SEMANTIC_COUNT];
+      uint32_t ElementCount;
+      uint32_t Stride;
+    };
+
+    /// @brief
+    /// メッシュごとの位置の量子化パラメーター(バウンディングボックスから求める)
+    /// 位置 = UNorm16x4の値(0～1) * PositionScale + PositionBias
+    struct VertexQuantization final
+    {
+      float PositionScale[3];
+      float PositionBias[3];
+    };
+
+    class VertexFormat final
+    {
+      public:
+        /// @brief
+        /// レイアウトを求める
+        /// @param desc 属性ごとの持ち方(属性に使えない持ち方は失敗する)
+        /// @param outLayout レイアウト
+        /// @param outError 失敗した理由
+        static bool CreateLayout(const VertexFormatDesc& desc, VertexLayout& outLayout, std::string& outError);
+
+        /// @brief
+        /// 要素のバイト数(Noneは0)
+        static uint32_t GetElementSize(VertexElementFormat format);
+
+        /// @brief
+        /// 要素のDXGI_FORMATの値
+        static uint32_t GetDxgiFormat(VertexElementFormat format);
+
+        /// @brief
+        /// HLSLのセマンティクス名
+        static const char* GetSemanticName(VertexSemantic semantic);
+
+        static const char* GetFormatName(VertexElementFormat format);
+
+        /// @brief
+        /// レイアウトから属性の要素を探す
+        /// @return 見つからなければnullptr
+        static const VertexElement* FindElement(const VertexLayout& layout, VertexSemantic semantic);
+
+      private:
+        VertexFormat() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Vertex attribute quantization (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_VERTEX_QUANTIZER
+#define M_VERTEX_QUANTIZER
+
+#include <RenderSystem/MeshData.h>
+#include <RenderSystem/VertexFormat.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 量子化して戻したときの最大誤差
+    struct VertexQuantizationError final
+    {
+      float Position;                 // バウンディングボックスの最大辺に対する割合
+      float NormalDegrees;            // 法線の角度の差(度)
+      float TexCoord;                 // UVの差
+    };
+
+    /// @brief
+    /// MeshVertexとVertexLayoutの形の頂点を相互に変換する(SSE2が使える場合は4頂点ずつ処理する)
+    /// 八面体マッピングの法線はシェーダー側で次のように戻す
+    ///   float3 n = float3(e.xy, 1 - abs(e.x) - abs(e.y));
+    ///   float t = saturate(-n.z);
+    ///   n.xy += (n.xy >= 0) ? -t : t;
+    ///   n = normalize(n);
+    class VertexQuantizer final
+    {
+      public:
+        /// @brief
+        /// 位置の量子化パラメーターをバウンディングボックスから求める
+        static VertexQuantization ComputeQuantization(const MeshVertex* vertices, size_t vertexCount);
+
+        /// @brief
+        /// バウンディングボックスから量子化パラメーターを作る(CookedMeshEntryの値から戻すときに使う)
+        static VertexQuantization CreateQuantization(const float boundsMin[3], const float boundsMax[3]);
+
+        /// @brief
+        /// 頂点をレイアウトの形に書き出す
+        /// @param outVertices layout.Stride * vertexCountバイト以上
+        static void Encode(const MeshVertex* vertices, size_t vertexCount, const VertexLayout& layout, const VertexQuantization& quantization, uint8_t* outVertices);
+
+        /// @brief
+        /// レイアウトの形の頂点をMeshVertexに戻す(レイアウトにない属性は0になる)
+        static void Decode(const uint8_t* vertices, size_t vertexCount, const VertexLayout& layout, const VertexQuantization& quantization, MeshVertex* outVertices);
+
+        /// @brief
+        /// 元の頂点と戻した頂点の最大誤差を求める
+        static VertexQuantizationError MeasureError(const MeshVertex* originalVertices, const MeshVertex* decodedVertices, size_t vertexCount);
+
+      private:
+        VertexQuantizer() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by an asset archive
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ARCHIVE_FILE_MOUNT
+#define M_ARCHIVE_FILE_MOUNT
+
+#include <AssetArchive.h>
+#include <ClassBaseInc.h>
+#include <Interfaces/IFileMount.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+
+    /// @brief
+    /// AssetPackerで作ったアーカイブ(.mpak)をマウントする
+    /// 検索はアーカイブのハッシュテーブルをそのまま使う
+    class ArchiveFileMount final : public IFileMount, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ArchiveFileMount)
+
+      public:
+        /// @brief
+        /// アーカイブを開く
+        /// @param archivePath アーカイブファイル(UTF-8)
+        /// @param isVerifyData データのハッシュも検証する
+        /// @param threadPool 圧縮したエントリーを展開するときに使うスレッドプール(nullptrなら呼び出したスレッドだけで展開する)
+        bool Init(const std::string& archivePath, bool isVerifyData = false, ThreadPool* threadPool = nullptr);
+
+        const AssetArchive& GetArchive(void) const;
+
+      public:
+        uint32_t Find(std::string_view normalizedPath, uint64_t pathHash) const override;
+        uint32_t GetCount(void) const override;
+        std::string_view GetPath(uint32_t index) const override;
+        uint64_t GetSize(uint32_t index) const override;
+        AssetView GetView(uint32_t index) const override;
+        bool Read(uint32_t index, uint8_t* dst, size_t dstSize) const override;
+        bool GetNativePath(uint32_t index, std::string& outPath) const override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        AssetArchive m_archive;
+        ThreadPool* m_threadPool;
+    };
+
+    inline const AssetArchive& ArchiveFileMount::GetArchive() const
+    {
+      return m_archive;
+    }
+  }
+}
+
+#endif
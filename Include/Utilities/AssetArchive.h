@@ -0,0 +1,134 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Memory-mapped packed asset archive reader
+
+Update History: 2026/10/19 Create
+                2026/10/19 Read compressed entries with parallel block decompression
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ASSET_ARCHIVE
+#define M_ASSET_ARCHIVE
+
+#include <ClassBaseInc.h>
+#include <AssetArchiveFormat.h>
+#include <MappedFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ICompressionCodec;
+    class ThreadPool;
+
+    /// @brief
+    /// アーカイブ内のデータを指すビュー(マップしたメモリを直接指す)
+    struct AssetView final
+    {
+      const uint8_t* Data;
+      size_t Size;
+
+      bool IsValid(void) const
+      {
+        return Data != nullptr;
+      }
+    };
+
+    /// @brief
+    /// AssetPackerが書き出したアーカイブをメモリマップで読む
+    /// 検索はハッシュテーブルの探索(O(1))で、文字列を作らずに正規化しながら比べる
+    /// 圧縮していないエントリーはマップしたメモリを直接返し、圧縮したエントリーはReadで展開する
+    /// 返したポインターはDisposeまで有効
+    class AssetArchive final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(AssetArchive)
+
+      public:
+        /// @brief
+        /// ファイルをマップしてヘッダーとテーブルを検証する
+        /// @param filePath アーカイブファイル(UTF-8)
+        /// @param isVerifyData データのハッシュも検証する(全体を読むので遅い)
+        bool Open(const std::string& filePath, bool isVerifyData = false);
+
+        /// @brief
+        /// パスでデータを探す(区切り文字と大文字小文字は区別しない)
+        /// @return 見つからないか圧縮したエントリーなら無効なビュー
+        AssetView Find(std::string_view path) const;
+
+        /// @brief
+        /// パスでエントリー番号を探す
+        /// @return 見つからなければASSET_ARCHIVE_EMPTY_BUCKET
+        uint32_t FindIndex(std::string_view path) const;
+
+        /// @brief
+        /// エントリーを番号で取得する(パス順に並んでいる)
+        /// GetDataは圧縮したエントリーなら無効なビューを返す
+        AssetView GetData(uint32_t index) const;
+        AssetView GetStoredData(uint32_t index) const;
+        std::string_view GetPath(uint32_t index) const;
+
+        /// @brief
+        /// 展開後のサイズを取得する
+        uint64_t GetSize(uint32_t index) const;
+        bool IsCompressed(uint32_t index) const;
+
+        /// @brief
+        /// エントリーの内容を展開して書き込む(ステージングバッファーに直接書き込める)
+        /// @param index エントリー番号
+        /// @param dst 書き込み先
+        /// @param dstSize 書き込み先のサイズ(GetSize以上)
+        /// @param threadPool ブロックを分担するスレッドプール(nullptrなら呼び出したスレッドだけで展開する)
+        bool Read(uint32_t index, uint8_t* dst, size_t dstSize, ThreadPool* threadPool = nullptr) const;
+
+        /// @brief
+        /// 展開に使うコーデックを登録する(Lz4Codecは最初から登録されている)
+        /// @param codec IDがASSET_ARCHIVE_MAX_CODEC_COUNT未満のコーデック(アーカイブより長く生存すること)
+        bool RegisterCodec(const ICompressionCodec* codec);
+
+        bool IsOpen(void) const;
+        uint32_t GetCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        bool validate(bool isVerifyData) const;
+
+      private:
+        MappedFile m_file;
+        const AssetArchiveBucket* m_buckets;
+        const AssetArchiveEntry* m_entries;
+        const char* m_paths;
+        uint32_t m_entryCount;
+        uint32_t m_bucketMask;
+        uint32_t m_blockSize;
+        const ICompressionCodec* m_codecs[ASSET_ARCHIVE_MAX_CODEC_COUNT];
+    };
+
+    inline bool AssetArchive::IsOpen() const
+    {
+      return m_entries != nullptr;
+    }
+
+    inline uint32_t AssetArchive::GetCount() const
+    {
+      return m_entryCount;
+    }
+  }
+}
+
+#endif
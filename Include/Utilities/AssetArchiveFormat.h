@@ -0,0 +1,105 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed asset archive file format
+
+Update History: 2026/10/19 Create
+                2026/10/19 Per-entry block compression
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ASSET_ARCHIVE_FORMAT
+#define M_ASSET_ARCHIVE_FORMAT
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    // ファイル形式
+    // [ヘッダー][ハッシュテーブル][エントリー(パス順)][パス文字列][アライメントしたデータ...]
+    // ポインターを含まないので、マップしたメモリをそのまま参照できる
+    // パスは正規化して保存する(区切りは'/'、ASCIIは小文字、先頭の"./"と"/"は除く)
+    // 圧縮したエントリーのデータは[ブロックごとの圧縮後サイズ(uint32) x BlockCount][圧縮したブロック...]
+    // ブロックは展開後BlockSizeごとに独立して圧縮するので並列に展開できる(縮まないブロックはそのまま格納する)
+    constexpr uint32_t ASSET_ARCHIVE_MAGIC = 0x4b41504d;                // "MPAK"
+    constexpr uint32_t ASSET_ARCHIVE_VERSION = 2;
+    constexpr uint32_t ASSET_ARCHIVE_DEFAULT_ALIGNMENT = 512;           // .mtexのデータ配置(TEXTURE_DATA_PLACEMENT_ALIGNMENT)を崩さない
+    constexpr uint32_t ASSET_ARCHIVE_DEFAULT_BLOCK_SIZE = 256 * 1024;
+    constexpr uint32_t ASSET_ARCHIVE_MAX_CODEC_COUNT = 8;
+    constexpr uint32_t ASSET_ARCHIVE_EMPTY_BUCKET = 0xFFFFFFFF;
+
+    struct AssetArchiveHeader final
+    {
+      uint32_t Magic;
+      uint32_t Version;
+      uint32_t EntryCount;
+      uint32_t BucketCount;         // 2の累乗(エントリー数の2倍以上)
+      uint32_t DataAlignment;
+      uint32_t BlockSize;           // 圧縮したエントリーのブロックの展開後サイズ
+      uint64_t BucketOffset;        // ファイル先頭から
+      uint64_t EntryOffset;
+      uint64_t PathOffset;
+      uint64_t PathSize;
+      uint64_t FileSize;
+    };
+
+    /// @brief
+    /// 開番地法のハッシュテーブルの一要素(線形探索)
+    struct AssetArchiveBucket final
+    {
+      uint64_t PathHash;
+      uint32_t EntryIndex;          // 空ならASSET_ARCHIVE_EMPTY_BUCKET
+      uint32_t Reserved;
+    };
+
+    struct AssetArchiveEntry final
+    {
+      uint64_t PathHash;
+      uint64_t Offset;              // ファイル先頭から(DataAlignmentの倍数)
+      uint64_t Size;                // 展開後のサイズ
+      uint64_t StoredSize;          // ファイル内のサイズ(圧縮しなければSizeと同じ)
+      uint64_t DataHash;            // ファイル内のバイト列のハッシュ(破損検出用)
+      uint32_t PathOffset;          // パス文字列の先頭から
+      uint32_t PathLength;
+      uint32_t Codec;               // COMPRESSION_CODEC_NONEなら圧縮しない
+      uint32_t BlockCount;
+    };
+
+    static_assert(sizeof(AssetArchiveHeader) == 64, "AssetArchiveHeader size must be fixed");
+    static_assert(sizeof(AssetArchiveBucket) == 16, "AssetArchiveBucket size must be fixed");
+    static_assert(sizeof(AssetArchiveEntry) == 56, "AssetArchiveEntry size must be fixed");
+
+    class AssetArchiveFormat final
+    {
+      public:
+        /// @brief
+        /// パスを正規化する(書き出し時に使う)
+        static std::string NormalizePath(std::string_view path);
+
+        /// @brief
+        /// 正規化したパスのハッシュ値を求める(文字列を作らずに一文字ずつ正規化する)
+        static uint64_t ComputePathHash(std::string_view path);
+
+        /// @brief
+        /// 正規化済みのパスと、正規化前のパスが一致するか
+        static bool IsSamePath(std::string_view normalizedPath, std::string_view path);
+
+      private:
+        AssetArchiveFormat() = delete;
+    };
+  }
+}
+
+#endif
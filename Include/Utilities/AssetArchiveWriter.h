@@ -0,0 +1,105 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed asset archive writer
+
+Update History: 2026/10/19 Create
+                2026/10/19 Per-entry block compression
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ASSET_ARCHIVE_WRITER
+#define M_ASSET_ARCHIVE_WRITER
+
+#include <ClassBaseInc.h>
+#include <AssetArchiveFormat.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ICompressionCodec;
+    class ThreadPool;
+
+    /// @brief
+    /// ファイルを集めて一つのアーカイブに書き出す
+    /// コーデックを設定すると、エントリーごとにブロック単位で圧縮し、十分に縮んだものだけ圧縮して格納する
+    class AssetArchiveWriter final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(AssetArchiveWriter)
+
+      public:
+        /// @brief
+        /// データを追加する
+        /// @param path アーカイブ内のパス(正規化して保存する)
+        /// @param isAllowCompression falseなら圧縮しない(既に圧縮されている形式など)
+        /// @return 同じパスで内容が異なるものが既にあればfalse
+        bool Add(std::string_view path, const void* data, size_t size, bool isAllowCompression = true);
+
+        /// @brief
+        /// ファイルを読み込んで追加する
+        /// @param path アーカイブ内のパス
+        /// @param filePath 読み込むファイル(UTF-8)
+        bool AddFile(std::string_view path, const std::string& filePath, bool isAllowCompression = true);
+
+        /// @brief
+        /// 圧縮の設定
+        /// @param codec nullptrなら圧縮しない(WriteToFileまで生存すること)
+        /// @param blockSize 展開後のブロックサイズ
+        /// @param maxRatio 圧縮後のサイズが元のこの割合以下になったエントリーだけ圧縮する
+        void SetCompression(const ICompressionCodec* codec, uint32_t blockSize = ASSET_ARCHIVE_DEFAULT_BLOCK_SIZE, float maxRatio = 0.9f);
+
+        /// @brief
+        /// ハッシュテーブルとアライメントしたデータを書き出す
+        /// @param dataAlignment データの先頭のアライメント(2の累乗)
+        /// @param threadPool 圧縮を分担するスレッドプール(nullptrなら呼び出したスレッドだけで処理する)
+        bool WriteToFile(const std::string& filePath, uint32_t dataAlignment = ASSET_ARCHIVE_DEFAULT_ALIGNMENT, ThreadPool* threadPool = nullptr) const;
+
+        size_t GetCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Asset
+        {
+          std::vector<uint8_t> Data;
+          bool IsAllowCompression;
+        };
+
+        /// @brief
+        /// ブロック単位で圧縮する
+        /// @return 十分に縮まなければfalse
+        bool compress(const Asset& asset, std::vector<uint8_t>& outStored, ThreadPool* threadPool) const;
+
+      private:
+        // パス順に並べておく(同じ入力なら同じファイルになる)
+        std::map<std::string, Asset> m_assets;
+        const ICompressionCodec* m_codec;
+        uint32_t m_blockSize;
+        float m_maxRatio;
+    };
+
+    inline size_t AssetArchiveWriter::GetCount() const
+    {
+      return m_assets.size();
+    }
+  }
+}
+
+#endif
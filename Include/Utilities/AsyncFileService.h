@@ -0,0 +1,197 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Asynchronous file read service with priorities and read coalescing
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ASYNC_FILE_SERVICE
+#define M_ASYNC_FILE_SERVICE
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IAsyncFileBackend.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+
+    /// @brief
+    /// 読み込みの優先度(高いクラスが残っている間は低いクラスを発行しない)
+    enum class AsyncFilePriority : uint8_t
+    {
+      Critical,     // 今のフレームで必要なもの
+      High,
+      Normal,
+      Low,          // 先読みなど
+    };
+
+    constexpr size_t ASYNC_FILE_PRIORITY_COUNT = 4;
+
+    struct AsyncFileResult final
+    {
+      uint64_t RequestId;
+      void* Buffer;
+      uint64_t Size;                    // 要求したバイト数
+      uint64_t ReadSize;                // 読めたバイト数(終端を越えた分は読めない)
+      bool IsSucceeded;                 // エラーがなく要求した分をすべて読めた
+    };
+
+    struct AsyncFileServiceDesc final
+    {
+      uint32_t QueueDepth = 64;                       // 同時に発行する読み込みの数(io_uring)
+      uint32_t ThreadCount = 4;                       // 読み込みスレッドの数(代わりのバックエンド)
+      uint64_t MaxCoalesceGap = 64 * 1024;            // この間隔までの隣り合う範囲は一回で読む(間は捨てる)
+      uint64_t MaxCoalesceSize = 4 * 1024 * 1024;     // まとめた読み込みの最大サイズ
+      bool IsPreferIoUring = true;                    // Linuxではio_uringを試す
+    };
+
+    struct AsyncFileServiceStats final
+    {
+      uint64_t RequestCount;            // 受け付けた要求の数
+      uint64_t ReadCount;               // バックエンドに発行した読み込みの数(まとめた後)
+      uint64_t CoalescedCount;          // 他の要求とまとめて読んだ要求の数
+      uint64_t ReadBytes;               // 読んだバイト数(捨てた間も含む)
+    };
+
+    /// @brief
+    /// 非同期にファイルを読み込むサービス
+    /// 要求は優先度ごとのキューに入り、ディスパッチスレッドが同じファイルの近い範囲をまとめてバックエンドに発行する
+    /// 読み込み先は呼び出し側が用意し、完了はコールバックまたはstd::futureで受け取る
+    /// バックエンドはLinuxならio_uring、使えなければスレッドでの同期読み込みになる
+    class AsyncFileService final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(AsyncFileService)
+
+      public:
+        ALIAS(std::function<void(const AsyncFileResult&)>, Callback);
+
+        static constexpr uint32_t INVALID_FILE_ID = 0;
+        static constexpr uint64_t INVALID_REQUEST_ID = 0;
+
+      public:
+        /// @brief
+        /// バックエンドとディスパッチスレッドを起動する
+        /// @param callbackPool コールバックを呼ぶスレッドプール(nullptrならディスパッチスレッドで呼ぶので短い処理にする)
+        bool Init(const AsyncFileServiceDesc& desc, ThreadPool* callbackPool = nullptr);
+
+        /// @brief
+        /// ファイルを開く(パスはUTF-8)
+        /// @return ファイルID(失敗ならINVALID_FILE_ID)
+        uint32_t OpenFile(const std::string& filePath);
+
+        /// @brief
+        /// ファイルを閉じる(読み込み中の要求があれば完了してから閉じる)
+        void CloseFile(uint32_t file);
+
+        uint64_t GetFileSize(uint32_t file) const;
+
+        /// @brief
+        /// 読み込みを要求する(スレッドセーフ)
+        /// @param file OpenFileの戻り値
+        /// @param offset ファイル先頭からの位置
+        /// @param size バイト数
+        /// @param buffer 読み込み先(完了するまで有効であること)
+        /// @param priority 優先度
+        /// @param callback 完了時に一度だけ呼ばれる
+        /// @return 要求ID(受け付けなかった場合はINVALID_REQUEST_IDでコールバックも呼ばない)
+        uint64_t Read(uint32_t file, uint64_t offset, uint64_t size, void* buffer, AsyncFilePriority priority, Callback callback);
+
+        /// @brief
+        /// 読み込みを要求し、結果をstd::futureで受け取る
+        /// 受け付けなかった場合はすぐに失敗の結果が入る
+        std::future<AsyncFileResult> ReadAsync(uint32_t file, uint64_t offset, uint64_t size, void* buffer, AsyncFilePriority priority = AsyncFilePriority::Normal);
+
+        /// @brief
+        /// 受け付けた要求がすべて完了し、コールバックが戻るまで待つ
+        void WaitIdle(void);
+
+        const char* GetBackendName(void) const;
+        AsyncFileServiceStats GetStats(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Request
+        {
+          uint64_t Id;
+          uint32_t File;
+          uint64_t Offset;
+          uint64_t Size;
+          void* Buffer;
+          Callback OnComplete;
+        };
+
+        // バックエンドへの一回の読み込み(まとめた要求を持つ)
+        struct Batch
+        {
+          std::vector<Request> Requests;                // オフセット順
+          std::vector<AsyncFileBuffer> Buffers;         // 要求の読み込み先と、間を捨てるための区間
+          std::vector<uint8_t> GapBuffer;
+          intptr_t NativeFile;
+          uint64_t Offset;
+          uint64_t Size;
+          uint64_t ReadSize;
+          uint32_t FirstBuffer;                         // 短い読み込みの続きを読むときの先頭
+        };
+
+        struct FileEntry
+        {
+          intptr_t NativeFile;
+          uint64_t Size;
+          uint32_t PendingCount;
+          bool IsOpen;
+          bool IsClosing;
+        };
+
+      private:
+        void dispatcherMain(void);
+        bool popBatch(Batch& batch);
+        bool submitBatch(Batch& batch);
+        void completeBatch(Batch& batch, bool isFailed);
+        void completeRequest(Request& request, const AsyncFileResult& result);
+        void finishRequest(void);
+        void releaseFile(uint32_t file);
+
+      private:
+        std::unique_ptr<IAsyncFileBackend> m_backend;
+        ThreadPool* m_callbackPool;
+        AsyncFileServiceDesc m_desc;
+        std::thread m_dispatcher;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_idleCondition;
+        std::deque<Request> m_queues[ASYNC_FILE_PRIORITY_COUNT];
+        std::vector<FileEntry> m_files;
+        uint64_t m_nextRequestId;
+        uint64_t m_outstandingCount;                    // 受け付けてからコールバックが戻るまでの数
+        AsyncFileServiceStats m_stats;
+        bool m_isStopping;
+    };
+  }
+}
+
+#endif
@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : Base definition macro
 
 Update History: 2024/11/01 Create
+                2026/10/19 Fix __cplusplus and typedef fallbacks
 
 Version : alpha_1.0.0
 
@@ -19,7 +20,7 @@ Encoding : UTF-8
 
 
 #if defined(__clang__) || defined(__GNUC__)
-    #define CPP_STANDARD __cpluspluc
+    #define CPP_STANDARD __cplusplus
 #elif defined(_MSC_VER)
     #define CPP_STANDARD _MSVC_LANG
 #endif
@@ -37,9 +38,9 @@ Encoding : UTF-8
 #define REF_ALIAS(type) using Ref = L_VALUE_REF(type);
 #define CONST_REF_ALIAS(type) using Const_Ref = CONST_VAR(L_VALUE_REF(type));
 #else
-#define ALIAS(type, typeAlias) typedef typeAlias type;
+#define ALIAS(type, typeAlias) typedef type typeAlias;
 #define REF_ALIAS(type) typedef type& Ref;
-#define CONST_REF_ALIAS(type) typedef CONST(type&) Const_Ref;
+#define CONST_REF_ALIAS(type) typedef CONST_VAR(L_VALUE_REF(type)) Const_Ref;
 #endif
 
 #endif
@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : D3D12Library Easy Utilities
 
 Update History: 2024/11/19 Create
+                2026/10/19 Fix AlignmentedSize for already aligned sizes
 
 Version : alpha_1.0.0
 
@@ -18,6 +19,8 @@ Encoding : UTF-8
 #ifndef M_D3D12_EASY_UTIL
 #define M_D3D12_EASY_UTIL
 
+#include <cstddef>
+
 namespace MFramework
 {
   inline namespace Utility
@@ -29,7 +32,7 @@ namespace MFramework
         /// アライメントに揃えたサイズを返す
         /// @param size 元のサイズ
         /// @param alignment アラインメントサイズ
-        /// @return アラインメントを揃えたサイズ
+        /// @return アラインメントを揃えたサイズ(すでに揃っていればsizeのまま)
         static size_t AlignmentedSize(size_t size, size_t alignment);
 
 
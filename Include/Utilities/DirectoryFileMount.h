@@ -0,0 +1,84 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by an OS directory
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_DIRECTORY_FILE_MOUNT
+#define M_DIRECTORY_FILE_MOUNT
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IFileMount.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// ディレクトリ以下のファイルをマウントする(Windows / POSIX)
+    /// 初期化時に一度だけ走査して索引を作り、以降の検索はファイルシステムに問い合わせない
+    /// 大文字小文字だけが違うファイルがある場合はパス順で先のものを使う
+    class DirectoryFileMount final : public IFileMount, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(DirectoryFileMount)
+
+      public:
+        /// @brief
+        /// ディレクトリを走査して索引を作る
+        /// @param directoryPath ディレクトリ(UTF-8)
+        /// @param isRecursive サブディレクトリも含める
+        bool Init(const std::string& directoryPath, bool isRecursive = true);
+
+        const std::string& GetDirectoryPath(void) const;
+
+      public:
+        uint32_t Find(std::string_view normalizedPath, uint64_t pathHash) const override;
+        uint32_t GetCount(void) const override;
+        std::string_view GetPath(uint32_t index) const override;
+        uint64_t GetSize(uint32_t index) const override;
+        AssetView GetView(uint32_t index) const override;
+        bool Read(uint32_t index, uint8_t* dst, size_t dstSize) const override;
+        bool GetNativePath(uint32_t index, std::string& outPath) const override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Entry
+        {
+          std::string Path;           // 正規化したパス
+          std::string NativePath;     // UTF-8
+          uint64_t Size;
+        };
+
+      private:
+        std::string m_directoryPath;
+        std::vector<Entry> m_entries;
+        std::unordered_multimap<uint64_t, uint32_t> m_index;
+    };
+
+    inline const std::string& DirectoryFileMount::GetDirectoryPath() const
+    {
+      return m_directoryPath;
+    }
+  }
+}
+
+#endif
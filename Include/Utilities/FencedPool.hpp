@@ -0,0 +1,194 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Fence-retired object pool template class
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_FENCED_POOL
+#define M_FENCED_POOL
+
+#include <ClassBaseInc.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// フレーム内で払い出したオブジェクトをフェンス値と一緒に退役させ、完了してから再利用するプール
+    /// オブジェクトはプールが所有し、Disposeまで解放しない
+    /// 取り出したオブジェクトのリセットは呼び出す側が行う(ロックの外で行えるように)
+    ///
+    /// 使い方:
+    ///   BeginFrame(完了済みフェンス値) -> 各スレッドでAcquire -> EndFrame(シグナルしたフェンス値)
+    template<typename Value_Type>
+    class FencedPool final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(FencedPool)
+
+      public:
+        /// @brief
+        /// フェンス値が完了したオブジェクトを再利用できるように戻す
+        /// @param completedFenceValue 完了済みのフェンス値
+        void BeginFrame(uint64_t completedFenceValue);
+
+        /// @brief
+        /// 空いているオブジェクトを取得する(スレッドセーフ)
+        /// 空きがなければcreateFuncで作る(ロックを持ったまま呼ぶ)
+        /// @param createFunc std::unique_ptr<Value_Type>を返す関数(失敗ならnullptr)
+        /// @return 作成に失敗したらnullptr
+        template<typename Create_Func_Type>
+        Value_Type* Acquire(Create_Func_Type&& createFunc);
+
+        /// @brief
+        /// このフレームで取得したすべてのオブジェクトを退役させる
+        /// @param signaledFenceValue サブミット後にシグナルしたフェンス値
+        void EndFrame(uint64_t signaledFenceValue);
+
+        size_t GetCreatedCount(void) const;
+        size_t GetAvailableCount(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct RetiredValue
+        {
+          Value_Type* Value;
+          uint64_t FenceValue;
+        };
+
+      private:
+        std::vector<std::unique_ptr<Value_Type>> m_values;
+        std::vector<Value_Type*> m_availableValues;
+        std::vector<Value_Type*> m_acquiredValues;
+        std::vector<RetiredValue> m_retiredValues;
+        mutable std::mutex m_mutex;
+    };
+
+    template<typename Value_Type>
+    FencedPool<Value_Type>::FencedPool()
+      : m_values()
+      , m_availableValues()
+      , m_acquiredValues()
+      , m_retiredValues()
+      , m_mutex()
+    { }
+
+    template<typename Value_Type>
+    FencedPool<Value_Type>::~FencedPool()
+    {
+      Dispose();
+    }
+
+    template<typename Value_Type>
+    void FencedPool<Value_Type>::BeginFrame(uint64_t completedFenceValue)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      auto retiredEnd = std::remove_if(
+                                        m_retiredValues.begin(),
+                                        m_retiredValues.end(),
+                                        [this, completedFenceValue](const RetiredValue& retired)
+                                        {
+                                          if (retired.FenceValue > completedFenceValue)
+                                          {
+                                            return false;
+                                          }
+
+                                          m_availableValues.emplace_back(retired.Value);
+                                          return true;
+                                        }
+                                      );
+
+      m_retiredValues.erase(retiredEnd, m_retiredValues.end());
+    }
+
+    template<typename Value_Type>
+    template<typename Create_Func_Type>
+    Value_Type* FencedPool<Value_Type>::Acquire(Create_Func_Type&& createFunc)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      Value_Type* value = nullptr;
+      if (!m_availableValues.empty())
+      {
+        value = m_availableValues.back();
+        m_availableValues.pop_back();
+      }
+      else
+      {
+        std::unique_ptr<Value_Type> newValue = createFunc();
+        if (newValue == nullptr)
+        {
+          return nullptr;
+        }
+
+        value = newValue.get();
+        m_values.emplace_back(std::move(newValue));
+      }
+
+      m_acquiredValues.emplace_back(value);
+      return value;
+    }
+
+    template<typename Value_Type>
+    void FencedPool<Value_Type>::EndFrame(uint64_t signaledFenceValue)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for (Value_Type* value : m_acquiredValues)
+      {
+        m_retiredValues.emplace_back(RetiredValue{ value, signaledFenceValue });
+      }
+
+      m_acquiredValues.clear();
+    }
+
+    template<typename Value_Type>
+    size_t FencedPool<Value_Type>::GetCreatedCount() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      return m_values.size();
+    }
+
+    template<typename Value_Type>
+    size_t FencedPool<Value_Type>::GetAvailableCount() const
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      return m_availableValues.size();
+    }
+
+    template<typename Value_Type>
+    void FencedPool<Value_Type>::Dispose() noexcept
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      m_availableValues.clear();
+      m_acquiredValues.clear();
+      m_retiredValues.clear();
+      m_values.clear();
+    }
+  }
+}
+
+#endif
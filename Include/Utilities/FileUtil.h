@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : File Utilities
 
 Update History: 2024/11/10 Create
+                2026/10/19 Cache resolved paths and drop Shlwapi
 
 Version : alpha_1.0.0
 
@@ -29,9 +30,20 @@ namespace MFramework
       private:
         FileUtility() = delete;
       public:
+        /// @brief
+        /// ファイル名をそのまま、実行ファイルのディレクトリ、その二つ上、その下のAssets/Imagesの順で探す
+        /// 見つかったパスはキャッシュして、二回目からはファイルシステムに問い合わせない
         static bool SearchFilePath(const wchar_t* fileName, std::wstring& filePath);
+
+        /// @brief
+        /// SearchFilePathのキャッシュを捨てる(ファイルを追加、移動した後に呼ぶ)
+        static void ClearSearchCache(void);
+
+        /// @brief
+        /// 実行ファイルのあるディレクトリ(一回だけ求める)
+        static const std::wstring& GetExecutableDirectory(void);
     };
   }
 }
 
-#endif
\ No newline at end of file
+#endif
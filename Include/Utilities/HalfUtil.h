@@ -0,0 +1,46 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Half float Utilities
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_HALF_UTIL
+#define M_HALF_UTIL
+
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// IEEE754の半精度浮動小数点数(DXGI_FORMAT_R16_FLOATなど)との変換
+    class HalfUtility final
+    {
+      public:
+        /// @brief
+        /// floatを半精度に変換する(最近接偶数丸め、範囲外は無限大)
+        static uint16_t FloatToHalf(float value);
+
+        /// @brief
+        /// 半精度をfloatに変換する
+        static float HalfToFloat(uint16_t value);
+
+      private:
+        HalfUtility() = delete;
+    };
+  }
+}
+
+#endif
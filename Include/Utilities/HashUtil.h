@@ -0,0 +1,76 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Hash Utilities
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add Crc32
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_HASH_UTIL
+#define M_HASH_UTIL
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class HashUtility final
+    {
+      public:
+        static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+        static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+      public:
+        /// @brief
+        /// FNV-1a(64bit)でバイト列のハッシュ値を求める
+        /// @param data 先頭アドレス
+        /// @param size バイト数
+        /// @param seed 続けてハッシュする場合は前回の結果を渡す
+        /// @return ハッシュ値
+        static uint64_t Fnv1a64(const void* data, size_t size, uint64_t seed = FNV_OFFSET_BASIS);
+
+        /// @brief
+        /// 文字列(終端文字まで)のハッシュ値を求める
+        static uint64_t Fnv1a64String(const char* str, uint64_t seed = FNV_OFFSET_BASIS);
+
+        /// @brief
+        /// CRC-32(PNG/zlibと同じ多項式)を求める
+        /// @param crc 続けて計算する場合は前回の結果を渡す
+        static uint32_t Crc32(const void* data, size_t size, uint32_t crc = 0);
+
+        /// @brief
+        /// 二つのハッシュ値を混ぜる
+        static uint64_t Combine(uint64_t seed, uint64_t value);
+
+        /// @brief
+        /// トリビアルコピー可能な値をそのままハッシュする
+        template<typename T>
+        static uint64_t HashValue(const T& value, uint64_t seed = FNV_OFFSET_BASIS);
+
+      private:
+        HashUtility() = delete;
+    };
+
+    template<typename T>
+    inline uint64_t HashUtility::HashValue(const T& value, uint64_t seed)
+    {
+      static_assert(std::is_trivially_copyable_v<T>, "HashValueの型はトリビアルコピー可能でなければなりません");
+      return Fnv1a64(&value, sizeof(T), seed);
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Deflate decompression Utilities
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_INFLATE_UTIL
+#define M_INFLATE_UTIL
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// Deflate(RFC1951)とzlib(RFC1950)形式の展開
+    /// PNGのIDATなど、外部ライブラリなしで読む必要があるデータに使う
+    class InflateUtility final
+    {
+      public:
+        /// @brief
+        /// zlib形式(2byteのヘッダー + Deflate + Adler-32)を展開する
+        /// @param src 圧縮データ
+        /// @param size バイト数
+        /// @param outData 展開先(末尾に追加しない、上書きする)
+        /// @param outError 失敗した理由
+        /// @param expectedSize 展開後のサイズがわかっていれば渡す(確保の回数を減らす)
+        static bool DecompressZlib(const uint8_t* src, size_t size, std::vector<uint8_t>& outData, std::string& outError, size_t expectedSize = 0);
+
+        /// @brief
+        /// ヘッダーなしのDeflateを展開する
+        /// @param outConsumedSize 読み終えたバイト数(最後のブロックの終わりまで)
+        static bool Decompress(const uint8_t* src, size_t size, std::vector<uint8_t>& outData, std::string& outError, size_t expectedSize = 0, size_t* outConsumedSize = nullptr);
+
+        /// @brief
+        /// Adler-32を求める
+        static uint32_t Adler32(const uint8_t* data, size_t size, uint32_t adler = 1);
+
+      private:
+        InflateUtility() = delete;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,89 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Asynchronous file read backend interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IASYNC_FILE_BACKEND
+#define M_IASYNC_FILE_BACKEND
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// 読み込み先の一区間(POSIXのiovecと同じ配置)
+    struct AsyncFileBuffer final
+    {
+      void* Data;
+      size_t Size;
+    };
+
+    /// @brief
+    /// 一回の読み込み(連続したファイルの範囲を複数のバッファーに順に読む)
+    /// Buffersは完了するまで呼び出し側が保持する
+    struct AsyncFileOperation final
+    {
+      intptr_t File;                    // ネイティブのハンドル(POSIXはfd、WindowsはHANDLE)
+      uint64_t Offset;
+      AsyncFileBuffer* Buffers;
+      uint32_t BufferCount;
+      void* UserData;
+    };
+
+    struct AsyncFileCompletion final
+    {
+      void* UserData;
+      int64_t Result;                   // 読んだバイト数(負ならエラー)
+    };
+
+    /// @brief
+    /// AsyncFileServiceが使う読み込みバックエンド
+    /// Wake以外はすべてディスパッチスレッドから呼ばれる
+    class IAsyncFileBackend
+    {
+      public:
+        virtual const char* GetName(void) const = 0;
+
+        /// @brief
+        /// 同時に発行できる読み込みの数
+        virtual uint32_t GetQueueDepth(void) const = 0;
+
+        /// @brief
+        /// 読み込みを積む(Flushまで発行されないことがある)
+        virtual bool Submit(const AsyncFileOperation& operation) = 0;
+
+        /// @brief
+        /// 積んだ読み込みをまとめて発行する
+        virtual void Flush(void) = 0;
+
+        /// @brief
+        /// 完了を一つ以上受け取るか、Wakeが呼ばれるまで待つ
+        /// @return 受け取った完了の数
+        virtual size_t WaitCompletions(AsyncFileCompletion* outCompletions, size_t maxCount) = 0;
+
+        /// @brief
+        /// WaitCompletionsで待っているスレッドを起こす(どのスレッドからでも呼べる)
+        /// 待っていないときに呼ばれた場合は次のWaitCompletionsがすぐに戻る
+        virtual void Wake(void) = 0;
+
+        virtual ~IAsyncFileBackend() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Compression codec interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ICOMPRESSION_CODEC
+#define M_ICOMPRESSION_CODEC
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    constexpr uint32_t COMPRESSION_CODEC_NONE = 0;      // 圧縮しない(ファイルに記録するID)
+
+    /// @brief
+    /// ブロック単位の圧縮コーデックのインターフェース
+    /// ブロックごとに独立して展開できること(前のブロックを参照しない)
+    /// ワーカースレッドから同時に呼ばれるため、すべての関数はスレッドセーフでなければならない
+    class ICompressionCodec
+    {
+      public:
+        /// @brief
+        /// ファイルに記録するID(COMPRESSION_CODEC_NONE以外)
+        virtual uint32_t GetId() const = 0;
+
+        /// @brief
+        /// 圧縮後の最大サイズ(出力先に必要な容量)
+        virtual size_t GetMaxCompressedSize(size_t srcSize) const = 0;
+
+        /// @brief
+        /// 圧縮する
+        /// @return 圧縮後のサイズ(容量が足りなければ0)
+        virtual size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const = 0;
+
+        /// @brief
+        /// 展開する(壊れたデータでも範囲外にアクセスしないこと)
+        /// @param dstSize 展開後のサイズ(ちょうど一致しなければ失敗)
+        virtual bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) const = 0;
+
+        virtual ~ICompressionCodec() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Draw packet backend interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IDRAW_PACKET_BACKEND
+#define M_IDRAW_PACKET_BACKEND
+
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 並べ替えた描画パケットを命令にするバックエンド
+    /// DrawPacketQueueは直前と変わったものだけを設定するので、バックエンドは受け取った設定をそのまま記録すればよい
+    /// ルートシグネチャー、パイプラインステート、マテリアル、メッシュはバックエンドに登録したIDで表す
+    class IDrawPacketBackend
+    {
+      public:
+        /// @brief
+        /// ルートシグネチャーを設定する(この後にマテリアルも設定し直される)
+        virtual void SetRootSignature(uint32_t rootSignature) = 0;
+        virtual void SetPipelineState(uint32_t pipelineState) = 0;
+        /// @brief
+        /// マテリアルのディスクリプタテーブルなどを設定する
+        virtual void SetMaterial(uint32_t material) = 0;
+        /// @brief
+        /// 頂点とインデックスのバッファーを設定する
+        virtual void SetMesh(uint32_t mesh) = 0;
+
+        /// @brief
+        /// 設定済みのメッシュをインスタンス描画する
+        /// @param instanceDataOffset インスタンスデータのリング先頭からのオフセット
+        virtual void Draw(uint32_t instanceCount, uint64_t instanceDataOffset) = 0;
+
+        virtual ~IDrawPacketBackend() {}
+    };
+  }
+}
+
+#endif
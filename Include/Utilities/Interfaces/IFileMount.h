@@ -0,0 +1,71 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IFILE_MOUNT
+#define M_IFILE_MOUNT
+
+#include <AssetArchive.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// VirtualFileSystemにマウントするファイルの集まり
+    /// パスはAssetArchiveFormat::NormalizePathで正規化したマウントポイントからの相対パス
+    /// ファイルはマウントしたときの内容で固定し、0から始まる番号で表す
+    class IFileMount
+    {
+      public:
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+      public:
+        /// @brief
+        /// ファイルを探す
+        /// @param normalizedPath 正規化したパス
+        /// @param pathHash AssetArchiveFormat::ComputePathHashの値
+        /// @return ファイル番号(見つからなければINVALID_INDEX)
+        virtual uint32_t Find(std::string_view normalizedPath, uint64_t pathHash) const = 0;
+
+        virtual uint32_t GetCount(void) const = 0;
+        virtual std::string_view GetPath(uint32_t index) const = 0;
+        virtual uint64_t GetSize(uint32_t index) const = 0;
+
+        /// @brief
+        /// コピーせずに参照できる場合はそのビューを返す(できなければ無効なビュー)
+        virtual AssetView GetView(uint32_t index) const = 0;
+
+        /// @brief
+        /// 内容を書き込む
+        /// @param dstSize GetSize以上
+        virtual bool Read(uint32_t index, uint8_t* dst, size_t dstSize) const = 0;
+
+        /// @brief
+        /// OSのファイルとして存在する場合はそのパスを返す(ファイル名を受け取るAPIに渡すため)
+        virtual bool GetNativePath(uint32_t index, std::string& outPath) const = 0;
+
+        virtual ~IFileMount() {}
+    };
+  }
+}
+
+#endif
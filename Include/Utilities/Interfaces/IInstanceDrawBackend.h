@@ -0,0 +1,59 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Instanced draw backend interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IINSTANCE_DRAW_BACKEND
+#define M_IINSTANCE_DRAW_BACKEND
+
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// インスタンス描画一回分
+    struct InstanceDrawCommand final
+    {
+      uint32_t Mesh;
+      uint32_t Material;
+      uint32_t InstanceCount;
+      uint64_t InstanceDataOffset;    // インスタンスデータのリング先頭からのオフセット(InstanceDataがInstanceCount個並ぶ)
+    };
+
+    /// @brief
+    /// InstanceBatcherが描画に使うバックエンド
+    /// メッシュとマテリアルはバックエンドに登録したIDで表す
+    /// すべてメインスレッド(記録中のスレッド)から呼ばれる
+    class IInstanceDrawBackend
+    {
+      public:
+        /// @brief
+        /// インスタンスデータのリングのメモリ(CPUから書き込み可能、GPUからも読める)
+        virtual uint8_t* GetInstanceMemory(void) const = 0;
+        virtual uint64_t GetInstanceCapacity(void) const = 0;
+
+        /// @brief
+        /// インスタンス描画を一回記録する
+        /// 同じメッシュやマテリアルが続く場合、バックエンドは設定し直さなくてよい
+        virtual void DrawInstanced(const InstanceDrawCommand& command) = 0;
+
+        virtual ~IInstanceDrawBackend() {}
+    };
+  }
+}
+
+#endif
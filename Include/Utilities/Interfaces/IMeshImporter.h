@@ -0,0 +1,49 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Mesh importer interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IMESH_IMPORTER
+#define M_IMESH_IMPORTER
+
+#include <RenderSystem/MeshData.h>
+
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// モデルファイルからメッシュを読み込むインターフェース
+    /// ワーカースレッドから同時に呼ばれるため、Importはスレッドセーフでなければならない
+    class IMeshImporter
+    {
+      public:
+        /// @brief
+        /// ファイルを読み込む
+        /// 頂点は三角形の角ごとに並べた状態で返してよい(重複はMeshOptimizer::DeduplicateVerticesでまとめる)
+        /// @param path ファイルパス(UTF-8)
+        /// @param outMeshes マテリアルごとに分けたメッシュ
+        /// @param outError 失敗時のメッセージ
+        virtual bool Import(const std::string& path, std::vector<MeshData>& outMeshes, std::string& outError) const = 0;
+
+        virtual ~IMeshImporter() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,54 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Shader compiler interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ISHADER_COMPILER
+#define M_ISHADER_COMPILER
+
+#include <Graphics_DX12/ShaderCompileCache.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// シェーダーコンパイラーのインターフェース
+    /// 複数スレッドから同時に呼ばれるため、Compileはスレッドセーフでなければならない
+    class IShaderCompiler
+    {
+      public:
+        /// @brief
+        /// コンパイラーの名前(ログ用)
+        virtual const char* GetName(void) const = 0;
+
+        /// @brief
+        /// 一つのパーミュテーションをコンパイルする
+        /// @param desc コンパイル設定
+        /// @param preprocessed インクルード展開済みのソース
+        /// @param outBytecode バイトコード
+        /// @param outError 失敗時のメッセージ
+        virtual bool Compile(const ShaderCompileDesc& desc, const PreprocessedShader& preprocessed, std::vector<uint8_t>& outBytecode, std::string& outError) const = 0;
+
+        virtual ~IShaderCompiler() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture decoder interface
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ITEXTURE_DECODER
+#define M_ITEXTURE_DECODER
+
+#include <RenderSystem/TextureData.h>
+
+#include <string>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// 画像ファイルをデコードするインターフェース
+    /// ワーカースレッドから同時に呼ばれるため、Decodeはスレッドセーフでなければならない
+    class ITextureDecoder
+    {
+      public:
+        /// @brief
+        /// ファイルをデコードする
+        /// @param path ファイルパス(UTF-8)
+        /// @param outData デコード結果
+        /// @param outError 失敗時のメッセージ
+        virtual bool Decode(const std::string& path, TextureData& outData, std::string& outError) const = 0;
+
+        virtual ~ITextureDecoder() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture upload backend interface
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add texture to texture copy for mip streaming
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_ITEXTURE_UPLOAD_BACKEND
+#define M_ITEXTURE_UPLOAD_BACKEND
+
+#include <RenderSystem/TextureFootprint.h>
+
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace RenderSystem
+  {
+    /// @brief
+    /// テクスチャストリーミングがGPUへのアップロードに使うバックエンド
+    /// すべてメインスレッドから呼ばれる
+    /// テクスチャはバックエンドが決める0以外のIDで表す
+    class ITextureUploadBackend
+    {
+      public:
+        /// @brief
+        /// ステージングリングのメモリ(CPUから書き込み可能)
+        virtual uint8_t* GetStagingMemory(void) const = 0;
+        virtual uint64_t GetStagingCapacity(void) const = 0;
+
+        /// @brief
+        /// コピー先のテクスチャを作る
+        /// @return テクスチャID(失敗なら0)
+        virtual uint64_t CreateTexture(const TextureDesc& desc) = 0;
+        virtual void DestroyTexture(uint64_t texture) = 0;
+
+        /// @brief
+        /// ステージングリングからサブリソース一つへのコピーを記録する
+        /// @param texture コピー先
+        /// @param subresource サブリソース番号
+        /// @param footprint リング先頭からの配置
+        virtual void CopyToTexture(uint64_t texture, uint32_t subresource, const SubresourceFootprint& footprint) = 0;
+
+        /// @brief
+        /// テクスチャ間のサブリソースのコピーを記録する(ミップを入れ替えるときに残すミップを移す)
+        virtual void CopyTextureSubresource(uint64_t dstTexture, uint32_t dstSubresource, uint64_t srcTexture, uint32_t srcSubresource) = 0;
+
+        /// @brief
+        /// 記録したコピーをまとめてサブミットする
+        /// @return 完了を示すフェンス値
+        virtual uint64_t Submit(void) = 0;
+
+        /// @brief
+        /// GPUが完了したフェンス値
+        virtual uint64_t GetCompletedFenceValue(void) const = 0;
+
+        /// @brief
+        /// これまでにサブミットされたGPUの処理(描画を含む)が完了したときのフェンス値
+        /// 差し替えたテクスチャはこの値の完了を待ってから破棄する
+        virtual uint64_t GetSubmittedFenceValue(void) const = 0;
+
+        virtual ~ITextureUploadBackend() {}
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : io_uring asynchronous file read backend (Linux)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_IO_URING_FILE_BACKEND
+#define M_IO_URING_FILE_BACKEND
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IAsyncFileBackend.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// io_uringで読み込むバックエンド(liburingは使わずシステムコールを直接呼ぶ)
+    /// 一回のio_uring_enterで積んだ読み込みをまとめて発行し、完了もまとめて受け取る
+    /// Linux以外、またはカーネルが対応していない場合はInitが失敗する
+    class IoUringFileBackend final : public IAsyncFileBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(IoUringFileBackend)
+
+      public:
+        /// @brief
+        /// @param queueDepth 同時に発行できる読み込みの数
+        bool Init(uint32_t queueDepth);
+
+      public:
+        const char* GetName(void) const override;
+        uint32_t GetQueueDepth(void) const override;
+        bool Submit(const AsyncFileOperation& operation) override;
+        void Flush(void) override;
+        size_t WaitCompletions(AsyncFileCompletion* outCompletions, size_t maxCount) override;
+        void Wake(void) override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        bool armWakePoll(void);
+
+      private:
+        int m_ringDescriptor;
+        int m_wakeDescriptor;             // eventfd(POLL_ADDで監視してWaitCompletionsを起こす)
+        uint32_t m_queueDepth;
+        uint32_t m_pendingSubmitCount;
+
+        // 共有リング(カーネルとmmapで共有する)
+        void* m_submitRing;
+        size_t m_submitRingSize;
+        void* m_completeRing;
+        size_t m_completeRingSize;
+        void* m_submitEntries;
+        size_t m_submitEntriesSize;
+
+        uint32_t* m_submitHead;
+        uint32_t* m_submitTail;
+        uint32_t m_submitMask;
+        uint32_t m_submitEntryCount;
+        uint32_t* m_submitArray;
+        uint32_t* m_completeHead;
+        uint32_t* m_completeTail;
+        uint32_t m_completeMask;
+        void* m_completeEntries;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,273 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Lock-free insert-only hash table template class
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_LOCK_FREE_HASH_TABLE
+#define M_LOCK_FREE_HASH_TABLE
+
+#include <ClassBaseInc.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// 64bitキーの追加専用ハッシュテーブル(オープンアドレス法、線形探索)
+    /// 検索も追加もロックを取らない。値はテーブルが所有し、Disposeまで削除されない
+    /// 容量は初期化時に固定(2のべき乗に切り上げ)
+    template<typename Value_Type>
+    class LockFreeHashTable final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(LockFreeHashTable)
+
+      public:
+        /// @brief
+        /// 初期化する
+        /// @param capacity 最大要素数
+        bool Init(size_t capacity);
+
+        /// @brief
+        /// キーに対応する値を探す
+        /// @return 見つからなければnullptr
+        Value_Type* Find(uint64_t key) const;
+
+        /// @brief
+        /// 値を追加する。すでに同じキーがあればそちらを返し、渡した値は破棄する
+        /// @param outInserted 追加できたらtrue
+        /// @return テーブル内の値(満杯ならnullptr)
+        Value_Type* Insert(uint64_t key, std::unique_ptr<Value_Type> value, bool* outInserted = nullptr);
+
+        /// @brief
+        /// すべての値に対して関数を呼ぶ(並行して追加された値は含まれないことがある)
+        template<typename Func_Type>
+        void ForEach(Func_Type&& func) const;
+
+        size_t GetCount(void) const;
+        size_t GetCapacity(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Slot
+        {
+          std::atomic<uint64_t> Key;
+          std::atomic<Value_Type*> Value;
+        };
+
+      private:
+        // 0は空きスロットを表すため使わない
+        static uint64_t normalizeKey(uint64_t key);
+        static Value_Type* waitForValue(const Slot& slot);
+
+      private:
+        std::unique_ptr<Slot[]> m_slots;
+        size_t m_mask;
+        std::atomic<size_t> m_count;
+    };
+
+    template<typename Value_Type>
+    LockFreeHashTable<Value_Type>::LockFreeHashTable()
+      : m_slots(nullptr)
+      , m_mask(0)
+      , m_count(0)
+    { }
+
+    template<typename Value_Type>
+    LockFreeHashTable<Value_Type>::~LockFreeHashTable()
+    {
+      Dispose();
+    }
+
+    template<typename Value_Type>
+    bool LockFreeHashTable<Value_Type>::Init(size_t capacity)
+    {
+      if (capacity == 0 || m_slots != nullptr)
+      {
+        return false;
+      }
+
+      // 探索が長くならないよう、実際のスロット数は要素数の2倍以上にする
+      size_t slotCount = 1;
+      while (slotCount < capacity * 2)
+      {
+        slotCount <<= 1;
+      }
+
+      m_slots = std::make_unique<Slot[]>(slotCount);
+      for (size_t i = 0; i < slotCount; ++i)
+      {
+        m_slots[i].Key.store(0, std::memory_order_relaxed);
+        m_slots[i].Value.store(nullptr, std::memory_order_relaxed);
+      }
+
+      m_mask = slotCount - 1;
+      m_count.store(0, std::memory_order_relaxed);
+
+      return true;
+    }
+
+    template<typename Value_Type>
+    Value_Type* LockFreeHashTable<Value_Type>::Find(uint64_t key) const
+    {
+      if (m_slots == nullptr)
+      {
+        return nullptr;
+      }
+
+      key = normalizeKey(key);
+
+      for (size_t probe = 0, index = static_cast<size_t>(key) & m_mask; probe <= m_mask; ++probe, index = (index + 1) & m_mask)
+      {
+        const uint64_t slotKey = m_slots[index].Key.load(std::memory_order_acquire);
+        if (slotKey == key)
+        {
+          // 追加中で値がまだ公開されていなければnullptrになる
+          return m_slots[index].Value.load(std::memory_order_acquire);
+        }
+
+        if (slotKey == 0)
+        {
+          return nullptr;
+        }
+      }
+
+      return nullptr;
+    }
+
+    template<typename Value_Type>
+    Value_Type* LockFreeHashTable<Value_Type>::Insert(uint64_t key, std::unique_ptr<Value_Type> value, bool* outInserted)
+    {
+      if (outInserted != nullptr)
+      {
+        *outInserted = false;
+      }
+
+      if (m_slots == nullptr || value == nullptr)
+      {
+        return nullptr;
+      }
+
+      key = normalizeKey(key);
+
+      for (size_t probe = 0, index = static_cast<size_t>(key) & m_mask; probe <= m_mask; ++probe, index = (index + 1) & m_mask)
+      {
+        Slot& slot = m_slots[index];
+        uint64_t slotKey = slot.Key.load(std::memory_order_acquire);
+
+        if (slotKey == 0)
+        {
+          // 空きスロットを確保する(失敗したら他スレッドが入れたキーを確認する)
+          if (slot.Key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel, std::memory_order_acquire))
+          {
+            Value_Type* inserted = value.release();
+            slot.Value.store(inserted, std::memory_order_release);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+
+            if (outInserted != nullptr)
+            {
+              *outInserted = true;
+            }
+            return inserted;
+          }
+        }
+
+        if (slotKey == key)
+        {
+          return waitForValue(slot);
+        }
+      }
+
+      // 満杯
+      return nullptr;
+    }
+
+    template<typename Value_Type>
+    template<typename Func_Type>
+    void LockFreeHashTable<Value_Type>::ForEach(Func_Type&& func) const
+    {
+      if (m_slots == nullptr)
+      {
+        return;
+      }
+
+      for (size_t i = 0; i <= m_mask; ++i)
+      {
+        Value_Type* value = m_slots[i].Value.load(std::memory_order_acquire);
+        if (value != nullptr)
+        {
+          func(m_slots[i].Key.load(std::memory_order_relaxed), *value);
+        }
+      }
+    }
+
+    template<typename Value_Type>
+    size_t LockFreeHashTable<Value_Type>::GetCount() const
+    {
+      return m_count.load(std::memory_order_relaxed);
+    }
+
+    template<typename Value_Type>
+    size_t LockFreeHashTable<Value_Type>::GetCapacity() const
+    {
+      return (m_slots != nullptr) ? ((m_mask + 1) / 2) : 0;
+    }
+
+    template<typename Value_Type>
+    void LockFreeHashTable<Value_Type>::Dispose() noexcept
+    {
+      // 他のスレッドが使っていないときに呼ぶこと
+      if (m_slots != nullptr)
+      {
+        for (size_t i = 0; i <= m_mask; ++i)
+        {
+          delete m_slots[i].Value.load(std::memory_order_relaxed);
+        }
+      }
+
+      m_slots.reset();
+      m_mask = 0;
+      m_count.store(0, std::memory_order_relaxed);
+    }
+
+    template<typename Value_Type>
+    uint64_t LockFreeHashTable<Value_Type>::normalizeKey(uint64_t key)
+    {
+      return (key != 0) ? key : 1;
+    }
+
+    template<typename Value_Type>
+    Value_Type* LockFreeHashTable<Value_Type>::waitForValue(const Slot& slot)
+    {
+      // キーの確保から値の公開までは数命令なので譲りながら待つ
+      Value_Type* value = slot.Value.load(std::memory_order_acquire);
+      while (value == nullptr)
+      {
+        std::this_thread::yield();
+        value = slot.Value.load(std::memory_order_acquire);
+      }
+
+      return value;
+    }
+  }
+}
+
+#endif
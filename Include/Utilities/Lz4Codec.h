@@ -0,0 +1,44 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : LZ4 block format codec
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_LZ4_CODEC
+#define M_LZ4_CODEC
+
+#include <Interfaces/ICompressionCodec.h>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// LZ4のブロック形式(フレームヘッダーなし)で圧縮・展開する
+    /// 圧縮はハッシュ表で直前の一致を探す貪欲法で、展開は速度を優先する
+    class Lz4Codec final : public ICompressionCodec
+    {
+      public:
+        static constexpr uint32_t CODEC_ID = 1;
+
+      public:
+        uint32_t GetId() const override;
+        size_t GetMaxCompressedSize(size_t srcSize) const override;
+        size_t Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const override;
+        bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) const override;
+    };
+  }
+}
+
+#endif
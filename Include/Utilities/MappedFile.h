@@ -0,0 +1,78 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Read-only memory-mapped file
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MAPPED_FILE
+#define M_MAPPED_FILE
+
+#include <ClassBaseInc.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// ファイルを読み取り専用でメモリにマップする(Windows / POSIX)
+    /// マップしている間はGetDataのポインターがそのまま使える
+    class MappedFile final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(MappedFile)
+
+      public:
+        /// @brief
+        /// ファイルをマップする(空のファイルは失敗扱い)
+        bool Open(const std::string& filePath);
+
+        const uint8_t* GetData(void) const;
+        size_t GetSize(void) const;
+        bool IsOpen(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        const uint8_t* m_data;
+        size_t m_size;
+        #ifdef _WIN32
+          void* m_fileHandle;
+          void* m_mappingHandle;
+        #else
+          int m_fileDescriptor;
+        #endif
+    };
+
+    inline const uint8_t* MappedFile::GetData() const
+    {
+      return m_data;
+    }
+
+    inline size_t MappedFile::GetSize() const
+    {
+      return m_size;
+    }
+
+    inline bool MappedFile::IsOpen() const
+    {
+      return m_data != nullptr;
+    }
+  }
+}
+
+#endif
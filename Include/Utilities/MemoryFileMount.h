@@ -0,0 +1,81 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by memory
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_MEMORY_FILE_MOUNT
+#define M_MEMORY_FILE_MOUNT
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IFileMount.h>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// メモリ上のデータをファイルとしてマウントする(埋め込みデータや生成したデータ、テスト用)
+    /// ファイルはマウントする前に追加する(マウント後に追加するとVirtualFileSystemのキャッシュと食い違う)
+    class MemoryFileMount final : public IFileMount, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(MemoryFileMount)
+
+      public:
+        /// @brief
+        /// 呼び出し側のメモリを参照するファイルを追加する(コピーしない)
+        /// @param data マウントを破棄するまで有効であること
+        /// @return 同じパスが既にあればfalse
+        bool Add(std::string_view path, const uint8_t* data, size_t size);
+
+        /// @brief
+        /// データの所有権を受け取ってファイルを追加する
+        bool Add(std::string_view path, std::vector<uint8_t>&& data);
+
+      public:
+        uint32_t Find(std::string_view normalizedPath, uint64_t pathHash) const override;
+        uint32_t GetCount(void) const override;
+        std::string_view GetPath(uint32_t index) const override;
+        uint64_t GetSize(uint32_t index) const override;
+        AssetView GetView(uint32_t index) const override;
+        bool Read(uint32_t index, uint8_t* dst, size_t dstSize) const override;
+        bool GetNativePath(uint32_t index, std::string& outPath) const override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct Entry
+        {
+          std::string Path;           // 正規化したパス
+          const uint8_t* Data;
+          size_t Size;
+        };
+
+      private:
+        std::vector<Entry> m_entries;
+        std::deque<std::vector<uint8_t>> m_ownedData;   // 要素を追加しても既存のデータは動かない
+        std::unordered_multimap<uint64_t, uint32_t> m_index;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Multithreaded LSD radix sort
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_RADIX_SORT
+#define M_RADIX_SORT
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+
+    /// @brief
+    /// 並べ替える要素(キーと値を一緒に動かすので16バイトに揃える)
+    struct RadixSortItem final
+    {
+      uint64_t Key;
+      uint32_t Value;
+      uint32_t Reserved;
+    };
+
+    /// @brief
+    /// 64ビットのキーと32ビットの値の組を下位の桁から8ビットずつ並べ替えるLSD基数ソート(安定)
+    /// すべてのキーで同じ値になる桁は飛ばすので、上位ビットが揃っているキーほど速い
+    /// 要素が多ければ配列をブロックに分け、ブロックごとの数え上げと書き出しをスレッドプールで並列に行う
+    class RadixSort final
+    {
+      public:
+        /// @brief
+        /// キーの昇順に並べ替える(同じキーは元の順番のまま)
+        /// @param items 並べ替える要素(結果もここに入る)
+        /// @param count 要素数
+        /// @param tempItems 作業領域(count個以上)
+        /// @param threadPool 並列に処理するスレッドプール(nullptrなら呼び出したスレッドだけで処理する)
+        static void Sort(RadixSortItem* items, size_t count, RadixSortItem* tempItems, ThreadPool* threadPool = nullptr);
+
+      private:
+        RadixSort() = delete;
+    };
+  }
+}
+
+#endif
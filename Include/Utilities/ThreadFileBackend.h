@@ -0,0 +1,74 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Thread based asynchronous file read backend
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_THREAD_FILE_BACKEND
+#define M_THREAD_FILE_BACKEND
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IAsyncFileBackend.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// ワーカースレッドで位置指定の同期読み込み(pread / ReadFile + OVERLAPPED)を行うバックエンド
+    /// io_uringが使えない環境(Windowsを含む)での代わり
+    class ThreadFileBackend final : public IAsyncFileBackend, public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ThreadFileBackend)
+
+      public:
+        /// @brief
+        /// @param threadCount 読み込みスレッドの数(同時に発行できる数もこれになる)
+        bool Init(uint32_t threadCount);
+
+      public:
+        const char* GetName(void) const override;
+        uint32_t GetQueueDepth(void) const override;
+        bool Submit(const AsyncFileOperation& operation) override;
+        void Flush(void) override;
+        size_t WaitCompletions(AsyncFileCompletion* outCompletions, size_t maxCount) override;
+        void Wake(void) override;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        void workerMain(void);
+
+      private:
+        std::vector<std::thread> m_threads;
+        std::deque<AsyncFileOperation> m_operations;
+        std::deque<AsyncFileCompletion> m_completions;
+        std::mutex m_mutex;
+        std::condition_variable m_operationCondition;
+        std::condition_variable m_completionCondition;
+        bool m_isWakeRequested;
+        bool m_isStopping;
+    };
+  }
+}
+
+#endif
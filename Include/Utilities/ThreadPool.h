@@ -0,0 +1,98 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Fixed size worker thread pool
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_THREAD_POOL
+#define M_THREAD_POOL
+
+#include <ClassBaseInc.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    /// @brief
+    /// 固定数のワーカースレッドでタスクを処理するスレッドプール
+    class ThreadPool final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(ThreadPool)
+
+      public:
+        ALIAS(std::function<void(void)>, Task);
+        ALIAS(std::function<void(size_t, size_t)>, RangeFunc);
+
+        static constexpr uint32_t INVALID_WORKER_INDEX = 0xffffffff;
+
+      public:
+        /// @brief
+        /// ワーカースレッドを起動する
+        /// @param threadCount スレッド数(0ならハードウェアスレッド数 - 1、最低1)
+        bool Init(uint32_t threadCount = 0);
+
+        /// @brief
+        /// タスクを追加する(スレッドセーフ)
+        void Submit(Task task);
+
+        /// @brief
+        /// [0, count)をチャンクに分けて並列に処理し、すべて終わるまで待つ
+        /// 呼び出したスレッドも処理に参加するため、ワーカーの中から呼んでもデッドロックしない
+        /// @param count 要素数
+        /// @param func [begin, end)を受け取る関数
+        /// @param minChunkSize 一つのチャンクの最小要素数
+        void ParallelFor(size_t count, const RangeFunc& func, size_t minChunkSize = 1);
+
+        /// @brief
+        /// 追加済みのタスクがすべて終わるまで待つ
+        void WaitIdle(void);
+
+        uint32_t GetThreadCount(void) const;
+
+        /// @brief
+        /// 呼び出したスレッドのワーカー番号を取得する(ワーカー以外はINVALID_WORKER_INDEX)
+        static uint32_t GetCurrentWorkerIndex(void);
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        void workerMain(uint32_t workerIndex);
+
+      private:
+        std::vector<std::thread> m_threads;
+        std::deque<Task> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_taskCondition;
+        std::condition_variable m_idleCondition;
+        size_t m_runningCount;
+        bool m_isStopping;
+    };
+
+    inline uint32_t ThreadPool::GetThreadCount() const
+    {
+      return static_cast<uint32_t>(m_threads.size());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system with prioritized mounts and path resolution cache
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_VIRTUAL_FILE_SYSTEM
+#define M_VIRTUAL_FILE_SYSTEM
+
+#include <ClassBaseInc.h>
+#include <Interfaces/IFileMount.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MFramework
+{
+  inline namespace Utility
+  {
+    class ThreadPool;
+
+    /// @brief
+    /// 解決したファイル(マウントを外すまで有効)
+    struct VirtualFile final
+    {
+      const IFileMount* Mount;
+      uint32_t Index;
+      uint64_t Size;
+
+      bool IsValid(void) const
+      {
+        return Mount != nullptr;
+      }
+    };
+
+    struct VirtualFileSystemStats final
+    {
+      uint64_t LookupCount;
+      uint64_t CacheHitCount;
+      uint64_t CacheEntryCount;
+    };
+
+    /// @brief
+    /// ディレクトリ、アーカイブ、メモリをマウントして一つのパス空間として扱う
+    /// 優先度の高いマウントから順に探し(同じ優先度なら後からマウントしたもの)、最初に見つかったファイルを使う
+    /// 解決結果は正規化したパス(AssetArchiveFormat::NormalizePath)のハッシュをキーにしてキャッシュし、見つからなかった結果も残す
+    /// 2回目以降の解決は文字列を作らずにハッシュテーブルを一回引くだけで、ファイルシステムには問い合わせない
+    /// マウントの追加と削除はキャッシュを捨てる。解決はスレッドセーフ
+    class VirtualFileSystem final : public IDisposable
+    {
+      GENERATE_CLASS_NO_COPY(VirtualFileSystem)
+
+      public:
+        static constexpr uint32_t INVALID_MOUNT_ID = 0;
+
+      public:
+        /// @brief
+        /// マウントする
+        /// @param mount マウントするファイルの集まり(所有権を受け取る)
+        /// @param priority 大きいほど先に探す
+        /// @param mountPoint このパスの下に見せる(空ならルート)
+        /// @return マウントID(失敗ならINVALID_MOUNT_ID)
+        uint32_t Mount(std::unique_ptr<IFileMount> mount, int32_t priority = 0, std::string_view mountPoint = {});
+
+        /// @brief
+        /// ディレクトリを走査してマウントする(走査はここで一度だけ行う)
+        uint32_t MountDirectory(const std::string& directoryPath, int32_t priority = 0, std::string_view mountPoint = {});
+
+        /// @brief
+        /// アーカイブを開いてマウントする
+        /// @param threadPool 圧縮したエントリーの展開に使う
+        uint32_t MountArchive(const std::string& archivePath, int32_t priority = 0, std::string_view mountPoint = {}, ThreadPool* threadPool = nullptr);
+
+        bool Unmount(uint32_t mountId);
+
+        /// @brief
+        /// パスを解決する(区切り文字と大文字小文字は区別しない)
+        /// @return 見つからなければ無効なファイル
+        VirtualFile Resolve(std::string_view path) const;
+
+        bool Exists(std::string_view path) const;
+
+        /// @brief
+        /// コピーせずに参照する(メモリと、アーカイブの圧縮していないエントリーだけ)
+        AssetView GetView(std::string_view path) const;
+
+        /// @brief
+        /// 内容を読み込む
+        bool ReadFile(std::string_view path, std::vector<uint8_t>& outData) const;
+
+        /// @brief
+        /// ディレクトリのマウントにあるファイルのOS上のパス(UTF-8)を取得する
+        bool GetNativePath(std::string_view path, std::string& outPath) const;
+
+        VirtualFileSystemStats GetStats(void) const;
+
+      public:
+        void Dispose(void) noexcept override;
+
+      private:
+        struct MountEntry
+        {
+          uint32_t Id;
+          int32_t Priority;
+          std::string MountPoint;                     // 正規化したパス(ルートなら空)
+          std::unique_ptr<IFileMount> FileMount;
+        };
+
+        struct CacheEntry
+        {
+          std::string Path;                           // 正規化したパス(ハッシュの衝突を見分ける)
+          const IFileMount* Mount;                    // 見つからなかった場合はnullptr
+          uint32_t Index;
+        };
+
+      private:
+        mutable std::shared_mutex m_mutex;
+        std::vector<MountEntry> m_mounts;             // 探す順
+        mutable std::unordered_map<uint64_t, CacheEntry> m_cache;
+        mutable std::atomic<uint64_t> m_lookupCount;
+        mutable std::atomic<uint64_t> m_cacheHitCount;
+        uint32_t m_nextMountId;
+    };
+  }
+}
+
+#endif
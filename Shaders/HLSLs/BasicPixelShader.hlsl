@@ -1,6 +1,9 @@
+//! shader BasicPS ps_5_1
+
 #include "BasicShaderHeader.hlsli"
 
 float4 BasicPS(Output input) : SV_TARGET
 {
-    return float4(tex.Sample(smp, input.uv));
+    // インスタンスごとにテクスチャが違ってよいので、インデックスは一様でないものとして扱う
+    return float4(textures[NonUniformResourceIndex(input.materialIndex)].Sample(smp, input.uv));
 }
\ No newline at end of file
@@ -3,17 +3,36 @@ struct Output
     float4 pos : POSITION;
     float4 svPos : SV_Position;
     float2 uv : TEXCOORD;
+    nointerpolation uint materialIndex : MATERIAL; // テクスチャのバインドレスインデックス
 };
 
 struct CMatrix
 {
-    matrix mat; // 変換行列
+    matrix mat; // ビュー・プロジェクション行列
 };
 
-Texture2D<float4> tex : register(t0);
+// InstanceBatcherが書き込むインスタンスごとのデータ(InstanceDataと同じ並び)
+struct InstanceData
+{
+    matrix world;       // ワールド行列
+    uint materialIndex; // マテリアルのテクスチャのバインドレスインデックス
+    uint3 reserved;
+};
+
+// ルート定数で渡すフレームごとの値
+struct FrameConstants
+{
+    uint viewProjectionIndex; // CMatrixの定数バッファーのバインドレスインデックス
+};
+
+// バインドレスヒープ全体(ルートシグネチャーのテーブルがヒープの先頭から重ねて見せている)
+Texture2D<float4> textures[] : register(t0, space1);
+ConstantBuffer<CMatrix> matrices[] : register(b0, space1);
 SamplerState smp : register(s0);
 // Shader Model 5.1以降
-ConstantBuffer<CMatrix> m : register(b0); // 定数バッファー
+ConstantBuffer<FrameConstants> frame : register(b0);
+// 描画のまとまりごとに先頭を差し替えるため、SV_InstanceIDで引く
+StructuredBuffer<InstanceData> instances : register(t0);
 
 //cbuffer cbuff0 : register(b0) // 定数バッファー
 //{
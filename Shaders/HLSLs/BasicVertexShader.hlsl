@@ -1,11 +1,17 @@
+//! shader BasicVS vs_5_1
+
 #include "BasicShaderHeader.hlsli"
 
-Output BasicVS(float4 pos : Position, float2 uv: TEXCOORD)
+Output BasicVS(float4 pos : Position, float2 uv: TEXCOORD, uint instanceID : SV_InstanceID)
 {
+    InstanceData instance = instances[instanceID];
+    CMatrix m = matrices[frame.viewProjectionIndex];
+
     Output o;
-    o.pos = pos;
-    o.svPos = mul(m.mat, pos);  // 列優先であるため、左方向にかけていきます
+    o.pos = mul(instance.world, pos);
+    o.svPos = mul(m.mat, o.pos);  // 列優先であるため、左方向にかけていきます
     o.uv = uv;
+    o.materialIndex = instance.materialIndex;
     
     return o;
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Bindless descriptor index allocator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/BindlessIndexAllocator.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  // 世代0は無効ハンドル用に予約
+  constexpr uint32_t FIRST_GENERATION = 1;
+}
+
+namespace MFramework
+{
+  BindlessIndexAllocator::BindlessIndexAllocator()
+    : m_generations()
+    , m_aliveFlags()
+    , m_freeIndices()
+    , m_retiredIndices()
+    , m_capacity(0)
+    , m_aliveCount(0)
+    , m_mutex()
+  { }
+
+  BindlessIndexAllocator::~BindlessIndexAllocator()
+  {
+    Dispose();
+  }
+
+  bool BindlessIndexAllocator::Init(uint32_t capacity)
+  {
+    if (capacity == 0 || capacity == BindlessHandle::INVALID_INDEX)
+    {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_capacity != 0)
+    {
+      return false;
+    }
+
+    m_capacity = capacity;
+    m_aliveCount = 0;
+    m_generations.assign(capacity, FIRST_GENERATION);
+    m_aliveFlags.assign(capacity, 0);
+
+    // 末尾から取り出すため逆順に積む(小さいインデックスから払い出される)
+    m_freeIndices.resize(capacity);
+    for (uint32_t i = 0; i < capacity; ++i)
+    {
+      m_freeIndices[i] = capacity - 1 - i;
+    }
+
+    m_retiredIndices.clear();
+
+    return true;
+  }
+
+  BindlessHandle BindlessIndexAllocator::Allocate()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_freeIndices.empty())
+    {
+      return BindlessHandle();
+    }
+
+    const uint32_t index = m_freeIndices.back();
+    m_freeIndices.pop_back();
+
+    m_aliveFlags[index] = 1;
+    ++m_aliveCount;
+
+    return BindlessHandle(index, m_generations[index]);
+  }
+
+  bool BindlessIndexAllocator::Free(BindlessHandle handle, uint64_t retireFenceValue)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!handle.IsValid() || handle.Index >= m_capacity)
+    {
+      return false;
+    }
+
+    // 二重解放または古いハンドルによる解放
+    if ((m_aliveFlags[handle.Index] == 0) || (m_generations[handle.Index] != handle.Generation))
+    {
+      assert(false && "BindlessIndexAllocator : stale handle freed");
+      return false;
+    }
+
+    // 世代を進めて古いハンドルを無効にする(0は飛ばす)
+    uint32_t nextGeneration = m_generations[handle.Index] + 1;
+    if (nextGeneration == 0)
+    {
+      nextGeneration = FIRST_GENERATION;
+    }
+    m_generations[handle.Index] = nextGeneration;
+    m_aliveFlags[handle.Index] = 0;
+    --m_aliveCount;
+
+    if (retireFenceValue == 0)
+    {
+      m_freeIndices.emplace_back(handle.Index);
+    }
+    else
+    {
+      m_retiredIndices.emplace_back(RetiredIndex{ handle.Index, retireFenceValue });
+    }
+
+    return true;
+  }
+
+  void BindlessIndexAllocator::ReleaseRetired(uint64_t completedFenceValue)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto retiredEnd = std::remove_if(
+                                      m_retiredIndices.begin(),
+                                      m_retiredIndices.end(),
+                                      [this, completedFenceValue](const RetiredIndex& retired)
+                                      {
+                                        if (retired.FenceValue > completedFenceValue)
+                                        {
+                                          return false;
+                                        }
+
+                                        m_freeIndices.emplace_back(retired.Index);
+                                        return true;
+                                      }
+                                    );
+
+    m_retiredIndices.erase(retiredEnd, m_retiredIndices.end());
+  }
+
+  bool BindlessIndexAllocator::IsAlive(BindlessHandle handle) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!handle.IsValid() || handle.Index >= m_capacity)
+    {
+      return false;
+    }
+
+    return (m_aliveFlags[handle.Index] != 0) && (m_generations[handle.Index] == handle.Generation);
+  }
+
+  void BindlessIndexAllocator::Dispose() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_generations.clear();
+    m_generations.shrink_to_fit();
+    m_aliveFlags.clear();
+    m_aliveFlags.shrink_to_fit();
+    m_freeIndices.clear();
+    m_freeIndices.shrink_to_fit();
+    m_retiredIndices.clear();
+    m_retiredIndices.shrink_to_fit();
+    m_capacity = 0;
+    m_aliveCount = 0;
+  }
+}
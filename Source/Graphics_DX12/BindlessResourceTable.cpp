@@ -0,0 +1,161 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Bindless resource table (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/BindlessResourceTable.h>
+
+#include <d3d12.h>
+
+#include <cassert>
+
+namespace MFramework
+{
+  BindlessResourceTable::BindlessResourceTable()
+    : m_heap()
+    , m_allocator()
+    , m_device(nullptr)
+  { }
+
+  BindlessResourceTable::~BindlessResourceTable()
+  {
+    Dispose();
+  }
+
+  bool BindlessResourceTable::Init(ID3D12Device* device, size_t numDesc)
+  {
+    if (device == nullptr || numDesc == 0)
+    {
+      return false;
+    }
+
+    if (m_device != nullptr)
+    {
+      return false;
+    }
+
+    m_heap.Init(device, D3D12DescHeapType::CBV_SRV_UAV, numDesc);
+    if (m_heap.Get() == nullptr)
+    {
+      return false;
+    }
+
+    if (!m_allocator.Init(static_cast<uint32_t>(numDesc)))
+    {
+      m_heap.Dispose();
+      return false;
+    }
+
+    m_device = device;
+    return true;
+  }
+
+  BindlessHandle BindlessResourceTable::Allocate()
+  {
+    if (m_device == nullptr)
+    {
+      return BindlessHandle();
+    }
+
+    return m_allocator.Allocate();
+  }
+
+  BindlessHandle BindlessResourceTable::CreateShaderResourceView(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC* desc)
+  {
+    BindlessHandle handle = Allocate();
+    if (!handle.IsValid())
+    {
+      return handle;
+    }
+
+    m_device->CreateShaderResourceView(resource, desc, m_heap.GetHandle(handle.Index).CPUHandle);
+    return handle;
+  }
+
+  BindlessHandle BindlessResourceTable::CreateConstantBufferView(const D3D12_CONSTANT_BUFFER_VIEW_DESC* desc)
+  {
+    if (desc == nullptr)
+    {
+      return BindlessHandle();
+    }
+
+    BindlessHandle handle = Allocate();
+    if (!handle.IsValid())
+    {
+      return handle;
+    }
+
+    m_device->CreateConstantBufferView(desc, m_heap.GetHandle(handle.Index).CPUHandle);
+    return handle;
+  }
+
+  BindlessHandle BindlessResourceTable::CreateUnorderedAccessView(ID3D12Resource* resource, ID3D12Resource* counter, const D3D12_UNORDERED_ACCESS_VIEW_DESC* desc)
+  {
+    BindlessHandle handle = Allocate();
+    if (!handle.IsValid())
+    {
+      return handle;
+    }
+
+    m_device->CreateUnorderedAccessView(resource, counter, desc, m_heap.GetHandle(handle.Index).CPUHandle);
+    return handle;
+  }
+
+  void BindlessResourceTable::Release(BindlessHandle handle, UINT64 retireFenceValue)
+  {
+    m_allocator.Free(handle, retireFenceValue);
+  }
+
+  void BindlessResourceTable::ReleaseRetired(UINT64 completedFenceValue)
+  {
+    m_allocator.ReleaseRetired(completedFenceValue);
+  }
+
+  DescriptorHandle BindlessResourceTable::GetHandle(BindlessHandle handle) const
+  {
+    // 解放済みのスロットを参照しようとしている
+    if (!m_allocator.IsAlive(handle))
+    {
+      assert(false && "BindlessResourceTable : use after free");
+      return DescriptorHandle();
+    }
+
+    return m_heap.GetHandle(handle.Index);
+  }
+
+  void BindlessResourceTable::Bind(ID3D12GraphicsCommandList* cmdList) const
+  {
+    if (cmdList == nullptr || m_heap.Get() == nullptr)
+    {
+      return;
+    }
+
+    ID3D12DescriptorHeap* pHeaps[] =
+    {
+      m_heap.Get(),
+    };
+    cmdList->SetDescriptorHeaps(_countof(pHeaps), pHeaps);
+  }
+
+  GPUDescHandle BindlessResourceTable::GetTableStart() const
+  {
+    return m_heap.GetHandle(0).GPUHandle;
+  }
+
+  void BindlessResourceTable::Dispose() noexcept
+  {
+    m_allocator.Dispose();
+    m_heap.Dispose();
+    m_device = nullptr;
+  }
+}
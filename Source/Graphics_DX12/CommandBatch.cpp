@@ -0,0 +1,80 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Ordered command list batch (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/CommandBatch.h>
+
+#include <algorithm>
+
+namespace MFramework
+{
+  CommandBatch::CommandBatch()
+    : m_entries()
+    , m_sequence(0)
+    , m_mutex()
+  { }
+
+  CommandBatch::~CommandBatch()
+  {
+    Clear();
+  }
+
+  void CommandBatch::Add(uint32_t order, CommandList* list)
+  {
+    if (list == nullptr)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_entries.emplace_back(Entry{ order, m_sequence++, list });
+  }
+
+  const std::vector<CommandBatch::Entry>& CommandBatch::Sort()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::sort(
+              m_entries.begin(),
+              m_entries.end(),
+              [](const Entry& lhs, const Entry& rhs)
+              {
+                if (lhs.Order != rhs.Order)
+                {
+                  return lhs.Order < rhs.Order;
+                }
+
+                return lhs.Sequence < rhs.Sequence;
+              }
+            );
+
+    return m_entries;
+  }
+
+  void CommandBatch::Clear()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_entries.clear();
+    m_sequence = 0;
+  }
+
+  size_t CommandBatch::GetCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_entries.size();
+  }
+}
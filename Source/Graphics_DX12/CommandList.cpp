@@ -8,6 +8,8 @@ Description : RenderFramework used by Game (Graphics API: DirectX12)
 Update History: 2024/09/19 Create
                 2024/09/26 Update constructor
                            Create virtual WndProc
+                2026/10/19 Add resource state tracking and batched barriers
+                2026/10/19 Flush barriers before draws, dispatches and copies
 
 Version : alpha_1.0.0
 
@@ -20,6 +22,7 @@ Encoding : UTF-8
 #include <d3d12.h>
 #pragma comment(lib,"d3d12.lib")
 
+#include <string>
 #include <cassert>
 
 // TODO
@@ -47,13 +50,15 @@ namespace MFramework
   CommandList::CommandList()
     : m_commandList(nullptr)
     , m_commandAllocators()
+    , m_stateTracker()
+    , m_flushBarriers()
   { }
 
   CommandList::~CommandList()
   {
     Dispose();
   }
-  void CommandList::Init(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, size_t frameCount)
+  void CommandList::Init(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, size_t frameCount, ResourceStateRegistry* stateRegistry)
   {
     if (m_commandList.Get() != nullptr)
     {
@@ -90,6 +95,11 @@ namespace MFramework
                                       );
 
     assert(SUCCEEDED(result));
+
+    m_stateTracker.Init(stateRegistry);
+    #ifdef _DEBUG
+      m_stateTracker.SetValidationMode(true);
+    #endif
   }
 
   void CommandList::Reset(int frameIndex, ID3D12PipelineState* pipelineState)
@@ -109,6 +119,151 @@ namespace MFramework
     }
 
     m_commandList->Reset(m_commandAllocators[frameIndex].Get(), pipelineState);
+    m_stateTracker.Reset();
+  }
+
+  void CommandList::Close()
+  {
+    if (m_commandList.Get() == nullptr)
+    {
+      return;
+    }
+
+    FlushBarriers();
+    m_commandList->Close();
+  }
+
+  void CommandList::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource)
+  {
+    m_stateTracker.Transition(resource, static_cast<ResourceStates>(after), subresource);
+  }
+
+  void CommandList::BeginSplitTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES after, UINT subresource)
+  {
+    m_stateTracker.BeginSplitTransition(resource, static_cast<ResourceStates>(after), subresource);
+  }
+
+  void CommandList::EndSplitTransition(ID3D12Resource* resource, UINT subresource)
+  {
+    m_stateTracker.EndSplitTransition(resource, subresource);
+  }
+
+  void CommandList::FlushBarriers()
+  {
+    if (!m_stateTracker.HasQueuedBarriers())
+    {
+      return;
+    }
+
+    m_flushBarriers.clear();
+    m_stateTracker.FlushBarriers(m_flushBarriers);
+    RecordBarriers(m_commandList.Get(), m_flushBarriers);
+  }
+
+  void CommandList::DrawInstanced(UINT vertexCountPerInstance, UINT instanceCount, UINT startVertexLocation, UINT startInstanceLocation)
+  {
+    FlushBarriers();
+    m_commandList->DrawInstanced(vertexCountPerInstance, instanceCount, startVertexLocation, startInstanceLocation);
+  }
+
+  void CommandList::DrawIndexedInstanced(UINT indexCountPerInstance, UINT instanceCount, UINT startIndexLocation, INT baseVertexLocation, UINT startInstanceLocation)
+  {
+    FlushBarriers();
+    m_commandList->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+  }
+
+  void CommandList::Dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ)
+  {
+    FlushBarriers();
+    m_commandList->Dispatch(threadGroupCountX, threadGroupCountY, threadGroupCountZ);
+  }
+
+  void CommandList::CopyResource(ID3D12Resource* dstResource, ID3D12Resource* srcResource)
+  {
+    FlushBarriers();
+    m_commandList->CopyResource(dstResource, srcResource);
+  }
+
+  void CommandList::CopyBufferRegion(ID3D12Resource* dstBuffer, UINT64 dstOffset, ID3D12Resource* srcBuffer, UINT64 srcOffset, UINT64 numBytes)
+  {
+    FlushBarriers();
+    m_commandList->CopyBufferRegion(dstBuffer, dstOffset, srcBuffer, srcOffset, numBytes);
+  }
+
+  void CommandList::CopyTextureRegion(const D3D12_TEXTURE_COPY_LOCATION* dst, UINT dstX, UINT dstY, UINT dstZ, const D3D12_TEXTURE_COPY_LOCATION* src, const D3D12_BOX* srcBox)
+  {
+    FlushBarriers();
+    m_commandList->CopyTextureRegion(dst, dstX, dstY, dstZ, src, srcBox);
+  }
+
+  void CommandList::ClearRenderTargetView(D3D12_CPU_DESCRIPTOR_HANDLE renderTargetView, const FLOAT colorRGBA[4], UINT numRects, const D3D12_RECT* rects)
+  {
+    FlushBarriers();
+    m_commandList->ClearRenderTargetView(renderTargetView, colorRGBA, numRects, rects);
+  }
+
+  void CommandList::ClearDepthStencilView(D3D12_CPU_DESCRIPTOR_HANDLE depthStencilView, D3D12_CLEAR_FLAGS clearFlags, FLOAT depth, UINT8 stencil, UINT numRects, const D3D12_RECT* rects)
+  {
+    FlushBarriers();
+    m_commandList->ClearDepthStencilView(depthStencilView, clearFlags, depth, stencil, numRects, rects);
+  }
+
+  size_t CommandList::ResolvePendingStates(std::vector<ResourceTransition>& outBarriers)
+  {
+    const size_t count = m_stateTracker.ResolvePendingStates(outBarriers);
+
+    #ifdef _DEBUG
+      for (const std::string& error : m_stateTracker.GetValidationErrors())
+      {
+        ::OutputDebugStringA(("*****ERROR***** " + error + "\n").c_str());
+      }
+    #endif
+
+    return count;
+  }
+
+  void CommandList::RecordBarriers(ID3D12GraphicsCommandList* commandList, const std::vector<ResourceTransition>& transitions)
+  {
+    if (commandList == nullptr || transitions.empty())
+    {
+      return;
+    }
+
+    std::vector<D3D12_RESOURCE_BARRIER> barriers(transitions.size());
+
+    for (size_t i = 0; i < transitions.size(); ++i)
+    {
+      const ResourceTransition& transition = transitions[i];
+      D3D12_RESOURCE_BARRIER& barrierDesc = barriers[i];
+
+      barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+      switch (transition.Split)
+      {
+        case BarrierSplit::BeginOnly:
+        {
+          barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_BEGIN_ONLY;
+        }
+        break;
+        case BarrierSplit::EndOnly:
+        {
+          barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_END_ONLY;
+        }
+        break;
+        case BarrierSplit::None:
+        default:
+        {
+          barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        }
+        break;
+      }
+      barrierDesc.Transition.pResource = transition.Resource;
+      barrierDesc.Transition.Subresource = transition.Subresource;
+      barrierDesc.Transition.StateBefore = static_cast<D3D12_RESOURCE_STATES>(transition.Before);
+      barrierDesc.Transition.StateAfter = static_cast<D3D12_RESOURCE_STATES>(transition.After);
+    }
+
+    // 全バリアを一回で発行する
+    commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
   }
 
   void CommandList::Dispose() noexcept
@@ -122,6 +277,10 @@ namespace MFramework
 
     m_commandAllocators.clear();
     m_commandAllocators.shrink_to_fit();
+
+    m_stateTracker.Dispose();
+    m_flushBarriers.clear();
+    m_flushBarriers.shrink_to_fit();
   }
 
     
@@ -0,0 +1,117 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Command list pool for parallel recording (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Share retire and reuse logic through FencedPool
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/CommandListPool.h>
+
+#include <d3d12.h>
+
+#include <memory>
+
+namespace
+{
+  // プール内のリストはそれぞれ専用のアロケーターを一つだけ持つ
+  constexpr size_t ALLOCATOR_COUNT_PER_LIST = 1;
+  constexpr int ALLOCATOR_INDEX = 0;
+}
+
+namespace MFramework
+{
+  CommandListPool::CommandListPool()
+    : m_device(nullptr)
+    , m_type(0)
+    , m_stateRegistry(nullptr)
+    , m_lists()
+  { }
+
+  CommandListPool::~CommandListPool()
+  {
+    Dispose();
+  }
+
+  bool CommandListPool::Init(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, ResourceStateRegistry* stateRegistry)
+  {
+    if (device == nullptr || m_device != nullptr)
+    {
+      return false;
+    }
+
+    m_device = device;
+    m_type = static_cast<UINT>(type);
+    m_stateRegistry = stateRegistry;
+
+    return true;
+  }
+
+  void CommandListPool::BeginFrame(UINT64 completedFenceValue)
+  {
+    m_lists.BeginFrame(completedFenceValue);
+  }
+
+  CommandList* CommandListPool::Acquire(ID3D12PipelineState* pipelineState)
+  {
+    if (m_device == nullptr)
+    {
+      return nullptr;
+    }
+
+    CommandList* list = m_lists.Acquire(
+                                          [this]()
+                                          {
+                                            std::unique_ptr<CommandList> newList = std::make_unique<CommandList>();
+                                            newList->Init(m_device, static_cast<D3D12_COMMAND_LIST_TYPE>(m_type), ALLOCATOR_COUNT_PER_LIST, m_stateRegistry);
+                                            if (newList->Get() == nullptr)
+                                            {
+                                              return std::unique_ptr<CommandList>();
+                                            }
+
+                                            // 作成直後は記録状態なので、Resetできるように一度閉じる
+                                            newList->Close();
+                                            return newList;
+                                          }
+                                        );
+    if (list == nullptr)
+    {
+      return nullptr;
+    }
+
+    // アロケーターのResetはロックの外で行う(このリストは呼び出したスレッドだけが使う)
+    list->Reset(ALLOCATOR_INDEX, pipelineState);
+
+    return list;
+  }
+
+  void CommandListPool::EndFrame(UINT64 signaledFenceValue)
+  {
+    m_lists.EndFrame(signaledFenceValue);
+  }
+
+  size_t CommandListPool::GetCreatedCount() const
+  {
+    return m_lists.GetCreatedCount();
+  }
+
+  size_t CommandListPool::GetAvailableCount() const
+  {
+    return m_lists.GetAvailableCount();
+  }
+
+  void CommandListPool::Dispose() noexcept
+  {
+    m_lists.Dispose();
+    m_device = nullptr;
+    m_stateRegistry = nullptr;
+  }
+}
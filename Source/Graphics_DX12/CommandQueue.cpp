@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : DirectX12 CommandQueue Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/06 Create
+                2026/10/19 Add ordered batch submission
+                2026/10/19 Always resolve pending states on batch submission
            
 Version : alpha_1.0.0
 
@@ -13,6 +15,9 @@ Encoding : UTF-8
 
 */
 #include <Graphics_DX12/CommandQueue.h>
+#include <Graphics_DX12/CommandBatch.h>
+#include <Graphics_DX12/CommandList.h>
+#include <Graphics_DX12/CommandListPool.h>
 
 #include <d3d12.h>
 #pragma comment(lib,"d3d12.lib")
@@ -23,6 +28,8 @@ namespace MFramework
 {
   CommandQueue::CommandQueue()
     : m_commandQueue(nullptr)
+    , m_submitLists()
+    , m_pendingBarriers()
   { }
   
   CommandQueue::~CommandQueue()
@@ -68,8 +75,53 @@ namespace MFramework
     m_commandQueue->ExecuteCommandLists(numCommandList, commandLists);
   }
 
+  size_t CommandQueue::Execute(CommandBatch& batch, CommandListPool& barrierPool)
+  {
+    if (m_commandQueue.Get() == nullptr)
+    {
+      return 0;
+    }
+
+    const std::vector<CommandBatch::Entry>& entries = batch.Sort();
+
+    m_submitLists.clear();
+    m_submitLists.reserve(entries.size() * 2);
+
+    for (const CommandBatch::Entry& entry : entries)
+    {
+      // 保留状態は必ずサブミット順に解決する(前のリストの終了状態が次のリストの開始状態になる)
+      // 解決を飛ばすとレジストリの状態が実際とずれるので、バリアが要らなくても毎回解決する
+      m_pendingBarriers.clear();
+      if (entry.List->ResolvePendingStates(m_pendingBarriers) > 0)
+      {
+        CommandList* barrierList = barrierPool.Acquire();
+        assert(barrierList != nullptr && "CommandQueue : failed to acquire a barrier list");
+        if (barrierList != nullptr)
+        {
+          CommandList::RecordBarriers(barrierList->Get(), m_pendingBarriers);
+          barrierList->Close();
+          m_submitLists.emplace_back(barrierList->Get());
+        }
+      }
+
+      m_submitLists.emplace_back(entry.List->Get());
+    }
+
+    const size_t submitCount = m_submitLists.size();
+    if (submitCount > 0)
+    {
+      m_commandQueue->ExecuteCommandLists(static_cast<UINT>(submitCount), m_submitLists.data());
+    }
+
+    batch.Clear();
+
+    return submitCount;
+  }
+
   void CommandQueue::Dispose() noexcept
   {
+    m_submitLists.clear();
+    m_pendingBarriers.clear();
     m_commandQueue.Reset();
   }
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : FXC shader compiler (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Keep opened include files on the heap
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/D3DShaderCompiler.h>
+
+#include <d3dcompiler.h>
+
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+
+namespace
+{
+  /// @brief
+  /// キャッシュキーを求めたときと同じ規則でインクルードファイルを探すハンドラー
+  class ShaderIncludeHandler final : public ID3DInclude
+  {
+    public:
+      ShaderIncludeHandler(const std::string& sourcePath, const std::vector<std::string>& includeDirs)
+        : m_includeDirs(includeDirs)
+        , m_rootDir(std::filesystem::path(sourcePath).parent_path().string())
+        , m_openedFiles()
+      { }
+
+      HRESULT __stdcall Open(D3D_INCLUDE_TYPE includeType, LPCSTR fileName, LPCVOID parentData, LPCVOID* outData, UINT* outBytes) override
+      {
+        // 親ファイルのディレクトリから相対的に探す
+        std::string currentDir = m_rootDir;
+        auto parentIt = m_openedFiles.find(parentData);
+        if (parentIt != m_openedFiles.end())
+        {
+          currentDir = parentIt->second->Directory;
+        }
+
+        std::string includePath;
+        const bool isSystem = (includeType == D3D_INCLUDE_SYSTEM);
+        if (!MFramework::ShaderPreprocessor::ResolveInclude(fileName, isSystem, currentDir, m_includeDirs, includePath))
+        {
+          return E_FAIL;
+        }
+
+        std::unique_ptr<OpenedFile> openedFile = std::make_unique<OpenedFile>();
+        if (!MFramework::ShaderPreprocessor::ReadFile(includePath, openedFile->Text))
+        {
+          return E_FAIL;
+        }
+        openedFile->Directory = std::filesystem::path(includePath).parent_path().string();
+
+        // 短い文字列は中身がオブジェクトの中にあってムーブで移動するので、ファイルごとヒープに置いてポインターを固定する
+        const void* data = openedFile->Text.data();
+        const UINT size = static_cast<UINT>(openedFile->Text.size());
+        m_openedFiles.emplace(data, std::move(openedFile));
+
+        *outData = data;
+        *outBytes = size;
+        return S_OK;
+      }
+
+      HRESULT __stdcall Close(LPCVOID data) override
+      {
+        m_openedFiles.erase(data);
+        return S_OK;
+      }
+
+    private:
+      struct OpenedFile
+      {
+        std::string Text;
+        std::string Directory;
+      };
+
+    private:
+      const std::vector<std::string>& m_includeDirs;
+      std::string m_rootDir;
+      std::unordered_map<const void*, std::unique_ptr<OpenedFile>> m_openedFiles;
+  };
+
+}
+
+namespace MFramework
+{
+  const char* D3DShaderCompiler::GetName() const
+  {
+    return "fxc";
+  }
+
+  bool D3DShaderCompiler::Compile(const ShaderCompileDesc& desc, const PreprocessedShader& preprocessed, std::vector<uint8_t>& outBytecode, std::string& outError) const
+  {
+    // 前処理結果はキーにだけ使い、行番号がずれないように元のファイルからコンパイルする
+    (void)preprocessed;
+
+    ComPtr<ID3DBlob> blob = nullptr;
+    ComPtr<ID3DBlob> error = nullptr;
+    HRESULT result = CompileToBlob(desc, blob.ReleaseAndGetAddressOf(), error.ReleaseAndGetAddressOf());
+    if (FAILED(result))
+    {
+      if (error.Get() != nullptr)
+      {
+        outError.assign(static_cast<const char*>(error->GetBufferPointer()), error->GetBufferSize());
+      }
+      else
+      {
+        outError = "D3DCompileFromFile failed";
+      }
+      return false;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(blob->GetBufferPointer());
+    outBytecode.assign(bytes, bytes + blob->GetBufferSize());
+    return true;
+  }
+
+  HRESULT D3DShaderCompiler::CompileToBlob(const ShaderCompileDesc& desc, ID3D10Blob** outBlob, ID3D10Blob** outError)
+  {
+    if (outBlob == nullptr)
+    {
+      return E_INVALIDARG;
+    }
+
+    // D3D_SHADER_MACROは終端にnullptrの組が必要
+    std::vector<D3D_SHADER_MACRO> macros;
+    macros.reserve(desc.Defines.size() + 1);
+    for (const ShaderDefine& define : desc.Defines)
+    {
+      macros.push_back({ define.Name.c_str(), define.Value.c_str() });
+    }
+    macros.push_back({ nullptr, nullptr });
+
+    ShaderIncludeHandler includeHandler(desc.SourcePath, desc.IncludeDirs);
+    const std::wstring sourcePath = std::filesystem::path(desc.SourcePath).wstring();
+
+    return D3DCompileFromFile(
+                                sourcePath.c_str(),           // シェーダーファイル名
+                                macros.data(),                // #defineの配列
+                                &includeHandler,              // #includeの解決
+                                desc.EntryPoint.c_str(),      // エントリーポイント
+                                desc.Target.c_str(),          // シェーダーモデルバージョン
+                                desc.Flags,                   // シェーダーコンパイルオプション
+                                0,                            // エフェクトコンパイルオプション（シェーダーファイルの場合０が推奨）
+                                outBlob,
+                                outError
+                              );
+  }
+}
@@ -0,0 +1,262 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DirectX12 instanced draw backend (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Sort draws through DrawPacketQueue
+                2026/10/19 Bindless materials
+                2026/10/19 Share root signatures by layout hash
+                2026/10/19 Encode root signature in sort keys
+                2026/10/19 Compare serialized layouts when sharing root signatures
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/DX12InstanceDrawBackend.h>
+#include <Graphics_DX12/CommandList.h>
+#include <Graphics_DX12/RootSignature.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  // まだ何も設定していないことを表すID
+  constexpr uint32_t INVALID_ID = ~0u;
+}
+
+namespace MFramework
+{
+  DX12InstanceDrawBackend::DX12InstanceDrawBackend()
+    : m_instanceBuffer(nullptr)
+    , m_instanceMemory(nullptr)
+    , m_instanceCapacity(0)
+    , m_instanceRootParameter(0)
+    , m_bindlessRootParameter(0)
+    , m_frameConstantsRootParameter(0)
+    , m_rootSignatures()
+    , m_pipelineStates()
+    , m_meshes()
+    , m_materials()
+    , m_packetQueue()
+    , m_threadPool(nullptr)
+    , m_recordingList(nullptr)
+    , m_bindlessTable()
+    , m_frameConstantBufferIndex(0)
+    , m_currentMesh(INVALID_ID)
+  { }
+
+  DX12InstanceDrawBackend::~DX12InstanceDrawBackend()
+  {
+    Dispose();
+  }
+
+  bool DX12InstanceDrawBackend::Init(ID3D12Device* device, uint64_t instanceCapacity, uint32_t instanceRootParameter, uint32_t bindlessRootParameter, uint32_t frameConstantsRootParameter, ThreadPool* threadPool)
+  {
+    if (device == nullptr || instanceCapacity == 0)
+    {
+      return false;
+    }
+
+    Dispose();
+
+    // アップロードヒープのバッファーを一つ作り、破棄するまでマップしたままにする
+    // (インスタンスデータは毎フレーム書き換えるので、デフォルトヒープへはコピーしない)
+    D3D12_HEAP_PROPERTIES uploadHeapProp = {};
+    uploadHeapProp.Type = D3D12_HEAP_TYPE_UPLOAD;
+    uploadHeapProp.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    uploadHeapProp.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    uploadHeapProp.CreationNodeMask = 0;
+    uploadHeapProp.VisibleNodeMask = 0;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.Width = instanceCapacity;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.SampleDesc.Quality = 0;
+
+    HRESULT result = device->CreateCommittedResource(
+                                                      &uploadHeapProp,
+                                                      D3D12_HEAP_FLAG_NONE,
+                                                      &bufferDesc,
+                                                      D3D12_RESOURCE_STATE_GENERIC_READ,
+                                                      nullptr,
+                                                      IID_PPV_ARGS(m_instanceBuffer.ReleaseAndGetAddressOf())
+                                                    );
+    if (FAILED(result))
+    {
+      return false;
+    }
+
+    // CPUからは書き込むだけなので読み取り範囲は空にする
+    D3D12_RANGE readRange = { 0, 0 };
+    result = m_instanceBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_instanceMemory));
+    if (FAILED(result))
+    {
+      m_instanceBuffer.Reset();
+      return false;
+    }
+
+    m_instanceCapacity = instanceCapacity;
+    m_instanceRootParameter = instanceRootParameter;
+    m_bindlessRootParameter = bindlessRootParameter;
+    m_frameConstantsRootParameter = frameConstantsRootParameter;
+    m_threadPool = threadPool;
+    return true;
+  }
+
+  uint32_t DX12InstanceDrawBackend::RegisterMesh(const D3D12_VERTEX_BUFFER_VIEW& vertexView, const D3D12_INDEX_BUFFER_VIEW& indexView, uint32_t indexCount)
+  {
+    m_meshes.emplace_back(Mesh{ vertexView, indexView, indexCount });
+    return static_cast<uint32_t>(m_meshes.size() - 1);
+  }
+
+  uint32_t DX12InstanceDrawBackend::RegisterPipelineState(const RootSignature& rootSignature, ID3D12PipelineState* pipelineState)
+  {
+    // ルートシグネチャーIDはソートキーに入るので、レイアウトが同じルートシグネチャーは同じIDにして切り替えを減らす
+    // ハッシュが同じでも正規形まで比べ、同じレイアウトのときだけまとめる(同じレイアウトのルートシグネチャーは入れ替えて使える)
+    const uint64_t hash = rootSignature.GetHash();
+    const std::vector<uint8_t>& serializedLayout = rootSignature.GetSerializedLayout();
+    const auto it = std::find_if(
+                                  m_rootSignatures.begin(),
+                                  m_rootSignatures.end(),
+                                  [hash, &serializedLayout](const RootSignatureEntry& entry)
+                                  {
+                                    return entry.Hash == hash && entry.SerializedLayout == serializedLayout;
+                                  }
+                                );
+    const uint32_t rootSignatureID = static_cast<uint32_t>(it - m_rootSignatures.begin());
+    if (it == m_rootSignatures.end())
+    {
+      m_rootSignatures.emplace_back(RootSignatureEntry{ hash, serializedLayout, rootSignature.Get() });
+    }
+    assert(rootSignatureID < (1u << DrawSortKey::ROOT_SIGNATURE_BITS) && "DX12InstanceDrawBackend : too many root signatures for the sort key");
+    assert(m_pipelineStates.size() < (1u << DrawSortKey::PIPELINE_STATE_BITS) && "DX12InstanceDrawBackend : too many pipeline states for the sort key");
+
+    m_pipelineStates.emplace_back(PipelineState{ rootSignatureID, pipelineState });
+    return static_cast<uint32_t>(m_pipelineStates.size() - 1);
+  }
+
+  uint32_t DX12InstanceDrawBackend::RegisterMaterial(uint32_t pipelineState, DrawBucket bucket)
+  {
+    assert(pipelineState < m_pipelineStates.size());
+    assert(m_materials.size() < (1u << DrawSortKey::MATERIAL_BITS) && "DX12InstanceDrawBackend : too many materials for the sort key");
+    m_materials.emplace_back(Material{ pipelineState, bucket });
+    return static_cast<uint32_t>(m_materials.size() - 1);
+  }
+
+  void DX12InstanceDrawBackend::BeginRecording(CommandList* cmdList, GPUDescHandle bindlessTable, uint32_t frameConstantBufferIndex)
+  {
+    m_recordingList = cmdList;
+    m_bindlessTable = bindlessTable;
+    m_frameConstantBufferIndex = frameConstantBufferIndex;
+    m_packetQueue.Clear();
+  }
+
+  void DX12InstanceDrawBackend::EndRecording()
+  {
+    if (m_recordingList != nullptr)
+    {
+      // リストが変わると設定は引き継がれないので、Translateは最初の描画で必ず全部設定する
+      m_packetQueue.Sort(m_threadPool);
+      m_packetQueue.Translate(*this);
+    }
+
+    m_packetQueue.Clear();
+    m_recordingList = nullptr;
+    m_currentMesh = INVALID_ID;
+  }
+
+  uint8_t* DX12InstanceDrawBackend::GetInstanceMemory() const
+  {
+    return m_instanceMemory;
+  }
+
+  uint64_t DX12InstanceDrawBackend::GetInstanceCapacity() const
+  {
+    return m_instanceCapacity;
+  }
+
+  void DX12InstanceDrawBackend::DrawInstanced(const InstanceDrawCommand& command)
+  {
+    if (m_recordingList == nullptr || command.Mesh >= m_meshes.size() || command.Material >= m_materials.size())
+    {
+      assert(false && "DX12InstanceDrawBackend : invalid draw command");
+      return;
+    }
+
+    // インスタンスデータはリングに書き込み済みなので、オフセットだけ覚えておけば後で記録できる
+    // 深度はまとまり全体で一つに決まらないので使わない
+    const Material& material = m_materials[command.Material];
+    const PipelineState& pipelineState = m_pipelineStates[material.PipelineState];
+    const uint64_t sortKey = DrawSortKey::Make(0, material.Bucket, pipelineState.RootSignature, material.PipelineState, command.Material, 0.0f);
+    m_packetQueue.Submit(sortKey, DrawPacket{ pipelineState.RootSignature, material.PipelineState, command.Material, command.Mesh, command.InstanceCount, 0, command.InstanceDataOffset });
+  }
+
+  void DX12InstanceDrawBackend::SetRootSignature(uint32_t rootSignature)
+  {
+    // ルートの引数は引き継がれないので、全描画で共通のものはここで設定し直す
+    ID3D12GraphicsCommandList* cmdList = m_recordingList->Get();
+    cmdList->SetGraphicsRootSignature(m_rootSignatures[rootSignature].RootSignature);
+    cmdList->SetGraphicsRootDescriptorTable(m_bindlessRootParameter, m_bindlessTable);
+    cmdList->SetGraphicsRoot32BitConstant(m_frameConstantsRootParameter, m_frameConstantBufferIndex, 0);
+  }
+
+  void DX12InstanceDrawBackend::SetPipelineState(uint32_t pipelineState)
+  {
+    m_recordingList->Get()->SetPipelineState(m_pipelineStates[pipelineState].State);
+  }
+
+  void DX12InstanceDrawBackend::SetMaterial(uint32_t)
+  {
+    // マテリアルのテクスチャはシェーダーがインスタンスデータのインデックスでヒープから引くので、設定するものはない
+  }
+
+  void DX12InstanceDrawBackend::SetMesh(uint32_t mesh)
+  {
+    ID3D12GraphicsCommandList* cmdList = m_recordingList->Get();
+    const Mesh& meshData = m_meshes[mesh];
+    cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    cmdList->IASetVertexBuffers(0, 1, &meshData.VertexView);
+    cmdList->IASetIndexBuffer(&meshData.IndexView);
+    m_currentMesh = mesh;
+  }
+
+  void DX12InstanceDrawBackend::Draw(uint32_t instanceCount, uint64_t instanceDataOffset)
+  {
+    // SV_InstanceIDはStartInstanceLocationを含まないので、まとまりの先頭をルートSRVで渡す
+    m_recordingList->Get()->SetGraphicsRootShaderResourceView(m_instanceRootParameter, m_instanceBuffer->GetGPUVirtualAddress() + instanceDataOffset);
+    m_recordingList->DrawIndexedInstanced(m_meshes[m_currentMesh].IndexCount, instanceCount, 0, 0, 0);
+  }
+
+  void DX12InstanceDrawBackend::Dispose() noexcept
+  {
+    if (m_instanceBuffer.Get() != nullptr && m_instanceMemory != nullptr)
+    {
+      m_instanceBuffer->Unmap(0, nullptr);
+    }
+    m_instanceBuffer.Reset();
+    m_instanceMemory = nullptr;
+    m_instanceCapacity = 0;
+    m_rootSignatures.clear();
+    m_pipelineStates.clear();
+    m_meshes.clear();
+    m_materials.clear();
+    m_packetQueue.Dispose();
+    m_threadPool = nullptr;
+    m_recordingList = nullptr;
+    m_currentMesh = INVALID_ID;
+  }
+}
@@ -0,0 +1,375 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture upload backend of texture streamer (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add texture to texture copy for mip streaming
+                2026/10/19 Pass the barrier pool to batch submission by reference
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/DX12TextureUploadBackend.h>
+#include <Graphics_DX12/CommandList.h>
+#include <Graphics_DX12/CommandListPool.h>
+#include <Graphics_DX12/CommandQueue.h>
+#include <Graphics_DX12/Fence.h>
+#include <Graphics_DX12/ResourceStateTracker.h>
+
+#include <d3d12.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace MFramework
+{
+  DX12TextureUploadBackend::DX12TextureUploadBackend()
+    : m_device(nullptr)
+    , m_cmdQueue(nullptr)
+    , m_cmdListPool(nullptr)
+    , m_fence(nullptr)
+    , m_stateRegistry(nullptr)
+    , m_stagingBuffer(nullptr)
+    , m_stagingMemory(nullptr)
+    , m_stagingCapacity(0)
+    , m_textures()
+    , m_recordingList(nullptr)
+    , m_copiedTextures()
+    , m_batch()
+  { }
+
+  DX12TextureUploadBackend::~DX12TextureUploadBackend()
+  {
+    Dispose();
+  }
+
+  bool DX12TextureUploadBackend::Init(ID3D12Device* device, CommandQueue* cmdQueue, CommandListPool* cmdListPool, Fence* fence, ResourceStateRegistry* stateRegistry, uint64_t stagingCapacity)
+  {
+    if (device == nullptr || cmdQueue == nullptr || cmdListPool == nullptr || fence == nullptr || stagingCapacity == 0)
+    {
+      return false;
+    }
+
+    // アップロードヒープのバッファーを一つ作り、破棄するまでマップしたままにする
+    D3D12_HEAP_PROPERTIES uploadHeapProp = {};
+    uploadHeapProp.Type = D3D12_HEAP_TYPE_UPLOAD;
+    uploadHeapProp.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    uploadHeapProp.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    uploadHeapProp.CreationNodeMask = 0;
+    uploadHeapProp.VisibleNodeMask = 0;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.Width = stagingCapacity;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    bufferDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.SampleDesc.Quality = 0;
+
+    HRESULT result = device->CreateCommittedResource(
+                                                      &uploadHeapProp,
+                                                      D3D12_HEAP_FLAG_NONE,
+                                                      &bufferDesc,
+                                                      D3D12_RESOURCE_STATE_GENERIC_READ,
+                                                      nullptr,
+                                                      IID_PPV_ARGS(m_stagingBuffer.ReleaseAndGetAddressOf())
+                                                    );
+    if (FAILED(result))
+    {
+      return false;
+    }
+
+    // CPUからは書き込むだけなので読み取り範囲は空にする
+    D3D12_RANGE readRange = { 0, 0 };
+    result = m_stagingBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_stagingMemory));
+    if (FAILED(result))
+    {
+      m_stagingBuffer.Reset();
+      return false;
+    }
+
+    m_device = device;
+    m_cmdQueue = cmdQueue;
+    m_cmdListPool = cmdListPool;
+    m_fence = fence;
+    m_stateRegistry = stateRegistry;
+    m_stagingCapacity = stagingCapacity;
+    return true;
+  }
+
+  ID3D12Resource* DX12TextureUploadBackend::GetResource(uint64_t texture) const
+  {
+    const auto it = m_textures.find(texture);
+    return (it != m_textures.end()) ? it->second.Get() : nullptr;
+  }
+
+  void DX12TextureUploadBackend::CreateShaderResourceView(uint64_t texture, CPUDescHandle handle) const
+  {
+    ID3D12Resource* resource = GetResource(texture);
+    if (resource == nullptr || m_device == nullptr)
+    {
+      return;
+    }
+
+    const D3D12_RESOURCE_DESC desc = resource->GetDesc();
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D)
+    {
+      srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE3D;
+      srvDesc.Texture3D.MipLevels = desc.MipLevels;
+    }
+    else if (desc.DepthOrArraySize > 1)
+    {
+      srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+      srvDesc.Texture2DArray.MipLevels = desc.MipLevels;
+      srvDesc.Texture2DArray.ArraySize = desc.DepthOrArraySize;
+    }
+    else
+    {
+      srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+      srvDesc.Texture2D.MipLevels = desc.MipLevels;
+    }
+
+    m_device->CreateShaderResourceView(resource, &srvDesc, handle);
+  }
+
+  uint8_t* DX12TextureUploadBackend::GetStagingMemory() const
+  {
+    return m_stagingMemory;
+  }
+
+  uint64_t DX12TextureUploadBackend::GetStagingCapacity() const
+  {
+    return m_stagingCapacity;
+  }
+
+  uint64_t DX12TextureUploadBackend::CreateTexture(const TextureDesc& desc)
+  {
+    if (m_device == nullptr)
+    {
+      return 0;
+    }
+
+    D3D12_HEAP_PROPERTIES texHeapProp = {};
+    texHeapProp.Type = D3D12_HEAP_TYPE_DEFAULT;
+    texHeapProp.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    texHeapProp.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    texHeapProp.CreationNodeMask = 0;
+    texHeapProp.VisibleNodeMask = 0;
+
+    D3D12_RESOURCE_DESC resDesc = {};
+    resDesc.Dimension = static_cast<D3D12_RESOURCE_DIMENSION>(desc.Dimension);
+    resDesc.Format = static_cast<DXGI_FORMAT>(desc.Format);
+    resDesc.Width = desc.Width;
+    resDesc.Height = desc.Height;
+    resDesc.DepthOrArraySize = static_cast<UINT16>(desc.DepthOrArraySize);
+    resDesc.MipLevels = static_cast<UINT16>(desc.MipLevels);
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    resDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.SampleDesc.Quality = 0;
+
+    ComPtr<ID3D12Resource> texture;
+    const HRESULT result = m_device->CreateCommittedResource(
+                                                              &texHeapProp,
+                                                              D3D12_HEAP_FLAG_NONE,
+                                                              &resDesc,
+                                                              D3D12_RESOURCE_STATE_COPY_DEST,
+                                                              nullptr,
+                                                              IID_PPV_ARGS(texture.ReleaseAndGetAddressOf())
+                                                            );
+    if (FAILED(result))
+    {
+      return 0;
+    }
+
+    if (m_stateRegistry != nullptr)
+    {
+      m_stateRegistry->Register(texture.Get(), TextureFootprint::GetSubresourceCount(desc), D3D12_RESOURCE_STATE_COPY_DEST);
+    }
+
+    const uint64_t id = reinterpret_cast<uint64_t>(texture.Get());
+    m_textures.emplace(id, std::move(texture));
+    return id;
+  }
+
+  void DX12TextureUploadBackend::DestroyTexture(uint64_t texture)
+  {
+    const auto it = m_textures.find(texture);
+    if (it == m_textures.end())
+    {
+      return;
+    }
+
+    if (m_stateRegistry != nullptr)
+    {
+      m_stateRegistry->Unregister(it->second.Get());
+    }
+
+    m_textures.erase(it);
+  }
+
+  void DX12TextureUploadBackend::CopyToTexture(uint64_t texture, uint32_t subresource, const SubresourceFootprint& footprint)
+  {
+    ID3D12Resource* resource = GetResource(texture);
+    if (resource == nullptr)
+    {
+      return;
+    }
+
+    if (!beginRecording())
+    {
+      return;
+    }
+
+    D3D12_TEXTURE_COPY_LOCATION src = {};
+    src.pResource = m_stagingBuffer.Get();
+    src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    src.PlacedFootprint.Offset = footprint.Offset;
+    src.PlacedFootprint.Footprint.Format = static_cast<DXGI_FORMAT>(footprint.Format);
+    src.PlacedFootprint.Footprint.Width = footprint.Width;
+    src.PlacedFootprint.Footprint.Height = footprint.Height;
+    src.PlacedFootprint.Footprint.Depth = footprint.Depth;
+    src.PlacedFootprint.Footprint.RowPitch = footprint.RowPitch;
+
+    D3D12_TEXTURE_COPY_LOCATION dst = {};
+    dst.pResource = resource;
+    dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dst.SubresourceIndex = subresource;
+
+    // 作成時の状態と同じなのでバリアは出ない
+    m_recordingList->Transition(resource, D3D12_RESOURCE_STATE_COPY_DEST, subresource);
+    m_recordingList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+    addCopiedTexture(resource);
+  }
+
+  void DX12TextureUploadBackend::CopyTextureSubresource(uint64_t dstTexture, uint32_t dstSubresource, uint64_t srcTexture, uint32_t srcSubresource)
+  {
+    ID3D12Resource* dstResource = GetResource(dstTexture);
+    ID3D12Resource* srcResource = GetResource(srcTexture);
+    if (dstResource == nullptr || srcResource == nullptr)
+    {
+      return;
+    }
+
+    if (!beginRecording())
+    {
+      return;
+    }
+
+    D3D12_TEXTURE_COPY_LOCATION src = {};
+    src.pResource = srcResource;
+    src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    src.SubresourceIndex = srcSubresource;
+
+    D3D12_TEXTURE_COPY_LOCATION dst = {};
+    dst.pResource = dstResource;
+    dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dst.SubresourceIndex = dstSubresource;
+
+    // コピー元は差し替えまで描画で使われるため、Submitでシェーダーリソースの状態に戻す
+    m_recordingList->Transition(srcResource, D3D12_RESOURCE_STATE_COPY_SOURCE, srcSubresource);
+    m_recordingList->Transition(dstResource, D3D12_RESOURCE_STATE_COPY_DEST, dstSubresource);
+    m_recordingList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+    addCopiedTexture(srcResource);
+    addCopiedTexture(dstResource);
+  }
+
+  uint64_t DX12TextureUploadBackend::Submit()
+  {
+    if (m_recordingList == nullptr)
+    {
+      return m_fence->GetLastSignaledValue();
+    }
+
+    // コピーに使ったテクスチャをまとめてシェーダーから読める状態にする(Closeで一回のバリアになる)
+    for (ID3D12Resource* resource : m_copiedTextures)
+    {
+      m_recordingList->Transition(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    }
+    m_recordingList->Close();
+
+    m_batch.Add(0, m_recordingList);
+    m_cmdQueue->Execute(m_batch, *m_cmdListPool);
+
+    m_recordingList = nullptr;
+    m_copiedTextures.clear();
+
+    return m_fence->Signal(m_cmdQueue->Get());
+  }
+
+  uint64_t DX12TextureUploadBackend::GetCompletedFenceValue() const
+  {
+    return (m_fence != nullptr) ? m_fence->GetCompletedValue() : 0;
+  }
+
+  uint64_t DX12TextureUploadBackend::GetSubmittedFenceValue() const
+  {
+    // 描画と同じフェンスを使っているため、最後にシグナルした値で全体の完了を表せる
+    return (m_fence != nullptr) ? m_fence->GetLastSignaledValue() : 0;
+  }
+
+  bool DX12TextureUploadBackend::beginRecording()
+  {
+    if (m_recordingList == nullptr)
+    {
+      m_recordingList = m_cmdListPool->Acquire();
+    }
+
+    return m_recordingList != nullptr;
+  }
+
+  void DX12TextureUploadBackend::addCopiedTexture(ID3D12Resource* resource)
+  {
+    if (std::find(m_copiedTextures.begin(), m_copiedTextures.end(), resource) == m_copiedTextures.end())
+    {
+      m_copiedTextures.emplace_back(resource);
+    }
+  }
+
+  void DX12TextureUploadBackend::Dispose() noexcept
+  {
+    // 記録途中のリストはプールに残したまま、次のフレームで退役させる
+    m_recordingList = nullptr;
+    m_copiedTextures.clear();
+    m_batch.Clear();
+
+    if (m_stateRegistry != nullptr)
+    {
+      for (auto& texture : m_textures)
+      {
+        m_stateRegistry->Unregister(texture.second.Get());
+      }
+    }
+    m_textures.clear();
+
+    if (m_stagingBuffer.Get() != nullptr && m_stagingMemory != nullptr)
+    {
+      m_stagingBuffer->Unmap(0, nullptr);
+    }
+    m_stagingBuffer.Reset();
+    m_stagingMemory = nullptr;
+    m_stagingCapacity = 0;
+
+    m_device = nullptr;
+    m_cmdQueue = nullptr;
+    m_cmdListPool = nullptr;
+    m_fence = nullptr;
+    m_stateRegistry = nullptr;
+  }
+}
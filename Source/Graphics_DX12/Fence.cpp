@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : D3D12 Fence Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/09/19 Create
+                2026/10/19 Add Signal and completed value query
 
 Version : alpha_1.0.0
 
@@ -64,9 +65,9 @@ namespace MFramework
           return;
       }
 
-      commandQueue->Signal(m_fence.Get(), ++m_fenceCount);
+      Signal(commandQueue);
 
-      if(m_fence->GetCompletedValue() != m_fenceCount)
+      if(m_fence->GetCompletedValue() < m_fenceCount)
       {
           m_fence->SetEventOnCompletion(m_fenceCount, m_event);
 
@@ -76,6 +77,32 @@ namespace MFramework
       }
     }
 
+    UINT64 Fence::Signal(ID3D12CommandQueue* commandQueue)
+    {
+      if (commandQueue == nullptr)
+      {
+        return 0;
+      }
+
+      if (!m_isInitialized)
+      {
+        return 0;
+      }
+
+      commandQueue->Signal(m_fence.Get(), ++m_fenceCount);
+      return m_fenceCount;
+    }
+
+    UINT64 Fence::GetCompletedValue() const
+    {
+      if (!m_isInitialized)
+      {
+        return 0;
+      }
+
+      return m_fence->GetCompletedValue();
+    }
+
     void Fence::Dispose() noexcept
     {
       if (m_event != nullptr)
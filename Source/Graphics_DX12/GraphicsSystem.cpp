@@ -23,6 +23,8 @@ Encoding : UTF-8
 
 #include <FileUtil.h> 
 #include <D3D12EasyUtil.h>
+#include <RenderSystem/VertexFormat.h>
+#include <filesystem>
 #include <string>
 #include <cassert>
 
@@ -37,7 +39,7 @@ static DirectX::XMMATRIX worldMatrix;
 static DirectX::XMMATRIX viewMatrix;
 static DirectX::XMFLOAT3 eye(0,0,-5), target(0,0,0), up(0,1,0);
 static DirectX::XMMATRIX projectionMatrix;
-static DirectX::XMMATRIX transformMatrix;
+static DirectX::XMMATRIX viewProjectionMatrix;
 
 namespace
 {
@@ -45,6 +47,32 @@ namespace
   constexpr D3D12_COMMAND_LIST_TYPE CMD_LIST_TYPE = D3D12_COMMAND_LIST_TYPE_DIRECT;
   constexpr D3D12_FILTER FILTER = D3D12_FILTER_MIN_MAG_MIP_LINEAR; // 線形補間
   const Color DEFAULT_SKYBOX_COLOR = Color::black; 
+  // バインドレスヒープに置けるディスクリプタ数(SRV/CBV/UAV共通)
+  constexpr size_t BINDLESS_DESCRIPTOR_COUNT = 4096;
+  // パイプラインステートのドライバーキャッシュの保存先
+  const std::string PIPELINE_CACHE_FILE_PATH = "PipelineCache.bin";
+  // コンパイル済みシェーダーの保存先
+  const std::string SHADER_CACHE_DIRECTORY = "ShaderCache";
+  const std::string SHADER_SOURCE_DIRECTORY = "Shaders/HLSLs";
+  // ShaderLibraryBuilderが書き出すパック済みシェーダー
+  const wchar_t* SHADER_LIBRARY_FILE_NAME = L"Shaders/ShaderLibrary.bin";
+  // テクスチャストリーミングのステージングリングと一フレームのアップロード量の上限
+  constexpr uint64_t TEXTURE_STAGING_SIZE = 32ull * 1024 * 1024;
+  constexpr uint64_t TEXTURE_UPLOAD_BYTES_PER_FRAME = 8ull * 1024 * 1024;
+  // 常駐ミップの予算(超えると使われていないテクスチャの細かいミップから追い出す)
+  constexpr uint64_t TEXTURE_RESIDENCY_BUDGET = 256ull * 1024 * 1024;
+  // 読み込みが終わるまで使う1x1のグレー(DXGI_FORMAT_R8G8B8A8_UNORM)
+  constexpr uint8_t PLACEHOLDER_TEXTURE_PIXEL[] = { 128, 128, 128, 255 };
+  // 画角(ミップの要求にも使う)
+  constexpr float CAMERA_FOV = DirectX::XM_PIDIV2;
+  // 板ポリゴンのワールド空間での大きさ
+  constexpr float QUAD_WORLD_SIZE = 2.0f;
+  // インスタンスデータのリング(80バイトのInstanceDataがフレームあたり約2万6千個、FRAME_COUNT分入る)
+  constexpr uint64_t INSTANCE_DATA_RING_SIZE = 4ull * 1024 * 1024;
+  // RootSignature::Initのルートパラメーターの並び
+  constexpr uint32_t BINDLESS_ROOT_PARAMETER = 0;
+  constexpr uint32_t INSTANCE_ROOT_PARAMETER = 1;
+  constexpr uint32_t FRAME_CONSTANTS_ROOT_PARAMETER = 2;
 
 }
 
@@ -53,21 +81,39 @@ namespace MFramework
   GraphicsSystem::GraphicsSystem()
     : m_dxgiFactory()
     , m_device()
+    , m_stateRegistry()
     , m_cmdList()
+    , m_cmdListPool()
+    , m_cmdBatch()
+    , m_renderGraph()
     , m_cmdQueue()
     , m_swapChain()
     , m_rtvHeap()
-    , m_texHeap()
+    , m_resourceTable()
     , m_renderTargets()
     , m_fence()
     , m_constBuffer()
     , m_vertBuffer()
     , m_idxBuffer()
+    , m_instanceDrawer()
+    , m_instanceBatcher()
+    , m_quadMesh(0)
+    , m_quadMaterial(0)
+    , m_shaderLibrary()
     , m_vertShader()
     , m_pixelShader()
+    , m_shaderCache()
+    , m_rootSigCache()
     , m_rootSig()
-    , m_pipelineState()
+    , m_psoCache()
+    , m_pipelineState(nullptr)
+    , m_threadPool()
+    , m_textureDecoder()
+    , m_textureUploader()
+    , m_textureStreamer()
     , m_texture() 
+    , m_textureSlot()
+    , m_constBufferSlot()
     , m_viewPort({})
     , m_scissorRect({})
     , m_clearColor(DEFAULT_SKYBOX_COLOR)
@@ -133,7 +179,8 @@ namespace MFramework
         // Maybe do something
       }
       #endif
-      m_cmdList.Init(m_device.Get(), CMD_LIST_TYPE, FRAME_COUNT);
+      m_cmdList.Init(m_device.Get(), CMD_LIST_TYPE, FRAME_COUNT, &m_stateRegistry);
+      m_cmdListPool.Init(m_device.Get(), CMD_LIST_TYPE, &m_stateRegistry);
       m_cmdQueue.Init(m_device.Get(), CMD_LIST_TYPE);
       m_swapChain.Init(m_dxgiFactory.Get(), m_cmdQueue.Get(), hWnd, FRAME_COUNT);
       m_rtvHeap.Init(m_device.Get(), D3D12DescHeapType::RTV, FRAME_COUNT);
@@ -143,19 +190,51 @@ namespace MFramework
       {
         auto handle = m_rtvHeap.GetHandle(i);
         m_renderTargets[i].Create(m_device.Get(), m_swapChain.Get(), i, &handle);
+        // バックバッファーはPRESENT状態から始まる
+        m_stateRegistry.Register(m_renderTargets[i].Get(), 1, D3D12_RESOURCE_STATE_PRESENT);
       }
 
       m_fence.Init(m_device.Get());
 
-      // TODO magic number
-      m_texHeap.Init(m_device.Get(), D3D12DescHeapType::CBV_SRV_UAV, 2);
-
-      assert(m_texture.Create( m_device.Get(),
-                              &m_cmdList,
-                              m_cmdQueue.Get(),
-                              m_texHeap.GetHandle(0),
-                              L"textest.png"
-                            ));
+      // SRV/CBV/UAVはすべて一つのバインドレスヒープに置く
+      m_resourceTable.Init(m_device.Get(), BINDLESS_DESCRIPTOR_COUNT);
+
+      // テクスチャはワーカーでデコードし、フレームごとにまとめてアップロードする
+      m_threadPool.Init();
+      m_textureUploader.Init(m_device.Get(), &m_cmdQueue, &m_cmdListPool, &m_fence, &m_stateRegistry, TEXTURE_STAGING_SIZE);
+
+      // PNGはミップを持たないため、読み込み時にsRGBとして線形空間で縮小したミップチェーンを作る
+      MipGenerateDesc mipDesc{};
+      mipDesc.Filter = MipFilter::Kaiser;
+      mipDesc.IsSRGB = true;
+      m_textureDecoder.EnableMipGeneration(mipDesc, &m_threadPool);
+
+      TextureStreamerDesc streamerDesc{};
+      streamerDesc.MaxUploadBytesPerUpdate = TEXTURE_UPLOAD_BYTES_PER_FRAME;
+      streamerDesc.ResidencyBudgetBytes = TEXTURE_RESIDENCY_BUDGET;
+      m_textureStreamer.Init(streamerDesc, &m_textureDecoder, &m_textureUploader, &m_threadPool);
+
+      TextureData placeholder{};
+      placeholder.Desc = { 1, 1, 1, 1, DXGI_FORMAT_R8G8B8A8_UNORM, D3D12_RESOURCE_DIMENSION_TEXTURE2D };
+      placeholder.Pixels.assign(std::begin(PLACEHOLDER_TEXTURE_PIXEL), std::end(PLACEHOLDER_TEXTURE_PIXEL));
+      placeholder.Subresources = { { 0, sizeof(PLACEHOLDER_TEXTURE_PIXEL), sizeof(PLACEHOLDER_TEXTURE_PIXEL) } };
+      const bool isPlaceholderCreated = m_textureStreamer.CreatePlaceholder(placeholder);
+      assert(isPlaceholderCreated);
+
+      // 読み込みが終わるまではプレースホルダーを参照し、常駐したら同じスロットのSRVを差し替える
+      // (PreProcessの時点で前のフレームはGPUが完了している)
+      m_textureSlot = m_resourceTable.Allocate();
+      m_textureUploader.CreateShaderResourceView(m_textureStreamer.GetPlaceholder(), m_resourceTable.GetHandle(m_textureSlot).CPUHandle);
+      m_textureStreamer.SetResidentCallback(
+                                              [this](StreamingTextureHandle handle, uint64_t texture)
+                                              {
+                                                if (handle.Index == m_texture.Index)
+                                                {
+                                                  m_textureUploader.CreateShaderResourceView(texture, m_resourceTable.GetHandle(m_textureSlot).CPUHandle);
+                                                }
+                                              }
+                                            );
+      m_texture = m_textureStreamer.Request("textest.png", 1.0f);
 
       // 定数バッファー作成
       worldMatrix = DirectX::XMMatrixRotationY(DirectX::XM_PIDIV4);
@@ -174,17 +253,19 @@ namespace MFramework
       // matrix.r[3].m128_f32[1] = 1.0f;
       viewMatrix = DirectX::XMMatrixLookAtLH(DirectX::XMLoadFloat3(&eye), DirectX::XMLoadFloat3(&target), DirectX::XMLoadFloat3(&up));
       projectionMatrix = DirectX::XMMatrixPerspectiveFovLH(
-                                                            DirectX::XM_PIDIV2,  // 画角が90° Pi/2
+                                                            CAMERA_FOV,          // 画角が90° Pi/2
                                                             wndAspect,           // アスペクト比
                                                             1.0f,                                 // 近接クリップ面
                                                             10.0f                                 // 遠方クリップ面  
                                                           );
       // 行優先のため変換行列は world * view * projection
-      transformMatrix = worldMatrix * viewMatrix * projectionMatrix;
+      // ワールド行列はインスタンスデータで渡すので、定数バッファーにはview * projectionだけを置く
+      viewProjectionMatrix = viewMatrix * projectionMatrix;
 
-      // TODO magic number;
-      MFramework::DescriptorHandle constHandle = m_texHeap.GetHandle(1);
-      m_constBuffer.Create(m_device.Get(), constHandle, 1, &transformMatrix);
+      // シェーダーはルート定数で渡したインデックスでヒープから引くので、スロットの位置は問わない
+      m_constBufferSlot = m_resourceTable.Allocate();
+      MFramework::DescriptorHandle constHandle = m_resourceTable.GetHandle(m_constBufferSlot);
+      m_constBuffer.Create(m_device.Get(), constHandle, 1, &viewProjectionMatrix);
 
       // TODO 
       {
@@ -214,33 +295,81 @@ namespace MFramework
       m_cmdList->IASetVertexBuffers(0, 1, &vertView);
 
       // TODO   
-      m_cmdList->Close();
+      m_cmdList.Close();
 
       // 頂点シェーダー作成    
-      if (!m_vertShader.InitFromCSO(L"BasicVertexShader.cso"))
+      // パック済みライブラリから取得し(ファイル検索は一回だけ)、なければキャッシュを通してコンパイルする
+      // (インクルードファイルが変わっていなければ再コンパイルしない)
+      std::wstring shaderLibraryPath;
+      if (Utility::FileUtility::SearchFilePath(SHADER_LIBRARY_FILE_NAME, shaderLibraryPath))
+      {
+        m_shaderLibrary.Open(std::filesystem::path(shaderLibraryPath).string());
+      }
+      m_shaderCache.Init(SHADER_CACHE_DIRECTORY);
+      if (!m_vertShader.InitFromLibrary(m_shaderLibrary, "BasicVertexShader", "BasicVS"))
       {
-        std::wstring vertShaderHLSLPath = L"Shaders/HLSLs/BasicVertexShader.hlsl";
-        if (!m_vertShader.InitFromFile(vertShaderHLSLPath.c_str(), "BasicVS", "vs_5_1"))
+        ShaderCompileDesc vertShaderDesc{};
+        vertShaderDesc.SourcePath = SHADER_SOURCE_DIRECTORY + "/BasicVertexShader.hlsl";
+        vertShaderDesc.EntryPoint = "BasicVS";
+        vertShaderDesc.Target = "vs_5_1";
+        vertShaderDesc.IncludeDirs = { SHADER_SOURCE_DIRECTORY };
+        vertShaderDesc.Flags = ShaderResBlob::GetDefaultCompileFlags();
+        if (!m_vertShader.InitFromFile(vertShaderDesc, &m_shaderCache))
         {
           // TODO
           assert(false);//bad design;
         }
       }
       // ピクセルシェーダー作成
-      if (!m_pixelShader.InitFromCSO(L"BasicPixelShader.cso"))
+      if (!m_pixelShader.InitFromLibrary(m_shaderLibrary, "BasicPixelShader", "BasicPS"))
       {
-        std::wstring pixelShaderHLSLPath = L"Shaders/HLSLs/BasicPixelShader.hlsl";
-        if (!m_pixelShader.InitFromFile(pixelShaderHLSLPath.c_str(), "BasicPS", "ps_5_1"))
+        ShaderCompileDesc pixelShaderDesc{};
+        pixelShaderDesc.SourcePath = SHADER_SOURCE_DIRECTORY + "/BasicPixelShader.hlsl";
+        pixelShaderDesc.EntryPoint = "BasicPS";
+        pixelShaderDesc.Target = "ps_5_1";
+        pixelShaderDesc.IncludeDirs = { SHADER_SOURCE_DIRECTORY };
+        pixelShaderDesc.Flags = ShaderResBlob::GetDefaultCompileFlags();
+        if (!m_pixelShader.InitFromFile(pixelShaderDesc, &m_shaderCache))
         {
           // TODO
           assert(false);//bad design;
         }
       }
 
-      // ルートシグネチャー作成
-      m_rootSig.Init(m_device.Get(), FILTER);
+      // ルートシグネチャー作成(キャッシュからレイアウトのハッシュで取得する)
+      m_rootSigCache.Init(m_device.Get());
+      [[maybe_unused]] const bool isRootSignatureCreated = m_rootSig.Init(m_rootSigCache, FILTER);
+      assert(isRootSignatureCreated);
        // パイプラインステート設定
-      m_pipelineState.Init(m_device.Get(), m_rootSig.Get(), &m_vertShader, &m_pixelShader, nullptr);
+      // パイプラインステートはキャッシュから取得する(前回のドライバーキャッシュがあれば再利用される)
+      m_psoCache.Init(m_device.Get(), PIPELINE_CACHE_FILE_PATH);
+
+      PipelineStateDesc psoDesc{};
+      psoDesc.RootSignature = m_rootSig.Get();
+      psoDesc.RootSignatureHash = m_rootSig.GetHash();
+      psoDesc.VS = ShaderBytecode::Create(m_vertShader.GetBufferPointer(), m_vertShader.GetBufferSize());
+      psoDesc.PS = ShaderBytecode::Create(m_pixelShader.GetBufferPointer(), m_pixelShader.GetBufferSize());
+
+      // 入力レイアウトは頂点の形の記述から作る
+      VertexLayout vertexLayout{};
+      std::string vertexLayoutError;
+      [[maybe_unused]] const bool isVertexLayoutCreated = VertexFormat::CreateLayout(VERTEX_FORMAT_POSITION_TEXCOORD, vertexLayout, vertexLayoutError);
+      assert(isVertexLayoutCreated && vertexLayout.Stride == sizeof(Vertex));
+      psoDesc.InputLayout = InputElement::CreateFromVertexLayout(vertexLayout);
+
+      // 起動時は完成するまで待つ
+      m_pipelineState = m_psoCache.GetOrCreate(psoDesc);
+      assert(m_pipelineState != nullptr);
+
+      // 板ポリゴンをメッシュ、パイプラインステートをマテリアルとして登録する
+      // (テクスチャはインスタンスデータのバインドレスインデックスで渡す)
+      [[maybe_unused]] const bool isInstanceDrawerCreated = m_instanceDrawer.Init(m_device.Get(), INSTANCE_DATA_RING_SIZE, INSTANCE_ROOT_PARAMETER, BINDLESS_ROOT_PARAMETER, FRAME_CONSTANTS_ROOT_PARAMETER, &m_threadPool);
+      assert(isInstanceDrawerCreated);
+      m_quadMesh = m_instanceDrawer.RegisterMesh(m_vertBuffer.GetView(), m_idxBuffer.GetView(), 6);
+      const uint32_t quadPipelineState = m_instanceDrawer.RegisterPipelineState(m_rootSig, m_pipelineState);
+      m_quadMaterial = m_instanceDrawer.RegisterMaterial(quadPipelineState);
+      [[maybe_unused]] const bool isInstanceBatcherCreated = m_instanceBatcher.Init(&m_instanceDrawer);
+      assert(isInstanceBatcherCreated);
 
       // ビューポートを作成
       m_viewPort.Width = wndWidthF;
@@ -267,24 +396,80 @@ namespace MFramework
     UINT backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
     // リセットし、命令オブジェクトをためていく
     // コマンドリストのクローズ状態を解除
-    m_cmdList.Reset(static_cast<int>(backBufferIndex), m_pipelineState.Get());
+    m_cmdList.Reset(static_cast<int>(backBufferIndex), m_pipelineState);
+
+    // GPUが完了したプールのリストとインスタンスデータの領域を再利用できるようにする
+    m_cmdListPool.BeginFrame(m_fence.GetCompletedValue());
+    m_instanceBatcher.BeginFrame(m_fence.GetCompletedValue());
+
+    // 画面上の大きさから必要なミップを要求する
+    const float cameraDistance = DirectX::XMVectorGetX(DirectX::XMVector3Length(DirectX::XMVectorSubtract(DirectX::XMLoadFloat3(&eye), DirectX::XMLoadFloat3(&target))));
+    m_textureStreamer.ReportScreenSize(m_texture, MipResidency::EstimateScreenSize(QUAD_WORLD_SIZE, cameraDistance, CAMERA_FOV, m_viewPort.Height));
+
+    // 完了したテクスチャを確定し、デコード済みのものとミップの入れ替えをまとめてアップロードする
+    m_textureStreamer.Update();
+
+    // フレームのパスを宣言し直す(構造が変わらなければコンパイル結果はキャッシュが使われる)
+    m_renderGraph.Reset();
+  }
+
+  void GraphicsSystem::Render()
+  {
+    // TODO
+    angle += 0.03f;
+    worldMatrix = DirectX::XMMatrixRotationY(angle);
+    m_constBuffer.Remap(1, &viewProjectionMatrix);
+
+    // 描画するオブジェクトを積む(同じメッシュとマテリアルのものはメインパスで一回の描画になる)
+    DirectX::XMFLOAT4X4 world;
+    DirectX::XMStoreFloat4x4(&world, worldMatrix);
+    m_instanceBatcher.Submit(m_quadMesh, m_quadMaterial, &world.m[0][0], m_textureSlot.Index);
+
+    // レンダーターゲットビューのインデックス取得
+    UINT backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+
+    // バックバッファーはPRESENTで受け取り、PRESENTで返す
+    RenderGraphResourceHandle backBuffer = m_renderGraph.ImportResource(
+                                                                        "BackBuffer",
+                                                                        m_renderTargets[backBufferIndex].Get(),
+                                                                        D3D12_RESOURCE_STATE_PRESENT,
+                                                                        D3D12_RESOURCE_STATE_PRESENT
+                                                                      );
+
+    RenderGraphPassHandle mainPass = m_renderGraph.AddPass(
+                                                            "MainPass",
+                                                            [this, backBufferIndex]()
+                                                            {
+                                                              renderMainPass(backBufferIndex);
+                                                            }
+                                                          );
+    m_renderGraph.Write(mainPass, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
 
+    if (!m_renderGraph.Compile())
     {
-      // リソースバリアを設定
-      D3D12_RESOURCE_BARRIER barrierDesc = {};
-
-      barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;                                // 遷移
-      barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;                                     // 特に指定なし
-      barrierDesc.Transition.pResource = m_renderTargets[backBufferIndex].Get();                  // バックバッファーリソース
-      barrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;             // サブリソース番号
-      barrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;                        // 直前はPRESENT状態
-      barrierDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;                   // 今からレンダーターゲット状態
-
-      // バリア指定実行
-      // 第一引数:設定バリアの数(現時点では1でよい)
-      // 第二引数:設定バリア構造体アドレス(配列で同時に設定できる)
-      m_cmdList->ResourceBarrier(1, &barrierDesc);
+      assert(false && "GraphicsSystem : render graph compile failed");
+      return;
     }
+
+    // グラフが決めた遷移はトラッカーに渡す(バックバッファーの最初の遷移はサブミット時に解決される)
+    m_renderGraph.Execute(
+                            [this](const RenderGraphBarrier& barrier)
+                            {
+                              // 一時リソースはまだ使っていないためエイリアシングバリアは来ない
+                              if (barrier.BarrierType == RenderGraphBarrier::Type::Transition)
+                              {
+                                m_cmdList.Transition(m_renderGraph.GetImportedResource(barrier.Resource), static_cast<D3D12_RESOURCE_STATES>(barrier.After));
+                              }
+                            },
+                            [this]()
+                            {
+                              m_cmdList.FlushBarriers();
+                            }
+                          );
+  }
+
+  void GraphicsSystem::renderMainPass(UINT backBufferIndex)
+  {
     // レンダーターゲットを指定
     auto rtvHandle = m_rtvHeap.GetHandle(backBufferIndex);
 
@@ -300,87 +485,42 @@ namespace MFramework
       
       // TODO
       float clearColor[] = {m_clearColor.r, m_clearColor.g, m_clearColor.b, m_clearColor.a};
-      m_cmdList->ClearRenderTargetView(rtvHandle.CPUHandle, clearColor, 0, nullptr);
+      m_cmdList.ClearRenderTargetView(rtvHandle.CPUHandle, clearColor, 0, nullptr);
     }
-  }
 
-  void GraphicsSystem::Render()
-  {
-    // TODO
-    angle += 0.03f;
-    worldMatrix = DirectX::XMMatrixRotationY(angle);
-    transformMatrix = worldMatrix * viewMatrix * projectionMatrix;
-
-    m_constBuffer.Remap(1, &transformMatrix);
-
-    ID3D12DescriptorHeap* pHeaps[] = 
-    {
-      m_texHeap.Get(),
-    };
-    // ルートシグネチャー設定
-    m_cmdList->SetGraphicsRootSignature(m_rootSig.Get());
-    m_cmdList->SetDescriptorHeaps(_countof(pHeaps), pHeaps);
+    // バインドレスヒープはフレームに一回だけセットする
+    m_resourceTable.Bind(m_cmdList.Get());
     m_cmdList->RSSetViewports(1, &m_viewPort);
     m_cmdList->RSSetScissorRects(1, &m_scissorRect);
 
-    // パイプラインステートを設定
-    m_cmdList->SetPipelineState(m_pipelineState.Get()); 
-
-    m_cmdList->SetGraphicsRootDescriptorTable(
-                                                0,           // ルートパラメーターインデックス 
-                                                m_texture.GetGPUHandle()   // ヒープアドレス
-                                              );
-  
-    // 頂点バッファーを設定
-    // 第一引数:スロット番号
-    // 第二引数:頂点バッファービューの数
-    // 第三引数:頂点バッファービューの配列
-    D3D12_VERTEX_BUFFER_VIEW vertView = m_vertBuffer.GetView();
-    D3D12_INDEX_BUFFER_VIEW idxView = m_idxBuffer.GetView();
-    m_cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_cmdList->IASetVertexBuffers(0, 1, &vertView);
-    m_cmdList->IASetIndexBuffer(&idxView);  
-    // 描画命令を設定
-    // 第一引数:頂点インデックス数
-    // 第二引数:インスタンス数
-    // 第三引数:頂点データのオフセット
-    // 第四引数:インスタンスのオフセット
-    // ※インスタンス数は同じプリミティブをいくつ表示するかという意味です
-    m_cmdList->DrawIndexedInstanced(6, 1, 0, 0, 0);
+    // ルートシグネチャー(とヒープ全体のテーブル、フレームの定数)、パイプラインステート、頂点とインデックスのバッファーはバックエンドが設定する
+    // まとまりごとにDrawIndexedInstancedを一回記録する(インスタンス数は同じメッシュをいくつ表示するか)
+    // 記録はEndRecordingでソートキーの順に並べてから行う
+    m_instanceDrawer.BeginRecording(&m_cmdList, m_resourceTable.GetTableStart(), m_constBufferSlot.Index);
+    m_instanceBatcher.Flush();
+    m_instanceDrawer.EndRecording();
   }
 
   void GraphicsSystem::PostProcess()
   {
-    // レンダーターゲットビューのインデックス取得
-    UINT backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
-    {
-      // リソースバリアを設定
-      D3D12_RESOURCE_BARRIER barrierDesc = {};
-
-      barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;                                // 遷移
-      barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;                                     // 特に指定なし
-      barrierDesc.Transition.pResource = m_renderTargets[backBufferIndex].Get();                  // バックバッファーリソース
-      barrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;             // サブリソース番号
-      barrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;    // 直前はレンダーターゲット状態
-      barrierDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;           // 今からPRESENT状態
-      // バリア指定実行
-      // 第一引数:設定バリアの数(現時点では1でよい)
-      // 第二引数:設定バリア構造体アドレス(配列で同時に設定できる)
-      m_cmdList->ResourceBarrier(1, &barrierDesc);
-    }
+    // バックバッファーのPRESENTへの遷移はレンダーグラフの最終バリアで記録済み
 
     // ためておいた命令を実行
-    // その前に命令をクローズが必須
-    m_cmdList->Close();
-    // 命令の実行
-    ID3D12CommandList* cmdLists[] = { m_cmdList.Get() };
-    // 第一引数:実行するコマンドリストの数(1でよい)
-    // 第二引数:コマンドリスト配列の先頭アドレス
-    m_cmdQueue.Execute(1, cmdLists);
+    // その前に命令をクローズが必須(溜めたバリアはここでまとめて発行される)
+    m_cmdList.Close();
+
+    // 保留状態の解決で必要になったバリアはプールのリストに記録され、本体の直前に挟まれる
+    // 複数スレッドで記録する場合もorderを指定してバッチに追加すれば一回でサブミットされる
+    m_cmdBatch.Add(0, &m_cmdList);
+    m_cmdQueue.Execute(m_cmdBatch, m_cmdListPool);
 
     // フェンスを使ってGPUの処理が終わるまで待つ
     m_fence.Wait(m_cmdQueue.Get());
 
+    // このフレームでプールから取得したリストと書き込んだインスタンスデータはシグナルしたフェンス値の完了後に再利用する
+    m_cmdListPool.EndFrame(m_fence.GetLastSignaledValue());
+    m_instanceBatcher.EndFrame(m_fence.GetLastSignaledValue());
+
     // フリップ
     // 第一引数:フリップまでの待ちフレーム数
     // ※0にするとPresentメソッドが即時復帰して次のフレームが始まってしまいます。
@@ -394,10 +534,12 @@ namespace MFramework
   {
     m_dxgiFactory.Dispose();
     m_cmdList.Dispose();
+    m_cmdBatch.Clear();
+    m_cmdListPool.Dispose();
+    m_renderGraph.Dispose();
     m_cmdQueue.Dispose();
     m_swapChain.Dispose();
     m_rtvHeap.Dispose();
-    m_texHeap.Dispose();
 
     for (size_t i = 0; i < m_renderTargets.size(); ++i)
     {
@@ -410,11 +552,25 @@ namespace MFramework
     m_constBuffer.Dispose();
     m_vertBuffer.Dispose();
     m_idxBuffer.Dispose();
+    m_instanceBatcher.Dispose();
+    m_instanceDrawer.Dispose();
     m_vertShader.Dispose();
     m_pixelShader.Dispose();
+    m_shaderCache.Dispose();
+    // バイトコードを参照するシェーダーより後に閉じる
+    m_shaderLibrary.Dispose();
     m_rootSig.Dispose();
-    m_pipelineState.Dispose();
-    m_texture.Dispose();
+    m_rootSigCache.Dispose();
+    // 次回起動時のためにドライバーのキャッシュを保存する
+    m_psoCache.SaveToFile();
+    m_psoCache.Dispose();
+    m_pipelineState = nullptr;
+    // デコード中のタスクを待ってからテクスチャを破棄する
+    m_textureStreamer.Dispose();
+    m_threadPool.Dispose();
+    m_textureUploader.Dispose();
+    m_resourceTable.Dispose();
+    m_stateRegistry.Dispose();
     m_device.Dispose();
     
     if (m_debugDevice.Get() != nullptr)
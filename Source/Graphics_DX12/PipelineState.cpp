@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : PipelineState Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/12 Create
+                2026/10/19 Build from PipelineStateDesc
+                2026/10/19 Generate input layout from vertex format
 
 Version : alpha_1.0.0
 
@@ -16,38 +18,49 @@ Encoding : UTF-8
 #include <Graphics_DX12/PipelineState.h>
 
 #include <Graphics_DX12/ShaderResBlob.h>
+#include <Graphics_DX12/PipelineStateDesc.h>
+#include <RenderSystem/VertexFormat.h>
 #include <d3d12.h>
 
 #include <cassert>
+#include <string>
+#include <vector>
 
 namespace
 {
   // 2D
-  // 頂点レイアウト作成
+  // 頂点レイアウト作成(座標float3 + uv float2)
   // 渡される頂点データなどをどのように解釈するかをGPUに教えてあげるため
-  constexpr D3D12_INPUT_ELEMENT_DESC INPUT_LAYOUT_2D[] = 
+  std::vector<MFramework::InputElement> CreateInputLayout2D()
   {
-    // 座標情報
-    {
-      "POSITION",                                 // セマンティクス名(今回は座標なのでPOSITION)
-      0,                                          // 同じセマンティクス名のときに使うインデックス(0でよい) ※要調べ
-      DXGI_FORMAT_R32G32B32_FLOAT,                // フォーマット(データの解釈(float3のため,rbg毎に32bit,float型))
-      0,                                          // 入力スロットインデックス(0でよい)IASetVertexBuffersでスロットとバッファーとを関連付けている
-      D3D12_APPEND_ALIGNED_ELEMENT,               // データが連続していることを表す定義としてALIGNED_ELEMENT
-      D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, // データの内容として、1頂点ごとにこのレイアウトが入っているを表す列挙※13.2.2で説明するらしい
-      0                                           // 一度に描画するインスタンスの数(インスタンシングを使わないため0でよい)※13.2.2で説明するらしい
-    },
-    // uv (追加)
+    MFramework::VertexLayout layout{};
+    std::string error;
+    [[maybe_unused]] const bool isCreated = MFramework::VertexFormat::CreateLayout(MFramework::VERTEX_FORMAT_POSITION_TEXCOORD, layout, error);
+    assert(isCreated);
+
+    return MFramework::InputElement::CreateFromVertexLayout(layout);
+  }
+
+  void ConvertBlendDesc(const D3D12_BLEND_DESC& src, MFramework::BlendState& dest)
+  {
+    dest.AlphaToCoverageEnable = (src.AlphaToCoverageEnable != FALSE);
+    dest.IndependentBlendEnable = (src.IndependentBlendEnable != FALSE);
+
+    for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
     {
-      "TEXCOORD",
-      0,
-      DXGI_FORMAT_R32G32_FLOAT,
-      0,
-      D3D12_APPEND_ALIGNED_ELEMENT,
-      D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-      0
-    },
-  };
+      const D3D12_RENDER_TARGET_BLEND_DESC& srcRT = src.RenderTarget[i];
+      MFramework::RenderTargetBlendState& destRT = dest.RenderTargets[i];
+
+      destRT.BlendEnable = (srcRT.BlendEnable != FALSE);
+      destRT.SrcBlend = static_cast<uint8_t>(srcRT.SrcBlend);
+      destRT.DestBlend = static_cast<uint8_t>(srcRT.DestBlend);
+      destRT.BlendOp = static_cast<uint8_t>(srcRT.BlendOp);
+      destRT.SrcBlendAlpha = static_cast<uint8_t>(srcRT.SrcBlendAlpha);
+      destRT.DestBlendAlpha = static_cast<uint8_t>(srcRT.DestBlendAlpha);
+      destRT.BlendOpAlpha = static_cast<uint8_t>(srcRT.BlendOpAlpha);
+      destRT.WriteMask = srcRT.RenderTargetWriteMask;
+    }
+  }
 }
 
 namespace MFramework
@@ -76,89 +89,135 @@ namespace MFramework
       return;
     }
 
-    if (vertexShader == nullptr || vertexShader->Get()->GetBufferPointer() == nullptr)
+    if (vertexShader == nullptr || vertexShader->GetBufferPointer() == nullptr)
     {
       return;
     }
 
-    if (pixelShader == nullptr || pixelShader->Get()->GetBufferPointer() == nullptr)
+    if (pixelShader == nullptr || pixelShader->GetBufferPointer() == nullptr)
     {
       return;
     }
 
+    // 既定値はカリングなし・深度テストなし・sRGBレンダーターゲット一つ
+    PipelineStateDesc desc{};
+    desc.RootSignature = rootSig;
+    desc.VS = ShaderBytecode::Create(vertexShader->GetBufferPointer(), vertexShader->GetBufferSize());
+    desc.PS = ShaderBytecode::Create(pixelShader->GetBufferPointer(), pixelShader->GetBufferSize());
+    desc.InputLayout = CreateInputLayout2D();
+
+    if (blendDesc != nullptr)
+    {
+      ConvertBlendDesc(*blendDesc, desc.Blend);
+    }
+
+    Init(device, desc);
+  }
+
+  void PipelineState::Init(ID3D12Device* device, const PipelineStateDesc& desc)
+  {
+    if (device == nullptr)
+    {
+      return;
+    }
+
+    HRESULT result = Create(device, desc, nullptr, 0, m_pipelineState.ReleaseAndGetAddressOf());
+
+    assert(SUCCEEDED(result));
+  }
+
+  HRESULT PipelineState::Create(
+                                  ID3D12Device* device,
+                                  const PipelineStateDesc& pipelineDesc,
+                                  const void* cachedBlob,
+                                  size_t cachedBlobSize,
+                                  ID3D12PipelineState** outPipelineState
+                                )
+  {
+    if (device == nullptr || outPipelineState == nullptr)
+    {
+      return E_INVALIDARG;
+    }
+
+    if (pipelineDesc.VS.Data == nullptr || pipelineDesc.PS.Data == nullptr)
+    {
+      return E_INVALIDARG;
+    }
+
     // ラスタライザーステートの設定
     D3D12_RASTERIZER_DESC rasDesc = {};
    
-    rasDesc.FillMode = D3D12_FILL_MODE_SOLID;         // 中身を塗りつぶす ※ポリゴンの中身、ソリッドモデル
-    rasDesc.CullMode = D3D12_CULL_MODE_NONE;          // カリングしない ※背面カリング、PMDモデルには裏側にポリゴンがないものが多い
-    rasDesc.FrontCounterClockwise = FALSE;            // false
-    rasDesc.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
-    rasDesc.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
-    rasDesc.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
-    rasDesc.DepthClipEnable = TRUE;                   // 深度方向のクリッピングは有効に　※後々必要になってくる
-    rasDesc.MultisampleEnable = FALSE;                // まだアンチエイリアシングを使わないためfalse 
+    rasDesc.FillMode = static_cast<D3D12_FILL_MODE>(pipelineDesc.Rasterizer.FillMode);   // 中身を塗りつぶす ※ポリゴンの中身、ソリッドモデル
+    rasDesc.CullMode = static_cast<D3D12_CULL_MODE>(pipelineDesc.Rasterizer.CullMode);   // カリング ※背面カリング、PMDモデルには裏側にポリゴンがないものが多い
+    rasDesc.FrontCounterClockwise = pipelineDesc.Rasterizer.FrontCounterClockwise;
+    rasDesc.DepthBias = pipelineDesc.Rasterizer.DepthBias;
+    rasDesc.DepthBiasClamp = pipelineDesc.Rasterizer.DepthBiasClamp;
+    rasDesc.SlopeScaledDepthBias = pipelineDesc.Rasterizer.SlopeScaledDepthBias;
+    rasDesc.DepthClipEnable = pipelineDesc.Rasterizer.DepthClipEnable;                   // 深度方向のクリッピング
+    rasDesc.MultisampleEnable = (pipelineDesc.SampleCount > 1);
     rasDesc.AntialiasedLineEnable = FALSE;
     rasDesc.ForcedSampleCount = 0;
-    rasDesc.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
+    rasDesc.ConservativeRaster = pipelineDesc.Rasterizer.ConservativeRaster ? D3D12_CONSERVATIVE_RASTERIZATION_MODE_ON : D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
 
      // パイプラインステート作成
     D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
 
-    desc.pRootSignature = rootSig;
+    desc.pRootSignature = pipelineDesc.RootSignature;
     // シェーダーをセット
-    desc.VS.pShaderBytecode = vertexShader->Get()->GetBufferPointer();
-    desc.VS.BytecodeLength = vertexShader->Get()->GetBufferSize();
-    desc.PS.pShaderBytecode = pixelShader->Get()->GetBufferPointer();
-    desc.PS.BytecodeLength = pixelShader->Get()->GetBufferSize();
+    desc.VS.pShaderBytecode = pipelineDesc.VS.Data;
+    desc.VS.BytecodeLength = pipelineDesc.VS.Size;
+    desc.PS.pShaderBytecode = pipelineDesc.PS.Data;
+    desc.PS.BytecodeLength = pipelineDesc.PS.Size;
 
-    // サンプルマスクとラスタライザーステート設定
-    desc.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
-   
     // ブレンドステート設定
-    
-    if (blendDesc == nullptr)
-    {   
-      // BlendOpとLogicOpがあり、メンバーをどう演算するかを表している
-      // BlendEnableとLogicOpEnableは演算を行うかを表す変数で、両方同時にtrueになれず、どちらかを選ぶ
-      // 今回はブレンドしないため、両方をfalseにする
-      D3D12_RENDER_TARGET_BLEND_DESC rtBlendDesc = {};
-      rtBlendDesc.BlendEnable = FALSE;
+    // BlendOpとLogicOpがあり、メンバーをどう演算するかを表している
+    // BlendEnableとLogicOpEnableは演算を行うかを表す変数で、両方同時にtrueになれず、どちらかを選ぶ
+    // 論理演算は使わないため、LogicOpEnableは常にfalse
+    // AlphaToCoverageEnable:ピクセルシェーダから出力されたアルファ成分を取得し、マルチサンプリングアンチエイリアス処理を適用する機能
+    // IndependentBlendEnable:FALSEに指定すれば、RenderTargetの０が使われ、１～７が無視される
+    desc.BlendState.AlphaToCoverageEnable = pipelineDesc.Blend.AlphaToCoverageEnable;
+    desc.BlendState.IndependentBlendEnable = pipelineDesc.Blend.IndependentBlendEnable;
+    for (UINT i = 0 ; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
+    {
+      const RenderTargetBlendState& rtBlend = pipelineDesc.Blend.RenderTargets[i];
+      D3D12_RENDER_TARGET_BLEND_DESC& rtBlendDesc = desc.BlendState.RenderTarget[i];
+
+      rtBlendDesc.BlendEnable = rtBlend.BlendEnable;
       rtBlendDesc.LogicOpEnable = FALSE;
-      rtBlendDesc.SrcBlend = D3D12_BLEND_ONE;         // ピクセルシェーダから出力されたRGB値に対して実行するブレンドオプション
-      rtBlendDesc.DestBlend = D3D12_BLEND_ZERO;       // 現在のレンダーターゲットのRGB値に対して実行するブレンドオプション
-      rtBlendDesc.BlendOp = D3D12_BLEND_OP_ADD;       // SRCとDESTをどのように結合するかを定義するブレンド演算
-      rtBlendDesc.SrcBlendAlpha = D3D12_BLEND_ONE;    // アルファ値に対する実行するブレンドオプション(_COLORで終わるブレンドオプションは設定できない)
-      rtBlendDesc.DestBlendAlpha = D3D12_BLEND_ZERO;  // アルファ値に対する実行するブレンドオプション(_COLORで終わるブレンドオプションは設定できない)
-      rtBlendDesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;  // SRCAlphaとDESTAlphaをどのように結合するかを定義するブレンド演算
-      rtBlendDesc.LogicOp = D3D12_LOGIC_OP_NOOP;      // レンダーターゲットに対して設定する論理演算を指定する
+      rtBlendDesc.SrcBlend = static_cast<D3D12_BLEND>(rtBlend.SrcBlend);                // ピクセルシェーダから出力されたRGB値に対して実行するブレンドオプション
+      rtBlendDesc.DestBlend = static_cast<D3D12_BLEND>(rtBlend.DestBlend);              // 現在のレンダーターゲットのRGB値に対して実行するブレンドオプション
+      rtBlendDesc.BlendOp = static_cast<D3D12_BLEND_OP>(rtBlend.BlendOp);               // SRCとDESTをどのように結合するかを定義するブレンド演算
+      rtBlendDesc.SrcBlendAlpha = static_cast<D3D12_BLEND>(rtBlend.SrcBlendAlpha);
+      rtBlendDesc.DestBlendAlpha = static_cast<D3D12_BLEND>(rtBlend.DestBlendAlpha);
+      rtBlendDesc.BlendOpAlpha = static_cast<D3D12_BLEND_OP>(rtBlend.BlendOpAlpha);
+      rtBlendDesc.LogicOp = D3D12_LOGIC_OP_NOOP;
       // RGBAそれぞれの値を書き込むかどうか指定するための値
-      rtBlendDesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
-
-      // DX12の魔導書の範囲においては、マルチサンプリング（アンチエイリアシングの適用）でない場合、AlphaToCoverageEnableの値はαテストの有無を表す（？）
-      // マルチサンプリング時の「網羅率」まで考慮して描画を行う
-      // ピクセルシェーダから出力されたアルファ成分を取得し、マルチサンプリングアンチエイリアス処理を適用する機能
-      desc.BlendState.AlphaToCoverageEnable = FALSE;
-      // IndependentBlendEnableにtrueを指定すれば、合計8個のレンダーターゲットに対して別々にブレンドステート設定できる。falseだったら0番目が全てに適用する。
-      // FALSEに指定すれば、RenderTargetの０が使われ、１～７が無視される
-      desc.BlendState.IndependentBlendEnable = FALSE;
-      for (UINT i = 0 ; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i)
-      {
-        desc.BlendState.RenderTarget[i] = rtBlendDesc;
-      }
-    }
-    else
-    {
-      desc.BlendState = *blendDesc;
+      rtBlendDesc.RenderTargetWriteMask = rtBlend.WriteMask;
     }
  
     desc.RasterizerState = rasDesc;
-    // ??
-    desc.DepthStencilState.DepthEnable = false;
-    desc.DepthStencilState.StencilEnable = false;
+
+    desc.DepthStencilState.DepthEnable = pipelineDesc.DepthStencil.DepthEnable;
+    desc.DepthStencilState.DepthWriteMask = pipelineDesc.DepthStencil.DepthWriteEnable ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+    desc.DepthStencilState.DepthFunc = static_cast<D3D12_COMPARISON_FUNC>(pipelineDesc.DepthStencil.DepthFunc);
+    desc.DepthStencilState.StencilEnable = pipelineDesc.DepthStencil.StencilEnable;
     
     // 入力レイアウトを設定
-    desc.InputLayout.pInputElementDescs = INPUT_LAYOUT_2D;
-    desc.InputLayout.NumElements = _countof(INPUT_LAYOUT_2D); // 配列の数を取得するためのマクロ
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements(pipelineDesc.InputLayout.size());
+    for (size_t i = 0; i < inputElements.size(); ++i)
+    {
+      const InputElement& element = pipelineDesc.InputLayout[i];
+
+      inputElements[i].SemanticName = element.SemanticName.c_str();
+      inputElements[i].SemanticIndex = element.SemanticIndex;
+      inputElements[i].Format = static_cast<DXGI_FORMAT>(element.Format);
+      inputElements[i].InputSlot = element.InputSlot;
+      inputElements[i].AlignedByteOffset = element.AlignedByteOffset;
+      inputElements[i].InputSlotClass = element.IsPerInstance ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+      inputElements[i].InstanceDataStepRate = element.InstanceDataStepRate;
+    }
+    desc.InputLayout.pInputElementDescs = inputElements.data();
+    desc.InputLayout.NumElements = static_cast<UINT>(inputElements.size());
 
     // IBStripCutValueを設定
     // トライアングルストリップのとき、「切り離せない頂点集合」を特定のインデックスで切り離すための指定を行うもの（詳しくはDX12魔導書P138）
@@ -167,25 +226,26 @@ namespace MFramework
 
     // PrimitiveTopologyTypeを設定
     // 構成要素が「点」「線」「三角形」のどれなのかを指定
-    desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    desc.PrimitiveTopologyType = static_cast<D3D12_PRIMITIVE_TOPOLOGY_TYPE>(pipelineDesc.PrimitiveTopologyType);
 
     // 設定したレンダーターゲットの数だけフォーマットを指定
-    desc.NumRenderTargets = 1;                             // 今回レンダーターゲットは一つしかないので1
-    desc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;  // 0~1に正規化されたRGBA
-    desc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+    desc.NumRenderTargets = (pipelineDesc.NumRenderTargets < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT) ? pipelineDesc.NumRenderTargets : D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT;
+    for (UINT i = 0; i < desc.NumRenderTargets; ++i)
+    {
+      desc.RTVFormats[i] = static_cast<DXGI_FORMAT>(pipelineDesc.RTVFormats[i]);
+    }
+    desc.DSVFormat = static_cast<DXGI_FORMAT>(pipelineDesc.DSVFormat);
 
     // アンチエイリアシング設定
-    // 今回はしない
-    desc.SampleDesc.Count = 1;                     // サンプリングは1ピクセルにつき1
-    desc.SampleDesc.Quality = 0;                   // クオリティ最低
-    // ??
-    desc.SampleMask = UINT_MAX;
+    desc.SampleDesc.Count = pipelineDesc.SampleCount;
+    desc.SampleDesc.Quality = pipelineDesc.SampleQuality;
+    desc.SampleMask = pipelineDesc.SampleMask;
 
-    HRESULT result = S_OK;
+    // 前回保存したドライバーのキャッシュがあれば使う
+    desc.CachedPSO.pCachedBlob = cachedBlob;
+    desc.CachedPSO.CachedBlobSizeInBytes = (cachedBlob != nullptr) ? cachedBlobSize : 0;
 
-    result = device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(m_pipelineState.ReleaseAndGetAddressOf()));
-
-    assert(SUCCEEDED(result));
+    return device->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(outPipelineState));
   }
 
   void PipelineState::Dispose() noexcept
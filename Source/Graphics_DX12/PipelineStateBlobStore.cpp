@@ -0,0 +1,188 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Pipeline state cached blob store (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/PipelineStateBlobStore.h>
+
+#include <fstream>
+
+namespace
+{
+  constexpr uint32_t BLOB_STORE_MAGIC = 0x4f53504d;     // "MPSO"
+  constexpr uint32_t BLOB_STORE_VERSION = 1;
+  // 壊れたファイルで巨大な確保をしないための上限
+  constexpr uint64_t MAX_BLOB_SIZE = 64ull * 1024 * 1024;
+
+  struct BlobStoreHeader
+  {
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Count;
+  };
+
+  struct BlobEntryHeader
+  {
+    uint64_t Key;
+    uint64_t Size;
+  };
+}
+
+namespace MFramework
+{
+  PipelineStateBlobStore::PipelineStateBlobStore()
+    : m_blobs()
+    , m_isDirty(false)
+    , m_mutex()
+  { }
+
+  PipelineStateBlobStore::~PipelineStateBlobStore()
+  {
+    Dispose();
+  }
+
+  bool PipelineStateBlobStore::LoadFromFile(const std::string& filePath)
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+
+    BlobStoreHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+      return false;
+    }
+
+    if ((header.Magic != BLOB_STORE_MAGIC) || (header.Version != BLOB_STORE_VERSION))
+    {
+      return false;
+    }
+
+    std::unordered_map<uint64_t, std::vector<uint8_t>> blobs;
+    for (uint64_t i = 0; i < header.Count; ++i)
+    {
+      BlobEntryHeader entry{};
+      if (!file.read(reinterpret_cast<char*>(&entry), sizeof(entry)) || (entry.Size > MAX_BLOB_SIZE))
+      {
+        return false;
+      }
+
+      std::vector<uint8_t> blob(static_cast<size_t>(entry.Size));
+      if (!file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(blob.size())))
+      {
+        return false;
+      }
+
+      blobs[entry.Key] = std::move(blob);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blobs = std::move(blobs);
+    m_isDirty = false;
+
+    return true;
+  }
+
+  bool PipelineStateBlobStore::SaveToFile(const std::string& filePath)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_isDirty)
+    {
+      return true;
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      return false;
+    }
+
+    BlobStoreHeader header{ BLOB_STORE_MAGIC, BLOB_STORE_VERSION, static_cast<uint64_t>(m_blobs.size()) };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const auto& [key, blob] : m_blobs)
+    {
+      BlobEntryHeader entry{ key, static_cast<uint64_t>(blob.size()) };
+      file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+      file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+    }
+
+    if (!file.good())
+    {
+      return false;
+    }
+
+    m_isDirty = false;
+    return true;
+  }
+
+  bool PipelineStateBlobStore::Find(uint64_t key, std::vector<uint8_t>& outBlob) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_blobs.find(key);
+    if (it == m_blobs.end())
+    {
+      return false;
+    }
+
+    outBlob = it->second;
+    return true;
+  }
+
+  void PipelineStateBlobStore::Store(uint64_t key, const void* data, size_t size)
+  {
+    if (data == nullptr || size == 0)
+    {
+      return;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blobs[key].assign(bytes, bytes + size);
+    m_isDirty = true;
+  }
+
+  void PipelineStateBlobStore::Remove(uint64_t key)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_blobs.erase(key) > 0)
+    {
+      m_isDirty = true;
+    }
+  }
+
+  size_t PipelineStateBlobStore::GetCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_blobs.size();
+  }
+
+  bool PipelineStateBlobStore::IsDirty() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isDirty;
+  }
+
+  void PipelineStateBlobStore::Dispose() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blobs.clear();
+    m_isDirty = false;
+  }
+}
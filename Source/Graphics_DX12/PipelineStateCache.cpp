@@ -0,0 +1,269 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Pipeline state object cache (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Compare serialized descriptions on hash hits
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/PipelineStateCache.h>
+#include <Graphics_DX12/PipelineState.h>
+#include <HashUtil.h>
+
+#include <d3d12.h>
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace
+{
+  // バックグラウンドのコンパイルに渡すデータ
+  // 呼び出し側のバイトコードやルートシグネチャーが先に解放されても困らないように持っておく
+  struct CompileJob
+  {
+    MFramework::PipelineStateDesc Desc;
+    std::vector<uint8_t> VSCode;
+    std::vector<uint8_t> PSCode;
+    MFramework::ComPtr<ID3D12RootSignature> RootSignature;
+  };
+
+  void CopyBytecode(MFramework::ShaderBytecode& bytecode, std::vector<uint8_t>& storage)
+  {
+    if (bytecode.Data == nullptr || bytecode.Size == 0)
+    {
+      return;
+    }
+
+    const uint8_t* data = static_cast<const uint8_t*>(bytecode.Data);
+    storage.assign(data, data + bytecode.Size);
+    bytecode.Data = storage.data();
+  }
+}
+
+namespace MFramework
+{
+  PipelineStateEntry::PipelineStateEntry()
+    : m_pipelineState(nullptr)
+    , m_status(Status::Compiling)
+    , m_hash(0)
+    , m_serializedDesc()
+  { }
+
+  PipelineStateEntry::~PipelineStateEntry()
+  {
+    m_pipelineState.Reset();
+  }
+
+  ID3D12PipelineState* PipelineStateEntry::Get() const
+  {
+    if (!IsReady())
+    {
+      return nullptr;
+    }
+
+    return m_pipelineState.Get();
+  }
+
+  void PipelineStateEntry::Wait() const
+  {
+    m_status.wait(Status::Compiling, std::memory_order_acquire);
+  }
+
+  PipelineStateCache::PipelineStateCache()
+    : m_device(nullptr)
+    , m_cacheFilePath()
+    , m_entries()
+    , m_blobStore()
+    , m_compileThreads()
+  { }
+
+  PipelineStateCache::~PipelineStateCache()
+  {
+    Dispose();
+  }
+
+  bool PipelineStateCache::Init(ID3D12Device* device, const std::string& cacheFilePath, uint32_t compileThreadCount, size_t capacity)
+  {
+    if (device == nullptr || m_device != nullptr)
+    {
+      return false;
+    }
+
+    if (!m_entries.Init(capacity))
+    {
+      return false;
+    }
+
+    if (!m_compileThreads.Init(compileThreadCount))
+    {
+      m_entries.Dispose();
+      return false;
+    }
+
+    m_device = device;
+    m_cacheFilePath = cacheFilePath;
+
+    // 前回のブロブがなくても問題ない(初回起動など)
+    if (!m_cacheFilePath.empty())
+    {
+      m_blobStore.LoadFromFile(m_cacheFilePath);
+    }
+
+    return true;
+  }
+
+  PipelineStateEntry* PipelineStateCache::Request(const PipelineStateDesc& desc)
+  {
+    if (m_device == nullptr)
+    {
+      return nullptr;
+    }
+
+    // ComputeHashと同じく正規形からハッシュを求め、正規形はエントリーとの比較に使う
+    std::vector<uint8_t> serializedDesc;
+    desc.Serialize(serializedDesc);
+    const uint64_t hash = HashUtility::Fnv1a64(serializedDesc.data(), serializedDesc.size());
+
+    PipelineStateEntry* entry = m_entries.Find(hash);
+    if (entry == nullptr)
+    {
+      std::unique_ptr<PipelineStateEntry> newEntry = std::make_unique<PipelineStateEntry>();
+      newEntry->m_hash = hash;
+      newEntry->m_serializedDesc = serializedDesc;
+
+      bool isInserted = false;
+      entry = m_entries.Insert(hash, std::move(newEntry), &isInserted);
+      if (entry == nullptr)
+      {
+        return nullptr;
+      }
+
+      // 同時に同じキーを要求した他のスレッドが先に追加した場合はそちらがコンパイルする
+      if (isInserted)
+      {
+        submitCompile(desc, entry);
+        return entry;
+      }
+    }
+
+    // ハッシュだけが同じ別の記述なら、違うパイプラインステートを返さない
+    if (entry->m_serializedDesc != serializedDesc)
+    {
+      #ifdef _DEBUG
+        ::OutputDebugStringA("PipelineStateCache : pipeline state hash collision\n");
+      #endif
+      assert(false && "PipelineStateCache : pipeline state hash collision");
+      return nullptr;
+    }
+
+    return entry;
+  }
+
+  void PipelineStateCache::submitCompile(const PipelineStateDesc& desc, PipelineStateEntry* entry)
+  {
+    std::shared_ptr<CompileJob> job = std::make_shared<CompileJob>();
+    job->Desc = desc;
+    job->RootSignature = desc.RootSignature;
+    CopyBytecode(job->Desc.VS, job->VSCode);
+    CopyBytecode(job->Desc.PS, job->PSCode);
+
+    m_compileThreads.Submit(
+                            [this, job, entry]()
+                            {
+                              compile(job->Desc, entry);
+                            }
+                          );
+  }
+
+  ID3D12PipelineState* PipelineStateCache::GetOrCreate(const PipelineStateDesc& desc)
+  {
+    PipelineStateEntry* entry = Request(desc);
+    if (entry == nullptr)
+    {
+      return nullptr;
+    }
+
+    entry->Wait();
+    return entry->Get();
+  }
+
+  void PipelineStateCache::WaitIdle()
+  {
+    m_compileThreads.WaitIdle();
+  }
+
+  bool PipelineStateCache::SaveToFile()
+  {
+    if (m_cacheFilePath.empty())
+    {
+      return false;
+    }
+
+    return m_blobStore.SaveToFile(m_cacheFilePath);
+  }
+
+  void PipelineStateCache::Dispose() noexcept
+  {
+    // コンパイル中のタスクが終わってからエントリーを破棄する
+    m_compileThreads.Dispose();
+    m_entries.Dispose();
+    m_blobStore.Dispose();
+    m_cacheFilePath.clear();
+    m_device = nullptr;
+  }
+
+  void PipelineStateCache::compile(const PipelineStateDesc& desc, PipelineStateEntry* entry)
+  {
+    std::vector<uint8_t> cachedBlob;
+    const bool hasCachedBlob = m_blobStore.Find(entry->m_hash, cachedBlob);
+    bool isBlobRequired = !hasCachedBlob;
+
+    HRESULT result = PipelineState::Create(
+                                            m_device,
+                                            desc,
+                                            hasCachedBlob ? cachedBlob.data() : nullptr,
+                                            cachedBlob.size(),
+                                            entry->m_pipelineState.ReleaseAndGetAddressOf()
+                                          );
+
+    // ドライバーやGPUが変わるとブロブが使えないため作り直す
+    if (FAILED(result) && hasCachedBlob)
+    {
+      m_blobStore.Remove(entry->m_hash);
+      isBlobRequired = true;
+      result = PipelineState::Create(m_device, desc, nullptr, 0, entry->m_pipelineState.ReleaseAndGetAddressOf());
+    }
+
+    if (SUCCEEDED(result))
+    {
+      if (isBlobRequired)
+      {
+        ComPtr<ID3DBlob> blob = nullptr;
+        if (SUCCEEDED(entry->m_pipelineState->GetCachedBlob(blob.ReleaseAndGetAddressOf())))
+        {
+          m_blobStore.Store(entry->m_hash, blob->GetBufferPointer(), blob->GetBufferSize());
+        }
+      }
+
+      entry->m_status.store(PipelineStateEntry::Status::Ready, std::memory_order_release);
+    }
+    else
+    {
+      #ifdef _DEBUG
+        ::OutputDebugStringA("PipelineStateCache : failed to create pipeline state\n");
+      #endif
+      entry->m_status.store(PipelineStateEntry::Status::Failed, std::memory_order_release);
+    }
+
+    entry->m_status.notify_all();
+  }
+}
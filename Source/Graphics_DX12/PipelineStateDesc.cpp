@@ -0,0 +1,150 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Hashable pipeline state description (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Input layout from vertex layout
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/PipelineStateDesc.h>
+#include <RenderSystem/VertexFormat.h>
+#include <HashUtil.h>
+
+#include <cstring>
+
+namespace
+{
+  // キーの形式を変えたら上げる(ディスクキャッシュも無効になる)
+  constexpr uint32_t PIPELINE_KEY_VERSION = 1;
+
+  template<typename T>
+  void Write(std::vector<uint8_t>& bytes, const T& value)
+  {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  void WriteBool(std::vector<uint8_t>& bytes, bool value)
+  {
+    bytes.emplace_back(value ? 1 : 0);
+  }
+
+  void WriteString(std::vector<uint8_t>& bytes, const std::string& value)
+  {
+    Write(bytes, static_cast<uint32_t>(value.size()));
+    bytes.insert(bytes.end(), value.begin(), value.end());
+  }
+}
+
+namespace MFramework
+{
+  ShaderBytecode ShaderBytecode::Create(const void* data, size_t size)
+  {
+    ShaderBytecode bytecode;
+    bytecode.Data = data;
+    bytecode.Size = size;
+    bytecode.Hash = HashUtility::Fnv1a64(data, size);
+
+    return bytecode;
+  }
+
+  std::vector<InputElement> InputElement::CreateFromVertexLayout(const VertexLayout& layout, uint32_t inputSlot)
+  {
+    std::vector<InputElement> elements;
+    elements.reserve(layout.ElementCount);
+    for (uint32_t i = 0; i < layout.ElementCount; ++i)
+    {
+      const VertexElement& element = layout.Elements[i];
+      elements.emplace_back(InputElement{ VertexFormat::GetSemanticName(element.Semantic), 0, VertexFormat::GetDxgiFormat(element.Format), inputSlot, element.Offset, false, 0 });
+    }
+
+    return elements;
+  }
+
+  void PipelineStateDesc::Serialize(std::vector<uint8_t>& outBytes) const
+  {
+    outBytes.clear();
+    outBytes.reserve(256);
+
+    Write(outBytes, PIPELINE_KEY_VERSION);
+    Write(outBytes, RootSignatureHash);
+    Write(outBytes, VS.Hash);
+    Write(outBytes, PS.Hash);
+
+    Write(outBytes, static_cast<uint32_t>(InputLayout.size()));
+    for (const InputElement& element : InputLayout)
+    {
+      WriteString(outBytes, element.SemanticName);
+      Write(outBytes, element.SemanticIndex);
+      Write(outBytes, element.Format);
+      Write(outBytes, element.InputSlot);
+      Write(outBytes, element.AlignedByteOffset);
+      WriteBool(outBytes, element.IsPerInstance);
+      Write(outBytes, element.InstanceDataStepRate);
+    }
+
+    WriteBool(outBytes, Blend.AlphaToCoverageEnable);
+    WriteBool(outBytes, Blend.IndependentBlendEnable);
+
+    // 独立ブレンドでなければ0番だけが使われる
+    const uint32_t blendCount = Blend.IndependentBlendEnable ? MAX_PIPELINE_RENDER_TARGETS : 1;
+    for (uint32_t i = 0; i < blendCount; ++i)
+    {
+      const RenderTargetBlendState& rtBlend = Blend.RenderTargets[i];
+      WriteBool(outBytes, rtBlend.BlendEnable);
+      Write(outBytes, rtBlend.SrcBlend);
+      Write(outBytes, rtBlend.DestBlend);
+      Write(outBytes, rtBlend.BlendOp);
+      Write(outBytes, rtBlend.SrcBlendAlpha);
+      Write(outBytes, rtBlend.DestBlendAlpha);
+      Write(outBytes, rtBlend.BlendOpAlpha);
+      Write(outBytes, rtBlend.WriteMask);
+    }
+
+    Write(outBytes, Rasterizer.FillMode);
+    Write(outBytes, Rasterizer.CullMode);
+    WriteBool(outBytes, Rasterizer.FrontCounterClockwise);
+    Write(outBytes, Rasterizer.DepthBias);
+    Write(outBytes, Rasterizer.DepthBiasClamp);
+    Write(outBytes, Rasterizer.SlopeScaledDepthBias);
+    WriteBool(outBytes, Rasterizer.DepthClipEnable);
+    WriteBool(outBytes, Rasterizer.ConservativeRaster);
+
+    WriteBool(outBytes, DepthStencil.DepthEnable);
+    WriteBool(outBytes, DepthStencil.DepthWriteEnable);
+    Write(outBytes, DepthStencil.DepthFunc);
+    WriteBool(outBytes, DepthStencil.StencilEnable);
+
+    Write(outBytes, SampleMask);
+    Write(outBytes, PrimitiveTopologyType);
+
+    // 使われないレンダーターゲットのフォーマットは含めない
+    const uint32_t rtCount = (NumRenderTargets < MAX_PIPELINE_RENDER_TARGETS) ? NumRenderTargets : MAX_PIPELINE_RENDER_TARGETS;
+    Write(outBytes, rtCount);
+    for (uint32_t i = 0; i < rtCount; ++i)
+    {
+      Write(outBytes, RTVFormats[i]);
+    }
+
+    Write(outBytes, DSVFormat);
+    Write(outBytes, SampleCount);
+    Write(outBytes, SampleQuality);
+  }
+
+  uint64_t PipelineStateDesc::ComputeHash() const
+  {
+    std::vector<uint8_t> bytes;
+    Serialize(bytes);
+
+    return HashUtility::Fnv1a64(bytes.data(), bytes.size());
+  }
+}
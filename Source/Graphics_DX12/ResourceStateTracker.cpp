@@ -0,0 +1,540 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Resource state tracker (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Merge only barriers with no recorded work between them
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ResourceStateTracker.h>
+
+#include <algorithm>
+#include <iterator>
+#include <cstdio>
+
+namespace
+{
+  constexpr size_t VALIDATION_MESSAGE_LENGTH = 256;
+}
+
+namespace MFramework
+{
+  #pragma region ResourceStateRegistry
+  ResourceStateRegistry::ResourceStateRegistry()
+    : m_states()
+    , m_mutex()
+  { }
+
+  ResourceStateRegistry::~ResourceStateRegistry()
+  {
+    Dispose();
+  }
+
+  void ResourceStateRegistry::Register(ID3D12Resource* resource, uint32_t subresourceCount, ResourceStates initialState)
+  {
+    if (resource == nullptr || subresourceCount == 0)
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_states[resource].assign(subresourceCount, initialState);
+  }
+
+  void ResourceStateRegistry::Unregister(ID3D12Resource* resource)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_states.erase(resource);
+  }
+
+  bool ResourceStateRegistry::IsRegistered(ID3D12Resource* resource) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_states.find(resource) != m_states.end();
+  }
+
+  uint32_t ResourceStateRegistry::GetSubresourceCount(ID3D12Resource* resource) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_states.find(resource);
+    if (it == m_states.end())
+    {
+      return 0;
+    }
+
+    return static_cast<uint32_t>(it->second.size());
+  }
+
+  ResourceStates ResourceStateRegistry::GetState(ID3D12Resource* resource, uint32_t subresource) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_states.find(resource);
+    if (it == m_states.end())
+    {
+      return UNKNOWN_RESOURCE_STATE;
+    }
+
+    const std::vector<ResourceStates>& states = it->second;
+
+    // 全サブリソースが同じ状態の場合のみ有効な値を返す
+    if (subresource == ALL_SUBRESOURCES)
+    {
+      for (size_t i = 1; i < states.size(); ++i)
+      {
+        if (states[i] != states[0])
+        {
+          return UNKNOWN_RESOURCE_STATE;
+        }
+      }
+      return states[0];
+    }
+
+    if (subresource >= states.size())
+    {
+      return UNKNOWN_RESOURCE_STATE;
+    }
+
+    return states[subresource];
+  }
+
+  void ResourceStateRegistry::SetState(ID3D12Resource* resource, uint32_t subresource, ResourceStates state)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_states.find(resource);
+    if (it == m_states.end())
+    {
+      return;
+    }
+
+    if (subresource == ALL_SUBRESOURCES)
+    {
+      std::fill(it->second.begin(), it->second.end(), state);
+    }
+    else if (subresource < it->second.size())
+    {
+      it->second[subresource] = state;
+    }
+  }
+
+  void ResourceStateRegistry::Dispose() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_states.clear();
+  }
+  #pragma endregion ResourceStateRegistry
+
+  #pragma region ResourceStateTracker
+  ResourceStates ResourceStateTracker::SubresourceStates::Get(uint32_t subresource) const
+  {
+    if (IsUniform || subresource == ALL_SUBRESOURCES)
+    {
+      return IsUniform ? UniformState : UNKNOWN_RESOURCE_STATE;
+    }
+
+    return (subresource < States.size()) ? States[subresource] : UNKNOWN_RESOURCE_STATE;
+  }
+
+  void ResourceStateTracker::SubresourceStates::Set(uint32_t subresource, ResourceStates state, uint32_t subresourceCount)
+  {
+    if (subresource == ALL_SUBRESOURCES)
+    {
+      SetAll(state);
+      return;
+    }
+
+    if (IsUniform)
+    {
+      if (UniformState == state)
+      {
+        return;
+      }
+
+      // 一部のサブリソースだけ状態が変わるため展開する
+      States.assign(subresourceCount, UniformState);
+      IsUniform = false;
+    }
+
+    if (subresource < States.size())
+    {
+      States[subresource] = state;
+    }
+  }
+
+  void ResourceStateTracker::SubresourceStates::SetAll(ResourceStates state)
+  {
+    IsUniform = true;
+    UniformState = state;
+    States.clear();
+  }
+
+  ResourceStateTracker::ResourceStateTracker()
+    : m_registry(nullptr)
+    , m_resources()
+    , m_queuedBarriers()
+    , m_validationErrors()
+    , m_isValidationMode(false)
+  { }
+
+  ResourceStateTracker::~ResourceStateTracker()
+  {
+    Dispose();
+  }
+
+  void ResourceStateTracker::Init(ResourceStateRegistry* registry)
+  {
+    m_registry = registry;
+    Reset();
+  }
+
+  void ResourceStateTracker::SetValidationMode(bool enable)
+  {
+    m_isValidationMode = enable;
+  }
+
+  void ResourceStateTracker::Transition(ID3D12Resource* resource, ResourceStates after, uint32_t subresource)
+  {
+    if (resource == nullptr)
+    {
+      return;
+    }
+
+    TrackedResource& tracked = track(resource);
+
+    if (isSplitting(tracked, subresource))
+    {
+      reportError("Transition on a subresource with an unfinished split barrier", resource, subresource);
+      return;
+    }
+
+    if (subresource == ALL_SUBRESOURCES)
+    {
+      if (tracked.Current.IsUniform)
+      {
+        transitionSubresource(resource, tracked, ALL_SUBRESOURCES, after);
+      }
+      else
+      {
+        // 状態がばらばらのため、サブリソースごとに遷移させてからまとめる
+        for (uint32_t i = 0; i < tracked.SubresourceCount; ++i)
+        {
+          transitionSubresource(resource, tracked, i, after);
+        }
+        tracked.Current.SetAll(after);
+      }
+      return;
+    }
+
+    if (subresource >= tracked.SubresourceCount)
+    {
+      reportError("Subresource index out of range", resource, subresource);
+      return;
+    }
+
+    transitionSubresource(resource, tracked, subresource, after);
+  }
+
+  void ResourceStateTracker::BeginSplitTransition(ID3D12Resource* resource, ResourceStates after, uint32_t subresource)
+  {
+    if (resource == nullptr)
+    {
+      return;
+    }
+
+    TrackedResource& tracked = track(resource);
+
+    if (isSplitting(tracked, subresource))
+    {
+      reportError("Split barrier begun twice", resource, subresource);
+      return;
+    }
+
+    if (subresource != ALL_SUBRESOURCES && subresource >= tracked.SubresourceCount)
+    {
+      reportError("Subresource index out of range", resource, subresource);
+      return;
+    }
+
+    const ResourceStates before = tracked.Current.Get(subresource);
+
+    // 直前の状態が分からないと分割できないため、通常の遷移にする
+    if (before == UNKNOWN_RESOURCE_STATE)
+    {
+      reportError("Split barrier on a subresource whose state is unknown in this list", resource, subresource);
+      Transition(resource, after, subresource);
+      return;
+    }
+
+    if (before == after)
+    {
+      return;
+    }
+
+    queueBarrier(resource, subresource, before, after, BarrierSplit::BeginOnly);
+    tracked.Splits.emplace_back(ActiveSplit{ subresource, before, after });
+  }
+
+  void ResourceStateTracker::EndSplitTransition(ID3D12Resource* resource, uint32_t subresource)
+  {
+    if (resource == nullptr)
+    {
+      return;
+    }
+
+    TrackedResource& tracked = track(resource);
+
+    for (auto it = tracked.Splits.begin(); it != tracked.Splits.end(); ++it)
+    {
+      if (it->Subresource != subresource)
+      {
+        continue;
+      }
+
+      queueBarrier(resource, subresource, it->Before, it->After, BarrierSplit::EndOnly);
+      tracked.Current.Set(subresource, it->After, tracked.SubresourceCount);
+      tracked.Splits.erase(it);
+      return;
+    }
+
+    reportError("Split barrier ended without begin", resource, subresource);
+  }
+
+  size_t ResourceStateTracker::FlushBarriers(std::vector<ResourceTransition>& outBarriers)
+  {
+    const size_t count = m_queuedBarriers.size();
+
+    outBarriers.insert(outBarriers.end(), m_queuedBarriers.begin(), m_queuedBarriers.end());
+    m_queuedBarriers.clear();
+
+    return count;
+  }
+
+  size_t ResourceStateTracker::ResolvePendingStates(std::vector<ResourceTransition>& outBarriers)
+  {
+    const size_t startCount = outBarriers.size();
+
+    if (!m_queuedBarriers.empty())
+    {
+      reportError("Barriers were not flushed before submit", nullptr, ALL_SUBRESOURCES);
+    }
+
+    for (auto& pair : m_resources)
+    {
+      ID3D12Resource* resource = pair.first;
+      TrackedResource& tracked = pair.second;
+
+      for (const ActiveSplit& split : tracked.Splits)
+      {
+        reportError("Split barrier not ended before submit", resource, split.Subresource);
+      }
+
+      if (m_registry == nullptr || !m_registry->IsRegistered(resource))
+      {
+        reportError("Resource is not registered in the state registry", resource, ALL_SUBRESOURCES);
+        continue;
+      }
+
+      // 保留状態とキュー上の状態を照合する
+      if (tracked.Pending.IsUniform)
+      {
+        const ResourceStates required = tracked.Pending.UniformState;
+        if (required != UNKNOWN_RESOURCE_STATE)
+        {
+          const ResourceStates committed = m_registry->GetState(resource, ALL_SUBRESOURCES);
+          if (committed != UNKNOWN_RESOURCE_STATE)
+          {
+            if (committed != required)
+            {
+              outBarriers.emplace_back(ResourceTransition{ resource, ALL_SUBRESOURCES, committed, required, BarrierSplit::None });
+            }
+          }
+          else
+          {
+            for (uint32_t i = 0; i < tracked.SubresourceCount; ++i)
+            {
+              const ResourceStates subCommitted = m_registry->GetState(resource, i);
+              if (subCommitted != required)
+              {
+                outBarriers.emplace_back(ResourceTransition{ resource, i, subCommitted, required, BarrierSplit::None });
+              }
+            }
+          }
+        }
+      }
+      else
+      {
+        for (uint32_t i = 0; i < tracked.SubresourceCount; ++i)
+        {
+          const ResourceStates required = tracked.Pending.Get(i);
+          if (required == UNKNOWN_RESOURCE_STATE)
+          {
+            continue;
+          }
+
+          const ResourceStates subCommitted = m_registry->GetState(resource, i);
+          if (subCommitted != required)
+          {
+            outBarriers.emplace_back(ResourceTransition{ resource, i, subCommitted, required, BarrierSplit::None });
+          }
+        }
+      }
+
+      // リスト終了時の状態を確定させる
+      if (tracked.Current.IsUniform)
+      {
+        if (tracked.Current.UniformState != UNKNOWN_RESOURCE_STATE)
+        {
+          m_registry->SetState(resource, ALL_SUBRESOURCES, tracked.Current.UniformState);
+        }
+      }
+      else
+      {
+        for (uint32_t i = 0; i < tracked.SubresourceCount; ++i)
+        {
+          const ResourceStates state = tracked.Current.Get(i);
+          if (state != UNKNOWN_RESOURCE_STATE)
+          {
+            m_registry->SetState(resource, i, state);
+          }
+        }
+      }
+    }
+
+    // 二重に確定させないよう破棄する
+    m_resources.clear();
+
+    return outBarriers.size() - startCount;
+  }
+
+  void ResourceStateTracker::Reset()
+  {
+    m_resources.clear();
+    m_queuedBarriers.clear();
+    m_validationErrors.clear();
+  }
+
+  void ResourceStateTracker::Dispose() noexcept
+  {
+    m_resources.clear();
+    m_queuedBarriers.clear();
+    m_queuedBarriers.shrink_to_fit();
+    m_validationErrors.clear();
+    m_registry = nullptr;
+  }
+
+  ResourceStateTracker::TrackedResource& ResourceStateTracker::track(ID3D12Resource* resource)
+  {
+    auto it = m_resources.find(resource);
+    if (it != m_resources.end())
+    {
+      return it->second;
+    }
+
+    uint32_t subresourceCount = (m_registry != nullptr) ? m_registry->GetSubresourceCount(resource) : 0;
+    if (subresourceCount == 0)
+    {
+      reportError("Resource is not registered in the state registry", resource, ALL_SUBRESOURCES);
+      subresourceCount = 1;
+    }
+
+    TrackedResource& tracked = m_resources[resource];
+    tracked.SubresourceCount = subresourceCount;
+    tracked.Current.SetAll(UNKNOWN_RESOURCE_STATE);
+    tracked.Pending.SetAll(UNKNOWN_RESOURCE_STATE);
+
+    return tracked;
+  }
+
+  void ResourceStateTracker::transitionSubresource(ID3D12Resource* resource, TrackedResource& tracked, uint32_t subresource, ResourceStates after)
+  {
+    const ResourceStates before = tracked.Current.Get(subresource);
+
+    // このリストで初めて使う:バリアは出さず、必要な状態を保留として記録する
+    if (before == UNKNOWN_RESOURCE_STATE)
+    {
+      tracked.Pending.Set(subresource, after, tracked.SubresourceCount);
+      tracked.Current.Set(subresource, after, tracked.SubresourceCount);
+      return;
+    }
+
+    // 冗長な遷移
+    if (before == after)
+    {
+      return;
+    }
+
+    queueBarrier(resource, subresource, before, after, BarrierSplit::None);
+    tracked.Current.Set(subresource, after, tracked.SubresourceCount);
+  }
+
+  bool ResourceStateTracker::isSplitting(const TrackedResource& tracked, uint32_t subresource) const
+  {
+    for (const ActiveSplit& split : tracked.Splits)
+    {
+      if (split.Subresource == subresource || split.Subresource == ALL_SUBRESOURCES || subresource == ALL_SUBRESOURCES)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void ResourceStateTracker::queueBarrier(ID3D12Resource* resource, uint32_t subresource, ResourceStates before, ResourceStates after, BarrierSplit split)
+  {
+    if (split == BarrierSplit::None)
+    {
+      // 同じリソースに対する直近の未発行バリアと統合する
+      // 作業の前には必ず発行するので、キューにあるバリアとこの遷移の間には作業がない
+      for (auto it = m_queuedBarriers.rbegin(); it != m_queuedBarriers.rend(); ++it)
+      {
+        if (it->Resource != resource)
+        {
+          continue;
+        }
+
+        if (it->Subresource == subresource && it->Split == BarrierSplit::None && it->After == before)
+        {
+          if (it->Before == after)
+          {
+            // A -> B -> A は何もしないのと同じ
+            m_queuedBarriers.erase(std::next(it).base());
+          }
+          else
+          {
+            it->After = after;
+          }
+          return;
+        }
+
+        // 間に別のサブリソースのバリアがあるため順序を保つ
+        break;
+      }
+    }
+
+    m_queuedBarriers.emplace_back(ResourceTransition{ resource, subresource, before, after, split });
+  }
+
+  void ResourceStateTracker::reportError(const char* message, ID3D12Resource* resource, uint32_t subresource)
+  {
+    if (!m_isValidationMode)
+    {
+      return;
+    }
+
+    char buffer[VALIDATION_MESSAGE_LENGTH] = {};
+    std::snprintf(buffer, VALIDATION_MESSAGE_LENGTH, "%s (resource = %p, subresource = %u)", message, static_cast<void*>(resource), subresource);
+    m_validationErrors.emplace_back(buffer);
+  }
+  #pragma endregion ResourceStateTracker
+}
@@ -6,6 +6,12 @@ Author : MAI ZHICONG
 Description : DirectX12 RootSignature Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/07 Create
+                2026/10/19 Keep serialized blob hash for pipeline state keys
+                           Build from RootSignatureLayout
+                2026/10/19 Root SRV for instance data
+                2026/10/19 Bindless descriptor table
+                2026/10/19 Create through RootSignatureCache
+                2026/10/19 Keep serialized layout to tell hash collisions apart
            
 Version : alpha_1.0.0
 
@@ -14,9 +20,12 @@ Encoding : UTF-8
 */
 
 #include <Graphics_DX12/RootSignature.h>
+#include <Graphics_DX12/RootSignatureCache.h>
+#include <HashUtil.h>
 
 #include <d3d12.h>
 #include <string>
+#include <vector>
 
 #include <cassert>
 
@@ -26,107 +35,202 @@ namespace
                                                         | D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS
                                                         | D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS
                                                         | D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
+
+  void OutputMessages(const std::vector<std::string>& messages)
+  {
+    #ifdef _DEBUG
+      for (const std::string& message : messages)
+      {
+        ::OutputDebugStringA(message.c_str());
+        ::OutputDebugStringA("\n");
+      }
+    #else
+      (void)messages;
+    #endif
+  }
 }
 
 namespace MFramework
 {
   RootSignature::RootSignature()
     :m_rootSignature(nullptr)
+    , m_hash(0)
+    , m_serializedLayout()
+    , m_sizeInDWords(0)
   { }
   RootSignature::~RootSignature()
   {
     Dispose();
   }
-  void RootSignature::Init(ID3D12Device* device, D3D12_FILTER filter)
+  bool RootSignature::Init(RootSignatureCache& cache, D3D12_FILTER filter)
+  {
+    // バインドレスヒープ全体を一つのテーブルで見せる
+    // SRVとCBVの終わりのないレンジをどちらもヒープの先頭に重ね、シェーダーはインデックスで引く(t0, space1とb0, space1)
+    // テーブルはルートシグネチャーを設定したときに一回だけ設定すればよく、マテリアルごとに切り替えない
+    // (終わりのないレンジはリソースバインディングティア2以上が必要)
+    // サンプラーは線形補間などの指定をピクセルシェーダーから見える静的サンプラー(s0)で行う
+    StaticSampler sampler{};
+    sampler.Filter = static_cast<uint32_t>(filter);
+
+    RootSignatureBuilder builder;
+    builder.AddDescriptorTable(
+                                {
+                                  { DescriptorRangeType::SRV, DESCRIPTOR_RANGE_UNBOUNDED, 0, 1, 0 },   // テクスチャ(t0, space1)
+                                  { DescriptorRangeType::CBV, DESCRIPTOR_RANGE_UNBOUNDED, 0, 1, 0 },   // 定数(b0, space1)
+                                },
+                                ShaderVisibility::All                   // すべてのシェーダーから見える
+                              )
+           .AddShaderResourceView(0, 0, ShaderVisibility::Vertex)       // インスタンスデータ(t0)、描画のまとまりごとにアドレスを差し替える
+           .AddConstants(1, 0, 0, ShaderVisibility::All)                // フレームの定数バッファーのインデックス(b0)
+           .AddStaticSampler(sampler)
+           .SetFlags(static_cast<uint32_t>(ROOT_SIGNATURE_FLAGS));    // 「頂点情報（入力アセンブラ）がある」
+
+    return Init(cache, builder.GetLayout());
+  }
+
+  bool RootSignature::Init(RootSignatureCache& cache, const RootSignatureLayout& layout)
+  {
+    uint64_t hash = 0;
+    ID3D12RootSignature* rootSignature = cache.GetOrCreate(layout, &hash);
+    if (rootSignature == nullptr)
+    {
+      assert(false);
+      return false;
+    }
+
+    // キャッシュと参照を共有する
+    m_rootSignature = rootSignature;
+    m_hash = hash;
+    layout.Serialize(m_serializedLayout);
+    m_sizeInDWords = layout.GetSizeInDWords();
+
+    return true;
+  }
+
+  bool RootSignature::Init(ID3D12Device* device, const RootSignatureLayout& layout)
   {
     if (device == nullptr)
     {
-      return;
+      return false;
+    }
+
+    HRESULT result = Create(device, layout, m_rootSignature.ReleaseAndGetAddressOf());
+    if (FAILED(result))
+    {
+      assert(false);
+      return false;
+    }
+
+    layout.Serialize(m_serializedLayout);
+    m_hash = HashUtility::Fnv1a64(m_serializedLayout.data(), m_serializedLayout.size());
+    m_sizeInDWords = layout.GetSizeInDWords();
+
+    return true;
+  }
+
+  HRESULT RootSignature::Create(ID3D12Device* device, const RootSignatureLayout& layout, ID3D12RootSignature** outRootSignature)
+  {
+    if (device == nullptr || outRootSignature == nullptr)
+    {
+      return E_INVALIDARG;
+    }
+
+    // 上限を超えていれば作らない。高速パスを超えている場合は警告だけ出す
+    std::vector<std::string> messages;
+    const bool isValid = layout.Validate(&messages);
+    OutputMessages(messages);
+    if (!isValid)
+    {
+      return E_INVALIDARG;
+    }
+
+    // ルートパラメーター作成
+    // レンジはパラメーターから参照されるため、先にすべて確保しておく
+    std::vector<D3D12_DESCRIPTOR_RANGE> ranges;
+    for (const RootParameter& parameter : layout.Parameters)
+    {
+      for (const DescriptorRange& range : parameter.Ranges)
+      {
+        D3D12_DESCRIPTOR_RANGE d3dRange = {};
+        d3dRange.RangeType = static_cast<D3D12_DESCRIPTOR_RANGE_TYPE>(range.Type);
+        d3dRange.NumDescriptors = range.NumDescriptors;
+        d3dRange.BaseShaderRegister = range.BaseShaderRegister;
+        d3dRange.RegisterSpace = range.RegisterSpace;
+        d3dRange.OffsetInDescriptorsFromTableStart = range.OffsetInDescriptorsFromTableStart;   // APPENDなら前のレンジの直後に来る
+        ranges.emplace_back(d3dRange);
+      }
+    }
+
+    std::vector<D3D12_ROOT_PARAMETER> rootParams(layout.Parameters.size());
+    size_t rangeOffset = 0;
+    for (size_t i = 0; i < layout.Parameters.size(); ++i)
+    {
+      const RootParameter& parameter = layout.Parameters[i];
+      D3D12_ROOT_PARAMETER& rootParam = rootParams[i];
+
+      rootParam.ParameterType = static_cast<D3D12_ROOT_PARAMETER_TYPE>(parameter.Type);
+      rootParam.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(parameter.Visibility);
+
+      switch (parameter.Type)
+      {
+        case RootParameterType::DescriptorTable:
+        {
+          // ディスクリプタレンジのアドレスとレンジ数
+          rootParam.DescriptorTable.pDescriptorRanges = ranges.data() + rangeOffset;
+          rootParam.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(parameter.Ranges.size());
+          rangeOffset += parameter.Ranges.size();
+        }
+        break;
+
+        case RootParameterType::Constants:
+        {
+          rootParam.Constants.ShaderRegister = parameter.ShaderRegister;
+          rootParam.Constants.RegisterSpace = parameter.RegisterSpace;
+          rootParam.Constants.Num32BitValues = parameter.Num32BitValues;
+        }
+        break;
+
+        default:
+        {
+          rootParam.Descriptor.ShaderRegister = parameter.ShaderRegister;
+          rootParam.Descriptor.RegisterSpace = parameter.RegisterSpace;
+        }
+        break;
+      }
     }
-    // テクスチャ用
-    D3D12_DESCRIPTOR_RANGE ranges[2] = {};
-
-    ranges[0].NumDescriptors = 1;                                                          // テクスチャ１つ（ディスクリプタ数）
-    ranges[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;                                 // 種別はテクスチャ
-    ranges[0].BaseShaderRegister = 0;                                                      // 0番スロットから
-    ranges[0].RegisterSpace = 0;
-    ranges[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;    // 連続したディスクリプタレンジが前のディスクリプタレンジの直後に来る
-
-    // 定数用レジスター 0番
-    ranges[1].NumDescriptors = 1;                                                          // 定数１つ（ディスクリプタ数）
-    ranges[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_CBV;                                 // 種別は定数
-    ranges[1].BaseShaderRegister = 0;                                                      // 0番スロットから
-    ranges[1].RegisterSpace = 0;
-    ranges[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;    // 連続したディスクリプタレンジが前のディスクリプタレンジの直後に来る
-
-      // ルートパラメーター作成
-    D3D12_ROOT_PARAMETER rootParam = {};
-
-    // テクスチャと定数用
-    // シェーダーリソースビューと定数バッファービューが連続しており、またレンジも連続しているため、
-    // ルートパラメーター1つに対して[レンジが2つ]という指定を行えば、いっぺんに2つのレジスター設定ができ、切り替えコストも軽減できる
-    rootParam.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-    // ディスクリプタレンジのアドレス
-    rootParam.DescriptorTable.pDescriptorRanges = &ranges[0];
-    // ディスクリプタレンジ数
-    rootParam.DescriptorTable.NumDescriptorRanges = 2;
-    // すべてのシェーダーから見える
-    rootParam.ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
-
-    //   // ルートパラメーター作成
-    // D3D12_ROOT_PARAMETER rootParam[2] = {};
-
-    // // テクスチャ用
-    // // シェーダーリソースビューと定数バッファービューが連続しており、またレンジも連続しているため、
-    // // ルートパラメーター1つに対して[レンジが2つ]という指定を行えば、いっぺんに2つのレジスター設定ができ、切り替えコストも軽減できる
-    // rootParam[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-    // // ディスクリプタレンジのアドレス
-    // rootParam[0].DescriptorTable.pDescriptorRanges = &ranges[0];
-    // // ディスクリプタレンジ数
-    // rootParam[0].DescriptorTable.NumDescriptorRanges = 1;
-    // // すべてのシェーダーから見える
-    // rootParam[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
-
-    // // 定数用
-    // // シェーダーリソースビューと定数バッファービューが連続しており、またレンジも連続しているため、
-    // // ルートパラメーター1つに対して[レンジが2つ]という指定を行えば、いっぺんに2つのレジスター設定ができ、切り替えコストも軽減できる
-    // rootParam[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
-    // // ディスクリプタレンジのアドレス
-    // rootParam[1].DescriptorTable.pDescriptorRanges = &ranges[1];
-    // // ディスクリプタレンジ数
-    // rootParam[1].DescriptorTable.NumDescriptorRanges = 1;
-    // // すべてのシェーダーから見える
-    // rootParam[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
 
     // サンプラーを作成
-    D3D12_STATIC_SAMPLER_DESC samplerDesc = {};
-    samplerDesc.Filter = filter;                                                // D3D12_FILTER_MIN_MAG_MIP_LINEAR:線形補間
-    samplerDesc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;                     // 横方向の繰り返し
-    samplerDesc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;                     // 縦方向の繰り返し
-    samplerDesc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;                     // 奥行き方向の繰り返し
-    samplerDesc.MipLODBias = D3D12_DEFAULT_MIP_LOD_BIAS;                        // ??
-    samplerDesc.MaxAnisotropy = 1;                                              // ??
-    samplerDesc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;                   // リサンプリングしない
-    samplerDesc.BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;      // ボーダーは黒
-    samplerDesc.MinLOD = 0.0f;                                                  // ミップマップ最小値
-    samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;                                     // ミップマップ最大値
-    samplerDesc.ShaderRegister = 0;                                             // ??
-    samplerDesc.RegisterSpace = 0;                                              // ??
-    samplerDesc.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;               // ピクセルシェーダーから見える        
+    std::vector<D3D12_STATIC_SAMPLER_DESC> samplerDescs(layout.StaticSamplers.size());
+    for (size_t i = 0; i < samplerDescs.size(); ++i)
+    {
+      const StaticSampler& sampler = layout.StaticSamplers[i];
+      D3D12_STATIC_SAMPLER_DESC& samplerDesc = samplerDescs[i];
+
+      samplerDesc.Filter = static_cast<D3D12_FILTER>(sampler.Filter);                              // D3D12_FILTER_MIN_MAG_MIP_LINEAR:線形補間
+      samplerDesc.AddressU = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.AddressU);            // 横方向の繰り返し
+      samplerDesc.AddressV = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.AddressV);            // 縦方向の繰り返し
+      samplerDesc.AddressW = static_cast<D3D12_TEXTURE_ADDRESS_MODE>(sampler.AddressW);            // 奥行き方向の繰り返し
+      samplerDesc.MipLODBias = sampler.MipLODBias;
+      samplerDesc.MaxAnisotropy = sampler.MaxAnisotropy;
+      samplerDesc.ComparisonFunc = static_cast<D3D12_COMPARISON_FUNC>(sampler.ComparisonFunc);     // NEVER:リサンプリングしない
+      samplerDesc.BorderColor = static_cast<D3D12_STATIC_BORDER_COLOR>(sampler.BorderColor);
+      samplerDesc.MinLOD = sampler.MinLOD;                                                          // ミップマップ最小値
+      samplerDesc.MaxLOD = sampler.MaxLOD;                                                          // ミップマップ最大値
+      samplerDesc.ShaderRegister = sampler.ShaderRegister;
+      samplerDesc.RegisterSpace = sampler.RegisterSpace;
+      samplerDesc.ShaderVisibility = static_cast<D3D12_SHADER_VISIBILITY>(sampler.Visibility);
+    }
 
     // ルートシグネチャー作成
     // ディスクリプタテーブルをまとめたもの
     // 頂点情報以外のデータをパイプラインの外からシェーダーに送りこむために使われる
-    // 今回は頂点だけを流し込んで、それをそのまま表示するため、ルートシグネチャー情報は特に必要ないが
-    // 空のルートシグネチャーを設定しないとパイプラインステートは作れません
     D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc = {};
 
-    // Flagsに「頂点情報（入力アセンブラ）がある」という意味の値を設定
-    rootSignatureDesc.NumParameters = 1;            // ルートパラメーター数
-    rootSignatureDesc.pParameters = &rootParam;     // ルートパラメーターの先頭アドレス
-    rootSignatureDesc.NumStaticSamplers = 1;        
-    rootSignatureDesc.pStaticSamplers = &samplerDesc;
-    rootSignatureDesc.Flags = ROOT_SIGNATURE_FLAGS;
+    rootSignatureDesc.NumParameters = static_cast<UINT>(rootParams.size());      // ルートパラメーター数
+    rootSignatureDesc.pParameters = rootParams.data();                           // ルートパラメーターの先頭アドレス
+    rootSignatureDesc.NumStaticSamplers = static_cast<UINT>(samplerDescs.size());
+    rootSignatureDesc.pStaticSamplers = samplerDescs.data();
+    rootSignatureDesc.Flags = static_cast<D3D12_ROOT_SIGNATURE_FLAGS>(layout.Flags);
 
     HRESULT result = S_OK;
 
@@ -154,31 +258,23 @@ namespace MFramework
       {
         // result を出力
       }
-      assert(false);
-      return;
+      return result;
     }
 
     // ルートシグネチャーオブジェクト作成
-    result = device->CreateRootSignature(
-                                            0,      // nodemask 0でよい
-                                            rootSigBlob->GetBufferPointer(),
-                                            rootSigBlob->GetBufferSize(),
-                                            IID_PPV_ARGS(m_rootSignature.ReleaseAndGetAddressOf())
-                                         );
-    
-    if(FAILED(result))
-    {
-      assert(false);
-      return;
-    }
-
-    rootSigBlob->Release();
-    rootSigBlob.Reset();
-
+    return device->CreateRootSignature(
+                                        0,      // nodemask 0でよい
+                                        rootSigBlob->GetBufferPointer(),
+                                        rootSigBlob->GetBufferSize(),
+                                        IID_PPV_ARGS(outRootSignature)
+                                      );
   }
 
   void RootSignature::Dispose(void) noexcept
   {
     m_rootSignature.Reset();
+    m_hash = 0;
+    m_serializedLayout.clear();
+    m_sizeInDWords = 0;
   }
 }
\ No newline at end of file
@@ -0,0 +1,136 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Root signature cache (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Compare serialized layouts on hash hits
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/RootSignatureCache.h>
+#include <Graphics_DX12/RootSignature.h>
+#include <HashUtil.h>
+
+#include <d3d12.h>
+
+#include <cassert>
+
+namespace MFramework
+{
+  RootSignatureCache::RootSignatureCache()
+    : m_device(nullptr)
+    , m_entries()
+    , m_hitCount(0)
+    , m_mutex()
+  { }
+
+  RootSignatureCache::~RootSignatureCache()
+  {
+    Dispose();
+  }
+
+  bool RootSignatureCache::Init(ID3D12Device* device)
+  {
+    if (device == nullptr)
+    {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_device = device;
+    return true;
+  }
+
+  ID3D12RootSignature* RootSignatureCache::GetOrCreate(const RootSignatureLayout& layout, uint64_t* outHash)
+  {
+    // ComputeHashと同じく正規形からハッシュを求め、正規形はエントリーとの比較に使う
+    std::vector<uint8_t> serializedLayout;
+    layout.Serialize(serializedLayout);
+    const uint64_t hash = HashUtility::Fnv1a64(serializedLayout.data(), serializedLayout.size());
+    if (outHash != nullptr)
+    {
+      *outHash = hash;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_device == nullptr)
+    {
+      return nullptr;
+    }
+
+    auto it = m_entries.find(hash);
+    if (it != m_entries.end())
+    {
+      // ハッシュだけが同じ別のレイアウトなら、違うルートシグネチャーを返さない
+      if (it->second.SerializedLayout != serializedLayout)
+      {
+        #ifdef _DEBUG
+          ::OutputDebugStringA("RootSignatureCache : root signature layout hash collision\n");
+        #endif
+        assert(false && "RootSignatureCache : root signature layout hash collision");
+        return nullptr;
+      }
+
+      ++m_hitCount;
+      return it->second.RootSignature.Get();
+    }
+
+    // 作成はまれなのでロックを持ったまま行う(同じレイアウトを二重に作らないため)
+    Entry entry{};
+    HRESULT result = RootSignature::Create(m_device, layout, entry.RootSignature.ReleaseAndGetAddressOf());
+    if (FAILED(result))
+    {
+      return nullptr;
+    }
+
+    entry.SerializedLayout = std::move(serializedLayout);
+    entry.SizeInDWords = layout.GetSizeInDWords();
+    ID3D12RootSignature* rootSignature = entry.RootSignature.Get();
+    m_entries.emplace(hash, std::move(entry));
+
+    return rootSignature;
+  }
+
+  ID3D12RootSignature* RootSignatureCache::Find(uint64_t hash) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(hash);
+    return it != m_entries.end() ? it->second.RootSignature.Get() : nullptr;
+  }
+
+  uint32_t RootSignatureCache::GetSizeInDWords(uint64_t hash) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(hash);
+    return it != m_entries.end() ? it->second.SizeInDWords : 0;
+  }
+
+  size_t RootSignatureCache::GetCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+  }
+
+  uint64_t RootSignatureCache::GetHitCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hitCount;
+  }
+
+  void RootSignatureCache::Dispose() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hitCount = 0;
+    m_device = nullptr;
+  }
+}
@@ -0,0 +1,308 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Data-driven root signature layout and builder (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Unbounded descriptor ranges
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/RootSignatureLayout.h>
+#include <HashUtil.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+  // 正規形を変えたら上げる
+  constexpr uint32_t ROOT_SIGNATURE_FORM_VERSION = 1;
+  // ルートディスクリプタは64bitアドレス
+  constexpr uint32_t ROOT_DESCRIPTOR_DWORDS = 2;
+  constexpr uint32_t DESCRIPTOR_TABLE_DWORDS = 1;
+
+  template<typename T>
+  void Write(std::vector<uint8_t>& bytes, const T& value)
+  {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  template<typename... Args>
+  void AddMessage(std::vector<std::string>* messages, const char* format, Args... args)
+  {
+    if (messages == nullptr)
+    {
+      return;
+    }
+
+    char buffer[256] = {};
+    std::snprintf(buffer, sizeof(buffer), format, args...);
+    messages->emplace_back(buffer);
+  }
+}
+
+namespace MFramework
+{
+  void RootSignatureLayout::Serialize(std::vector<uint8_t>& outBytes) const
+  {
+    outBytes.clear();
+    outBytes.reserve(128);
+
+    Write(outBytes, ROOT_SIGNATURE_FORM_VERSION);
+    Write(outBytes, Flags);
+    Write(outBytes, static_cast<uint32_t>(Parameters.size()));
+
+    for (const RootParameter& parameter : Parameters)
+    {
+      Write(outBytes, static_cast<uint8_t>(parameter.Type));
+      Write(outBytes, static_cast<uint8_t>(parameter.Visibility));
+
+      switch (parameter.Type)
+      {
+        case RootParameterType::DescriptorTable:
+        {
+          Write(outBytes, static_cast<uint32_t>(parameter.Ranges.size()));
+
+          // APPENDを実際のオフセットに直す
+          uint32_t nextOffset = 0;
+          for (const DescriptorRange& range : parameter.Ranges)
+          {
+            const uint32_t offset = (range.OffsetInDescriptorsFromTableStart == DESCRIPTOR_RANGE_OFFSET_APPEND) ? nextOffset : range.OffsetInDescriptorsFromTableStart;
+
+            Write(outBytes, static_cast<uint8_t>(range.Type));
+            Write(outBytes, range.NumDescriptors);
+            Write(outBytes, range.BaseShaderRegister);
+            Write(outBytes, range.RegisterSpace);
+            Write(outBytes, offset);
+
+            nextOffset = offset + range.NumDescriptors;
+          }
+        }
+        break;
+
+        case RootParameterType::Constants:
+        {
+          Write(outBytes, parameter.ShaderRegister);
+          Write(outBytes, parameter.RegisterSpace);
+          Write(outBytes, parameter.Num32BitValues);
+        }
+        break;
+
+        default:
+        {
+          Write(outBytes, parameter.ShaderRegister);
+          Write(outBytes, parameter.RegisterSpace);
+        }
+        break;
+      }
+    }
+
+    // 静的サンプラーの順番は意味を持たないため並べ替える
+    std::vector<StaticSampler> samplers = StaticSamplers;
+    std::sort(
+              samplers.begin(),
+              samplers.end(),
+              [](const StaticSampler& lhs, const StaticSampler& rhs)
+              {
+                if (lhs.RegisterSpace != rhs.RegisterSpace)
+                {
+                  return lhs.RegisterSpace < rhs.RegisterSpace;
+                }
+
+                return lhs.ShaderRegister < rhs.ShaderRegister;
+              }
+            );
+
+    Write(outBytes, static_cast<uint32_t>(samplers.size()));
+    for (const StaticSampler& sampler : samplers)
+    {
+      Write(outBytes, sampler.Filter);
+      Write(outBytes, sampler.AddressU);
+      Write(outBytes, sampler.AddressV);
+      Write(outBytes, sampler.AddressW);
+      Write(outBytes, sampler.MipLODBias);
+      Write(outBytes, sampler.MaxAnisotropy);
+      Write(outBytes, sampler.ComparisonFunc);
+      Write(outBytes, sampler.BorderColor);
+      Write(outBytes, sampler.MinLOD);
+      Write(outBytes, sampler.MaxLOD);
+      Write(outBytes, sampler.ShaderRegister);
+      Write(outBytes, sampler.RegisterSpace);
+      Write(outBytes, static_cast<uint8_t>(sampler.Visibility));
+    }
+  }
+
+  uint64_t RootSignatureLayout::ComputeHash() const
+  {
+    std::vector<uint8_t> bytes;
+    Serialize(bytes);
+
+    return HashUtility::Fnv1a64(bytes.data(), bytes.size());
+  }
+
+  uint32_t RootSignatureLayout::GetSizeInDWords() const
+  {
+    uint32_t size = 0;
+
+    for (const RootParameter& parameter : Parameters)
+    {
+      switch (parameter.Type)
+      {
+        case RootParameterType::DescriptorTable:
+        {
+          size += DESCRIPTOR_TABLE_DWORDS;
+        }
+        break;
+
+        case RootParameterType::Constants:
+        {
+          size += parameter.Num32BitValues;
+        }
+        break;
+
+        default:
+        {
+          size += ROOT_DESCRIPTOR_DWORDS;
+        }
+        break;
+      }
+    }
+
+    return size;
+  }
+
+  bool RootSignatureLayout::Validate(std::vector<std::string>* outMessages) const
+  {
+    bool isValid = true;
+
+    const uint32_t size = GetSizeInDWords();
+    if (size > MAX_ROOT_SIGNATURE_DWORDS)
+    {
+      AddMessage(outMessages, "RootSignature error : size %u DWORDs exceeds the limit of %u DWORDs", size, MAX_ROOT_SIGNATURE_DWORDS);
+      isValid = false;
+    }
+    else if (size > ROOT_SIGNATURE_FAST_PATH_DWORDS)
+    {
+      AddMessage(outMessages, "RootSignature warning : size %u DWORDs exceeds the fast path of %u DWORDs", size, ROOT_SIGNATURE_FAST_PATH_DWORDS);
+    }
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(Parameters.size()); ++i)
+    {
+      const RootParameter& parameter = Parameters[i];
+      if (parameter.Type != RootParameterType::DescriptorTable)
+      {
+        continue;
+      }
+
+      if (parameter.Ranges.empty())
+      {
+        AddMessage(outMessages, "RootSignature error : parameter %u is an empty descriptor table", i);
+        isValid = false;
+        continue;
+      }
+
+      // サンプラーは他の種類と同じテーブルに置けない
+      const bool hasSampler = std::any_of(parameter.Ranges.begin(), parameter.Ranges.end(), [](const DescriptorRange& range) { return range.Type == DescriptorRangeType::Sampler; });
+      const bool hasView = std::any_of(parameter.Ranges.begin(), parameter.Ranges.end(), [](const DescriptorRange& range) { return range.Type != DescriptorRangeType::Sampler; });
+      if (hasSampler && hasView)
+      {
+        AddMessage(outMessages, "RootSignature error : parameter %u mixes samplers and views in one table", i);
+        isValid = false;
+      }
+
+      // 終わりのないレンジの後ろには続けられない
+      for (size_t rangeIndex = 1; rangeIndex < parameter.Ranges.size(); ++rangeIndex)
+      {
+        if (parameter.Ranges[rangeIndex - 1].NumDescriptors == DESCRIPTOR_RANGE_UNBOUNDED && parameter.Ranges[rangeIndex].OffsetInDescriptorsFromTableStart == DESCRIPTOR_RANGE_OFFSET_APPEND)
+        {
+          AddMessage(outMessages, "RootSignature error : parameter %u appends a range after an unbounded range", i);
+          isValid = false;
+        }
+      }
+    }
+
+    return isValid;
+  }
+
+  RootSignatureBuilder::RootSignatureBuilder()
+    : m_layout()
+  { }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddConstants(uint32_t num32BitValues, uint32_t shaderRegister, uint32_t registerSpace, ShaderVisibility visibility)
+  {
+    RootParameter parameter{};
+    parameter.Type = RootParameterType::Constants;
+    parameter.Visibility = visibility;
+    parameter.ShaderRegister = shaderRegister;
+    parameter.RegisterSpace = registerSpace;
+    parameter.Num32BitValues = num32BitValues;
+
+    m_layout.Parameters.emplace_back(std::move(parameter));
+    return *this;
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddConstantBufferView(uint32_t shaderRegister, uint32_t registerSpace, ShaderVisibility visibility)
+  {
+    return addRootDescriptor(RootParameterType::CBV, shaderRegister, registerSpace, visibility);
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddShaderResourceView(uint32_t shaderRegister, uint32_t registerSpace, ShaderVisibility visibility)
+  {
+    return addRootDescriptor(RootParameterType::SRV, shaderRegister, registerSpace, visibility);
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddUnorderedAccessView(uint32_t shaderRegister, uint32_t registerSpace, ShaderVisibility visibility)
+  {
+    return addRootDescriptor(RootParameterType::UAV, shaderRegister, registerSpace, visibility);
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddDescriptorTable(std::initializer_list<DescriptorRange> ranges, ShaderVisibility visibility)
+  {
+    return AddDescriptorTable(std::vector<DescriptorRange>(ranges), visibility);
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddDescriptorTable(const std::vector<DescriptorRange>& ranges, ShaderVisibility visibility)
+  {
+    RootParameter parameter{};
+    parameter.Type = RootParameterType::DescriptorTable;
+    parameter.Visibility = visibility;
+    parameter.Ranges = ranges;
+
+    m_layout.Parameters.emplace_back(std::move(parameter));
+    return *this;
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::AddStaticSampler(const StaticSampler& sampler)
+  {
+    m_layout.StaticSamplers.emplace_back(sampler);
+    return *this;
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::SetFlags(uint32_t flags)
+  {
+    m_layout.Flags = flags;
+    return *this;
+  }
+
+  RootSignatureBuilder& RootSignatureBuilder::addRootDescriptor(RootParameterType type, uint32_t shaderRegister, uint32_t registerSpace, ShaderVisibility visibility)
+  {
+    RootParameter parameter{};
+    parameter.Type = type;
+    parameter.Visibility = visibility;
+    parameter.ShaderRegister = shaderRegister;
+    parameter.RegisterSpace = registerSpace;
+
+    m_layout.Parameters.emplace_back(std::move(parameter));
+    return *this;
+  }
+}
@@ -0,0 +1,236 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : On-disk shader compilation cache (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Allow concurrent Store from builder threads
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderCompileCache.h>
+
+#include <HashUtil.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace
+{
+  namespace fs = std::filesystem;
+
+  constexpr uint32_t SHADER_CACHE_MAGIC = 0x4348534d;     // "MSHC"
+  constexpr uint32_t SHADER_CACHE_VERSION = 1;
+  // キーの計算方法を変えたら上げる
+  constexpr uint64_t SHADER_CACHE_KEY_VERSION = 1;
+  // 壊れたファイルで巨大な確保をしないための上限
+  constexpr uint64_t MAX_BYTECODE_SIZE = 64ull * 1024 * 1024;
+
+  struct ShaderCacheFileHeader
+  {
+    uint32_t Magic;
+    uint32_t Version;
+    uint64_t Key;
+    uint64_t Size;
+    uint64_t DataHash;
+  };
+
+  uint64_t HashString(const std::string& str, uint64_t seed)
+  {
+    // 長さも混ぜて"ab"+"c"と"a"+"bc"を区別する
+    seed = MFramework::HashUtility::HashValue(static_cast<uint64_t>(str.size()), seed);
+    return MFramework::HashUtility::Fnv1a64(str.data(), str.size(), seed);
+  }
+}
+
+namespace MFramework
+{
+  ShaderCompileCache::ShaderCompileCache()
+    : m_directory()
+    , m_includeGraph()
+    , m_hitCount(0)
+    , m_missCount(0)
+  { }
+
+  ShaderCompileCache::~ShaderCompileCache()
+  {
+    Dispose();
+  }
+
+  bool ShaderCompileCache::Init(const std::string& cacheDirectory)
+  {
+    if (cacheDirectory.empty())
+    {
+      return false;
+    }
+
+    std::error_code error;
+    fs::create_directories(cacheDirectory, error);
+    if (!fs::is_directory(cacheDirectory, error))
+    {
+      return false;
+    }
+
+    m_directory = cacheDirectory;
+    return true;
+  }
+
+  bool ShaderCompileCache::PrepareKey(const ShaderCompileDesc& desc, uint64_t& outKey, PreprocessedShader* outShader, std::string* outError)
+  {
+    PreprocessedShader shader{};
+    if (!ShaderPreprocessor::Preprocess(desc.SourcePath, desc.IncludeDirs, shader, outError))
+    {
+      return false;
+    }
+
+    std::error_code error;
+    const std::string sourceKey = fs::weakly_canonical(desc.SourcePath, error).generic_string();
+    m_includeGraph.Update(error ? fs::path(desc.SourcePath).lexically_normal().generic_string() : sourceKey, shader.Dependencies);
+
+    outKey = ComputeKey(desc, shader.SourceHash);
+    if (outShader != nullptr)
+    {
+      *outShader = std::move(shader);
+    }
+
+    return true;
+  }
+
+  uint64_t ShaderCompileCache::ComputeKey(const ShaderCompileDesc& desc, uint64_t sourceHash)
+  {
+    uint64_t hash = HashUtility::HashValue(SHADER_CACHE_KEY_VERSION);
+    hash = HashUtility::HashValue(sourceHash, hash);
+    hash = HashString(desc.EntryPoint, hash);
+    hash = HashString(desc.Target, hash);
+    hash = HashUtility::HashValue(desc.Flags, hash);
+
+    // 定義は名前順に並べて、指定順の違いでキーが変わらないようにする
+    std::vector<const ShaderDefine*> defines;
+    defines.reserve(desc.Defines.size());
+    for (const ShaderDefine& define : desc.Defines)
+    {
+      defines.emplace_back(&define);
+    }
+    std::stable_sort(defines.begin(), defines.end(), [](const ShaderDefine* a, const ShaderDefine* b)
+                                                     {
+                                                       return a->Name < b->Name;
+                                                     });
+
+    hash = HashUtility::HashValue(static_cast<uint64_t>(defines.size()), hash);
+    for (const ShaderDefine* define : defines)
+    {
+      hash = HashString(define->Name, hash);
+      hash = HashString(define->Value, hash);
+    }
+
+    return hash;
+  }
+
+  bool ShaderCompileCache::Find(uint64_t key, std::vector<uint8_t>& outBytecode)
+  {
+    if (m_directory.empty())
+    {
+      return false;
+    }
+
+    std::ifstream file(makeFilePath(key), std::ios::binary);
+    if (!file.is_open())
+    {
+      m_missCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    ShaderCacheFileHeader header{};
+    bool isValid = file.read(reinterpret_cast<char*>(&header), sizeof(header))
+                && (header.Magic == SHADER_CACHE_MAGIC)
+                && (header.Version == SHADER_CACHE_VERSION)
+                && (header.Key == key)
+                && (header.Size <= MAX_BYTECODE_SIZE);
+
+    if (isValid)
+    {
+      outBytecode.resize(static_cast<size_t>(header.Size));
+      isValid = file.read(reinterpret_cast<char*>(outBytecode.data()), static_cast<std::streamsize>(outBytecode.size()))
+             && (HashUtility::Fnv1a64(outBytecode.data(), outBytecode.size()) == header.DataHash);
+    }
+
+    if (!isValid)
+    {
+      outBytecode.clear();
+      m_missCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    m_hitCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool ShaderCompileCache::Store(uint64_t key, const void* data, size_t size)
+  {
+    if (m_directory.empty() || data == nullptr || size == 0 || size > MAX_BYTECODE_SIZE)
+    {
+      return false;
+    }
+
+    // 一時ファイルに書いてから置き換え、読み込み中に中途半端なファイルが見えないようにする
+    // 同じキーを複数スレッドが同時に保存することがあるため、一時ファイル名はスレッドごとに分ける
+    const std::string filePath = makeFilePath(key);
+    const std::string tempPath = filePath + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+      if (!file.is_open())
+      {
+        return false;
+      }
+
+      ShaderCacheFileHeader header{ SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key, static_cast<uint64_t>(size), HashUtility::Fnv1a64(data, size) };
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+      if (!file.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, filePath, error);
+    if (error)
+    {
+      fs::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  size_t ShaderCompileCache::CollectAffected(const std::string& changedPath, std::vector<std::string>& outSources) const
+  {
+    std::error_code error;
+    const std::string key = fs::weakly_canonical(changedPath, error).generic_string();
+    return m_includeGraph.CollectAffected(error ? changedPath : key, outSources);
+  }
+
+  void ShaderCompileCache::Dispose() noexcept
+  {
+    m_includeGraph.Dispose();
+    m_directory.clear();
+  }
+
+  std::string ShaderCompileCache::makeFilePath(uint64_t key) const
+  {
+    char fileName[32] = {};
+    std::snprintf(fileName, sizeof(fileName), "%016llx.shc", static_cast<unsigned long long>(key));
+
+    return (fs::path(m_directory) / fileName).string();
+  }
+}
@@ -0,0 +1,130 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Shader include dependency graph (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderIncludeGraph.h>
+
+namespace MFramework
+{
+  ShaderIncludeGraph::ShaderIncludeGraph()
+    : m_dependencies()
+    , m_dependents()
+    , m_mutex()
+  { }
+
+  ShaderIncludeGraph::~ShaderIncludeGraph()
+  {
+    Dispose();
+  }
+
+  void ShaderIncludeGraph::Update(const std::string& sourcePath, const std::vector<std::string>& dependencies)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    unlink(sourcePath);
+
+    // 依存はすべて展開済みで渡されるため、逆引きも一段で済む
+    for (const std::string& dependency : dependencies)
+    {
+      m_dependents[dependency].insert(sourcePath);
+    }
+    m_dependencies[sourcePath] = dependencies;
+  }
+
+  void ShaderIncludeGraph::Remove(const std::string& sourcePath)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    unlink(sourcePath);
+    m_dependencies.erase(sourcePath);
+  }
+
+  size_t ShaderIncludeGraph::CollectAffected(const std::string& changedPath, std::vector<std::string>& outSources) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t count = 0;
+    if (m_dependencies.count(changedPath) != 0)
+    {
+      outSources.emplace_back(changedPath);
+      ++count;
+    }
+
+    auto it = m_dependents.find(changedPath);
+    if (it != m_dependents.end())
+    {
+      for (const std::string& source : it->second)
+      {
+        if (source != changedPath)
+        {
+          outSources.emplace_back(source);
+          ++count;
+        }
+      }
+    }
+
+    return count;
+  }
+
+  bool ShaderIncludeGraph::GetDependencies(const std::string& sourcePath, std::vector<std::string>& outDependencies) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_dependencies.find(sourcePath);
+    if (it == m_dependencies.end())
+    {
+      return false;
+    }
+
+    outDependencies = it->second;
+    return true;
+  }
+
+  size_t ShaderIncludeGraph::GetSourceCount() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_dependencies.size();
+  }
+
+  void ShaderIncludeGraph::Dispose() noexcept
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_dependencies.clear();
+    m_dependents.clear();
+  }
+
+  void ShaderIncludeGraph::unlink(const std::string& sourcePath)
+  {
+    auto it = m_dependencies.find(sourcePath);
+    if (it == m_dependencies.end())
+    {
+      return;
+    }
+
+    for (const std::string& dependency : it->second)
+    {
+      auto dependentIt = m_dependents.find(dependency);
+      if (dependentIt == m_dependents.end())
+      {
+        continue;
+      }
+
+      dependentIt->second.erase(sourcePath);
+      if (dependentIt->second.empty())
+      {
+        m_dependents.erase(dependentIt);
+      }
+    }
+  }
+}
@@ -0,0 +1,140 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Memory-mapped packed shader library reader (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderLibrary.h>
+
+#include <HashUtil.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace MFramework
+{
+  ShaderLibrary::ShaderLibrary()
+    : m_file()
+    , m_entries(nullptr)
+    , m_entryCount(0)
+  { }
+
+  ShaderLibrary::~ShaderLibrary()
+  {
+    Dispose();
+  }
+
+  bool ShaderLibrary::Open(const std::string& filePath, bool isVerifyBytecode)
+  {
+    Dispose();
+
+    if (!m_file.Open(filePath))
+    {
+      return false;
+    }
+
+    if (m_file.GetSize() < sizeof(ShaderLibraryHeader))
+    {
+      Dispose();
+      return false;
+    }
+
+    ShaderLibraryHeader header{};
+    std::memcpy(&header, m_file.GetData(), sizeof(header));
+
+    // インデックスがファイル内に収まっているか
+    const uint64_t indexSize = static_cast<uint64_t>(header.EntryCount) * sizeof(ShaderLibraryEntry);
+    const bool isHeaderValid = (header.Magic == SHADER_LIBRARY_MAGIC)
+                            && (header.Version == SHADER_LIBRARY_VERSION)
+                            && (header.FileSize == m_file.GetSize())
+                            && (header.IndexOffset % alignof(ShaderLibraryEntry) == 0)
+                            && (header.IndexOffset <= header.FileSize)
+                            && (indexSize <= header.FileSize - header.IndexOffset);
+    if (!isHeaderValid)
+    {
+      Dispose();
+      return false;
+    }
+
+    // マップしたメモリはページ境界から始まるため、アライメント済みのインデックスはそのまま参照できる
+    m_entries = reinterpret_cast<const ShaderLibraryEntry*>(m_file.GetData() + header.IndexOffset);
+    m_entryCount = header.EntryCount;
+
+    if (!validate(isVerifyBytecode))
+    {
+      Dispose();
+      return false;
+    }
+
+    return true;
+  }
+
+  ShaderBytecodeView ShaderLibrary::Find(uint64_t key) const
+  {
+    if (m_entries == nullptr)
+    {
+      return { nullptr, 0 };
+    }
+
+    const ShaderLibraryEntry* end = m_entries + m_entryCount;
+    const ShaderLibraryEntry* it = std::lower_bound(m_entries, end, key, [](const ShaderLibraryEntry& entry, uint64_t value)
+                                                                         {
+                                                                           return entry.Key < value;
+                                                                         });
+    if (it == end || it->Key != key)
+    {
+      return { nullptr, 0 };
+    }
+
+    return { m_file.GetData() + it->Offset, static_cast<size_t>(it->Size) };
+  }
+
+  ShaderBytecodeView ShaderLibrary::Find(const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines) const
+  {
+    return Find(ShaderLibraryFormat::ComputeKey(shaderName, entryPoint, defines));
+  }
+
+  void ShaderLibrary::Dispose() noexcept
+  {
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_file.Dispose();
+  }
+
+  bool ShaderLibrary::validate(bool isVerifyBytecode) const
+  {
+    const uint64_t fileSize = static_cast<uint64_t>(m_file.GetSize());
+
+    for (uint32_t i = 0; i < m_entryCount; ++i)
+    {
+      const ShaderLibraryEntry& entry = m_entries[i];
+
+      // 二分探索のためにキーは昇順かつ重複なし
+      if (i > 0 && m_entries[i - 1].Key >= entry.Key)
+      {
+        return false;
+      }
+
+      if (entry.Offset > fileSize || entry.Size > fileSize - entry.Offset || entry.Offset % SHADER_LIBRARY_BLOB_ALIGNMENT != 0)
+      {
+        return false;
+      }
+
+      if (isVerifyBytecode && HashUtility::Fnv1a64(m_file.GetData() + entry.Offset, static_cast<size_t>(entry.Size)) != entry.BytecodeHash)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed shader library file format (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderLibraryFormat.h>
+
+#include <HashUtil.h>
+
+#include <algorithm>
+
+namespace
+{
+  uint64_t HashString(const std::string& str, uint64_t seed)
+  {
+    seed = MFramework::HashUtility::HashValue(static_cast<uint64_t>(str.size()), seed);
+    return MFramework::HashUtility::Fnv1a64(str.data(), str.size(), seed);
+  }
+}
+
+namespace MFramework
+{
+  uint64_t ShaderLibraryFormat::ComputeKey(const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines)
+  {
+    uint64_t hash = HashUtility::HashValue(SHADER_LIBRARY_VERSION);
+    hash = HashString(shaderName, hash);
+    hash = HashString(entryPoint, hash);
+
+    // 指定順の違いでキーが変わらないように名前順に並べる
+    std::vector<const ShaderDefine*> sortedDefines;
+    sortedDefines.reserve(defines.size());
+    for (const ShaderDefine& define : defines)
+    {
+      sortedDefines.emplace_back(&define);
+    }
+    std::stable_sort(sortedDefines.begin(), sortedDefines.end(), [](const ShaderDefine* a, const ShaderDefine* b)
+                                                                 {
+                                                                   return a->Name < b->Name;
+                                                                 });
+
+    hash = HashUtility::HashValue(static_cast<uint64_t>(sortedDefines.size()), hash);
+    for (const ShaderDefine* define : sortedDefines)
+    {
+      hash = HashString(define->Name, hash);
+      hash = HashString(define->Value, hash);
+    }
+
+    return hash;
+  }
+}
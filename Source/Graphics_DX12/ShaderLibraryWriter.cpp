@@ -0,0 +1,136 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed shader library writer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderLibraryWriter.h>
+
+#include <HashUtil.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  uint64_t AlignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+}
+
+namespace MFramework
+{
+  ShaderLibraryWriter::ShaderLibraryWriter()
+    : m_blobs()
+  { }
+
+  ShaderLibraryWriter::~ShaderLibraryWriter()
+  {
+    Dispose();
+  }
+
+  bool ShaderLibraryWriter::Add(uint64_t key, const void* data, size_t size)
+  {
+    if (data == nullptr || size == 0)
+    {
+      return false;
+    }
+
+    auto it = m_blobs.find(key);
+    if (it != m_blobs.end())
+    {
+      // 同じ内容なら重複として無視する
+      return (it->second.size() == size) && (std::memcmp(it->second.data(), data, size) == 0);
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_blobs.emplace(key, std::vector<uint8_t>(bytes, bytes + size));
+    return true;
+  }
+
+  bool ShaderLibraryWriter::WriteToFile(const std::string& filePath) const
+  {
+    // 配置を先に決める
+    std::vector<ShaderLibraryEntry> entries;
+    entries.reserve(m_blobs.size());
+
+    const uint64_t indexOffset = sizeof(ShaderLibraryHeader);
+    uint64_t offset = indexOffset + sizeof(ShaderLibraryEntry) * m_blobs.size();
+    for (const auto& [key, blob] : m_blobs)
+    {
+      offset = AlignUp(offset, SHADER_LIBRARY_BLOB_ALIGNMENT);
+
+      ShaderLibraryEntry entry{};
+      entry.Key = key;
+      entry.Offset = offset;
+      entry.Size = static_cast<uint64_t>(blob.size());
+      entry.BytecodeHash = HashUtility::Fnv1a64(blob.data(), blob.size());
+      entries.emplace_back(entry);
+
+      offset += entry.Size;
+    }
+
+    ShaderLibraryHeader header{};
+    header.Magic = SHADER_LIBRARY_MAGIC;
+    header.Version = SHADER_LIBRARY_VERSION;
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+    header.BlobAlignment = SHADER_LIBRARY_BLOB_ALIGNMENT;
+    header.IndexOffset = indexOffset;
+    header.FileSize = offset;
+
+    // 一時ファイルに書いてから置き換え、実行中のアプリが中途半端なファイルをマップしないようにする
+    const std::string tempPath = filePath + ".tmp";
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+      if (!file.is_open())
+      {
+        return false;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(ShaderLibraryEntry) * entries.size()));
+
+      static const char PADDING[SHADER_LIBRARY_BLOB_ALIGNMENT] = {};
+      uint64_t written = indexOffset + sizeof(ShaderLibraryEntry) * entries.size();
+      size_t entryIndex = 0;
+      for (const auto& [key, blob] : m_blobs)
+      {
+        const ShaderLibraryEntry& entry = entries[entryIndex++];
+        file.write(PADDING, static_cast<std::streamsize>(entry.Offset - written));
+        file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        written = entry.Offset + entry.Size;
+      }
+
+      if (!file.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error)
+    {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  void ShaderLibraryWriter::Dispose() noexcept
+  {
+    m_blobs.clear();
+  }
+}
@@ -0,0 +1,346 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline shader permutation builder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderPermutationBuilder.h>
+
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+
+namespace
+{
+  namespace fs = std::filesystem;
+
+  constexpr const char* ANNOTATION_PREFIX = "//!";
+  constexpr const char* SHADER_SOURCE_EXTENSION = ".hlsl";
+  // 組み合わせ爆発の歯止め
+  constexpr size_t MAX_PERMUTATIONS_PER_SOURCE = 4096;
+
+  void SplitWords(const std::string& line, std::vector<std::string>& outWords)
+  {
+    std::istringstream stream(line);
+    std::string word;
+    while (stream >> word)
+    {
+      outWords.emplace_back(word);
+    }
+  }
+}
+
+namespace MFramework
+{
+  ShaderPermutationBuilder::ShaderPermutationBuilder()
+    : m_sources()
+    , m_includeDirs()
+    , m_errors()
+    , m_cache(nullptr)
+    , m_stats()
+    , m_compileFlags(0)
+  { }
+
+  ShaderPermutationBuilder::~ShaderPermutationBuilder()
+  {
+    Dispose();
+  }
+
+  bool ShaderPermutationBuilder::ScanDirectory(const std::string& directory)
+  {
+    std::error_code error;
+    if (!fs::is_directory(directory, error))
+    {
+      m_errors.emplace_back("not a directory : " + directory);
+      return false;
+    }
+
+    // 出力を毎回同じにするためにパス順で処理する
+    std::vector<std::string> sourcePaths;
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+    {
+      if (it->is_regular_file(error) && it->path().extension() == SHADER_SOURCE_EXTENSION)
+      {
+        sourcePaths.emplace_back(it->path().generic_string());
+      }
+    }
+    std::sort(sourcePaths.begin(), sourcePaths.end());
+
+    bool isSucceeded = true;
+    for (const std::string& sourcePath : sourcePaths)
+    {
+      isSucceeded &= AddSource(sourcePath);
+    }
+
+    return isSucceeded;
+  }
+
+  bool ShaderPermutationBuilder::AddSource(const std::string& sourcePath)
+  {
+    std::string text;
+    if (!ShaderPreprocessor::ReadFile(sourcePath, text))
+    {
+      m_errors.emplace_back("cannot open : " + sourcePath);
+      return false;
+    }
+
+    ShaderSourceInfo info{};
+    std::string errorMessage;
+    if (!ParseAnnotations(text, info.Entries, info.Axes, &errorMessage))
+    {
+      m_errors.emplace_back(sourcePath + " : " + errorMessage);
+      return false;
+    }
+
+    // エントリーポイントの宣言がないファイルはビルド対象外
+    if (info.Entries.empty())
+    {
+      return true;
+    }
+
+    info.SourcePath = sourcePath;
+    info.ShaderName = fs::path(sourcePath).stem().string();
+    m_sources.emplace_back(std::move(info));
+
+    return true;
+  }
+
+  void ShaderPermutationBuilder::SetIncludeDirs(const std::vector<std::string>& includeDirs)
+  {
+    m_includeDirs = includeDirs;
+  }
+
+  void ShaderPermutationBuilder::SetCompileFlags(uint32_t flags)
+  {
+    m_compileFlags = flags;
+  }
+
+  void ShaderPermutationBuilder::SetCache(ShaderCompileCache* cache)
+  {
+    m_cache = cache;
+  }
+
+  bool ShaderPermutationBuilder::Build(const IShaderCompiler& compiler, ThreadPool* threadPool, ShaderLibraryWriter& outWriter)
+  {
+    m_stats = {};
+    m_stats.SourceCount = static_cast<uint32_t>(m_sources.size());
+
+    // ソースの前処理はパーミュテーションによらないので一回だけ行う
+    // (マクロを評価しないため、定義の違いはキーに別途混ぜる)
+    std::vector<PreprocessedShader> preprocessed(m_sources.size());
+    std::vector<std::string> preprocessErrors(m_sources.size());
+    std::vector<uint8_t> isPreprocessed(m_sources.size(), 0);
+    auto preprocess = [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        isPreprocessed[i] = ShaderPreprocessor::Preprocess(m_sources[i].SourcePath, m_includeDirs, preprocessed[i], &preprocessErrors[i]) ? 1 : 0;
+      }
+    };
+
+    if (threadPool != nullptr)
+    {
+      threadPool->ParallelFor(m_sources.size(), preprocess);
+    }
+    else
+    {
+      preprocess(0, m_sources.size());
+    }
+
+    // パーミュテーションを列挙する
+    std::vector<PermutationJob> jobs;
+    for (size_t sourceIndex = 0; sourceIndex < m_sources.size(); ++sourceIndex)
+    {
+      const ShaderSourceInfo& source = m_sources[sourceIndex];
+      if (isPreprocessed[sourceIndex] == 0)
+      {
+        m_errors.emplace_back(preprocessErrors[sourceIndex]);
+        m_stats.FailedCount += static_cast<uint32_t>(source.Entries.size());
+        continue;
+      }
+
+      std::vector<std::vector<ShaderDefine>> permutations;
+      ExpandPermutations(source.Axes, permutations);
+      if (permutations.size() > MAX_PERMUTATIONS_PER_SOURCE)
+      {
+        m_errors.emplace_back(source.SourcePath + " : too many permutations (" + std::to_string(permutations.size()) + ")");
+        m_stats.FailedCount += static_cast<uint32_t>(source.Entries.size());
+        continue;
+      }
+
+      for (const ShaderEntryDecl& entry : source.Entries)
+      {
+        for (const std::vector<ShaderDefine>& defines : permutations)
+        {
+          PermutationJob job{};
+          job.SourceIndex = sourceIndex;
+          job.Desc.SourcePath = source.SourcePath;
+          job.Desc.EntryPoint = entry.EntryPoint;
+          job.Desc.Target = entry.Target;
+          job.Desc.Defines = defines;
+          job.Desc.IncludeDirs = m_includeDirs;
+          job.Desc.Flags = m_compileFlags;
+          job.LibraryKey = ShaderLibraryFormat::ComputeKey(source.ShaderName, entry.EntryPoint, defines);
+          jobs.emplace_back(std::move(job));
+        }
+      }
+    }
+    m_stats.PermutationCount = static_cast<uint32_t>(jobs.size());
+
+    // コンパイル(一つ一つが重いのでチャンクは1件ずつ)
+    std::vector<JobResult> results(jobs.size());
+    auto compile = [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const PermutationJob& job = jobs[i];
+        JobResult& result = results[i];
+        const PreprocessedShader& shader = preprocessed[job.SourceIndex];
+
+        const uint64_t cacheKey = ShaderCompileCache::ComputeKey(job.Desc, shader.SourceHash);
+        if (m_cache != nullptr && m_cache->Find(cacheKey, result.Bytecode))
+        {
+          result.IsSucceeded = true;
+          result.IsCacheHit = true;
+          continue;
+        }
+
+        result.IsSucceeded = compiler.Compile(job.Desc, shader, result.Bytecode, result.Error);
+        if (result.IsSucceeded && m_cache != nullptr)
+        {
+          m_cache->Store(cacheKey, result.Bytecode.data(), result.Bytecode.size());
+        }
+      }
+    };
+
+    if (threadPool != nullptr)
+    {
+      threadPool->ParallelFor(jobs.size(), compile);
+    }
+    else
+    {
+      compile(0, jobs.size());
+    }
+
+    // 結果をライブラリに追加する(書き出しはキー順なので追加順は問わない)
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+      const PermutationJob& job = jobs[i];
+      JobResult& result = results[i];
+
+      if (!result.IsSucceeded)
+      {
+        m_errors.emplace_back(job.Desc.SourcePath + " (" + job.Desc.EntryPoint + ") : " + result.Error);
+        ++m_stats.FailedCount;
+        continue;
+      }
+
+      if (!outWriter.Add(job.LibraryKey, result.Bytecode.data(), result.Bytecode.size()))
+      {
+        m_errors.emplace_back(job.Desc.SourcePath + " (" + job.Desc.EntryPoint + ") : duplicate library key");
+        ++m_stats.FailedCount;
+        continue;
+      }
+
+      if (result.IsCacheHit)
+      {
+        ++m_stats.CacheHitCount;
+      }
+      else
+      {
+        ++m_stats.CompiledCount;
+      }
+    }
+
+    return m_stats.FailedCount == 0;
+  }
+
+  bool ShaderPermutationBuilder::ParseAnnotations(const std::string& source, std::vector<ShaderEntryDecl>& outEntries, std::vector<ShaderPermutationAxis>& outAxes, std::string* outError)
+  {
+    std::istringstream stream(source);
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+      ++lineNumber;
+
+      const size_t begin = line.find_first_not_of(" \t");
+      if (begin == std::string::npos || line.compare(begin, std::char_traits<char>::length(ANNOTATION_PREFIX), ANNOTATION_PREFIX) != 0)
+      {
+        continue;
+      }
+
+      std::vector<std::string> words;
+      SplitWords(line.substr(begin + std::char_traits<char>::length(ANNOTATION_PREFIX)), words);
+      if (words.empty())
+      {
+        continue;
+      }
+
+      if (words[0] == "shader" && words.size() == 3)
+      {
+        outEntries.push_back({ words[1], words[2] });
+      }
+      else if (words[0] == "permutation" && words.size() >= 3)
+      {
+        ShaderPermutationAxis axis{};
+        axis.Name = words[1];
+        axis.Values.assign(words.begin() + 2, words.end());
+        outAxes.emplace_back(std::move(axis));
+      }
+      else
+      {
+        if (outError != nullptr)
+        {
+          *outError = "line " + std::to_string(lineNumber) + " : invalid annotation : " + line.substr(begin);
+        }
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void ShaderPermutationBuilder::ExpandPermutations(const std::vector<ShaderPermutationAxis>& axes, std::vector<std::vector<ShaderDefine>>& outPermutations)
+  {
+    outPermutations.clear();
+    outPermutations.emplace_back();
+
+    // 軸ごとに今までの組み合わせを値の数だけ複製する
+    for (const ShaderPermutationAxis& axis : axes)
+    {
+      std::vector<std::vector<ShaderDefine>> expanded;
+      expanded.reserve(outPermutations.size() * axis.Values.size());
+      for (const std::vector<ShaderDefine>& permutation : outPermutations)
+      {
+        for (const std::string& value : axis.Values)
+        {
+          std::vector<ShaderDefine> defines = permutation;
+          defines.push_back({ axis.Name, value });
+          expanded.emplace_back(std::move(defines));
+        }
+      }
+      outPermutations = std::move(expanded);
+    }
+  }
+
+  void ShaderPermutationBuilder::Dispose() noexcept
+  {
+    m_sources.clear();
+    m_includeDirs.clear();
+    m_errors.clear();
+    m_cache = nullptr;
+    m_stats = {};
+  }
+}
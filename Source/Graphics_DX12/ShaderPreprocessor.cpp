@@ -0,0 +1,412 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : HLSL include expander for shader cache keys (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/ShaderPreprocessor.h>
+
+#include <HashUtil.h>
+
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+
+namespace
+{
+  namespace fs = std::filesystem;
+
+  // 深すぎるインクルードは循環とみなす
+  constexpr uint32_t MAX_INCLUDE_DEPTH = 32;
+
+  bool IsSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+  }
+
+  // コメントを空白に置き換える(改行は残すので行番号は変わらない)
+  std::string StripComments(const std::string& source)
+  {
+    std::string result;
+    result.reserve(source.size());
+
+    size_t i = 0;
+    while (i < source.size())
+    {
+      const char c = source[i];
+      const char next = (i + 1 < source.size()) ? source[i + 1] : '\0';
+
+      // 文字列リテラルはそのまま
+      if (c == '"')
+      {
+        result += c;
+        ++i;
+        while (i < source.size() && source[i] != '"' && source[i] != '\n')
+        {
+          if (source[i] == '\\' && i + 1 < source.size())
+          {
+            result += source[i++];
+          }
+          result += source[i++];
+        }
+        if (i < source.size() && source[i] == '"')
+        {
+          result += source[i++];
+        }
+      }
+      else if (c == '/' && next == '/')
+      {
+        while (i < source.size() && source[i] != '\n')
+        {
+          ++i;
+        }
+      }
+      else if (c == '/' && next == '*')
+      {
+        result += ' ';
+        i += 2;
+        while (i < source.size() && !(source[i] == '*' && (i + 1 < source.size()) && source[i + 1] == '/'))
+        {
+          if (source[i] == '\n')
+          {
+            result += '\n';
+          }
+          ++i;
+        }
+        i = (i < source.size()) ? i + 2 : i;
+      }
+      else
+      {
+        result += c;
+        ++i;
+      }
+    }
+
+    return result;
+  }
+
+  // 行を前後の空白を除き、連続する空白を一つにする
+  std::string NormalizeLine(const std::string& line)
+  {
+    std::string result;
+    result.reserve(line.size());
+
+    bool isPendingSpace = false;
+    bool isInString = false;
+    for (char c : line)
+    {
+      if (!isInString && IsSpace(c))
+      {
+        isPendingSpace = !result.empty();
+        continue;
+      }
+
+      if (isPendingSpace)
+      {
+        result += ' ';
+        isPendingSpace = false;
+      }
+
+      if (c == '"')
+      {
+        isInString = !isInString;
+      }
+      result += c;
+    }
+
+    return result;
+  }
+
+  // "#  include <x>"のような行から指令名を取り出す
+  bool ParseDirective(const std::string& line, std::string& outDirective, size_t& outArgsBegin)
+  {
+    size_t i = 0;
+    while (i < line.size() && IsSpace(line[i]))
+    {
+      ++i;
+    }
+    if (i >= line.size() || line[i] != '#')
+    {
+      return false;
+    }
+
+    ++i;
+    while (i < line.size() && IsSpace(line[i]))
+    {
+      ++i;
+    }
+
+    const size_t begin = i;
+    while (i < line.size() && (std::isalpha(static_cast<unsigned char>(line[i])) != 0))
+    {
+      ++i;
+    }
+
+    outDirective = line.substr(begin, i - begin);
+    outArgsBegin = i;
+    return true;
+  }
+
+  bool ParseInclude(const std::string& line, std::string& outName, bool& outIsSystem)
+  {
+    std::string directive;
+    size_t i = 0;
+    if (!ParseDirective(line, directive, i) || directive != "include")
+    {
+      return false;
+    }
+
+    while (i < line.size() && IsSpace(line[i]))
+    {
+      ++i;
+    }
+    if (i >= line.size())
+    {
+      return false;
+    }
+
+    const char open = line[i];
+    const char close = (open == '<') ? '>' : '"';
+    if (open != '<' && open != '"')
+    {
+      return false;
+    }
+
+    const size_t end = line.find(close, i + 1);
+    if (end == std::string::npos)
+    {
+      return false;
+    }
+
+    outName = line.substr(i + 1, end - i - 1);
+    outIsSystem = (open == '<');
+    return true;
+  }
+
+  bool IsPragmaOnce(const std::string& line)
+  {
+    std::string directive;
+    size_t i = 0;
+    if (!ParseDirective(line, directive, i) || directive != "pragma")
+    {
+      return false;
+    }
+
+    return NormalizeLine(line.substr(i)) == "once";
+  }
+
+  std::string ToKeyPath(const fs::path& path)
+  {
+    std::error_code error;
+    fs::path absolutePath = fs::weakly_canonical(path, error);
+    if (error)
+    {
+      absolutePath = fs::absolute(path, error).lexically_normal();
+    }
+
+    return absolutePath.generic_string();
+  }
+
+  struct ExpandContext
+  {
+    const std::vector<std::string>* IncludeDirs;
+    std::unordered_set<std::string> Visited;
+    std::vector<std::string> Stack;
+    MFramework::PreprocessedShader* Output;
+    std::string Error;
+  };
+
+  bool Expand(const fs::path& filePath, ExpandContext& context)
+  {
+    if (context.Stack.size() >= MAX_INCLUDE_DEPTH)
+    {
+      context.Error = "include depth exceeded : " + filePath.generic_string();
+      return false;
+    }
+
+    std::string text;
+    if (!MFramework::ShaderPreprocessor::ReadFile(filePath.string(), text))
+    {
+      context.Error = "cannot open : " + filePath.generic_string();
+      return false;
+    }
+
+    const std::string keyPath = ToKeyPath(filePath);
+    context.Stack.emplace_back(keyPath);
+
+    std::istringstream stream(StripComments(text));
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+      ++lineNumber;
+
+      std::string name;
+      bool isSystem = false;
+      if (ParseInclude(line, name, isSystem))
+      {
+        std::string includePath;
+        if (!MFramework::ShaderPreprocessor::ResolveInclude(name, isSystem, filePath.parent_path().string(), *context.IncludeDirs, includePath))
+        {
+          context.Error = filePath.generic_string() + "(" + std::to_string(lineNumber) + ") : include not found : " + name;
+          return false;
+        }
+
+        const std::string includeKey = ToKeyPath(includePath);
+        for (const std::string& parent : context.Stack)
+        {
+          if (parent == includeKey)
+          {
+            context.Error = filePath.generic_string() + "(" + std::to_string(lineNumber) + ") : circular include : " + name;
+            return false;
+          }
+        }
+
+        // 二回目以降のインクルードは展開しない(#pragma onceと同じ扱い)
+        if (context.Visited.insert(includeKey).second)
+        {
+          context.Output->Dependencies.emplace_back(includeKey);
+          if (!Expand(fs::path(includePath), context))
+          {
+            return false;
+          }
+        }
+        continue;
+      }
+
+      if (IsPragmaOnce(line))
+      {
+        continue;
+      }
+
+      std::string normalized = NormalizeLine(line);
+      if (!normalized.empty())
+      {
+        context.Output->Source += normalized;
+        context.Output->Source += '\n';
+      }
+    }
+
+    context.Stack.pop_back();
+    return true;
+  }
+}
+
+namespace MFramework
+{
+  bool ShaderPreprocessor::Preprocess(const std::string& sourcePath, const std::vector<std::string>& includeDirs, PreprocessedShader& outShader, std::string* outError)
+  {
+    outShader.Source.clear();
+    outShader.Dependencies.clear();
+    outShader.SourceHash = 0;
+
+    ExpandContext context{};
+    context.IncludeDirs = &includeDirs;
+    context.Output = &outShader;
+    context.Visited.insert(ToKeyPath(sourcePath));
+
+    if (!Expand(fs::path(sourcePath), context))
+    {
+      if (outError != nullptr)
+      {
+        *outError = context.Error;
+      }
+      return false;
+    }
+
+    outShader.SourceHash = HashUtility::Fnv1a64(outShader.Source.data(), outShader.Source.size());
+    return true;
+  }
+
+  void ShaderPreprocessor::ScanIncludes(const std::string& source, std::vector<ShaderIncludeDirective>& outIncludes)
+  {
+    std::istringstream stream(StripComments(source));
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(stream, line))
+    {
+      ++lineNumber;
+
+      ShaderIncludeDirective directive{};
+      if (ParseInclude(line, directive.Name, directive.IsSystem))
+      {
+        directive.Line = lineNumber;
+        outIncludes.emplace_back(std::move(directive));
+      }
+    }
+  }
+
+  std::string ShaderPreprocessor::Normalize(const std::string& source)
+  {
+    std::string result;
+    result.reserve(source.size());
+
+    std::istringstream stream(StripComments(source));
+    std::string line;
+    while (std::getline(stream, line))
+    {
+      std::string normalized = NormalizeLine(line);
+      if (!normalized.empty())
+      {
+        result += normalized;
+        result += '\n';
+      }
+    }
+
+    return result;
+  }
+
+  bool ShaderPreprocessor::ResolveInclude(const std::string& name, bool isSystem, const std::string& currentDir, const std::vector<std::string>& includeDirs, std::string& outPath)
+  {
+    std::error_code error;
+
+    // "..."はインクルードしたファイルのディレクトリを先に探す
+    if (!isSystem)
+    {
+      fs::path candidate = fs::path(currentDir) / name;
+      if (fs::is_regular_file(candidate, error))
+      {
+        outPath = candidate.string();
+        return true;
+      }
+    }
+
+    for (const std::string& dir : includeDirs)
+    {
+      fs::path candidate = fs::path(dir) / name;
+      if (fs::is_regular_file(candidate, error))
+      {
+        outPath = candidate.string();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool ShaderPreprocessor::ReadFile(const std::string& filePath, std::string& outText)
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+      return false;
+    }
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    outText = stream.str();
+
+    return true;
+  }
+}
@@ -6,6 +6,8 @@ Author : MAI ZHICONG
 Description : Shader Blob Wrapper (Graphics API: DirectX12)
 
 Update History: 2024/11/10 Create
+                2026/10/19 Compile through ShaderCompileCache
+                           Replace per-shader .cso lookup with ShaderLibrary
 
 Version : alpha_1.0.0
 
@@ -18,7 +20,12 @@ Encoding : UTF-8
 #include <d3d12.h>
 #include <d3dcompiler.h>
 
-#include <FileUtil.h>
+#include <Graphics_DX12/ShaderCompileCache.h>
+#include <Graphics_DX12/D3DShaderCompiler.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -27,12 +34,28 @@ namespace
   #else
     constexpr UINT SHADER_COMPILE_OPT = D3DCOMPILE_OPTIMIZATION_LEVEL3;  // 最高の最適化レベル
   #endif
+
+  void OutputCompileError(HRESULT result, ID3DBlob* error)
+  {
+    if (result == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+    {
+      ::OutputDebugStringW(L"*****ERROR***** ファイルが見当たりません。\n");
+    }
+    else
+    {
+      if (error != nullptr)
+      {
+        ::OutputDebugStringA(static_cast<char*>(error->GetBufferPointer()));
+      }
+    }
+  }
 }
 
 namespace MFramework
 {
   ShaderResBlob::ShaderResBlob()
     :m_shaderBlob(nullptr)
+    , m_bytecode()
   { }
 
   ShaderResBlob::~ShaderResBlob()
@@ -40,26 +63,17 @@ namespace MFramework
     Dispose();
   }
 
-  bool ShaderResBlob::InitFromCSO(const wchar_t* fileName)
+  bool ShaderResBlob::InitFromLibrary(const ShaderLibrary& library, const std::string& shaderName, const std::string& entryPoint, const std::vector<ShaderDefine>& defines)
   {
-    if (fileName == nullptr)
-    {
-      return false;
-    }
-
-    std::wstring destPath;
-    if (!Utility::FileUtility::SearchFilePath(fileName, destPath))
-    {
-      return false;
-    }
-
-    HRESULT result = D3DReadFileToBlob(destPath.c_str(), m_shaderBlob.ReleaseAndGetAddressOf());
-
-    if (FAILED(result))
+    // マップしたメモリを指すだけでコピーしない
+    ShaderBytecodeView bytecode = library.Find(shaderName, entryPoint, defines);
+    if (!bytecode.IsValid())
     {
       return false;
     }
 
+    m_shaderBlob.Reset();
+    m_bytecode = bytecode;
     return true;
   }
 
@@ -90,26 +104,89 @@ namespace MFramework
 
     if (FAILED(result))
     {
-      if (result == HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND))
+      OutputCompileError(result, error.Get());
+      return false;
+    }
+
+    m_bytecode = { m_shaderBlob->GetBufferPointer(), m_shaderBlob->GetBufferSize() };
+    return true;
+  }
+
+  bool ShaderResBlob::InitFromFile(const ShaderCompileDesc& desc, ShaderCompileCache* cache)
+  {
+    if (desc.SourcePath.empty() || desc.EntryPoint.empty() || desc.Target.empty())
+    {
+      return false;
+    }
+
+    // キャッシュにあればコンパイルしない
+    uint64_t key = 0;
+    bool hasKey = false;
+    if (cache != nullptr)
+    {
+      std::string errorMessage;
+      hasKey = cache->PrepareKey(desc, key, nullptr, &errorMessage);
+      if (!hasKey)
       {
-        ::OutputDebugStringW(L"*****ERROR***** ファイルが見当たりません。\n");
+        #ifdef _DEBUG
+          ::OutputDebugStringA((errorMessage + "\n").c_str());
+        #endif
       }
-      else
+    }
+
+    if (hasKey)
+    {
+      std::vector<uint8_t> bytecode;
+      if (cache->Find(key, bytecode) && InitFromMemory(bytecode.data(), bytecode.size()))
       {
-        if (error.Get() != nullptr)
-        {
-          ::OutputDebugStringA(static_cast<char*>(error->GetBufferPointer()));
-        }
+        return true;
       }
+    }
+
+    ComPtr<ID3DBlob> error = nullptr;
+    HRESULT result = D3DShaderCompiler::CompileToBlob(desc, m_shaderBlob.ReleaseAndGetAddressOf(), error.ReleaseAndGetAddressOf());
+
+    if (FAILED(result))
+    {
+      OutputCompileError(result, error.Get());
+      return false;
+    }
+
+    if (hasKey)
+    {
+      cache->Store(key, m_shaderBlob->GetBufferPointer(), m_shaderBlob->GetBufferSize());
+    }
+
+    m_bytecode = { m_shaderBlob->GetBufferPointer(), m_shaderBlob->GetBufferSize() };
+    return true;
+  }
 
+  bool ShaderResBlob::InitFromMemory(const void* data, size_t size)
+  {
+    if (data == nullptr || size == 0)
+    {
       return false;
     }
 
+    HRESULT result = D3DCreateBlob(size, m_shaderBlob.ReleaseAndGetAddressOf());
+    if (FAILED(result))
+    {
+      return false;
+    }
+
+    std::memcpy(m_shaderBlob->GetBufferPointer(), data, size);
+    m_bytecode = { m_shaderBlob->GetBufferPointer(), size };
     return true;
   }
 
+  uint32_t ShaderResBlob::GetDefaultCompileFlags()
+  {
+    return SHADER_COMPILE_OPT;
+  }
+
   void ShaderResBlob::Dispose() noexcept
   {
     m_shaderBlob.Reset();
+    m_bytecode = {};
   }
 }
\ No newline at end of file
@@ -6,6 +6,11 @@ Author : MAI ZHICONG
 Description : Texture of MRenderFramework (Graphics API: DirectX12)
 
 Update History: 2024/11/19
+                2026/10/19 Use resource state tracker for barriers
+                2026/10/19 Upload every subresource and make the SRV cover all mip levels
+                2026/10/19 Upload cooked textures (.mtex) with a single copy
+                2026/10/19 Load block-compressed textures from DDS files
+                2026/10/19 Upload DDS files straight from the mapped file
 
 Version : alpha_1.0.0
 
@@ -16,15 +21,61 @@ Encoding : UTF-8
 #include <Graphics_DX12/Texture.h>
 #include <Graphics_DX12/CommandList.h>
 #include <Graphics_DX12/Fence.h>
+#include <RenderSystem/CookedTextureFormat.h>
+#include <RenderSystem/DdsFormat.h>
+#include <RenderSystem/TextureFootprint.h>
 
+#include <Windows.h>
 #include <d3d12.h>
 #include <DirectXTex.h>
 
 #include <FileUtil.h>
-#include <D3D12EasyUtil.h>
+#include <MappedFile.h>
 
 #include <string>
+#include <vector>
 #include <cassert>
+#include <cstring>
+
+namespace
+{
+  constexpr const wchar_t* COOKED_TEXTURE_EXTENSION = L".mtex";
+  constexpr const wchar_t* DDS_TEXTURE_EXTENSION = L".dds";
+
+  bool hasExtension(const std::wstring& filePath, const wchar_t* extension)
+  {
+    const size_t extensionLength = std::char_traits<wchar_t>::length(extension);
+    return filePath.size() >= extensionLength &&
+           ::_wcsicmp(filePath.c_str() + filePath.size() - extensionLength, extension) == 0;
+  }
+
+  bool openMappedFile(const std::wstring& filePath, MFramework::MappedFile& outFile)
+  {
+    // MappedFileはUTF-8のパスを受け取る
+    const int length = ::WideCharToMultiByte(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0, nullptr, nullptr);
+    if (length <= 0)
+    {
+      return false;
+    }
+    std::string utf8Path(static_cast<size_t>(length), '\0');
+    ::WideCharToMultiByte(CP_UTF8, 0, filePath.c_str(), -1, utf8Path.data(), length, nullptr, nullptr);
+    utf8Path.pop_back();
+
+    return outFile.Open(utf8Path);
+  }
+
+  bool openCookedTexture(const std::wstring& filePath, MFramework::MappedFile& outFile, MFramework::CookedTextureView& outView)
+  {
+    std::string error;
+    return openMappedFile(filePath, outFile) && MFramework::CookedTextureFormat::Parse(outFile.GetData(), outFile.GetSize(), outView, error);
+  }
+
+  bool openDdsTexture(const std::wstring& filePath, MFramework::MappedFile& outFile, MFramework::DdsTextureView& outView)
+  {
+    std::string error;
+    return openMappedFile(filePath, outFile) && MFramework::DdsFormat::Parse(outFile.GetData(), outFile.GetSize(), outView, error);
+  }
+}
 
 namespace MFramework
 {
@@ -40,6 +91,7 @@ namespace MFramework
 
   Texture::Texture()
     : m_tex(nullptr)
+    , m_stateRegistry(nullptr)
   {}
 
   Texture::~Texture()
@@ -70,19 +122,79 @@ namespace MFramework
     TexMetadata metadata;
     ScratchImg scratchImg;
 
-    result = DirectX::LoadFromWICFile(                                          
-                                      filePath.c_str(),                 // ファイルパス
-                                      DirectX::WIC_FLAGS_NONE,         // どのようにロードするかを示すフラグ
-                                      &metadata,                       // メタデータ(DirectX::TexMetadata)を受け取るためのポインター
-                                      scratchImg                       // 実際のデータが入っているオブジェクト
-                                     ); 
-    
-    if (FAILED(result))
+    // TextureCookerで作った.mtexはアップロードバッファーと同じ配置で保存されている
+    const bool isCooked = hasExtension(filePath, COOKED_TEXTURE_EXTENSION);
+    MappedFile mappedFile;
+    CookedTextureView cookedView{};
+
+    // DDSはマップしたまま解析し、ScratchImageを経由せずにアップロードバッファーへコピーする
+    const bool isDds = hasExtension(filePath, DDS_TEXTURE_EXTENSION);
+    DdsTextureView ddsView{};
+    bool isMappedDds = false;
+
+    TextureDesc textureDesc{};
+    std::vector<SubresourceFootprint> footprints;
+    uint64_t uploadSize = 0;
+
+    if (isCooked)
     {
-      return false;
+      if (!openCookedTexture(filePath, mappedFile, cookedView))
+      {
+        return false;
+      }
+
+      textureDesc = cookedView.Header->Desc;
+      footprints.assign(cookedView.Footprints, cookedView.Footprints + cookedView.Header->SubresourceCount);
+      uploadSize = cookedView.Header->DataSize;
+    }
+    else
+    {
+      isMappedDds = isDds && openDdsTexture(filePath, mappedFile, ddsView);
+      if (isMappedDds)
+      {
+        textureDesc = ddsView.Desc;
+      }
+      else
+      {
+        mappedFile.Dispose();
+
+        if (isDds)
+        {
+          // 変換が必要な旧形式のDDSはDirectXTexに任せる
+          result = DirectX::LoadFromDDSFile(filePath.c_str(), DirectX::DDS_FLAGS_NONE, &metadata, scratchImg);
+        }
+        else
+        {
+          result = DirectX::LoadFromWICFile(                                          
+                                            filePath.c_str(),                 // ファイルパス
+                                            DirectX::WIC_FLAGS_NONE,         // どのようにロードするかを示すフラグ
+                                            &metadata,                       // メタデータ(DirectX::TexMetadata)を受け取るためのポインター
+                                            scratchImg                       // 実際のデータが入っているオブジェクト
+                                           ); 
+        }
+        
+        if (FAILED(result))
+        {
+          return false;
+        }
+
+        textureDesc.Width = static_cast<uint32_t>(metadata.width);
+        textureDesc.Height = static_cast<uint32_t>(metadata.height);
+        textureDesc.DepthOrArraySize = static_cast<uint32_t>(metadata.IsVolumemap() ? metadata.depth : metadata.arraySize);
+        textureDesc.MipLevels = static_cast<uint32_t>(metadata.mipLevels);
+        textureDesc.Format = static_cast<uint32_t>(metadata.format);
+        textureDesc.Dimension = static_cast<uint32_t>(metadata.dimension);
+      }
+
+      // すべてのサブリソースのアップロードバッファー内の配置を求める
+      // (行ピッチは256、サブリソースの先頭は512の倍数になる)
+      if (!TextureFootprint::Compute(textureDesc, footprints, &uploadSize))
+      {
+        return false;
+      }
     }
 
-    const DirectX::Image* img = scratchImg.GetImage(0, 0, 0);  // 生のデータ抽出
+    const DXGI_FORMAT format = static_cast<DXGI_FORMAT>(textureDesc.Format);
 
     // 中間バッファーとしてのアップロードヒープ設定
     D3D12_HEAP_PROPERTIES uploadHeapProp = {};
@@ -101,8 +213,8 @@ namespace MFramework
     // 単なるバッファーとして指定
     resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
     // rowPitchが変わったためバッファーのサイズも変更しなければならない
-    // アラインメントされたサイズ*高さとする必要がある
-    resDesc.Width = D3D12EasyUtility::AlignmentedSize(img->rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT) * img->height;    // データサイズ
+    // 全サブリソースをアラインメントされた配置で並べたサイズとする
+    resDesc.Width = uploadSize;    // データサイズ
     resDesc.Height = 1;
     resDesc.DepthOrArraySize = 1;
     resDesc.MipLevels = 1;
@@ -137,12 +249,12 @@ namespace MFramework
     texHeapProp.VisibleNodeMask = 0;
 
     // リソース設定 (変数使いまわし)
-    resDesc.Format = metadata.format;
-    resDesc.Width = static_cast<UINT64>(metadata.width);
-    resDesc.Height = static_cast<UINT>(metadata.height);
-    resDesc.DepthOrArraySize = static_cast<UINT16>(metadata.arraySize);    // 2D配列でもないので1
-    resDesc.MipLevels = static_cast<UINT16>(metadata.mipLevels);           // ミップマップしないためミップ数は1つ
-    resDesc.Dimension = static_cast<D3D12_RESOURCE_DIMENSION>(metadata.dimension);
+    resDesc.Format = format;
+    resDesc.Width = static_cast<UINT64>(textureDesc.Width);
+    resDesc.Height = static_cast<UINT>(textureDesc.Height);
+    resDesc.DepthOrArraySize = static_cast<UINT16>(textureDesc.DepthOrArraySize);    // 2D配列でもないので1
+    resDesc.MipLevels = static_cast<UINT16>(textureDesc.MipLevels);         // ファイルに含まれるミップ数
+    resDesc.Dimension = static_cast<D3D12_RESOURCE_DIMENSION>(textureDesc.Dimension);
     resDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
 
     result = device->CreateCommittedResource(
@@ -157,63 +269,87 @@ namespace MFramework
     {
       return false;
     }
+
+    // 作成時の状態をレジストリに登録する
+    m_stateRegistry = cmdList->GetStateTracker().GetRegistry();
+    if (m_stateRegistry != nullptr)
+    {
+      m_stateRegistry->Register(m_tex.Get(), static_cast<UINT32>(footprints.size()), D3D12_RESOURCE_STATE_COPY_DEST);
+    }
     
     // アップロードリソースへのマップ
     UINT8* mapforImg = nullptr; // img->pixelsと同じ型にする
     result = uploadBuffer->Map(0, nullptr, reinterpret_cast<void**>(&mapforImg));
 
-    // 元データをコピーする際に、元データのRowPitchとバッファーのRowPitchが合わないため、
-    // 一行ごとにコピーして行頭が合うようにする
-    UINT8* srcAddress = img->pixels;
-    size_t rowPitch = D3D12EasyUtility::AlignmentedSize(img->rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
-
-    for (int y = 0; y < img->height; ++y)
+    if (isCooked)
     {
-      std::copy_n(srcAddress, rowPitch, mapforImg);
-
-      // 一行ごとの辻褄を合わせる
-      srcAddress += img->rowPitch;
-      mapforImg += rowPitch;
+      // 配置済みなので一回のコピーで済む
+      std::memcpy(mapforImg, cookedView.Data, static_cast<size_t>(uploadSize));
+    }
+    else if (isMappedDds)
+    {
+      // マップしたファイルから行ピッチを合わせて直接コピーする
+      for (size_t i = 0; i < footprints.size(); ++i)
+      {
+        const SubresourceData& subresource = ddsView.Subresources[i];
+        TextureFootprint::CopySubresource(mapforImg, footprints[i], ddsView.Data + subresource.Offset, subresource.RowPitch, subresource.SlicePitch);
+      }
+    }
+    else
+    {
+      // 元データをコピーする際に、元データのRowPitchとバッファーのRowPitchが合わないため、
+      // 一行ごとにコピーして行頭が合うようにする
+      const size_t itemCount = metadata.IsVolumemap() ? 1 : metadata.arraySize;
+      for (size_t i = 0; i < footprints.size(); ++i)
+      {
+        const DirectX::Image* img = scratchImg.GetImage(i % metadata.mipLevels, i / metadata.mipLevels, 0);  // 生のデータ抽出
+        assert(img != nullptr && i / metadata.mipLevels < itemCount);
+        TextureFootprint::CopySubresource(mapforImg, footprints[i], img->pixels, img->rowPitch, img->slicePitch);
+      }
     }
+    mappedFile.Dispose();
 
     uploadBuffer->Unmap(0, nullptr); //アンマップ
 
     {
-      D3D12_TEXTURE_COPY_LOCATION src = {};
-      // コピー元(アップロード側)設定
-      src.pResource = uploadBuffer.Get();   // 中間バッファー
-      // D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINTの場合、pResourceはバッファーリソースを指す必要がある
-      // D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEXの場合、pResourceはテクスチャリソースを指す必要がある
-      src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;  // フットプリント指定
-      src.PlacedFootprint.Offset = 0;
-      src.PlacedFootprint.Footprint.Width = static_cast<UINT>(metadata.width);
-      src.PlacedFootprint.Footprint.Height = static_cast<UINT>(metadata.height);
-      src.PlacedFootprint.Footprint.Depth = static_cast<UINT>(metadata.depth);
-      // ここが重要
-      // RowPitchが256の倍数でないとCopyTextureRegionの実行は失敗する
-      // 256アライメントにする
-      src.PlacedFootprint.Footprint.RowPitch = static_cast<UINT>(D3D12EasyUtility::AlignmentedSize(img->rowPitch, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
-      src.PlacedFootprint.Footprint.Format = img->format;
-
-      D3D12_TEXTURE_COPY_LOCATION dst = {};
-
-      // コピー先設定
-      dst.pResource = m_tex.Get();
-      dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-      dst.SubresourceIndex = 0;
-      cmdList->Get()->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
-
-      D3D12_RESOURCE_BARRIER barrierDesc = {};
-
-      barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-      barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-      barrierDesc.Transition.pResource = m_tex.Get();
-      barrierDesc.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-      barrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;    // ここが重要
-      barrierDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE; // ここが重要
-
-      cmdList->Get()->ResourceBarrier(1, &barrierDesc);
-      cmdList->Get()->Close();
+      // コピー先として使うことを記録(作成時の状態と同じなのでバリアは出ない)
+      cmdList->Transition(m_tex.Get(), D3D12_RESOURCE_STATE_COPY_DEST);
+
+      for (size_t i = 0; i < footprints.size(); ++i)
+      {
+        D3D12_TEXTURE_COPY_LOCATION src = {};
+        // コピー元(アップロード側)設定
+        src.pResource = uploadBuffer.Get();   // 中間バッファー
+        // D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINTの場合、pResourceはバッファーリソースを指す必要がある
+        // D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEXの場合、pResourceはテクスチャリソースを指す必要がある
+        src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;  // フットプリント指定
+        src.PlacedFootprint.Offset = footprints[i].Offset;
+        src.PlacedFootprint.Footprint.Width = footprints[i].Width;
+        src.PlacedFootprint.Footprint.Height = footprints[i].Height;
+        src.PlacedFootprint.Footprint.Depth = footprints[i].Depth;
+        // ここが重要
+        // RowPitchが256の倍数でないとCopyTextureRegionの実行は失敗する
+        src.PlacedFootprint.Footprint.RowPitch = footprints[i].RowPitch;
+        src.PlacedFootprint.Footprint.Format = format;
+
+        D3D12_TEXTURE_COPY_LOCATION dst = {};
+
+        // コピー先設定
+        dst.pResource = m_tex.Get();
+        dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        dst.SubresourceIndex = static_cast<UINT>(i);
+
+        cmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+      }
+
+      cmdList->Transition(m_tex.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+      // 溜めたバリアを発行してクローズ
+      cmdList->Close();
+
+      // 作成直後でCOPY_DESTのはずなので、リストより前に実行すべきバリアはない
+      std::vector<ResourceTransition> pendingBarriers;
+      cmdList->ResolvePendingStates(pendingBarriers);
+      assert(pendingBarriers.empty());
 
       // コマンドリストの実行
       ID3D12CommandList* cmdLists[] = { cmdList->Get(),};
@@ -235,12 +371,12 @@ namespace MFramework
 
       auto desc = m_tex->GetDesc();
 
-      srvDesc.Format = metadata.format;                                               // RGBA(0.0f~1.0fに正規化)
+      srvDesc.Format = format;                                               // RGBA(0.0f~1.0fに正規化)
       srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;                      // 2Dテクスチャ
       srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING; // データのRGBAをどのようにマッピングするかということを指定するためのもの
                                                                                   // 画像の情報がそのままRGBAなど「指定されたフォーマットに、
                                                                                   // データどおりの順序で割り当てられている」ことを表しています。
-      srvDesc.Texture2D.MipLevels = 1;                                            // ミップマップは使用しないので１
+      srvDesc.Texture2D.MipLevels = desc.MipLevels;                               // ファイルに含まれるすべてのミップを使う
 
       // 三つ目の引数はディスクリプタヒープのどこにこのビューを配置するかを指定するためのもの
       // 複数のテクスチャビューがある場合、取得したハンドルからオフセットを指定する必要がある
@@ -264,6 +400,12 @@ namespace MFramework
 
   void Texture::Dispose() noexcept
   {
+    if (m_stateRegistry != nullptr)
+    {
+      m_stateRegistry->Unregister(m_tex.Get());
+      m_stateRegistry = nullptr;
+    }
+
     m_tex.Reset();
   }
 }
\ No newline at end of file
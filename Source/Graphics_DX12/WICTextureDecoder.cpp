@@ -0,0 +1,196 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : WIC texture decoder of texture streamer (Graphics API: DirectX12)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Generate mip chains at import
+                2026/10/19 Read cooked textures (.mtex) without WIC
+                2026/10/19 Read block-compressed textures from DDS files
+                2026/10/19 Parse DDS files without DirectXTex when possible
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Graphics_DX12/WICTextureDecoder.h>
+#include <RenderSystem/CookedTextureDecoder.h>
+#include <RenderSystem/DdsTextureDecoder.h>
+
+#include <Windows.h>
+#include <d3d12.h>
+#include <DirectXTex.h>
+
+#include <FileUtil.h>
+#include <MappedFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace
+{
+  constexpr const wchar_t* COOKED_TEXTURE_EXTENSION = L".mtex";
+  constexpr const wchar_t* DDS_TEXTURE_EXTENSION = L".dds";
+
+  bool hasExtension(const std::wstring& filePath, const wchar_t* extension)
+  {
+    const size_t extensionLength = std::char_traits<wchar_t>::length(extension);
+    return filePath.size() >= extensionLength &&
+           ::_wcsicmp(filePath.c_str() + filePath.size() - extensionLength, extension) == 0;
+  }
+}
+
+namespace MFramework
+{
+  WICTextureDecoder::WICTextureDecoder()
+    : m_mipDesc()
+    , m_threadPool(nullptr)
+    , m_isGenerateMips(false)
+  { }
+
+  void WICTextureDecoder::EnableMipGeneration(const MipGenerateDesc& desc, ThreadPool* threadPool)
+  {
+    m_mipDesc = desc;
+    m_threadPool = threadPool;
+    m_isGenerateMips = true;
+  }
+
+  bool WICTextureDecoder::Decode(const std::string& path, TextureData& outData, std::string& outError) const
+  {
+    // パスはUTF-8として扱う
+    const int length = ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (length <= 0)
+    {
+      outError = "invalid path " + path;
+      return false;
+    }
+    std::wstring widePath(static_cast<size_t>(length), L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), length);
+
+    std::wstring filePath;
+    if (!FileUtility::SearchFilePath(widePath.c_str(), filePath))
+    {
+      outError = "file not found " + path;
+      return false;
+    }
+
+    const bool isCooked = hasExtension(filePath, COOKED_TEXTURE_EXTENSION);
+    const bool isDds = hasExtension(filePath, DDS_TEXTURE_EXTENSION);
+    bool isParsedDds = false;
+    if (isCooked || isDds)
+    {
+      const int utf8Length = ::WideCharToMultiByte(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0, nullptr, nullptr);
+      std::string utf8Path(static_cast<size_t>(std::max(utf8Length, 1)), '\0');
+      ::WideCharToMultiByte(CP_UTF8, 0, filePath.c_str(), -1, utf8Path.data(), utf8Length, nullptr, nullptr);
+      utf8Path.pop_back();
+
+      MappedFile file;
+      if (!file.Open(utf8Path))
+      {
+        outError = "cannot open " + path;
+        return false;
+      }
+
+      // TextureCookerで作った.mtexはミップも配置も済んでいるのでそのまま読む
+      if (isCooked)
+      {
+        if (!CookedTextureDecoder::DecodeMemory(file.GetData(), file.GetSize(), outData, outError))
+        {
+          outError = "cannot read cooked texture " + path + " " + outError;
+          return false;
+        }
+
+        return true;
+      }
+
+      // DDSはマップしたまま解析してScratchImageを経由しない(変換が必要な旧形式だけDirectXTexに任せる)
+      std::string ddsError;
+      isParsedDds = DdsTextureDecoder::DecodeMemory(file.GetData(), file.GetSize(), outData, ddsError);
+    }
+
+    if (!isParsedDds)
+    {
+      DirectX::TexMetadata metadata{};
+      DirectX::ScratchImage scratchImg;
+      if (isDds)
+      {
+        // DDSはCOMを使わない
+        if (FAILED(DirectX::LoadFromDDSFile(filePath.c_str(), DirectX::DDS_FLAGS_NONE, &metadata, scratchImg)))
+        {
+          outError = "LoadFromDDSFile failed " + path;
+          return false;
+        }
+      }
+      else
+      {
+        // WICはCOMを使うため、ワーカースレッドでも初期化する
+        const HRESULT comResult = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+        // ミップを生成するときはグレースケールなども含めてRGBAで読む
+        const DirectX::WIC_FLAGS flags = m_isGenerateMips ? DirectX::WIC_FLAGS_FORCE_RGB : DirectX::WIC_FLAGS_NONE;
+        const HRESULT result = DirectX::LoadFromWICFile(filePath.c_str(), flags, &metadata, scratchImg);
+
+        if (SUCCEEDED(comResult))
+        {
+          ::CoUninitialize();
+        }
+
+        if (FAILED(result))
+        {
+          outError = "LoadFromWICFile failed " + path;
+          return false;
+        }
+      }
+
+      outData.Desc.Width = static_cast<uint32_t>(metadata.width);
+      outData.Desc.Height = static_cast<uint32_t>(metadata.height);
+      outData.Desc.DepthOrArraySize = static_cast<uint32_t>(metadata.IsVolumemap() ? metadata.depth : metadata.arraySize);
+      outData.Desc.MipLevels = static_cast<uint32_t>(metadata.mipLevels);
+      outData.Desc.Format = static_cast<uint32_t>(metadata.format);
+      outData.Desc.Dimension = static_cast<uint32_t>(metadata.dimension);
+
+      // ScratchImageのピクセルは一つの連続したバッファーなので、そのままコピーしてオフセットだけ記録する
+      const uint8_t* pixels = scratchImg.GetPixels();
+      outData.Pixels.assign(pixels, pixels + scratchImg.GetPixelsSize());
+
+      const size_t itemCount = metadata.IsVolumemap() ? 1 : metadata.arraySize;
+      outData.Subresources.clear();
+      outData.Subresources.reserve(itemCount * metadata.mipLevels);
+      for (size_t item = 0; item < itemCount; ++item)
+      {
+        for (size_t mip = 0; mip < metadata.mipLevels; ++mip)
+        {
+          const DirectX::Image* img = scratchImg.GetImage(mip, item, 0);
+          if (img == nullptr)
+          {
+            outError = "missing image " + path;
+            return false;
+          }
+
+          outData.Subresources.emplace_back(SubresourceData{ static_cast<uint64_t>(img->pixels - pixels), img->rowPitch, img->slicePitch });
+        }
+      }
+    }
+
+    if (m_isGenerateMips && outData.Desc.MipLevels == 1 && MipGenerator::IsSupportedFormat(outData.Desc.Format) &&
+        outData.Desc.Dimension != TEXTURE_DIMENSION_TEXTURE3D)
+    {
+      TextureData mipData{};
+      std::string mipError;
+      if (!MipGenerator::Generate(outData, m_mipDesc, mipData, mipError, m_threadPool))
+      {
+        outError = "mip generation failed " + path + " : " + mipError;
+        return false;
+      }
+
+      outData = std::move(mipData);
+    }
+
+    return true;
+  }
+}
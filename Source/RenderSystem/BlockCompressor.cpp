@@ -0,0 +1,1692 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU block compression encoder (BC1/BC3/BC5/BC7) (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 BC7 modes 4 and 5
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/BlockCompressor.h>
+#include <RenderSystem/TextureFootprint.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t FORMAT_R8G8B8A8_UNORM = 28;
+  constexpr uint32_t FORMAT_R8G8B8A8_UNORM_SRGB = 29;
+  constexpr uint32_t FORMAT_B8G8R8A8_UNORM = 87;
+  constexpr uint32_t FORMAT_B8G8R8A8_UNORM_SRGB = 91;
+  constexpr uint32_t FORMAT_BC1_UNORM = 71;
+  constexpr uint32_t FORMAT_BC1_UNORM_SRGB = 72;
+  constexpr uint32_t FORMAT_BC3_UNORM = 77;
+  constexpr uint32_t FORMAT_BC3_UNORM_SRGB = 78;
+  constexpr uint32_t FORMAT_BC5_UNORM = 83;
+  constexpr uint32_t FORMAT_BC7_UNORM = 98;
+  constexpr uint32_t FORMAT_BC7_UNORM_SRGB = 99;
+
+  constexpr uint32_t BLOCK_DIMENSION = 4;
+  constexpr uint32_t BLOCK_PIXEL_COUNT = 16;
+  constexpr uint32_t CHANNEL_COUNT = 4;
+  constexpr uint32_t BLOCK_ROWS_PER_CHUNK = 2;
+  constexpr uint8_t BC1_ALPHA_THRESHOLD = 128;
+
+  // BC7の2/3/4bitインデックスの補間の重み(/64)
+  constexpr uint32_t BC7_WEIGHTS2[4] = { 0, 21, 43, 64 };
+  constexpr uint32_t BC7_WEIGHTS3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+  constexpr uint32_t BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+  constexpr uint32_t BC7_MODE4 = 4;
+  constexpr uint32_t BC7_MODE5 = 5;
+  constexpr uint32_t BC7_MODE6 = 6;
+  constexpr uint32_t BC7_ROTATION_COUNT = 4;
+
+  ALIAS(uint8_t[BLOCK_PIXEL_COUNT][CHANNEL_COUNT], BlockPixels);
+
+  /// @brief
+  /// プリセットから決めた探索の量
+  struct EncodeSettings
+  {
+    uint32_t RefineIterations;    // 最小二乗法で端点を補正する回数
+    bool IsUsePrincipalAxis;      // 主成分方向から端点を求める(falseなら範囲の両端)
+    bool IsSearchAllPBits;        // BC7のpビットの組み合わせをすべて試す
+    bool IsTrySixValueMode;       // BC4の0/255を明示する6値モードも試す
+    bool IsPerturbEndpoints;      // BC1の丸めた端点を1ずつずらして誤差が減るか試す(BC7は効果が小さいので行わない)
+    uint32_t BC7ModeMask;         // 試すBC7のモード(1 << モード番号の組み合わせ、ブロックごとに誤差の小さいものを選ぶ)
+    bool IsSearchBC7Rotations;    // BC7モード4/5でアルファと入れ替えるチャンネルとモード4のインデックスの割り当てをすべて試す
+  };
+
+  EncodeSettings getEncodeSettings(MFramework::BlockCompressQuality quality)
+  {
+    switch (quality)
+    {
+      case MFramework::BlockCompressQuality::Fast:
+        return EncodeSettings{ 0, false, false, false, false, 1u << BC7_MODE6, false };
+      case MFramework::BlockCompressQuality::High:
+        return EncodeSettings{ 4, true, true, true, true, (1u << BC7_MODE4) | (1u << BC7_MODE5) | (1u << BC7_MODE6), true };
+      default:
+        return EncodeSettings{ 1, true, true, true, false, (1u << BC7_MODE5) | (1u << BC7_MODE6), false };
+    }
+  }
+
+  uint32_t getBlockBytes(uint32_t format)
+  {
+    return (format == FORMAT_BC1_UNORM || format == FORMAT_BC1_UNORM_SRGB) ? 8 : 16;
+  }
+
+  bool isSRGBFormat(uint32_t format)
+  {
+    return format == FORMAT_R8G8B8A8_UNORM_SRGB || format == FORMAT_B8G8R8A8_UNORM_SRGB;
+  }
+
+  bool isBGRAFormat(uint32_t format)
+  {
+    return format == FORMAT_B8G8R8A8_UNORM || format == FORMAT_B8G8R8A8_UNORM_SRGB;
+  }
+
+  int32_t clampInt(int32_t value, int32_t low, int32_t high)
+  {
+    return std::min(std::max(value, low), high);
+  }
+
+  /// @brief
+  /// LSBから詰めるビット書き込み
+  struct BitWriter
+  {
+    uint8_t* Data;
+    uint32_t Position;
+
+    void Write(uint32_t value, uint32_t bitCount)
+    {
+      for (uint32_t i = 0; i < bitCount; ++i, ++Position)
+      {
+        if ((value >> i) & 1)
+        {
+          Data[Position >> 3] |= static_cast<uint8_t>(1u << (Position & 7));
+        }
+      }
+    }
+  };
+
+  struct BitReader
+  {
+    const uint8_t* Data;
+    uint32_t Position;
+
+    uint32_t Read(uint32_t bitCount)
+    {
+      uint32_t value = 0;
+      for (uint32_t i = 0; i < bitCount; ++i, ++Position)
+      {
+        value |= static_cast<uint32_t>((Data[Position >> 3] >> (Position & 7)) & 1) << i;
+      }
+      return value;
+    }
+  };
+
+  #pragma region Endpoint Fitting
+
+  /// @brief
+  /// 点の集まりを通る直線の両端を求める
+  /// 主成分方向(共分散行列のべき乗法)に投影した最小値と最大値の位置を返す
+  void computeEndpoints(const float points[][CHANNEL_COUNT], uint32_t count, uint32_t channelCount, bool isUsePrincipalAxis, float outLow[CHANNEL_COUNT], float outHigh[CHANNEL_COUNT])
+  {
+    float minValue[CHANNEL_COUNT] = { 255.0f, 255.0f, 255.0f, 255.0f };
+    float maxValue[CHANNEL_COUNT] = {};
+    float mean[CHANNEL_COUNT] = {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        minValue[c] = std::min(minValue[c], points[i][c]);
+        maxValue[c] = std::max(maxValue[c], points[i][c]);
+        mean[c] += points[i][c];
+      }
+    }
+
+    if (!isUsePrincipalAxis)
+    {
+      // 両端は外れ値の影響を受けやすいので少し内側に寄せる
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        const float inset = (maxValue[c] - minValue[c]) / 16.0f;
+        outLow[c] = minValue[c] + inset;
+        outHigh[c] = maxValue[c] - inset;
+      }
+      return;
+    }
+
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      mean[c] /= static_cast<float>(count);
+    }
+
+    float covariance[CHANNEL_COUNT][CHANNEL_COUNT] = {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      for (uint32_t a = 0; a < channelCount; ++a)
+      {
+        const float da = points[i][a] - mean[a];
+        for (uint32_t b = a; b < channelCount; ++b)
+        {
+          covariance[a][b] += da * (points[i][b] - mean[b]);
+        }
+      }
+    }
+    for (uint32_t a = 0; a < channelCount; ++a)
+    {
+      for (uint32_t b = 0; b < a; ++b)
+      {
+        covariance[a][b] = covariance[b][a];
+      }
+    }
+
+    // 範囲の対角線から始めると少ない反復で収束する
+    float axis[CHANNEL_COUNT] = {};
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      axis[c] = maxValue[c] - minValue[c];
+    }
+
+    for (uint32_t iteration = 0; iteration < 8; ++iteration)
+    {
+      float next[CHANNEL_COUNT] = {};
+      float length = 0.0f;
+      for (uint32_t a = 0; a < channelCount; ++a)
+      {
+        for (uint32_t b = 0; b < channelCount; ++b)
+        {
+          next[a] += covariance[a][b] * axis[b];
+        }
+        length = std::max(length, std::fabs(next[a]));
+      }
+
+      if (length < 1e-6f)
+      {
+        break;
+      }
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        axis[c] = next[c] / length;
+      }
+    }
+
+    float lengthSquared = 0.0f;
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      lengthSquared += axis[c] * axis[c];
+    }
+
+    if (lengthSquared < 1e-12f)
+    {
+      // すべて同じ色
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        outLow[c] = mean[c];
+        outHigh[c] = mean[c];
+      }
+      return;
+    }
+
+    float minProjection = std::numeric_limits<float>::max();
+    float maxProjection = std::numeric_limits<float>::lowest();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      float projection = 0.0f;
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        projection += (points[i][c] - mean[c]) * axis[c];
+      }
+      minProjection = std::min(minProjection, projection);
+      maxProjection = std::max(maxProjection, projection);
+    }
+
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      outLow[c] = mean[c] + axis[c] * (minProjection / lengthSquared);
+      outHigh[c] = mean[c] + axis[c] * (maxProjection / lengthSquared);
+    }
+  }
+
+  /// @brief
+  /// 各点の補間位置(0なら端点A、1なら端点B)を固定して、誤差が最小になる端点を最小二乗法で求める
+  bool solveEndpoints(const float points[][CHANNEL_COUNT], const float* weights, uint32_t count, uint32_t channelCount, float outA[CHANNEL_COUNT], float outB[CHANNEL_COUNT])
+  {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float ax[CHANNEL_COUNT] = {};
+    float bx[CHANNEL_COUNT] = {};
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const float b = weights[i];
+      const float a = 1.0f - b;
+      aa += a * a;
+      ab += a * b;
+      bb += b * b;
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        ax[c] += a * points[i][c];
+        bx[c] += b * points[i][c];
+      }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f)
+    {
+      return false;
+    }
+
+    const float inverse = 1.0f / determinant;
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      outA[c] = std::clamp((bb * ax[c] - ab * bx[c]) * inverse, 0.0f, 255.0f);
+      outB[c] = std::clamp((aa * bx[c] - ab * ax[c]) * inverse, 0.0f, 255.0f);
+    }
+    return true;
+  }
+
+  #pragma endregion Endpoint Fitting
+
+  #pragma region BC1 Color Block
+
+  uint16_t packRGB565(const float color[CHANNEL_COUNT])
+  {
+    const uint32_t r = static_cast<uint32_t>(clampInt(static_cast<int32_t>(std::lround(color[0] * 31.0f / 255.0f)), 0, 31));
+    const uint32_t g = static_cast<uint32_t>(clampInt(static_cast<int32_t>(std::lround(color[1] * 63.0f / 255.0f)), 0, 63));
+    const uint32_t b = static_cast<uint32_t>(clampInt(static_cast<int32_t>(std::lround(color[2] * 31.0f / 255.0f)), 0, 31));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+  }
+
+  void unpackRGB565(uint16_t value, int32_t outColor[3])
+  {
+    const int32_t r = (value >> 11) & 31;
+    const int32_t g = (value >> 5) & 63;
+    const int32_t b = value & 31;
+    outColor[0] = (r << 3) | (r >> 2);
+    outColor[1] = (g << 2) | (g >> 4);
+    outColor[2] = (b << 3) | (b >> 2);
+  }
+
+  /// @brief
+  /// c0 > c1なら4色、それ以外は3色 + 透明の黒(BC2/BC3の色ブロックは常に4色)
+  void buildColorPalette(uint16_t color0, uint16_t color1, bool isFourColor, int32_t outPalette[4][3])
+  {
+    unpackRGB565(color0, outPalette[0]);
+    unpackRGB565(color1, outPalette[1]);
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+      if (isFourColor)
+      {
+        outPalette[2][c] = (2 * outPalette[0][c] + outPalette[1][c] + 1) / 3;
+        outPalette[3][c] = (outPalette[0][c] + 2 * outPalette[1][c] + 1) / 3;
+      }
+      else
+      {
+        outPalette[2][c] = (outPalette[0][c] + outPalette[1][c] + 1) / 2;
+        outPalette[3][c] = 0;
+      }
+    }
+  }
+
+  /// @brief
+  /// 各ピクセルに最も近いパレットの色を選び、誤差の二乗和を返す
+  /// 3色モードでは透明なピクセルにインデックス3を使う
+  uint32_t selectColorIndices(const BlockPixels& pixels, const int32_t palette[4][3], bool isFourColor, uint32_t transparentMask, uint8_t outIndices[BLOCK_PIXEL_COUNT])
+  {
+    const uint32_t paletteCount = isFourColor ? 4 : 3;
+    uint32_t totalError = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      if ((transparentMask >> i) & 1)
+      {
+        outIndices[i] = 3;
+        continue;
+      }
+
+      uint32_t bestError = std::numeric_limits<uint32_t>::max();
+      for (uint32_t p = 0; p < paletteCount; ++p)
+      {
+        uint32_t error = 0;
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+          const int32_t difference = palette[p][c] - pixels[i][c];
+          error += static_cast<uint32_t>(difference * difference);
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          outIndices[i] = static_cast<uint8_t>(p);
+        }
+      }
+      totalError += bestError;
+    }
+    return totalError;
+  }
+
+  struct ColorBlockCandidate
+  {
+    uint16_t Color0;
+    uint16_t Color1;
+    uint8_t Indices[BLOCK_PIXEL_COUNT];
+    uint32_t Error;
+  };
+
+  /// @brief
+  /// 565の端点をモードに合わせて並べてから評価する
+  ColorBlockCandidate evaluateColorCandidate(const BlockPixels& pixels, uint16_t color0, uint16_t color1, uint32_t transparentMask)
+  {
+    const bool isFourColor = (transparentMask == 0);
+    // 4色モードはc0 > c1、3色モードはc0 <= c1
+    if ((isFourColor && color0 < color1) || (!isFourColor && color0 > color1))
+    {
+      std::swap(color0, color1);
+    }
+
+    ColorBlockCandidate candidate{};
+    candidate.Color0 = color0;
+    candidate.Color1 = color1;
+
+    int32_t palette[4][3] = {};
+    buildColorPalette(color0, color1, isFourColor, palette);
+    if (isFourColor && color0 == color1)
+    {
+      // 同じ値だと3色モードとして読まれるため、端点そのものだけを使う
+      std::fill(std::begin(candidate.Indices), std::end(candidate.Indices), static_cast<uint8_t>(0));
+      candidate.Error = 0;
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+          const int32_t difference = palette[0][c] - pixels[i][c];
+          candidate.Error += static_cast<uint32_t>(difference * difference);
+        }
+      }
+      return candidate;
+    }
+
+    candidate.Error = selectColorIndices(pixels, palette, isFourColor, transparentMask, candidate.Indices);
+    return candidate;
+  }
+
+  /// @brief
+  /// 浮動小数の端点を565に丸めて評価する
+  ColorBlockCandidate evaluateColorEndpoints(const BlockPixels& pixels, const float low[CHANNEL_COUNT], const float high[CHANNEL_COUNT], uint32_t transparentMask)
+  {
+    return evaluateColorCandidate(pixels, packRGB565(high), packRGB565(low), transparentMask);
+  }
+
+  /// @brief
+  /// 端点の各チャンネルを1段階ずつずらし、誤差が減る限り繰り返す
+  void perturbColorEndpoints(const BlockPixels& pixels, uint32_t transparentMask, ColorBlockCandidate& best)
+  {
+    // 565の各フィールド(シフト量と最大値)
+    static constexpr uint32_t FIELD_SHIFTS[3] = { 11, 5, 0 };
+    static constexpr uint32_t FIELD_MAXIMUMS[3] = { 31, 63, 31 };
+
+    bool isImproved = true;
+    while (isImproved && best.Error > 0)
+    {
+      isImproved = false;
+      for (uint32_t endpoint = 0; endpoint < 2; ++endpoint)
+      {
+        for (uint32_t field = 0; field < 3; ++field)
+        {
+          for (int32_t step = -1; step <= 1; step += 2)
+          {
+            uint16_t colors[2] = { best.Color0, best.Color1 };
+            const int32_t value = static_cast<int32_t>((colors[endpoint] >> FIELD_SHIFTS[field]) & FIELD_MAXIMUMS[field]) + step;
+            if (value < 0 || value > static_cast<int32_t>(FIELD_MAXIMUMS[field]))
+            {
+              continue;
+            }
+
+            colors[endpoint] = static_cast<uint16_t>((colors[endpoint] & ~(FIELD_MAXIMUMS[field] << FIELD_SHIFTS[field])) | (static_cast<uint32_t>(value) << FIELD_SHIFTS[field]));
+            const ColorBlockCandidate candidate = evaluateColorCandidate(pixels, colors[0], colors[1], transparentMask);
+            if (candidate.Error < best.Error)
+            {
+              best = candidate;
+              isImproved = true;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void encodeColorBlock(const BlockPixels& pixels, const EncodeSettings& settings, bool isAllowTransparent, uint8_t* outBlock)
+  {
+    uint32_t transparentMask = 0;
+    float points[BLOCK_PIXEL_COUNT][CHANNEL_COUNT] = {};
+    uint32_t pointCount = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      if (isAllowTransparent && pixels[i][3] < BC1_ALPHA_THRESHOLD)
+      {
+        transparentMask |= 1u << i;
+        continue;
+      }
+      for (uint32_t c = 0; c < 3; ++c)
+      {
+        points[pointCount][c] = static_cast<float>(pixels[i][c]);
+      }
+      ++pointCount;
+    }
+
+    ColorBlockCandidate best{};
+    if (pointCount == 0)
+    {
+      // すべて透明(3色モードのインデックス3)
+      best.Color0 = 0;
+      best.Color1 = 0;
+      std::fill(std::begin(best.Indices), std::end(best.Indices), static_cast<uint8_t>(3));
+    }
+    else
+    {
+      float low[CHANNEL_COUNT] = {};
+      float high[CHANNEL_COUNT] = {};
+      computeEndpoints(points, pointCount, 3, settings.IsUsePrincipalAxis, low, high);
+      best = evaluateColorEndpoints(pixels, low, high, transparentMask);
+
+      const bool isFourColor = (transparentMask == 0);
+      for (uint32_t iteration = 0; iteration < settings.RefineIterations && best.Error > 0; ++iteration)
+      {
+        // インデックスを補間位置に直して端点を解き直す(c0側が0、c1側が1)
+        static constexpr float FOUR_COLOR_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+        static constexpr float THREE_COLOR_WEIGHTS[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+        float weights[BLOCK_PIXEL_COUNT] = {};
+        uint32_t weightCount = 0;
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+          if (((transparentMask >> i) & 1) == 0)
+          {
+            weights[weightCount++] = isFourColor ? FOUR_COLOR_WEIGHTS[best.Indices[i]] : THREE_COLOR_WEIGHTS[best.Indices[i]];
+          }
+        }
+
+        float color0[CHANNEL_COUNT] = {};
+        float color1[CHANNEL_COUNT] = {};
+        if (!solveEndpoints(points, weights, pointCount, 3, color0, color1))
+        {
+          break;
+        }
+
+        const ColorBlockCandidate refined = evaluateColorEndpoints(pixels, color1, color0, transparentMask);
+        if (refined.Error >= best.Error)
+        {
+          break;
+        }
+        best = refined;
+      }
+
+      if (settings.IsPerturbEndpoints)
+      {
+        perturbColorEndpoints(pixels, transparentMask, best);
+      }
+    }
+
+    outBlock[0] = static_cast<uint8_t>(best.Color0 & 0xff);
+    outBlock[1] = static_cast<uint8_t>(best.Color0 >> 8);
+    outBlock[2] = static_cast<uint8_t>(best.Color1 & 0xff);
+    outBlock[3] = static_cast<uint8_t>(best.Color1 >> 8);
+    uint32_t indexBits = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      indexBits |= static_cast<uint32_t>(best.Indices[i]) << (i * 2);
+    }
+    std::memcpy(outBlock + 4, &indexBits, sizeof(indexBits));
+  }
+
+  void decodeColorBlock(const uint8_t* block, bool isAllowThreeColor, BlockPixels& outPixels)
+  {
+    const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    const bool isFourColor = !isAllowThreeColor || color0 > color1;
+
+    int32_t palette[4][3] = {};
+    buildColorPalette(color0, color1, isFourColor, palette);
+
+    uint32_t indexBits = 0;
+    std::memcpy(&indexBits, block + 4, sizeof(indexBits));
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      const uint32_t index = (indexBits >> (i * 2)) & 3;
+      for (uint32_t c = 0; c < 3; ++c)
+      {
+        outPixels[i][c] = static_cast<uint8_t>(palette[index][c]);
+      }
+      outPixels[i][3] = (!isFourColor && index == 3) ? 0 : 255;
+    }
+  }
+
+  #pragma endregion BC1 Color Block
+
+  #pragma region BC4 Single Channel Block
+
+  /// @brief
+  /// a0 > a1なら8段階、それ以外は6段階 + 0 + 255
+  void buildSingleChannelPalette(uint8_t value0, uint8_t value1, int32_t outPalette[8])
+  {
+    outPalette[0] = value0;
+    outPalette[1] = value1;
+    if (value0 > value1)
+    {
+      for (int32_t k = 1; k <= 6; ++k)
+      {
+        outPalette[k + 1] = ((7 - k) * value0 + k * value1 + 3) / 7;
+      }
+    }
+    else
+    {
+      for (int32_t k = 1; k <= 4; ++k)
+      {
+        outPalette[k + 1] = ((5 - k) * value0 + k * value1 + 2) / 5;
+      }
+      outPalette[6] = 0;
+      outPalette[7] = 255;
+    }
+  }
+
+  struct SingleChannelCandidate
+  {
+    uint8_t Value0;
+    uint8_t Value1;
+    uint8_t Indices[BLOCK_PIXEL_COUNT];
+    uint32_t Error;
+  };
+
+  SingleChannelCandidate evaluateSingleChannel(const uint8_t values[BLOCK_PIXEL_COUNT], uint8_t value0, uint8_t value1)
+  {
+    SingleChannelCandidate candidate{};
+    candidate.Value0 = value0;
+    candidate.Value1 = value1;
+
+    int32_t palette[8] = {};
+    buildSingleChannelPalette(value0, value1, palette);
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      uint32_t bestError = std::numeric_limits<uint32_t>::max();
+      for (uint32_t p = 0; p < 8; ++p)
+      {
+        const int32_t difference = palette[p] - values[i];
+        const uint32_t error = static_cast<uint32_t>(difference * difference);
+        if (error < bestError)
+        {
+          bestError = error;
+          candidate.Indices[i] = static_cast<uint8_t>(p);
+        }
+      }
+      candidate.Error += bestError;
+    }
+    return candidate;
+  }
+
+  void encodeSingleChannelBlock(const uint8_t values[BLOCK_PIXEL_COUNT], const EncodeSettings& settings, uint8_t* outBlock)
+  {
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+    uint8_t innerMin = 255;       // 0と255を除いた範囲(6値モード用)
+    uint8_t innerMax = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      minValue = std::min(minValue, values[i]);
+      maxValue = std::max(maxValue, values[i]);
+      if (values[i] != 0 && values[i] != 255)
+      {
+        innerMin = std::min(innerMin, values[i]);
+        innerMax = std::max(innerMax, values[i]);
+      }
+    }
+
+    SingleChannelCandidate best = evaluateSingleChannel(values, maxValue, minValue);
+
+    if (settings.IsTrySixValueMode && best.Error > 0)
+    {
+      if (innerMin > innerMax)
+      {
+        innerMin = innerMax = 0;
+      }
+      const SingleChannelCandidate sixValue = evaluateSingleChannel(values, innerMin, innerMax);
+      if (sixValue.Error < best.Error)
+      {
+        best = sixValue;
+      }
+    }
+
+    // 8値モードだけ補間位置を固定して端点を解き直す
+    for (uint32_t iteration = 0; iteration < settings.RefineIterations && best.Error > 0 && best.Value0 > best.Value1; ++iteration)
+    {
+      static constexpr float WEIGHTS[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+      float points[BLOCK_PIXEL_COUNT][CHANNEL_COUNT] = {};
+      float weights[BLOCK_PIXEL_COUNT] = {};
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        points[i][0] = static_cast<float>(values[i]);
+        weights[i] = WEIGHTS[best.Indices[i]];
+      }
+
+      float value0[CHANNEL_COUNT] = {};
+      float value1[CHANNEL_COUNT] = {};
+      if (!solveEndpoints(points, weights, BLOCK_PIXEL_COUNT, 1, value0, value1))
+      {
+        break;
+      }
+
+      uint8_t rounded0 = static_cast<uint8_t>(std::lround(value0[0]));
+      uint8_t rounded1 = static_cast<uint8_t>(std::lround(value1[0]));
+      if (rounded0 < rounded1)
+      {
+        std::swap(rounded0, rounded1);
+      }
+      if (rounded0 == rounded1)
+      {
+        break;
+      }
+
+      const SingleChannelCandidate refined = evaluateSingleChannel(values, rounded0, rounded1);
+      if (refined.Error >= best.Error)
+      {
+        break;
+      }
+      best = refined;
+    }
+
+    outBlock[0] = best.Value0;
+    outBlock[1] = best.Value1;
+    uint64_t indexBits = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      indexBits |= static_cast<uint64_t>(best.Indices[i]) << (i * 3);
+    }
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+      outBlock[2 + i] = static_cast<uint8_t>(indexBits >> (i * 8));
+    }
+  }
+
+  void decodeSingleChannelBlock(const uint8_t* block, uint8_t outValues[BLOCK_PIXEL_COUNT])
+  {
+    int32_t palette[8] = {};
+    buildSingleChannelPalette(block[0], block[1], palette);
+
+    uint64_t indexBits = 0;
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+      indexBits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      outValues[i] = static_cast<uint8_t>(palette[(indexBits >> (i * 3)) & 7]);
+    }
+  }
+
+  #pragma endregion BC4 Single Channel Block
+
+  #pragma region BC7
+
+  // モード6 : 1サブセット、RGBA各7bit + 端点ごとのpビット、4bitインデックス
+  struct BC7Candidate
+  {
+    uint8_t Endpoints[2][CHANNEL_COUNT];    // 7bit
+    uint8_t PBits[2];
+    uint8_t Indices[BLOCK_PIXEL_COUNT];
+    uint32_t Error;
+  };
+
+  /// @brief
+  /// 7bitの端点とpビットからインデックスを選び、誤差を求める
+  void evaluateBC7Candidate(const BlockPixels& pixels, BC7Candidate& candidate)
+  {
+    int32_t endpoints[2][CHANNEL_COUNT] = {};
+    for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+    {
+      endpoints[0][c] = (candidate.Endpoints[0][c] << 1) | candidate.PBits[0];
+      endpoints[1][c] = (candidate.Endpoints[1][c] << 1) | candidate.PBits[1];
+    }
+
+    int32_t palette[16][CHANNEL_COUNT] = {};
+    for (uint32_t p = 0; p < 16; ++p)
+    {
+      for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+      {
+        palette[p][c] = ((64 - static_cast<int32_t>(BC7_WEIGHTS4[p])) * endpoints[0][c] + static_cast<int32_t>(BC7_WEIGHTS4[p]) * endpoints[1][c] + 32) >> 6;
+      }
+    }
+
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      uint32_t bestError = std::numeric_limits<uint32_t>::max();
+      for (uint32_t p = 0; p < 16; ++p)
+      {
+        uint32_t error = 0;
+        for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+        {
+          const int32_t difference = palette[p][c] - pixels[i][c];
+          error += static_cast<uint32_t>(difference * difference);
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          candidate.Indices[i] = static_cast<uint8_t>(p);
+        }
+      }
+      candidate.Error += bestError;
+    }
+  }
+
+  BC7Candidate evaluateBC7Endpoints(const BlockPixels& pixels, const float low[CHANNEL_COUNT], const float high[CHANNEL_COUNT], uint8_t pBit0, uint8_t pBit1)
+  {
+    BC7Candidate candidate{};
+    candidate.PBits[0] = pBit0;
+    candidate.PBits[1] = pBit1;
+    for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+    {
+      // pビットを固定して8bitの値に最も近い7bitを選ぶ
+      candidate.Endpoints[0][c] = static_cast<uint8_t>(clampInt(static_cast<int32_t>(std::lround((low[c] - pBit0) * 0.5f)), 0, 127));
+      candidate.Endpoints[1][c] = static_cast<uint8_t>(clampInt(static_cast<int32_t>(std::lround((high[c] - pBit1) * 0.5f)), 0, 127));
+    }
+
+    evaluateBC7Candidate(pixels, candidate);
+    return candidate;
+  }
+
+  BC7Candidate searchBC7PBits(const BlockPixels& pixels, const float low[CHANNEL_COUNT], const float high[CHANNEL_COUNT], const EncodeSettings& settings)
+  {
+    BC7Candidate best = evaluateBC7Endpoints(pixels, low, high, 0, 0);
+    const uint32_t combinationCount = settings.IsSearchAllPBits ? 4 : 2;
+    for (uint32_t combination = 1; combination < combinationCount && best.Error > 0; ++combination)
+    {
+      // Fastは(0,0)と(1,1)だけ
+      const uint8_t pBit0 = settings.IsSearchAllPBits ? static_cast<uint8_t>(combination & 1) : 1;
+      const uint8_t pBit1 = settings.IsSearchAllPBits ? static_cast<uint8_t>(combination >> 1) : 1;
+      const BC7Candidate candidate = evaluateBC7Endpoints(pixels, low, high, pBit0, pBit1);
+      if (candidate.Error < best.Error)
+      {
+        best = candidate;
+      }
+    }
+    return best;
+  }
+
+  BC7Candidate fitBC7Mode6(const BlockPixels& pixels, const EncodeSettings& settings)
+  {
+    float points[BLOCK_PIXEL_COUNT][CHANNEL_COUNT] = {};
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+      {
+        points[i][c] = static_cast<float>(pixels[i][c]);
+      }
+    }
+
+    float low[CHANNEL_COUNT] = {};
+    float high[CHANNEL_COUNT] = {};
+    computeEndpoints(points, BLOCK_PIXEL_COUNT, CHANNEL_COUNT, settings.IsUsePrincipalAxis, low, high);
+    BC7Candidate best = searchBC7PBits(pixels, low, high, settings);
+
+    for (uint32_t iteration = 0; iteration < settings.RefineIterations && best.Error > 0; ++iteration)
+    {
+      float weights[BLOCK_PIXEL_COUNT] = {};
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        weights[i] = static_cast<float>(BC7_WEIGHTS4[best.Indices[i]]) / 64.0f;
+      }
+
+      if (!solveEndpoints(points, weights, BLOCK_PIXEL_COUNT, CHANNEL_COUNT, low, high))
+      {
+        break;
+      }
+
+      const BC7Candidate refined = searchBC7PBits(pixels, low, high, settings);
+      if (refined.Error >= best.Error)
+      {
+        break;
+      }
+      best = refined;
+    }
+
+    return best;
+  }
+
+  void writeBC7Mode6(BC7Candidate best, uint8_t* outBlock)
+  {
+    // 最初のピクセルのインデックスは最上位ビットを省略するため、8未満になるよう端点を入れ替える
+    if (best.Indices[0] >= 8)
+    {
+      std::swap(best.Endpoints[0], best.Endpoints[1]);
+      std::swap(best.PBits[0], best.PBits[1]);
+      for (uint8_t& index : best.Indices)
+      {
+        index = static_cast<uint8_t>(15 - index);
+      }
+    }
+
+    std::memset(outBlock, 0, 16);
+    BitWriter writer{ outBlock, 0 };
+    writer.Write(1u << BC7_MODE6, BC7_MODE6 + 1);
+    for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+    {
+      writer.Write(best.Endpoints[0][c], 7);
+      writer.Write(best.Endpoints[1][c], 7);
+    }
+    writer.Write(best.PBits[0], 1);
+    writer.Write(best.PBits[1], 1);
+    writer.Write(best.Indices[0], 3);
+    for (uint32_t i = 1; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      writer.Write(best.Indices[i], 4);
+    }
+  }
+
+  // モード4/5 : 1サブセット、色(RGB)とアルファを別々の端点とインデックスで表す
+  //   モード4 : 色5bit、アルファ6bit、2bitと3bitのインデックス(どちらを色に使うかを選べる)
+  //   モード5 : 色7bit、アルファ8bit、2bitのインデックスを二組
+  // ローテーションでRGBのどれか一つとアルファを入れ替えてから符号化できる
+  struct BC7ComponentCandidate
+  {
+    uint8_t Endpoints[2][CHANNEL_COUNT];
+    uint8_t Indices[BLOCK_PIXEL_COUNT];
+    uint32_t Error;
+  };
+
+  struct BC7SeparateAlphaCandidate
+  {
+    uint32_t Mode;
+    uint32_t Rotation;
+    uint32_t IndexSelection;
+    BC7ComponentCandidate Color;
+    BC7ComponentCandidate Alpha;
+    uint32_t Error;
+  };
+
+  const uint32_t* getBC7Weights(uint32_t indexBits)
+  {
+    switch (indexBits)
+    {
+      case 2:
+        return BC7_WEIGHTS2;
+      case 3:
+        return BC7_WEIGHTS3;
+      default:
+        return BC7_WEIGHTS4;
+    }
+  }
+
+  int32_t expandBC7Endpoint(uint32_t value, uint32_t endpointBits)
+  {
+    // 上位ビットを下に繰り返して8bitにする
+    const uint32_t shifted = value << (8 - endpointBits);
+    return static_cast<int32_t>(shifted | (shifted >> endpointBits));
+  }
+
+  /// @brief
+  /// 量子化した端点からインデックスを選び、誤差を求める
+  /// @param firstChannel ブロックのピクセルで使う最初のチャンネル(色は0、アルファは3)
+  void evaluateBC7Component(const BlockPixels& pixels, uint32_t firstChannel, uint32_t channelCount, uint32_t endpointBits, uint32_t indexBits, BC7ComponentCandidate& candidate)
+  {
+    const uint32_t* weights = getBC7Weights(indexBits);
+    const uint32_t paletteCount = 1u << indexBits;
+    int32_t palette[8][CHANNEL_COUNT] = {};
+    for (uint32_t p = 0; p < paletteCount; ++p)
+    {
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        const int32_t endpoint0 = expandBC7Endpoint(candidate.Endpoints[0][c], endpointBits);
+        const int32_t endpoint1 = expandBC7Endpoint(candidate.Endpoints[1][c], endpointBits);
+        palette[p][c] = ((64 - static_cast<int32_t>(weights[p])) * endpoint0 + static_cast<int32_t>(weights[p]) * endpoint1 + 32) >> 6;
+      }
+    }
+
+    candidate.Error = 0;
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      uint32_t bestError = std::numeric_limits<uint32_t>::max();
+      for (uint32_t p = 0; p < paletteCount; ++p)
+      {
+        uint32_t error = 0;
+        for (uint32_t c = 0; c < channelCount; ++c)
+        {
+          const int32_t difference = palette[p][c] - pixels[i][firstChannel + c];
+          error += static_cast<uint32_t>(difference * difference);
+        }
+        if (error < bestError)
+        {
+          bestError = error;
+          candidate.Indices[i] = static_cast<uint8_t>(p);
+        }
+      }
+      candidate.Error += bestError;
+    }
+  }
+
+  BC7ComponentCandidate quantizeBC7Component(const BlockPixels& pixels, uint32_t firstChannel, uint32_t channelCount, uint32_t endpointBits, uint32_t indexBits, const float low[CHANNEL_COUNT], const float high[CHANNEL_COUNT])
+  {
+    const int32_t maxValue = (1 << endpointBits) - 1;
+    const float scale = static_cast<float>(maxValue) / 255.0f;
+    BC7ComponentCandidate candidate{};
+    for (uint32_t c = 0; c < channelCount; ++c)
+    {
+      candidate.Endpoints[0][c] = static_cast<uint8_t>(clampInt(static_cast<int32_t>(std::lround(low[c] * scale)), 0, maxValue));
+      candidate.Endpoints[1][c] = static_cast<uint8_t>(clampInt(static_cast<int32_t>(std::lround(high[c] * scale)), 0, maxValue));
+    }
+
+    evaluateBC7Component(pixels, firstChannel, channelCount, endpointBits, indexBits, candidate);
+    return candidate;
+  }
+
+  /// @brief
+  /// 色またはアルファの端点をモード6と同じ手順(主成分分析と最小二乗法の補正)で求める
+  BC7ComponentCandidate fitBC7Component(const BlockPixels& pixels, uint32_t firstChannel, uint32_t channelCount, uint32_t endpointBits, uint32_t indexBits, const EncodeSettings& settings)
+  {
+    float points[BLOCK_PIXEL_COUNT][CHANNEL_COUNT] = {};
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        points[i][c] = static_cast<float>(pixels[i][firstChannel + c]);
+      }
+    }
+
+    float low[CHANNEL_COUNT] = {};
+    float high[CHANNEL_COUNT] = {};
+    computeEndpoints(points, BLOCK_PIXEL_COUNT, channelCount, settings.IsUsePrincipalAxis, low, high);
+    BC7ComponentCandidate best = quantizeBC7Component(pixels, firstChannel, channelCount, endpointBits, indexBits, low, high);
+
+    const uint32_t* weightTable = getBC7Weights(indexBits);
+    for (uint32_t iteration = 0; iteration < settings.RefineIterations && best.Error > 0; ++iteration)
+    {
+      float weights[BLOCK_PIXEL_COUNT] = {};
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        weights[i] = static_cast<float>(weightTable[best.Indices[i]]) / 64.0f;
+      }
+
+      if (!solveEndpoints(points, weights, BLOCK_PIXEL_COUNT, channelCount, low, high))
+      {
+        break;
+      }
+
+      const BC7ComponentCandidate refined = quantizeBC7Component(pixels, firstChannel, channelCount, endpointBits, indexBits, low, high);
+      if (refined.Error >= best.Error)
+      {
+        break;
+      }
+      best = refined;
+    }
+
+    return best;
+  }
+
+  BC7SeparateAlphaCandidate fitBC7SeparateAlpha(const BlockPixels& pixels, uint32_t mode, uint32_t rotation, uint32_t indexSelection, const EncodeSettings& settings)
+  {
+    // ローテーションしたピクセルを符号化する(誤差は入れ替えても変わらない)
+    BlockPixels rotated = {};
+    std::memcpy(rotated, pixels, sizeof(BlockPixels));
+    if (rotation != 0)
+    {
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        std::swap(rotated[i][rotation - 1], rotated[i][3]);
+      }
+    }
+
+    const bool isMode4 = (mode == BC7_MODE4);
+    const uint32_t colorIndexBits = (isMode4 && indexSelection != 0) ? 3 : 2;
+    const uint32_t alphaIndexBits = (isMode4 && indexSelection == 0) ? 3 : 2;
+
+    BC7SeparateAlphaCandidate candidate{};
+    candidate.Mode = mode;
+    candidate.Rotation = rotation;
+    candidate.IndexSelection = indexSelection;
+    candidate.Color = fitBC7Component(rotated, 0, 3, isMode4 ? 5 : 7, colorIndexBits, settings);
+    candidate.Alpha = fitBC7Component(rotated, 3, 1, isMode4 ? 6 : 8, alphaIndexBits, settings);
+    candidate.Error = candidate.Color.Error + candidate.Alpha.Error;
+    return candidate;
+  }
+
+  /// @brief
+  /// 最初のピクセルのインデックスの最上位ビットが0になるよう端点を入れ替えて書き込む
+  void writeBC7Indices(BitWriter& writer, BC7ComponentCandidate& component, uint32_t channelCount, uint32_t indexBits)
+  {
+    const uint32_t maxIndex = (1u << indexBits) - 1;
+    if (component.Indices[0] > (maxIndex >> 1))
+    {
+      for (uint32_t c = 0; c < channelCount; ++c)
+      {
+        std::swap(component.Endpoints[0][c], component.Endpoints[1][c]);
+      }
+      for (uint8_t& index : component.Indices)
+      {
+        index = static_cast<uint8_t>(maxIndex - index);
+      }
+    }
+
+    writer.Write(component.Indices[0], indexBits - 1);
+    for (uint32_t i = 1; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      writer.Write(component.Indices[i], indexBits);
+    }
+  }
+
+  void writeBC7SeparateAlpha(BC7SeparateAlphaCandidate best, uint8_t* outBlock)
+  {
+    const bool isMode4 = (best.Mode == BC7_MODE4);
+    const uint32_t colorBits = isMode4 ? 5 : 7;
+    const uint32_t alphaBits = isMode4 ? 6 : 8;
+
+    // インデックスの並べ替えで端点が入れ替わるので、端点より先に決めておく
+    // 2bitのインデックスが先に並ぶ(モード4でインデックスの割り当てを入れ替えたときはアルファが先)
+    const bool isAlphaFirst = isMode4 && best.IndexSelection != 0;
+    uint8_t indexBlock[16] = {};
+    BitWriter indexWriter{ indexBlock, 0 };
+    if (isAlphaFirst)
+    {
+      writeBC7Indices(indexWriter, best.Alpha, 1, 2);
+      writeBC7Indices(indexWriter, best.Color, 3, 3);
+    }
+    else
+    {
+      writeBC7Indices(indexWriter, best.Color, 3, 2);
+      writeBC7Indices(indexWriter, best.Alpha, 1, isMode4 ? 3 : 2);
+    }
+
+    std::memset(outBlock, 0, 16);
+    BitWriter writer{ outBlock, 0 };
+    writer.Write(1u << best.Mode, best.Mode + 1);
+    writer.Write(best.Rotation, 2);
+    if (isMode4)
+    {
+      writer.Write(best.IndexSelection, 1);
+    }
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+      writer.Write(best.Color.Endpoints[0][c], colorBits);
+      writer.Write(best.Color.Endpoints[1][c], colorBits);
+    }
+    writer.Write(best.Alpha.Endpoints[0][0], alphaBits);
+    writer.Write(best.Alpha.Endpoints[1][0], alphaBits);
+
+    BitReader indexReader{ indexBlock, 0 };
+    while (indexReader.Position < indexWriter.Position)
+    {
+      const uint32_t bitCount = std::min(indexWriter.Position - indexReader.Position, 8u);
+      writer.Write(indexReader.Read(bitCount), bitCount);
+    }
+  }
+
+  /// @brief
+  /// 設定で許したモードを試し、誤差が最も小さいもので書き込む
+  void encodeBC7Block(const BlockPixels& pixels, const EncodeSettings& settings, uint8_t* outBlock)
+  {
+    const BC7Candidate mode6 = fitBC7Mode6(pixels, settings);
+    if ((settings.BC7ModeMask & ((1u << BC7_MODE4) | (1u << BC7_MODE5))) == 0 || mode6.Error == 0)
+    {
+      writeBC7Mode6(mode6, outBlock);
+      return;
+    }
+
+    BC7SeparateAlphaCandidate best{};
+    best.Error = std::numeric_limits<uint32_t>::max();
+    const uint32_t rotationCount = settings.IsSearchBC7Rotations ? BC7_ROTATION_COUNT : 1;
+    for (uint32_t rotation = 0; rotation < rotationCount; ++rotation)
+    {
+      if ((settings.BC7ModeMask & (1u << BC7_MODE5)) != 0)
+      {
+        const BC7SeparateAlphaCandidate candidate = fitBC7SeparateAlpha(pixels, BC7_MODE5, rotation, 0, settings);
+        if (candidate.Error < best.Error)
+        {
+          best = candidate;
+        }
+      }
+
+      if ((settings.BC7ModeMask & (1u << BC7_MODE4)) != 0)
+      {
+        const uint32_t indexSelectionCount = settings.IsSearchBC7Rotations ? 2 : 1;
+        for (uint32_t indexSelection = 0; indexSelection < indexSelectionCount; ++indexSelection)
+        {
+          const BC7SeparateAlphaCandidate candidate = fitBC7SeparateAlpha(pixels, BC7_MODE4, rotation, indexSelection, settings);
+          if (candidate.Error < best.Error)
+          {
+            best = candidate;
+          }
+        }
+      }
+    }
+
+    if (best.Error < mode6.Error)
+    {
+      writeBC7SeparateAlpha(best, outBlock);
+    }
+    else
+    {
+      writeBC7Mode6(mode6, outBlock);
+    }
+  }
+
+  void decodeBC7SeparateAlpha(BitReader& reader, uint32_t mode, BlockPixels& outPixels)
+  {
+    const bool isMode4 = (mode == BC7_MODE4);
+    const uint32_t rotation = reader.Read(2);
+    const uint32_t indexSelection = isMode4 ? reader.Read(1) : 0;
+    const uint32_t colorBits = isMode4 ? 5 : 7;
+    const uint32_t alphaBits = isMode4 ? 6 : 8;
+
+    int32_t endpoints[2][CHANNEL_COUNT] = {};
+    for (uint32_t c = 0; c < 3; ++c)
+    {
+      endpoints[0][c] = expandBC7Endpoint(reader.Read(colorBits), colorBits);
+      endpoints[1][c] = expandBC7Endpoint(reader.Read(colorBits), colorBits);
+    }
+    endpoints[0][3] = expandBC7Endpoint(reader.Read(alphaBits), alphaBits);
+    endpoints[1][3] = expandBC7Endpoint(reader.Read(alphaBits), alphaBits);
+
+    // 先に2bit、次にモード4は3bit、モード5は2bitのインデックスが並ぶ
+    const uint32_t indexBits[2] = { 2, isMode4 ? 3u : 2u };
+    uint8_t indices[2][BLOCK_PIXEL_COUNT] = {};
+    for (uint32_t set = 0; set < 2; ++set)
+    {
+      for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+      {
+        indices[set][i] = static_cast<uint8_t>(reader.Read(i == 0 ? indexBits[set] - 1 : indexBits[set]));
+      }
+    }
+
+    const uint32_t colorSet = (indexSelection != 0) ? 1 : 0;
+    const uint32_t* colorWeights = getBC7Weights(indexBits[colorSet]);
+    const uint32_t* alphaWeights = getBC7Weights(indexBits[1 - colorSet]);
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      const int32_t colorWeight = static_cast<int32_t>(colorWeights[indices[colorSet][i]]);
+      const int32_t alphaWeight = static_cast<int32_t>(alphaWeights[indices[1 - colorSet][i]]);
+      for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+      {
+        const int32_t weight = (c == 3) ? alphaWeight : colorWeight;
+        outPixels[i][c] = static_cast<uint8_t>(((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6);
+      }
+      if (rotation != 0)
+      {
+        std::swap(outPixels[i][rotation - 1], outPixels[i][3]);
+      }
+    }
+  }
+
+  bool decodeBC7Block(const uint8_t* block, BlockPixels& outPixels)
+  {
+    BitReader reader{ block, 0 };
+    uint32_t mode = 0;
+    while (mode < 8 && reader.Read(1) == 0)
+    {
+      ++mode;
+    }
+
+    if (mode == BC7_MODE4 || mode == BC7_MODE5)
+    {
+      decodeBC7SeparateAlpha(reader, mode, outPixels);
+      return true;
+    }
+    if (mode != BC7_MODE6)
+    {
+      return false;
+    }
+
+    int32_t endpoints[2][CHANNEL_COUNT] = {};
+    for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+    {
+      endpoints[0][c] = static_cast<int32_t>(reader.Read(7));
+      endpoints[1][c] = static_cast<int32_t>(reader.Read(7));
+    }
+    const int32_t pBit0 = static_cast<int32_t>(reader.Read(1));
+    const int32_t pBit1 = static_cast<int32_t>(reader.Read(1));
+    for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+    {
+      endpoints[0][c] = (endpoints[0][c] << 1) | pBit0;
+      endpoints[1][c] = (endpoints[1][c] << 1) | pBit1;
+    }
+
+    for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+    {
+      const uint32_t weight = BC7_WEIGHTS4[reader.Read(i == 0 ? 3 : 4)];
+      for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+      {
+        outPixels[i][c] = static_cast<uint8_t>(((64 - static_cast<int32_t>(weight)) * endpoints[0][c] + static_cast<int32_t>(weight) * endpoints[1][c] + 32) >> 6);
+      }
+    }
+    return true;
+  }
+
+  #pragma endregion BC7
+
+  /// @brief
+  /// 4x4ブロックをRGBAの順で読み込む(端のブロックは端のピクセルを繰り返す)
+  void loadBlock(const uint8_t* src, uint64_t rowPitch, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, bool isBGRA, BlockPixels& outPixels)
+  {
+    for (uint32_t y = 0; y < BLOCK_DIMENSION; ++y)
+    {
+      const uint32_t sourceY = std::min(blockY * BLOCK_DIMENSION + y, height - 1);
+      const uint8_t* row = src + rowPitch * sourceY;
+      for (uint32_t x = 0; x < BLOCK_DIMENSION; ++x)
+      {
+        const uint32_t sourceX = std::min(blockX * BLOCK_DIMENSION + x, width - 1);
+        const uint8_t* pixel = row + static_cast<size_t>(sourceX) * CHANNEL_COUNT;
+        uint8_t* out = outPixels[y * BLOCK_DIMENSION + x];
+        out[0] = isBGRA ? pixel[2] : pixel[0];
+        out[1] = pixel[1];
+        out[2] = isBGRA ? pixel[0] : pixel[2];
+        out[3] = pixel[3];
+      }
+    }
+  }
+
+  void encodeBlock(const BlockPixels& pixels, MFramework::BlockCompressFormat format, const EncodeSettings& settings, uint8_t* outBlock)
+  {
+    switch (format)
+    {
+      case MFramework::BlockCompressFormat::BC1:
+      {
+        encodeColorBlock(pixels, settings, true, outBlock);
+        break;
+      }
+      case MFramework::BlockCompressFormat::BC3:
+      {
+        uint8_t alpha[BLOCK_PIXEL_COUNT] = {};
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+          alpha[i] = pixels[i][3];
+        }
+        encodeSingleChannelBlock(alpha, settings, outBlock);
+        encodeColorBlock(pixels, settings, false, outBlock + 8);
+        break;
+      }
+      case MFramework::BlockCompressFormat::BC5:
+      {
+        for (uint32_t c = 0; c < 2; ++c)
+        {
+          uint8_t values[BLOCK_PIXEL_COUNT] = {};
+          for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+          {
+            values[i] = pixels[i][c];
+          }
+          encodeSingleChannelBlock(values, settings, outBlock + c * 8);
+        }
+        break;
+      }
+      default:
+      {
+        encodeBC7Block(pixels, settings, outBlock);
+        break;
+      }
+    }
+  }
+
+  bool decodeBlock(const uint8_t* block, uint32_t format, BlockPixels& outPixels)
+  {
+    switch (format)
+    {
+      case FORMAT_BC1_UNORM:
+      case FORMAT_BC1_UNORM_SRGB:
+      {
+        decodeColorBlock(block, true, outPixels);
+        return true;
+      }
+      case FORMAT_BC3_UNORM:
+      case FORMAT_BC3_UNORM_SRGB:
+      {
+        uint8_t alpha[BLOCK_PIXEL_COUNT] = {};
+        decodeSingleChannelBlock(block, alpha);
+        decodeColorBlock(block + 8, false, outPixels);
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+          outPixels[i][3] = alpha[i];
+        }
+        return true;
+      }
+      case FORMAT_BC5_UNORM:
+      {
+        uint8_t red[BLOCK_PIXEL_COUNT] = {};
+        uint8_t green[BLOCK_PIXEL_COUNT] = {};
+        decodeSingleChannelBlock(block, red);
+        decodeSingleChannelBlock(block + 8, green);
+        for (uint32_t i = 0; i < BLOCK_PIXEL_COUNT; ++i)
+        {
+          outPixels[i][0] = red[i];
+          outPixels[i][1] = green[i];
+          outPixels[i][2] = 0;
+          outPixels[i][3] = 255;
+        }
+        return true;
+      }
+      case FORMAT_BC7_UNORM:
+      case FORMAT_BC7_UNORM_SRGB:
+      {
+        return decodeBC7Block(block, outPixels);
+      }
+      default:
+      {
+        return false;
+      }
+    }
+  }
+
+  /// @brief
+  /// 比べるチャンネルの数(RGBAの先頭から)と、アルファを比べるか
+  /// BC1のアルファは1bitなので、閾値で二値化してから比べる
+  void getCompareChannels(uint32_t format, uint32_t& outColorChannelCount, bool& outIsCompareAlpha)
+  {
+    switch (format)
+    {
+      case FORMAT_BC1_UNORM:
+      case FORMAT_BC1_UNORM_SRGB:
+        outColorChannelCount = 3;
+        outIsCompareAlpha = true;
+        break;
+      case FORMAT_BC5_UNORM:
+        outColorChannelCount = 2;
+        outIsCompareAlpha = false;
+        break;
+      default:
+        outColorChannelCount = 3;
+        outIsCompareAlpha = true;
+        break;
+    }
+  }
+
+  /// @brief
+  /// サブリソースを詰めて並べたときの配置を計算する
+  void computePackedLayout(const MFramework::TextureDesc& desc, uint32_t blockBytes, uint32_t blockDimension, std::vector<MFramework::SubresourceData>& outSubresources, uint64_t& outTotalBytes)
+  {
+    const uint32_t subresourceCount = MFramework::TextureFootprint::GetSubresourceCount(desc);
+    outSubresources.resize(subresourceCount);
+    outTotalBytes = 0;
+    for (uint32_t i = 0; i < subresourceCount; ++i)
+    {
+      const uint32_t mip = i % desc.MipLevels;
+      const uint32_t width = MFramework::TextureFootprint::GetMipDimension(desc.Width, mip);
+      const uint32_t height = MFramework::TextureFootprint::GetMipDimension(desc.Height, mip);
+      const uint64_t rowPitch = static_cast<uint64_t>((width + blockDimension - 1) / blockDimension) * blockBytes;
+      const uint64_t slicePitch = rowPitch * ((height + blockDimension - 1) / blockDimension);
+      outSubresources[i] = MFramework::SubresourceData{ outTotalBytes, rowPitch, slicePitch };
+      outTotalBytes += slicePitch;
+    }
+  }
+}
+
+namespace MFramework
+{
+  bool BlockCompressor::IsSupportedSourceFormat(uint32_t format)
+  {
+    return format == FORMAT_R8G8B8A8_UNORM || format == FORMAT_R8G8B8A8_UNORM_SRGB ||
+           format == FORMAT_B8G8R8A8_UNORM || format == FORMAT_B8G8R8A8_UNORM_SRGB;
+  }
+
+  uint32_t BlockCompressor::GetCompressedFormat(BlockCompressFormat format, bool isSRGB)
+  {
+    switch (format)
+    {
+      case BlockCompressFormat::BC1:
+        return isSRGB ? FORMAT_BC1_UNORM_SRGB : FORMAT_BC1_UNORM;
+      case BlockCompressFormat::BC3:
+        return isSRGB ? FORMAT_BC3_UNORM_SRGB : FORMAT_BC3_UNORM;
+      case BlockCompressFormat::BC5:
+        return FORMAT_BC5_UNORM;
+      default:
+        return isSRGB ? FORMAT_BC7_UNORM_SRGB : FORMAT_BC7_UNORM;
+    }
+  }
+
+  bool BlockCompressor::Compress(const TextureData& src, const BlockCompressDesc& desc, TextureData& outData, std::string& outError, ThreadPool* threadPool)
+  {
+    if (&src == &outData)
+    {
+      outError = "source and destination must differ";
+      return false;
+    }
+
+    if (!IsSupportedSourceFormat(src.Desc.Format))
+    {
+      outError = "unsupported source format";
+      return false;
+    }
+
+    if (src.Desc.Dimension != TEXTURE_DIMENSION_TEXTURE2D || src.Desc.MipLevels == 0 ||
+        src.Subresources.size() != TextureFootprint::GetSubresourceCount(src.Desc))
+    {
+      outError = "unsupported texture desc";
+      return false;
+    }
+
+    // D3D12はBCフォーマットのミップ0のサイズが4の倍数であることを要求する
+    if (src.Desc.Width % BLOCK_DIMENSION != 0 || src.Desc.Height % BLOCK_DIMENSION != 0)
+    {
+      outError = "width and height must be multiples of 4";
+      return false;
+    }
+
+    const uint32_t compressedFormat = GetCompressedFormat(desc.Format, desc.IsSRGB || isSRGBFormat(src.Desc.Format));
+    const uint32_t blockBytes = getBlockBytes(compressedFormat);
+    const bool isBGRA = isBGRAFormat(src.Desc.Format);
+    const EncodeSettings settings = getEncodeSettings(desc.Quality);
+
+    outData.Desc = src.Desc;
+    outData.Desc.Format = compressedFormat;
+    uint64_t totalBytes = 0;
+    computePackedLayout(outData.Desc, blockBytes, BLOCK_DIMENSION, outData.Subresources, totalBytes);
+    outData.Pixels.assign(static_cast<size_t>(totalBytes), 0);
+
+    // ブロック行を仕事の単位にする(小さいミップも大きいミップと同じ粒度で分担できる)
+    struct BlockRowJob
+    {
+      uint32_t Subresource;
+      uint32_t BlockY;
+    };
+
+    std::vector<BlockRowJob> jobs;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(src.Subresources.size()); ++i)
+    {
+      const uint32_t height = TextureFootprint::GetMipDimension(src.Desc.Height, i % src.Desc.MipLevels);
+      const uint32_t width = TextureFootprint::GetMipDimension(src.Desc.Width, i % src.Desc.MipLevels);
+      const SubresourceData& subresource = src.Subresources[i];
+      if (subresource.RowPitch < static_cast<uint64_t>(width) * CHANNEL_COUNT ||
+          subresource.Offset + subresource.RowPitch * (height - 1) + static_cast<uint64_t>(width) * CHANNEL_COUNT > src.Pixels.size())
+      {
+        outError = "subresource out of range";
+        return false;
+      }
+
+      const uint32_t blockRowCount = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+      for (uint32_t blockY = 0; blockY < blockRowCount; ++blockY)
+      {
+        jobs.emplace_back(BlockRowJob{ i, blockY });
+      }
+    }
+
+    auto encodeRows = [&](size_t begin, size_t end)
+                      {
+                        BlockPixels pixels = {};
+                        for (size_t j = begin; j < end; ++j)
+                        {
+                          const BlockRowJob& job = jobs[j];
+                          const uint32_t mip = job.Subresource % src.Desc.MipLevels;
+                          const uint32_t width = TextureFootprint::GetMipDimension(src.Desc.Width, mip);
+                          const uint32_t height = TextureFootprint::GetMipDimension(src.Desc.Height, mip);
+                          const SubresourceData& source = src.Subresources[job.Subresource];
+                          const SubresourceData& destination = outData.Subresources[job.Subresource];
+
+                          uint8_t* outRow = outData.Pixels.data() + destination.Offset + destination.RowPitch * job.BlockY;
+                          const uint32_t blockColumnCount = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+                          for (uint32_t blockX = 0; blockX < blockColumnCount; ++blockX)
+                          {
+                            loadBlock(src.Pixels.data() + source.Offset, source.RowPitch, width, height, blockX, job.BlockY, isBGRA, pixels);
+                            encodeBlock(pixels, desc.Format, settings, outRow + static_cast<size_t>(blockX) * blockBytes);
+                          }
+                        }
+                      };
+
+    if (threadPool != nullptr)
+    {
+      threadPool->ParallelFor(jobs.size(), encodeRows, BLOCK_ROWS_PER_CHUNK);
+    }
+    else
+    {
+      encodeRows(0, jobs.size());
+    }
+
+    return true;
+  }
+
+  bool BlockCompressor::Decompress(const TextureData& src, TextureData& outData, std::string& outError)
+  {
+    const uint32_t format = src.Desc.Format;
+    const bool isSRGB = (format == FORMAT_BC1_UNORM_SRGB || format == FORMAT_BC3_UNORM_SRGB || format == FORMAT_BC7_UNORM_SRGB);
+    if (&src == &outData || src.Desc.Dimension != TEXTURE_DIMENSION_TEXTURE2D || src.Desc.MipLevels == 0 ||
+        src.Subresources.size() != TextureFootprint::GetSubresourceCount(src.Desc))
+    {
+      outError = "unsupported texture desc";
+      return false;
+    }
+
+    outData.Desc = src.Desc;
+    outData.Desc.Format = isSRGB ? FORMAT_R8G8B8A8_UNORM_SRGB : FORMAT_R8G8B8A8_UNORM;
+    uint64_t totalBytes = 0;
+    computePackedLayout(outData.Desc, CHANNEL_COUNT, 1, outData.Subresources, totalBytes);
+    outData.Pixels.assign(static_cast<size_t>(totalBytes), 0);
+
+    const uint32_t blockBytes = getBlockBytes(format);
+    BlockPixels pixels = {};
+    for (size_t i = 0; i < src.Subresources.size(); ++i)
+    {
+      const uint32_t mip = static_cast<uint32_t>(i % src.Desc.MipLevels);
+      const uint32_t width = TextureFootprint::GetMipDimension(src.Desc.Width, mip);
+      const uint32_t height = TextureFootprint::GetMipDimension(src.Desc.Height, mip);
+      const uint32_t blockColumnCount = (width + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+      const uint32_t blockRowCount = (height + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+      const SubresourceData& source = src.Subresources[i];
+      const SubresourceData& destination = outData.Subresources[i];
+
+      if (source.RowPitch < static_cast<uint64_t>(blockColumnCount) * blockBytes ||
+          source.Offset + source.RowPitch * blockRowCount > src.Pixels.size())
+      {
+        outError = "subresource out of range";
+        return false;
+      }
+
+      for (uint32_t blockY = 0; blockY < blockRowCount; ++blockY)
+      {
+        for (uint32_t blockX = 0; blockX < blockColumnCount; ++blockX)
+        {
+          const uint8_t* block = src.Pixels.data() + source.Offset + source.RowPitch * blockY + static_cast<size_t>(blockX) * blockBytes;
+          if (!decodeBlock(block, format, pixels))
+          {
+            outError = "unsupported block";
+            return false;
+          }
+
+          // 端のブロックははみ出した部分を捨てる
+          for (uint32_t y = 0; y < BLOCK_DIMENSION && blockY * BLOCK_DIMENSION + y < height; ++y)
+          {
+            for (uint32_t x = 0; x < BLOCK_DIMENSION && blockX * BLOCK_DIMENSION + x < width; ++x)
+            {
+              uint8_t* out = outData.Pixels.data() + destination.Offset + destination.RowPitch * (blockY * BLOCK_DIMENSION + y) +
+                             static_cast<size_t>(blockX * BLOCK_DIMENSION + x) * CHANNEL_COUNT;
+              std::memcpy(out, pixels[y * BLOCK_DIMENSION + x], CHANNEL_COUNT);
+            }
+          }
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool BlockCompressor::ComputePSNR(const TextureData& reference, const TextureData& compressed, double& outPSNR, std::string& outError)
+  {
+    if (!IsSupportedSourceFormat(reference.Desc.Format) ||
+        reference.Desc.Width != compressed.Desc.Width || reference.Desc.Height != compressed.Desc.Height ||
+        reference.Desc.MipLevels != compressed.Desc.MipLevels || reference.Desc.DepthOrArraySize != compressed.Desc.DepthOrArraySize ||
+        reference.Subresources.size() != compressed.Subresources.size())
+    {
+      outError = "textures do not match";
+      return false;
+    }
+
+    TextureData decoded{};
+    if (!Decompress(compressed, decoded, outError))
+    {
+      return false;
+    }
+
+    uint32_t colorChannelCount = 0;
+    bool isCompareAlpha = false;
+    getCompareChannels(compressed.Desc.Format, colorChannelCount, isCompareAlpha);
+    const bool isBGRA = isBGRAFormat(reference.Desc.Format);
+    const bool isBinaryAlpha = (compressed.Desc.Format == FORMAT_BC1_UNORM || compressed.Desc.Format == FORMAT_BC1_UNORM_SRGB);
+
+    double squaredErrorSum = 0.0;
+    uint64_t sampleCount = 0;
+    for (size_t i = 0; i < reference.Subresources.size(); ++i)
+    {
+      const uint32_t mip = static_cast<uint32_t>(i % reference.Desc.MipLevels);
+      const uint32_t width = TextureFootprint::GetMipDimension(reference.Desc.Width, mip);
+      const uint32_t height = TextureFootprint::GetMipDimension(reference.Desc.Height, mip);
+      const SubresourceData& source = reference.Subresources[i];
+      const SubresourceData& target = decoded.Subresources[i];
+      if (source.Offset + source.RowPitch * (height - 1) + static_cast<uint64_t>(width) * CHANNEL_COUNT > reference.Pixels.size())
+      {
+        outError = "subresource out of range";
+        return false;
+      }
+
+      for (uint32_t y = 0; y < height; ++y)
+      {
+        const uint8_t* sourceRow = reference.Pixels.data() + source.Offset + source.RowPitch * y;
+        const uint8_t* targetRow = decoded.Pixels.data() + target.Offset + target.RowPitch * y;
+        for (uint32_t x = 0; x < width; ++x)
+        {
+          const uint8_t* sourcePixel = sourceRow + static_cast<size_t>(x) * CHANNEL_COUNT;
+          const uint8_t* targetPixel = targetRow + static_cast<size_t>(x) * CHANNEL_COUNT;
+          uint8_t sourceRGBA[CHANNEL_COUNT] =
+          {
+            isBGRA ? sourcePixel[2] : sourcePixel[0],
+            sourcePixel[1],
+            isBGRA ? sourcePixel[0] : sourcePixel[2],
+            sourcePixel[3],
+          };
+
+          if (isBinaryAlpha)
+          {
+            sourceRGBA[3] = (sourceRGBA[3] < BC1_ALPHA_THRESHOLD) ? 0 : 255;
+          }
+
+          // 透明になったピクセルは色を持たないので、アルファだけ比べる
+          const bool isTransparent = isBinaryAlpha && sourceRGBA[3] == 0 && targetPixel[3] == 0;
+          for (uint32_t c = 0; c < colorChannelCount; ++c)
+          {
+            const double difference = isTransparent ? 0.0 : static_cast<double>(sourceRGBA[c]) - targetPixel[c];
+            squaredErrorSum += difference * difference;
+          }
+          if (isCompareAlpha)
+          {
+            const double difference = static_cast<double>(sourceRGBA[3]) - targetPixel[3];
+            squaredErrorSum += difference * difference;
+          }
+        }
+      }
+      sampleCount += static_cast<uint64_t>(width) * height * (colorChannelCount + (isCompareAlpha ? 1 : 0));
+    }
+
+    const double meanSquaredError = squaredErrorSum / static_cast<double>(std::max<uint64_t>(sampleCount, 1));
+    outPSNR = (meanSquaredError > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / meanSquaredError) : std::numeric_limits<double>::infinity();
+    return true;
+  }
+}
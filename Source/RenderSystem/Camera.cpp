@@ -0,0 +1,239 @@
+/*
+
+MGameEngine Core Module
+Author : MAI ZHICONG
+
+Description : Camera
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/Camera.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  constexpr float DEFAULT_FOV_Y = 0.785398163f;     // 45°
+  constexpr float DEFAULT_ASPECT_RATIO = 16.0f / 9.0f;
+  constexpr float DEFAULT_NEAR_Z = 0.1f;
+  constexpr float DEFAULT_FAR_Z = 1000.0f;
+
+  float dot(const float a[3], const float b[3])
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  void cross(const float a[3], const float b[3], float out[3])
+  {
+    const float x = a[1] * b[2] - a[2] * b[1];
+    const float y = a[2] * b[0] - a[0] * b[2];
+    const float z = a[0] * b[1] - a[1] * b[0];
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
+  }
+
+  bool normalize(float vector[3])
+  {
+    const float length = std::sqrt(dot(vector, vector));
+    if (length <= 0.0f)
+    {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+      vector[i] /= length;
+    }
+    return true;
+  }
+
+  void setPlane(float outPlane[4], const float normal[3], const float point[3])
+  {
+    float unitNormal[3] = { normal[0], normal[1], normal[2] };
+    normalize(unitNormal);
+    outPlane[0] = unitNormal[0];
+    outPlane[1] = unitNormal[1];
+    outPlane[2] = unitNormal[2];
+    outPlane[3] = -dot(unitNormal, point);
+  }
+
+  void multiply(const float a[16], const float b[16], float out[16])
+  {
+    float result[16] = {};
+    for (uint32_t row = 0; row < 4; ++row)
+    {
+      for (uint32_t column = 0; column < 4; ++column)
+      {
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+          result[row * 4 + column] += a[row * 4 + i] * b[i * 4 + column];
+        }
+      }
+    }
+    std::memcpy(out, result, sizeof(result));
+  }
+}
+
+namespace MGameEngine
+{
+  Camera::Camera()
+    : m_position{ 0.0f, 0.0f, 0.0f }
+    , m_forward{ 0.0f, 0.0f, 1.0f }
+    , m_right{ 1.0f, 0.0f, 0.0f }
+    , m_up{ 0.0f, 1.0f, 0.0f }
+    , m_fovY(DEFAULT_FOV_Y)
+    , m_aspectRatio(DEFAULT_ASPECT_RATIO)
+    , m_nearZ(DEFAULT_NEAR_Z)
+    , m_farZ(DEFAULT_FAR_Z)
+  { }
+
+  void Camera::SetLookAt(const float eye[3], const float target[3], const float up[3])
+  {
+    float forward[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+    float right[3] = {};
+    cross(up, forward, right);
+
+    std::memcpy(m_position, eye, sizeof(m_position));
+
+    // 注視点が位置と同じ、または上方向と向きが平行なら向きを変えない
+    if (!normalize(forward) || !normalize(right))
+    {
+      return;
+    }
+
+    std::memcpy(m_forward, forward, sizeof(m_forward));
+    std::memcpy(m_right, right, sizeof(m_right));
+    cross(m_forward, m_right, m_up);
+  }
+
+  void Camera::SetPerspective(float fovY, float aspectRatio, float nearZ, float farZ)
+  {
+    m_fovY = fovY;
+    m_aspectRatio = aspectRatio;
+    m_nearZ = nearZ;
+    m_farZ = farZ;
+  }
+
+  const float* Camera::GetPosition() const
+  {
+    return m_position;
+  }
+
+  const float* Camera::GetForward() const
+  {
+    return m_forward;
+  }
+
+  const float* Camera::GetRight() const
+  {
+    return m_right;
+  }
+
+  const float* Camera::GetUp() const
+  {
+    return m_up;
+  }
+
+  float Camera::GetFovY() const
+  {
+    return m_fovY;
+  }
+
+  float Camera::GetAspectRatio() const
+  {
+    return m_aspectRatio;
+  }
+
+  float Camera::GetNearZ() const
+  {
+    return m_nearZ;
+  }
+
+  float Camera::GetFarZ() const
+  {
+    return m_farZ;
+  }
+
+  void Camera::GetViewMatrix(float outMatrix[16]) const
+  {
+    // XMMatrixLookToLHと同じ(列に基底を並べ、4行目で位置を打ち消す)
+    const float matrix[16] =
+    {
+      m_right[0], m_up[0], m_forward[0], 0.0f,
+      m_right[1], m_up[1], m_forward[1], 0.0f,
+      m_right[2], m_up[2], m_forward[2], 0.0f,
+      -dot(m_right, m_position), -dot(m_up, m_position), -dot(m_forward, m_position), 1.0f,
+    };
+    std::memcpy(outMatrix, matrix, sizeof(matrix));
+  }
+
+  void Camera::GetProjectionMatrix(float outMatrix[16]) const
+  {
+    // XMMatrixPerspectiveFovLHと同じ
+    const float height = 1.0f / std::tan(m_fovY * 0.5f);
+    const float width = height / m_aspectRatio;
+    const float range = m_farZ / (m_farZ - m_nearZ);
+    const float matrix[16] =
+    {
+      width, 0.0f, 0.0f, 0.0f,
+      0.0f, height, 0.0f, 0.0f,
+      0.0f, 0.0f, range, 1.0f,
+      0.0f, 0.0f, -range * m_nearZ, 0.0f,
+    };
+    std::memcpy(outMatrix, matrix, sizeof(matrix));
+  }
+
+  void Camera::GetViewProjectionMatrix(float outMatrix[16]) const
+  {
+    float view[16] = {};
+    float projection[16] = {};
+    GetViewMatrix(view);
+    GetProjectionMatrix(projection);
+    multiply(view, projection, outMatrix);
+  }
+
+  void Camera::GetFrustumPlanes(float outPlanes[CAMERA_FRUSTUM_PLANE_COUNT][4]) const
+  {
+    // 行列から取り出すより誤差が少ないので、カメラの基底から直接求める
+    // 側面は位置を通り、画面端の方向(forward ± right * tan)を含む平面になる
+    const float tanY = std::tan(m_fovY * 0.5f);
+    const float tanX = tanY * m_aspectRatio;
+
+    float nearPoint[3] = {};
+    float farPoint[3] = {};
+    const float backward[3] = { -m_forward[0], -m_forward[1], -m_forward[2] };
+    float leftNormal[3] = {};
+    float rightNormal[3] = {};
+    float bottomNormal[3] = {};
+    float topNormal[3] = {};
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+      nearPoint[i] = m_position[i] + m_forward[i] * m_nearZ;
+      farPoint[i] = m_position[i] + m_forward[i] * m_farZ;
+      leftNormal[i] = m_forward[i] * tanX + m_right[i];
+      rightNormal[i] = m_forward[i] * tanX - m_right[i];
+      bottomNormal[i] = m_forward[i] * tanY + m_up[i];
+      topNormal[i] = m_forward[i] * tanY - m_up[i];
+    }
+
+    setPlane(outPlanes[0], m_forward, nearPoint);
+    setPlane(outPlanes[1], backward, farPoint);
+    setPlane(outPlanes[2], leftNormal, m_position);
+    setPlane(outPlanes[3], rightNormal, m_position);
+    setPlane(outPlanes[4], bottomNormal, m_position);
+    setPlane(outPlanes[5], topNormal, m_position);
+  }
+
+  float Camera::GetProjectionScale(float viewportHeight) const
+  {
+    return viewportHeight / (2.0f * std::tan(m_fovY * 0.5f));
+  }
+}
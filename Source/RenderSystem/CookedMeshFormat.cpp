@@ -0,0 +1,610 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked mesh file format (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Quantized vertex formats
+                2026/10/19 Meshlets
+                2026/10/19 LOD chain
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/CookedMeshFormat.h>
+#include <RenderSystem/VertexQuantizer.h>
+
+#include <HashUtil.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+  // これ未満の頂点数なら16bitインデックスにする
+  constexpr size_t MAX_16BIT_VERTEX_COUNT = 0x10000;
+
+  uint64_t alignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  void computeBounds(const MFramework::MeshData& mesh, MFramework::CookedMeshEntry& entry)
+  {
+    if (mesh.Vertices.empty())
+    {
+      std::fill(entry.BoundsMin, entry.BoundsMin + 3, 0.0f);
+      std::fill(entry.BoundsMax, entry.BoundsMax + 3, 0.0f);
+      return;
+    }
+
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      entry.BoundsMin[axis] = std::numeric_limits<float>::max();
+      entry.BoundsMax[axis] = std::numeric_limits<float>::lowest();
+    }
+
+    for (const MFramework::MeshVertex& vertex : mesh.Vertices)
+    {
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        entry.BoundsMin[axis] = std::min(entry.BoundsMin[axis], vertex.Position[axis]);
+        entry.BoundsMax[axis] = std::max(entry.BoundsMax[axis], vertex.Position[axis]);
+      }
+    }
+  }
+
+  bool isInRange(uint64_t offset, uint64_t size, uint64_t limit)
+  {
+    return offset <= limit && size <= limit - offset;
+  }
+
+  void writeIndices(const uint32_t* indices, size_t indexCount, uint32_t indexStride, uint8_t* dst)
+  {
+    if (indexStride == sizeof(uint16_t))
+    {
+      uint16_t* shortIndices = reinterpret_cast<uint16_t*>(dst);
+      for (size_t i = 0; i < indexCount; ++i)
+      {
+        shortIndices[i] = static_cast<uint16_t>(indices[i]);
+      }
+    }
+    else if (indexCount > 0)
+    {
+      std::memcpy(dst, indices, sizeof(uint32_t) * indexCount);
+    }
+  }
+
+  uint32_t readIndex(const uint8_t* indexData, uint32_t index, uint32_t indexStride)
+  {
+    if (indexStride == sizeof(uint16_t))
+    {
+      uint16_t value = 0;
+      std::memcpy(&value, indexData + static_cast<uint64_t>(index) * sizeof(uint16_t), sizeof(value));
+      return value;
+    }
+
+    uint32_t value = 0;
+    std::memcpy(&value, indexData + static_cast<uint64_t>(index) * sizeof(uint32_t), sizeof(value));
+    return value;
+  }
+
+  /// @brief
+  /// 範囲外のインデックスはGPUでは読み出し結果が不定になる
+  bool isValidIndices(const uint8_t* indexData, uint32_t indexCount, uint32_t indexStride, uint32_t vertexCount)
+  {
+    for (uint32_t i = 0; i < indexCount; ++i)
+    {
+      if (readIndex(indexData, i, indexStride) >= vertexCount)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief
+  /// メッシュレットのデータの各部分の位置(データの先頭から)
+  struct MeshletSections
+  {
+    uint64_t MeshletOffset;
+    uint64_t BoundsOffset;
+    uint64_t VertexIndexOffset;
+    uint64_t PrimitiveIndexOffset;
+    uint64_t EndOffset;
+  };
+
+  MeshletSections getMeshletSections(const MFramework::CookedMeshEntry& entry)
+  {
+    // MeshletとMeshletBoundsは16の倍数の大きさなので後ろの部分も揃う
+    MeshletSections sections{};
+    sections.MeshletOffset = entry.MeshletOffset;
+    sections.BoundsOffset = sections.MeshletOffset + sizeof(MFramework::Meshlet) * static_cast<uint64_t>(entry.MeshletCount);
+    sections.VertexIndexOffset = sections.BoundsOffset + sizeof(MFramework::MeshletBounds) * static_cast<uint64_t>(entry.MeshletCount);
+    sections.PrimitiveIndexOffset = sections.VertexIndexOffset + sizeof(uint32_t) * static_cast<uint64_t>(entry.MeshletVertexIndexCount);
+    sections.EndOffset = sections.PrimitiveIndexOffset + entry.MeshletPrimitiveIndexCount;
+    return sections;
+  }
+
+  /// @brief
+  /// メッシュレットが頂点とメッシュレットのデータの範囲内を指しているか
+  bool isValidMeshlets(const MFramework::CookedMeshEntry& entry, const uint8_t* meshData)
+  {
+    const MeshletSections sections = getMeshletSections(entry);
+    const MFramework::Meshlet* meshlets = reinterpret_cast<const MFramework::Meshlet*>(meshData + sections.MeshletOffset);
+    const uint32_t* vertexIndices = reinterpret_cast<const uint32_t*>(meshData + sections.VertexIndexOffset);
+    const uint8_t* primitiveIndices = meshData + sections.PrimitiveIndexOffset;
+
+    for (uint32_t i = 0; i < entry.MeshletCount; ++i)
+    {
+      const MFramework::Meshlet& meshlet = meshlets[i];
+      if (!isInRange(meshlet.VertexOffset, meshlet.VertexCount, entry.MeshletVertexIndexCount) ||
+          !isInRange(meshlet.PrimitiveOffset, static_cast<uint64_t>(meshlet.TriangleCount) * 3, entry.MeshletPrimitiveIndexCount))
+      {
+        return false;
+      }
+
+      for (uint32_t vertex = 0; vertex < meshlet.VertexCount; ++vertex)
+      {
+        if (vertexIndices[meshlet.VertexOffset + vertex] >= entry.VertexCount)
+        {
+          return false;
+        }
+      }
+
+      for (uint32_t primitive = 0; primitive < meshlet.TriangleCount * 3; ++primitive)
+      {
+        if (primitiveIndices[meshlet.PrimitiveOffset + primitive] >= meshlet.VertexCount)
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  template<typename T>
+  void copyArray(const uint8_t* src, size_t count, std::vector<T>& outValues)
+  {
+    outValues.resize(count);
+    if (count > 0)
+    {
+      std::memcpy(outValues.data(), src, sizeof(T) * count);
+    }
+  }
+}
+
+namespace MFramework
+{
+  bool CookedMeshFormat::Serialize(const std::vector<MeshData>& meshes, const std::vector<MeshletData>& meshlets, const std::vector<std::vector<MeshLod>>& lods, const VertexFormatDesc& vertexFormat, std::vector<uint8_t>& outFile, std::string& outError)
+  {
+    if (meshes.size() > std::numeric_limits<uint32_t>::max())
+    {
+      outError = "too many meshes";
+      return false;
+    }
+
+    if (!meshlets.empty() && meshlets.size() != meshes.size())
+    {
+      outError = "meshlet count does not match mesh count";
+      return false;
+    }
+
+    if (!lods.empty() && lods.size() != meshes.size())
+    {
+      outError = "lod count does not match mesh count";
+      return false;
+    }
+
+    VertexLayout layout{};
+    if (!VertexFormat::CreateLayout(vertexFormat, layout, outError))
+    {
+      return false;
+    }
+
+    std::vector<CookedMeshEntry> entries(meshes.size());
+    std::vector<std::vector<CookedMeshLod>> lodTables(meshes.size());
+    std::string strings;
+    uint64_t dataSize = 0;
+
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+      const MeshData& mesh = meshes[i];
+      if (mesh.Vertices.size() > std::numeric_limits<uint32_t>::max() || mesh.Indices.size() > std::numeric_limits<uint32_t>::max() || mesh.Indices.size() % 3 != 0)
+      {
+        outError = "invalid mesh " + mesh.Name;
+        return false;
+      }
+
+      for (const uint32_t index : mesh.Indices)
+      {
+        if (index >= mesh.Vertices.size())
+        {
+          outError = "index out of range in " + mesh.Name;
+          return false;
+        }
+      }
+
+      CookedMeshEntry& entry = entries[i];
+      entry = CookedMeshEntry{};
+      entry.VertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+      entry.IndexCount = static_cast<uint32_t>(mesh.Indices.size());
+      entry.IndexStride = (mesh.Vertices.size() < MAX_16BIT_VERTEX_COUNT) ? sizeof(uint16_t) : sizeof(uint32_t);
+
+      entry.NameOffset = static_cast<uint32_t>(strings.size());
+      entry.NameLength = static_cast<uint32_t>(mesh.Name.size());
+      strings += mesh.Name;
+      entry.MaterialNameOffset = static_cast<uint32_t>(strings.size());
+      entry.MaterialNameLength = static_cast<uint32_t>(mesh.MaterialName.size());
+      strings += mesh.MaterialName;
+
+      entry.VertexOffset = alignUp(dataSize, COOKED_MESH_DATA_ALIGNMENT);
+      entry.IndexOffset = alignUp(entry.VertexOffset + static_cast<uint64_t>(layout.Stride) * mesh.Vertices.size(), COOKED_MESH_DATA_ALIGNMENT);
+      dataSize = entry.IndexOffset + static_cast<uint64_t>(entry.IndexStride) * mesh.Indices.size();
+
+      if (!meshlets.empty())
+      {
+        const MeshletData& meshletData = meshlets[i];
+        if (meshletData.Meshlets.size() > std::numeric_limits<uint32_t>::max() || meshletData.Bounds.size() != meshletData.Meshlets.size() ||
+            meshletData.VertexIndices.size() > std::numeric_limits<uint32_t>::max() || meshletData.PrimitiveIndices.size() > std::numeric_limits<uint32_t>::max())
+        {
+          outError = "invalid meshlets in " + mesh.Name;
+          return false;
+        }
+
+        entry.MeshletCount = static_cast<uint32_t>(meshletData.Meshlets.size());
+        entry.MeshletVertexIndexCount = static_cast<uint32_t>(meshletData.VertexIndices.size());
+        entry.MeshletPrimitiveIndexCount = static_cast<uint32_t>(meshletData.PrimitiveIndices.size());
+        if (entry.MeshletCount > 0)
+        {
+          entry.MeshletOffset = alignUp(dataSize, COOKED_MESH_DATA_ALIGNMENT);
+          dataSize = getMeshletSections(entry).EndOffset;
+        }
+      }
+
+      // 0番は元のインデックス、残りは表の後ろに並べる
+      std::vector<CookedMeshLod>& lodTable = lodTables[i];
+      lodTable.emplace_back(CookedMeshLod{ entry.IndexOffset, entry.IndexCount, 0.0f });
+      entry.LodOffset = alignUp(dataSize, COOKED_MESH_DATA_ALIGNMENT);
+      dataSize = entry.LodOffset + sizeof(CookedMeshLod) * (1 + (lods.empty() ? 0 : lods[i].size()));
+      if (!lods.empty())
+      {
+        for (const MeshLod& lod : lods[i])
+        {
+          const bool isIndexInRange = std::all_of(
+                                                  lod.Indices.begin(),
+                                                  lod.Indices.end(),
+                                                  [&mesh](uint32_t index)
+                                                  {
+                                                    return index < mesh.Vertices.size();
+                                                  }
+                                                );
+          if (lod.Indices.size() > std::numeric_limits<uint32_t>::max() || lod.Indices.size() % 3 != 0 || !isIndexInRange)
+          {
+            outError = "invalid lod in " + mesh.Name;
+            return false;
+          }
+
+          const uint64_t lodIndexOffset = alignUp(dataSize, COOKED_MESH_DATA_ALIGNMENT);
+          lodTable.emplace_back(CookedMeshLod{ lodIndexOffset, static_cast<uint32_t>(lod.Indices.size()), lod.Error });
+          dataSize = lodIndexOffset + static_cast<uint64_t>(entry.IndexStride) * lod.Indices.size();
+        }
+      }
+      entry.LodCount = static_cast<uint32_t>(lodTable.size());
+
+      computeBounds(mesh, entry);
+    }
+
+    if (strings.size() > std::numeric_limits<uint32_t>::max())
+    {
+      outError = "string table too large";
+      return false;
+    }
+
+    const uint64_t meshTableOffset = sizeof(CookedMeshHeader);
+    const uint64_t stringTableOffset = meshTableOffset + sizeof(CookedMeshEntry) * entries.size();
+    const uint64_t dataOffset = alignUp(stringTableOffset + strings.size(), COOKED_MESH_DATA_ALIGNMENT);
+    dataSize = alignUp(dataSize, COOKED_MESH_DATA_ALIGNMENT);
+
+    // パディングを0にしてハッシュが毎回同じになるようにする
+    outFile.assign(static_cast<size_t>(dataOffset + dataSize), 0);
+    uint8_t* data = outFile.data() + dataOffset;
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+      const MeshData& mesh = meshes[i];
+      const CookedMeshEntry& entry = entries[i];
+      const VertexQuantization quantization = VertexQuantizer::CreateQuantization(entry.BoundsMin, entry.BoundsMax);
+      VertexQuantizer::Encode(mesh.Vertices.data(), mesh.Vertices.size(), layout, quantization, data + entry.VertexOffset);
+
+      writeIndices(mesh.Indices.data(), mesh.Indices.size(), entry.IndexStride, data + entry.IndexOffset);
+
+      if (entry.MeshletCount > 0)
+      {
+        const MeshletData& meshletData = meshlets[i];
+        const MeshletSections sections = getMeshletSections(entry);
+        std::memcpy(data + sections.MeshletOffset, meshletData.Meshlets.data(), sizeof(Meshlet) * meshletData.Meshlets.size());
+        std::memcpy(data + sections.BoundsOffset, meshletData.Bounds.data(), sizeof(MeshletBounds) * meshletData.Bounds.size());
+        if (!meshletData.VertexIndices.empty())
+        {
+          std::memcpy(data + sections.VertexIndexOffset, meshletData.VertexIndices.data(), sizeof(uint32_t) * meshletData.VertexIndices.size());
+        }
+        if (!meshletData.PrimitiveIndices.empty())
+        {
+          std::memcpy(data + sections.PrimitiveIndexOffset, meshletData.PrimitiveIndices.data(), meshletData.PrimitiveIndices.size());
+        }
+      }
+
+      const std::vector<CookedMeshLod>& lodTable = lodTables[i];
+      std::memcpy(data + entry.LodOffset, lodTable.data(), sizeof(CookedMeshLod) * lodTable.size());
+      for (size_t lod = 1; lod < lodTable.size(); ++lod)
+      {
+        const std::vector<uint32_t>& lodIndices = lods[i][lod - 1].Indices;
+        writeIndices(lodIndices.data(), lodIndices.size(), entry.IndexStride, data + lodTable[lod].IndexOffset);
+      }
+    }
+
+    CookedMeshHeader header{};
+    header.Magic = COOKED_MESH_MAGIC;
+    header.Version = COOKED_MESH_VERSION;
+    header.MeshCount = static_cast<uint32_t>(entries.size());
+    header.VertexStride = layout.Stride;
+    header.PositionFormat = static_cast<uint8_t>(vertexFormat.Position);
+    header.NormalFormat = static_cast<uint8_t>(vertexFormat.Normal);
+    header.TexCoordFormat = static_cast<uint8_t>(vertexFormat.TexCoord);
+    header.MeshTableOffset = meshTableOffset;
+    header.StringTableOffset = stringTableOffset;
+    header.StringTableSize = strings.size();
+    header.DataOffset = dataOffset;
+    header.DataSize = dataSize;
+    header.DataHash = HashUtility::Fnv1a64(data, static_cast<size_t>(dataSize));
+
+    std::memcpy(outFile.data(), &header, sizeof(header));
+    if (!entries.empty())
+    {
+      std::memcpy(outFile.data() + meshTableOffset, entries.data(), sizeof(CookedMeshEntry) * entries.size());
+    }
+    if (!strings.empty())
+    {
+      std::memcpy(outFile.data() + stringTableOffset, strings.data(), strings.size());
+    }
+    return true;
+  }
+
+  bool CookedMeshFormat::WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file)
+  {
+    const std::filesystem::path path(std::u8string(filePath.begin(), filePath.end()));
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+      std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+      {
+        return false;
+      }
+
+      stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+      if (!stream.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool CookedMeshFormat::Parse(const uint8_t* data, size_t size, CookedMeshView& outView, std::string& outError, bool isVerifyData)
+  {
+    if (data == nullptr || size < sizeof(CookedMeshHeader))
+    {
+      outError = "file too small";
+      return false;
+    }
+
+    const CookedMeshHeader* header = reinterpret_cast<const CookedMeshHeader*>(data);
+    if (header->Magic != COOKED_MESH_MAGIC || header->Version != COOKED_MESH_VERSION)
+    {
+      outError = "not a cooked mesh";
+      return false;
+    }
+
+    const VertexFormatDesc vertexFormat =
+    {
+      static_cast<VertexElementFormat>(header->PositionFormat),
+      static_cast<VertexElementFormat>(header->NormalFormat),
+      static_cast<VertexElementFormat>(header->TexCoordFormat),
+    };
+    VertexLayout layout{};
+    if (!VertexFormat::CreateLayout(vertexFormat, layout, outError) || layout.Stride != header->VertexStride)
+    {
+      outError = "invalid vertex format";
+      return false;
+    }
+
+    const uint64_t meshTableSize = sizeof(CookedMeshEntry) * static_cast<uint64_t>(header->MeshCount);
+    if (header->MeshTableOffset % alignof(CookedMeshEntry) != 0 || !isInRange(header->MeshTableOffset, meshTableSize, size))
+    {
+      outError = "mesh table out of range";
+      return false;
+    }
+
+    if (!isInRange(header->StringTableOffset, header->StringTableSize, size))
+    {
+      outError = "string table out of range";
+      return false;
+    }
+
+    if (header->DataOffset % COOKED_MESH_DATA_ALIGNMENT != 0 || !isInRange(header->DataOffset, header->DataSize, size))
+    {
+      outError = "data out of range";
+      return false;
+    }
+
+    const CookedMeshEntry* entries = reinterpret_cast<const CookedMeshEntry*>(data + header->MeshTableOffset);
+    const uint8_t* meshData = data + header->DataOffset;
+    for (uint32_t i = 0; i < header->MeshCount; ++i)
+    {
+      const CookedMeshEntry& entry = entries[i];
+      const uint64_t vertexSize = static_cast<uint64_t>(layout.Stride) * entry.VertexCount;
+      const uint64_t indexSize = static_cast<uint64_t>(entry.IndexStride) * entry.IndexCount;
+      if ((entry.IndexStride != sizeof(uint16_t) && entry.IndexStride != sizeof(uint32_t)) || entry.IndexCount % 3 != 0 ||
+          entry.VertexOffset % COOKED_MESH_DATA_ALIGNMENT != 0 || entry.IndexOffset % COOKED_MESH_DATA_ALIGNMENT != 0 ||
+          !isInRange(entry.VertexOffset, vertexSize, header->DataSize) || !isInRange(entry.IndexOffset, indexSize, header->DataSize) ||
+          !isInRange(entry.NameOffset, entry.NameLength, header->StringTableSize) ||
+          !isInRange(entry.MaterialNameOffset, entry.MaterialNameLength, header->StringTableSize))
+      {
+        outError = "mesh " + std::to_string(i) + " out of range";
+        return false;
+      }
+
+      if (entry.MeshletCount > 0 && (entry.MeshletOffset % COOKED_MESH_DATA_ALIGNMENT != 0 || !isInRange(entry.MeshletOffset, getMeshletSections(entry).EndOffset - entry.MeshletOffset, header->DataSize)))
+      {
+        outError = "mesh " + std::to_string(i) + " meshlets out of range";
+        return false;
+      }
+
+      if (entry.LodCount == 0 || entry.LodOffset % COOKED_MESH_DATA_ALIGNMENT != 0 || !isInRange(entry.LodOffset, sizeof(CookedMeshLod) * static_cast<uint64_t>(entry.LodCount), header->DataSize))
+      {
+        outError = "mesh " + std::to_string(i) + " lods out of range";
+        return false;
+      }
+
+      const CookedMeshLod* lods = reinterpret_cast<const CookedMeshLod*>(meshData + entry.LodOffset);
+      for (uint32_t lod = 0; lod < entry.LodCount; ++lod)
+      {
+        if (lods[lod].IndexCount % 3 != 0 || lods[lod].IndexOffset % sizeof(uint32_t) != 0 ||
+            !isInRange(lods[lod].IndexOffset, static_cast<uint64_t>(entry.IndexStride) * lods[lod].IndexCount, header->DataSize))
+        {
+          outError = "mesh " + std::to_string(i) + " lod " + std::to_string(lod) + " out of range";
+          return false;
+        }
+      }
+
+      if (!isVerifyData)
+      {
+        continue;
+      }
+
+      if (!isValidIndices(meshData + entry.IndexOffset, entry.IndexCount, entry.IndexStride, entry.VertexCount))
+      {
+        outError = "mesh " + std::to_string(i) + " index out of range";
+        return false;
+      }
+
+      for (uint32_t lod = 0; lod < entry.LodCount; ++lod)
+      {
+        if (!isValidIndices(meshData + lods[lod].IndexOffset, lods[lod].IndexCount, entry.IndexStride, entry.VertexCount))
+        {
+          outError = "mesh " + std::to_string(i) + " lod " + std::to_string(lod) + " index out of range";
+          return false;
+        }
+      }
+
+      if (!isValidMeshlets(entry, meshData))
+      {
+        outError = "mesh " + std::to_string(i) + " meshlet index out of range";
+        return false;
+      }
+    }
+
+    if (isVerifyData && HashUtility::Fnv1a64(meshData, static_cast<size_t>(header->DataSize)) != header->DataHash)
+    {
+      outError = "data hash mismatch";
+      return false;
+    }
+
+    outView.Header = header;
+    outView.Meshes = entries;
+    outView.Strings = reinterpret_cast<const char*>(data + header->StringTableOffset);
+    outView.Data = meshData;
+    outView.Layout = layout;
+    return true;
+  }
+
+  std::string_view CookedMeshFormat::GetName(const CookedMeshView& view, uint32_t meshIndex)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    return std::string_view(view.Strings + entry.NameOffset, entry.NameLength);
+  }
+
+  std::string_view CookedMeshFormat::GetMaterialName(const CookedMeshView& view, uint32_t meshIndex)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    return std::string_view(view.Strings + entry.MaterialNameOffset, entry.MaterialNameLength);
+  }
+
+  VertexQuantization CookedMeshFormat::GetQuantization(const CookedMeshView& view, uint32_t meshIndex)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    return VertexQuantizer::CreateQuantization(entry.BoundsMin, entry.BoundsMax);
+  }
+
+  void CookedMeshFormat::ReadMesh(const CookedMeshView& view, uint32_t meshIndex, MeshData& outMesh)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    outMesh.Name = std::string(GetName(view, meshIndex));
+    outMesh.MaterialName = std::string(GetMaterialName(view, meshIndex));
+    outMesh.HasNormals = (view.Layout.Desc.Normal != VertexElementFormat::None);
+
+    outMesh.Vertices.resize(entry.VertexCount);
+    VertexQuantizer::Decode(view.Data + entry.VertexOffset, entry.VertexCount, view.Layout, GetQuantization(view, meshIndex), outMesh.Vertices.data());
+
+    outMesh.Indices.resize(entry.IndexCount);
+    const uint8_t* indexData = view.Data + entry.IndexOffset;
+    for (uint32_t i = 0; i < entry.IndexCount; ++i)
+    {
+      outMesh.Indices[i] = readIndex(indexData, i, entry.IndexStride);
+    }
+  }
+
+  CookedMeshLod CookedMeshFormat::GetLod(const CookedMeshView& view, uint32_t meshIndex, uint32_t lodIndex)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    CookedMeshLod lod{};
+    std::memcpy(&lod, view.Data + entry.LodOffset + sizeof(CookedMeshLod) * lodIndex, sizeof(lod));
+    return lod;
+  }
+
+  void CookedMeshFormat::ReadLodIndices(const CookedMeshView& view, uint32_t meshIndex, uint32_t lodIndex, std::vector<uint32_t>& outIndices)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    const CookedMeshLod lod = GetLod(view, meshIndex, lodIndex);
+    outIndices.resize(lod.IndexCount);
+    for (uint32_t i = 0; i < lod.IndexCount; ++i)
+    {
+      outIndices[i] = readIndex(view.Data + lod.IndexOffset, i, entry.IndexStride);
+    }
+  }
+
+  void CookedMeshFormat::ReadMeshlets(const CookedMeshView& view, uint32_t meshIndex, MeshletData& outMeshlets)
+  {
+    const CookedMeshEntry& entry = view.Meshes[meshIndex];
+    if (entry.MeshletCount == 0)
+    {
+      outMeshlets = MeshletData{};
+      return;
+    }
+
+    const MeshletSections sections = getMeshletSections(entry);
+    copyArray(view.Data + sections.MeshletOffset, entry.MeshletCount, outMeshlets.Meshlets);
+    copyArray(view.Data + sections.BoundsOffset, entry.MeshletCount, outMeshlets.Bounds);
+    copyArray(view.Data + sections.VertexIndexOffset, entry.MeshletVertexIndexCount, outMeshlets.VertexIndices);
+    copyArray(view.Data + sections.PrimitiveIndexOffset, entry.MeshletPrimitiveIndexCount, outMeshlets.PrimitiveIndices);
+  }
+}
@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked texture (.mtex) decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/CookedTextureDecoder.h>
+#include <RenderSystem/CookedTextureFormat.h>
+#include <MappedFile.h>
+
+namespace MFramework
+{
+  bool CookedTextureDecoder::Decode(const std::string& path, TextureData& outData, std::string& outError) const
+  {
+    MappedFile file;
+    if (!file.Open(path))
+    {
+      outError = "file not found " + path;
+      return false;
+    }
+
+    if (!DecodeMemory(file.GetData(), file.GetSize(), outData, outError))
+    {
+      outError += " : " + path;
+      return false;
+    }
+
+    return true;
+  }
+
+  bool CookedTextureDecoder::DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError)
+  {
+    CookedTextureView view{};
+    if (!CookedTextureFormat::Parse(data, size, view, outError))
+    {
+      return false;
+    }
+
+    // データの塊をそのまま持ち、サブリソースは配置済みの位置とピッチを指す
+    outData.Desc = view.Header->Desc;
+    outData.Pixels.assign(view.Data, view.Data + view.Header->DataSize);
+    outData.Subresources.resize(view.Header->SubresourceCount);
+    for (uint32_t i = 0; i < view.Header->SubresourceCount; ++i)
+    {
+      const SubresourceFootprint& footprint = view.Footprints[i];
+      outData.Subresources[i] = SubresourceData{ footprint.Offset, footprint.RowPitch, static_cast<uint64_t>(footprint.RowPitch) * footprint.NumRows };
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,191 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Cooked texture file format (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/CookedTextureFormat.h>
+
+#include <HashUtil.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  uint64_t alignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  bool isSameFootprint(const MFramework::SubresourceFootprint& a, const MFramework::SubresourceFootprint& b)
+  {
+    return a.Offset == b.Offset && a.Format == b.Format &&
+           a.Width == b.Width && a.Height == b.Height && a.Depth == b.Depth &&
+           a.RowPitch == b.RowPitch && a.NumRows == b.NumRows && a.RowSizeInBytes == b.RowSizeInBytes;
+  }
+}
+
+namespace MFramework
+{
+  bool CookedTextureFormat::Serialize(const TextureData& src, std::vector<uint8_t>& outFile, std::string& outError)
+  {
+    std::vector<SubresourceFootprint> footprints;
+    uint64_t dataSize = 0;
+    if (!TextureFootprint::Compute(src.Desc, footprints, &dataSize))
+    {
+      outError = "unsupported texture desc";
+      return false;
+    }
+
+    if (src.Subresources.size() != footprints.size())
+    {
+      outError = "subresource count mismatch";
+      return false;
+    }
+
+    // 元データが範囲内に収まっているか先に確認する
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const SubresourceData& subresource = src.Subresources[i];
+      const SubresourceFootprint& footprint = footprints[i];
+      if (subresource.RowPitch < footprint.RowSizeInBytes)
+      {
+        outError = "row pitch too small";
+        return false;
+      }
+
+      const uint64_t lastByte = subresource.Offset + subresource.SlicePitch * (footprint.Depth - 1) +
+                                subresource.RowPitch * (footprint.NumRows - 1) + footprint.RowSizeInBytes;
+      if (lastByte > src.Pixels.size())
+      {
+        outError = "subresource out of range";
+        return false;
+      }
+    }
+
+    const uint64_t footprintOffset = sizeof(CookedTextureHeader);
+    const uint64_t dataOffset = alignUp(footprintOffset + sizeof(SubresourceFootprint) * footprints.size(), TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+    // パディングを0にしてハッシュが毎回同じになるようにする
+    outFile.assign(static_cast<size_t>(dataOffset + dataSize), 0);
+    uint8_t* data = outFile.data() + dataOffset;
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const SubresourceData& subresource = src.Subresources[i];
+      TextureFootprint::CopySubresource(data, footprints[i], src.Pixels.data() + subresource.Offset, subresource.RowPitch, subresource.SlicePitch);
+    }
+
+    CookedTextureHeader header{};
+    header.Magic = COOKED_TEXTURE_MAGIC;
+    header.Version = COOKED_TEXTURE_VERSION;
+    header.Desc = src.Desc;
+    header.SubresourceCount = static_cast<uint32_t>(footprints.size());
+    header.FootprintOffset = footprintOffset;
+    header.DataOffset = dataOffset;
+    header.DataSize = dataSize;
+    header.DataHash = HashUtility::Fnv1a64(data, static_cast<size_t>(dataSize));
+
+    std::memcpy(outFile.data(), &header, sizeof(header));
+    std::memcpy(outFile.data() + footprintOffset, footprints.data(), sizeof(SubresourceFootprint) * footprints.size());
+    return true;
+  }
+
+  bool CookedTextureFormat::WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file)
+  {
+    const std::string tempPath = filePath + ".tmp";
+    {
+      std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+      {
+        return false;
+      }
+
+      stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+      if (!stream.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error)
+    {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool CookedTextureFormat::Parse(const uint8_t* data, size_t size, CookedTextureView& outView, std::string& outError, bool isVerifyData)
+  {
+    if (data == nullptr || size < sizeof(CookedTextureHeader))
+    {
+      outError = "file too small";
+      return false;
+    }
+
+    const CookedTextureHeader* header = reinterpret_cast<const CookedTextureHeader*>(data);
+    if (header->Magic != COOKED_TEXTURE_MAGIC || header->Version != COOKED_TEXTURE_VERSION)
+    {
+      outError = "not a cooked texture";
+      return false;
+    }
+
+    std::vector<SubresourceFootprint> expected;
+    uint64_t expectedSize = 0;
+    if (!TextureFootprint::Compute(header->Desc, expected, &expectedSize) || expected.size() != header->SubresourceCount)
+    {
+      outError = "invalid texture desc";
+      return false;
+    }
+
+    const uint64_t footprintBytes = sizeof(SubresourceFootprint) * static_cast<uint64_t>(header->SubresourceCount);
+    if (header->FootprintOffset % alignof(SubresourceFootprint) != 0 || header->FootprintOffset > size || footprintBytes > size - header->FootprintOffset)
+    {
+      outError = "footprints out of range";
+      return false;
+    }
+
+    if (header->DataOffset % TEXTURE_DATA_PLACEMENT_ALIGNMENT != 0 || header->DataSize != expectedSize ||
+        header->DataOffset > size || header->DataSize > size - header->DataOffset)
+    {
+      outError = "data out of range";
+      return false;
+    }
+
+    // 書き出したときと計算結果が変わっていればそのままではアップロードできない
+    const SubresourceFootprint* footprints = reinterpret_cast<const SubresourceFootprint*>(data + header->FootprintOffset);
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      if (!isSameFootprint(footprints[i], expected[i]))
+      {
+        outError = "footprint mismatch";
+        return false;
+      }
+    }
+
+    if (isVerifyData && HashUtility::Fnv1a64(data + header->DataOffset, static_cast<size_t>(header->DataSize)) != header->DataHash)
+    {
+      outError = "data hash mismatch";
+      return false;
+    }
+
+    outView.Header = header;
+    outView.Footprints = footprints;
+    outView.Data = data + header->DataOffset;
+    return true;
+  }
+}
@@ -0,0 +1,435 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DDS file format (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Parse DDS files without DirectXTex
+                2026/10/19 Reject sizes over the D3D12 limits
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/DdsFormat.h>
+#include <RenderSystem/TextureFootprint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  constexpr uint32_t DDSD_CAPS = 0x1;
+  constexpr uint32_t DDSD_HEIGHT = 0x2;
+  constexpr uint32_t DDSD_WIDTH = 0x4;
+  constexpr uint32_t DDSD_PITCH = 0x8;
+  constexpr uint32_t DDSD_PIXELFORMAT = 0x1000;
+  constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+  constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+  constexpr uint32_t DDSD_DEPTH = 0x800000;
+  constexpr uint32_t DDPF_ALPHAPIXELS = 0x1;
+  constexpr uint32_t DDPF_ALPHA = 0x2;
+  constexpr uint32_t DDPF_FOURCC = 0x4;
+  constexpr uint32_t DDPF_RGB = 0x40;
+  constexpr uint32_t DDPF_LUMINANCE = 0x20000;
+  constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+  constexpr uint32_t DDSCAPS_TEXTURE = 0x1000;
+  constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+  constexpr uint32_t DDSCAPS2_CUBEMAP = 0x200;
+  constexpr uint32_t DDSCAPS2_CUBEMAP_ALLFACES = 0xFC00;
+  constexpr uint32_t DDSCAPS2_VOLUME = 0x200000;
+  constexpr uint32_t DDS_RESOURCE_MISC_TEXTURECUBE = 0x4;
+  constexpr uint32_t CUBEMAP_FACE_COUNT = 6;
+  constexpr uint32_t MAX_MIP_LEVELS = 15;             // D3D12_REQ_MIP_LEVELS
+  constexpr uint64_t MAX_TEXTURE1D_SIZE = 16384;      // D3D12_REQ_TEXTURE1D_U_DIMENSION
+  constexpr uint64_t MAX_TEXTURE2D_SIZE = 16384;      // D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION
+  constexpr uint64_t MAX_TEXTURE3D_SIZE = 2048;       // D3D12_REQ_TEXTURE3D_U_V_OR_W_DIMENSION
+  constexpr uint64_t MAX_TEXTURE_ARRAY_SIZE = 2048;   // D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION(キューブマップは面の数で数える)
+
+  constexpr uint32_t makeFourCC(char c0, char c1, char c2, char c3)
+  {
+    return static_cast<uint32_t>(static_cast<uint8_t>(c0)) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c1)) << 8) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c2)) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(c3)) << 24);
+  }
+
+  struct FourCCFormat
+  {
+    uint32_t FourCC;
+    uint32_t Format;    // DXGI_FORMAT
+  };
+
+  // 旧形式のFourCC(数値はD3DFORMAT)
+  constexpr FourCCFormat FOURCC_FORMAT_TABLE[] =
+  {
+    { makeFourCC('D', 'X', 'T', '1'), 71 },   // BC1_UNORM
+    { makeFourCC('D', 'X', 'T', '2'), 74 },   // BC2_UNORM
+    { makeFourCC('D', 'X', 'T', '3'), 74 },
+    { makeFourCC('D', 'X', 'T', '4'), 77 },   // BC3_UNORM
+    { makeFourCC('D', 'X', 'T', '5'), 77 },
+    { makeFourCC('A', 'T', 'I', '1'), 80 },   // BC4_UNORM
+    { makeFourCC('B', 'C', '4', 'U'), 80 },
+    { makeFourCC('B', 'C', '4', 'S'), 81 },   // BC4_SNORM
+    { makeFourCC('A', 'T', 'I', '2'), 83 },   // BC5_UNORM
+    { makeFourCC('B', 'C', '5', 'U'), 83 },
+    { makeFourCC('B', 'C', '5', 'S'), 84 },   // BC5_SNORM
+    { 36,  11 },                              // A16B16G16R16 -> R16G16B16A16_UNORM
+    { 111, 54 },                              // R16F -> R16_FLOAT
+    { 112, 34 },                              // G16R16F -> R16G16_FLOAT
+    { 113, 10 },                              // A16B16G16R16F -> R16G16B16A16_FLOAT
+    { 114, 41 },                              // R32F -> R32_FLOAT
+    { 115, 16 },                              // G32R32F -> R32G32_FLOAT
+    { 116,  2 },                              // A32B32G32R32F -> R32G32B32A32_FLOAT
+  };
+
+  struct MaskFormat
+  {
+    uint32_t Flags;       // DDPF_RGB / DDPF_LUMINANCE / DDPF_ALPHA
+    uint32_t BitCount;
+    uint32_t RBitMask;
+    uint32_t GBitMask;
+    uint32_t BBitMask;
+    uint32_t ABitMask;
+    uint32_t Format;      // DXGI_FORMAT
+  };
+
+  // 旧形式のビットマスク(変換せずにそのまま使えるものだけ)
+  constexpr MaskFormat MASK_FORMAT_TABLE[] =
+  {
+    { DDPF_RGB,       32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000,  28 },   // R8G8B8A8_UNORM
+    { DDPF_RGB,       32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0xff000000,  87 },   // B8G8R8A8_UNORM
+    { DDPF_RGB,       32, 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000,  88 },   // B8G8R8X8_UNORM
+    { DDPF_RGB,       32, 0x3ff00000, 0x000ffc00, 0x000003ff, 0xc0000000,  24 },   // R10G10B10A2_UNORM(D3DX10以降の並び)
+    { DDPF_RGB,       32, 0x0000ffff, 0xffff0000, 0x00000000, 0x00000000,  35 },   // R16G16_UNORM
+    { DDPF_RGB,       32, 0xffffffff, 0x00000000, 0x00000000, 0x00000000,  41 },   // R32_FLOAT
+    { DDPF_RGB,       16, 0x0000f800, 0x000007e0, 0x0000001f, 0x00000000,  85 },   // B5G6R5_UNORM
+    { DDPF_RGB,       16, 0x00007c00, 0x000003e0, 0x0000001f, 0x00008000,  86 },   // B5G5R5A1_UNORM
+    { DDPF_RGB,       16, 0x00000f00, 0x000000f0, 0x0000000f, 0x0000f000, 115 },   // B4G4R4A4_UNORM
+    { DDPF_LUMINANCE,  8, 0x000000ff, 0x00000000, 0x00000000, 0x00000000,  61 },   // R8_UNORM
+    { DDPF_LUMINANCE, 16, 0x0000ffff, 0x00000000, 0x00000000, 0x00000000,  56 },   // R16_UNORM
+    { DDPF_LUMINANCE, 16, 0x000000ff, 0x00000000, 0x00000000, 0x0000ff00,  49 },   // R8G8_UNORM
+    { DDPF_ALPHA,      8, 0x00000000, 0x00000000, 0x00000000, 0x000000ff,  65 },   // A8_UNORM
+  };
+
+  uint32_t getLegacyFormat(const MFramework::DdsPixelFormat& pixelFormat)
+  {
+    if ((pixelFormat.Flags & DDPF_FOURCC) != 0)
+    {
+      for (const FourCCFormat& entry : FOURCC_FORMAT_TABLE)
+      {
+        if (entry.FourCC == pixelFormat.FourCC)
+        {
+          return entry.Format;
+        }
+      }
+
+      return 0;
+    }
+
+    // アルファの有無はマスクで判断するので、種類のフラグだけを比べる
+    const uint32_t kind = pixelFormat.Flags & (DDPF_RGB | DDPF_LUMINANCE | DDPF_ALPHA);
+    const uint32_t alphaMask = ((pixelFormat.Flags & (DDPF_ALPHAPIXELS | DDPF_ALPHA)) != 0) ? pixelFormat.ABitMask : 0;
+    for (const MaskFormat& entry : MASK_FORMAT_TABLE)
+    {
+      if (entry.Flags == kind && entry.BitCount == pixelFormat.RGBBitCount &&
+          entry.RBitMask == pixelFormat.RBitMask && entry.GBitMask == pixelFormat.GBitMask &&
+          entry.BBitMask == pixelFormat.BBitMask && entry.ABitMask == alphaMask)
+      {
+        return entry.Format;
+      }
+    }
+
+    return 0;
+  }
+
+  uint32_t getMaxMipLevels(uint32_t width, uint32_t height, uint32_t depth)
+  {
+    uint32_t size = std::max(std::max(width, height), depth);
+    uint32_t levels = 1;
+    while (size > 1)
+    {
+      size >>= 1;
+      ++levels;
+    }
+
+    return levels;
+  }
+}
+
+namespace MFramework
+{
+  bool DdsFormat::Serialize(const TextureData& src, std::vector<uint8_t>& outFile, std::string& outError)
+  {
+    // 行サイズと行数はアップロード時の配置と同じ計算で求める(オフセットは使わない)
+    std::vector<SubresourceFootprint> footprints;
+    if (!TextureFootprint::Compute(src.Desc, footprints))
+    {
+      outError = "unsupported texture desc";
+      return false;
+    }
+
+    if (src.Subresources.size() != footprints.size())
+    {
+      outError = "subresource count mismatch";
+      return false;
+    }
+
+    uint64_t dataSize = 0;
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const SubresourceData& subresource = src.Subresources[i];
+      const SubresourceFootprint& footprint = footprints[i];
+      const uint64_t lastByte = subresource.Offset + subresource.SlicePitch * (footprint.Depth - 1) +
+                                subresource.RowPitch * (footprint.NumRows - 1) + footprint.RowSizeInBytes;
+      if (subresource.RowPitch < footprint.RowSizeInBytes || lastByte > src.Pixels.size())
+      {
+        outError = "subresource out of range";
+        return false;
+      }
+      dataSize += footprint.RowSizeInBytes * footprint.NumRows * footprint.Depth;
+    }
+
+    const bool isVolume = (src.Desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D);
+    const bool isBlockCompressed = TextureFootprint::GetFormatInfo(src.Desc.Format).IsBlockCompressed();
+
+    DdsHeader header{};
+    header.Size = sizeof(DdsHeader);
+    header.Flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT |
+                   (isBlockCompressed ? DDSD_LINEARSIZE : DDSD_PITCH) | (isVolume ? DDSD_DEPTH : 0);
+    header.Height = src.Desc.Height;
+    header.Width = src.Desc.Width;
+    header.PitchOrLinearSize = static_cast<uint32_t>(isBlockCompressed ? footprints[0].RowSizeInBytes * footprints[0].NumRows : footprints[0].RowSizeInBytes);
+    header.Depth = isVolume ? src.Desc.DepthOrArraySize : 1;
+    header.MipMapCount = src.Desc.MipLevels;
+    header.PixelFormat.Size = sizeof(DdsPixelFormat);
+    header.PixelFormat.Flags = DDPF_FOURCC;
+    header.PixelFormat.FourCC = DDS_FOURCC_DX10;
+    header.Caps = DDSCAPS_TEXTURE | ((src.Desc.MipLevels > 1) ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0);
+    header.Caps2 = isVolume ? DDSCAPS2_VOLUME : 0;
+
+    DdsHeaderDX10 headerDX10{};
+    headerDX10.DxgiFormat = src.Desc.Format;
+    headerDX10.ResourceDimension = src.Desc.Dimension;
+    headerDX10.ArraySize = isVolume ? 1 : src.Desc.DepthOrArraySize;
+
+    const size_t headerSize = sizeof(DDS_MAGIC) + sizeof(DdsHeader) + sizeof(DdsHeaderDX10);
+    outFile.resize(headerSize + static_cast<size_t>(dataSize));
+    std::memcpy(outFile.data(), &DDS_MAGIC, sizeof(DDS_MAGIC));
+    std::memcpy(outFile.data() + sizeof(DDS_MAGIC), &header, sizeof(header));
+    std::memcpy(outFile.data() + sizeof(DDS_MAGIC) + sizeof(DdsHeader), &headerDX10, sizeof(headerDX10));
+
+    // DDSの行は詰めて並べる
+    uint8_t* dst = outFile.data() + headerSize;
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const SubresourceData& subresource = src.Subresources[i];
+      const SubresourceFootprint& footprint = footprints[i];
+      const size_t rowSize = static_cast<size_t>(footprint.RowSizeInBytes);
+      for (uint32_t z = 0; z < footprint.Depth; ++z)
+      {
+        const uint8_t* srcRow = src.Pixels.data() + subresource.Offset + subresource.SlicePitch * z;
+        for (uint32_t y = 0; y < footprint.NumRows; ++y)
+        {
+          std::memcpy(dst, srcRow, rowSize);
+          dst += rowSize;
+          srcRow += subresource.RowPitch;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  bool DdsFormat::WriteToFile(const std::string& filePath, const std::vector<uint8_t>& file)
+  {
+    const std::string tempPath = filePath + ".tmp";
+    {
+      std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+      if (!stream.is_open())
+      {
+        return false;
+      }
+
+      stream.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+      if (!stream.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error)
+    {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  bool DdsFormat::Parse(const uint8_t* data, size_t size, DdsTextureView& outView, std::string& outError)
+  {
+    constexpr size_t HEADER_OFFSET = sizeof(DDS_MAGIC);
+    if (data == nullptr || size < HEADER_OFFSET + sizeof(DdsHeader))
+    {
+      outError = "file too small";
+      return false;
+    }
+
+    // マップした先頭はページ境界だが、念のためヘッダーはコピーして読む
+    uint32_t magic = 0;
+    DdsHeader header{};
+    std::memcpy(&magic, data, sizeof(magic));
+    std::memcpy(&header, data + HEADER_OFFSET, sizeof(header));
+    if (magic != DDS_MAGIC || header.Size != sizeof(DdsHeader) || header.PixelFormat.Size != sizeof(DdsPixelFormat))
+    {
+      outError = "not a dds file";
+      return false;
+    }
+
+    TextureDesc desc{};
+    desc.Width = header.Width;
+    desc.Height = ((header.Flags & DDSD_HEIGHT) != 0) ? header.Height : 1;
+    desc.MipLevels = std::max<uint32_t>(header.MipMapCount, 1);
+    bool isCubemap = false;
+    // ヘッダーの値はそのまま信用せず、掛け算が溢れないように64ビットで求めてから上限と比べる
+    uint64_t depthOrArraySize = 1;
+    size_t dataOffset = HEADER_OFFSET + sizeof(DdsHeader);
+
+    if ((header.PixelFormat.Flags & DDPF_FOURCC) != 0 && header.PixelFormat.FourCC == DDS_FOURCC_DX10)
+    {
+      if (size < dataOffset + sizeof(DdsHeaderDX10))
+      {
+        outError = "file too small";
+        return false;
+      }
+
+      DdsHeaderDX10 headerDX10{};
+      std::memcpy(&headerDX10, data + dataOffset, sizeof(headerDX10));
+      dataOffset += sizeof(DdsHeaderDX10);
+
+      desc.Format = headerDX10.DxgiFormat;
+      desc.Dimension = headerDX10.ResourceDimension;
+      isCubemap = (headerDX10.MiscFlag & DDS_RESOURCE_MISC_TEXTURECUBE) != 0;
+
+      switch (desc.Dimension)
+      {
+        case TEXTURE_DIMENSION_TEXTURE1D:
+          desc.Height = 1;
+          depthOrArraySize = headerDX10.ArraySize;
+          break;
+        case TEXTURE_DIMENSION_TEXTURE2D:
+          depthOrArraySize = static_cast<uint64_t>(headerDX10.ArraySize) * (isCubemap ? CUBEMAP_FACE_COUNT : 1);
+          break;
+        case TEXTURE_DIMENSION_TEXTURE3D:
+          depthOrArraySize = ((header.Flags & DDSD_DEPTH) != 0) ? header.Depth : 1;
+          if (headerDX10.ArraySize > 1)
+          {
+            outError = "volume texture array is not supported";
+            return false;
+          }
+          break;
+        default:
+          outError = "invalid resource dimension";
+          return false;
+      }
+    }
+    else
+    {
+      desc.Format = getLegacyFormat(header.PixelFormat);
+      if ((header.Caps2 & DDSCAPS2_VOLUME) != 0)
+      {
+        desc.Dimension = TEXTURE_DIMENSION_TEXTURE3D;
+        depthOrArraySize = ((header.Flags & DDSD_DEPTH) != 0) ? header.Depth : 1;
+      }
+      else
+      {
+        desc.Dimension = TEXTURE_DIMENSION_TEXTURE2D;
+        if ((header.Caps2 & DDSCAPS2_CUBEMAP) != 0)
+        {
+          // 一部の面しか持たないキューブマップはD3D12で表せない
+          if ((header.Caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+          {
+            outError = "partial cubemap is not supported";
+            return false;
+          }
+          isCubemap = true;
+        }
+        depthOrArraySize = isCubemap ? CUBEMAP_FACE_COUNT : 1;
+      }
+    }
+
+    // サブリソースごとに配置を求めるので、大きすぎる値は配置を求める前に弾く
+    uint64_t maxSize = MAX_TEXTURE2D_SIZE;
+    uint64_t maxDepthOrArraySize = MAX_TEXTURE_ARRAY_SIZE;
+    if (desc.Dimension == TEXTURE_DIMENSION_TEXTURE1D)
+    {
+      maxSize = MAX_TEXTURE1D_SIZE;
+    }
+    else if (desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D)
+    {
+      maxSize = MAX_TEXTURE3D_SIZE;
+      maxDepthOrArraySize = MAX_TEXTURE3D_SIZE;
+    }
+    if (desc.Width > maxSize || desc.Height > maxSize || depthOrArraySize > maxDepthOrArraySize)
+    {
+      outError = "texture size exceeds the D3D12 limits";
+      return false;
+    }
+    desc.DepthOrArraySize = static_cast<uint32_t>(depthOrArraySize);
+
+    if (!TextureFootprint::GetFormatInfo(desc.Format).IsValid())
+    {
+      outError = "unsupported pixel format";
+      return false;
+    }
+
+    const uint32_t depth = (desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D) ? desc.DepthOrArraySize : 1;
+    if (desc.Width == 0 || desc.Height == 0 || desc.DepthOrArraySize == 0 ||
+        desc.MipLevels > std::min(MAX_MIP_LEVELS, getMaxMipLevels(desc.Width, desc.Height, depth)))
+    {
+      outError = "invalid texture size";
+      return false;
+    }
+
+    // 行サイズと行数はアップロード時の配置と同じ計算で求め、ファイル内では詰めて並んでいるものとする
+    std::vector<SubresourceFootprint> footprints;
+    if (!TextureFootprint::Compute(desc, footprints))
+    {
+      outError = "invalid texture desc";
+      return false;
+    }
+
+    const uint64_t dataSize = static_cast<uint64_t>(size - dataOffset);
+    uint64_t offset = 0;
+    outView.Subresources.resize(footprints.size());
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const SubresourceFootprint& footprint = footprints[i];
+      const uint64_t slicePitch = footprint.RowSizeInBytes * footprint.NumRows;
+      const uint64_t subresourceSize = slicePitch * footprint.Depth;
+      if (subresourceSize > dataSize - offset)
+      {
+        outError = "data out of range";
+        return false;
+      }
+
+      outView.Subresources[i] = SubresourceData{ offset, footprint.RowSizeInBytes, slicePitch };
+      offset += subresourceSize;
+    }
+
+    outView.Desc = desc;
+    outView.IsCubemap = isCubemap;
+    outView.Data = data + dataOffset;
+    outView.DataSize = offset;
+    return true;
+  }
+}
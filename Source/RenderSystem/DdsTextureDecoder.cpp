@@ -0,0 +1,56 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : DDS texture decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/DdsTextureDecoder.h>
+#include <RenderSystem/DdsFormat.h>
+#include <MappedFile.h>
+
+#include <utility>
+
+namespace MFramework
+{
+  bool DdsTextureDecoder::Decode(const std::string& path, TextureData& outData, std::string& outError) const
+  {
+    MappedFile file;
+    if (!file.Open(path))
+    {
+      outError = "file not found " + path;
+      return false;
+    }
+
+    if (!DecodeMemory(file.GetData(), file.GetSize(), outData, outError))
+    {
+      outError += " : " + path;
+      return false;
+    }
+
+    return true;
+  }
+
+  bool DdsTextureDecoder::DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError)
+  {
+    DdsTextureView view{};
+    if (!DdsFormat::Parse(data, size, view, outError))
+    {
+      return false;
+    }
+
+    // サブリソースはファイル内で連続しているので、まとめてコピーしてオフセットはそのまま使う
+    outData.Desc = view.Desc;
+    outData.Pixels.assign(view.Data, view.Data + view.DataSize);
+    outData.Subresources = std::move(view.Subresources);
+    return true;
+  }
+}
@@ -0,0 +1,180 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Sorted draw packet queue with 64 bit sort keys (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Encode root signature in sort keys
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/DrawPacketQueue.h>
+
+#include <ThreadPool.h>
+
+#include <cmath>
+
+namespace
+{
+  // まだ何も設定していないことを表すID
+  constexpr uint32_t INVALID_ID = ~0u;
+
+  constexpr uint64_t fieldMask(uint32_t bits)
+  {
+    return (1ull << bits) - 1;
+  }
+}
+
+namespace MFramework
+{
+  uint64_t DrawSortKey::Make(uint32_t pass, DrawBucket bucket, uint32_t rootSignature, uint32_t pipelineState, uint32_t material, float depth)
+  {
+    const uint64_t passField = pass & fieldMask(PASS_BITS);
+    const uint64_t bucketField = static_cast<uint64_t>(bucket) & fieldMask(BUCKET_BITS);
+    const uint64_t rootSignatureField = rootSignature & fieldMask(ROOT_SIGNATURE_BITS);
+    const uint64_t pipelineStateField = pipelineState & fieldMask(PIPELINE_STATE_BITS);
+    const uint64_t materialField = material & fieldMask(MATERIAL_BITS);
+    const uint64_t depthField = QuantizeDepth(depth);
+
+    uint64_t key = (passField << (64 - PASS_BITS)) | (bucketField << (64 - PASS_BITS - BUCKET_BITS));
+    if (bucket == DrawBucket::Transparent)
+    {
+      // 奥から描くので深度を反転して最上位に置く
+      const uint64_t farFirstDepth = fieldMask(DEPTH_BITS) - depthField;
+      key |= (farFirstDepth << (ROOT_SIGNATURE_BITS + PIPELINE_STATE_BITS + MATERIAL_BITS)) | (rootSignatureField << (PIPELINE_STATE_BITS + MATERIAL_BITS)) | (pipelineStateField << MATERIAL_BITS) | materialField;
+    }
+    else
+    {
+      key |= (rootSignatureField << (PIPELINE_STATE_BITS + MATERIAL_BITS + DEPTH_BITS)) | (pipelineStateField << (MATERIAL_BITS + DEPTH_BITS)) | (materialField << DEPTH_BITS) | depthField;
+    }
+
+    return key;
+  }
+
+  uint32_t DrawSortKey::QuantizeDepth(float depth)
+  {
+    // NaNも0に寄せる
+    if (!(depth > 0.0f))
+    {
+      return 0;
+    }
+    if (depth >= 1.0f)
+    {
+      return static_cast<uint32_t>(fieldMask(DEPTH_BITS));
+    }
+
+    return static_cast<uint32_t>(std::lround(static_cast<double>(depth) * static_cast<double>(fieldMask(DEPTH_BITS))));
+  }
+
+  uint32_t DrawSortKey::GetPass(uint64_t key)
+  {
+    return static_cast<uint32_t>(key >> (64 - PASS_BITS));
+  }
+
+  DrawBucket DrawSortKey::GetBucket(uint64_t key)
+  {
+    return static_cast<DrawBucket>((key >> (64 - PASS_BITS - BUCKET_BITS)) & fieldMask(BUCKET_BITS));
+  }
+
+  DrawPacketQueue::DrawPacketQueue()
+    : m_packets()
+    , m_items()
+    , m_tempItems()
+  { }
+
+  DrawPacketQueue::~DrawPacketQueue()
+  {
+    Dispose();
+  }
+
+  void DrawPacketQueue::Reserve(size_t packetCount)
+  {
+    m_packets.reserve(packetCount);
+    m_items.reserve(packetCount);
+  }
+
+  void DrawPacketQueue::Submit(uint64_t sortKey, const DrawPacket& packet)
+  {
+    m_items.emplace_back(RadixSortItem{ sortKey, static_cast<uint32_t>(m_packets.size()), 0 });
+    m_packets.emplace_back(packet);
+  }
+
+  void DrawPacketQueue::Sort(ThreadPool* threadPool)
+  {
+    // 作業領域はフレームをまたいで使い回す
+    if (m_tempItems.size() < m_items.size())
+    {
+      m_tempItems.resize(m_items.size());
+    }
+
+    RadixSort::Sort(m_items.data(), m_items.size(), m_tempItems.data(), threadPool);
+  }
+
+  DrawPacketStats DrawPacketQueue::Translate(IDrawPacketBackend& backend) const
+  {
+    DrawPacketStats stats{};
+    stats.PacketCount = static_cast<uint32_t>(m_items.size());
+
+    uint32_t currentRootSignature = INVALID_ID;
+    uint32_t currentPipelineState = INVALID_ID;
+    uint32_t currentMaterial = INVALID_ID;
+    uint32_t currentMesh = INVALID_ID;
+    for (const RadixSortItem& item : m_items)
+    {
+      const DrawPacket& packet = m_packets[item.Value];
+
+      if (packet.RootSignature != currentRootSignature)
+      {
+        backend.SetRootSignature(packet.RootSignature);
+        currentRootSignature = packet.RootSignature;
+        currentMaterial = INVALID_ID;
+        ++stats.RootSignatureChangeCount;
+      }
+      if (packet.PipelineState != currentPipelineState)
+      {
+        backend.SetPipelineState(packet.PipelineState);
+        currentPipelineState = packet.PipelineState;
+        ++stats.PipelineStateChangeCount;
+      }
+      if (packet.Material != currentMaterial)
+      {
+        backend.SetMaterial(packet.Material);
+        currentMaterial = packet.Material;
+        ++stats.MaterialChangeCount;
+      }
+      if (packet.Mesh != currentMesh)
+      {
+        backend.SetMesh(packet.Mesh);
+        currentMesh = packet.Mesh;
+        ++stats.MeshChangeCount;
+      }
+
+      backend.Draw(packet.InstanceCount, packet.InstanceDataOffset);
+    }
+
+    return stats;
+  }
+
+  void DrawPacketQueue::Clear()
+  {
+    // 容量は次のフレームのために残す
+    m_packets.clear();
+    m_items.clear();
+  }
+
+  void DrawPacketQueue::Dispose() noexcept
+  {
+    m_packets.clear();
+    m_packets.shrink_to_fit();
+    m_items.clear();
+    m_items.shrink_to_fit();
+    m_tempItems.clear();
+    m_tempItems.shrink_to_fit();
+  }
+}
@@ -0,0 +1,1031 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : glTF 2.0 mesh importer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/GltfMeshImporter.h>
+
+#include <MappedFile.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+  constexpr uint32_t GLB_MAGIC = 0x46546c67;              // "glTF"
+  constexpr uint32_t GLB_VERSION = 2;
+  constexpr uint32_t GLB_CHUNK_JSON = 0x4e4f534a;         // "JSON"
+  constexpr uint32_t GLB_CHUNK_BIN = 0x004e4942;          // "BIN\0"
+  constexpr size_t GLB_HEADER_SIZE = 12;
+  constexpr size_t GLB_CHUNK_HEADER_SIZE = 8;
+
+  constexpr uint32_t COMPONENT_UNSIGNED_BYTE = 5121;
+  constexpr uint32_t COMPONENT_UNSIGNED_SHORT = 5123;
+  constexpr uint32_t COMPONENT_UNSIGNED_INT = 5125;
+  constexpr uint32_t COMPONENT_FLOAT = 5126;
+  constexpr uint32_t PRIMITIVE_MODE_TRIANGLES = 4;
+
+  // 入れ子が深すぎる入力でスタックを使い切らないようにする
+  constexpr uint32_t MAX_JSON_DEPTH = 64;
+
+  /// @brief
+  /// glTFを読むのに必要なだけのJSONの値
+  struct JsonValue
+  {
+    enum class Type : uint8_t
+    {
+      Null,
+      Bool,
+      Number,
+      String,
+      Array,
+      Object,
+    };
+
+    Type Kind = Type::Null;
+    bool Boolean = false;
+    double Number = 0.0;
+    std::string String;
+    std::vector<JsonValue> Elements;
+    std::vector<std::pair<std::string, JsonValue>> Members;
+
+    const JsonValue* Find(std::string_view key) const
+    {
+      if (Kind != Type::Object)
+      {
+        return nullptr;
+      }
+      for (const auto& member : Members)
+      {
+        if (member.first == key)
+        {
+          return &member.second;
+        }
+      }
+      return nullptr;
+    }
+
+    const JsonValue* At(size_t index) const
+    {
+      return (Kind == Type::Array && index < Elements.size()) ? &Elements[index] : nullptr;
+    }
+  };
+
+  class JsonReader
+  {
+    public:
+      JsonReader(const char* begin, const char* end)
+        : m_cursor(begin)
+        , m_end(end)
+      { }
+
+      bool Parse(JsonValue& outValue)
+      {
+        if (!parseValue(outValue, 0))
+        {
+          return false;
+        }
+        skipSpace();
+        return m_cursor == m_end;
+      }
+
+    private:
+      void skipSpace()
+      {
+        while (m_cursor < m_end && (*m_cursor == ' ' || *m_cursor == '\t' || *m_cursor == '\r' || *m_cursor == '\n'))
+        {
+          ++m_cursor;
+        }
+      }
+
+      bool consume(const char* literal)
+      {
+        const size_t length = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_cursor) < length || std::memcmp(m_cursor, literal, length) != 0)
+        {
+          return false;
+        }
+        m_cursor += length;
+        return true;
+      }
+
+      bool parseHex4(uint32_t& outValue)
+      {
+        if (m_end - m_cursor < 4)
+        {
+          return false;
+        }
+
+        outValue = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+          const char c = *m_cursor++;
+          uint32_t digit = 0;
+          if (c >= '0' && c <= '9')
+          {
+            digit = static_cast<uint32_t>(c - '0');
+          }
+          else if (c >= 'a' && c <= 'f')
+          {
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+          }
+          else if (c >= 'A' && c <= 'F')
+          {
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+          }
+          else
+          {
+            return false;
+          }
+          outValue = (outValue << 4) | digit;
+        }
+        return true;
+      }
+
+      static void appendUtf8(std::string& text, uint32_t codePoint)
+      {
+        if (codePoint < 0x80)
+        {
+          text += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+          text += static_cast<char>(0xc0 | (codePoint >> 6));
+          text += static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+        else if (codePoint < 0x10000)
+        {
+          text += static_cast<char>(0xe0 | (codePoint >> 12));
+          text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+          text += static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+        else
+        {
+          text += static_cast<char>(0xf0 | (codePoint >> 18));
+          text += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+          text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+          text += static_cast<char>(0x80 | (codePoint & 0x3f));
+        }
+      }
+
+      bool parseString(std::string& outText)
+      {
+        // 呼び出し側で先頭の'"'を確認している
+        ++m_cursor;
+        outText.clear();
+        while (m_cursor < m_end)
+        {
+          const char c = *m_cursor++;
+          if (c == '"')
+          {
+            return true;
+          }
+          if (c != '\\')
+          {
+            outText += c;
+            continue;
+          }
+
+          if (m_cursor == m_end)
+          {
+            return false;
+          }
+
+          const char escape = *m_cursor++;
+          switch (escape)
+          {
+            case '"':  outText += '"';  break;
+            case '\\': outText += '\\'; break;
+            case '/':  outText += '/';  break;
+            case 'b':  outText += '\b'; break;
+            case 'f':  outText += '\f'; break;
+            case 'n':  outText += '\n'; break;
+            case 'r':  outText += '\r'; break;
+            case 't':  outText += '\t'; break;
+            case 'u':
+            {
+              uint32_t codePoint = 0;
+              if (!parseHex4(codePoint))
+              {
+                return false;
+              }
+
+              // サロゲートペア
+              if (codePoint >= 0xd800 && codePoint < 0xdc00)
+              {
+                uint32_t low = 0;
+                if (!consume("\\u") || !parseHex4(low) || low < 0xdc00 || low >= 0xe000)
+                {
+                  return false;
+                }
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+              }
+              appendUtf8(outText, codePoint);
+              break;
+            }
+            default:
+              return false;
+          }
+        }
+
+        return false;
+      }
+
+      bool parseNumber(double& outNumber)
+      {
+        const char* begin = m_cursor;
+        while (m_cursor < m_end && (std::strchr("+-0123456789.eE", *m_cursor) != nullptr))
+        {
+          ++m_cursor;
+        }
+
+        const std::string text(begin, m_cursor);
+        if (text.empty())
+        {
+          return false;
+        }
+
+        char* end = nullptr;
+        outNumber = std::strtod(text.c_str(), &end);
+        return end == text.c_str() + text.size();
+      }
+
+      bool parseValue(JsonValue& outValue, uint32_t depth)
+      {
+        skipSpace();
+        if (m_cursor == m_end || depth > MAX_JSON_DEPTH)
+        {
+          return false;
+        }
+
+        const char c = *m_cursor;
+        if (c == '{')
+        {
+          ++m_cursor;
+          outValue.Kind = JsonValue::Type::Object;
+          skipSpace();
+          if (m_cursor < m_end && *m_cursor == '}')
+          {
+            ++m_cursor;
+            return true;
+          }
+
+          for (;;)
+          {
+            skipSpace();
+            if (m_cursor == m_end || *m_cursor != '"')
+            {
+              return false;
+            }
+
+            outValue.Members.emplace_back();
+            if (!parseString(outValue.Members.back().first))
+            {
+              return false;
+            }
+
+            skipSpace();
+            if (m_cursor == m_end || *m_cursor++ != ':' || !parseValue(outValue.Members.back().second, depth + 1))
+            {
+              return false;
+            }
+
+            skipSpace();
+            if (m_cursor == m_end)
+            {
+              return false;
+            }
+            const char separator = *m_cursor++;
+            if (separator == '}')
+            {
+              return true;
+            }
+            if (separator != ',')
+            {
+              return false;
+            }
+          }
+        }
+
+        if (c == '[')
+        {
+          ++m_cursor;
+          outValue.Kind = JsonValue::Type::Array;
+          skipSpace();
+          if (m_cursor < m_end && *m_cursor == ']')
+          {
+            ++m_cursor;
+            return true;
+          }
+
+          for (;;)
+          {
+            outValue.Elements.emplace_back();
+            if (!parseValue(outValue.Elements.back(), depth + 1))
+            {
+              return false;
+            }
+
+            skipSpace();
+            if (m_cursor == m_end)
+            {
+              return false;
+            }
+            const char separator = *m_cursor++;
+            if (separator == ']')
+            {
+              return true;
+            }
+            if (separator != ',')
+            {
+              return false;
+            }
+          }
+        }
+
+        if (c == '"')
+        {
+          outValue.Kind = JsonValue::Type::String;
+          return parseString(outValue.String);
+        }
+
+        if (consume("true"))
+        {
+          outValue.Kind = JsonValue::Type::Bool;
+          outValue.Boolean = true;
+          return true;
+        }
+
+        if (consume("false"))
+        {
+          outValue.Kind = JsonValue::Type::Bool;
+          return true;
+        }
+
+        if (consume("null"))
+        {
+          outValue.Kind = JsonValue::Type::Null;
+          return true;
+        }
+
+        outValue.Kind = JsonValue::Type::Number;
+        return parseNumber(outValue.Number);
+      }
+
+    private:
+      const char* m_cursor;
+      const char* m_end;
+  };
+
+  /// @brief
+  /// 0以上の整数のメンバーを取り出す(無ければdefaultValue)
+  bool getIndex(const JsonValue& object, std::string_view key, uint64_t& outValue, uint64_t defaultValue, bool isRequired = false)
+  {
+    const JsonValue* value = object.Find(key);
+    if (value == nullptr)
+    {
+      outValue = defaultValue;
+      return !isRequired;
+    }
+
+    if (value->Kind != JsonValue::Type::Number || value->Number < 0.0 || value->Number > 9.0e15 || std::floor(value->Number) != value->Number)
+    {
+      return false;
+    }
+
+    outValue = static_cast<uint64_t>(value->Number);
+    return true;
+  }
+
+  std::string getString(const JsonValue* object, std::string_view key)
+  {
+    const JsonValue* value = (object != nullptr) ? object->Find(key) : nullptr;
+    return (value != nullptr && value->Kind == JsonValue::Type::String) ? value->String : std::string();
+  }
+
+  bool decodeBase64(std::string_view text, std::vector<uint8_t>& outData)
+  {
+    auto decodeChar = [](char c) -> int
+    {
+      if (c >= 'A' && c <= 'Z') return c - 'A';
+      if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+      if (c >= '0' && c <= '9') return c - '0' + 52;
+      if (c == '+' || c == '-') return 62;
+      if (c == '/' || c == '_') return 63;
+      return -1;
+    };
+
+    outData.clear();
+    outData.reserve(text.size() / 4 * 3);
+
+    uint32_t bits = 0;
+    int bitCount = 0;
+    for (const char c : text)
+    {
+      if (c == '=')
+      {
+        break;
+      }
+
+      const int value = decodeChar(c);
+      if (value < 0)
+      {
+        return false;
+      }
+
+      bits = (bits << 6) | static_cast<uint32_t>(value);
+      bitCount += 6;
+      if (bitCount >= 8)
+      {
+        bitCount -= 8;
+        outData.emplace_back(static_cast<uint8_t>((bits >> bitCount) & 0xff));
+      }
+    }
+
+    return true;
+  }
+
+  /// @brief
+  /// URIの%エスケープを戻す
+  std::string decodeUri(std::string_view uri)
+  {
+    std::string path;
+    path.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i)
+    {
+      if (uri[i] == '%' && i + 2 < uri.size())
+      {
+        const std::string hex(uri.substr(i + 1, 2));
+        char* end = nullptr;
+        const long value = std::strtol(hex.c_str(), &end, 16);
+        if (end == hex.c_str() + 2)
+        {
+          path += static_cast<char>(value);
+          i += 2;
+          continue;
+        }
+      }
+      path += uri[i];
+    }
+    return path;
+  }
+
+  // パスはUTF-8として扱う(MappedFileと同じ)
+  std::filesystem::path toPath(const std::string& utf8Path)
+  {
+    return std::filesystem::path(std::u8string(utf8Path.begin(), utf8Path.end()));
+  }
+
+  std::string toUtf8(const std::filesystem::path& path)
+  {
+    const std::u8string utf8Path = path.u8string();
+    return std::string(utf8Path.begin(), utf8Path.end());
+  }
+
+  struct BufferData
+  {
+    const uint8_t* Data;
+    size_t Size;
+  };
+
+  /// @brief
+  /// アクセサーが指す要素の位置
+  struct AccessorView
+  {
+    const uint8_t* Data;
+    size_t Count;
+    size_t Stride;
+    uint32_t ComponentType;
+    uint32_t ComponentCount;
+    bool IsNormalized;
+  };
+
+  class GltfDocument
+  {
+    public:
+      bool Load(const std::string& path, std::string& outError)
+      {
+        if (!m_file.Open(path))
+        {
+          outError = "cannot open " + path;
+          return false;
+        }
+
+        const uint8_t* data = m_file.GetData();
+        const size_t size = m_file.GetSize();
+
+        const char* jsonBegin = reinterpret_cast<const char*>(data);
+        const char* jsonEnd = jsonBegin + size;
+        BufferData binaryChunk{ nullptr, 0 };
+        bool hasBinaryChunk = false;
+
+        uint32_t magic = 0;
+        if (size >= sizeof(magic))
+        {
+          std::memcpy(&magic, data, sizeof(magic));
+        }
+
+        if (magic == GLB_MAGIC)
+        {
+          uint32_t header[3] = {};
+          if (size < GLB_HEADER_SIZE)
+          {
+            outError = "truncated glb header";
+            return false;
+          }
+          std::memcpy(header, data, sizeof(header));
+          if (header[1] != GLB_VERSION || header[2] > size)
+          {
+            outError = "unsupported glb";
+            return false;
+          }
+
+          // チャンクは4バイト境界に並ぶ(最初がJSON、次があればBIN)
+          size_t offset = GLB_HEADER_SIZE;
+          bool hasJsonChunk = false;
+          while (offset + GLB_CHUNK_HEADER_SIZE <= header[2])
+          {
+            uint32_t chunk[2] = {};
+            std::memcpy(chunk, data + offset, sizeof(chunk));
+            offset += GLB_CHUNK_HEADER_SIZE;
+            if (chunk[0] > header[2] - offset)
+            {
+              outError = "glb chunk out of range";
+              return false;
+            }
+
+            if (chunk[1] == GLB_CHUNK_JSON && !hasJsonChunk)
+            {
+              jsonBegin = reinterpret_cast<const char*>(data + offset);
+              jsonEnd = jsonBegin + chunk[0];
+              hasJsonChunk = true;
+            }
+            else if (chunk[1] == GLB_CHUNK_BIN && !hasBinaryChunk)
+            {
+              binaryChunk = BufferData{ data + offset, chunk[0] };
+              hasBinaryChunk = true;
+            }
+            offset += (static_cast<size_t>(chunk[0]) + 3) & ~static_cast<size_t>(3);
+          }
+
+          if (!hasJsonChunk)
+          {
+            outError = "glb has no json chunk";
+            return false;
+          }
+        }
+
+        if (!JsonReader(jsonBegin, jsonEnd).Parse(m_root) || m_root.Kind != JsonValue::Type::Object)
+        {
+          outError = "invalid json";
+          return false;
+        }
+
+        return loadBuffers(path, hasBinaryChunk ? &binaryChunk : nullptr, outError);
+      }
+
+      const JsonValue& GetRoot() const
+      {
+        return m_root;
+      }
+
+      const JsonValue* GetElement(std::string_view arrayName, uint64_t index) const
+      {
+        const JsonValue* array = m_root.Find(arrayName);
+        return (array != nullptr) ? array->At(static_cast<size_t>(index)) : nullptr;
+      }
+
+      bool GetAccessor(uint64_t accessorIndex, AccessorView& outView, std::string& outError) const
+      {
+        const JsonValue* accessor = GetElement("accessors", accessorIndex);
+        if (accessor == nullptr)
+        {
+          outError = "invalid accessor " + std::to_string(accessorIndex);
+          return false;
+        }
+
+        if (accessor->Find("sparse") != nullptr)
+        {
+          outError = "sparse accessor is not supported";
+          return false;
+        }
+
+        uint64_t bufferViewIndex = 0;
+        uint64_t accessorOffset = 0;
+        uint64_t componentType = 0;
+        uint64_t count = 0;
+        if (!getIndex(*accessor, "bufferView", bufferViewIndex, 0, true) ||
+            !getIndex(*accessor, "byteOffset", accessorOffset, 0) ||
+            !getIndex(*accessor, "componentType", componentType, 0, true) ||
+            !getIndex(*accessor, "count", count, 0, true))
+        {
+          outError = "invalid accessor " + std::to_string(accessorIndex);
+          return false;
+        }
+
+        const std::string type = getString(accessor, "type");
+        uint32_t componentCount = 0;
+        if (type == "SCALAR")
+        {
+          componentCount = 1;
+        }
+        else if (type == "VEC2")
+        {
+          componentCount = 2;
+        }
+        else if (type == "VEC3")
+        {
+          componentCount = 3;
+        }
+        else if (type == "VEC4")
+        {
+          componentCount = 4;
+        }
+        else
+        {
+          outError = "unsupported accessor type " + type;
+          return false;
+        }
+
+        uint32_t componentSize = 0;
+        switch (componentType)
+        {
+          case COMPONENT_UNSIGNED_BYTE:   componentSize = 1; break;
+          case COMPONENT_UNSIGNED_SHORT:  componentSize = 2; break;
+          case COMPONENT_UNSIGNED_INT:    componentSize = 4; break;
+          case COMPONENT_FLOAT:           componentSize = 4; break;
+          default:
+            outError = "unsupported component type " + std::to_string(componentType);
+            return false;
+        }
+
+        const JsonValue* bufferView = GetElement("bufferViews", bufferViewIndex);
+        uint64_t bufferIndex = 0;
+        uint64_t viewOffset = 0;
+        uint64_t viewLength = 0;
+        uint64_t viewStride = 0;
+        if (bufferView == nullptr ||
+            !getIndex(*bufferView, "buffer", bufferIndex, 0, true) ||
+            !getIndex(*bufferView, "byteOffset", viewOffset, 0) ||
+            !getIndex(*bufferView, "byteLength", viewLength, 0, true) ||
+            !getIndex(*bufferView, "byteStride", viewStride, 0) ||
+            bufferIndex >= m_buffers.size())
+        {
+          outError = "invalid buffer view " + std::to_string(bufferViewIndex);
+          return false;
+        }
+
+        const BufferData& buffer = m_buffers[static_cast<size_t>(bufferIndex)];
+        const uint64_t elementSize = static_cast<uint64_t>(componentSize) * componentCount;
+        const uint64_t stride = (viewStride != 0) ? viewStride : elementSize;
+        if (viewOffset > buffer.Size || viewLength > buffer.Size - viewOffset ||
+            (count > 0 && (accessorOffset > viewLength || stride < elementSize || count - 1 > (viewLength - accessorOffset) / stride ||
+                           (count - 1) * stride + elementSize > viewLength - accessorOffset)))
+        {
+          outError = "accessor out of range " + std::to_string(accessorIndex);
+          return false;
+        }
+
+        const JsonValue* normalized = accessor->Find("normalized");
+        outView.Data = buffer.Data + viewOffset + accessorOffset;
+        outView.Count = static_cast<size_t>(count);
+        outView.Stride = static_cast<size_t>(stride);
+        outView.ComponentType = static_cast<uint32_t>(componentType);
+        outView.ComponentCount = componentCount;
+        outView.IsNormalized = (normalized != nullptr && normalized->Kind == JsonValue::Type::Bool && normalized->Boolean);
+        return true;
+      }
+
+    private:
+      bool loadBuffers(const std::string& path, const BufferData* binaryChunk, std::string& outError)
+      {
+        const JsonValue* buffers = m_root.Find("buffers");
+        if (buffers == nullptr)
+        {
+          return true;
+        }
+
+        m_buffers.reserve(buffers->Elements.size());
+        for (size_t i = 0; i < buffers->Elements.size(); ++i)
+        {
+          const JsonValue& buffer = buffers->Elements[i];
+          uint64_t byteLength = 0;
+          if (!getIndex(buffer, "byteLength", byteLength, 0, true))
+          {
+            outError = "invalid buffer " + std::to_string(i);
+            return false;
+          }
+
+          const std::string uri = getString(&buffer, "uri");
+          BufferData data{ nullptr, 0 };
+          if (uri.empty())
+          {
+            // GLBの最初のバッファーはBINチャンクを指す
+            if (i != 0 || binaryChunk == nullptr)
+            {
+              outError = "buffer " + std::to_string(i) + " has no data";
+              return false;
+            }
+            data = *binaryChunk;
+          }
+          else if (uri.compare(0, 5, "data:") == 0)
+          {
+            const size_t dataPosition = uri.find(";base64,");
+            m_ownedBuffers.emplace_back();
+            if (dataPosition == std::string::npos || !decodeBase64(std::string_view(uri).substr(dataPosition + 8), m_ownedBuffers.back()))
+            {
+              outError = "invalid data uri in buffer " + std::to_string(i);
+              return false;
+            }
+            data = BufferData{ m_ownedBuffers.back().data(), m_ownedBuffers.back().size() };
+          }
+          else
+          {
+            const std::string bufferPath = toUtf8(toPath(path).parent_path() / toPath(decodeUri(uri)));
+            m_bufferFiles.emplace_back();
+            if (!m_bufferFiles.back().Open(bufferPath))
+            {
+              outError = "cannot open " + bufferPath;
+              return false;
+            }
+            data = BufferData{ m_bufferFiles.back().GetData(), m_bufferFiles.back().GetSize() };
+          }
+
+          if (data.Size < byteLength)
+          {
+            outError = "buffer " + std::to_string(i) + " is too small";
+            return false;
+          }
+
+          data.Size = static_cast<size_t>(byteLength);
+          m_buffers.emplace_back(data);
+        }
+
+        return true;
+      }
+
+    private:
+      MFramework::MappedFile m_file;
+      JsonValue m_root;
+      std::vector<BufferData> m_buffers;
+      std::deque<std::vector<uint8_t>> m_ownedBuffers;     // 要素のアドレスが変わらないようにdequeで持つ
+      std::deque<MFramework::MappedFile> m_bufferFiles;
+  };
+
+  /// @brief
+  /// 要素一つの成分をfloatで読む(正規化整数は0から1へ)
+  void readFloats(const AccessorView& view, size_t index, float* outValues, uint32_t count)
+  {
+    const uint8_t* element = view.Data + view.Stride * index;
+    for (uint32_t i = 0; i < count && i < view.ComponentCount; ++i)
+    {
+      switch (view.ComponentType)
+      {
+        case COMPONENT_FLOAT:
+          std::memcpy(&outValues[i], element + i * 4, sizeof(float));
+          break;
+        case COMPONENT_UNSIGNED_BYTE:
+          outValues[i] = static_cast<float>(element[i]) / (view.IsNormalized ? 255.0f : 1.0f);
+          break;
+        case COMPONENT_UNSIGNED_SHORT:
+        {
+          uint16_t value = 0;
+          std::memcpy(&value, element + i * 2, sizeof(value));
+          outValues[i] = static_cast<float>(value) / (view.IsNormalized ? 65535.0f : 1.0f);
+          break;
+        }
+        default:
+        {
+          uint32_t value = 0;
+          std::memcpy(&value, element + i * 4, sizeof(value));
+          outValues[i] = static_cast<float>(value);
+          break;
+        }
+      }
+    }
+  }
+
+  uint32_t readIndex(const AccessorView& view, size_t index)
+  {
+    const uint8_t* element = view.Data + view.Stride * index;
+    switch (view.ComponentType)
+    {
+      case COMPONENT_UNSIGNED_BYTE:
+        return element[0];
+      case COMPONENT_UNSIGNED_SHORT:
+      {
+        uint16_t value = 0;
+        std::memcpy(&value, element, sizeof(value));
+        return value;
+      }
+      default:
+      {
+        uint32_t value = 0;
+        std::memcpy(&value, element, sizeof(value));
+        return value;
+      }
+    }
+  }
+
+  bool importPrimitive(const GltfDocument& document, const JsonValue& primitive, MFramework::MeshData& outMesh, std::string& outError)
+  {
+    const JsonValue* attributes = primitive.Find("attributes");
+    uint64_t positionAccessor = 0;
+    if (attributes == nullptr || !getIndex(*attributes, "POSITION", positionAccessor, 0, true))
+    {
+      outError = "primitive has no POSITION";
+      return false;
+    }
+
+    AccessorView positions{};
+    if (!document.GetAccessor(positionAccessor, positions, outError))
+    {
+      return false;
+    }
+    if (positions.ComponentType != COMPONENT_FLOAT || positions.ComponentCount != 3)
+    {
+      outError = "POSITION must be float3";
+      return false;
+    }
+
+    AccessorView normals{};
+    AccessorView texCoords{};
+    uint64_t accessorIndex = 0;
+    const bool hasNormal = (attributes->Find("NORMAL") != nullptr);
+    const bool hasTexCoord = (attributes->Find("TEXCOORD_0") != nullptr);
+    if (hasNormal && (!getIndex(*attributes, "NORMAL", accessorIndex, 0) || !document.GetAccessor(accessorIndex, normals, outError)))
+    {
+      return false;
+    }
+    if (hasTexCoord && (!getIndex(*attributes, "TEXCOORD_0", accessorIndex, 0) || !document.GetAccessor(accessorIndex, texCoords, outError)))
+    {
+      return false;
+    }
+    if ((hasNormal && (normals.Count != positions.Count || normals.ComponentType != COMPONENT_FLOAT || normals.ComponentCount != 3)) ||
+        (hasTexCoord && (texCoords.Count != positions.Count || texCoords.ComponentCount != 2 || texCoords.ComponentType == COMPONENT_UNSIGNED_INT)))
+    {
+      outError = "invalid NORMAL or TEXCOORD_0";
+      return false;
+    }
+
+    outMesh.HasNormals = hasNormal;
+    outMesh.Vertices.resize(positions.Count);
+    for (size_t i = 0; i < positions.Count; ++i)
+    {
+      MFramework::MeshVertex& vertex = outMesh.Vertices[i];
+      vertex = MFramework::MeshVertex{};
+      readFloats(positions, i, vertex.Position, 3);
+      vertex.Position[2] = -vertex.Position[2];
+      if (hasNormal)
+      {
+        readFloats(normals, i, vertex.Normal, 3);
+        vertex.Normal[2] = -vertex.Normal[2];
+      }
+      if (hasTexCoord)
+      {
+        // glTFのテクスチャ座標はD3Dと同じ左上原点
+        readFloats(texCoords, i, vertex.TexCoord, 2);
+      }
+    }
+
+    uint64_t indicesAccessor = 0;
+    if (primitive.Find("indices") != nullptr)
+    {
+      AccessorView indices{};
+      if (!getIndex(primitive, "indices", indicesAccessor, 0) || !document.GetAccessor(indicesAccessor, indices, outError))
+      {
+        return false;
+      }
+      if (indices.ComponentCount != 1 || indices.ComponentType == COMPONENT_FLOAT || indices.Count % 3 != 0)
+      {
+        outError = "invalid indices";
+        return false;
+      }
+
+      outMesh.Indices.resize(indices.Count);
+      for (size_t i = 0; i < indices.Count; ++i)
+      {
+        const uint32_t index = readIndex(indices, i);
+        if (index >= positions.Count)
+        {
+          outError = "index out of range";
+          return false;
+        }
+        outMesh.Indices[i] = index;
+      }
+    }
+    else
+    {
+      if (positions.Count % 3 != 0)
+      {
+        outError = "vertex count is not a multiple of 3";
+        return false;
+      }
+      outMesh.Indices.resize(positions.Count);
+      for (size_t i = 0; i < positions.Count; ++i)
+      {
+        outMesh.Indices[i] = static_cast<uint32_t>(i);
+      }
+    }
+
+    // 巻き順を反転する
+    for (size_t i = 0; i < outMesh.Indices.size(); i += 3)
+    {
+      std::swap(outMesh.Indices[i + 1], outMesh.Indices[i + 2]);
+    }
+
+    return true;
+  }
+}
+
+namespace MFramework
+{
+  bool GltfMeshImporter::Import(const std::string& path, std::vector<MeshData>& outMeshes, std::string& outError) const
+  {
+    outMeshes.clear();
+
+    GltfDocument document;
+    if (!document.Load(path, outError))
+    {
+      return false;
+    }
+
+    const JsonValue* meshes = document.GetRoot().Find("meshes");
+    if (meshes == nullptr || meshes->Kind != JsonValue::Type::Array)
+    {
+      outError = "no meshes";
+      return false;
+    }
+
+    for (size_t meshIndex = 0; meshIndex < meshes->Elements.size(); ++meshIndex)
+    {
+      const JsonValue& mesh = meshes->Elements[meshIndex];
+      const JsonValue* primitives = mesh.Find("primitives");
+      if (primitives == nullptr || primitives->Kind != JsonValue::Type::Array)
+      {
+        continue;
+      }
+
+      std::string meshName = getString(&mesh, "name");
+      if (meshName.empty())
+      {
+        meshName = "mesh_" + std::to_string(meshIndex);
+      }
+
+      for (const JsonValue& primitive : primitives->Elements)
+      {
+        // 線と点は読み飛ばす
+        uint64_t mode = 0;
+        if (!getIndex(primitive, "mode", mode, PRIMITIVE_MODE_TRIANGLES) || mode != PRIMITIVE_MODE_TRIANGLES)
+        {
+          continue;
+        }
+
+        MeshData meshData{};
+        meshData.Name = meshName;
+
+        uint64_t materialIndex = 0;
+        if (primitive.Find("material") != nullptr && getIndex(primitive, "material", materialIndex, 0))
+        {
+          meshData.MaterialName = getString(document.GetElement("materials", materialIndex), "name");
+          if (meshData.MaterialName.empty())
+          {
+            meshData.MaterialName = "material_" + std::to_string(materialIndex);
+          }
+        }
+
+        if (!importPrimitive(document, primitive, meshData, outError))
+        {
+          outError = meshName + " : " + outError;
+          outMeshes.clear();
+          return false;
+        }
+
+        outMeshes.emplace_back(std::move(meshData));
+      }
+    }
+
+    if (outMeshes.empty())
+    {
+      outError = "no triangle primitives";
+      return false;
+    }
+
+    return true;
+  }
+}
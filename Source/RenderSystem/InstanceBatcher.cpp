@@ -0,0 +1,245 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Instanced draw batching by mesh and material (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/InstanceBatcher.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  // インスタンスデータの先頭のアラインメント(ルートSRVのアドレスに使う)
+  constexpr uint64_t INSTANCE_DATA_ALIGNMENT = 16;
+
+  // まだまとまりを探していないことを表す番号
+  constexpr uint32_t INVALID_GROUP = ~0u;
+  // まとまりのハッシュ表の最小の大きさ(まとまりの数の2倍以上を保つ)
+  constexpr size_t MIN_GROUP_SLOT_COUNT = 64;
+
+  uint64_t makeKey(uint32_t mesh, uint32_t material)
+  {
+    return (static_cast<uint64_t>(mesh) << 32) | material;
+  }
+
+  size_t hashKey(uint64_t key, size_t slotMask)
+  {
+    // フィボナッチハッシュで上位ビットを混ぜる
+    const uint64_t hash = key * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash ^ (hash >> 32)) & slotMask;
+  }
+}
+
+namespace MFramework
+{
+  InstanceBatcher::InstanceBatcher()
+    : m_backend(nullptr)
+    , m_ring()
+    , m_instances()
+    , m_instanceGroups()
+    , m_groups()
+    , m_slotKeys()
+    , m_slotGroups()
+    , m_order()
+    , m_sortedGroups()
+    , m_lastKey(0)
+    , m_lastGroup(INVALID_GROUP)
+  { }
+
+  InstanceBatcher::~InstanceBatcher()
+  {
+    Dispose();
+  }
+
+  bool InstanceBatcher::Init(IInstanceDrawBackend* backend)
+  {
+    if (backend == nullptr || backend->GetInstanceMemory() == nullptr)
+    {
+      return false;
+    }
+
+    Dispose();
+    if (!m_ring.Init(backend->GetInstanceCapacity()))
+    {
+      return false;
+    }
+
+    m_backend = backend;
+    return true;
+  }
+
+  void InstanceBatcher::BeginFrame(uint64_t completedFenceValue)
+  {
+    m_ring.Release(completedFenceValue);
+  }
+
+  void InstanceBatcher::Submit(uint32_t mesh, uint32_t material, const float world[16], uint32_t materialIndex)
+  {
+    InstanceData& instance = m_instances.emplace_back();
+    std::memcpy(instance.World, world, sizeof(instance.World));
+    instance.MaterialIndex = materialIndex;
+    instance.Reserved[0] = 0;
+    instance.Reserved[1] = 0;
+    instance.Reserved[2] = 0;
+
+    // シーンの走査では同じものが続きやすいので、直前と同じなら探さない
+    const uint64_t key = makeKey(mesh, material);
+    if (m_lastGroup == INVALID_GROUP || key != m_lastKey)
+    {
+      m_lastKey = key;
+      m_lastGroup = findGroup(key);
+    }
+
+    ++m_groups[m_lastGroup].InstanceCount;
+    m_instanceGroups.emplace_back(m_lastGroup);
+  }
+
+  InstanceBatchStats InstanceBatcher::Flush()
+  {
+    InstanceBatchStats stats{};
+    stats.SubmittedCount = static_cast<uint32_t>(m_instances.size());
+    if (m_backend == nullptr || m_instances.empty())
+    {
+      stats.DroppedCount = stats.SubmittedCount;
+      clearSubmissions();
+      return stats;
+    }
+
+    // まとまりの数はオブジェクト数よりずっと少ないので、まとまりだけをメッシュ、マテリアルの順に並べる
+    const uint32_t groupCount = static_cast<uint32_t>(m_groups.size());
+    m_sortedGroups.resize(groupCount);
+    for (uint32_t i = 0; i < groupCount; ++i)
+    {
+      m_sortedGroups[i] = i;
+    }
+    std::sort(
+                m_sortedGroups.begin(),
+                m_sortedGroups.end(),
+                [this](uint32_t lhs, uint32_t rhs)
+                {
+                  return m_groups[lhs].Key < m_groups[rhs].Key;
+                }
+              );
+
+    // 数え上げでインスタンスをまとまりの順に並べる(同じまとまりの中はSubmitした順のまま)
+    uint32_t firstOrder = 0;
+    for (const uint32_t group : m_sortedGroups)
+    {
+      m_groups[group].FirstOrder = firstOrder;
+      firstOrder += m_groups[group].InstanceCount;
+    }
+
+    m_order.resize(m_instances.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_instanceGroups.size()); ++i)
+    {
+      m_order[m_groups[m_instanceGroups[i]].FirstOrder++] = i;
+    }
+
+    uint8_t* memory = m_backend->GetInstanceMemory();
+    uint32_t order = 0;
+    for (const uint32_t groupIndex : m_sortedGroups)
+    {
+      const Group& group = m_groups[groupIndex];
+      const uint32_t instanceCount = group.InstanceCount;
+      const uint32_t firstInstance = order;
+      order += instanceCount;
+
+      const uint64_t offset = m_ring.Allocate(instanceCount * sizeof(InstanceData), INSTANCE_DATA_ALIGNMENT);
+      if (offset == StagingRing::INVALID_OFFSET)
+      {
+        // 前のフレームがまだ使っていて入らないまとまりは描画しない
+        stats.DroppedCount += instanceCount;
+        continue;
+      }
+
+      // まとまりの中を連続して詰める(アップロードヒープには順に書き込むだけにする)
+      InstanceData* dst = reinterpret_cast<InstanceData*>(memory + offset);
+      for (uint32_t i = firstInstance; i < order; ++i)
+      {
+        std::memcpy(dst++, &m_instances[m_order[i]], sizeof(InstanceData));
+      }
+
+      InstanceDrawCommand command{};
+      command.Mesh = static_cast<uint32_t>(group.Key >> 32);
+      command.Material = static_cast<uint32_t>(group.Key);
+      command.InstanceCount = instanceCount;
+      command.InstanceDataOffset = offset;
+      m_backend->DrawInstanced(command);
+      ++stats.DrawCount;
+    }
+
+    clearSubmissions();
+    return stats;
+  }
+
+  void InstanceBatcher::EndFrame(uint64_t signaledFenceValue)
+  {
+    m_ring.Commit(signaledFenceValue);
+  }
+
+  void InstanceBatcher::Dispose() noexcept
+  {
+    m_backend = nullptr;
+    m_ring.Dispose();
+    clearSubmissions();
+  }
+
+  uint32_t InstanceBatcher::findGroup(uint64_t key)
+  {
+    // 半分より埋まったら大きくして入れ直す
+    if ((m_groups.size() + 1) * 2 > m_slotGroups.size())
+    {
+      const size_t slotCount = std::max(MIN_GROUP_SLOT_COUNT, m_slotGroups.size() * 2);
+      m_slotKeys.assign(slotCount, 0);
+      m_slotGroups.assign(slotCount, INVALID_GROUP);
+      for (uint32_t group = 0; group < static_cast<uint32_t>(m_groups.size()); ++group)
+      {
+        size_t slot = hashKey(m_groups[group].Key, slotCount - 1);
+        while (m_slotGroups[slot] != INVALID_GROUP)
+        {
+          slot = (slot + 1) & (slotCount - 1);
+        }
+        m_slotKeys[slot] = m_groups[group].Key;
+        m_slotGroups[slot] = group;
+      }
+    }
+
+    const size_t slotMask = m_slotGroups.size() - 1;
+    size_t slot = hashKey(key, slotMask);
+    while (m_slotGroups[slot] != INVALID_GROUP)
+    {
+      if (m_slotKeys[slot] == key)
+      {
+        return m_slotGroups[slot];
+      }
+      slot = (slot + 1) & slotMask;
+    }
+
+    const uint32_t group = static_cast<uint32_t>(m_groups.size());
+    m_groups.emplace_back(Group{ key, 0, 0 });
+    m_slotKeys[slot] = key;
+    m_slotGroups[slot] = group;
+    return group;
+  }
+
+  void InstanceBatcher::clearSubmissions()
+  {
+    // 容量は次のフレームのために残す
+    m_instances.clear();
+    m_instanceGroups.clear();
+    m_groups.clear();
+    std::fill(m_slotGroups.begin(), m_slotGroups.end(), INVALID_GROUP);
+    m_lastGroup = INVALID_GROUP;
+  }
+}
@@ -0,0 +1,54 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Screen space error based mesh LOD selection (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MeshLodSelector.h>
+
+#include <RenderSystem/Camera.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace MFramework
+{
+  float MeshLodSelector::ComputeScreenError(float error, const float center[3], float radius, float scale, const MGameEngine::Camera& camera, float viewportHeight)
+  {
+    const float* position = camera.GetPosition();
+    const float offset[3] = { center[0] - position[0], center[1] - position[1], center[2] - position[2] };
+    const float distance = std::sqrt(offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+
+    // 球の中にカメラが入っている場合は近クリップ面の距離で見る
+    const float nearestDistance = std::max(distance - radius * scale, camera.GetNearZ());
+    return error * scale * camera.GetProjectionScale(viewportHeight) / nearestDistance;
+  }
+
+  uint32_t MeshLodSelector::Select(const float* lodErrors, uint32_t lodCount, const float center[3], float radius, float scale, const MGameEngine::Camera& camera, float viewportHeight, float maxPixelError)
+  {
+    // 同じ距離では誤差に比例するので、ピクセル数に直す係数を一度だけ求める
+    const float pixelsPerError = ComputeScreenError(1.0f, center, radius, scale, camera, viewportHeight);
+
+    // レベルが粗くなるほど誤差は大きくなるので、超えた時点で止める
+    uint32_t level = 0;
+    for (uint32_t i = 1; i < lodCount; ++i)
+    {
+      if (lodErrors[i] * pixelsPerError > maxPixelError)
+      {
+        break;
+      }
+      level = i;
+    }
+
+    return level;
+  }
+}
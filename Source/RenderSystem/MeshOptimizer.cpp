@@ -0,0 +1,595 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Mesh vertex cache, overdraw and vertex fetch optimizer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MeshOptimizer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+  // Forsythのスコア関数のパラメーター(論文の値)
+  constexpr uint32_t CACHE_SIZE = MFramework::MeshOptimizer::DEFAULT_CACHE_SIZE;
+  constexpr float CACHE_DECAY_POWER = 1.5f;
+  constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+  constexpr float VALENCE_BOOST_SCALE = 2.0f;
+  constexpr float VALENCE_BOOST_POWER = 0.5f;
+  constexpr uint32_t MAX_VALENCE_SCORE = 64;
+
+  /// @brief
+  /// 頂点スコアの表(キャッシュ位置と残りの三角形数ごと)
+  struct VertexScoreTable
+  {
+    float Cache[CACHE_SIZE];
+    float Valence[MAX_VALENCE_SCORE + 1];
+
+    VertexScoreTable()
+    {
+      for (uint32_t i = 0; i < CACHE_SIZE; ++i)
+      {
+        // 直前の三角形の頂点は同じ値にして、次の三角形の選択が向きに偏らないようにする
+        Cache[i] = (i < 3) ? LAST_TRIANGLE_SCORE : std::pow(1.0f - static_cast<float>(i - 3) / static_cast<float>(CACHE_SIZE - 3), CACHE_DECAY_POWER);
+      }
+
+      Valence[0] = 0.0f;
+      for (uint32_t i = 1; i <= MAX_VALENCE_SCORE; ++i)
+      {
+        Valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+      }
+    }
+  };
+
+  const VertexScoreTable& getScoreTable()
+  {
+    static const VertexScoreTable table;
+    return table;
+  }
+
+  float computeVertexScore(const VertexScoreTable& table, int32_t cachePosition, uint32_t liveTriangleCount)
+  {
+    // 残りの三角形が無い頂点はもう選ばれない
+    if (liveTriangleCount == 0)
+    {
+      return -1.0f;
+    }
+
+    const float cacheScore = (cachePosition >= 0) ? table.Cache[cachePosition] : 0.0f;
+    return cacheScore + table.Valence[std::min(liveTriangleCount, MAX_VALENCE_SCORE)];
+  }
+
+  /// @brief
+  /// タイムスタンプで表したFIFOキャッシュ(要素を動かさずに当たり判定できる)
+  class FifoCacheSimulator
+  {
+    public:
+      FifoCacheSimulator(size_t vertexCount, uint32_t cacheSize)
+        : m_timestamps(vertexCount, 0)
+        , m_time(cacheSize + 1)
+        , m_cacheSize(cacheSize)
+      { }
+
+      /// @brief
+      /// 三角形一つを通して外れた頂点数を返す
+      uint32_t Simulate(const uint32_t* triangle)
+      {
+        uint32_t missCount = 0;
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+          const uint32_t vertex = triangle[corner];
+          if (m_time - m_timestamps[vertex] > m_cacheSize)
+          {
+            m_timestamps[vertex] = m_time++;
+            ++missCount;
+          }
+        }
+        return missCount;
+      }
+
+      /// @brief
+      /// キャッシュを空にする
+      void Flush()
+      {
+        m_time += m_cacheSize + 1;
+      }
+
+    private:
+      std::vector<uint32_t> m_timestamps;
+      uint32_t m_time;
+      uint32_t m_cacheSize;
+  };
+
+  struct Float3
+  {
+    float X, Y, Z;
+  };
+
+  Float3 subtract(const float* a, const float* b)
+  {
+    return Float3{ a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+  }
+
+  Float3 cross(const Float3& a, const Float3& b)
+  {
+    return Float3{ a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+  }
+
+  /// @brief
+  /// 面積の2倍の長さを持つ面の法線(時計回りが表の左手座標系で表側を向く)
+  Float3 computeFaceNormal(const MFramework::MeshVertex& v0, const MFramework::MeshVertex& v1, const MFramework::MeshVertex& v2)
+  {
+    return cross(subtract(v1.Position, v0.Position), subtract(v2.Position, v0.Position));
+  }
+
+  /// @brief
+  /// 頂点を比べるためのキー(-0を+0にそろえる)
+  MFramework::MeshVertex makeVertexKey(const MFramework::MeshVertex& vertex)
+  {
+    MFramework::MeshVertex key = vertex;
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+      key.Position[i] += 0.0f;
+      key.Normal[i] += 0.0f;
+    }
+    key.TexCoord[0] += 0.0f;
+    key.TexCoord[1] += 0.0f;
+    return key;
+  }
+
+  /// @brief
+  /// 頂点のハッシュ(4バイト単位で混ぜる、バイト単位のFNVより速い)
+  uint64_t hashVertex(const MFramework::MeshVertex& vertex)
+  {
+    uint32_t words[sizeof(MFramework::MeshVertex) / sizeof(uint32_t)];
+    std::memcpy(words, &vertex, sizeof(words));
+
+    uint64_t hash = 0;
+    for (const uint32_t word : words)
+    {
+      hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+      hash ^= hash >> 29;
+    }
+    return hash;
+  }
+
+  size_t getHashTableSize(size_t count)
+  {
+    size_t size = 16;
+    while (size < count + count / 2)
+    {
+      size <<= 1;
+    }
+    return size;
+  }
+}
+
+namespace MFramework
+{
+  size_t MeshOptimizer::DeduplicateVertices(MeshData& mesh)
+  {
+    const size_t vertexCount = mesh.Vertices.size();
+    if (vertexCount == 0)
+    {
+      return 0;
+    }
+
+    std::vector<MeshVertex> keys(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      keys[i] = makeVertexKey(mesh.Vertices[i]);
+    }
+
+    // 開番地法のハッシュテーブルに代表の頂点番号を入れる
+    const size_t tableSize = getHashTableSize(vertexCount);
+    const size_t tableMask = tableSize - 1;
+    std::vector<uint32_t> table(tableSize, INVALID_INDEX);
+    std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+    std::vector<MeshVertex> uniqueVertices;
+    uniqueVertices.reserve(vertexCount);
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      size_t slot = static_cast<size_t>(hashVertex(keys[i])) & tableMask;
+      for (;;)
+      {
+        const uint32_t candidate = table[slot];
+        if (candidate == INVALID_INDEX)
+        {
+          table[slot] = static_cast<uint32_t>(i);
+          remap[i] = static_cast<uint32_t>(uniqueVertices.size());
+          uniqueVertices.emplace_back(keys[i]);
+          break;
+        }
+
+        if (std::memcmp(&keys[candidate], &keys[i], sizeof(MeshVertex)) == 0)
+        {
+          remap[i] = remap[candidate];
+          break;
+        }
+
+        slot = (slot + 1) & tableMask;
+      }
+    }
+
+    for (uint32_t& index : mesh.Indices)
+    {
+      index = remap[index];
+    }
+
+    mesh.Vertices = std::move(uniqueVertices);
+    return mesh.Vertices.size();
+  }
+
+  void MeshOptimizer::OptimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+  {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+    {
+      return;
+    }
+
+    const VertexScoreTable& scoreTable = getScoreTable();
+    const std::vector<uint32_t> source(indices, indices + triangleCount * 3);
+
+    // 頂点ごとの隣接三角形(CSR形式、描いた三角形は末尾と入れ替えて取り除く)
+    std::vector<uint32_t> liveTriangleCounts(vertexCount, 0);
+    for (const uint32_t index : source)
+    {
+      ++liveTriangleCounts[index];
+    }
+
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      adjacencyOffsets[i + 1] = adjacencyOffsets[i] + liveTriangleCounts[i];
+    }
+
+    std::vector<uint32_t> adjacency(source.size());
+    {
+      std::vector<uint32_t> fillOffsets(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for (size_t i = 0; i < source.size(); ++i)
+      {
+        adjacency[fillOffsets[source[i]]++] = static_cast<uint32_t>(i / 3);
+      }
+    }
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      vertexScores[i] = computeVertexScore(scoreTable, -1, liveTriangleCounts[i]);
+    }
+
+    uint32_t bestTriangle = INVALID_INDEX;
+    float bestScore = -1.0f;
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+      const uint32_t* triangle = &source[i * 3];
+      const float score = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+      if (score > bestScore)
+      {
+        bestScore = score;
+        bestTriangle = static_cast<uint32_t>(i);
+      }
+    }
+
+    std::vector<uint8_t> isEmitted(triangleCount, 0);
+    uint32_t cache[CACHE_SIZE + 3];
+    uint32_t newCache[CACHE_SIZE + 3];
+    uint32_t cacheCount = 0;
+    size_t searchCursor = 0;
+
+    for (size_t outputTriangle = 0; outputTriangle < triangleCount; ++outputTriangle)
+    {
+      // キャッシュ内の頂点に候補が無くなったら、まだ描いていない最初の三角形から始め直す
+      if (bestTriangle == INVALID_INDEX)
+      {
+        while (isEmitted[searchCursor] != 0)
+        {
+          ++searchCursor;
+        }
+        bestTriangle = static_cast<uint32_t>(searchCursor);
+      }
+
+      const uint32_t* triangle = &source[bestTriangle * 3];
+      std::memcpy(indices + outputTriangle * 3, triangle, sizeof(uint32_t) * 3);
+      isEmitted[bestTriangle] = 1;
+
+      for (uint32_t corner = 0; corner < 3; ++corner)
+      {
+        const uint32_t vertex = triangle[corner];
+        uint32_t* begin = adjacency.data() + adjacencyOffsets[vertex];
+        uint32_t* end = begin + liveTriangleCounts[vertex];
+        uint32_t* found = std::find(begin, end, bestTriangle);
+        if (found != end)
+        {
+          *found = *(end - 1);
+          --liveTriangleCounts[vertex];
+        }
+      }
+
+      // 描いた三角形の頂点を先頭に置き、残りを後ろへずらす(同じ頂点が二度入らないようにする)
+      uint32_t newCacheCount = 0;
+      for (uint32_t corner = 0; corner < 3; ++corner)
+      {
+        const uint32_t vertex = triangle[corner];
+        if (std::find(newCache, newCache + newCacheCount, vertex) == newCache + newCacheCount)
+        {
+          newCache[newCacheCount++] = vertex;
+        }
+      }
+      for (uint32_t i = 0; i < cacheCount; ++i)
+      {
+        const uint32_t vertex = cache[i];
+        if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+        {
+          newCache[newCacheCount++] = vertex;
+        }
+      }
+
+      // 押し出された頂点も含めてスコアを更新する
+      for (uint32_t i = 0; i < newCacheCount; ++i)
+      {
+        const uint32_t vertex = newCache[i];
+        cachePositions[vertex] = (i < CACHE_SIZE) ? static_cast<int32_t>(i) : -1;
+        vertexScores[vertex] = computeVertexScore(scoreTable, cachePositions[vertex], liveTriangleCounts[vertex]);
+      }
+
+      bestTriangle = INVALID_INDEX;
+      bestScore = -1.0f;
+      for (uint32_t i = 0; i < newCacheCount; ++i)
+      {
+        const uint32_t vertex = newCache[i];
+        const uint32_t* begin = adjacency.data() + adjacencyOffsets[vertex];
+        const uint32_t* end = begin + liveTriangleCounts[vertex];
+        for (const uint32_t* it = begin; it != end; ++it)
+        {
+          const uint32_t* adjacent = &source[*it * 3];
+          const float score = vertexScores[adjacent[0]] + vertexScores[adjacent[1]] + vertexScores[adjacent[2]];
+          if (score > bestScore)
+          {
+            bestScore = score;
+            bestTriangle = *it;
+          }
+        }
+      }
+
+      cacheCount = std::min(newCacheCount, CACHE_SIZE);
+      std::memcpy(cache, newCache, sizeof(uint32_t) * cacheCount);
+    }
+  }
+
+  void MeshOptimizer::OptimizeOverdraw(MeshData& mesh, uint32_t cacheSize, float threshold)
+  {
+    const size_t triangleCount = mesh.Indices.size() / 3;
+    if (triangleCount < 2 || cacheSize == 0)
+    {
+      return;
+    }
+
+    const uint32_t* indices = mesh.Indices.data();
+    FifoCacheSimulator simulator(mesh.Vertices.size(), cacheSize);
+
+    // 今の順番でキャッシュが全部外れる三角形が、前とのつながりが切れる位置
+    std::vector<size_t> hardBoundaries;
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+      if (simulator.Simulate(indices + i * 3) == 3 || i == 0)
+      {
+        hardBoundaries.emplace_back(i);
+      }
+    }
+    hardBoundaries.emplace_back(triangleCount);
+
+    // さらに、キャッシュを空にして始めてもACMRがしきい値以内に収まる長さで区切る
+    std::vector<size_t> clusterStarts;
+    for (size_t hard = 0; hard + 1 < hardBoundaries.size(); ++hard)
+    {
+      const size_t begin = hardBoundaries[hard];
+      const size_t end = hardBoundaries[hard + 1];
+
+      simulator.Flush();
+      uint32_t clusterMissCount = 0;
+      for (size_t i = begin; i < end; ++i)
+      {
+        clusterMissCount += simulator.Simulate(indices + i * 3);
+      }
+      const float clusterThreshold = threshold * static_cast<float>(clusterMissCount) / static_cast<float>(end - begin);
+
+      size_t start = begin;
+      while (start < end)
+      {
+        clusterStarts.emplace_back(start);
+
+        simulator.Flush();
+        uint32_t missCount = 0;
+        size_t i = start;
+        while (i < end)
+        {
+          missCount += simulator.Simulate(indices + i * 3);
+          ++i;
+          if (static_cast<float>(missCount) <= clusterThreshold * static_cast<float>(i - start))
+          {
+            break;
+          }
+        }
+        start = i;
+      }
+    }
+    clusterStarts.emplace_back(triangleCount);
+
+    // クラスターの中心と向き(面積で重み付け)
+    const size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<Float3> clusterCentroids(clusterCount, Float3{ 0.0f, 0.0f, 0.0f });
+    std::vector<Float3> clusterNormals(clusterCount, Float3{ 0.0f, 0.0f, 0.0f });
+    Float3 meshCentroid{ 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+    {
+      float clusterArea = 0.0f;
+      Float3& centroid = clusterCentroids[cluster];
+      Float3& normal = clusterNormals[cluster];
+      for (size_t i = clusterStarts[cluster]; i < clusterStarts[cluster + 1]; ++i)
+      {
+        const MeshVertex& v0 = mesh.Vertices[indices[i * 3 + 0]];
+        const MeshVertex& v1 = mesh.Vertices[indices[i * 3 + 1]];
+        const MeshVertex& v2 = mesh.Vertices[indices[i * 3 + 2]];
+        const Float3 faceNormal = computeFaceNormal(v0, v1, v2);
+        const float area = std::sqrt(faceNormal.X * faceNormal.X + faceNormal.Y * faceNormal.Y + faceNormal.Z * faceNormal.Z);
+
+        normal.X += faceNormal.X;
+        normal.Y += faceNormal.Y;
+        normal.Z += faceNormal.Z;
+        centroid.X += (v0.Position[0] + v1.Position[0] + v2.Position[0]) * area;
+        centroid.Y += (v0.Position[1] + v1.Position[1] + v2.Position[1]) * area;
+        centroid.Z += (v0.Position[2] + v1.Position[2] + v2.Position[2]) * area;
+        clusterArea += area;
+      }
+
+      meshCentroid.X += centroid.X;
+      meshCentroid.Y += centroid.Y;
+      meshCentroid.Z += centroid.Z;
+      meshArea += clusterArea;
+
+      const float scale = (clusterArea > 0.0f) ? 1.0f / (clusterArea * 3.0f) : 0.0f;
+      centroid = Float3{ centroid.X * scale, centroid.Y * scale, centroid.Z * scale };
+    }
+
+    if (meshArea <= 0.0f)
+    {
+      return;
+    }
+
+    const float meshScale = 1.0f / (meshArea * 3.0f);
+    meshCentroid = Float3{ meshCentroid.X * meshScale, meshCentroid.Y * meshScale, meshCentroid.Z * meshScale };
+
+    // 中心から外を向いているクラスターほど他を隠しやすいので先に描く
+    std::vector<float> clusterSortKeys(clusterCount);
+    std::vector<uint32_t> clusterOrder(clusterCount);
+    for (size_t cluster = 0; cluster < clusterCount; ++cluster)
+    {
+      const Float3& normal = clusterNormals[cluster];
+      const float length = std::sqrt(normal.X * normal.X + normal.Y * normal.Y + normal.Z * normal.Z);
+      const Float3& centroid = clusterCentroids[cluster];
+      const float dot = (centroid.X - meshCentroid.X) * normal.X + (centroid.Y - meshCentroid.Y) * normal.Y + (centroid.Z - meshCentroid.Z) * normal.Z;
+
+      clusterSortKeys[cluster] = (length > 0.0f) ? dot / length : 0.0f;
+      clusterOrder[cluster] = static_cast<uint32_t>(cluster);
+    }
+
+    std::stable_sort(
+                      clusterOrder.begin(),
+                      clusterOrder.end(),
+                      [&clusterSortKeys](uint32_t a, uint32_t b)
+                      {
+                        return clusterSortKeys[a] > clusterSortKeys[b];
+                      }
+                    );
+
+    std::vector<uint32_t> sortedIndices;
+    sortedIndices.reserve(mesh.Indices.size());
+    for (const uint32_t cluster : clusterOrder)
+    {
+      sortedIndices.insert(sortedIndices.end(), mesh.Indices.begin() + clusterStarts[cluster] * 3, mesh.Indices.begin() + clusterStarts[cluster + 1] * 3);
+    }
+
+    mesh.Indices = std::move(sortedIndices);
+  }
+
+  size_t MeshOptimizer::OptimizeVertexFetch(MeshData& mesh)
+  {
+    std::vector<uint32_t> remap(mesh.Vertices.size(), INVALID_INDEX);
+    std::vector<MeshVertex> orderedVertices;
+    orderedVertices.reserve(mesh.Vertices.size());
+
+    for (uint32_t& index : mesh.Indices)
+    {
+      if (remap[index] == INVALID_INDEX)
+      {
+        remap[index] = static_cast<uint32_t>(orderedVertices.size());
+        orderedVertices.emplace_back(mesh.Vertices[index]);
+      }
+      index = remap[index];
+    }
+
+    mesh.Vertices = std::move(orderedVertices);
+    return mesh.Vertices.size();
+  }
+
+  void MeshOptimizer::ComputeNormals(MeshData& mesh)
+  {
+    std::vector<Float3> normals(mesh.Vertices.size(), Float3{ 0.0f, 0.0f, 0.0f });
+    for (size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+    {
+      const uint32_t* triangle = &mesh.Indices[i];
+      const Float3 faceNormal = computeFaceNormal(mesh.Vertices[triangle[0]], mesh.Vertices[triangle[1]], mesh.Vertices[triangle[2]]);
+      for (uint32_t corner = 0; corner < 3; ++corner)
+      {
+        Float3& normal = normals[triangle[corner]];
+        normal.X += faceNormal.X;
+        normal.Y += faceNormal.Y;
+        normal.Z += faceNormal.Z;
+      }
+    }
+
+    for (size_t i = 0; i < mesh.Vertices.size(); ++i)
+    {
+      const Float3& normal = normals[i];
+      const float length = std::sqrt(normal.X * normal.X + normal.Y * normal.Y + normal.Z * normal.Z);
+      const float scale = (length > 0.0f) ? 1.0f / length : 0.0f;
+
+      MeshVertex& vertex = mesh.Vertices[i];
+      vertex.Normal[0] = normal.X * scale;
+      vertex.Normal[1] = normal.Y * scale;
+      vertex.Normal[2] = normal.Z * scale;
+    }
+
+    mesh.HasNormals = true;
+  }
+
+  VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize)
+  {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0 || cacheSize == 0)
+    {
+      return VertexCacheStats{ 0.0f, 0.0f };
+    }
+
+    FifoCacheSimulator simulator(vertexCount, cacheSize);
+    uint64_t missCount = 0;
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+      missCount += simulator.Simulate(indices + i * 3);
+    }
+
+    // 使われていない頂点は数えない
+    std::vector<uint8_t> isReferenced(vertexCount, 0);
+    size_t referencedCount = 0;
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+      if (isReferenced[indices[i]] == 0)
+      {
+        isReferenced[indices[i]] = 1;
+        ++referencedCount;
+      }
+    }
+
+    return VertexCacheStats{ static_cast<float>(missCount) / static_cast<float>(triangleCount), static_cast<float>(missCount) / static_cast<float>(referencedCount) };
+  }
+}
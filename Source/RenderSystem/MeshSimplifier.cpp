@@ -0,0 +1,899 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Quadric error metric mesh simplifier (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Record measured deviation as the LOD error
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MeshSimplifier.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  constexpr uint32_t INVALID_VERTEX = 0xffffffff;
+
+  // 縁の形を保つために縁に垂直な平面へ掛ける重み(辺の長さの2乗に掛ける)
+  constexpr double BORDER_WEIGHT = 10.0;
+
+  // 縮約で面の向きがこれ以上変わる場合は縮約しない(法線の内積、約75度)
+  constexpr double MIN_NORMAL_DOT = 0.25;
+
+  // 一つ前のレベルから三角形がこの割合までしか減らなければLODの生成をやめる
+  constexpr float MIN_LOD_REDUCTION = 0.9f;
+
+  // MeasureDeviationで格子に分ける数の上限(一辺)
+  constexpr uint32_t MAX_GRID_RESOLUTION = 128;
+
+  enum class VertexKind : uint8_t
+  {
+    Manifold,       // 閉じた面の内側(どの頂点にも縮約できる)
+    Border,         // 開いた縁(縁に沿ってだけ縮約できる)
+    Locked,         // 継ぎ目や非多様体(動かさない)
+  };
+
+  struct Vector3
+  {
+    double X;
+    double Y;
+    double Z;
+  };
+
+  Vector3 load(const float value[3])
+  {
+    return Vector3{ value[0], value[1], value[2] };
+  }
+
+  Vector3 subtract(const Vector3& a, const Vector3& b)
+  {
+    return Vector3{ a.X - b.X, a.Y - b.Y, a.Z - b.Z };
+  }
+
+  double dot(const Vector3& a, const Vector3& b)
+  {
+    return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+  }
+
+  Vector3 cross(const Vector3& a, const Vector3& b)
+  {
+    return Vector3{ a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+  }
+
+  /// @brief
+  /// 平面までの距離の2乗の重み付き和(対称行列A、ベクトルb、定数c)
+  struct Quadric
+  {
+    double A00, A01, A02, A11, A12, A22;
+    double B0, B1, B2;
+    double C;
+    double Weight;
+
+    /// @brief
+    /// 平面dot(normal, p) + distance = 0を足す
+    /// @param normal 単位ベクトル
+    void AddPlane(const Vector3& normal, double distance, double weight)
+    {
+      A00 += weight * normal.X * normal.X;
+      A01 += weight * normal.X * normal.Y;
+      A02 += weight * normal.X * normal.Z;
+      A11 += weight * normal.Y * normal.Y;
+      A12 += weight * normal.Y * normal.Z;
+      A22 += weight * normal.Z * normal.Z;
+      B0 += weight * normal.X * distance;
+      B1 += weight * normal.Y * distance;
+      B2 += weight * normal.Z * distance;
+      C += weight * distance * distance;
+      Weight += weight;
+    }
+
+    void Add(const Quadric& other)
+    {
+      A00 += other.A00;
+      A01 += other.A01;
+      A02 += other.A02;
+      A11 += other.A11;
+      A12 += other.A12;
+      A22 += other.A22;
+      B0 += other.B0;
+      B1 += other.B1;
+      B2 += other.B2;
+      C += other.C;
+      Weight += other.Weight;
+    }
+  };
+
+  /// @brief
+  /// 二つの二次誤差を足した値の点pでの平均(距離の2乗)
+  double evaluate(const Quadric& a, const Quadric& b, const Vector3& p)
+  {
+    const double weight = a.Weight + b.Weight;
+    if (weight <= 0.0)
+    {
+      return 0.0;
+    }
+
+    const double a00 = a.A00 + b.A00;
+    const double a01 = a.A01 + b.A01;
+    const double a02 = a.A02 + b.A02;
+    const double a11 = a.A11 + b.A11;
+    const double a12 = a.A12 + b.A12;
+    const double a22 = a.A22 + b.A22;
+    const double value = p.X * (a00 * p.X + 2.0 * (a01 * p.Y + a02 * p.Z)) + p.Y * (a11 * p.Y + 2.0 * a12 * p.Z) + a22 * p.Z * p.Z +
+                         2.0 * ((a.B0 + b.B0) * p.X + (a.B1 + b.B1) * p.Y + (a.B2 + b.B2) * p.Z) + (a.C + b.C);
+    return std::max(value / weight, 0.0);
+  }
+
+  /// @brief
+  /// 頂点から使っている三角形を引く表(CSR)
+  void buildAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount, std::vector<uint32_t>& outOffsets, std::vector<uint32_t>& outTriangles)
+  {
+    outOffsets.assign(vertexCount + 1, 0);
+    for (const uint32_t index : indices)
+    {
+      ++outOffsets[index + 1];
+    }
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      outOffsets[i + 1] += outOffsets[i];
+    }
+
+    outTriangles.resize(indices.size());
+    std::vector<uint32_t> cursors(outOffsets.begin(), outOffsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      outTriangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  /// @brief
+  /// 縮約の候補(fromの頂点をtoへ寄せる)
+  struct Collapse
+  {
+    uint32_t From;
+    uint32_t To;
+    double Cost;
+  };
+
+  /// @brief
+  /// 縮約を進めるメッシュ
+  class SimplifierState
+  {
+    public:
+      explicit SimplifierState(const MFramework::MeshData& mesh)
+        : m_mesh(mesh)
+        , m_indices(mesh.Indices)
+        , m_positionIds(mesh.Vertices.size())
+        , m_kinds(mesh.Vertices.size(), VertexKind::Manifold)
+        , m_borderNext(mesh.Vertices.size(), INVALID_VERTEX)
+        , m_borderPrev(mesh.Vertices.size(), INVALID_VERTEX)
+        , m_quadrics(mesh.Vertices.size(), Quadric{})
+        , m_maxCost(0.0)
+      {
+        m_indices.resize(m_indices.size() / 3 * 3);
+        buildPositionIds();
+        classifyVertices();
+        buildQuadrics();
+        removeDegenerateTriangles();
+      }
+
+      const std::vector<uint32_t>& GetIndices(void) const
+      {
+        return m_indices;
+      }
+
+      float GetError(void) const
+      {
+        return static_cast<float>(std::sqrt(m_maxCost));
+      }
+
+      /// @brief
+      /// インデックス数が目標以下になるか、縮約できなくなるまで進める
+      void Reduce(size_t targetIndexCount, float maxError)
+      {
+        const double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+        while (m_indices.size() > targetIndexCount)
+        {
+          if (!reducePass(targetIndexCount, maxCost))
+          {
+            break;
+          }
+        }
+      }
+
+    private:
+      /// @brief
+      /// 同じ位置の頂点に同じ番号(その位置の最初の頂点)を付ける
+      void buildPositionIds(void)
+      {
+        const std::vector<MFramework::MeshVertex>& vertices = m_mesh.Vertices;
+        std::vector<uint32_t> order(vertices.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+          order[i] = static_cast<uint32_t>(i);
+        }
+
+        auto isLess = [&vertices](uint32_t a, uint32_t b)
+        {
+          const float* pa = vertices[a].Position;
+          const float* pb = vertices[b].Position;
+          if (pa[0] != pb[0])
+          {
+            return pa[0] < pb[0];
+          }
+          if (pa[1] != pb[1])
+          {
+            return pa[1] < pb[1];
+          }
+          return pa[2] < pb[2];
+        };
+        std::sort(order.begin(), order.end(), isLess);
+
+        for (size_t i = 0; i < order.size();)
+        {
+          size_t end = i + 1;
+          while (end < order.size() && !isLess(order[i], order[end]))
+          {
+            ++end;
+          }
+
+          const uint32_t id = *std::min_element(order.begin() + i, order.begin() + end);
+          for (size_t j = i; j < end; ++j)
+          {
+            m_positionIds[order[j]] = id;
+          }
+
+          // 同じ位置に複数の頂点があるところは継ぎ目なので動かさない
+          if (end - i > 1)
+          {
+            for (size_t j = i; j < end; ++j)
+            {
+              m_kinds[order[j]] = VertexKind::Locked;
+            }
+          }
+          i = end;
+        }
+      }
+
+      /// @brief
+      /// 位置で見た辺の向きから開いた縁と非多様体を見つける
+      void classifyVertices(void)
+      {
+        std::vector<uint64_t> edges;
+        edges.reserve(m_indices.size());
+        for (size_t i = 0; i < m_indices.size(); i += 3)
+        {
+          for (uint32_t corner = 0; corner < 3; ++corner)
+          {
+            const uint32_t from = m_positionIds[m_indices[i + corner]];
+            const uint32_t to = m_positionIds[m_indices[i + (corner + 1) % 3]];
+            if (from != to)
+            {
+              edges.emplace_back((static_cast<uint64_t>(from) << 32) | to);
+            }
+          }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::vector<uint8_t> openOutCounts(m_mesh.Vertices.size(), 0);
+        std::vector<uint8_t> openInCounts(m_mesh.Vertices.size(), 0);
+        std::vector<uint8_t> isNonManifold(m_mesh.Vertices.size(), 0);
+        for (size_t i = 0; i < edges.size();)
+        {
+          size_t end = i + 1;
+          while (end < edges.size() && edges[end] == edges[i])
+          {
+            ++end;
+          }
+
+          const uint32_t from = static_cast<uint32_t>(edges[i] >> 32);
+          const uint32_t to = static_cast<uint32_t>(edges[i] & 0xffffffff);
+          const uint64_t reverse = (static_cast<uint64_t>(to) << 32) | from;
+          const auto reverseRange = std::equal_range(edges.begin(), edges.end(), reverse);
+          const size_t reverseCount = static_cast<size_t>(reverseRange.second - reverseRange.first);
+
+          if (end - i > 1 || reverseCount > 1)
+          {
+            isNonManifold[from] = 1;
+            isNonManifold[to] = 1;
+          }
+          else if (reverseCount == 0)
+          {
+            openOutCounts[from] = static_cast<uint8_t>(std::min(openOutCounts[from] + 1, 2));
+            openInCounts[to] = static_cast<uint8_t>(std::min(openInCounts[to] + 1, 2));
+            m_borderNext[from] = to;
+            m_borderPrev[to] = from;
+          }
+          i = end;
+        }
+
+        for (size_t i = 0; i < m_mesh.Vertices.size(); ++i)
+        {
+          const uint32_t id = m_positionIds[i];
+          if (m_kinds[i] == VertexKind::Locked)
+          {
+            continue;
+          }
+
+          if (isNonManifold[id] != 0 || openOutCounts[id] != openInCounts[id] || openOutCounts[id] > 1)
+          {
+            m_kinds[i] = VertexKind::Locked;
+          }
+          else if (openOutCounts[id] == 1)
+          {
+            m_kinds[i] = VertexKind::Border;
+          }
+        }
+      }
+
+      /// @brief
+      /// 面と縁の平面から頂点ごとの二次誤差を作る(面は面積で重み付けする)
+      void buildQuadrics(void)
+      {
+        for (size_t i = 0; i < m_indices.size(); i += 3)
+        {
+          const uint32_t corners[3] = { m_indices[i], m_indices[i + 1], m_indices[i + 2] };
+          const Vector3 p[3] = { getPosition(corners[0]), getPosition(corners[1]), getPosition(corners[2]) };
+          Vector3 normal = cross(subtract(p[1], p[0]), subtract(p[2], p[0]));
+          const double length = std::sqrt(dot(normal, normal));
+          if (length <= 0.0)
+          {
+            continue;
+          }
+
+          normal = Vector3{ normal.X / length, normal.Y / length, normal.Z / length };
+          const double area = length * 0.5;
+          for (const uint32_t corner : corners)
+          {
+            m_quadrics[corner].AddPlane(normal, -dot(normal, p[0]), area);
+          }
+
+          // 開いた縁は縁を含み面に垂直な平面で縁から離れないようにする
+          for (uint32_t corner = 0; corner < 3; ++corner)
+          {
+            const uint32_t from = corners[corner];
+            const uint32_t to = corners[(corner + 1) % 3];
+            if (m_borderNext[m_positionIds[from]] != m_positionIds[to])
+            {
+              continue;
+            }
+
+            const Vector3 edge = subtract(p[(corner + 1) % 3], p[corner]);
+            const double edgeLengthSquared = dot(edge, edge);
+            Vector3 side = cross(edge, normal);
+            const double sideLength = std::sqrt(dot(side, side));
+            if (sideLength <= 0.0)
+            {
+              continue;
+            }
+
+            side = Vector3{ side.X / sideLength, side.Y / sideLength, side.Z / sideLength };
+            const double distance = -dot(side, p[corner]);
+            m_quadrics[from].AddPlane(side, distance, edgeLengthSquared * BORDER_WEIGHT);
+            m_quadrics[to].AddPlane(side, distance, edgeLengthSquared * BORDER_WEIGHT);
+          }
+        }
+      }
+
+      Vector3 getPosition(uint32_t vertex) const
+      {
+        return load(m_mesh.Vertices[vertex].Position);
+      }
+
+      bool canCollapse(uint32_t from, uint32_t to) const
+      {
+        const uint32_t fromId = m_positionIds[from];
+        const uint32_t toId = m_positionIds[to];
+        if (fromId == toId)
+        {
+          return false;
+        }
+
+        switch (m_kinds[from])
+        {
+          case VertexKind::Manifold:
+            return true;
+          case VertexKind::Border:
+          {
+            // 縁に沿った隣の頂点にだけ寄せる(3頂点の穴は閉じない)
+            if (m_borderNext[fromId] != toId && m_borderPrev[fromId] != toId)
+            {
+              return false;
+            }
+            const uint32_t next = m_borderNext[fromId];
+            return m_borderNext[next] == INVALID_VERTEX || m_borderNext[m_borderNext[next]] != fromId;
+          }
+          default:
+            return false;
+        }
+      }
+
+      /// @brief
+      /// 縮約してもfromの周りの面が裏返らないか
+      bool isCollapseValid(uint32_t from, uint32_t to, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& triangles) const
+      {
+        const uint32_t toId = m_positionIds[to];
+        const Vector3 target = getPosition(to);
+        for (uint32_t i = offsets[from]; i < offsets[from + 1]; ++i)
+        {
+          const uint32_t* corners = &m_indices[triangles[i] * 3];
+          if (m_positionIds[corners[0]] == toId || m_positionIds[corners[1]] == toId || m_positionIds[corners[2]] == toId)
+          {
+            continue;
+          }
+
+          // fromが最初に来るように回す
+          const uint32_t rotation = (corners[0] == from) ? 0 : ((corners[1] == from) ? 1 : 2);
+          const Vector3 source = getPosition(from);
+          const Vector3 p1 = getPosition(corners[(rotation + 1) % 3]);
+          const Vector3 p2 = getPosition(corners[(rotation + 2) % 3]);
+          const Vector3 before = cross(subtract(p1, source), subtract(p2, source));
+          const Vector3 after = cross(subtract(p1, target), subtract(p2, target));
+          const double afterLengthSquared = dot(after, after);
+          if (afterLengthSquared <= 0.0 || dot(before, after) < MIN_NORMAL_DOT * std::sqrt(dot(before, before) * afterLengthSquared))
+          {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /// @brief
+      /// 縁に沿って縮約したら縁のつながりを付け替える
+      void updateBorder(uint32_t from, uint32_t to)
+      {
+        if (m_kinds[from] != VertexKind::Border)
+        {
+          return;
+        }
+
+        const uint32_t fromId = m_positionIds[from];
+        const uint32_t toId = m_positionIds[to];
+        if (m_borderNext[fromId] == toId)
+        {
+          const uint32_t prev = m_borderPrev[fromId];
+          m_borderNext[prev] = toId;
+          m_borderPrev[toId] = prev;
+        }
+        else
+        {
+          const uint32_t next = m_borderNext[fromId];
+          m_borderPrev[next] = toId;
+          m_borderNext[toId] = next;
+        }
+        m_borderNext[fromId] = INVALID_VERTEX;
+        m_borderPrev[fromId] = INVALID_VERTEX;
+      }
+
+      /// @brief
+      /// 誤差の小さい辺から、周りが重ならない縮約をまとめて行う
+      /// @return 一つでも縮約したか
+      bool reducePass(size_t targetIndexCount, double maxCost)
+      {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> triangles;
+        buildAdjacency(m_indices, m_mesh.Vertices.size(), offsets, triangles);
+
+        m_collapses.clear();
+        for (size_t i = 0; i < m_indices.size(); i += 3)
+        {
+          for (uint32_t corner = 0; corner < 3; ++corner)
+          {
+            const uint32_t a = m_indices[i + corner];
+            const uint32_t b = m_indices[i + (corner + 1) % 3];
+
+            // 内側の辺は隣の三角形に逆向きで現れるので片方だけ見る(縁の辺は一度しか現れない)
+            if (a > b && m_borderNext[m_positionIds[a]] != m_positionIds[b])
+            {
+              continue;
+            }
+
+            const double costAB = canCollapse(a, b) ? evaluate(m_quadrics[a], m_quadrics[b], getPosition(b)) : std::numeric_limits<double>::max();
+            const double costBA = canCollapse(b, a) ? evaluate(m_quadrics[b], m_quadrics[a], getPosition(a)) : std::numeric_limits<double>::max();
+            if (costAB <= costBA && costAB <= maxCost)
+            {
+              m_collapses.emplace_back(Collapse{ a, b, costAB });
+            }
+            else if (costBA < costAB && costBA <= maxCost)
+            {
+              m_collapses.emplace_back(Collapse{ b, a, costBA });
+            }
+          }
+        }
+
+        std::sort(
+                  m_collapses.begin(),
+                  m_collapses.end(),
+                  [](const Collapse& a, const Collapse& b)
+                  {
+                    return a.Cost < b.Cost;
+                  }
+                );
+
+        // 内側の縮約一つで三角形が2つ減る
+        const size_t neededCount = std::max<size_t>((m_indices.size() - targetIndexCount) / 6, 1);
+        m_remap.resize(m_mesh.Vertices.size());
+        for (size_t i = 0; i < m_remap.size(); ++i)
+        {
+          m_remap[i] = static_cast<uint32_t>(i);
+        }
+        m_isTouched.assign(m_mesh.Vertices.size(), 0);
+
+        size_t appliedCount = 0;
+        for (const Collapse& collapse : m_collapses)
+        {
+          if (appliedCount >= neededCount)
+          {
+            break;
+          }
+
+          // 同じパスで周りの頂点が動いていると判定が古くなるので、縮約した頂点の1リングはこのパスでは触らない
+          if (m_isTouched[collapse.From] != 0 || m_isTouched[collapse.To] != 0 || !isCollapseValid(collapse.From, collapse.To, offsets, triangles))
+          {
+            continue;
+          }
+
+          for (uint32_t i = offsets[collapse.From]; i < offsets[collapse.From + 1]; ++i)
+          {
+            const uint32_t* corners = &m_indices[triangles[i] * 3];
+            m_isTouched[corners[0]] = 1;
+            m_isTouched[corners[1]] = 1;
+            m_isTouched[corners[2]] = 1;
+          }
+
+          m_remap[collapse.From] = collapse.To;
+          m_quadrics[collapse.To].Add(m_quadrics[collapse.From]);
+          updateBorder(collapse.From, collapse.To);
+          m_maxCost = std::max(m_maxCost, collapse.Cost);
+          ++appliedCount;
+        }
+
+        if (appliedCount == 0)
+        {
+          return false;
+        }
+
+        for (uint32_t& index : m_indices)
+        {
+          index = m_remap[index];
+        }
+        removeDegenerateTriangles();
+        return true;
+      }
+
+      /// @brief
+      /// 位置が重なった三角形を取り除く
+      void removeDegenerateTriangles(void)
+      {
+        size_t writeIndex = 0;
+        for (size_t i = 0; i < m_indices.size(); i += 3)
+        {
+          const uint32_t a = m_positionIds[m_indices[i]];
+          const uint32_t b = m_positionIds[m_indices[i + 1]];
+          const uint32_t c = m_positionIds[m_indices[i + 2]];
+          if (a == b || b == c || c == a)
+          {
+            continue;
+          }
+
+          m_indices[writeIndex++] = m_indices[i];
+          m_indices[writeIndex++] = m_indices[i + 1];
+          m_indices[writeIndex++] = m_indices[i + 2];
+        }
+        m_indices.resize(writeIndex);
+      }
+
+    private:
+      const MFramework::MeshData& m_mesh;
+      std::vector<uint32_t> m_indices;
+      std::vector<uint32_t> m_positionIds;      // 同じ位置の頂点で共通の番号
+      std::vector<VertexKind> m_kinds;
+      std::vector<uint32_t> m_borderNext;       // 位置の番号で引く縁の次の位置(縁でなければINVALID_VERTEX)
+      std::vector<uint32_t> m_borderPrev;
+      std::vector<Quadric> m_quadrics;
+      std::vector<Collapse> m_collapses;
+      std::vector<uint32_t> m_remap;
+      std::vector<uint8_t> m_isTouched;
+      double m_maxCost;
+  };
+
+  /// @brief
+  /// 点から三角形までの距離の2乗(Ericson, Real-Time Collision Detection 5.1.5)
+  double pointTriangleDistanceSquared(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c)
+  {
+    const Vector3 ab = subtract(b, a);
+    const Vector3 ac = subtract(c, a);
+    const Vector3 ap = subtract(p, a);
+    const double d1 = dot(ab, ap);
+    const double d2 = dot(ac, ap);
+    auto distanceTo = [&p](const Vector3& q)
+    {
+      const Vector3 difference = subtract(p, q);
+      return dot(difference, difference);
+    };
+
+    if (d1 <= 0.0 && d2 <= 0.0)
+    {
+      return distanceTo(a);
+    }
+
+    const Vector3 bp = subtract(p, b);
+    const double d3 = dot(ab, bp);
+    const double d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+      return distanceTo(b);
+    }
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+      const double v = d1 / (d1 - d3);
+      return distanceTo(Vector3{ a.X + ab.X * v, a.Y + ab.Y * v, a.Z + ab.Z * v });
+    }
+
+    const Vector3 cp = subtract(p, c);
+    const double d5 = dot(ab, cp);
+    const double d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+      return distanceTo(c);
+    }
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+      const double w = d2 / (d2 - d6);
+      return distanceTo(Vector3{ a.X + ac.X * w, a.Y + ac.Y * w, a.Z + ac.Z * w });
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+      const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+      return distanceTo(Vector3{ b.X + (c.X - b.X) * w, b.Y + (c.Y - b.Y) * w, b.Z + (c.Z - b.Z) * w });
+    }
+
+    const double denominator = 1.0 / (va + vb + vc);
+    const double v = vb * denominator;
+    const double w = vc * denominator;
+    return distanceTo(Vector3{ a.X + ab.X * v + ac.X * w, a.Y + ab.Y * v + ac.Y * w, a.Z + ab.Z * v + ac.Z * w });
+  }
+}
+
+namespace MFramework
+{
+  float MeshSimplifier::Simplify(const MeshData& mesh, size_t targetIndexCount, float maxError, std::vector<uint32_t>& outIndices)
+  {
+    SimplifierState state(mesh);
+    state.Reduce(targetIndexCount, maxError);
+    outIndices = state.GetIndices();
+    return std::max(state.GetError(), MeasureDeviation(mesh, outIndices.data(), outIndices.size()));
+  }
+
+  void MeshSimplifier::BuildLods(const MeshData& mesh, const MeshLodOptions& options, std::vector<MeshLod>& outLods)
+  {
+    outLods.clear();
+    if (mesh.Vertices.empty() || mesh.Indices.size() < 3)
+    {
+      return;
+    }
+
+    float boundsMin[3] = { mesh.Vertices[0].Position[0], mesh.Vertices[0].Position[1], mesh.Vertices[0].Position[2] };
+    float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+    for (const MeshVertex& vertex : mesh.Vertices)
+    {
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        boundsMin[axis] = std::min(boundsMin[axis], vertex.Position[axis]);
+        boundsMax[axis] = std::max(boundsMax[axis], vertex.Position[axis]);
+      }
+    }
+    const float extent[3] = { boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] };
+    const float maxError = options.MaxError * std::sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]);
+
+    SimplifierState state(mesh);
+    size_t previousIndexCount = mesh.Indices.size() / 3 * 3;
+    float previousError = 0.0f;
+    for (uint32_t level = 0; level < options.MaxLodCount; ++level)
+    {
+      const size_t targetIndexCount = static_cast<size_t>(static_cast<float>(previousIndexCount / 3) * options.Reduction) * 3;
+      if (targetIndexCount < static_cast<size_t>(options.MinTriangleCount) * 3)
+      {
+        break;
+      }
+
+      state.Reduce(targetIndexCount, maxError);
+      const size_t indexCount = state.GetIndices().size();
+      if (indexCount == 0 || static_cast<float>(indexCount) > static_cast<float>(previousIndexCount) * MIN_LOD_REDUCTION)
+      {
+        break;
+      }
+
+      // 二次誤差は実際のずれを下回ることがあるので、測ったずれと比べて大きい方を使う
+      // 粗いレベルほど誤差が大きくなるようにして、選ぶ側が単調に探せるようにする
+      const std::vector<uint32_t>& indices = state.GetIndices();
+      const float error = std::max({ state.GetError(), MeasureDeviation(mesh, indices.data(), indices.size()), previousError });
+      outLods.emplace_back(MeshLod{ indices, error });
+      previousIndexCount = indexCount;
+      previousError = error;
+    }
+  }
+
+  float MeshSimplifier::MeasureDeviation(const MeshData& mesh, const uint32_t* indices, size_t indexCount)
+  {
+    const size_t triangleCount = indexCount / 3;
+    if (mesh.Vertices.empty() || triangleCount == 0)
+    {
+      return 0.0f;
+    }
+
+    // 三角形を一様な格子に登録して近くのセルから探す
+    Vector3 boundsMin = load(mesh.Vertices[0].Position);
+    Vector3 boundsMax = boundsMin;
+    for (const MeshVertex& vertex : mesh.Vertices)
+    {
+      boundsMin = Vector3{ std::min(boundsMin.X, static_cast<double>(vertex.Position[0])), std::min(boundsMin.Y, static_cast<double>(vertex.Position[1])), std::min(boundsMin.Z, static_cast<double>(vertex.Position[2])) };
+      boundsMax = Vector3{ std::max(boundsMax.X, static_cast<double>(vertex.Position[0])), std::max(boundsMax.Y, static_cast<double>(vertex.Position[1])), std::max(boundsMax.Z, static_cast<double>(vertex.Position[2])) };
+    }
+
+    const Vector3 extent = subtract(boundsMax, boundsMin);
+    const double maxExtent = std::max({ extent.X, extent.Y, extent.Z, 1.0e-12 });
+    // 三角形は面に沿って並ぶので、一辺の分割数は三角形数の平方根に比例させる
+    const uint32_t resolution = std::clamp(static_cast<uint32_t>(std::sqrt(static_cast<double>(triangleCount))), 1u, MAX_GRID_RESOLUTION);
+    const double cellSize = maxExtent / resolution;
+    const uint32_t cellCounts[3] =
+    {
+      std::clamp(static_cast<uint32_t>(extent.X / cellSize) + 1, 1u, resolution),
+      std::clamp(static_cast<uint32_t>(extent.Y / cellSize) + 1, 1u, resolution),
+      std::clamp(static_cast<uint32_t>(extent.Z / cellSize) + 1, 1u, resolution),
+    };
+
+    auto toCell = [&](double value, double origin, uint32_t axis)
+    {
+      return std::min(static_cast<uint32_t>(std::max((value - origin) / cellSize, 0.0)), cellCounts[axis] - 1);
+    };
+    auto getCellIndex = [&](uint32_t x, uint32_t y, uint32_t z)
+    {
+      return (static_cast<size_t>(z) * cellCounts[1] + y) * cellCounts[0] + x;
+    };
+
+    // 1回目で数え、2回目で詰める
+    const size_t cellCount = static_cast<size_t>(cellCounts[0]) * cellCounts[1] * cellCounts[2];
+    std::vector<uint32_t> cellOffsets(cellCount + 1, 0);
+    std::vector<uint32_t> cellTriangles;
+    for (uint32_t pass = 0; pass < 2; ++pass)
+    {
+      std::vector<uint32_t> cursors;
+      if (pass == 1)
+      {
+        for (size_t i = 0; i < cellCount; ++i)
+        {
+          cellOffsets[i + 1] += cellOffsets[i];
+        }
+        cellTriangles.resize(cellOffsets[cellCount]);
+        cursors.assign(cellOffsets.begin(), cellOffsets.end() - 1);
+      }
+
+      for (size_t triangle = 0; triangle < triangleCount; ++triangle)
+      {
+        const float* p0 = mesh.Vertices[indices[triangle * 3 + 0]].Position;
+        const float* p1 = mesh.Vertices[indices[triangle * 3 + 1]].Position;
+        const float* p2 = mesh.Vertices[indices[triangle * 3 + 2]].Position;
+        const double origins[3] = { boundsMin.X, boundsMin.Y, boundsMin.Z };
+        uint32_t cellMin[3] = {};
+        uint32_t cellMax[3] = {};
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+          cellMin[axis] = toCell(std::min({ p0[axis], p1[axis], p2[axis] }), origins[axis], axis);
+          cellMax[axis] = toCell(std::max({ p0[axis], p1[axis], p2[axis] }), origins[axis], axis);
+        }
+
+        for (uint32_t z = cellMin[2]; z <= cellMax[2]; ++z)
+        {
+          for (uint32_t y = cellMin[1]; y <= cellMax[1]; ++y)
+          {
+            for (uint32_t x = cellMin[0]; x <= cellMax[0]; ++x)
+            {
+              if (pass == 0)
+              {
+                ++cellOffsets[getCellIndex(x, y, z) + 1];
+              }
+              else
+              {
+                cellTriangles[cursors[getCellIndex(x, y, z)]++] = static_cast<uint32_t>(triangle);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    // 元のメッシュで使われている頂点ごとに最も近い三角形を探す
+    std::vector<uint8_t> isUsed(mesh.Vertices.size(), 0);
+    for (const uint32_t index : mesh.Indices)
+    {
+      isUsed[index] = 1;
+    }
+
+    const uint32_t maxRing = std::max({ cellCounts[0], cellCounts[1], cellCounts[2] });
+    double maxDistanceSquared = 0.0;
+    for (size_t vertex = 0; vertex < mesh.Vertices.size(); ++vertex)
+    {
+      if (isUsed[vertex] == 0)
+      {
+        continue;
+      }
+
+      const Vector3 point = load(mesh.Vertices[vertex].Position);
+      const uint32_t center[3] = { toCell(point.X, boundsMin.X, 0), toCell(point.Y, boundsMin.Y, 1), toCell(point.Z, boundsMin.Z, 2) };
+      double bestDistanceSquared = std::numeric_limits<double>::max();
+      for (uint32_t ring = 0; ring <= maxRing; ++ring)
+      {
+        // 中心からring個離れたセルの殻だけを調べる
+        const int64_t ringSize = static_cast<int64_t>(ring);
+        for (int64_t dz = -ringSize; dz <= ringSize; ++dz)
+        {
+          for (int64_t dy = -ringSize; dy <= ringSize; ++dy)
+          {
+            for (int64_t dx = -ringSize; dx <= ringSize; ++dx)
+            {
+              if (std::max({ std::abs(dx), std::abs(dy), std::abs(dz) }) != ringSize)
+              {
+                continue;
+              }
+
+              const int64_t x = static_cast<int64_t>(center[0]) + dx;
+              const int64_t y = static_cast<int64_t>(center[1]) + dy;
+              const int64_t z = static_cast<int64_t>(center[2]) + dz;
+              if (x < 0 || y < 0 || z < 0 || x >= cellCounts[0] || y >= cellCounts[1] || z >= cellCounts[2])
+              {
+                continue;
+              }
+
+              const size_t cell = getCellIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y), static_cast<uint32_t>(z));
+              for (uint32_t i = cellOffsets[cell]; i < cellOffsets[cell + 1]; ++i)
+              {
+                const uint32_t* corners = &indices[cellTriangles[i] * 3];
+                bestDistanceSquared = std::min(
+                                                bestDistanceSquared,
+                                                pointTriangleDistanceSquared(point, load(mesh.Vertices[corners[0]].Position), load(mesh.Vertices[corners[1]].Position), load(mesh.Vertices[corners[2]].Position))
+                                              );
+              }
+            }
+          }
+        }
+
+        // 調べていないセルは調べた範囲の箱の面より遠い
+        const double pointValues[3] = { point.X, point.Y, point.Z };
+        const double origins[3] = { boundsMin.X, boundsMin.Y, boundsMin.Z };
+        double ringDistance = std::numeric_limits<double>::max();
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+          const double lower = origins[axis] + (static_cast<double>(center[axis]) - ring) * cellSize;
+          const double upper = origins[axis] + (static_cast<double>(center[axis]) + ring + 1) * cellSize;
+          ringDistance = std::min({ ringDistance, pointValues[axis] - lower, upper - pointValues[axis] });
+        }
+        if (bestDistanceSquared <= ringDistance * ringDistance)
+        {
+          break;
+        }
+      }
+
+      maxDistanceSquared = std::max(maxDistanceSquared, bestDistanceSquared);
+    }
+
+    return static_cast<float>(std::sqrt(maxDistanceSquared));
+  }
+}
@@ -0,0 +1,472 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Meshlet builder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MeshletBuilder.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // メッシュレット内の頂点番号はuint8で持つ
+  constexpr uint32_t MAX_LOCAL_VERTEX_COUNT = 255;
+  constexpr uint8_t INVALID_LOCAL_INDEX = 0xff;
+  constexpr uint32_t INVALID_TRIANGLE = 0xffffffff;
+
+  // 法線の広がりがこれより大きい(最小の内積がこれ以下)なら裏面の判定をしない
+  constexpr float MIN_CONE_DOT = 0.1f;
+
+  struct Float3
+  {
+    float X;
+    float Y;
+    float Z;
+  };
+
+  Float3 load(const float value[3])
+  {
+    return Float3{ value[0], value[1], value[2] };
+  }
+
+  Float3 subtract(const Float3& a, const Float3& b)
+  {
+    return Float3{ a.X - b.X, a.Y - b.Y, a.Z - b.Z };
+  }
+
+  float dot(const Float3& a, const Float3& b)
+  {
+    return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+  }
+
+  Float3 cross(const Float3& a, const Float3& b)
+  {
+    return Float3{ a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X };
+  }
+
+  Float3 normalize(const Float3& value)
+  {
+    const float length = std::sqrt(dot(value, value));
+    return (length > 0.0f) ? Float3{ value.X / length, value.Y / length, value.Z / length } : Float3{ 0.0f, 0.0f, 0.0f };
+  }
+
+  /// @brief
+  /// 頂点から使っている三角形を引く表(CSR)
+  struct TriangleAdjacency
+  {
+    std::vector<uint32_t> Offsets;          // 頂点数 + 1
+    std::vector<uint32_t> Triangles;
+  };
+
+  void buildAdjacency(const std::vector<uint32_t>& indices, size_t vertexCount, TriangleAdjacency& outAdjacency)
+  {
+    outAdjacency.Offsets.assign(vertexCount + 1, 0);
+    for (const uint32_t index : indices)
+    {
+      ++outAdjacency.Offsets[index + 1];
+    }
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      outAdjacency.Offsets[i + 1] += outAdjacency.Offsets[i];
+    }
+
+    outAdjacency.Triangles.resize(indices.size());
+    std::vector<uint32_t> cursors(outAdjacency.Offsets.begin(), outAdjacency.Offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i)
+    {
+      outAdjacency.Triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    }
+  }
+
+  /// @brief
+  /// 作っている途中のメッシュレット
+  class MeshletState
+  {
+    public:
+      MeshletState(const MFramework::MeshData& mesh, const std::vector<Float3>& triangleNormals, MFramework::MeshletData& data)
+        : m_mesh(mesh)
+        , m_triangleNormals(triangleNormals)
+        , m_data(data)
+        , m_localIndices(mesh.Vertices.size(), INVALID_LOCAL_INDEX)
+        , m_normalSum{ 0.0f, 0.0f, 0.0f }
+        , m_meshlet{}
+      {
+        m_meshlet.VertexOffset = static_cast<uint32_t>(data.VertexIndices.size());
+        m_meshlet.PrimitiveOffset = static_cast<uint32_t>(data.PrimitiveIndices.size());
+      }
+
+      uint32_t GetVertexCount(void) const
+      {
+        return m_meshlet.VertexCount;
+      }
+
+      uint32_t GetTriangleCount(void) const
+      {
+        return m_meshlet.TriangleCount;
+      }
+
+      uint32_t CountNewVertices(uint32_t triangle) const
+      {
+        const uint32_t* corners = &m_mesh.Indices[triangle * 3];
+        return static_cast<uint32_t>(m_localIndices[corners[0]] == INVALID_LOCAL_INDEX) +
+               static_cast<uint32_t>(m_localIndices[corners[1]] == INVALID_LOCAL_INDEX) +
+               static_cast<uint32_t>(m_localIndices[corners[2]] == INVALID_LOCAL_INDEX);
+      }
+
+      Float3 GetAxis(void) const
+      {
+        return normalize(m_normalSum);
+      }
+
+      /// @brief
+      /// 三角形を加える
+      /// @param onNewVertex 新しく加わった頂点ごとに呼ぶ
+      template<typename Func>
+      void Add(uint32_t triangle, Func&& onNewVertex)
+      {
+        const uint32_t* corners = &m_mesh.Indices[triangle * 3];
+        for (uint32_t corner = 0; corner < 3; ++corner)
+        {
+          const uint32_t vertex = corners[corner];
+          if (m_localIndices[vertex] == INVALID_LOCAL_INDEX)
+          {
+            m_localIndices[vertex] = static_cast<uint8_t>(m_meshlet.VertexCount++);
+            m_data.VertexIndices.emplace_back(vertex);
+            onNewVertex(vertex);
+          }
+          m_data.PrimitiveIndices.emplace_back(m_localIndices[vertex]);
+        }
+
+        ++m_meshlet.TriangleCount;
+        const Float3& normal = m_triangleNormals[triangle];
+        m_normalSum = Float3{ m_normalSum.X + normal.X, m_normalSum.Y + normal.Y, m_normalSum.Z + normal.Z };
+      }
+
+      /// @brief
+      /// メッシュレットを確定して次を始める
+      void Flush(void)
+      {
+        if (m_meshlet.TriangleCount == 0)
+        {
+          return;
+        }
+
+        for (uint32_t i = 0; i < m_meshlet.VertexCount; ++i)
+        {
+          m_localIndices[m_data.VertexIndices[m_meshlet.VertexOffset + i]] = INVALID_LOCAL_INDEX;
+        }
+
+        m_data.Meshlets.emplace_back(m_meshlet);
+        m_data.Bounds.emplace_back(MFramework::MeshletBuilder::ComputeBounds(m_mesh, m_data, m_meshlet));
+
+        m_meshlet = MFramework::Meshlet{};
+        m_meshlet.VertexOffset = static_cast<uint32_t>(m_data.VertexIndices.size());
+        m_meshlet.PrimitiveOffset = static_cast<uint32_t>(m_data.PrimitiveIndices.size());
+        m_normalSum = Float3{ 0.0f, 0.0f, 0.0f };
+      }
+
+    private:
+      const MFramework::MeshData& m_mesh;
+      const std::vector<Float3>& m_triangleNormals;
+      MFramework::MeshletData& m_data;
+      std::vector<uint8_t> m_localIndices;      // メッシュの頂点番号 -> メッシュレット内の番号
+      Float3 m_normalSum;
+      MFramework::Meshlet m_meshlet;
+  };
+
+  /// @brief
+  /// 点の集まりを囲む球(Ritterの方法、最小の球より数%大きくなる)
+  void computeBoundingSphere(const Float3* points, size_t count, Float3& outCenter, float& outRadius)
+  {
+    // 各軸で最も離れた点の組のうち一番遠い組から始める
+    size_t minIndices[3] = {};
+    size_t maxIndices[3] = {};
+    for (size_t i = 1; i < count; ++i)
+    {
+      const float values[3] = { points[i].X, points[i].Y, points[i].Z };
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        const float minValue[3] = { points[minIndices[axis]].X, points[minIndices[axis]].Y, points[minIndices[axis]].Z };
+        const float maxValue[3] = { points[maxIndices[axis]].X, points[maxIndices[axis]].Y, points[maxIndices[axis]].Z };
+        if (values[axis] < minValue[axis])
+        {
+          minIndices[axis] = i;
+        }
+        if (values[axis] > maxValue[axis])
+        {
+          maxIndices[axis] = i;
+        }
+      }
+    }
+
+    uint32_t bestAxis = 0;
+    float bestDistance = -1.0f;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      const Float3 difference = subtract(points[maxIndices[axis]], points[minIndices[axis]]);
+      const float distance = dot(difference, difference);
+      if (distance > bestDistance)
+      {
+        bestDistance = distance;
+        bestAxis = axis;
+      }
+    }
+
+    const Float3& p0 = points[minIndices[bestAxis]];
+    const Float3& p1 = points[maxIndices[bestAxis]];
+    Float3 center{ (p0.X + p1.X) * 0.5f, (p0.Y + p1.Y) * 0.5f, (p0.Z + p1.Z) * 0.5f };
+    float radius = std::sqrt(bestDistance) * 0.5f;
+
+    // 外にある点を含むように球を広げる
+    for (size_t i = 0; i < count; ++i)
+    {
+      const Float3 difference = subtract(points[i], center);
+      const float distanceSquared = dot(difference, difference);
+      if (distanceSquared > radius * radius)
+      {
+        const float distance = std::sqrt(distanceSquared);
+        const float newRadius = (radius + distance) * 0.5f;
+        const float shift = (newRadius - radius) / distance;
+        center = Float3{ center.X + difference.X * shift, center.Y + difference.Y * shift, center.Z + difference.Z * shift };
+        radius = newRadius;
+      }
+    }
+
+    outCenter = center;
+    outRadius = radius;
+  }
+}
+
+namespace MFramework
+{
+  void MeshletBuilder::Build(const MeshData& mesh, MeshletData& outData, uint32_t maxVertexCount, uint32_t maxTriangleCount, float coneWeight)
+  {
+    outData = MeshletData{};
+
+    maxVertexCount = std::clamp(maxVertexCount, 3u, MAX_LOCAL_VERTEX_COUNT);
+    maxTriangleCount = std::max(maxTriangleCount, 1u);
+
+    const size_t triangleCount = mesh.Indices.size() / 3;
+    if (triangleCount == 0)
+    {
+      return;
+    }
+
+    TriangleAdjacency adjacency;
+    buildAdjacency(mesh.Indices, mesh.Vertices.size(), adjacency);
+
+    std::vector<Float3> triangleNormals(triangleCount);
+    for (size_t i = 0; i < triangleCount; ++i)
+    {
+      const Float3 p0 = load(mesh.Vertices[mesh.Indices[i * 3 + 0]].Position);
+      const Float3 p1 = load(mesh.Vertices[mesh.Indices[i * 3 + 1]].Position);
+      const Float3 p2 = load(mesh.Vertices[mesh.Indices[i * 3 + 2]].Position);
+      triangleNormals[i] = normalize(cross(subtract(p1, p0), subtract(p2, p0)));
+    }
+
+    // 一つのメッシュレットには最大で三角形数と同じだけの頂点が入る
+    outData.Meshlets.reserve(triangleCount / maxTriangleCount + 1);
+    outData.VertexIndices.reserve(std::min(mesh.Indices.size(), mesh.Vertices.size() * 2));
+    outData.PrimitiveIndices.reserve(mesh.Indices.size());
+
+    MeshletState state(mesh, triangleNormals, outData);
+    std::vector<uint8_t> isTriangleUsed(triangleCount, 0);
+    std::vector<uint32_t> candidateStamps(triangleCount, INVALID_TRIANGLE);   // 候補に入れたメッシュレットの番号(重複を防ぐ)
+    std::vector<uint32_t> candidates;
+    uint32_t meshletStamp = 0;
+    size_t seedCursor = 0;
+    size_t usedCount = 0;
+
+    // 頂点ごとの未使用の三角形の数
+    std::vector<uint32_t> liveCounts(mesh.Vertices.size());
+    for (size_t i = 0; i < mesh.Vertices.size(); ++i)
+    {
+      liveCounts[i] = adjacency.Offsets[i + 1] - adjacency.Offsets[i];
+    }
+
+    auto addCandidates = [&](uint32_t vertex)
+    {
+      for (uint32_t i = adjacency.Offsets[vertex]; i < adjacency.Offsets[vertex + 1]; ++i)
+      {
+        const uint32_t triangle = adjacency.Triangles[i];
+        if (isTriangleUsed[triangle] == 0 && candidateStamps[triangle] != meshletStamp)
+        {
+          candidateStamps[triangle] = meshletStamp;
+          candidates.emplace_back(triangle);
+        }
+      }
+    };
+
+    auto addTriangle = [&](uint32_t triangle)
+    {
+      isTriangleUsed[triangle] = 1;
+      ++usedCount;
+      --liveCounts[mesh.Indices[triangle * 3 + 0]];
+      --liveCounts[mesh.Indices[triangle * 3 + 1]];
+      --liveCounts[mesh.Indices[triangle * 3 + 2]];
+      state.Add(triangle, addCandidates);
+    };
+
+    while (usedCount < triangleCount)
+    {
+      // 候補から新しい頂点が少なく、法線がメッシュレットの向きに近い三角形を選ぶ
+      const Float3 axis = state.GetAxis();
+      const bool hasAxis = state.GetTriangleCount() > 0;
+      uint32_t bestTriangle = INVALID_TRIANGLE;
+      float bestScore = std::numeric_limits<float>::max();
+      for (size_t i = 0; i < candidates.size();)
+      {
+        const uint32_t triangle = candidates[i];
+        if (isTriangleUsed[triangle] != 0)
+        {
+          candidates[i] = candidates.back();
+          candidates.pop_back();
+          continue;
+        }
+
+        const uint32_t newVertexCount = state.CountNewVertices(triangle);
+        const float deviation = hasAxis ? 1.0f - dot(triangleNormals[triangle], axis) : 0.0f;
+        // 頂点を使い切る三角形は新しい頂点があっても先に選ぶ(取り残された三角形で小さなメッシュレットができるのを防ぐ)
+        const uint32_t* corners = &mesh.Indices[triangle * 3];
+        const bool isClosing = (liveCounts[corners[0]] == 1 || liveCounts[corners[1]] == 1 || liveCounts[corners[2]] == 1);
+        const float score = static_cast<float>(isClosing ? 0 : newVertexCount) + coneWeight * deviation;
+        if (score < bestScore && state.GetVertexCount() + newVertexCount <= maxVertexCount)
+        {
+          bestScore = score;
+          bestTriangle = triangle;
+        }
+        ++i;
+      }
+
+      if (bestTriangle != INVALID_TRIANGLE && state.GetTriangleCount() < maxTriangleCount)
+      {
+        addTriangle(bestTriangle);
+        continue;
+      }
+
+      // 入らなくなったら確定する
+      // 残った候補は次のメッシュレットの始まりに使う(境界に沿って隣に続けると飛び地ができにくい)
+      // 未使用の隣接が最も少ない三角形(使用済みの領域に囲まれたところ)から始める
+      if (state.GetTriangleCount() > 0)
+      {
+        state.Flush();
+        ++meshletStamp;
+
+        uint32_t seed = INVALID_TRIANGLE;
+        uint32_t seedLiveCount = std::numeric_limits<uint32_t>::max();
+        for (const uint32_t triangle : candidates)
+        {
+          const uint32_t* corners = &mesh.Indices[triangle * 3];
+          const uint32_t liveCount = liveCounts[corners[0]] + liveCounts[corners[1]] + liveCounts[corners[2]];
+          if (isTriangleUsed[triangle] == 0 && liveCount < seedLiveCount)
+          {
+            seed = triangle;
+            seedLiveCount = liveCount;
+          }
+        }
+        candidates.clear();
+
+        if (seed != INVALID_TRIANGLE)
+        {
+          addTriangle(seed);
+          continue;
+        }
+      }
+
+      // 隣接する三角形がなければ元の順番で次の未使用の三角形から始める
+      while (isTriangleUsed[seedCursor] != 0)
+      {
+        ++seedCursor;
+      }
+      addTriangle(static_cast<uint32_t>(seedCursor));
+    }
+
+    state.Flush();
+  }
+
+  MeshletBounds MeshletBuilder::ComputeBounds(const MeshData& mesh, const MeshletData& data, const Meshlet& meshlet)
+  {
+    MeshletBounds bounds{};
+
+    Float3 points[MAX_LOCAL_VERTEX_COUNT];
+    const uint32_t vertexCount = std::min(meshlet.VertexCount, MAX_LOCAL_VERTEX_COUNT);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+      points[i] = load(mesh.Vertices[data.VertexIndices[meshlet.VertexOffset + i]].Position);
+    }
+
+    if (vertexCount > 0)
+    {
+      Float3 center{};
+      computeBoundingSphere(points, vertexCount, center, bounds.Radius);
+      bounds.Center[0] = center.X;
+      bounds.Center[1] = center.Y;
+      bounds.Center[2] = center.Z;
+    }
+
+    // 法線の平均を軸にして、軸から最も離れた法線との角度で円錐を作る(面積0の三角形は除く)
+    Float3 normals[MESHLET_MAX_TRIANGLE_COUNT];
+    std::vector<Float3> largeNormals;
+    Float3* triangleNormals = normals;
+    if (meshlet.TriangleCount > MESHLET_MAX_TRIANGLE_COUNT)
+    {
+      largeNormals.resize(meshlet.TriangleCount);
+      triangleNormals = largeNormals.data();
+    }
+
+    uint32_t normalCount = 0;
+    Float3 normalSum{ 0.0f, 0.0f, 0.0f };
+    for (uint32_t i = 0; i < meshlet.TriangleCount; ++i)
+    {
+      const uint8_t* corners = &data.PrimitiveIndices[meshlet.PrimitiveOffset + i * 3];
+      const Float3 p0 = points[corners[0]];
+      const Float3 normal = normalize(cross(subtract(points[corners[1]], p0), subtract(points[corners[2]], p0)));
+      if (dot(normal, normal) == 0.0f)
+      {
+        continue;
+      }
+
+      triangleNormals[normalCount++] = normal;
+      normalSum = Float3{ normalSum.X + normal.X, normalSum.Y + normal.Y, normalSum.Z + normal.Z };
+    }
+
+    const Float3 axis = normalize(normalSum);
+    float minDot = 1.0f;
+    for (uint32_t i = 0; i < normalCount; ++i)
+    {
+      minDot = std::min(minDot, dot(triangleNormals[i], axis));
+    }
+
+    bounds.ConeAxis[0] = axis.X;
+    bounds.ConeAxis[1] = axis.Y;
+    bounds.ConeAxis[2] = axis.Z;
+    bounds.ConeCutoff = (normalCount == 0 || minDot <= MIN_CONE_DOT) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+    return bounds;
+  }
+
+  void MeshletBuilder::AppendIndices(const MeshletData& data, const uint32_t* meshletIndices, size_t meshletCount, std::vector<uint32_t>& outIndices)
+  {
+    for (size_t i = 0; i < meshletCount; ++i)
+    {
+      const Meshlet& meshlet = data.Meshlets[meshletIndices[i]];
+      const uint32_t* vertexIndices = &data.VertexIndices[meshlet.VertexOffset];
+      const uint8_t* primitiveIndices = &data.PrimitiveIndices[meshlet.PrimitiveOffset];
+      for (uint32_t j = 0; j < meshlet.TriangleCount * 3; ++j)
+      {
+        outIndices.emplace_back(vertexIndices[primitiveIndices[j]]);
+      }
+    }
+  }
+}
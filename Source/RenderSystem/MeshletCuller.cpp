@@ -0,0 +1,205 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU meshlet culling (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MeshletCuller.h>
+
+#include <RenderSystem/Camera.h>
+#include <RenderSystem/MeshletBuilder.h>
+
+#include <cmath>
+
+// x64ではSSE2が必ず使える
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+  #define M_MESHLET_CULLER_USE_SSE 1
+  #include <emmintrin.h>
+#else
+  #define M_MESHLET_CULLER_USE_SSE 0
+#endif
+
+namespace
+{
+  // 下位4ビットのマスクに立っているビットの数
+  constexpr uint32_t MASK_BIT_COUNTS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+  /// @brief
+  /// 判定に使うカメラの値
+  struct CullCamera
+  {
+    float Planes[MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT][4];
+    float Position[3];
+  };
+
+  /// @brief
+  /// 4つのメッシュレットの判定結果
+  struct BatchResult
+  {
+    uint32_t FrustumCulledMask;
+    uint32_t BackfaceCulledMask;
+  };
+
+#if !M_MESHLET_CULLER_USE_SSE
+  BatchResult testBatchScalar(const MFramework::MeshletCullBatch& batch, const CullCamera& camera, uint32_t laneCount)
+  {
+    BatchResult result{};
+    for (uint32_t lane = 0; lane < laneCount; ++lane)
+    {
+      const float center[3] = { batch.CenterX[lane], batch.CenterY[lane], batch.CenterZ[lane] };
+      const float radius = batch.Radius[lane];
+
+      // SSE版と同じく、一つでも平面の外側にあれば見えない
+      bool isOutside = false;
+      for (uint32_t plane = 0; plane < MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT; ++plane)
+      {
+        const float* p = camera.Planes[plane];
+        const float distance = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+        isOutside = isOutside || (distance < -radius);
+      }
+      if (isOutside)
+      {
+        result.FrustumCulledMask |= 1u << lane;
+        continue;
+      }
+
+      const float view[3] = { center[0] - camera.Position[0], center[1] - camera.Position[1], center[2] - camera.Position[2] };
+      const float viewLength = std::sqrt(view[0] * view[0] + view[1] * view[1] + view[2] * view[2]);
+      const float projected = view[0] * batch.AxisX[lane] + view[1] * batch.AxisY[lane] + view[2] * batch.AxisZ[lane];
+      if (projected >= batch.Cutoff[lane] * viewLength + radius)
+      {
+        result.BackfaceCulledMask |= 1u << lane;
+      }
+    }
+
+    return result;
+  }
+#else
+  BatchResult testBatchSse(const MFramework::MeshletCullBatch& batch, const __m128 planes[MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT][4], const __m128 position[3], uint32_t laneMask)
+  {
+    const __m128 centerX = _mm_load_ps(batch.CenterX);
+    const __m128 centerY = _mm_load_ps(batch.CenterY);
+    const __m128 centerZ = _mm_load_ps(batch.CenterZ);
+    const __m128 radius = _mm_load_ps(batch.Radius);
+    const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+    // 一つでも平面の外側にあれば見えない
+    __m128 outside = _mm_setzero_ps();
+    for (uint32_t plane = 0; plane < MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT; ++plane)
+    {
+      const __m128 distance = _mm_add_ps(
+                                          _mm_add_ps(_mm_mul_ps(planes[plane][0], centerX), _mm_mul_ps(planes[plane][1], centerY)),
+                                          _mm_add_ps(_mm_mul_ps(planes[plane][2], centerZ), planes[plane][3])
+                                        );
+      outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+    }
+
+    const __m128 viewX = _mm_sub_ps(centerX, position[0]);
+    const __m128 viewY = _mm_sub_ps(centerY, position[1]);
+    const __m128 viewZ = _mm_sub_ps(centerZ, position[2]);
+    const __m128 viewLength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(viewX, viewX), _mm_mul_ps(viewY, viewY)), _mm_mul_ps(viewZ, viewZ)));
+    const __m128 projected = _mm_add_ps(
+                                          _mm_add_ps(_mm_mul_ps(viewX, _mm_load_ps(batch.AxisX)), _mm_mul_ps(viewY, _mm_load_ps(batch.AxisY))),
+                                          _mm_mul_ps(viewZ, _mm_load_ps(batch.AxisZ))
+                                        );
+    const __m128 backface = _mm_cmpge_ps(projected, _mm_add_ps(_mm_mul_ps(_mm_load_ps(batch.Cutoff), viewLength), radius));
+
+    BatchResult result{};
+    result.FrustumCulledMask = static_cast<uint32_t>(_mm_movemask_ps(outside)) & laneMask;
+    result.BackfaceCulledMask = static_cast<uint32_t>(_mm_movemask_ps(backface)) & laneMask & ~result.FrustumCulledMask;
+    return result;
+  }
+#endif
+}
+
+namespace MFramework
+{
+  void MeshletCuller::Prepare(const MeshletData& data, MeshletCullData& outCullData)
+  {
+    const uint32_t meshletCount = static_cast<uint32_t>(data.Meshlets.size());
+    outCullData.MeshletCount = meshletCount;
+    outCullData.Batches.assign((meshletCount + MESHLET_CULL_BATCH_SIZE - 1) / MESHLET_CULL_BATCH_SIZE, MeshletCullBatch{});
+    outCullData.TriangleCounts.resize(meshletCount);
+
+    for (uint32_t i = 0; i < meshletCount; ++i)
+    {
+      const MeshletBounds& bounds = data.Bounds[i];
+      MeshletCullBatch& batch = outCullData.Batches[i / MESHLET_CULL_BATCH_SIZE];
+      const uint32_t lane = i % MESHLET_CULL_BATCH_SIZE;
+      batch.CenterX[lane] = bounds.Center[0];
+      batch.CenterY[lane] = bounds.Center[1];
+      batch.CenterZ[lane] = bounds.Center[2];
+      batch.Radius[lane] = bounds.Radius;
+      batch.AxisX[lane] = bounds.ConeAxis[0];
+      batch.AxisY[lane] = bounds.ConeAxis[1];
+      batch.AxisZ[lane] = bounds.ConeAxis[2];
+      batch.Cutoff[lane] = bounds.ConeCutoff;
+      outCullData.TriangleCounts[i] = data.Meshlets[i].TriangleCount;
+    }
+  }
+
+  MeshletCullStats MeshletCuller::Cull(const MeshletCullData& cullData, const MGameEngine::Camera& camera, std::vector<uint32_t>& outVisibleIndices)
+  {
+    MeshletCullStats stats{};
+    outVisibleIndices.clear();
+    outVisibleIndices.reserve(cullData.MeshletCount);
+
+    CullCamera cullCamera{};
+    camera.GetFrustumPlanes(cullCamera.Planes);
+    cullCamera.Position[0] = camera.GetPosition()[0];
+    cullCamera.Position[1] = camera.GetPosition()[1];
+    cullCamera.Position[2] = camera.GetPosition()[2];
+
+#if M_MESHLET_CULLER_USE_SSE
+    __m128 planes[MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT][4];
+    for (uint32_t plane = 0; plane < MGameEngine::CAMERA_FRUSTUM_PLANE_COUNT; ++plane)
+    {
+      for (uint32_t component = 0; component < 4; ++component)
+      {
+        planes[plane][component] = _mm_set1_ps(cullCamera.Planes[plane][component]);
+      }
+    }
+    const __m128 position[3] = { _mm_set1_ps(cullCamera.Position[0]), _mm_set1_ps(cullCamera.Position[1]), _mm_set1_ps(cullCamera.Position[2]) };
+#endif
+
+    const size_t batchCount = cullData.Batches.size();
+    for (size_t batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+    {
+      // 最後のバッチは埋めていないレーンを除く
+      const uint32_t firstIndex = static_cast<uint32_t>(batchIndex * MESHLET_CULL_BATCH_SIZE);
+      const uint32_t laneCount = (cullData.MeshletCount - firstIndex < MESHLET_CULL_BATCH_SIZE) ? (cullData.MeshletCount - firstIndex) : MESHLET_CULL_BATCH_SIZE;
+      const uint32_t laneMask = (1u << laneCount) - 1;
+
+#if M_MESHLET_CULLER_USE_SSE
+      const BatchResult result = testBatchSse(cullData.Batches[batchIndex], planes, position, laneMask);
+#else
+      const BatchResult result = testBatchScalar(cullData.Batches[batchIndex], cullCamera, laneCount);
+#endif
+
+      stats.TestedCount += laneCount;
+      stats.FrustumCulledCount += MASK_BIT_COUNTS[result.FrustumCulledMask];
+      stats.BackfaceCulledCount += MASK_BIT_COUNTS[result.BackfaceCulledMask];
+
+      uint32_t visibleMask = laneMask & ~(result.FrustumCulledMask | result.BackfaceCulledMask);
+      while (visibleMask != 0)
+      {
+        const uint32_t lane = MASK_BIT_COUNTS[(visibleMask & (0u - visibleMask)) - 1];
+        visibleMask &= visibleMask - 1;
+        outVisibleIndices.emplace_back(firstIndex + lane);
+        stats.VisibleTriangleCount += cullData.TriangleCounts[firstIndex + lane];
+      }
+    }
+
+    stats.VisibleCount = static_cast<uint32_t>(outVisibleIndices.size());
+    return stats;
+  }
+}
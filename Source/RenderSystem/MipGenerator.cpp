@@ -0,0 +1,831 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : CPU mip chain generator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MipGenerator.h>
+#include <RenderSystem/TextureFootprint.h>
+#include <HalfUtil.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// x64ではSSE2が必ず使える
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+  #define M_MIP_GENERATOR_USE_SSE 1
+  #include <emmintrin.h>
+#else
+  #define M_MIP_GENERATOR_USE_SSE 0
+#endif
+
+namespace
+{
+  // DXGI_FORMAT
+  constexpr uint32_t FORMAT_R32G32B32A32_FLOAT = 2;
+  constexpr uint32_t FORMAT_R16G16B16A16_FLOAT = 10;
+  constexpr uint32_t FORMAT_R8G8B8A8_UNORM = 28;
+  constexpr uint32_t FORMAT_R8G8B8A8_UNORM_SRGB = 29;
+  constexpr uint32_t FORMAT_B8G8R8A8_UNORM = 87;
+  constexpr uint32_t FORMAT_B8G8R8A8_UNORM_SRGB = 91;
+
+  constexpr uint32_t CHANNEL_COUNT = 4;
+  constexpr uint32_t ALPHA_CHANNEL = 3;       // RGBA/BGRAどちらも4番目がアルファ
+
+  constexpr float DEFAULT_ALPHA_REFERENCE = 0.5f;
+  constexpr float DEFAULT_KAISER_WIDTH = 3.0f;
+  constexpr float DEFAULT_KAISER_ALPHA = 4.0f;
+  constexpr size_t ALPHA_HISTOGRAM_SIZE = 1024;
+  constexpr float MIN_ALPHA_THRESHOLD = 1.0f / 1024.0f;
+
+  // ParallelForの一つのチャンクで処理するピクセル数の目安
+  constexpr size_t PIXELS_PER_CHUNK = 16384;
+  // 横方向の結果を溜めてから縦方向を計算する行数(縮小先の行数)
+  constexpr size_t BAND_ROW_COUNT = 4;
+
+  constexpr double PI = 3.14159265358979323846;
+
+  enum class PixelType : uint8_t
+  {
+    UNorm8,
+    Float16,
+    Float32,
+  };
+
+  /// @brief
+  /// 縮小先の一ピクセルが参照する元の範囲
+  struct FilterTap
+  {
+    uint32_t First;
+    uint32_t Count;
+    uint32_t WeightOffset;
+  };
+
+  /// @brief
+  /// 一方向分の縮小フィルター(縮小先のピクセルごとの重み)
+  struct FilterKernel
+  {
+    std::vector<FilterTap> Taps;
+    std::vector<float> Weights;
+  };
+
+  constexpr size_t SRGB_ENCODE_TABLE_SIZE = 4096;
+
+  struct SRGBTable
+  {
+    float ToLinear[256];
+    float EncodeThresholds[255];                    // sRGBの値iとi+1の中間に当たる線形値
+    uint8_t EncodeTable[SRGB_ENCODE_TABLE_SIZE];    // 線形値を量子化した位置から引く初期値(正確な値以下になる)
+  };
+
+  float srgbToLinear(double value)
+  {
+    return static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+  }
+
+  const SRGBTable& getSRGBTable()
+  {
+    static const SRGBTable table = []()
+    {
+      SRGBTable result{};
+      for (uint32_t i = 0; i < 256; ++i)
+      {
+        result.ToLinear[i] = srgbToLinear(i / 255.0);
+      }
+      for (uint32_t i = 0; i < 255; ++i)
+      {
+        result.EncodeThresholds[i] = srgbToLinear((i + 0.5) / 255.0);
+      }
+      for (size_t i = 0; i < SRGB_ENCODE_TABLE_SIZE; ++i)
+      {
+        const float linear = static_cast<float>(i) / (SRGB_ENCODE_TABLE_SIZE - 1);
+        result.EncodeTable[i] = static_cast<uint8_t>(std::upper_bound(result.EncodeThresholds, result.EncodeThresholds + 255, linear) - result.EncodeThresholds);
+      }
+      return result;
+    }();
+
+    return table;
+  }
+
+  uint8_t encodeSRGB(const SRGBTable& table, float linear)
+  {
+    // 表で近くまで引いてから閾値と比べて進める(sRGB空間で最も近い値に丸めたことになる)
+    if (!(linear > 0.0f))
+    {
+      return 0;
+    }
+
+    linear = std::min(linear, 1.0f);
+    uint32_t value = table.EncodeTable[static_cast<size_t>(linear * (SRGB_ENCODE_TABLE_SIZE - 1))];
+    while (value < 255 && linear >= table.EncodeThresholds[value])
+    {
+      ++value;
+    }
+
+    return static_cast<uint8_t>(value);
+  }
+
+  uint8_t encodeUNorm8(float value)
+  {
+    // SIMD版(_mm_cvtps_epi32)と同じく最近接偶数に丸める
+    return static_cast<uint8_t>(std::lrint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+  }
+
+  PixelType getPixelType(uint32_t format)
+  {
+    switch (format)
+    {
+      case FORMAT_R32G32B32A32_FLOAT:
+        return PixelType::Float32;
+      case FORMAT_R16G16B16A16_FLOAT:
+        return PixelType::Float16;
+      default:
+        return PixelType::UNorm8;
+    }
+  }
+
+  uint32_t getBytesPerPixel(PixelType type)
+  {
+    switch (type)
+    {
+      case PixelType::Float32:
+        return 16;
+      case PixelType::Float16:
+        return 8;
+      default:
+        return 4;
+    }
+  }
+
+  double besselI0(double x)
+  {
+    // 級数展開(収束するまで足す)
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x * 0.5;
+    for (uint32_t k = 1; k < 64; ++k)
+    {
+      const double factor = halfX / k;
+      term *= factor * factor;
+      sum += term;
+      if (term < sum * 1e-12)
+      {
+        break;
+      }
+    }
+
+    return sum;
+  }
+
+  double kaiserWeight(double t, double width, double alpha)
+  {
+    const double absT = std::abs(t);
+    if (absT >= width)
+    {
+      return 0.0;
+    }
+
+    const double sinc = (absT < 1e-9) ? 1.0 : std::sin(PI * t) / (PI * t);
+    const double ratio = t / width;
+    return sinc * besselI0(alpha * std::sqrt(1.0 - ratio * ratio)) / besselI0(alpha);
+  }
+
+  /// @brief
+  /// srcSizeからdstSizeに縮小するフィルターを作る
+  /// 範囲外は端のピクセルを繰り返す
+  FilterKernel buildKernel(uint32_t srcSize, uint32_t dstSize, const MFramework::MipGenerateDesc& desc)
+  {
+    FilterKernel kernel;
+    kernel.Taps.reserve(dstSize);
+
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    const int64_t lastIndex = static_cast<int64_t>(srcSize) - 1;
+    std::vector<double> weights;
+
+    for (uint32_t x = 0; x < dstSize; ++x)
+    {
+      // 元の座標系での縮小先ピクセルの中心
+      const double center = (x + 0.5) * scale;
+      const double radius = (desc.Filter == MFramework::MipFilter::Box) ? scale * 0.5 : desc.KaiserWidth * scale;
+      const int64_t rawFirst = static_cast<int64_t>(std::floor(center - radius));
+      const int64_t rawLast = static_cast<int64_t>(std::ceil(center + radius)) - 1;
+      const int64_t first = std::clamp<int64_t>(rawFirst, 0, lastIndex);
+      const int64_t last = std::clamp<int64_t>(rawLast, 0, lastIndex);
+
+      weights.assign(static_cast<size_t>(last - first + 1), 0.0);
+      for (int64_t i = rawFirst; i <= rawLast; ++i)
+      {
+        double weight = 0.0;
+        if (desc.Filter == MFramework::MipFilter::Box)
+        {
+          // ピクセル[i, i + 1)と範囲の重なり
+          weight = std::min(center + radius, i + 1.0) - std::max(center - radius, static_cast<double>(i));
+        }
+        else
+        {
+          weight = kaiserWeight((i + 0.5 - center) / scale, desc.KaiserWidth, desc.KaiserAlpha);
+        }
+
+        weights[static_cast<size_t>(std::clamp<int64_t>(i, 0, lastIndex) - first)] += weight;
+      }
+
+      double sum = 0.0;
+      for (const double weight : weights)
+      {
+        sum += weight;
+      }
+
+      FilterTap tap{};
+      tap.First = static_cast<uint32_t>(first);
+      tap.Count = static_cast<uint32_t>(weights.size());
+      tap.WeightOffset = static_cast<uint32_t>(kernel.Weights.size());
+
+      // 重みの合計が1になるように正規化する
+      for (const double weight : weights)
+      {
+        kernel.Weights.emplace_back(static_cast<float>(sum != 0.0 ? weight / sum : 1.0 / weights.size()));
+      }
+
+      kernel.Taps.emplace_back(tap);
+    }
+
+    return kernel;
+  }
+
+  /// @brief
+  /// 一行をRGBAのfloatに展開する
+  void loadRow(const uint8_t* src, float* dst, uint32_t width, PixelType type, const SRGBTable* srgb)
+  {
+    switch (type)
+    {
+      case PixelType::Float32:
+      {
+        std::memcpy(dst, src, static_cast<size_t>(width) * CHANNEL_COUNT * sizeof(float));
+        break;
+      }
+      case PixelType::Float16:
+      {
+        uint16_t half = 0;
+        for (size_t i = 0; i < static_cast<size_t>(width) * CHANNEL_COUNT; ++i)
+        {
+          std::memcpy(&half, src + i * sizeof(uint16_t), sizeof(uint16_t));
+          dst[i] = MFramework::HalfUtility::HalfToFloat(half);
+        }
+        break;
+      }
+      default:
+      {
+        if (srgb != nullptr)
+        {
+          for (size_t x = 0; x < width; ++x)
+          {
+            const uint8_t* pixel = src + x * CHANNEL_COUNT;
+            float* out = dst + x * CHANNEL_COUNT;
+            out[0] = srgb->ToLinear[pixel[0]];
+            out[1] = srgb->ToLinear[pixel[1]];
+            out[2] = srgb->ToLinear[pixel[2]];
+            out[ALPHA_CHANNEL] = pixel[ALPHA_CHANNEL] / 255.0f;
+          }
+          break;
+        }
+
+        size_t x = 0;
+#if M_MIP_GENERATOR_USE_SSE
+        // 4ピクセル(16byte)ずつ32bit整数に広げてからfloatにする
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 4 <= width; x += 4)
+        {
+          const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * CHANNEL_COUNT));
+          const __m128i low16 = _mm_unpacklo_epi8(bytes, zero);
+          const __m128i high16 = _mm_unpackhi_epi8(bytes, zero);
+          float* out = dst + x * CHANNEL_COUNT;
+          _mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low16, zero)), scale));
+          _mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low16, zero)), scale));
+          _mm_storeu_ps(out + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high16, zero)), scale));
+          _mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high16, zero)), scale));
+        }
+#endif
+        for (size_t i = x * CHANNEL_COUNT; i < static_cast<size_t>(width) * CHANNEL_COUNT; ++i)
+        {
+          dst[i] = src[i] / 255.0f;
+        }
+        break;
+      }
+    }
+  }
+
+  /// @brief
+  /// RGBAのfloatの一行を元のフォーマットに戻す
+  void storeRow(const float* src, uint8_t* dst, uint32_t width, PixelType type, const SRGBTable* srgb, float alphaScale)
+  {
+    const bool isScaleAlpha = (alphaScale != 1.0f);
+
+    switch (type)
+    {
+      case PixelType::Float32:
+      case PixelType::Float16:
+      {
+        for (size_t x = 0; x < width; ++x)
+        {
+          float pixel[CHANNEL_COUNT] = { src[x * 4], src[x * 4 + 1], src[x * 4 + 2], src[x * 4 + 3] };
+          if (isScaleAlpha)
+          {
+            pixel[ALPHA_CHANNEL] = std::clamp(pixel[ALPHA_CHANNEL] * alphaScale, 0.0f, 1.0f);
+          }
+
+          if (type == PixelType::Float32)
+          {
+            std::memcpy(dst + x * sizeof(pixel), pixel, sizeof(pixel));
+            continue;
+          }
+
+          for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+          {
+            const uint16_t half = MFramework::HalfUtility::FloatToHalf(pixel[c]);
+            std::memcpy(dst + (x * CHANNEL_COUNT + c) * sizeof(uint16_t), &half, sizeof(uint16_t));
+          }
+        }
+        break;
+      }
+      default:
+      {
+        if (srgb != nullptr)
+        {
+          for (size_t x = 0; x < width; ++x)
+          {
+            const float* pixel = src + x * CHANNEL_COUNT;
+            uint8_t* out = dst + x * CHANNEL_COUNT;
+            for (uint32_t c = 0; c < ALPHA_CHANNEL; ++c)
+            {
+              out[c] = encodeSRGB(*srgb, pixel[c]);
+            }
+            out[ALPHA_CHANNEL] = encodeUNorm8(pixel[ALPHA_CHANNEL] * alphaScale);
+          }
+          break;
+        }
+
+        size_t x = 0;
+#if M_MIP_GENERATOR_USE_SSE
+        // 一ピクセルずつ[0, 255]に変換して8bitに詰める
+        const __m128 scale = _mm_set_ps(255.0f * alphaScale, 255.0f, 255.0f, 255.0f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 maxValue = _mm_set1_ps(255.0f);
+        for (; x + 1 < width; x += 2)
+        {
+          const __m128 p0 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + x * 4), scale), zero), maxValue);
+          const __m128 p1 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + x * 4 + 4), scale), zero), maxValue);
+          const __m128i packed16 = _mm_packs_epi32(_mm_cvtps_epi32(p0), _mm_cvtps_epi32(p1));
+          const __m128i packed8 = _mm_packus_epi16(packed16, packed16);
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * CHANNEL_COUNT), packed8);
+        }
+#endif
+        for (; x < width; ++x)
+        {
+          const float* pixel = src + x * CHANNEL_COUNT;
+          uint8_t* out = dst + x * CHANNEL_COUNT;
+          for (uint32_t c = 0; c < ALPHA_CHANNEL; ++c)
+          {
+            out[c] = encodeUNorm8(pixel[c]);
+          }
+          out[ALPHA_CHANNEL] = encodeUNorm8(pixel[ALPHA_CHANNEL] * alphaScale);
+        }
+        break;
+      }
+    }
+  }
+
+  /// @brief
+  /// 横方向に一行縮小する(一ピクセル = RGBAの4floatをまとめて計算する)
+  void filterRowHorizontal(const float* src, float* dst, const FilterKernel& kernel)
+  {
+    for (size_t x = 0; x < kernel.Taps.size(); ++x)
+    {
+      const FilterTap& tap = kernel.Taps[x];
+      const float* weights = kernel.Weights.data() + tap.WeightOffset;
+      const float* pixels = src + static_cast<size_t>(tap.First) * CHANNEL_COUNT;
+
+#if M_MIP_GENERATOR_USE_SSE
+      __m128 sum = _mm_setzero_ps();
+      for (uint32_t i = 0; i < tap.Count; ++i)
+      {
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[i]), _mm_loadu_ps(pixels + i * CHANNEL_COUNT)));
+      }
+      _mm_storeu_ps(dst + x * CHANNEL_COUNT, sum);
+#else
+      float sum[CHANNEL_COUNT] = {};
+      for (uint32_t i = 0; i < tap.Count; ++i)
+      {
+        for (uint32_t c = 0; c < CHANNEL_COUNT; ++c)
+        {
+          sum[c] += weights[i] * pixels[i * CHANNEL_COUNT + c];
+        }
+      }
+      std::memcpy(dst + x * CHANNEL_COUNT, sum, sizeof(sum));
+#endif
+    }
+  }
+
+  /// @brief
+  /// 縦方向に一行縮小する
+  /// 8floatずつ全タップを足し切ってから書き込むため、途中結果をメモリに戻さない
+  void filterRowVertical(const float* src, size_t rowFloatCount, float* dst, const FilterTap& tap, const float* weights)
+  {
+    const float* firstRow = src + static_cast<size_t>(tap.First) * rowFloatCount;
+    size_t i = 0;
+
+#if M_MIP_GENERATOR_USE_SSE
+    for (; i + 8 <= rowFloatCount; i += 8)
+    {
+      __m128 sum0 = _mm_setzero_ps();
+      __m128 sum1 = _mm_setzero_ps();
+      const float* row = firstRow + i;
+      for (uint32_t t = 0; t < tap.Count; ++t, row += rowFloatCount)
+      {
+        const __m128 weight = _mm_set1_ps(weights[t]);
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(weight, _mm_loadu_ps(row)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(weight, _mm_loadu_ps(row + 4)));
+      }
+      _mm_storeu_ps(dst + i, sum0);
+      _mm_storeu_ps(dst + i + 4, sum1);
+    }
+#endif
+
+    for (; i < rowFloatCount; ++i)
+    {
+      float sum = 0.0f;
+      const float* row = firstRow + i;
+      for (uint32_t t = 0; t < tap.Count; ++t, row += rowFloatCount)
+      {
+        sum += weights[t] * (*row);
+      }
+      dst[i] = sum;
+    }
+  }
+
+  /// @brief
+  /// 行の帯に分けて並列に処理する
+  void parallelRows(MFramework::ThreadPool* threadPool, size_t rowCount, size_t rowPixelCount, const MFramework::ThreadPool::RangeFunc& func)
+  {
+    if (threadPool == nullptr)
+    {
+      func(0, rowCount);
+      return;
+    }
+
+    const size_t minChunkSize = std::max<size_t>(1, PIXELS_PER_CHUNK / std::max<size_t>(rowPixelCount, 1));
+    threadPool->ParallelFor(rowCount, func, minChunkSize);
+  }
+
+  /// @brief
+  /// アルファが閾値を超えるピクセルの数
+  uint64_t countAlphaAbove(const float* pixels, size_t pixelCount, float threshold)
+  {
+    uint64_t count = 0;
+    const float* alpha = pixels + ALPHA_CHANNEL;
+    for (size_t i = 0; i < pixelCount; ++i, alpha += CHANNEL_COUNT)
+    {
+      count += (*alpha > threshold) ? 1 : 0;
+    }
+
+    return count;
+  }
+
+  /// @brief
+  /// アルファのヒストグラムから、閾値を超える割合が目標に最も近くなる閾値を探し、アルファの倍率に変換する
+  float findAlphaScale(const float* pixels, uint32_t width, uint32_t height, float targetCoverage, float reference, MFramework::ThreadPool* threadPool)
+  {
+    std::vector<uint64_t> histogram(ALPHA_HISTOGRAM_SIZE, 0);
+    std::mutex histogramMutex;
+    parallelRows(
+                  threadPool, height, width,
+                  [&](size_t begin, size_t end)
+                  {
+                    std::vector<uint64_t> local(ALPHA_HISTOGRAM_SIZE, 0);
+                    const float* alpha = pixels + begin * width * CHANNEL_COUNT + ALPHA_CHANNEL;
+                    const size_t pixelCount = (end - begin) * width;
+                    for (size_t i = 0; i < pixelCount; ++i, alpha += CHANNEL_COUNT)
+                    {
+                      const float bin = std::clamp(*alpha, 0.0f, 1.0f) * (ALPHA_HISTOGRAM_SIZE - 1);
+                      ++local[static_cast<size_t>(bin)];
+                    }
+
+                    std::lock_guard<std::mutex> lock(histogramMutex);
+                    for (size_t i = 0; i < ALPHA_HISTOGRAM_SIZE; ++i)
+                    {
+                      histogram[i] += local[i];
+                    }
+                  }
+                );
+
+    // 上の段から足していき、閾値(段の下端)ごとの割合を求める
+    const double pixelCount = static_cast<double>(width) * height;
+    uint64_t covered = 0;
+    float bestThreshold = reference;
+    double bestError = 2.0;
+    for (size_t bin = ALPHA_HISTOGRAM_SIZE; bin-- > 1;)
+    {
+      covered += histogram[bin];
+      const double error = std::abs(covered / pixelCount - targetCoverage);
+      if (error < bestError)
+      {
+        bestError = error;
+        bestThreshold = static_cast<float>(bin) / (ALPHA_HISTOGRAM_SIZE - 1);
+      }
+    }
+
+    // 見つけた閾値がreferenceに来るように拡大縮小する
+    return reference / std::max(bestThreshold, MIN_ALPHA_THRESHOLD);
+  }
+}
+
+namespace MFramework
+{
+  bool MipGenerator::IsSupportedFormat(uint32_t format)
+  {
+    switch (format)
+    {
+      case FORMAT_R32G32B32A32_FLOAT:
+      case FORMAT_R16G16B16A16_FLOAT:
+      case FORMAT_R8G8B8A8_UNORM:
+      case FORMAT_R8G8B8A8_UNORM_SRGB:
+      case FORMAT_B8G8R8A8_UNORM:
+      case FORMAT_B8G8R8A8_UNORM_SRGB:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  uint32_t MipGenerator::GetFullMipCount(uint32_t width, uint32_t height)
+  {
+    uint32_t size = std::max(width, height);
+    uint32_t count = 1;
+    while (size > 1)
+    {
+      size >>= 1;
+      ++count;
+    }
+
+    return count;
+  }
+
+  bool MipGenerator::Generate(const TextureData& src, const MipGenerateDesc& desc, TextureData& outData, std::string& outError, ThreadPool* threadPool)
+  {
+    if (&src == &outData)
+    {
+      outError = "source and destination must be different";
+      return false;
+    }
+
+    const TextureDesc& srcDesc = src.Desc;
+    if (srcDesc.Dimension == TEXTURE_DIMENSION_TEXTURE3D)
+    {
+      outError = "volume textures are not supported";
+      return false;
+    }
+
+    if (!IsSupportedFormat(srcDesc.Format))
+    {
+      outError = "unsupported format " + std::to_string(srcDesc.Format);
+      return false;
+    }
+
+    if (srcDesc.Width == 0 || srcDesc.Height == 0 || srcDesc.DepthOrArraySize == 0 || srcDesc.MipLevels == 0)
+    {
+      outError = "invalid texture description";
+      return false;
+    }
+
+    const uint32_t arraySize = srcDesc.DepthOrArraySize;
+    if (src.Subresources.size() < static_cast<size_t>(srcDesc.MipLevels) * arraySize)
+    {
+      outError = "missing subresources";
+      return false;
+    }
+
+    // 既定値を埋める
+    MipGenerateDesc settings = desc;
+    if (settings.AlphaReference <= 0.0f)
+    {
+      settings.AlphaReference = DEFAULT_ALPHA_REFERENCE;
+    }
+    if (settings.KaiserWidth <= 0.0f)
+    {
+      settings.KaiserWidth = DEFAULT_KAISER_WIDTH;
+    }
+    if (settings.KaiserAlpha <= 0.0f)
+    {
+      settings.KaiserAlpha = DEFAULT_KAISER_ALPHA;
+    }
+
+    const uint32_t fullMipCount = GetFullMipCount(srcDesc.Width, srcDesc.Height);
+    const uint32_t mipLevels = (settings.MipLevels == 0) ? fullMipCount : std::min(settings.MipLevels, fullMipCount);
+
+    const PixelType pixelType = getPixelType(srcDesc.Format);
+    const uint32_t bytesPerPixel = getBytesPerPixel(pixelType);
+    const bool isSRGBFormat = (srcDesc.Format == FORMAT_R8G8B8A8_UNORM_SRGB) || (srcDesc.Format == FORMAT_B8G8R8A8_UNORM_SRGB);
+    const SRGBTable* srgb = ((pixelType == PixelType::UNorm8) && (settings.IsSRGB || isSRGBFormat)) ? &getSRGBTable() : nullptr;
+
+    // 出力の配置(行は詰めて並べる)
+    outData.Desc = srcDesc;
+    outData.Desc.MipLevels = mipLevels;
+    outData.Subresources.clear();
+    outData.Subresources.reserve(static_cast<size_t>(mipLevels) * arraySize);
+
+    uint64_t totalBytes = 0;
+    for (uint32_t slice = 0; slice < arraySize; ++slice)
+    {
+      for (uint32_t mip = 0; mip < mipLevels; ++mip)
+      {
+        const uint64_t rowPitch = static_cast<uint64_t>(TextureFootprint::GetMipDimension(srcDesc.Width, mip)) * bytesPerPixel;
+        const uint64_t slicePitch = rowPitch * TextureFootprint::GetMipDimension(srcDesc.Height, mip);
+        outData.Subresources.emplace_back(SubresourceData{ totalBytes, rowPitch, slicePitch });
+        totalBytes += slicePitch;
+      }
+    }
+    outData.Pixels.resize(static_cast<size_t>(totalBytes));
+
+    // 縮小フィルターは全スライスで共通(大きさが変わらない方向は重み1つのフィルターになる)
+    std::vector<FilterKernel> horizontalKernels(mipLevels);
+    std::vector<FilterKernel> verticalKernels(mipLevels);
+    for (uint32_t mip = 1; mip < mipLevels; ++mip)
+    {
+      horizontalKernels[mip] = buildKernel(TextureFootprint::GetMipDimension(srcDesc.Width, mip - 1), TextureFootprint::GetMipDimension(srcDesc.Width, mip), settings);
+      verticalKernels[mip] = buildKernel(TextureFootprint::GetMipDimension(srcDesc.Height, mip - 1), TextureFootprint::GetMipDimension(srcDesc.Height, mip), settings);
+    }
+
+    std::vector<float> current;     // 一つ上のレベル(ミップ1以降、floatに展開済み)
+    std::vector<float> next;
+
+    for (uint32_t slice = 0; slice < arraySize; ++slice)
+    {
+      const SubresourceData& srcSubresource = src.Subresources[static_cast<size_t>(slice) * srcDesc.MipLevels];
+      const uint64_t rowSize = static_cast<uint64_t>(srcDesc.Width) * bytesPerPixel;
+      if (srcSubresource.RowPitch < rowSize ||
+          srcSubresource.Offset + srcSubresource.RowPitch * (srcDesc.Height - 1) + rowSize > src.Pixels.size())
+      {
+        outError = "source pixels out of range";
+        return false;
+      }
+
+      const uint8_t* srcPixels = src.Pixels.data() + srcSubresource.Offset;
+      uint8_t* dstBase = outData.Pixels.data();
+
+      // ミップ0はそのままコピーする
+      const SubresourceData& dstTop = outData.Subresources[static_cast<size_t>(slice) * mipLevels];
+      for (uint32_t y = 0; y < srcDesc.Height; ++y)
+      {
+        std::memcpy(dstBase + dstTop.Offset + dstTop.RowPitch * y, srcPixels + srcSubresource.RowPitch * y, static_cast<size_t>(rowSize));
+      }
+
+      if (mipLevels == 1)
+      {
+        continue;
+      }
+
+      // ミップ0でアルファテストに残る割合
+      float targetCoverage = 0.0f;
+      if (settings.IsPreserveAlphaCoverage)
+      {
+        std::atomic<uint64_t> coveredCount{ 0 };
+        parallelRows(
+                      threadPool, srcDesc.Height, srcDesc.Width,
+                      [&](size_t begin, size_t end)
+                      {
+                        std::vector<float> row(static_cast<size_t>(srcDesc.Width) * CHANNEL_COUNT);
+                        uint64_t count = 0;
+                        for (size_t y = begin; y < end; ++y)
+                        {
+                          loadRow(srcPixels + srcSubresource.RowPitch * y, row.data(), srcDesc.Width, pixelType, srgb);
+                          count += countAlphaAbove(row.data(), srcDesc.Width, settings.AlphaReference);
+                        }
+                        coveredCount.fetch_add(count, std::memory_order_relaxed);
+                      }
+                    );
+        targetCoverage = static_cast<float>(static_cast<double>(coveredCount.load()) / (static_cast<uint64_t>(srcDesc.Width) * srcDesc.Height));
+      }
+      const bool isScaleAlpha = settings.IsPreserveAlphaCoverage && targetCoverage > 0.0f && targetCoverage < 1.0f;
+
+      for (uint32_t mip = 1; mip < mipLevels; ++mip)
+      {
+        const uint32_t srcWidth = TextureFootprint::GetMipDimension(srcDesc.Width, mip - 1);
+        const uint32_t dstWidth = TextureFootprint::GetMipDimension(srcDesc.Width, mip);
+        const uint32_t dstHeight = TextureFootprint::GetMipDimension(srcDesc.Height, mip);
+        const size_t srcRowFloatCount = static_cast<size_t>(srcWidth) * CHANNEL_COUNT;
+        const size_t dstRowFloatCount = static_cast<size_t>(dstWidth) * CHANNEL_COUNT;
+        const FilterKernel& horizontalKernel = horizontalKernels[mip];
+        const FilterKernel& verticalKernel = verticalKernels[mip];
+        const SubresourceData& dstSubresource = outData.Subresources[static_cast<size_t>(slice) * mipLevels + mip];
+
+        // ミップ0は元のフォーマットのまま一行ずつ展開して読む(全体をfloatにしない)
+        const bool isFromSource = (mip == 1);
+
+        next.resize(dstRowFloatCount * dstHeight);
+
+        // 縮小先の行を帯に分け、帯が参照する元の行だけ横方向に縮小してから縦方向に縮小する
+        // 隣の帯と重なる行は前に詰めて使い回す
+        parallelRows(
+                      threadPool, dstHeight, dstWidth,
+                      [&](size_t begin, size_t end)
+                      {
+                        std::vector<float> band;
+                        std::vector<float> sourceRow(isFromSource ? srcRowFloatCount : 0);
+                        size_t bandFirst = 0;
+                        size_t bandRowCount = 0;
+
+                        for (size_t bandBegin = begin; bandBegin < end; bandBegin += BAND_ROW_COUNT)
+                        {
+                          const size_t bandEnd = std::min(bandBegin + BAND_ROW_COUNT, end);
+                          size_t rowFirst = verticalKernel.Taps[bandBegin].First;
+                          size_t rowLast = rowFirst;
+                          for (size_t y = bandBegin; y < bandEnd; ++y)
+                          {
+                            const FilterTap& tap = verticalKernel.Taps[y];
+                            rowFirst = std::min<size_t>(rowFirst, tap.First);
+                            rowLast = std::max<size_t>(rowLast, tap.First + tap.Count - 1);
+                          }
+
+                          const size_t rowCount = rowLast - rowFirst + 1;
+                          band.resize(std::max(band.size(), rowCount * dstRowFloatCount));
+
+                          size_t reusedCount = 0;
+                          if (bandRowCount > 0 && rowFirst >= bandFirst && rowFirst < bandFirst + bandRowCount)
+                          {
+                            reusedCount = std::min(bandFirst + bandRowCount - rowFirst, rowCount);
+                            std::memmove(band.data(), band.data() + (rowFirst - bandFirst) * dstRowFloatCount, reusedCount * dstRowFloatCount * sizeof(float));
+                          }
+
+                          for (size_t row = rowFirst + reusedCount; row <= rowLast; ++row)
+                          {
+                            const float* input = nullptr;
+                            if (isFromSource)
+                            {
+                              loadRow(srcPixels + srcSubresource.RowPitch * row, sourceRow.data(), srcWidth, pixelType, srgb);
+                              input = sourceRow.data();
+                            }
+                            else
+                            {
+                              input = current.data() + row * srcRowFloatCount;
+                            }
+                            filterRowHorizontal(input, band.data() + (row - rowFirst) * dstRowFloatCount, horizontalKernel);
+                          }
+                          bandFirst = rowFirst;
+                          bandRowCount = rowCount;
+
+                          for (size_t y = bandBegin; y < bandEnd; ++y)
+                          {
+                            FilterTap tap = verticalKernel.Taps[y];
+                            const float* weights = verticalKernel.Weights.data() + tap.WeightOffset;
+                            tap.First -= static_cast<uint32_t>(rowFirst);
+
+                            float* output = next.data() + y * dstRowFloatCount;
+                            filterRowVertical(band.data(), dstRowFloatCount, output, tap, weights);
+
+                            // アルファの倍率を求める必要がなければ、キャッシュにあるうちに書き出す
+                            if (!isScaleAlpha)
+                            {
+                              storeRow(output, dstBase + dstSubresource.Offset + dstSubresource.RowPitch * y, dstWidth, pixelType, srgb, 1.0f);
+                            }
+                          }
+                        }
+                      }
+                    );
+
+        if (isScaleAlpha)
+        {
+          // 倍率は書き出すときだけ掛け、次のレベルは倍率を掛ける前の値から作る
+          const float alphaScale = findAlphaScale(next.data(), dstWidth, dstHeight, targetCoverage, settings.AlphaReference, threadPool);
+          parallelRows(
+                        threadPool, dstHeight, dstWidth,
+                        [&](size_t begin, size_t end)
+                        {
+                          for (size_t y = begin; y < end; ++y)
+                          {
+                            storeRow(next.data() + y * dstRowFloatCount, dstBase + dstSubresource.Offset + dstSubresource.RowPitch * y, dstWidth, pixelType, srgb, alphaScale);
+                          }
+                        }
+                      );
+        }
+
+        current.swap(next);
+      }
+    }
+
+    return true;
+  }
+}
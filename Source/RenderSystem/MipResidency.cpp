@@ -0,0 +1,368 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Mip residency policy of texture streaming (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/MipResidency.h>
+#include <RenderSystem/TextureFootprint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  constexpr uint32_t INVALID_ID = 0xffffffff;
+}
+
+namespace MFramework
+{
+  MipResidency::MipResidency()
+    : m_textures()
+    , m_budgetBytes(0)
+    , m_committedBytes(0)
+    , m_evictionCount(0)
+    , m_maxStreamInPerPlan(0)
+  { }
+
+  MipResidency::~MipResidency()
+  {
+    Dispose();
+  }
+
+  bool MipResidency::Init(uint64_t budgetBytes, uint32_t maxStreamInPerPlan)
+  {
+    if (budgetBytes == 0 || maxStreamInPerPlan == 0)
+    {
+      return false;
+    }
+
+    Dispose();
+    m_budgetBytes = budgetBytes;
+    m_maxStreamInPerPlan = maxStreamInPerPlan;
+    return true;
+  }
+
+  void MipResidency::Register(uint32_t id, const TextureDesc& desc, uint32_t tailMip, uint32_t residentMip)
+  {
+    if (desc.MipLevels == 0)
+    {
+      return;
+    }
+
+    if (id >= m_textures.size())
+    {
+      m_textures.resize(static_cast<size_t>(id) + 1);
+    }
+
+    Unregister(id);
+
+    TextureState& state = m_textures[id];
+    state.IsRegistered = true;
+    state.TailMip = std::min(tailMip, desc.MipLevels - 1);
+    state.ResidentMip = std::min(residentMip, state.TailMip);
+    state.PendingMip = state.ResidentMip;
+    state.WantedMip = state.ResidentMip;
+    state.LastUsedFrame = 0;
+
+    state.ChainSizes.assign(desc.MipLevels, 0);
+    std::vector<SubresourceFootprint> footprints;
+    for (uint32_t mip = 0; mip < desc.MipLevels; ++mip)
+    {
+      TextureFootprint::Compute(TextureFootprint::GetMipDesc(desc, mip), footprints, &state.ChainSizes[mip]);
+    }
+
+    m_committedBytes += state.ChainSizes[state.ResidentMip];
+  }
+
+  void MipResidency::Unregister(uint32_t id)
+  {
+    if (id >= m_textures.size() || !m_textures[id].IsRegistered)
+    {
+      return;
+    }
+
+    TextureState& state = m_textures[id];
+    m_committedBytes -= state.ChainSizes[state.PendingMip];
+    state = TextureState{};
+  }
+
+  void MipResidency::Request(uint32_t id, uint32_t wantedMip, uint64_t frameIndex)
+  {
+    if (id >= m_textures.size() || !m_textures[id].IsRegistered)
+    {
+      return;
+    }
+
+    TextureState& state = m_textures[id];
+    // テールより粗いミップは常駐しているので、テールで止める
+    state.WantedMip = std::min(wantedMip, state.TailMip);
+    state.LastUsedFrame = std::max(state.LastUsedFrame, frameIndex);
+  }
+
+  void MipResidency::SetResidentMip(uint32_t id, uint32_t residentMip)
+  {
+    if (id >= m_textures.size() || !m_textures[id].IsRegistered)
+    {
+      return;
+    }
+
+    TextureState& state = m_textures[id];
+    const uint32_t mip = std::min(residentMip, state.TailMip);
+    m_committedBytes -= state.ChainSizes[state.PendingMip];
+    m_committedBytes += state.ChainSizes[mip];
+    state.ResidentMip = mip;
+    state.PendingMip = mip;
+  }
+
+  void MipResidency::CancelPending(uint32_t id)
+  {
+    if (id >= m_textures.size() || !m_textures[id].IsRegistered)
+    {
+      return;
+    }
+
+    SetResidentMip(id, m_textures[id].ResidentMip);
+  }
+
+  void MipResidency::Plan(std::vector<MipResidencyAction>& outActions)
+  {
+    outActions.clear();
+
+    // 使われていない順、ただし必要以上に細かいミップを持つものを最優先に追い出す
+    const auto pickVictim = [this](uint32_t excludeID, uint64_t usedBefore) -> uint32_t
+                            {
+                              uint32_t victim = INVALID_ID;
+                              for (uint32_t id = 0; id < m_textures.size(); ++id)
+                              {
+                                const TextureState& state = m_textures[id];
+                                if (id == excludeID || !isEvictable(state))
+                                {
+                                  continue;
+                                }
+
+                                const bool isOverResident = state.ResidentMip < state.WantedMip;
+                                if (!isOverResident && state.LastUsedFrame >= usedBefore)
+                                {
+                                  continue;
+                                }
+
+                                if (victim == INVALID_ID)
+                                {
+                                  victim = id;
+                                  continue;
+                                }
+
+                                const TextureState& current = m_textures[victim];
+                                const bool isCurrentOverResident = current.ResidentMip < current.WantedMip;
+                                if (isOverResident != isCurrentOverResident)
+                                {
+                                  if (isOverResident)
+                                  {
+                                    victim = id;
+                                  }
+                                  continue;
+                                }
+
+                                if (state.LastUsedFrame < current.LastUsedFrame)
+                                {
+                                  victim = id;
+                                }
+                              }
+                              return victim;
+                            };
+
+    // 予算が減った場合などはまず予算内に戻す
+    while (m_committedBytes > m_budgetBytes)
+    {
+      const uint32_t victim = pickVictim(INVALID_ID, std::numeric_limits<uint64_t>::max());
+      if (victim == INVALID_ID)
+      {
+        break;
+      }
+      evictOneLevel(victim, outActions);
+    }
+
+    // 細かいミップが必要なテクスチャ(最近使われた順、足りないミップが多い順)
+    std::vector<uint32_t> candidates;
+    for (uint32_t id = 0; id < m_textures.size(); ++id)
+    {
+      const TextureState& state = m_textures[id];
+      if (state.IsRegistered && state.PendingMip == state.ResidentMip && state.WantedMip < state.ResidentMip)
+      {
+        candidates.emplace_back(id);
+      }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [this](uint32_t lhs, uint32_t rhs)
+              {
+                const TextureState& l = m_textures[lhs];
+                const TextureState& r = m_textures[rhs];
+                if (l.LastUsedFrame != r.LastUsedFrame)
+                {
+                  return l.LastUsedFrame > r.LastUsedFrame;
+                }
+
+                const uint32_t lDeficit = l.ResidentMip - l.WantedMip;
+                const uint32_t rDeficit = r.ResidentMip - r.WantedMip;
+                if (lDeficit != rDeficit)
+                {
+                  return lDeficit > rDeficit;
+                }
+
+                return lhs < rhs;
+              });
+
+    uint32_t streamInCount = 0;
+    for (const uint32_t id : candidates)
+    {
+      if (streamInCount >= m_maxStreamInPerPlan)
+      {
+        break;
+      }
+
+      TextureState& state = m_textures[id];
+      // 追い出しで候補の状態が変わっていることがある
+      if (state.PendingMip != state.ResidentMip)
+      {
+        continue;
+      }
+
+      // 一段ずつ細かくする
+      const uint32_t target = state.ResidentMip - 1;
+      const uint64_t cost = state.ChainSizes[target] - state.ChainSizes[state.ResidentMip];
+
+      // 自分より後に使われたテクスチャは追い出さない(同じフレームで見えているもの同士で取り合わない)
+      while (m_committedBytes + cost > m_budgetBytes)
+      {
+        const uint32_t victim = pickVictim(id, state.LastUsedFrame);
+        if (victim == INVALID_ID)
+        {
+          break;
+        }
+        evictOneLevel(victim, outActions);
+      }
+
+      if (m_committedBytes + cost > m_budgetBytes)
+      {
+        continue;
+      }
+
+      state.PendingMip = target;
+      m_committedBytes += cost;
+      outActions.emplace_back(MipResidencyAction{ id, target });
+      ++streamInCount;
+    }
+  }
+
+  uint32_t MipResidency::GetResidentMip(uint32_t id) const
+  {
+    return (id < m_textures.size() && m_textures[id].IsRegistered) ? m_textures[id].ResidentMip : 0;
+  }
+
+  uint32_t MipResidency::GetWantedMip(uint32_t id) const
+  {
+    return (id < m_textures.size() && m_textures[id].IsRegistered) ? m_textures[id].WantedMip : 0;
+  }
+
+  bool MipResidency::IsPending(uint32_t id) const
+  {
+    return id < m_textures.size() && m_textures[id].IsRegistered && m_textures[id].PendingMip != m_textures[id].ResidentMip;
+  }
+
+  uint64_t MipResidency::GetMipChainSize(uint32_t id, uint32_t firstMip) const
+  {
+    if (id >= m_textures.size() || !m_textures[id].IsRegistered || firstMip >= m_textures[id].ChainSizes.size())
+    {
+      return 0;
+    }
+
+    return m_textures[id].ChainSizes[firstMip];
+  }
+
+  uint32_t MipResidency::ComputeWantedMip(const TextureDesc& desc, float screenSize)
+  {
+    if (desc.MipLevels == 0)
+    {
+      return 0;
+    }
+
+    const uint32_t lastMip = desc.MipLevels - 1;
+    if (!(screenSize > 0.0f))
+    {
+      return lastMip;
+    }
+
+    // 1テクセルが1ピクセル以上になる最も粗いミップ
+    const float textureSize = static_cast<float>(std::max(desc.Width, desc.Height));
+    const float ratio = textureSize / screenSize;
+    if (ratio <= 1.0f)
+    {
+      return 0;
+    }
+
+    const uint32_t mip = static_cast<uint32_t>(std::floor(std::log2(ratio)));
+    return std::min(mip, lastMip);
+  }
+
+  uint32_t MipResidency::ComputeTailMip(const TextureDesc& desc, uint32_t tailSize)
+  {
+    for (uint32_t mip = 0; mip < desc.MipLevels; ++mip)
+    {
+      const uint32_t size = std::max(TextureFootprint::GetMipDimension(desc.Width, mip), TextureFootprint::GetMipDimension(desc.Height, mip));
+      if (size <= tailSize)
+      {
+        return mip;
+      }
+    }
+
+    return (desc.MipLevels > 0) ? desc.MipLevels - 1 : 0;
+  }
+
+  float MipResidency::EstimateScreenSize(float worldSize, float distance, float verticalFov, float viewportHeight)
+  {
+    const float halfHeight = distance * std::tan(verticalFov * 0.5f);
+    if (!(halfHeight > 0.0f))
+    {
+      // カメラの位置か後ろにある場合は最も細かいミップを要求する
+      return std::numeric_limits<float>::max();
+    }
+
+    return worldSize / (2.0f * halfHeight) * viewportHeight;
+  }
+
+  bool MipResidency::isEvictable(const TextureState& state) const
+  {
+    return state.IsRegistered && state.PendingMip == state.ResidentMip && state.ResidentMip < state.TailMip;
+  }
+
+  void MipResidency::evictOneLevel(uint32_t id, std::vector<MipResidencyAction>& outActions)
+  {
+    TextureState& state = m_textures[id];
+    const uint32_t target = state.ResidentMip + 1;
+    m_committedBytes -= state.ChainSizes[state.ResidentMip] - state.ChainSizes[target];
+    state.PendingMip = target;
+    ++m_evictionCount;
+    outActions.emplace_back(MipResidencyAction{ id, target });
+  }
+
+  void MipResidency::Dispose() noexcept
+  {
+    m_textures.clear();
+    m_budgetBytes = 0;
+    m_committedBytes = 0;
+    m_evictionCount = 0;
+    m_maxStreamInPerPlan = 0;
+  }
+}
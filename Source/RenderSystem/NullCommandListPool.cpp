@@ -0,0 +1,136 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null command list pool for parallel recording (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Share retire and reuse logic through FencedPool
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/NullCommandListPool.h>
+
+#include <cassert>
+#include <memory>
+
+namespace
+{
+  // 命令の種類
+  constexpr uint32_t COMMAND_SET_ROOT_SIGNATURE = 0;
+  constexpr uint32_t COMMAND_SET_PIPELINE_STATE = 1;
+  constexpr uint32_t COMMAND_SET_MATERIAL = 2;
+  constexpr uint32_t COMMAND_SET_MESH = 3;
+  constexpr uint32_t COMMAND_DRAW = 4;
+}
+
+namespace MFramework
+{
+  NullCommandList::NullCommandList()
+    : m_commands()
+    , m_drawCount(0)
+    , m_isClosed(false)
+  { }
+
+  NullCommandList::~NullCommandList()
+  { }
+
+  void NullCommandList::Reset()
+  {
+    m_commands.clear();
+    m_drawCount = 0;
+    m_isClosed = false;
+  }
+
+  void NullCommandList::Close()
+  {
+    m_isClosed = true;
+  }
+
+  void NullCommandList::SetRootSignature(uint32_t rootSignature)
+  {
+    write(COMMAND_SET_ROOT_SIGNATURE, rootSignature);
+  }
+
+  void NullCommandList::SetPipelineState(uint32_t pipelineState)
+  {
+    write(COMMAND_SET_PIPELINE_STATE, pipelineState);
+  }
+
+  void NullCommandList::SetMaterial(uint32_t material)
+  {
+    write(COMMAND_SET_MATERIAL, material);
+  }
+
+  void NullCommandList::SetMesh(uint32_t mesh)
+  {
+    write(COMMAND_SET_MESH, mesh);
+  }
+
+  void NullCommandList::Draw(uint32_t instanceCount, uint64_t instanceDataOffset)
+  {
+    write(COMMAND_DRAW, instanceCount, static_cast<uint32_t>(instanceDataOffset), static_cast<uint32_t>(instanceDataOffset >> 32));
+    ++m_drawCount;
+  }
+
+  void NullCommandList::write(uint32_t type, uint32_t argument0, uint32_t argument1, uint32_t argument2)
+  {
+    assert(!m_isClosed && "NullCommandList : recording into a closed list");
+
+    m_commands.emplace_back(Command{ type, { argument0, argument1, argument2 } });
+  }
+
+  NullCommandListPool::NullCommandListPool()
+    : m_lists()
+  { }
+
+  NullCommandListPool::~NullCommandListPool()
+  {
+    Dispose();
+  }
+
+  void NullCommandListPool::BeginFrame(uint64_t completedFenceValue)
+  {
+    m_lists.BeginFrame(completedFenceValue);
+  }
+
+  NullCommandList* NullCommandListPool::Acquire()
+  {
+    NullCommandList* list = m_lists.Acquire(
+                                              []()
+                                              {
+                                                return std::make_unique<NullCommandList>();
+                                              }
+                                            );
+
+    // Resetはロックの外で行う(このリストは呼び出したスレッドだけが使う)
+    list->Reset();
+
+    return list;
+  }
+
+  void NullCommandListPool::EndFrame(uint64_t signaledFenceValue)
+  {
+    m_lists.EndFrame(signaledFenceValue);
+  }
+
+  size_t NullCommandListPool::GetCreatedCount() const
+  {
+    return m_lists.GetCreatedCount();
+  }
+
+  size_t NullCommandListPool::GetAvailableCount() const
+  {
+    return m_lists.GetAvailableCount();
+  }
+
+  void NullCommandListPool::Dispose() noexcept
+  {
+    m_lists.Dispose();
+  }
+}
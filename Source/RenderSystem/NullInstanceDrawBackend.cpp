@@ -0,0 +1,124 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null instanced draw backend (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Draw packet backend
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/NullInstanceDrawBackend.h>
+
+namespace MFramework
+{
+  NullInstanceDrawBackend::NullInstanceDrawBackend()
+    : m_instanceMemory()
+    , m_drawCount(0)
+    , m_instanceCount(0)
+    , m_meshChangeCount(0)
+    , m_materialChangeCount(0)
+    , m_rootSignatureChangeCount(0)
+    , m_pipelineStateChangeCount(0)
+    , m_currentMesh(0)
+    , m_currentMaterial(0)
+    , m_hasCurrent(false)
+  { }
+
+  NullInstanceDrawBackend::~NullInstanceDrawBackend()
+  {
+    Dispose();
+  }
+
+  bool NullInstanceDrawBackend::Init(uint64_t instanceCapacity)
+  {
+    if (instanceCapacity == 0)
+    {
+      return false;
+    }
+
+    Dispose();
+    m_instanceMemory.resize(static_cast<size_t>(instanceCapacity));
+    return true;
+  }
+
+  void NullInstanceDrawBackend::ResetCounters()
+  {
+    m_drawCount = 0;
+    m_instanceCount = 0;
+    m_meshChangeCount = 0;
+    m_materialChangeCount = 0;
+    m_rootSignatureChangeCount = 0;
+    m_pipelineStateChangeCount = 0;
+    m_hasCurrent = false;
+  }
+
+  uint8_t* NullInstanceDrawBackend::GetInstanceMemory() const
+  {
+    return m_instanceMemory.empty() ? nullptr : const_cast<uint8_t*>(m_instanceMemory.data());
+  }
+
+  uint64_t NullInstanceDrawBackend::GetInstanceCapacity() const
+  {
+    return m_instanceMemory.size();
+  }
+
+  void NullInstanceDrawBackend::DrawInstanced(const InstanceDrawCommand& command)
+  {
+    // DX12のバックエンドと同じく、変わったものだけ設定し直したとして数える
+    if (!m_hasCurrent || command.Mesh != m_currentMesh)
+    {
+      ++m_meshChangeCount;
+    }
+    if (!m_hasCurrent || command.Material != m_currentMaterial)
+    {
+      ++m_materialChangeCount;
+    }
+
+    m_currentMesh = command.Mesh;
+    m_currentMaterial = command.Material;
+    m_hasCurrent = true;
+
+    ++m_drawCount;
+    m_instanceCount += command.InstanceCount;
+  }
+
+  void NullInstanceDrawBackend::SetRootSignature(uint32_t)
+  {
+    ++m_rootSignatureChangeCount;
+  }
+
+  void NullInstanceDrawBackend::SetPipelineState(uint32_t)
+  {
+    ++m_pipelineStateChangeCount;
+  }
+
+  void NullInstanceDrawBackend::SetMaterial(uint32_t)
+  {
+    ++m_materialChangeCount;
+  }
+
+  void NullInstanceDrawBackend::SetMesh(uint32_t)
+  {
+    ++m_meshChangeCount;
+  }
+
+  void NullInstanceDrawBackend::Draw(uint32_t instanceCount, uint64_t)
+  {
+    ++m_drawCount;
+    m_instanceCount += instanceCount;
+  }
+
+  void NullInstanceDrawBackend::Dispose() noexcept
+  {
+    m_instanceMemory.clear();
+    m_instanceMemory.shrink_to_fit();
+    ResetCounters();
+  }
+}
@@ -0,0 +1,187 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Null texture upload backend (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add texture to texture copy
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/NullTextureUploadBackend.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace MFramework
+{
+  NullTextureUploadBackend::NullTextureUploadBackend()
+    : m_staging()
+    , m_textures()
+    , m_pendingCopies()
+    , m_nextTextureID(1)
+    , m_submittedValue(0)
+    , m_completedValue(0)
+    , m_copyCount(0)
+    , m_isAutoComplete(true)
+  { }
+
+  NullTextureUploadBackend::~NullTextureUploadBackend()
+  {
+    Dispose();
+  }
+
+  bool NullTextureUploadBackend::Init(uint64_t stagingCapacity)
+  {
+    if (stagingCapacity == 0)
+    {
+      return false;
+    }
+
+    Dispose();
+    m_staging.resize(static_cast<size_t>(stagingCapacity));
+    return true;
+  }
+
+  void NullTextureUploadBackend::SetAutoComplete(bool isAutoComplete)
+  {
+    m_isAutoComplete = isAutoComplete;
+  }
+
+  void NullTextureUploadBackend::CompleteFenceValue(uint64_t fenceValue)
+  {
+    m_completedValue = std::max(m_completedValue, std::min(fenceValue, m_submittedValue));
+  }
+
+  const std::vector<uint8_t>* NullTextureUploadBackend::GetTextureData(uint64_t texture) const
+  {
+    const auto it = m_textures.find(texture);
+    return (it != m_textures.end()) ? &it->second.Data : nullptr;
+  }
+
+  const TextureDesc* NullTextureUploadBackend::GetTextureDesc(uint64_t texture) const
+  {
+    const auto it = m_textures.find(texture);
+    return (it != m_textures.end()) ? &it->second.Desc : nullptr;
+  }
+
+  uint8_t* NullTextureUploadBackend::GetStagingMemory() const
+  {
+    return m_staging.empty() ? nullptr : const_cast<uint8_t*>(m_staging.data());
+  }
+
+  uint64_t NullTextureUploadBackend::GetStagingCapacity() const
+  {
+    return m_staging.size();
+  }
+
+  uint64_t NullTextureUploadBackend::CreateTexture(const TextureDesc& desc)
+  {
+    NullTexture texture{};
+    texture.Desc = desc;
+
+    uint64_t totalBytes = 0;
+    if (!TextureFootprint::Compute(desc, texture.Footprints, &totalBytes))
+    {
+      return 0;
+    }
+    texture.Data.resize(static_cast<size_t>(totalBytes));
+
+    const uint64_t id = m_nextTextureID++;
+    m_textures.emplace(id, std::move(texture));
+    return id;
+  }
+
+  void NullTextureUploadBackend::DestroyTexture(uint64_t texture)
+  {
+    m_textures.erase(texture);
+  }
+
+  void NullTextureUploadBackend::CopyToTexture(uint64_t texture, uint32_t subresource, const SubresourceFootprint& footprint)
+  {
+    m_pendingCopies.emplace_back(PendingCopy{ texture, subresource, footprint, 0, 0 });
+  }
+
+  void NullTextureUploadBackend::CopyTextureSubresource(uint64_t dstTexture, uint32_t dstSubresource, uint64_t srcTexture, uint32_t srcSubresource)
+  {
+    m_pendingCopies.emplace_back(PendingCopy{ dstTexture, dstSubresource, SubresourceFootprint{}, srcTexture, srcSubresource });
+  }
+
+  uint64_t NullTextureUploadBackend::Submit()
+  {
+    // GPUのコピーの代わりに、サブミット時点のステージングやテクスチャの内容を記録順に写す
+    for (const PendingCopy& copy : m_pendingCopies)
+    {
+      const auto it = m_textures.find(copy.Texture);
+      if (it == m_textures.end() || copy.Subresource >= it->second.Footprints.size())
+      {
+        continue;
+      }
+
+      if (copy.SrcTexture == 0)
+      {
+        copyRows(it->second, copy.Subresource, m_staging.data(), copy.Footprint);
+        ++m_copyCount;
+        continue;
+      }
+
+      const auto srcIt = m_textures.find(copy.SrcTexture);
+      if (srcIt == m_textures.end() || copy.SrcSubresource >= srcIt->second.Footprints.size())
+      {
+        continue;
+      }
+
+      copyRows(it->second, copy.Subresource, srcIt->second.Data.data(), srcIt->second.Footprints[copy.SrcSubresource]);
+      ++m_copyCount;
+    }
+    m_pendingCopies.clear();
+
+    ++m_submittedValue;
+    if (m_isAutoComplete)
+    {
+      m_completedValue = m_submittedValue;
+    }
+
+    return m_submittedValue;
+  }
+
+  uint64_t NullTextureUploadBackend::GetCompletedFenceValue() const
+  {
+    return m_completedValue;
+  }
+
+  uint64_t NullTextureUploadBackend::GetSubmittedFenceValue() const
+  {
+    return m_submittedValue;
+  }
+
+  void NullTextureUploadBackend::copyRows(NullTexture& dst, uint32_t dstSubresource, const uint8_t* src, const SubresourceFootprint& srcFootprint)
+  {
+    const SubresourceFootprint& dstFootprint = dst.Footprints[dstSubresource];
+    const uint64_t rowCount = static_cast<uint64_t>(std::min(srcFootprint.NumRows, dstFootprint.NumRows)) * std::min(srcFootprint.Depth, dstFootprint.Depth);
+    const size_t rowSize = static_cast<size_t>(std::min(srcFootprint.RowSizeInBytes, dstFootprint.RowSizeInBytes));
+    for (uint64_t row = 0; row < rowCount; ++row)
+    {
+      std::memcpy(dst.Data.data() + dstFootprint.Offset + row * dstFootprint.RowPitch, src + srcFootprint.Offset + row * srcFootprint.RowPitch, rowSize);
+    }
+  }
+
+  void NullTextureUploadBackend::Dispose() noexcept
+  {
+    m_staging.clear();
+    m_staging.shrink_to_fit();
+    m_textures.clear();
+    m_pendingCopies.clear();
+    m_nextTextureID = 1;
+    m_submittedValue = 0;
+    m_completedValue = 0;
+    m_copyCount = 0;
+    m_isAutoComplete = true;
+  }
+}
@@ -0,0 +1,350 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Wavefront OBJ mesh importer (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/ObjMeshImporter.h>
+
+#include <MappedFile.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace
+{
+  struct Float3
+  {
+    float X, Y, Z;
+  };
+
+  struct Float2
+  {
+    float X, Y;
+  };
+
+  /// @brief
+  /// 面の頂点一つ分の番号(0始まり、無ければ-1)
+  struct FaceCorner
+  {
+    int64_t Position;
+    int64_t TexCoord;
+    int64_t Normal;
+  };
+
+  bool isSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r';
+  }
+
+  std::string_view trim(std::string_view text)
+  {
+    while (!text.empty() && isSpace(text.front()))
+    {
+      text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back()))
+    {
+      text.remove_suffix(1);
+    }
+    return text;
+  }
+
+  std::string_view nextToken(std::string_view& text)
+  {
+    text = trim(text);
+    size_t length = 0;
+    while (length < text.size() && !isSpace(text[length]))
+    {
+      ++length;
+    }
+
+    const std::string_view token = text.substr(0, length);
+    text.remove_prefix(length);
+    return token;
+  }
+
+  /// @brief
+  /// トークンを数値にする(strtofは終端文字が必要なので短いバッファーへコピーする)
+  bool parseFloat(std::string_view token, float& outValue)
+  {
+    char buffer[64];
+    if (token.empty() || token.size() >= sizeof(buffer))
+    {
+      return false;
+    }
+
+    std::memcpy(buffer, token.data(), token.size());
+    buffer[token.size()] = '\0';
+
+    char* end = nullptr;
+    outValue = std::strtof(buffer, &end);
+    return end == buffer + token.size();
+  }
+
+  bool parseFloats(std::string_view& text, float* outValues, size_t count, size_t requiredCount)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      const std::string_view token = nextToken(text);
+      if (token.empty())
+      {
+        return i >= requiredCount;
+      }
+      if (!parseFloat(token, outValues[i]))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief
+  /// 1始まりまたは負(末尾からの相対)の番号を0始まりにする
+  bool resolveIndex(std::string_view token, size_t elementCount, int64_t& outIndex)
+  {
+    if (token.empty())
+    {
+      outIndex = -1;
+      return true;
+    }
+
+    int64_t value = 0;
+    bool isNegative = false;
+    size_t position = 0;
+    if (token[0] == '-')
+    {
+      isNegative = true;
+      position = 1;
+    }
+    if (position == token.size())
+    {
+      return false;
+    }
+    for (; position < token.size(); ++position)
+    {
+      const char c = token[position];
+      if (c < '0' || c > '9' || value > (1LL << 40))
+      {
+        return false;
+      }
+      value = value * 10 + (c - '0');
+    }
+
+    outIndex = isNegative ? static_cast<int64_t>(elementCount) - value : value - 1;
+    return value != 0 && outIndex >= 0 && outIndex < static_cast<int64_t>(elementCount);
+  }
+
+  bool parseCorner(std::string_view token, size_t positionCount, size_t texCoordCount, size_t normalCount, FaceCorner& outCorner)
+  {
+    // v / v/vt / v//vn / v/vt/vn
+    const size_t firstSlash = token.find('/');
+    const std::string_view positionToken = token.substr(0, firstSlash);
+    std::string_view texCoordToken;
+    std::string_view normalToken;
+    if (firstSlash != std::string_view::npos)
+    {
+      const std::string_view rest = token.substr(firstSlash + 1);
+      const size_t secondSlash = rest.find('/');
+      texCoordToken = rest.substr(0, secondSlash);
+      if (secondSlash != std::string_view::npos)
+      {
+        normalToken = rest.substr(secondSlash + 1);
+      }
+    }
+
+    return !positionToken.empty() &&
+           resolveIndex(positionToken, positionCount, outCorner.Position) &&
+           resolveIndex(texCoordToken, texCoordCount, outCorner.TexCoord) &&
+           resolveIndex(normalToken, normalCount, outCorner.Normal);
+  }
+
+  MFramework::MeshVertex makeVertex(const FaceCorner& corner, const std::vector<Float3>& positions, const std::vector<Float2>& texCoords, const std::vector<Float3>& normals)
+  {
+    MFramework::MeshVertex vertex{};
+
+    const Float3& position = positions[static_cast<size_t>(corner.Position)];
+    vertex.Position[0] = position.X;
+    vertex.Position[1] = position.Y;
+    vertex.Position[2] = -position.Z;
+
+    if (corner.Normal >= 0)
+    {
+      const Float3& normal = normals[static_cast<size_t>(corner.Normal)];
+      vertex.Normal[0] = normal.X;
+      vertex.Normal[1] = normal.Y;
+      vertex.Normal[2] = -normal.Z;
+    }
+
+    if (corner.TexCoord >= 0)
+    {
+      const Float2& texCoord = texCoords[static_cast<size_t>(corner.TexCoord)];
+      vertex.TexCoord[0] = texCoord.X;
+      vertex.TexCoord[1] = 1.0f - texCoord.Y;
+    }
+
+    return vertex;
+  }
+}
+
+namespace MFramework
+{
+  bool ObjMeshImporter::Import(const std::string& path, std::vector<MeshData>& outMeshes, std::string& outError) const
+  {
+    MappedFile file;
+    if (!file.Open(path))
+    {
+      outError = "cannot open " + path;
+      return false;
+    }
+
+    return ImportMemory(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), outMeshes, outError);
+  }
+
+  bool ObjMeshImporter::ImportMemory(const char* text, size_t size, std::vector<MeshData>& outMeshes, std::string& outError)
+  {
+    std::vector<Float3> positions;
+    std::vector<Float2> texCoords;
+    std::vector<Float3> normals;
+    std::vector<FaceCorner> corners;
+
+    outMeshes.clear();
+
+    // 次の面で新しいメッシュを作る(面の無いグループは残さない)
+    std::string objectName = "default";
+    std::string materialName;
+    MeshData* mesh = nullptr;
+
+    const std::string_view source(text, size);
+    size_t lineNumber = 0;
+    size_t lineStart = 0;
+    while (lineStart < source.size())
+    {
+      size_t lineEnd = source.find('\n', lineStart);
+      if (lineEnd == std::string_view::npos)
+      {
+        lineEnd = source.size();
+      }
+
+      std::string_view line = source.substr(lineStart, lineEnd - lineStart);
+      lineStart = lineEnd + 1;
+      ++lineNumber;
+
+      const size_t commentPosition = line.find('#');
+      if (commentPosition != std::string_view::npos)
+      {
+        line = line.substr(0, commentPosition);
+      }
+
+      const std::string_view keyword = nextToken(line);
+      if (keyword.empty())
+      {
+        continue;
+      }
+
+      bool isValid = true;
+      if (keyword == "v")
+      {
+        Float3 position{};
+        isValid = parseFloats(line, &position.X, 3, 3);
+        positions.emplace_back(position);
+      }
+      else if (keyword == "vt")
+      {
+        // 3つ目(w)は使わない
+        float values[3] = {};
+        isValid = parseFloats(line, values, 3, 1);
+        texCoords.emplace_back(Float2{ values[0], values[1] });
+      }
+      else if (keyword == "vn")
+      {
+        Float3 normal{};
+        isValid = parseFloats(line, &normal.X, 3, 3);
+        normals.emplace_back(normal);
+      }
+      else if (keyword == "f")
+      {
+        corners.clear();
+        for (std::string_view token = nextToken(line); !token.empty(); token = nextToken(line))
+        {
+          FaceCorner corner{};
+          if (!parseCorner(token, positions.size(), texCoords.size(), normals.size(), corner))
+          {
+            isValid = false;
+            break;
+          }
+          corners.emplace_back(corner);
+        }
+
+        if (isValid && corners.size() < 3)
+        {
+          isValid = false;
+        }
+
+        if (isValid)
+        {
+          if (mesh == nullptr)
+          {
+            outMeshes.emplace_back();
+            mesh = &outMeshes.back();
+            mesh->Name = objectName;
+            mesh->MaterialName = materialName;
+            mesh->HasNormals = true;
+          }
+
+          const uint32_t baseVertex = static_cast<uint32_t>(mesh->Vertices.size());
+          for (const FaceCorner& corner : corners)
+          {
+            mesh->Vertices.emplace_back(makeVertex(corner, positions, texCoords, normals));
+            mesh->HasNormals = mesh->HasNormals && (corner.Normal >= 0);
+          }
+
+          // 扇状に分割し、巻き順を反転する
+          for (uint32_t i = 1; i + 1 < corners.size(); ++i)
+          {
+            mesh->Indices.emplace_back(baseVertex);
+            mesh->Indices.emplace_back(baseVertex + i + 1);
+            mesh->Indices.emplace_back(baseVertex + i);
+          }
+        }
+      }
+      else if (keyword == "o" || keyword == "g")
+      {
+        const std::string_view name = trim(line);
+        objectName = name.empty() ? std::string("default") : std::string(name);
+        mesh = nullptr;
+      }
+      else if (keyword == "usemtl")
+      {
+        materialName = std::string(trim(line));
+        mesh = nullptr;
+      }
+
+      // mtllib、s、lなどは使わない
+      if (!isValid)
+      {
+        outError = "invalid line " + std::to_string(lineNumber) + " : " + std::string(keyword);
+        outMeshes.clear();
+        return false;
+      }
+    }
+
+    if (outMeshes.empty())
+    {
+      outError = "no faces";
+      return false;
+    }
+
+    return true;
+  }
+}
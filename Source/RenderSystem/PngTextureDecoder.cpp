@@ -0,0 +1,548 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : PNG texture decoder (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/PngTextureDecoder.h>
+#include <HashUtil.h>
+#include <InflateUtil.h>
+#include <MappedFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  constexpr uint8_t PNG_SIGNATURE[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+  constexpr uint32_t FORMAT_R8G8B8A8_UNORM = 28;      // DXGI_FORMAT_R8G8B8A8_UNORM
+  constexpr uint32_t MAX_DIMENSION = 16384;           // D3D12_REQ_TEXTURE2D_U_OR_V_DIMENSION
+  constexpr uint32_t OUTPUT_CHANNEL_COUNT = 4;
+
+  constexpr uint8_t COLOR_TYPE_GRAY = 0;
+  constexpr uint8_t COLOR_TYPE_RGB = 2;
+  constexpr uint8_t COLOR_TYPE_PALETTE = 3;
+  constexpr uint8_t COLOR_TYPE_GRAY_ALPHA = 4;
+  constexpr uint8_t COLOR_TYPE_RGBA = 6;
+
+  struct PngHeader
+  {
+    uint32_t Width;
+    uint32_t Height;
+    uint8_t BitDepth;
+    uint8_t ColorType;
+    uint8_t Interlace;
+  };
+
+  /// @brief
+  /// Adam7の各パスの開始位置と間隔
+  struct InterlacePass
+  {
+    uint32_t XStart;
+    uint32_t YStart;
+    uint32_t XStep;
+    uint32_t YStep;
+  };
+
+  constexpr InterlacePass ADAM7_PASSES[7] =
+  {
+    { 0, 0, 8, 8 },
+    { 4, 0, 8, 8 },
+    { 0, 4, 4, 8 },
+    { 2, 0, 4, 4 },
+    { 0, 2, 2, 4 },
+    { 1, 0, 2, 2 },
+    { 0, 1, 1, 2 },
+  };
+
+  /// @brief
+  /// 透過情報(tRNS)とパレット
+  struct PngColorInfo
+  {
+    uint8_t Palette[256][4];
+    uint32_t PaletteSize;
+    bool HasColorKey;
+    uint16_t ColorKey[3];     // グレースケールは[0]のみ(元のビット深度の値)
+  };
+
+  uint32_t readBigEndian32(const uint8_t* data)
+  {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+           (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+  }
+
+  uint32_t getChannelCount(uint8_t colorType)
+  {
+    switch (colorType)
+    {
+      case COLOR_TYPE_GRAY:
+      case COLOR_TYPE_PALETTE:
+        return 1;
+      case COLOR_TYPE_GRAY_ALPHA:
+        return 2;
+      case COLOR_TYPE_RGB:
+        return 3;
+      case COLOR_TYPE_RGBA:
+        return 4;
+      default:
+        return 0;
+    }
+  }
+
+  bool isValidBitDepth(uint8_t colorType, uint8_t bitDepth)
+  {
+    switch (colorType)
+    {
+      case COLOR_TYPE_GRAY:
+        return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+      case COLOR_TYPE_PALETTE:
+        return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+      case COLOR_TYPE_RGB:
+      case COLOR_TYPE_GRAY_ALPHA:
+      case COLOR_TYPE_RGBA:
+        return bitDepth == 8 || bitDepth == 16;
+      default:
+        return false;
+    }
+  }
+
+  uint64_t getRowBytes(const PngHeader& header, uint32_t width)
+  {
+    const uint64_t bitsPerPixel = static_cast<uint64_t>(getChannelCount(header.ColorType)) * header.BitDepth;
+    return (bitsPerPixel * width + 7) / 8;
+  }
+
+  uint32_t getPassSize(uint32_t size, uint32_t start, uint32_t step)
+  {
+    return (size > start) ? (size - start + step - 1) / step : 0;
+  }
+
+  uint8_t paeth(uint8_t left, uint8_t up, uint8_t upLeft)
+  {
+    const int32_t estimate = static_cast<int32_t>(left) + up - upLeft;
+    const int32_t distanceLeft = std::abs(estimate - left);
+    const int32_t distanceUp = std::abs(estimate - up);
+    const int32_t distanceUpLeft = std::abs(estimate - upLeft);
+
+    if (distanceLeft <= distanceUp && distanceLeft <= distanceUpLeft)
+    {
+      return left;
+    }
+
+    return (distanceUp <= distanceUpLeft) ? up : upLeft;
+  }
+
+  /// @brief
+  /// 各行の先頭のフィルター種別に従って、その場でフィルターを戻す
+  /// @param data [フィルター種別 + 行データ]がheight行並んだもの
+  bool unfilterRows(uint8_t* data, uint64_t rowBytes, uint32_t height, uint32_t pixelStride, std::string& outError)
+  {
+    const uint8_t* previous = nullptr;
+    for (uint32_t y = 0; y < height; ++y)
+    {
+      uint8_t* line = data + y * (rowBytes + 1);
+      const uint8_t filterType = line[0];
+      uint8_t* row = line + 1;
+
+      switch (filterType)
+      {
+        case 0:
+          break;
+        case 1:
+        {
+          for (uint64_t i = pixelStride; i < rowBytes; ++i)
+          {
+            row[i] = static_cast<uint8_t>(row[i] + row[i - pixelStride]);
+          }
+          break;
+        }
+        case 2:
+        {
+          if (previous != nullptr)
+          {
+            for (uint64_t i = 0; i < rowBytes; ++i)
+            {
+              row[i] = static_cast<uint8_t>(row[i] + previous[i]);
+            }
+          }
+          break;
+        }
+        case 3:
+        {
+          for (uint64_t i = 0; i < rowBytes; ++i)
+          {
+            const uint32_t left = (i >= pixelStride) ? row[i - pixelStride] : 0;
+            const uint32_t up = (previous != nullptr) ? previous[i] : 0;
+            row[i] = static_cast<uint8_t>(row[i] + ((left + up) >> 1));
+          }
+          break;
+        }
+        case 4:
+        {
+          for (uint64_t i = 0; i < rowBytes; ++i)
+          {
+            const uint8_t left = (i >= pixelStride) ? row[i - pixelStride] : 0;
+            const uint8_t up = (previous != nullptr) ? previous[i] : 0;
+            const uint8_t upLeft = (previous != nullptr && i >= pixelStride) ? previous[i - pixelStride] : 0;
+            row[i] = static_cast<uint8_t>(row[i] + paeth(left, up, upLeft));
+          }
+          break;
+        }
+        default:
+        {
+          outError = "invalid filter type";
+          return false;
+        }
+      }
+
+      previous = row;
+    }
+
+    return true;
+  }
+
+  /// @brief
+  /// 行からi番目のサンプルを元のビット深度のまま取り出す
+  uint32_t readSample(const uint8_t* row, uint64_t sampleIndex, uint8_t bitDepth)
+  {
+    if (bitDepth == 8)
+    {
+      return row[sampleIndex];
+    }
+
+    if (bitDepth == 16)
+    {
+      return (static_cast<uint32_t>(row[sampleIndex * 2]) << 8) | row[sampleIndex * 2 + 1];
+    }
+
+    // 1/2/4bitは上位ビットから詰まっている
+    const uint64_t bitOffset = sampleIndex * bitDepth;
+    const uint32_t shift = 8 - bitDepth - static_cast<uint32_t>(bitOffset % 8);
+    return (row[bitOffset / 8] >> shift) & ((1u << bitDepth) - 1);
+  }
+
+  uint8_t toUNorm8(uint32_t sample, uint8_t bitDepth)
+  {
+    switch (bitDepth)
+    {
+      case 1:
+        return static_cast<uint8_t>(sample * 255);
+      case 2:
+        return static_cast<uint8_t>(sample * 85);
+      case 4:
+        return static_cast<uint8_t>(sample * 17);
+      case 16:
+        return static_cast<uint8_t>(sample >> 8);
+      default:
+        return static_cast<uint8_t>(sample);
+    }
+  }
+
+  /// @brief
+  /// フィルターを戻した一行をRGBA8に変換して書き込む
+  bool expandRow(const uint8_t* row, uint32_t width, const PngHeader& header, const PngColorInfo& colorInfo, uint8_t* dstRow, uint32_t xStart, uint32_t xStep, std::string& outError)
+  {
+    const uint32_t channelCount = getChannelCount(header.ColorType);
+
+    for (uint32_t x = 0; x < width; ++x)
+    {
+      uint8_t* out = dstRow + static_cast<size_t>(xStart + x * xStep) * OUTPUT_CHANNEL_COUNT;
+      const uint64_t firstSample = static_cast<uint64_t>(x) * channelCount;
+
+      switch (header.ColorType)
+      {
+        case COLOR_TYPE_GRAY:
+        {
+          const uint32_t sample = readSample(row, firstSample, header.BitDepth);
+          out[0] = out[1] = out[2] = toUNorm8(sample, header.BitDepth);
+          out[3] = (colorInfo.HasColorKey && sample == colorInfo.ColorKey[0]) ? 0 : 255;
+          break;
+        }
+        case COLOR_TYPE_RGB:
+        {
+          uint32_t samples[3] = {};
+          for (uint32_t c = 0; c < 3; ++c)
+          {
+            samples[c] = readSample(row, firstSample + c, header.BitDepth);
+            out[c] = toUNorm8(samples[c], header.BitDepth);
+          }
+          const bool isKey = colorInfo.HasColorKey &&
+                             samples[0] == colorInfo.ColorKey[0] && samples[1] == colorInfo.ColorKey[1] && samples[2] == colorInfo.ColorKey[2];
+          out[3] = isKey ? 0 : 255;
+          break;
+        }
+        case COLOR_TYPE_PALETTE:
+        {
+          const uint32_t index = readSample(row, firstSample, header.BitDepth);
+          if (index >= colorInfo.PaletteSize)
+          {
+            outError = "palette index out of range";
+            return false;
+          }
+          std::memcpy(out, colorInfo.Palette[index], OUTPUT_CHANNEL_COUNT);
+          break;
+        }
+        case COLOR_TYPE_GRAY_ALPHA:
+        {
+          out[0] = out[1] = out[2] = toUNorm8(readSample(row, firstSample, header.BitDepth), header.BitDepth);
+          out[3] = toUNorm8(readSample(row, firstSample + 1, header.BitDepth), header.BitDepth);
+          break;
+        }
+        default:
+        {
+          for (uint32_t c = 0; c < 4; ++c)
+          {
+            out[c] = toUNorm8(readSample(row, firstSample + c, header.BitDepth), header.BitDepth);
+          }
+          break;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+namespace MFramework
+{
+  bool PngTextureDecoder::Decode(const std::string& path, TextureData& outData, std::string& outError) const
+  {
+    MappedFile file;
+    if (!file.Open(path))
+    {
+      outError = "file not found " + path;
+      return false;
+    }
+
+    if (!DecodeMemory(file.GetData(), file.GetSize(), outData, outError))
+    {
+      outError += " : " + path;
+      return false;
+    }
+
+    return true;
+  }
+
+  bool PngTextureDecoder::DecodeMemory(const uint8_t* data, size_t size, TextureData& outData, std::string& outError)
+  {
+    if (data == nullptr || size < sizeof(PNG_SIGNATURE) || std::memcmp(data, PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) != 0)
+    {
+      outError = "not a png file";
+      return false;
+    }
+
+    PngHeader header{};
+    PngColorInfo colorInfo{};
+    std::vector<uint8_t> compressed;
+    bool hasHeader = false;
+    bool hasEnd = false;
+
+    // チャンク : [長さ(4)][種類(4)][データ][CRC(4)]
+    size_t offset = sizeof(PNG_SIGNATURE);
+    while (!hasEnd)
+    {
+      if (offset + 12 > size)
+      {
+        outError = "truncated chunk";
+        return false;
+      }
+
+      const uint32_t length = readBigEndian32(data + offset);
+      const uint8_t* type = data + offset + 4;
+      const uint8_t* chunk = data + offset + 8;
+      if (length > size - offset - 12)
+      {
+        outError = "truncated chunk";
+        return false;
+      }
+
+      if (HashUtility::Crc32(type, static_cast<size_t>(length) + 4) != readBigEndian32(chunk + length))
+      {
+        outError = "chunk crc mismatch";
+        return false;
+      }
+
+      if (std::memcmp(type, "IHDR", 4) == 0)
+      {
+        if (length != 13)
+        {
+          outError = "invalid IHDR";
+          return false;
+        }
+
+        header.Width = readBigEndian32(chunk);
+        header.Height = readBigEndian32(chunk + 4);
+        header.BitDepth = chunk[8];
+        header.ColorType = chunk[9];
+        header.Interlace = chunk[12];
+        if (header.Width == 0 || header.Height == 0 || header.Width > MAX_DIMENSION || header.Height > MAX_DIMENSION ||
+            !isValidBitDepth(header.ColorType, header.BitDepth) || chunk[10] != 0 || chunk[11] != 0 || header.Interlace > 1)
+        {
+          outError = "unsupported IHDR";
+          return false;
+        }
+        hasHeader = true;
+      }
+      else if (!hasHeader)
+      {
+        outError = "IHDR must come first";
+        return false;
+      }
+      else if (std::memcmp(type, "PLTE", 4) == 0)
+      {
+        if (length % 3 != 0 || length / 3 > 256)
+        {
+          outError = "invalid PLTE";
+          return false;
+        }
+
+        colorInfo.PaletteSize = length / 3;
+        for (uint32_t i = 0; i < colorInfo.PaletteSize; ++i)
+        {
+          colorInfo.Palette[i][0] = chunk[i * 3];
+          colorInfo.Palette[i][1] = chunk[i * 3 + 1];
+          colorInfo.Palette[i][2] = chunk[i * 3 + 2];
+          colorInfo.Palette[i][3] = 255;
+        }
+      }
+      else if (std::memcmp(type, "tRNS", 4) == 0)
+      {
+        if (header.ColorType == COLOR_TYPE_PALETTE)
+        {
+          // パレット順のアルファ(足りない分は不透明)
+          for (uint32_t i = 0; i < length && i < 256; ++i)
+          {
+            colorInfo.Palette[i][3] = chunk[i];
+          }
+        }
+        else if (header.ColorType == COLOR_TYPE_GRAY && length >= 2)
+        {
+          colorInfo.HasColorKey = true;
+          colorInfo.ColorKey[0] = static_cast<uint16_t>((chunk[0] << 8) | chunk[1]);
+        }
+        else if (header.ColorType == COLOR_TYPE_RGB && length >= 6)
+        {
+          colorInfo.HasColorKey = true;
+          for (uint32_t c = 0; c < 3; ++c)
+          {
+            colorInfo.ColorKey[c] = static_cast<uint16_t>((chunk[c * 2] << 8) | chunk[c * 2 + 1]);
+          }
+        }
+      }
+      else if (std::memcmp(type, "IDAT", 4) == 0)
+      {
+        compressed.insert(compressed.end(), chunk, chunk + length);
+      }
+      else if (std::memcmp(type, "IEND", 4) == 0)
+      {
+        hasEnd = true;
+      }
+      else if ((type[0] & 0x20) == 0)
+      {
+        // 大文字で始まる未知のチャンクは読み飛ばせない
+        outError = "unknown critical chunk";
+        return false;
+      }
+
+      offset += static_cast<size_t>(length) + 12;
+    }
+
+    if (header.ColorType == COLOR_TYPE_PALETTE && colorInfo.PaletteSize == 0)
+    {
+      outError = "missing PLTE";
+      return false;
+    }
+
+    // 展開後のサイズ(インターレースはパスごとに行が並ぶ)
+    uint64_t expectedSize = 0;
+    if (header.Interlace == 0)
+    {
+      expectedSize = (getRowBytes(header, header.Width) + 1) * header.Height;
+    }
+    else
+    {
+      for (const InterlacePass& pass : ADAM7_PASSES)
+      {
+        const uint32_t passWidth = getPassSize(header.Width, pass.XStart, pass.XStep);
+        const uint32_t passHeight = getPassSize(header.Height, pass.YStart, pass.YStep);
+        if (passWidth > 0 && passHeight > 0)
+        {
+          expectedSize += (getRowBytes(header, passWidth) + 1) * passHeight;
+        }
+      }
+    }
+
+    std::vector<uint8_t> filtered;
+    if (!InflateUtility::DecompressZlib(compressed.data(), compressed.size(), filtered, outError, static_cast<size_t>(expectedSize)))
+    {
+      return false;
+    }
+
+    if (filtered.size() < expectedSize)
+    {
+      outError = "image data too short";
+      return false;
+    }
+
+    outData.Desc.Width = header.Width;
+    outData.Desc.Height = header.Height;
+    outData.Desc.DepthOrArraySize = 1;
+    outData.Desc.MipLevels = 1;
+    outData.Desc.Format = FORMAT_R8G8B8A8_UNORM;
+    outData.Desc.Dimension = TEXTURE_DIMENSION_TEXTURE2D;
+
+    const uint64_t dstRowPitch = static_cast<uint64_t>(header.Width) * OUTPUT_CHANNEL_COUNT;
+    outData.Pixels.assign(static_cast<size_t>(dstRowPitch * header.Height), 0);
+    outData.Subresources.assign(1, SubresourceData{ 0, dstRowPitch, dstRowPitch * header.Height });
+
+    // フィルターは1byte未満のピクセルでも1byte単位で参照する
+    const uint32_t bitsPerPixel = getChannelCount(header.ColorType) * header.BitDepth;
+    const uint32_t pixelStride = std::max<uint32_t>(1, bitsPerPixel / 8);
+
+    const InterlacePass fullPass{ 0, 0, 1, 1 };
+    const InterlacePass* passes = (header.Interlace == 0) ? &fullPass : ADAM7_PASSES;
+    const uint32_t passCount = (header.Interlace == 0) ? 1 : 7;
+
+    uint8_t* passData = filtered.data();
+    for (uint32_t p = 0; p < passCount; ++p)
+    {
+      const InterlacePass& pass = passes[p];
+      const uint32_t passWidth = getPassSize(header.Width, pass.XStart, pass.XStep);
+      const uint32_t passHeight = getPassSize(header.Height, pass.YStart, pass.YStep);
+      if (passWidth == 0 || passHeight == 0)
+      {
+        continue;
+      }
+
+      const uint64_t rowBytes = getRowBytes(header, passWidth);
+      if (!unfilterRows(passData, rowBytes, passHeight, pixelStride, outError))
+      {
+        return false;
+      }
+
+      for (uint32_t y = 0; y < passHeight; ++y)
+      {
+        const uint8_t* row = passData + y * (rowBytes + 1) + 1;
+        uint8_t* dstRow = outData.Pixels.data() + (pass.YStart + static_cast<uint64_t>(y) * pass.YStep) * dstRowPitch;
+        if (!expandRow(row, passWidth, header, colorInfo, dstRow, pass.XStart, pass.XStep, outError))
+        {
+          return false;
+        }
+      }
+
+      passData += (rowBytes + 1) * passHeight;
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,732 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Render graph (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Flush barriers before each pass
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/RenderGraph.h>
+#include <HashUtil.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <queue>
+
+namespace
+{
+  using MFramework::ResourceStates;
+
+  // D3D12_RESOURCE_STATESのうち書き込みを伴う状態
+  // RENDER_TARGET | UNORDERED_ACCESS | DEPTH_WRITE | STREAM_OUT | COPY_DEST | RESOLVE_DEST
+  constexpr ResourceStates WRITE_RESOURCE_STATES = 0x4 | 0x8 | 0x10 | 0x100 | 0x400 | 0x1000;
+
+  // D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT
+  constexpr uint64_t DEFAULT_PLACEMENT_ALIGNMENT = 65536;
+
+  const std::string EMPTY_NAME;
+
+  // 読み取り専用の状態同士はORでまとめて一回の遷移にできる
+  // COMMON(0)はまとめられない
+  bool IsReadOnlyState(ResourceStates state)
+  {
+    return (state != 0) && ((state & WRITE_RESOURCE_STATES) == 0);
+  }
+
+  uint64_t AlignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+}
+
+namespace MFramework
+{
+  RenderGraph::RenderGraph()
+    : m_resources()
+    , m_passes()
+    , m_compiled()
+    , m_isCompiled(false)
+    , m_hasCache(false)
+    , m_cacheHitCount(0)
+  { }
+
+  RenderGraph::~RenderGraph()
+  {
+    Dispose();
+  }
+
+  RenderGraphResourceHandle RenderGraph::ImportResource(const std::string& name, ID3D12Resource* resource, ResourceStates initialState, ResourceStates finalState)
+  {
+    ResourceNode node{};
+    node.Name = name;
+    node.IsImported = true;
+    node.Imported = resource;
+    node.InitialState = initialState;
+    node.FinalState = finalState;
+
+    m_resources.emplace_back(std::move(node));
+    m_isCompiled = false;
+
+    return RenderGraphResourceHandle(static_cast<uint32_t>(m_resources.size() - 1));
+  }
+
+  RenderGraphResourceHandle RenderGraph::CreateTransient(const std::string& name, const TransientResourceDesc& desc)
+  {
+    ResourceNode node{};
+    node.Name = name;
+    node.IsImported = false;
+    node.Imported = nullptr;
+    node.InitialState = UNKNOWN_RESOURCE_STATE;
+    node.FinalState = UNKNOWN_RESOURCE_STATE;
+    node.Desc = desc;
+
+    m_resources.emplace_back(std::move(node));
+    m_isCompiled = false;
+
+    return RenderGraphResourceHandle(static_cast<uint32_t>(m_resources.size() - 1));
+  }
+
+  RenderGraphPassHandle RenderGraph::AddPass(const std::string& name, ExecuteFunc execute)
+  {
+    PassNode node{};
+    node.Name = name;
+    node.HasSideEffect = false;
+    node.Execute = std::move(execute);
+
+    m_passes.emplace_back(std::move(node));
+    m_isCompiled = false;
+
+    return RenderGraphPassHandle(static_cast<uint32_t>(m_passes.size() - 1));
+  }
+
+  void RenderGraph::Read(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, ResourceStates state)
+  {
+    addAccess(pass, resource, state, false);
+  }
+
+  void RenderGraph::Write(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, ResourceStates state)
+  {
+    addAccess(pass, resource, state, true);
+  }
+
+  void RenderGraph::SetSideEffect(RenderGraphPassHandle pass)
+  {
+    if (pass.Index >= m_passes.size())
+    {
+      assert(false && "RenderGraph : invalid pass handle");
+      return;
+    }
+
+    m_passes[pass.Index].HasSideEffect = true;
+    m_isCompiled = false;
+  }
+
+  bool RenderGraph::Compile()
+  {
+    const uint64_t hash = computeHash();
+
+    // 構造が変わっていなければ前回の結果を使う
+    if (m_hasCache && (m_compiled.Hash == hash))
+    {
+      ++m_cacheHitCount;
+      m_isCompiled = true;
+      return true;
+    }
+
+    std::vector<std::vector<uint32_t>> predecessors;
+    buildDependencies(predecessors);
+
+    std::vector<uint8_t> alive;
+    const uint32_t culledCount = cullPasses(predecessors, alive);
+
+    std::vector<uint32_t> order;
+    if (!sortPasses(predecessors, alive, order))
+    {
+      m_isCompiled = false;
+      m_hasCache = false;
+      return false;
+    }
+
+    CompiledRenderGraph compiled{};
+    compiled.Passes.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+      compiled.Passes[i].PassIndex = order[i];
+    }
+
+    // エイリアシングバリアを遷移バリアより先に積むため、配置を先に決める
+    allocateTransients(order, compiled);
+    planBarriers(order, compiled);
+
+    compiled.CulledPassCount = culledCount;
+    compiled.BarrierCount = static_cast<uint32_t>(compiled.FinalBarriers.size());
+    for (const CompiledRenderPass& pass : compiled.Passes)
+    {
+      compiled.BarrierCount += static_cast<uint32_t>(pass.Barriers.size());
+    }
+    compiled.Hash = hash;
+
+    m_compiled = std::move(compiled);
+    m_isCompiled = true;
+    m_hasCache = true;
+
+    return true;
+  }
+
+  void RenderGraph::Execute(const BarrierFunc& onBarrier, const FlushFunc& onFlush) const
+  {
+    if (!m_isCompiled)
+    {
+      assert(false && "RenderGraph : execute before compile");
+      return;
+    }
+
+    for (const CompiledRenderPass& compiledPass : m_compiled.Passes)
+    {
+      if (onBarrier)
+      {
+        for (const RenderGraphBarrier& barrier : compiledPass.Barriers)
+        {
+          onBarrier(barrier);
+        }
+      }
+
+      // パスが記録するコマンドより先にバリアを記録する
+      if (onFlush)
+      {
+        onFlush();
+      }
+
+      const PassNode& pass = m_passes[compiledPass.PassIndex];
+      if (pass.Execute)
+      {
+        pass.Execute();
+      }
+    }
+
+    if (onBarrier)
+    {
+      for (const RenderGraphBarrier& barrier : m_compiled.FinalBarriers)
+      {
+        onBarrier(barrier);
+      }
+    }
+
+    if (onFlush)
+    {
+      onFlush();
+    }
+  }
+
+  void RenderGraph::Reset()
+  {
+    m_resources.clear();
+    m_passes.clear();
+    m_isCompiled = false;
+  }
+
+  ID3D12Resource* RenderGraph::GetImportedResource(RenderGraphResourceHandle resource) const
+  {
+    if (resource.Index >= m_resources.size())
+    {
+      return nullptr;
+    }
+
+    return m_resources[resource.Index].Imported;
+  }
+
+  const std::string& RenderGraph::GetPassName(RenderGraphPassHandle pass) const
+  {
+    if (pass.Index >= m_passes.size())
+    {
+      return EMPTY_NAME;
+    }
+
+    return m_passes[pass.Index].Name;
+  }
+
+  const std::string& RenderGraph::GetResourceName(RenderGraphResourceHandle resource) const
+  {
+    if (resource.Index >= m_resources.size())
+    {
+      return EMPTY_NAME;
+    }
+
+    return m_resources[resource.Index].Name;
+  }
+
+  void RenderGraph::Dispose() noexcept
+  {
+    m_resources.clear();
+    m_resources.shrink_to_fit();
+    m_passes.clear();
+    m_passes.shrink_to_fit();
+    m_compiled = CompiledRenderGraph{};
+    m_isCompiled = false;
+    m_hasCache = false;
+    m_cacheHitCount = 0;
+  }
+
+  void RenderGraph::addAccess(RenderGraphPassHandle pass, RenderGraphResourceHandle resource, ResourceStates state, bool isWrite)
+  {
+    if ((pass.Index >= m_passes.size()) || (resource.Index >= m_resources.size()))
+    {
+      assert(false && "RenderGraph : invalid handle");
+      return;
+    }
+
+    m_passes[pass.Index].Accesses.emplace_back(PassAccess{ resource.Index, state, isWrite });
+    m_isCompiled = false;
+  }
+
+  uint64_t RenderGraph::computeHash() const
+  {
+    // 名前と実行関数、インポートしたリソースの実体は構造に含めない
+    uint64_t hash = HashUtility::HashValue(m_resources.size());
+
+    for (const ResourceNode& resource : m_resources)
+    {
+      hash = HashUtility::HashValue(resource.IsImported, hash);
+      hash = HashUtility::HashValue(resource.InitialState, hash);
+      hash = HashUtility::HashValue(resource.FinalState, hash);
+      if (!resource.IsImported)
+      {
+        hash = HashUtility::HashValue(resource.Desc.SizeInBytes, hash);
+        hash = HashUtility::HashValue(resource.Desc.Alignment, hash);
+        hash = HashUtility::HashValue(resource.Desc.Width, hash);
+        hash = HashUtility::HashValue(resource.Desc.Height, hash);
+        hash = HashUtility::HashValue(resource.Desc.Format, hash);
+      }
+    }
+
+    hash = HashUtility::HashValue(m_passes.size(), hash);
+
+    for (const PassNode& pass : m_passes)
+    {
+      hash = HashUtility::HashValue(pass.HasSideEffect, hash);
+      hash = HashUtility::HashValue(pass.Accesses.size(), hash);
+      for (const PassAccess& access : pass.Accesses)
+      {
+        hash = HashUtility::HashValue(access.Resource, hash);
+        hash = HashUtility::HashValue(access.State, hash);
+        hash = HashUtility::HashValue(access.IsWrite, hash);
+      }
+    }
+
+    return hash;
+  }
+
+  void RenderGraph::buildDependencies(std::vector<std::vector<uint32_t>>& outPredecessors) const
+  {
+    constexpr uint32_t NO_WRITER = 0xffffffff;
+
+    // 宣言順に走査し、リソースごとに最後の書き込みパスとそれ以降の読み込みパスを覚えておく
+    std::vector<uint32_t> lastWriters(m_resources.size(), NO_WRITER);
+    std::vector<std::vector<uint32_t>> readersSinceWrite(m_resources.size());
+
+    outPredecessors.assign(m_passes.size(), {});
+
+    for (uint32_t passIndex = 0; passIndex < static_cast<uint32_t>(m_passes.size()); ++passIndex)
+    {
+      std::vector<uint32_t>& predecessors = outPredecessors[passIndex];
+
+      for (const PassAccess& access : m_passes[passIndex].Accesses)
+      {
+        const uint32_t lastWriter = lastWriters[access.Resource];
+
+        // 書き込み後の読み込み/書き込み
+        if ((lastWriter != NO_WRITER) && (lastWriter != passIndex))
+        {
+          predecessors.emplace_back(lastWriter);
+        }
+
+        std::vector<uint32_t>& readers = readersSinceWrite[access.Resource];
+
+        if (access.IsWrite)
+        {
+          // 読み込み後の書き込み
+          for (uint32_t reader : readers)
+          {
+            if (reader != passIndex)
+            {
+              predecessors.emplace_back(reader);
+            }
+          }
+
+          readers.clear();
+          lastWriters[access.Resource] = passIndex;
+        }
+        else
+        {
+          readers.emplace_back(passIndex);
+        }
+      }
+
+      std::sort(predecessors.begin(), predecessors.end());
+      predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+    }
+  }
+
+  uint32_t RenderGraph::cullPasses(const std::vector<std::vector<uint32_t>>& predecessors, std::vector<uint8_t>& outAlive) const
+  {
+    outAlive.assign(m_passes.size(), 0);
+
+    // 副作用のあるパスとインポートしたリソースに書き込むパスから依存を遡る
+    std::vector<uint32_t> stack;
+    for (uint32_t passIndex = 0; passIndex < static_cast<uint32_t>(m_passes.size()); ++passIndex)
+    {
+      const PassNode& pass = m_passes[passIndex];
+      bool isRoot = pass.HasSideEffect;
+
+      for (const PassAccess& access : pass.Accesses)
+      {
+        if (access.IsWrite && m_resources[access.Resource].IsImported)
+        {
+          isRoot = true;
+          break;
+        }
+      }
+
+      if (isRoot)
+      {
+        outAlive[passIndex] = 1;
+        stack.emplace_back(passIndex);
+      }
+    }
+
+    while (!stack.empty())
+    {
+      const uint32_t passIndex = stack.back();
+      stack.pop_back();
+
+      for (uint32_t predecessor : predecessors[passIndex])
+      {
+        if (outAlive[predecessor] == 0)
+        {
+          outAlive[predecessor] = 1;
+          stack.emplace_back(predecessor);
+        }
+      }
+    }
+
+    uint32_t culledCount = 0;
+    for (uint8_t isAlive : outAlive)
+    {
+      culledCount += (isAlive == 0) ? 1 : 0;
+    }
+
+    return culledCount;
+  }
+
+  bool RenderGraph::sortPasses(const std::vector<std::vector<uint32_t>>& predecessors, const std::vector<uint8_t>& alive, std::vector<uint32_t>& outOrder) const
+  {
+    const uint32_t passCount = static_cast<uint32_t>(m_passes.size());
+
+    std::vector<uint32_t> inDegrees(passCount, 0);
+    std::vector<std::vector<uint32_t>> successors(passCount);
+    uint32_t aliveCount = 0;
+
+    for (uint32_t passIndex = 0; passIndex < passCount; ++passIndex)
+    {
+      if (alive[passIndex] == 0)
+      {
+        continue;
+      }
+
+      ++aliveCount;
+      for (uint32_t predecessor : predecessors[passIndex])
+      {
+        // 生きているパスの依存先は必ず生きている
+        successors[predecessor].emplace_back(passIndex);
+        ++inDegrees[passIndex];
+      }
+    }
+
+    // Kahn法(同順位は宣言順を優先して結果を安定させる)
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+    for (uint32_t passIndex = 0; passIndex < passCount; ++passIndex)
+    {
+      if ((alive[passIndex] != 0) && (inDegrees[passIndex] == 0))
+      {
+        ready.push(passIndex);
+      }
+    }
+
+    outOrder.clear();
+    outOrder.reserve(aliveCount);
+
+    while (!ready.empty())
+    {
+      const uint32_t passIndex = ready.top();
+      ready.pop();
+      outOrder.emplace_back(passIndex);
+
+      for (uint32_t successor : successors[passIndex])
+      {
+        if (--inDegrees[successor] == 0)
+        {
+          ready.push(successor);
+        }
+      }
+    }
+
+    // 循環がある
+    return outOrder.size() == aliveCount;
+  }
+
+  void RenderGraph::allocateTransients(const std::vector<uint32_t>& order, CompiledRenderGraph& outCompiled) const
+  {
+    constexpr uint32_t NOT_USED = 0xffffffff;
+
+    const uint32_t resourceCount = static_cast<uint32_t>(m_resources.size());
+
+    // 実行順での寿命を求める
+    std::vector<uint32_t> firstOrders(resourceCount, NOT_USED);
+    std::vector<uint32_t> lastOrders(resourceCount, 0);
+
+    for (uint32_t orderIndex = 0; orderIndex < static_cast<uint32_t>(order.size()); ++orderIndex)
+    {
+      for (const PassAccess& access : m_passes[order[orderIndex]].Accesses)
+      {
+        if (m_resources[access.Resource].IsImported)
+        {
+          continue;
+        }
+
+        firstOrders[access.Resource] = std::min(firstOrders[access.Resource], orderIndex);
+        lastOrders[access.Resource] = std::max(lastOrders[access.Resource], orderIndex);
+      }
+    }
+
+    std::vector<uint32_t> transients;
+    for (uint32_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex)
+    {
+      if (firstOrders[resourceIndex] != NOT_USED)
+      {
+        transients.emplace_back(resourceIndex);
+      }
+    }
+
+    // 大きいものから配置する
+    std::stable_sort(
+                      transients.begin(),
+                      transients.end(),
+                      [this](uint32_t lhs, uint32_t rhs)
+                      {
+                        return m_resources[lhs].Desc.SizeInBytes > m_resources[rhs].Desc.SizeInBytes;
+                      }
+                    );
+
+    std::vector<TransientAllocation>& allocations = outCompiled.TransientAllocations;
+    allocations.clear();
+    allocations.reserve(transients.size());
+
+    uint64_t heapSize = 0;
+    std::vector<const TransientAllocation*> conflicts;
+
+    for (uint32_t resourceIndex : transients)
+    {
+      const TransientResourceDesc& desc = m_resources[resourceIndex].Desc;
+      const uint64_t alignment = (desc.Alignment != 0) ? desc.Alignment : DEFAULT_PLACEMENT_ALIGNMENT;
+      const uint32_t first = firstOrders[resourceIndex];
+      const uint32_t last = lastOrders[resourceIndex];
+
+      // 寿命が重なる配置済みリソースとはメモリを共有できない
+      conflicts.clear();
+      for (const TransientAllocation& placed : allocations)
+      {
+        if ((placed.FirstPassOrder <= last) && (first <= placed.LastPassOrder))
+        {
+          conflicts.emplace_back(&placed);
+        }
+      }
+
+      std::sort(
+                conflicts.begin(),
+                conflicts.end(),
+                [](const TransientAllocation* lhs, const TransientAllocation* rhs)
+                {
+                  return lhs->Offset < rhs->Offset;
+                }
+              );
+
+      // 先頭から隙間を探す
+      uint64_t offset = 0;
+      for (const TransientAllocation* conflict : conflicts)
+      {
+        if (offset + desc.SizeInBytes <= conflict->Offset)
+        {
+          break;
+        }
+
+        offset = std::max(offset, AlignUp(conflict->Offset + conflict->SizeInBytes, alignment));
+      }
+
+      TransientAllocation allocation{};
+      allocation.Resource = RenderGraphResourceHandle(resourceIndex);
+      allocation.Offset = offset;
+      allocation.SizeInBytes = desc.SizeInBytes;
+      allocation.InitialState = UNKNOWN_RESOURCE_STATE;
+      allocation.FirstPassOrder = first;
+      allocation.LastPassOrder = last;
+      allocations.emplace_back(allocation);
+
+      heapSize = std::max(heapSize, offset + desc.SizeInBytes);
+    }
+
+    std::sort(
+              allocations.begin(),
+              allocations.end(),
+              [](const TransientAllocation& lhs, const TransientAllocation& rhs)
+              {
+                return lhs.Resource.Index < rhs.Resource.Index;
+              }
+            );
+
+    // 同じメモリを直前まで使っていたリソースとの間にエイリアシングバリアを置く
+    for (const TransientAllocation& after : allocations)
+    {
+      const TransientAllocation* before = nullptr;
+
+      for (const TransientAllocation& other : allocations)
+      {
+        const bool isMemoryOverlapped = (other.Offset < after.Offset + after.SizeInBytes) && (after.Offset < other.Offset + other.SizeInBytes);
+        if (!isMemoryOverlapped || (other.LastPassOrder >= after.FirstPassOrder))
+        {
+          continue;
+        }
+
+        if ((before == nullptr) || (other.LastPassOrder > before->LastPassOrder))
+        {
+          before = &other;
+        }
+      }
+
+      if (before != nullptr)
+      {
+        RenderGraphBarrier barrier{};
+        barrier.BarrierType = RenderGraphBarrier::Type::Aliasing;
+        barrier.Resource = after.Resource;
+        barrier.AliasedBefore = before->Resource;
+        barrier.Before = UNKNOWN_RESOURCE_STATE;
+        barrier.After = UNKNOWN_RESOURCE_STATE;
+        outCompiled.Passes[after.FirstPassOrder].Barriers.emplace_back(barrier);
+      }
+    }
+
+    outCompiled.TransientHeapSize = heapSize;
+  }
+
+  void RenderGraph::planBarriers(const std::vector<uint32_t>& order, CompiledRenderGraph& outCompiled) const
+  {
+    struct ResourceUse
+    {
+      uint32_t Order;
+      ResourceStates State;
+      bool IsWrite;
+    };
+
+    const uint32_t resourceCount = static_cast<uint32_t>(m_resources.size());
+
+    // 実行順でのリソースごとの使用履歴(同じパス内の複数の宣言はまとめる)
+    std::vector<std::vector<ResourceUse>> uses(resourceCount);
+    for (uint32_t orderIndex = 0; orderIndex < static_cast<uint32_t>(order.size()); ++orderIndex)
+    {
+      for (const PassAccess& access : m_passes[order[orderIndex]].Accesses)
+      {
+        std::vector<ResourceUse>& resourceUses = uses[access.Resource];
+
+        if (!resourceUses.empty() && (resourceUses.back().Order == orderIndex))
+        {
+          resourceUses.back().State |= access.State;
+          resourceUses.back().IsWrite |= access.IsWrite;
+        }
+        else
+        {
+          resourceUses.emplace_back(ResourceUse{ orderIndex, access.State, access.IsWrite });
+        }
+      }
+    }
+
+    std::vector<TransientAllocation*> allocationLookup(resourceCount, nullptr);
+    for (TransientAllocation& allocation : outCompiled.TransientAllocations)
+    {
+      allocationLookup[allocation.Resource.Index] = &allocation;
+    }
+
+    for (uint32_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex)
+    {
+      const ResourceNode& resource = m_resources[resourceIndex];
+      const std::vector<ResourceUse>& resourceUses = uses[resourceIndex];
+
+      // 一時リソースは最初に使う状態で作るため、最初の遷移は不要
+      ResourceStates current = resource.IsImported ? resource.InitialState : UNKNOWN_RESOURCE_STATE;
+
+      for (size_t useIndex = 0; useIndex < resourceUses.size(); ++useIndex)
+      {
+        const ResourceUse& use = resourceUses[useIndex];
+        ResourceStates target = use.State;
+
+        if (!use.IsWrite && IsReadOnlyState(target))
+        {
+          // すでに必要な読み取り状態を含んでいれば遷移しない
+          if (IsReadOnlyState(current) && ((current & target) == target))
+          {
+            continue;
+          }
+
+          // 続けて読むだけのパスの状態をまとめ、一回の遷移で済ませる
+          for (size_t nextIndex = useIndex + 1; nextIndex < resourceUses.size(); ++nextIndex)
+          {
+            const ResourceUse& next = resourceUses[nextIndex];
+            if (next.IsWrite || !IsReadOnlyState(next.State))
+            {
+              break;
+            }
+
+            target |= next.State;
+          }
+        }
+
+        if (current == UNKNOWN_RESOURCE_STATE)
+        {
+          if (allocationLookup[resourceIndex] != nullptr)
+          {
+            allocationLookup[resourceIndex]->InitialState = target;
+          }
+        }
+        else if (current != target)
+        {
+          RenderGraphBarrier barrier{};
+          barrier.BarrierType = RenderGraphBarrier::Type::Transition;
+          barrier.Resource = RenderGraphResourceHandle(resourceIndex);
+          barrier.Before = current;
+          barrier.After = target;
+          outCompiled.Passes[use.Order].Barriers.emplace_back(barrier);
+        }
+
+        current = target;
+      }
+
+      // インポートしたリソースを指定された最終状態に戻す
+      if (resource.IsImported && (resource.FinalState != UNKNOWN_RESOURCE_STATE) && (current != resource.FinalState))
+      {
+        RenderGraphBarrier barrier{};
+        barrier.BarrierType = RenderGraphBarrier::Type::Transition;
+        barrier.Resource = RenderGraphResourceHandle(resourceIndex);
+        barrier.Before = current;
+        barrier.After = resource.FinalState;
+        outCompiled.FinalBarriers.emplace_back(barrier);
+      }
+    }
+  }
+}
@@ -0,0 +1,150 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Staging ring allocator (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/StagingRing.h>
+
+namespace
+{
+  uint64_t alignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+}
+
+namespace MFramework
+{
+  StagingRing::StagingRing()
+    : m_capacity(0)
+    , m_head(0)
+    , m_tail(0)
+    , m_usedSize(0)
+    , m_uncommittedSize(0)
+    , m_retirements()
+  { }
+
+  StagingRing::~StagingRing()
+  {
+    Dispose();
+  }
+
+  bool StagingRing::Init(uint64_t capacity)
+  {
+    if (capacity == 0)
+    {
+      return false;
+    }
+
+    Dispose();
+    m_capacity = capacity;
+    return true;
+  }
+
+  uint64_t StagingRing::Allocate(uint64_t size, uint64_t alignment)
+  {
+    if (size == 0 || size > m_capacity || alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+      return INVALID_OFFSET;
+    }
+
+    // 何も使っていなければ先頭からやり直す
+    if (m_usedSize == 0)
+    {
+      m_head = 0;
+      m_tail = 0;
+    }
+
+    const bool isFull = (m_usedSize == m_capacity);
+    if (isFull)
+    {
+      return INVALID_OFFSET;
+    }
+
+    uint64_t offset = INVALID_OFFSET;
+    uint64_t consumed = 0;
+
+    if (m_head >= m_tail)
+    {
+      // [tail, head)が使用中 : 末尾に置けるか、先頭に戻って[0, tail)に置けるか
+      const uint64_t aligned = alignUp(m_head, alignment);
+      if (aligned + size <= m_capacity)
+      {
+        offset = aligned;
+        consumed = aligned + size - m_head;
+      }
+      else if (size <= m_tail)
+      {
+        offset = 0;
+        consumed = (m_capacity - m_head) + size;
+      }
+    }
+    else
+    {
+      // 折り返し済み : [head, tail)が空き
+      const uint64_t aligned = alignUp(m_head, alignment);
+      if (aligned + size <= m_tail)
+      {
+        offset = aligned;
+        consumed = aligned + size - m_head;
+      }
+    }
+
+    if (offset == INVALID_OFFSET)
+    {
+      return INVALID_OFFSET;
+    }
+
+    m_head = offset + size;
+    if (m_head == m_capacity)
+    {
+      m_head = 0;
+    }
+    m_usedSize += consumed;
+    m_uncommittedSize += consumed;
+
+    return offset;
+  }
+
+  void StagingRing::Commit(uint64_t fenceValue)
+  {
+    if (m_uncommittedSize == 0)
+    {
+      return;
+    }
+
+    m_retirements.push_back(Retirement{ fenceValue, m_head, m_uncommittedSize });
+    m_uncommittedSize = 0;
+  }
+
+  void StagingRing::Release(uint64_t completedFenceValue)
+  {
+    while (!m_retirements.empty() && m_retirements.front().FenceValue <= completedFenceValue)
+    {
+      const Retirement& retirement = m_retirements.front();
+      m_tail = retirement.Head;
+      m_usedSize -= retirement.Size;
+      m_retirements.pop_front();
+    }
+  }
+
+  void StagingRing::Dispose() noexcept
+  {
+    m_capacity = 0;
+    m_head = 0;
+    m_tail = 0;
+    m_usedSize = 0;
+    m_uncommittedSize = 0;
+    m_retirements.clear();
+  }
+}
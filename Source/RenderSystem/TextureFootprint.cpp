@@ -0,0 +1,214 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Texture footprint calculation (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add GetMipDesc
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/TextureFootprint.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  struct FormatRange
+  {
+    uint32_t First;   // DXGI_FORMAT
+    uint32_t Last;
+    uint32_t BytesPerBlock;
+    uint32_t BlockSize;
+  };
+
+  // 対応しているDXGI_FORMAT(値の範囲ごと)
+  constexpr FormatRange FORMAT_TABLE[] =
+  {
+    {   1,   4, 16, 1 },   // R32G32B32A32
+    {   5,   8, 12, 1 },   // R32G32B32
+    {   9,  14,  8, 1 },   // R16G16B16A16
+    {  15,  18,  8, 1 },   // R32G32
+    {  23,  26,  4, 1 },   // R10G10B10A2 / R11G11B10_FLOAT
+    {  27,  32,  4, 1 },   // R8G8B8A8
+    {  33,  38,  4, 1 },   // R16G16
+    {  39,  43,  4, 1 },   // R32 / D32_FLOAT
+    {  48,  52,  2, 1 },   // R8G8
+    {  53,  59,  2, 1 },   // R16 / D16_UNORM
+    {  60,  65,  1, 1 },   // R8 / A8
+    {  67,  67,  4, 1 },   // R9G9B9E5_SHAREDEXP
+    {  70,  72,  8, 4 },   // BC1
+    {  73,  78, 16, 4 },   // BC2 / BC3
+    {  79,  81,  8, 4 },   // BC4
+    {  82,  84, 16, 4 },   // BC5
+    {  85,  86,  2, 1 },   // B5G6R5 / B5G5R5A1
+    {  87,  88,  4, 1 },   // B8G8R8A8 / B8G8R8X8
+    {  90,  93,  4, 1 },   // B8G8R8A8 / B8G8R8X8 (TYPELESS / SRGB)
+    {  94,  99, 16, 4 },   // BC6H / BC7
+    { 115, 115,  2, 1 },   // B4G4R4A4
+  };
+
+  uint64_t alignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+}
+
+namespace MFramework
+{
+  TextureFormatInfo TextureFootprint::GetFormatInfo(uint32_t format)
+  {
+    for (const FormatRange& range : FORMAT_TABLE)
+    {
+      if (format >= range.First && format <= range.Last)
+      {
+        return TextureFormatInfo{ range.BytesPerBlock, range.BlockSize, range.BlockSize };
+      }
+    }
+
+    return TextureFormatInfo{ 0, 0, 0 };
+  }
+
+  uint32_t TextureFootprint::GetSubresourceCount(const TextureDesc& desc)
+  {
+    const uint32_t arraySize = (desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D) ? 1 : desc.DepthOrArraySize;
+    return desc.MipLevels * arraySize;
+  }
+
+  uint32_t TextureFootprint::GetMipDimension(uint32_t size, uint32_t mipLevel)
+  {
+    if (mipLevel >= 32)
+    {
+      return 1;
+    }
+
+    return std::max<uint32_t>(size >> mipLevel, 1);
+  }
+
+  TextureDesc TextureFootprint::GetMipDesc(const TextureDesc& desc, uint32_t firstMip)
+  {
+    const uint32_t mip = std::min(firstMip, desc.MipLevels - 1);
+
+    TextureDesc mipDesc = desc;
+    mipDesc.Width = GetMipDimension(desc.Width, mip);
+    mipDesc.Height = GetMipDimension(desc.Height, mip);
+    if (desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D)
+    {
+      mipDesc.DepthOrArraySize = GetMipDimension(desc.DepthOrArraySize, mip);
+    }
+    mipDesc.MipLevels = desc.MipLevels - mip;
+    return mipDesc;
+  }
+
+  bool TextureFootprint::Compute(const TextureDesc& desc, uint32_t firstSubresource, uint32_t subresourceCount, uint64_t baseOffset, std::vector<SubresourceFootprint>& outFootprints, uint64_t* outTotalBytes)
+  {
+    outFootprints.clear();
+
+    const TextureFormatInfo info = GetFormatInfo(desc.Format);
+    if (!info.IsValid() || desc.Width == 0 || desc.Height == 0 || desc.DepthOrArraySize == 0 || desc.MipLevels == 0)
+    {
+      return false;
+    }
+
+    if (firstSubresource + subresourceCount > GetSubresourceCount(desc) || subresourceCount == 0)
+    {
+      return false;
+    }
+
+    if (baseOffset % TEXTURE_DATA_PLACEMENT_ALIGNMENT != 0)
+    {
+      return false;
+    }
+
+    const bool isVolume = (desc.Dimension == TEXTURE_DIMENSION_TEXTURE3D);
+
+    outFootprints.reserve(subresourceCount);
+
+    uint64_t offset = baseOffset;
+    uint64_t totalBytes = 0;
+    for (uint32_t i = 0; i < subresourceCount; ++i)
+    {
+      const uint32_t subresource = firstSubresource + i;
+      const uint32_t mipLevel = subresource % desc.MipLevels;
+
+      const uint32_t width = GetMipDimension(desc.Width, mipLevel);
+      const uint32_t height = GetMipDimension(desc.Height, mipLevel);
+      const uint32_t depth = isVolume ? GetMipDimension(desc.DepthOrArraySize, mipLevel) : 1;
+
+      const uint64_t blocksWide = (width + info.BlockWidth - 1) / info.BlockWidth;
+      const uint32_t numRows = (height + info.BlockHeight - 1) / info.BlockHeight;
+
+      SubresourceFootprint footprint{};
+      footprint.Offset = offset;
+      footprint.Format = desc.Format;
+      // ブロック圧縮フォーマットはブロック単位に切り上げたサイズになる
+      footprint.Width = static_cast<uint32_t>(alignUp(width, info.BlockWidth));
+      footprint.Height = static_cast<uint32_t>(alignUp(height, info.BlockHeight));
+      footprint.Depth = depth;
+      footprint.RowSizeInBytes = blocksWide * info.BytesPerBlock;
+      footprint.RowPitch = static_cast<uint32_t>(alignUp(footprint.RowSizeInBytes, TEXTURE_DATA_PITCH_ALIGNMENT));
+      footprint.NumRows = numRows;
+
+      outFootprints.emplace_back(footprint);
+
+      // 最後の行のパディングは含めない(GetCopyableFootprintsのpTotalBytesと同じ)
+      const uint64_t usedBytes = static_cast<uint64_t>(footprint.RowPitch) * (static_cast<uint64_t>(numRows) * depth - 1) + footprint.RowSizeInBytes;
+      totalBytes = offset + usedBytes - baseOffset;
+
+      offset = alignUp(offset + static_cast<uint64_t>(footprint.RowPitch) * numRows * depth, TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    }
+
+    if (outTotalBytes != nullptr)
+    {
+      *outTotalBytes = totalBytes;
+    }
+
+    return true;
+  }
+
+  bool TextureFootprint::Compute(const TextureDesc& desc, std::vector<SubresourceFootprint>& outFootprints, uint64_t* outTotalBytes)
+  {
+    return Compute(desc, 0, GetSubresourceCount(desc), 0, outFootprints, outTotalBytes);
+  }
+
+  void TextureFootprint::CopySubresource(uint8_t* dst, const SubresourceFootprint& footprint, const uint8_t* src, uint64_t srcRowPitch, uint64_t srcSlicePitch)
+  {
+    if (dst == nullptr || src == nullptr)
+    {
+      return;
+    }
+
+    const size_t rowSize = static_cast<size_t>(footprint.RowSizeInBytes);
+    uint8_t* dstSlice = dst + footprint.Offset;
+    const uint64_t dstSlicePitch = static_cast<uint64_t>(footprint.RowPitch) * footprint.NumRows;
+
+    for (uint32_t z = 0; z < footprint.Depth; ++z)
+    {
+      // ピッチが同じなら一回でコピーする
+      if (srcRowPitch == footprint.RowPitch)
+      {
+        std::memcpy(dstSlice, src + srcSlicePitch * z, static_cast<size_t>(footprint.RowPitch) * (footprint.NumRows - 1) + rowSize);
+      }
+      else
+      {
+        const uint8_t* srcRow = src + srcSlicePitch * z;
+        uint8_t* dstRow = dstSlice;
+        for (uint32_t y = 0; y < footprint.NumRows; ++y)
+        {
+          std::memcpy(dstRow, srcRow, rowSize);
+          srcRow += srcRowPitch;
+          dstRow += footprint.RowPitch;
+        }
+      }
+
+      dstSlice += dstSlicePitch;
+    }
+  }
+}
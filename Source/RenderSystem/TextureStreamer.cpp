@@ -0,0 +1,832 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Asynchronous texture streamer (Device independent)
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add mip streaming with residency budget
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/TextureStreamer.h>
+#include <RenderSystem/TextureFootprint.h>
+#include <Interfaces/ITextureDecoder.h>
+#include <Interfaces/ITextureUploadBackend.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  const std::string EMPTY_STRING = "";
+  constexpr uint32_t DEFAULT_TAIL_MIP_SIZE = 64;
+  constexpr uint32_t DEFAULT_MAX_MIP_STREAM_IN_PER_UPDATE = 4;
+
+  uint64_t alignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  uint32_t getArraySize(const MFramework::TextureDesc& desc)
+  {
+    return (desc.Dimension == MFramework::TEXTURE_DIMENSION_TEXTURE3D) ? 1 : desc.DepthOrArraySize;
+  }
+
+  bool queueLess(float lhsPriority, uint32_t lhsSequence, float rhsPriority, uint32_t rhsSequence)
+  {
+    // 優先度が同じなら先に要求した方を先にする
+    if (lhsPriority != rhsPriority)
+    {
+      return lhsPriority < rhsPriority;
+    }
+
+    return lhsSequence > rhsSequence;
+  }
+
+  /// @brief
+  /// デコード結果のサブリソースがピクセルの範囲に収まっているか
+  bool validateData(const MFramework::TextureData& data, std::string& outError)
+  {
+    std::vector<MFramework::SubresourceFootprint> footprints;
+    if (!MFramework::TextureFootprint::Compute(data.Desc, footprints))
+    {
+      outError = "unsupported texture description";
+      return false;
+    }
+
+    if (data.Subresources.size() != footprints.size())
+    {
+      outError = "subresource count mismatch";
+      return false;
+    }
+
+    for (size_t i = 0; i < footprints.size(); ++i)
+    {
+      const MFramework::SubresourceFootprint& footprint = footprints[i];
+      const MFramework::SubresourceData& subresource = data.Subresources[i];
+      if (subresource.RowPitch < footprint.RowSizeInBytes)
+      {
+        outError = "row pitch is smaller than row size";
+        return false;
+      }
+
+      const uint64_t lastByte = subresource.Offset
+                              + subresource.SlicePitch * (footprint.Depth - 1)
+                              + subresource.RowPitch * (footprint.NumRows - 1)
+                              + footprint.RowSizeInBytes;
+      if (lastByte > data.Pixels.size())
+      {
+        outError = "subresource is out of pixel data";
+        return false;
+      }
+    }
+
+    return true;
+  }
+}
+
+namespace MFramework
+{
+  TextureStreamer::TextureStreamer()
+    : m_desc()
+    , m_decoder(nullptr)
+    , m_backend(nullptr)
+    , m_threadPool(nullptr)
+    , m_ring()
+    , m_entries()
+    , m_pathToIndex()
+    , m_queue()
+    , m_sequence(0)
+    , m_decoded()
+    , m_uploading()
+    , m_recordedUploads()
+    , m_recordedMipChanges()
+    , m_recordedBytes(0)
+    , m_residency()
+    , m_mipActions()
+    , m_mipChanging()
+    , m_retiredTextures()
+    , m_frameIndex(0)
+    , m_decodesInFlight(0)
+    , m_completedDecodes()
+    , m_runningDecodeCount(0)
+    , m_completedMutex()
+    , m_completedCondition()
+    , m_placeholder(0)
+    , m_onResident()
+    , m_stats()
+  { }
+
+  TextureStreamer::~TextureStreamer()
+  {
+    Dispose();
+  }
+
+  bool TextureStreamer::Init(const TextureStreamerDesc& desc, ITextureDecoder* decoder, ITextureUploadBackend* backend, ThreadPool* threadPool)
+  {
+    if (decoder == nullptr || backend == nullptr)
+    {
+      return false;
+    }
+
+    if (backend->GetStagingMemory() == nullptr || !m_ring.Init(backend->GetStagingCapacity()))
+    {
+      return false;
+    }
+
+    m_desc = desc;
+    if (m_desc.MaxDecodesInFlight == 0)
+    {
+      m_desc.MaxDecodesInFlight = (threadPool != nullptr) ? std::max<uint32_t>(threadPool->GetThreadCount() * 2, 1) : 1;
+    }
+
+    if (m_desc.ResidencyBudgetBytes != 0)
+    {
+      if (m_desc.TailMipSize == 0)
+      {
+        m_desc.TailMipSize = DEFAULT_TAIL_MIP_SIZE;
+      }
+      if (m_desc.MaxMipStreamInPerUpdate == 0)
+      {
+        m_desc.MaxMipStreamInPerUpdate = DEFAULT_MAX_MIP_STREAM_IN_PER_UPDATE;
+      }
+      m_residency.Init(m_desc.ResidencyBudgetBytes, m_desc.MaxMipStreamInPerUpdate);
+    }
+
+    m_decoder = decoder;
+    m_backend = backend;
+    m_threadPool = threadPool;
+    m_stats = TextureStreamerStats{};
+    return true;
+  }
+
+  bool TextureStreamer::CreatePlaceholder(const TextureData& data)
+  {
+    if (m_backend == nullptr || m_placeholder != 0)
+    {
+      return false;
+    }
+
+    std::string error;
+    if (!validateData(data, error))
+    {
+      return false;
+    }
+
+    const uint64_t totalBytes = computeStagingSize(data, 0, data.Desc.MipLevels, 0);
+    const uint64_t stagingOffset = m_ring.Allocate(totalBytes, TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    if (stagingOffset == StagingRing::INVALID_OFFSET)
+    {
+      return false;
+    }
+
+    const uint64_t texture = m_backend->CreateTexture(data.Desc);
+    if (texture == 0)
+    {
+      m_ring.Commit(0);
+      return false;
+    }
+
+    stageMips(data, 0, data.Desc.MipLevels, texture, 0, stagingOffset);
+    m_ring.Commit(m_backend->Submit());
+    ++m_stats.SubmitCount;
+
+    m_placeholder = texture;
+    return true;
+  }
+
+  StreamingTextureHandle TextureStreamer::Request(const std::string& path, float priority)
+  {
+    if (m_decoder == nullptr || path.empty())
+    {
+      return StreamingTextureHandle();
+    }
+
+    const auto it = m_pathToIndex.find(path);
+    if (it != m_pathToIndex.end())
+    {
+      const StreamingTextureHandle handle(it->second);
+      if (priority > m_entries[it->second].Priority)
+      {
+        SetPriority(handle, priority);
+      }
+      return handle;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_entries.size());
+
+    Entry entry{};
+    entry.Path = path;
+    entry.Priority = priority;
+    entry.State = TextureStreamingState::Queued;
+    m_entries.emplace_back(std::move(entry));
+    m_pathToIndex.emplace(path, index);
+
+    pushQueue(index);
+    return StreamingTextureHandle(index);
+  }
+
+  void TextureStreamer::SetPriority(StreamingTextureHandle handle, float priority)
+  {
+    if (!handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return;
+    }
+
+    Entry& entry = m_entries[handle.Index];
+    if (entry.Priority == priority)
+    {
+      return;
+    }
+
+    entry.Priority = priority;
+
+    // キューの古い要素は取り出し時に優先度の不一致で捨てられる
+    if (entry.State == TextureStreamingState::Queued)
+    {
+      pushQueue(handle.Index);
+    }
+  }
+
+  void TextureStreamer::ReportScreenSize(StreamingTextureHandle handle, float screenSize)
+  {
+    if (!IsMipStreamingEnabled() || !handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return;
+    }
+
+    const Entry& entry = m_entries[handle.Index];
+    if (entry.State != TextureStreamingState::Resident || entry.Data == nullptr)
+    {
+      return;
+    }
+
+    m_residency.Request(handle.Index, MipResidency::ComputeWantedMip(entry.Data->Desc, screenSize), m_frameIndex);
+  }
+
+  void TextureStreamer::SetResidentCallback(ResidentFunc onResident)
+  {
+    m_onResident = std::move(onResident);
+  }
+
+  void TextureStreamer::Update()
+  {
+    if (m_backend == nullptr)
+    {
+      return;
+    }
+
+    ++m_frameIndex;
+
+    retireUploads();
+    dispatchDecodes();
+    collectDecodes();
+
+    m_recordedBytes = 0;
+    uploadDecoded();
+    streamMips();
+    submitUploads();
+  }
+
+  TextureStreamingState TextureStreamer::GetState(StreamingTextureHandle handle) const
+  {
+    if (!handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return TextureStreamingState::Failed;
+    }
+
+    return m_entries[handle.Index].State;
+  }
+
+  uint64_t TextureStreamer::GetTexture(StreamingTextureHandle handle) const
+  {
+    if (!handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return m_placeholder;
+    }
+
+    const Entry& entry = m_entries[handle.Index];
+    return (entry.State == TextureStreamingState::Resident) ? entry.Texture : m_placeholder;
+  }
+
+  const std::string& TextureStreamer::GetError(StreamingTextureHandle handle) const
+  {
+    if (!handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return EMPTY_STRING;
+    }
+
+    return m_entries[handle.Index].Error;
+  }
+
+  uint32_t TextureStreamer::GetResidentMip(StreamingTextureHandle handle) const
+  {
+    if (!handle.IsValid() || handle.Index >= m_entries.size())
+    {
+      return 0;
+    }
+
+    return m_entries[handle.Index].ResidentMip;
+  }
+
+  bool TextureStreamer::IsIdle() const
+  {
+    for (const Entry& entry : m_entries)
+    {
+      if (entry.State != TextureStreamingState::Resident && entry.State != TextureStreamingState::Failed)
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void TextureStreamer::pushQueue(uint32_t index)
+  {
+    m_queue.emplace_back(QueueItem{ m_entries[index].Priority, m_sequence++, index });
+    std::push_heap(m_queue.begin(), m_queue.end(),
+                  [](const QueueItem& lhs, const QueueItem& rhs)
+                  {
+                    return queueLess(lhs.Priority, lhs.Sequence, rhs.Priority, rhs.Sequence);
+                  });
+  }
+
+  void TextureStreamer::retireUploads()
+  {
+    const uint64_t completedValue = m_backend->GetCompletedFenceValue();
+    m_ring.Release(completedValue);
+
+    // 差し替え前のテクスチャはGPUが使い終わってから破棄する
+    size_t writeIndex = 0;
+    for (const RetiredTexture& retired : m_retiredTextures)
+    {
+      if (retired.FenceValue > completedValue)
+      {
+        m_retiredTextures[writeIndex++] = retired;
+        continue;
+      }
+      m_backend->DestroyTexture(retired.Texture);
+    }
+    m_retiredTextures.resize(writeIndex);
+
+    writeIndex = 0;
+    for (const uint32_t index : m_uploading)
+    {
+      Entry& entry = m_entries[index];
+      if (entry.UploadFenceValue > completedValue)
+      {
+        m_uploading[writeIndex++] = index;
+        continue;
+      }
+
+      entry.State = TextureStreamingState::Resident;
+      if (IsMipStreamingEnabled())
+      {
+        const uint32_t tailMip = MipResidency::ComputeTailMip(entry.Data->Desc, m_desc.TailMipSize);
+        m_residency.Register(index, entry.Data->Desc, tailMip, entry.ResidentMip);
+      }
+
+      if (m_onResident)
+      {
+        m_onResident(StreamingTextureHandle(index), entry.Texture);
+      }
+    }
+    m_uploading.resize(writeIndex);
+
+    writeIndex = 0;
+    for (const uint32_t index : m_mipChanging)
+    {
+      Entry& entry = m_entries[index];
+      if (entry.UploadFenceValue > completedValue)
+      {
+        m_mipChanging[writeIndex++] = index;
+        continue;
+      }
+
+      // 今までに記録された描画は古いテクスチャを参照している可能性がある
+      m_retiredTextures.emplace_back(RetiredTexture{ entry.Texture, m_backend->GetSubmittedFenceValue() });
+
+      entry.Texture = entry.PendingTexture;
+      entry.ResidentMip = entry.PendingMip;
+      entry.PendingTexture = 0;
+      m_residency.SetResidentMip(index, entry.ResidentMip);
+
+      if (m_onResident)
+      {
+        m_onResident(StreamingTextureHandle(index), entry.Texture);
+      }
+    }
+    m_mipChanging.resize(writeIndex);
+  }
+
+  void TextureStreamer::dispatchDecodes()
+  {
+    const auto less = [](const QueueItem& lhs, const QueueItem& rhs)
+                      {
+                        return queueLess(lhs.Priority, lhs.Sequence, rhs.Priority, rhs.Sequence);
+                      };
+
+    while (m_decodesInFlight < m_desc.MaxDecodesInFlight && !m_queue.empty())
+    {
+      std::pop_heap(m_queue.begin(), m_queue.end(), less);
+      const QueueItem item = m_queue.back();
+      m_queue.pop_back();
+
+      Entry& entry = m_entries[item.Index];
+      // 優先度変更前の古い要素、またはすでに発行済み
+      if (entry.State != TextureStreamingState::Queued || entry.Priority != item.Priority)
+      {
+        continue;
+      }
+
+      entry.State = TextureStreamingState::Decoding;
+      ++m_decodesInFlight;
+
+      if (m_threadPool == nullptr)
+      {
+        DecodeResult result = decode(item.Index, entry.Path);
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        m_completedDecodes.emplace_back(std::move(result));
+        continue;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(m_completedMutex);
+        ++m_runningDecodeCount;
+      }
+
+      // エントリの配列は再確保されることがあるため、パスはコピーして渡す
+      const uint32_t index = item.Index;
+      m_threadPool->Submit(
+                            [this, index, path = entry.Path]()
+                            {
+                              DecodeResult result = decode(index, path);
+
+                              std::lock_guard<std::mutex> lock(m_completedMutex);
+                              m_completedDecodes.emplace_back(std::move(result));
+                              --m_runningDecodeCount;
+                              m_completedCondition.notify_all();
+                            }
+                          );
+    }
+  }
+
+  void TextureStreamer::collectDecodes()
+  {
+    std::vector<DecodeResult> results;
+    {
+      std::lock_guard<std::mutex> lock(m_completedMutex);
+      results.swap(m_completedDecodes);
+    }
+
+    for (DecodeResult& result : results)
+    {
+      --m_decodesInFlight;
+
+      if (result.Data == nullptr)
+      {
+        fail(result.Index, result.Error);
+        continue;
+      }
+
+      Entry& entry = m_entries[result.Index];
+      entry.Data = std::move(result.Data);
+      entry.State = TextureStreamingState::Decoded;
+      m_decoded.emplace_back(result.Index);
+      ++m_stats.DecodedCount;
+    }
+  }
+
+  void TextureStreamer::uploadDecoded()
+  {
+    if (m_decoded.empty())
+    {
+      return;
+    }
+
+    // 優先度の高い順にアップロードする
+    std::stable_sort(m_decoded.begin(), m_decoded.end(),
+                    [this](uint32_t lhs, uint32_t rhs)
+                    {
+                      return m_entries[lhs].Priority > m_entries[rhs].Priority;
+                    });
+
+    size_t processed = 0;
+    for (; processed < m_decoded.size(); ++processed)
+    {
+      const uint32_t index = m_decoded[processed];
+      Entry& entry = m_entries[index];
+      const TextureData& data = *entry.Data;
+
+      // ミップストリーミング中はテールミップだけを最初にアップロードする
+      const uint32_t firstMip = IsMipStreamingEnabled() ? MipResidency::ComputeTailMip(data.Desc, m_desc.TailMipSize) : 0;
+      const uint64_t totalBytes = computeStagingSize(data, firstMip, data.Desc.MipLevels, firstMip);
+
+      if (totalBytes > m_ring.GetCapacity())
+      {
+        fail(index, "texture is larger than the staging ring");
+        continue;
+      }
+
+      // 上限を超えたら次のUpdateに回す(一枚目は必ず通す)
+      if (m_recordedBytes > 0 && m_recordedBytes + totalBytes > m_desc.MaxUploadBytesPerUpdate)
+      {
+        break;
+      }
+
+      // リングが空くまで待つ(優先度順を守るため、後ろの小さいテクスチャで追い越さない)
+      const uint64_t stagingOffset = m_ring.Allocate(totalBytes, TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+      if (stagingOffset == StagingRing::INVALID_OFFSET)
+      {
+        break;
+      }
+
+      const uint64_t texture = m_backend->CreateTexture(TextureFootprint::GetMipDesc(data.Desc, firstMip));
+      if (texture == 0)
+      {
+        // 確保した領域は次のCommitで一緒に返す
+        fail(index, "failed to create texture");
+        continue;
+      }
+
+      stageMips(data, firstMip, data.Desc.MipLevels, texture, firstMip, stagingOffset);
+
+      entry.Texture = texture;
+      entry.ResidentMip = firstMip;
+      entry.State = TextureStreamingState::Uploading;
+      if (!IsMipStreamingEnabled())
+      {
+        entry.Data.reset();
+      }
+      m_recordedUploads.emplace_back(index);
+
+      m_recordedBytes += totalBytes;
+    }
+
+    m_decoded.erase(m_decoded.begin(), m_decoded.begin() + processed);
+  }
+
+  void TextureStreamer::streamMips()
+  {
+    if (!IsMipStreamingEnabled())
+    {
+      return;
+    }
+
+    m_residency.Plan(m_mipActions);
+    for (const MipResidencyAction& action : m_mipActions)
+    {
+      if (!changeResidentMip(action.ID, action.TargetMip))
+      {
+        m_residency.CancelPending(action.ID);
+      }
+    }
+  }
+
+  bool TextureStreamer::changeResidentMip(uint32_t index, uint32_t targetMip)
+  {
+    Entry& entry = m_entries[index];
+    if (entry.State != TextureStreamingState::Resident || entry.Data == nullptr || entry.PendingTexture != 0)
+    {
+      return false;
+    }
+
+    const TextureData& data = *entry.Data;
+    const uint32_t residentMip = entry.ResidentMip;
+    const uint32_t mipLevels = data.Desc.MipLevels;
+    if (targetMip == residentMip || targetMip >= mipLevels)
+    {
+      return false;
+    }
+
+    // 細かくする場合は足りないミップをリングからアップロードする
+    if (targetMip < residentMip)
+    {
+      const uint64_t totalBytes = computeStagingSize(data, targetMip, residentMip, targetMip);
+      if (m_recordedBytes > 0 && m_recordedBytes + totalBytes > m_desc.MaxUploadBytesPerUpdate)
+      {
+        return false;
+      }
+
+      const uint64_t stagingOffset = m_ring.Allocate(totalBytes, TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+      if (stagingOffset == StagingRing::INVALID_OFFSET)
+      {
+        return false;
+      }
+
+      entry.PendingTexture = m_backend->CreateTexture(TextureFootprint::GetMipDesc(data.Desc, targetMip));
+      if (entry.PendingTexture == 0)
+      {
+        return false;
+      }
+
+      stageMips(data, targetMip, residentMip, entry.PendingTexture, targetMip, stagingOffset);
+      m_recordedBytes += totalBytes;
+      ++m_stats.MipStreamInCount;
+    }
+    else
+    {
+      entry.PendingTexture = m_backend->CreateTexture(TextureFootprint::GetMipDesc(data.Desc, targetMip));
+      if (entry.PendingTexture == 0)
+      {
+        return false;
+      }
+      ++m_stats.MipEvictionCount;
+    }
+
+    // 両方にあるミップはGPU上でコピーする
+    const uint32_t keepFirstMip = std::max(targetMip, residentMip);
+    const uint32_t oldMipLevels = mipLevels - residentMip;
+    const uint32_t newMipLevels = mipLevels - targetMip;
+    const uint32_t arraySize = getArraySize(data.Desc);
+    for (uint32_t slice = 0; slice < arraySize; ++slice)
+    {
+      for (uint32_t mip = keepFirstMip; mip < mipLevels; ++mip)
+      {
+        m_backend->CopyTextureSubresource(
+                                          entry.PendingTexture, (mip - targetMip) + slice * newMipLevels,
+                                          entry.Texture, (mip - residentMip) + slice * oldMipLevels
+                                        );
+      }
+    }
+
+    entry.PendingMip = targetMip;
+    m_recordedMipChanges.emplace_back(index);
+    return true;
+  }
+
+  void TextureStreamer::submitUploads()
+  {
+    if (m_recordedUploads.empty() && m_recordedMipChanges.empty())
+    {
+      // 失敗したテクスチャの領域だけが残っている場合は完了済みの値で返す
+      m_ring.Commit(m_backend->GetCompletedFenceValue());
+      return;
+    }
+
+    // 一回のサブミットにまとめる
+    const uint64_t fenceValue = m_backend->Submit();
+    m_ring.Commit(fenceValue);
+    ++m_stats.SubmitCount;
+
+    for (const uint32_t index : m_recordedUploads)
+    {
+      m_entries[index].UploadFenceValue = fenceValue;
+      m_uploading.emplace_back(index);
+    }
+
+    for (const uint32_t index : m_recordedMipChanges)
+    {
+      m_entries[index].UploadFenceValue = fenceValue;
+      m_mipChanging.emplace_back(index);
+    }
+
+    m_stats.UploadedCount += m_recordedUploads.size();
+    m_stats.UploadedBytes += m_recordedBytes;
+
+    m_recordedUploads.clear();
+    m_recordedMipChanges.clear();
+  }
+
+  uint64_t TextureStreamer::computeStagingSize(const TextureData& data, uint32_t firstMip, uint32_t endMip, uint32_t textureFirstMip) const
+  {
+    const TextureDesc textureDesc = TextureFootprint::GetMipDesc(data.Desc, textureFirstMip);
+    const uint32_t arraySize = getArraySize(data.Desc);
+
+    // 配列の要素ごとに連続したサブリソースを512アラインメントで並べる
+    uint64_t totalBytes = 0;
+    std::vector<SubresourceFootprint> footprints;
+    for (uint32_t slice = 0; slice < arraySize; ++slice)
+    {
+      uint64_t sliceBytes = 0;
+      TextureFootprint::Compute(textureDesc, (firstMip - textureFirstMip) + slice * textureDesc.MipLevels, endMip - firstMip, 0, footprints, &sliceBytes);
+      totalBytes = alignUp(totalBytes, TEXTURE_DATA_PLACEMENT_ALIGNMENT) + sliceBytes;
+    }
+
+    return totalBytes;
+  }
+
+  void TextureStreamer::stageMips(const TextureData& data, uint32_t firstMip, uint32_t endMip, uint64_t texture, uint32_t textureFirstMip, uint64_t stagingOffset) const
+  {
+    const TextureDesc textureDesc = TextureFootprint::GetMipDesc(data.Desc, textureFirstMip);
+    const uint32_t arraySize = getArraySize(data.Desc);
+    const uint32_t mipCount = endMip - firstMip;
+
+    uint8_t* staging = m_backend->GetStagingMemory();
+    std::vector<SubresourceFootprint> footprints;
+    uint64_t offset = stagingOffset;
+    for (uint32_t slice = 0; slice < arraySize; ++slice)
+    {
+      const uint32_t firstSubresource = (firstMip - textureFirstMip) + slice * textureDesc.MipLevels;
+      uint64_t sliceBytes = 0;
+      offset = alignUp(offset, TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+      TextureFootprint::Compute(textureDesc, firstSubresource, mipCount, offset, footprints, &sliceBytes);
+
+      for (uint32_t i = 0; i < mipCount; ++i)
+      {
+        const SubresourceData& subresource = data.Subresources[(firstMip + i) + slice * data.Desc.MipLevels];
+        TextureFootprint::CopySubresource(staging, footprints[i], data.Pixels.data() + subresource.Offset, subresource.RowPitch, subresource.SlicePitch);
+        m_backend->CopyToTexture(texture, firstSubresource + i, footprints[i]);
+      }
+
+      offset += sliceBytes;
+    }
+  }
+
+  void TextureStreamer::fail(uint32_t index, const std::string& error)
+  {
+    Entry& entry = m_entries[index];
+    entry.State = TextureStreamingState::Failed;
+    entry.Data.reset();
+    entry.Error = error;
+    ++m_stats.FailedCount;
+  }
+
+  TextureStreamer::DecodeResult TextureStreamer::decode(uint32_t index, const std::string& path) const
+  {
+    DecodeResult result{};
+    result.Index = index;
+
+    std::unique_ptr<TextureData> data = std::make_unique<TextureData>();
+    if (!m_decoder->Decode(path, *data, result.Error))
+    {
+      if (result.Error.empty())
+      {
+        result.Error = "failed to decode " + path;
+      }
+      return result;
+    }
+
+    if (!validateData(*data, result.Error))
+    {
+      return result;
+    }
+
+    result.Data = std::move(data);
+    return result;
+  }
+
+  void TextureStreamer::Dispose() noexcept
+  {
+    // ワーカーが結果を書き込む前に破棄しない
+    {
+      std::unique_lock<std::mutex> lock(m_completedMutex);
+      m_completedCondition.wait(lock, [this]() { return m_runningDecodeCount == 0; });
+      m_completedDecodes.clear();
+    }
+
+    if (m_backend != nullptr)
+    {
+      for (const Entry& entry : m_entries)
+      {
+        if (entry.Texture != 0)
+        {
+          m_backend->DestroyTexture(entry.Texture);
+        }
+        if (entry.PendingTexture != 0)
+        {
+          m_backend->DestroyTexture(entry.PendingTexture);
+        }
+      }
+
+      for (const RetiredTexture& retired : m_retiredTextures)
+      {
+        m_backend->DestroyTexture(retired.Texture);
+      }
+
+      if (m_placeholder != 0)
+      {
+        m_backend->DestroyTexture(m_placeholder);
+      }
+    }
+
+    m_entries.clear();
+    m_pathToIndex.clear();
+    m_queue.clear();
+    m_decoded.clear();
+    m_uploading.clear();
+    m_recordedUploads.clear();
+    m_recordedMipChanges.clear();
+    m_recordedBytes = 0;
+    m_residency.Dispose();
+    m_mipActions.clear();
+    m_mipChanging.clear();
+    m_retiredTextures.clear();
+    m_frameIndex = 0;
+    m_decodesInFlight = 0;
+    m_placeholder = 0;
+    m_ring.Dispose();
+    m_onResident = nullptr;
+    m_decoder = nullptr;
+    m_backend = nullptr;
+    m_threadPool = nullptr;
+  }
+}
@@ -0,0 +1,168 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Vertex format description (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/VertexFormat.h>
+
+namespace
+{
+  // DXGI_FORMATの値(dxgiformat.hを読み込まないため)
+  constexpr uint32_t DXGI_FORMAT_UNKNOWN_VALUE = 0;
+  constexpr uint32_t DXGI_FORMAT_R32G32B32_FLOAT_VALUE = 6;
+  constexpr uint32_t DXGI_FORMAT_R16G16B16A16_UNORM_VALUE = 11;
+  constexpr uint32_t DXGI_FORMAT_R32G32_FLOAT_VALUE = 16;
+  constexpr uint32_t DXGI_FORMAT_R16G16_FLOAT_VALUE = 34;
+  constexpr uint32_t DXGI_FORMAT_R16G16_SNORM_VALUE = 37;
+
+  bool isFormatAllowed(MFramework::VertexSemantic semantic, MFramework::VertexElementFormat format)
+  {
+    using MFramework::VertexElementFormat;
+    using MFramework::VertexSemantic;
+
+    switch (semantic)
+    {
+      case VertexSemantic::Position:
+        return format == VertexElementFormat::Float3 || format == VertexElementFormat::UNorm16x4;
+      case VertexSemantic::Normal:
+        return format == VertexElementFormat::Float3 || format == VertexElementFormat::OctahedralSNorm16x2;
+      case VertexSemantic::TexCoord:
+        return format == VertexElementFormat::Float2 || format == VertexElementFormat::Half2;
+    }
+
+    return false;
+  }
+}
+
+namespace MFramework
+{
+  bool VertexFormat::CreateLayout(const VertexFormatDesc& desc, VertexLayout& outLayout, std::string& outError)
+  {
+    const VertexElementFormat formats[VERTEX_SEMANTIC_COUNT] = { desc.Position, desc.Normal, desc.TexCoord };
+
+    VertexLayout layout{};
+    layout.Desc = desc;
+    for (uint32_t i = 0; i < VERTEX_SEMANTIC_COUNT; ++i)
+    {
+      const VertexSemantic semantic = static_cast<VertexSemantic>(i);
+      if (formats[i] == VertexElementFormat::None)
+      {
+        continue;
+      }
+
+      if (!isFormatAllowed(semantic, formats[i]))
+      {
+        outError = std::string(GetFormatName(formats[i])) + " cannot be used for " + GetSemanticName(semantic);
+        return false;
+      }
+
+      // どの要素も4バイトの倍数なので詰めても入力レイアウトの配置の制約を満たす
+      layout.Elements[layout.ElementCount] = VertexElement{ semantic, formats[i], layout.Stride };
+      ++layout.ElementCount;
+      layout.Stride += GetElementSize(formats[i]);
+    }
+
+    if (desc.Position == VertexElementFormat::None)
+    {
+      outError = "vertex format must have a position";
+      return false;
+    }
+
+    outLayout = layout;
+    return true;
+  }
+
+  uint32_t VertexFormat::GetElementSize(VertexElementFormat format)
+  {
+    switch (format)
+    {
+      case VertexElementFormat::Float2:
+        return sizeof(float) * 2;
+      case VertexElementFormat::Float3:
+        return sizeof(float) * 3;
+      case VertexElementFormat::Half2:
+      case VertexElementFormat::OctahedralSNorm16x2:
+        return sizeof(uint16_t) * 2;
+      case VertexElementFormat::UNorm16x4:
+        return sizeof(uint16_t) * 4;
+      default:
+        return 0;
+    }
+  }
+
+  uint32_t VertexFormat::GetDxgiFormat(VertexElementFormat format)
+  {
+    switch (format)
+    {
+      case VertexElementFormat::Float2:
+        return DXGI_FORMAT_R32G32_FLOAT_VALUE;
+      case VertexElementFormat::Float3:
+        return DXGI_FORMAT_R32G32B32_FLOAT_VALUE;
+      case VertexElementFormat::Half2:
+        return DXGI_FORMAT_R16G16_FLOAT_VALUE;
+      case VertexElementFormat::UNorm16x4:
+        return DXGI_FORMAT_R16G16B16A16_UNORM_VALUE;
+      case VertexElementFormat::OctahedralSNorm16x2:
+        return DXGI_FORMAT_R16G16_SNORM_VALUE;
+      default:
+        return DXGI_FORMAT_UNKNOWN_VALUE;
+    }
+  }
+
+  const char* VertexFormat::GetSemanticName(VertexSemantic semantic)
+  {
+    switch (semantic)
+    {
+      case VertexSemantic::Position:
+        return "POSITION";
+      case VertexSemantic::Normal:
+        return "NORMAL";
+      case VertexSemantic::TexCoord:
+        return "TEXCOORD";
+    }
+
+    return "";
+  }
+
+  const char* VertexFormat::GetFormatName(VertexElementFormat format)
+  {
+    switch (format)
+    {
+      case VertexElementFormat::None:
+        return "none";
+      case VertexElementFormat::Float2:
+        return "float2";
+      case VertexElementFormat::Float3:
+        return "float3";
+      case VertexElementFormat::Half2:
+        return "half2";
+      case VertexElementFormat::UNorm16x4:
+        return "unorm16x4";
+      case VertexElementFormat::OctahedralSNorm16x2:
+        return "oct16";
+    }
+
+    return "unknown";
+  }
+
+  const VertexElement* VertexFormat::FindElement(const VertexLayout& layout, VertexSemantic semantic)
+  {
+    for (uint32_t i = 0; i < layout.ElementCount; ++i)
+    {
+      if (layout.Elements[i].Semantic == semantic)
+        return &layout.Elements[i];
+    }
+
+    return nullptr;
+  }
+}
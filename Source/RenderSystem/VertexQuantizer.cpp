@@ -0,0 +1,569 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Vertex attribute quantization (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RenderSystem/VertexQuantizer.h>
+
+#include <HalfUtil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// x64ではSSE2が必ず使える
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+  #define M_VERTEX_QUANTIZER_USE_SSE 1
+  #include <emmintrin.h>
+#else
+  #define M_VERTEX_QUANTIZER_USE_SSE 0
+#endif
+
+namespace
+{
+  constexpr float UNORM16_MAX = 65535.0f;
+  constexpr float SNORM16_MAX = 32767.0f;
+  constexpr float RADIAN_TO_DEGREE = 57.29577951308232f;
+
+  // SIMD版とスカラー版は同じ順序で演算して結果をビット単位で一致させる
+  // 丸めはどちらも最近接偶数(_mm_cvtps_epi32とstd::lrint)
+
+  /// @brief
+  /// 位置の量子化で掛ける係数(大きさ0の軸は0にしてBiasだけで表す)
+  void getEncodeFactors(const MFramework::VertexQuantization& quantization, float outFactors[3])
+  {
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      outFactors[axis] = (quantization.PositionScale[axis] > 0.0f) ? (UNORM16_MAX / quantization.PositionScale[axis]) : 0.0f;
+    }
+  }
+
+  uint16_t encodeUNorm16(float value, float bias, float factor)
+  {
+    return static_cast<uint16_t>(std::lrint(std::clamp((value - bias) * factor, 0.0f, UNORM16_MAX)));
+  }
+
+  float copySign(float value, float signSource)
+  {
+    return std::signbit(signSource) ? -value : value;
+  }
+
+  void encodeOctahedral(const float normal[3], int16_t outEncoded[2])
+  {
+    // L1ノルムで八面体に投影して、下半分は対角線で折り返す
+    const float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    const float inverseLength = (length > 0.0f) ? (1.0f / length) : 0.0f;
+    float x = normal[0] * inverseLength;
+    float y = normal[1] * inverseLength;
+    if (normal[2] < 0.0f)
+    {
+      const float foldedX = (1.0f - std::fabs(y)) * copySign(1.0f, x);
+      const float foldedY = (1.0f - std::fabs(x)) * copySign(1.0f, y);
+      x = foldedX;
+      y = foldedY;
+    }
+
+    outEncoded[0] = static_cast<int16_t>(std::lrint(x * SNORM16_MAX));
+    outEncoded[1] = static_cast<int16_t>(std::lrint(y * SNORM16_MAX));
+  }
+
+  void decodeOctahedral(const int16_t encoded[2], float outNormal[3])
+  {
+    // SNORMは-32768も-1になる
+    float x = std::max(static_cast<float>(encoded[0]) * (1.0f / SNORM16_MAX), -1.0f);
+    float y = std::max(static_cast<float>(encoded[1]) * (1.0f / SNORM16_MAX), -1.0f);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    const float t = std::max(-z, 0.0f);
+    x += (x >= 0.0f) ? -t : t;
+    y += (y >= 0.0f) ? -t : t;
+
+    const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+    outNormal[0] = x * inverseLength;
+    outNormal[1] = y * inverseLength;
+    outNormal[2] = z * inverseLength;
+  }
+
+  const float* getAttribute(const MFramework::MeshVertex& vertex, MFramework::VertexSemantic semantic)
+  {
+    switch (semantic)
+    {
+      case MFramework::VertexSemantic::Position:
+        return vertex.Position;
+      case MFramework::VertexSemantic::Normal:
+        return vertex.Normal;
+      default:
+        return vertex.TexCoord;
+    }
+  }
+
+  float* getAttribute(MFramework::MeshVertex& vertex, MFramework::VertexSemantic semantic)
+  {
+    return const_cast<float*>(getAttribute(static_cast<const MFramework::MeshVertex&>(vertex), semantic));
+  }
+
+#if M_VERTEX_QUANTIZER_USE_SSE
+  // 半精度変換(F16Cを前提にしないためSSE2の整数演算で行う、HalfUtilityと同じ結果になる)
+  __m128i floatToHalf4(__m128 value)
+  {
+    const __m128i signMask = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i infinityLimit = _mm_set1_epi32((127 + 16) << 23);                       // これ以上は無限大(丸めで溢れる分は正規化数の経路で無限大になる)
+    const __m128i normalLimit = _mm_set1_epi32((127 - 14) << 23);                         // これ未満は非正規化数
+    const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);    // 足すと仮数の下位に半精度の非正規化数が丸められて入る
+    const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));                // 指数の付け替えと丸めの0.5
+
+    const __m128 sign = _mm_and_ps(value, _mm_castsi128_ps(signMask));
+    const __m128 absValue = _mm_xor_ps(value, sign);
+    const __m128i absBits = _mm_castps_si128(absValue);
+
+    const __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+    const __m128i isFinite = _mm_cmpgt_epi32(infinityLimit, absBits);
+    const __m128i isSubnormal = _mm_cmpgt_epi32(normalLimit, absBits);
+    const __m128i special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x0200)), _mm_set1_epi32(0x7c00));
+
+    const __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+    // 仮数の最下位bitが奇数なら丸めを1足して最近接偶数にする
+    const __m128i isOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+    const __m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), isOdd), 13);
+
+    const __m128i finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+    const __m128i result = _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, special));
+    return _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+  }
+
+  __m128 halfToFloat4(__m128i half)
+  {
+    const __m128i exponentMantissa = _mm_and_si128(half, _mm_set1_epi32(0x7fff));
+    const __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, exponentMantissa), 16);
+
+    // 指数の差を掛け算で補正すると非正規化数もそのまま正規化される
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), magic);
+
+    const __m128i isInfinityOrNaN = _mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7bff));
+    const __m128 infinityExponent = _mm_and_ps(_mm_castsi128_ps(isInfinityOrNaN), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+    return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infinityExponent));
+  }
+
+  /// @brief
+  /// 0～65535の32bit整数を16bitに詰める(packs_epi32は符号付きなので0x8000ずらしてから詰める)
+  __m128i packUnsigned16(__m128i low, __m128i high)
+  {
+    const __m128i offset32 = _mm_set1_epi32(0x8000);
+    const __m128i offset16 = _mm_set1_epi16(static_cast<short>(0x8000));
+    return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(low, offset32), _mm_sub_epi32(high, offset32)), offset16);
+  }
+
+  /// @brief
+  /// 4頂点分の32bit値を頂点ごとに書き出す
+  void store32x4(__m128i values, uint8_t* outVertices, size_t stride)
+  {
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+      const int value = _mm_cvtsi128_si32(values);
+      std::memcpy(outVertices + i * stride, &value, sizeof(value));
+      values = _mm_srli_si128(values, 4);
+    }
+  }
+
+  __m128i load32(const uint8_t* data)
+  {
+    int value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return _mm_cvtsi32_si128(value);
+  }
+
+  __m128i load32x4(const uint8_t* vertices, size_t stride)
+  {
+    const __m128i v01 = _mm_unpacklo_epi32(load32(vertices), load32(vertices + stride));
+    const __m128i v23 = _mm_unpacklo_epi32(load32(vertices + stride * 2), load32(vertices + stride * 3));
+    return _mm_unpacklo_epi64(v01, v23);
+  }
+
+  __m128 copySign4(__m128 value, __m128 signSource)
+  {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    return _mm_or_ps(_mm_andnot_ps(signMask, value), _mm_and_ps(signMask, signSource));
+  }
+
+  __m128 abs4(__m128 value)
+  {
+    return _mm_and_ps(value, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+  }
+#endif
+
+  // SIMD版の戻す処理は4番目のレーン(0)も書き込んで次の属性の先頭を0にする
+  // Decodeは要素をPosition、Normal、TexCoordの順に処理するので、次の属性があれば後で上書きされる
+
+  void encodePositions(const MFramework::MeshVertex* vertices, size_t vertexCount, const MFramework::VertexQuantization& quantization, uint8_t* outVertices, size_t stride)
+  {
+    float factors[3] = {};
+    getEncodeFactors(quantization, factors);
+
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    // 頂点ごとに(x, y, z, nx)を読んで4番目のレーンは係数0で捨てる(NaNもmax_psで0になる)
+    const __m128 bias = _mm_setr_ps(quantization.PositionBias[0], quantization.PositionBias[1], quantization.PositionBias[2], 0.0f);
+    const __m128 factor = _mm_setr_ps(factors[0], factors[1], factors[2], 0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 maxValue = _mm_set1_ps(UNORM16_MAX);
+    for (; i + 2 <= vertexCount; i += 2)
+    {
+      const __m128 p0 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(vertices[i].Position), bias), factor), zero), maxValue);
+      const __m128 p1 = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(vertices[i + 1].Position), bias), factor), zero), maxValue);
+      const __m128i packed = packUnsigned16(_mm_cvtps_epi32(p0), _mm_cvtps_epi32(p1));
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(outVertices + i * stride), packed);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(outVertices + (i + 1) * stride), _mm_srli_si128(packed, 8));
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      const uint16_t encoded[4] =
+      {
+        encodeUNorm16(vertices[i].Position[0], quantization.PositionBias[0], factors[0]),
+        encodeUNorm16(vertices[i].Position[1], quantization.PositionBias[1], factors[1]),
+        encodeUNorm16(vertices[i].Position[2], quantization.PositionBias[2], factors[2]),
+        0,
+      };
+      std::memcpy(outVertices + i * stride, encoded, sizeof(encoded));
+    }
+  }
+
+  void decodePositions(const uint8_t* vertices, size_t vertexCount, const MFramework::VertexQuantization& quantization, MFramework::MeshVertex* outVertices, size_t stride)
+  {
+    float factors[3] = {};
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      factors[axis] = quantization.PositionScale[axis] * (1.0f / UNORM16_MAX);
+    }
+
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    const __m128 bias = _mm_setr_ps(quantization.PositionBias[0], quantization.PositionBias[1], quantization.PositionBias[2], 0.0f);
+    const __m128 factor = _mm_setr_ps(factors[0], factors[1], factors[2], 0.0f);
+    const __m128i zero = _mm_setzero_si128();
+    for (; i < vertexCount; ++i)
+    {
+      const __m128i encoded = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(vertices + i * stride));
+      const __m128 position = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(encoded, zero)), factor), bias);
+      _mm_storeu_ps(outVertices[i].Position, position);
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      uint16_t encoded[4] = {};
+      std::memcpy(encoded, vertices + i * stride, sizeof(encoded));
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        outVertices[i].Position[axis] = static_cast<float>(encoded[axis]) * factors[axis] + quantization.PositionBias[axis];
+      }
+    }
+  }
+
+  void encodeNormals(const MFramework::MeshVertex* vertices, size_t vertexCount, uint8_t* outVertices, size_t stride)
+  {
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    // (nx, ny, nz, u)を4頂点分読んで転置する
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(SNORM16_MAX);
+    for (; i + 4 <= vertexCount; i += 4)
+    {
+      __m128 x = _mm_loadu_ps(vertices[i].Normal);
+      __m128 y = _mm_loadu_ps(vertices[i + 1].Normal);
+      __m128 z = _mm_loadu_ps(vertices[i + 2].Normal);
+      __m128 unused = _mm_loadu_ps(vertices[i + 3].Normal);
+      _MM_TRANSPOSE4_PS(x, y, z, unused);
+
+      const __m128 length = _mm_add_ps(_mm_add_ps(abs4(x), abs4(y)), abs4(z));
+      const __m128 inverseLength = _mm_and_ps(_mm_div_ps(one, length), _mm_cmpgt_ps(length, zero));
+      const __m128 projectedX = _mm_mul_ps(x, inverseLength);
+      const __m128 projectedY = _mm_mul_ps(y, inverseLength);
+
+      const __m128 foldedX = _mm_mul_ps(_mm_sub_ps(one, abs4(projectedY)), copySign4(one, projectedX));
+      const __m128 foldedY = _mm_mul_ps(_mm_sub_ps(one, abs4(projectedX)), copySign4(one, projectedY));
+      const __m128 isLower = _mm_cmplt_ps(z, zero);
+      const __m128 octX = _mm_or_ps(_mm_and_ps(isLower, foldedX), _mm_andnot_ps(isLower, projectedX));
+      const __m128 octY = _mm_or_ps(_mm_and_ps(isLower, foldedY), _mm_andnot_ps(isLower, projectedY));
+
+      // (x0..x3, y0..y3)を(x0, y0, x1, y1, ...)に並べ替える
+      const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(octX, scale)), _mm_cvtps_epi32(_mm_mul_ps(octY, scale)));
+      store32x4(_mm_unpacklo_epi16(packed, _mm_srli_si128(packed, 8)), outVertices + i * stride, stride);
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      int16_t encoded[2] = {};
+      encodeOctahedral(vertices[i].Normal, encoded);
+      std::memcpy(outVertices + i * stride, encoded, sizeof(encoded));
+    }
+  }
+
+  void decodeNormals(const uint8_t* vertices, size_t vertexCount, MFramework::MeshVertex* outVertices, size_t stride)
+  {
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 scale = _mm_set1_ps(1.0f / SNORM16_MAX);
+    for (; i + 4 <= vertexCount; i += 4)
+    {
+      // 下位16bitがx、上位16bitがy
+      const __m128i encoded = load32x4(vertices + i * stride, stride);
+      __m128 x = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(encoded, 16), 16)), scale), minusOne);
+      __m128 y = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(encoded, 16)), scale), minusOne);
+      __m128 z = _mm_sub_ps(_mm_sub_ps(one, abs4(x)), abs4(y));
+
+      const __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+      const __m128 minusT = _mm_sub_ps(zero, t);
+      const __m128 isPositiveX = _mm_cmpge_ps(x, zero);
+      const __m128 isPositiveY = _mm_cmpge_ps(y, zero);
+      x = _mm_add_ps(x, _mm_or_ps(_mm_and_ps(isPositiveX, minusT), _mm_andnot_ps(isPositiveX, t)));
+      y = _mm_add_ps(y, _mm_or_ps(_mm_and_ps(isPositiveY, minusT), _mm_andnot_ps(isPositiveY, t)));
+
+      const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+      const __m128 inverseLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+      x = _mm_mul_ps(x, inverseLength);
+      y = _mm_mul_ps(y, inverseLength);
+      z = _mm_mul_ps(z, inverseLength);
+
+      __m128 w = zero;
+      _MM_TRANSPOSE4_PS(x, y, z, w);
+      _mm_storeu_ps(outVertices[i].Normal, x);
+      _mm_storeu_ps(outVertices[i + 1].Normal, y);
+      _mm_storeu_ps(outVertices[i + 2].Normal, z);
+      _mm_storeu_ps(outVertices[i + 3].Normal, w);
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      int16_t encoded[2] = {};
+      std::memcpy(encoded, vertices + i * stride, sizeof(encoded));
+      decodeOctahedral(encoded, outVertices[i].Normal);
+    }
+  }
+
+  void encodeTexCoords(const MFramework::MeshVertex* vertices, size_t vertexCount, uint8_t* outVertices, size_t stride)
+  {
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    // (u0, v0, u1, v1)の並びのまま変換すれば詰めた結果も頂点ごとの並びになる
+    for (; i + 4 <= vertexCount; i += 4)
+    {
+      const __m128 uv01 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(vertices[i].TexCoord)), reinterpret_cast<const __m64*>(vertices[i + 1].TexCoord));
+      const __m128 uv23 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(vertices[i + 2].TexCoord)), reinterpret_cast<const __m64*>(vertices[i + 3].TexCoord));
+      store32x4(packUnsigned16(floatToHalf4(uv01), floatToHalf4(uv23)), outVertices + i * stride, stride);
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      const uint16_t encoded[2] =
+      {
+        MFramework::HalfUtility::FloatToHalf(vertices[i].TexCoord[0]),
+        MFramework::HalfUtility::FloatToHalf(vertices[i].TexCoord[1]),
+      };
+      std::memcpy(outVertices + i * stride, encoded, sizeof(encoded));
+    }
+  }
+
+  void decodeTexCoords(const uint8_t* vertices, size_t vertexCount, MFramework::MeshVertex* outVertices, size_t stride)
+  {
+    size_t i = 0;
+#if M_VERTEX_QUANTIZER_USE_SSE
+    const __m128i lowMask = _mm_set1_epi32(0xffff);
+    for (; i + 4 <= vertexCount; i += 4)
+    {
+      const __m128i encoded = load32x4(vertices + i * stride, stride);
+      const __m128 u = halfToFloat4(_mm_and_si128(encoded, lowMask));
+      const __m128 v = halfToFloat4(_mm_srli_epi32(encoded, 16));
+      const __m128 uv01 = _mm_unpacklo_ps(u, v);
+      const __m128 uv23 = _mm_unpackhi_ps(u, v);
+      _mm_storel_pi(reinterpret_cast<__m64*>(outVertices[i].TexCoord), uv01);
+      _mm_storeh_pi(reinterpret_cast<__m64*>(outVertices[i + 1].TexCoord), uv01);
+      _mm_storel_pi(reinterpret_cast<__m64*>(outVertices[i + 2].TexCoord), uv23);
+      _mm_storeh_pi(reinterpret_cast<__m64*>(outVertices[i + 3].TexCoord), uv23);
+    }
+#endif
+    for (; i < vertexCount; ++i)
+    {
+      uint16_t encoded[2] = {};
+      std::memcpy(encoded, vertices + i * stride, sizeof(encoded));
+      outVertices[i].TexCoord[0] = MFramework::HalfUtility::HalfToFloat(encoded[0]);
+      outVertices[i].TexCoord[1] = MFramework::HalfUtility::HalfToFloat(encoded[1]);
+    }
+  }
+}
+
+namespace MFramework
+{
+  VertexQuantization VertexQuantizer::ComputeQuantization(const MeshVertex* vertices, size_t vertexCount)
+  {
+    float boundsMin[3] = {};
+    float boundsMax[3] = {};
+    if (vertexCount > 0)
+    {
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        boundsMin[axis] = std::numeric_limits<float>::max();
+        boundsMax[axis] = std::numeric_limits<float>::lowest();
+      }
+    }
+
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        boundsMin[axis] = std::min(boundsMin[axis], vertices[i].Position[axis]);
+        boundsMax[axis] = std::max(boundsMax[axis], vertices[i].Position[axis]);
+      }
+    }
+
+    return CreateQuantization(boundsMin, boundsMax);
+  }
+
+  VertexQuantization VertexQuantizer::CreateQuantization(const float boundsMin[3], const float boundsMax[3])
+  {
+    // 軸ごとに範囲いっぱいを使う(等方にしないのは薄いメッシュの精度を落とさないため)
+    VertexQuantization quantization{};
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+      quantization.PositionScale[axis] = std::max(boundsMax[axis] - boundsMin[axis], 0.0f);
+      quantization.PositionBias[axis] = boundsMin[axis];
+    }
+    return quantization;
+  }
+
+  void VertexQuantizer::Encode(const MeshVertex* vertices, size_t vertexCount, const VertexLayout& layout, const VertexQuantization& quantization, uint8_t* outVertices)
+  {
+    // 属性ごとに全頂点を処理する(同じ種類の変換を続けるほうがSIMDにしやすい)
+    for (uint32_t elementIndex = 0; elementIndex < layout.ElementCount; ++elementIndex)
+    {
+      const VertexElement& element = layout.Elements[elementIndex];
+      uint8_t* out = outVertices + element.Offset;
+      switch (element.Format)
+      {
+        case VertexElementFormat::UNorm16x4:
+        {
+          encodePositions(vertices, vertexCount, quantization, out, layout.Stride);
+          break;
+        }
+        case VertexElementFormat::OctahedralSNorm16x2:
+        {
+          encodeNormals(vertices, vertexCount, out, layout.Stride);
+          break;
+        }
+        case VertexElementFormat::Half2:
+        {
+          encodeTexCoords(vertices, vertexCount, out, layout.Stride);
+          break;
+        }
+        default:
+        {
+          const size_t size = VertexFormat::GetElementSize(element.Format);
+          for (size_t i = 0; i < vertexCount; ++i)
+          {
+            std::memcpy(out + i * layout.Stride, getAttribute(vertices[i], element.Semantic), size);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  void VertexQuantizer::Decode(const uint8_t* vertices, size_t vertexCount, const VertexLayout& layout, const VertexQuantization& quantization, MeshVertex* outVertices)
+  {
+    if (vertexCount > 0 && layout.ElementCount < VERTEX_SEMANTIC_COUNT)
+    {
+      std::memset(outVertices, 0, sizeof(MeshVertex) * vertexCount);
+    }
+
+    for (uint32_t elementIndex = 0; elementIndex < layout.ElementCount; ++elementIndex)
+    {
+      const VertexElement& element = layout.Elements[elementIndex];
+      const uint8_t* src = vertices + element.Offset;
+      switch (element.Format)
+      {
+        case VertexElementFormat::UNorm16x4:
+        {
+          decodePositions(src, vertexCount, quantization, outVertices, layout.Stride);
+          break;
+        }
+        case VertexElementFormat::OctahedralSNorm16x2:
+        {
+          decodeNormals(src, vertexCount, outVertices, layout.Stride);
+          break;
+        }
+        case VertexElementFormat::Half2:
+        {
+          decodeTexCoords(src, vertexCount, outVertices, layout.Stride);
+          break;
+        }
+        default:
+        {
+          const size_t size = VertexFormat::GetElementSize(element.Format);
+          for (size_t i = 0; i < vertexCount; ++i)
+          {
+            std::memcpy(getAttribute(outVertices[i], element.Semantic), src + i * layout.Stride, size);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  VertexQuantizationError VertexQuantizer::MeasureError(const MeshVertex* originalVertices, const MeshVertex* decodedVertices, size_t vertexCount)
+  {
+    const VertexQuantization quantization = ComputeQuantization(originalVertices, vertexCount);
+    const float extent = std::max({ quantization.PositionScale[0], quantization.PositionScale[1], quantization.PositionScale[2] });
+
+    VertexQuantizationError error{};
+    for (size_t i = 0; i < vertexCount; ++i)
+    {
+      const MeshVertex& original = originalVertices[i];
+      const MeshVertex& decoded = decodedVertices[i];
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        error.Position = std::max(error.Position, std::fabs(original.Position[axis] - decoded.Position[axis]));
+      }
+      for (uint32_t axis = 0; axis < 2; ++axis)
+      {
+        error.TexCoord = std::max(error.TexCoord, std::fabs(original.TexCoord[axis] - decoded.TexCoord[axis]));
+      }
+
+      // 長さ0の法線は比べない(小さい角度はacosでは精度が出ないので外積と内積から求める)
+      const float* a = original.Normal;
+      const float* b = decoded.Normal;
+      const float cross[3] =
+      {
+        a[1] * b[2] - a[2] * b[1],
+        a[2] * b[0] - a[0] * b[2],
+        a[0] * b[1] - a[1] * b[0],
+      };
+      const float sine = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+      const float cosine = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+      if (sine > 0.0f || cosine != 0.0f)
+      {
+        error.NormalDegrees = std::max(error.NormalDegrees, std::atan2(sine, cosine) * RADIAN_TO_DEGREE);
+      }
+    }
+
+    if (extent > 0.0f)
+    {
+      error.Position /= extent;
+    }
+    return error;
+  }
+}
@@ -0,0 +1,85 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by an asset archive
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <ArchiveFileMount.h>
+
+namespace MFramework
+{
+  ArchiveFileMount::ArchiveFileMount()
+    : m_archive()
+    , m_threadPool(nullptr)
+  { }
+
+  ArchiveFileMount::~ArchiveFileMount()
+  {
+    Dispose();
+  }
+
+  bool ArchiveFileMount::Init(const std::string& archivePath, bool isVerifyData, ThreadPool* threadPool)
+  {
+    Dispose();
+
+    if (!m_archive.Open(archivePath, isVerifyData))
+    {
+      return false;
+    }
+
+    m_threadPool = threadPool;
+    return true;
+  }
+
+  uint32_t ArchiveFileMount::Find(std::string_view normalizedPath, uint64_t) const
+  {
+    // アーカイブのテーブルも同じハッシュ値で引くが、正規化は中で行うのでパスを渡す
+    const uint32_t index = m_archive.FindIndex(normalizedPath);
+    return (index == ASSET_ARCHIVE_EMPTY_BUCKET) ? INVALID_INDEX : index;
+  }
+
+  uint32_t ArchiveFileMount::GetCount() const
+  {
+    return m_archive.GetCount();
+  }
+
+  std::string_view ArchiveFileMount::GetPath(uint32_t index) const
+  {
+    return m_archive.GetPath(index);
+  }
+
+  uint64_t ArchiveFileMount::GetSize(uint32_t index) const
+  {
+    return m_archive.GetSize(index);
+  }
+
+  AssetView ArchiveFileMount::GetView(uint32_t index) const
+  {
+    return m_archive.GetData(index);
+  }
+
+  bool ArchiveFileMount::Read(uint32_t index, uint8_t* dst, size_t dstSize) const
+  {
+    return m_archive.Read(index, dst, dstSize, m_threadPool);
+  }
+
+  bool ArchiveFileMount::GetNativePath(uint32_t, std::string&) const
+  {
+    return false;
+  }
+
+  void ArchiveFileMount::Dispose() noexcept
+  {
+    m_archive.Dispose();
+    m_threadPool = nullptr;
+  }
+}
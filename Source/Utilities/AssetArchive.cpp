@@ -0,0 +1,340 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Memory-mapped packed asset archive reader
+
+Update History: 2026/10/19 Create
+                2026/10/19 Read compressed entries with parallel block decompression
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <AssetArchive.h>
+#include <HashUtil.h>
+#include <Lz4Codec.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  constexpr size_t BLOCKS_PER_CHUNK = 1;
+
+  const MFramework::Lz4Codec LZ4_CODEC{};
+
+  bool isRangeValid(uint64_t offset, uint64_t size, uint64_t fileSize)
+  {
+    return offset <= fileSize && size <= fileSize - offset;
+  }
+}
+
+namespace MFramework
+{
+  AssetArchive::AssetArchive()
+    : m_file()
+    , m_buckets(nullptr)
+    , m_entries(nullptr)
+    , m_paths(nullptr)
+    , m_entryCount(0)
+    , m_bucketMask(0)
+    , m_blockSize(0)
+    , m_codecs()
+  {
+    m_codecs[Lz4Codec::CODEC_ID] = &LZ4_CODEC;
+  }
+
+  AssetArchive::~AssetArchive()
+  {
+    Dispose();
+  }
+
+  bool AssetArchive::Open(const std::string& filePath, bool isVerifyData)
+  {
+    Dispose();
+
+    if (!m_file.Open(filePath))
+    {
+      return false;
+    }
+
+    if (m_file.GetSize() < sizeof(AssetArchiveHeader))
+    {
+      Dispose();
+      return false;
+    }
+
+    AssetArchiveHeader header{};
+    std::memcpy(&header, m_file.GetData(), sizeof(header));
+
+    // テーブルがファイル内に収まっているか(空きバケットが必ずあるので探索は終わる)
+    const uint64_t bucketSize = static_cast<uint64_t>(header.BucketCount) * sizeof(AssetArchiveBucket);
+    const uint64_t entrySize = static_cast<uint64_t>(header.EntryCount) * sizeof(AssetArchiveEntry);
+    const bool isHeaderValid = (header.Magic == ASSET_ARCHIVE_MAGIC)
+                            && (header.Version == ASSET_ARCHIVE_VERSION)
+                            && (header.FileSize == m_file.GetSize())
+                            && (header.BucketCount != 0)
+                            && ((header.BucketCount & (header.BucketCount - 1)) == 0)
+                            && (header.EntryCount < header.BucketCount)
+                            && (header.DataAlignment != 0)
+                            && (header.BucketOffset % alignof(AssetArchiveBucket) == 0)
+                            && (header.EntryOffset % alignof(AssetArchiveEntry) == 0)
+                            && isRangeValid(header.BucketOffset, bucketSize, header.FileSize)
+                            && isRangeValid(header.EntryOffset, entrySize, header.FileSize)
+                            && isRangeValid(header.PathOffset, header.PathSize, header.FileSize);
+    if (!isHeaderValid)
+    {
+      Dispose();
+      return false;
+    }
+
+    // マップしたメモリはページ境界から始まるため、アライメント済みのテーブルはそのまま参照できる
+    m_buckets = reinterpret_cast<const AssetArchiveBucket*>(m_file.GetData() + header.BucketOffset);
+    m_entries = reinterpret_cast<const AssetArchiveEntry*>(m_file.GetData() + header.EntryOffset);
+    m_paths = reinterpret_cast<const char*>(m_file.GetData() + header.PathOffset);
+    m_entryCount = header.EntryCount;
+    m_bucketMask = header.BucketCount - 1;
+    m_blockSize = header.BlockSize;
+
+    if (!validate(isVerifyData))
+    {
+      Dispose();
+      return false;
+    }
+
+    return true;
+  }
+
+  AssetView AssetArchive::Find(std::string_view path) const
+  {
+    return GetData(FindIndex(path));
+  }
+
+  uint32_t AssetArchive::FindIndex(std::string_view path) const
+  {
+    if (m_entries == nullptr)
+    {
+      return ASSET_ARCHIVE_EMPTY_BUCKET;
+    }
+
+    const uint64_t hash = AssetArchiveFormat::ComputePathHash(path);
+    for (uint32_t bucketIndex = static_cast<uint32_t>(hash) & m_bucketMask; ; bucketIndex = (bucketIndex + 1) & m_bucketMask)
+    {
+      const AssetArchiveBucket& bucket = m_buckets[bucketIndex];
+      if (bucket.EntryIndex == ASSET_ARCHIVE_EMPTY_BUCKET)
+      {
+        return ASSET_ARCHIVE_EMPTY_BUCKET;
+      }
+
+      // ハッシュが衝突しても文字列で確認する
+      if (bucket.PathHash == hash && AssetArchiveFormat::IsSamePath(GetPath(bucket.EntryIndex), path))
+      {
+        return bucket.EntryIndex;
+      }
+    }
+  }
+
+  AssetView AssetArchive::GetData(uint32_t index) const
+  {
+    if (index >= m_entryCount || m_entries[index].Codec != COMPRESSION_CODEC_NONE)
+    {
+      return { nullptr, 0 };
+    }
+
+    return GetStoredData(index);
+  }
+
+  AssetView AssetArchive::GetStoredData(uint32_t index) const
+  {
+    if (index >= m_entryCount)
+    {
+      return { nullptr, 0 };
+    }
+
+    const AssetArchiveEntry& entry = m_entries[index];
+    return { m_file.GetData() + entry.Offset, static_cast<size_t>(entry.StoredSize) };
+  }
+
+  uint64_t AssetArchive::GetSize(uint32_t index) const
+  {
+    return (index < m_entryCount) ? m_entries[index].Size : 0;
+  }
+
+  bool AssetArchive::IsCompressed(uint32_t index) const
+  {
+    return (index < m_entryCount) && (m_entries[index].Codec != COMPRESSION_CODEC_NONE);
+  }
+
+  bool AssetArchive::Read(uint32_t index, uint8_t* dst, size_t dstSize, ThreadPool* threadPool) const
+  {
+    if (index >= m_entryCount || dstSize < m_entries[index].Size || (dst == nullptr && m_entries[index].Size != 0))
+    {
+      return false;
+    }
+
+    const AssetArchiveEntry& entry = m_entries[index];
+    const uint8_t* stored = m_file.GetData() + entry.Offset;
+    if (entry.Codec == COMPRESSION_CODEC_NONE)
+    {
+      if (entry.Size != 0)
+      {
+        std::memcpy(dst, stored, static_cast<size_t>(entry.Size));
+      }
+      return true;
+    }
+
+    const ICompressionCodec* codec = (entry.Codec < ASSET_ARCHIVE_MAX_CODEC_COUNT) ? m_codecs[entry.Codec] : nullptr;
+    if (codec == nullptr)
+    {
+      return false;
+    }
+
+    // ブロックの位置はサイズ表を足し合わせて求める(ブロックの並びと表の合計がStoredSizeと一致すること)
+    const uint64_t tableSize = sizeof(uint32_t) * static_cast<uint64_t>(entry.BlockCount);
+    std::vector<uint64_t> blockOffsets(static_cast<size_t>(entry.BlockCount) + 1);
+    blockOffsets[0] = tableSize;
+    for (uint32_t i = 0; i < entry.BlockCount; ++i)
+    {
+      uint32_t blockSize = 0;
+      std::memcpy(&blockSize, stored + sizeof(uint32_t) * i, sizeof(blockSize));
+      blockOffsets[i + 1] = blockOffsets[i] + blockSize;
+    }
+
+    if (blockOffsets.back() != entry.StoredSize)
+    {
+      return false;
+    }
+
+    // ブロックは独立しているので、書き込み先の別々の範囲へ並列に展開できる
+    std::atomic<bool> isSucceeded = true;
+    auto decompressBlocks = [&](size_t begin, size_t end)
+                            {
+                              for (size_t i = begin; i < end && isSucceeded.load(std::memory_order_relaxed); ++i)
+                              {
+                                const uint64_t rawOffset = static_cast<uint64_t>(m_blockSize) * i;
+                                const size_t rawSize = static_cast<size_t>(std::min<uint64_t>(m_blockSize, entry.Size - rawOffset));
+                                const size_t storedSize = static_cast<size_t>(blockOffsets[i + 1] - blockOffsets[i]);
+
+                                // 縮まなかったブロックはそのまま格納されている
+                                bool isBlockSucceeded = true;
+                                if (storedSize == rawSize)
+                                {
+                                  std::memcpy(dst + rawOffset, stored + blockOffsets[i], rawSize);
+                                }
+                                else
+                                {
+                                  isBlockSucceeded = codec->Decompress(stored + blockOffsets[i], storedSize, dst + rawOffset, rawSize);
+                                }
+
+                                if (!isBlockSucceeded)
+                                {
+                                  isSucceeded.store(false, std::memory_order_relaxed);
+                                }
+                              }
+                            };
+
+    if (threadPool != nullptr)
+    {
+      threadPool->ParallelFor(entry.BlockCount, decompressBlocks, BLOCKS_PER_CHUNK);
+    }
+    else
+    {
+      decompressBlocks(0, entry.BlockCount);
+    }
+
+    return isSucceeded.load();
+  }
+
+  bool AssetArchive::RegisterCodec(const ICompressionCodec* codec)
+  {
+    if (codec == nullptr || codec->GetId() == COMPRESSION_CODEC_NONE || codec->GetId() >= ASSET_ARCHIVE_MAX_CODEC_COUNT)
+    {
+      return false;
+    }
+
+    m_codecs[codec->GetId()] = codec;
+    return true;
+  }
+
+  std::string_view AssetArchive::GetPath(uint32_t index) const
+  {
+    if (index >= m_entryCount)
+    {
+      return {};
+    }
+
+    const AssetArchiveEntry& entry = m_entries[index];
+    return std::string_view(m_paths + entry.PathOffset, entry.PathLength);
+  }
+
+  void AssetArchive::Dispose() noexcept
+  {
+    m_buckets = nullptr;
+    m_entries = nullptr;
+    m_paths = nullptr;
+    m_entryCount = 0;
+    m_bucketMask = 0;
+    m_blockSize = 0;
+    m_file.Dispose();
+  }
+
+  bool AssetArchive::validate(bool isVerifyData) const
+  {
+    AssetArchiveHeader header{};
+    std::memcpy(&header, m_file.GetData(), sizeof(header));
+
+    for (uint32_t i = 0; i < m_entryCount; ++i)
+    {
+      const AssetArchiveEntry& entry = m_entries[i];
+      if (!isRangeValid(entry.Offset, entry.StoredSize, header.FileSize) || entry.Offset % header.DataAlignment != 0 ||
+          !isRangeValid(entry.PathOffset, entry.PathLength, header.PathSize))
+      {
+        return false;
+      }
+
+      // ブロック数は展開後のサイズから決まる(サイズ表の中身は展開時に確認する)
+      if (entry.Codec == COMPRESSION_CODEC_NONE)
+      {
+        if (entry.StoredSize != entry.Size || entry.BlockCount != 0)
+        {
+          return false;
+        }
+      }
+      else if (header.BlockSize == 0 || entry.Codec >= ASSET_ARCHIVE_MAX_CODEC_COUNT ||
+               entry.BlockCount != (entry.Size + header.BlockSize - 1) / header.BlockSize ||
+               entry.StoredSize < sizeof(uint32_t) * static_cast<uint64_t>(entry.BlockCount))
+      {
+        return false;
+      }
+
+      if (isVerifyData && HashUtility::Fnv1a64(m_file.GetData() + entry.Offset, static_cast<size_t>(entry.StoredSize)) != entry.DataHash)
+      {
+        return false;
+      }
+    }
+
+    // 空きバケットが一つもないと探索が終わらない
+    bool hasEmptyBucket = false;
+    for (uint32_t i = 0; i <= m_bucketMask; ++i)
+    {
+      const uint32_t entryIndex = m_buckets[i].EntryIndex;
+      if (entryIndex == ASSET_ARCHIVE_EMPTY_BUCKET)
+      {
+        hasEmptyBucket = true;
+      }
+      else if (entryIndex >= m_entryCount || m_buckets[i].PathHash != m_entries[entryIndex].PathHash)
+      {
+        return false;
+      }
+    }
+
+    return hasEmptyBucket;
+  }
+}
@@ -0,0 +1,145 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed asset archive file format
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <AssetArchiveFormat.h>
+#include <HashUtil.h>
+
+namespace
+{
+  /// @brief
+  /// 正規化した文字を先頭から順に取り出す
+  class NormalizedPathReader
+  {
+    public:
+      explicit NormalizedPathReader(std::string_view path)
+        : m_path(path)
+        , m_index(0)
+        , m_isAfterSeparator(true)
+      { }
+
+      /// @return 終端ならfalse
+      bool Next(char& outChar)
+      {
+        while (m_index < m_path.size())
+        {
+          char c = m_path[m_index++];
+          if (c == '\\')
+          {
+            c = '/';
+          }
+
+          if (c == '/')
+          {
+            // 先頭と連続した区切りは読み飛ばす
+            if (m_isAfterSeparator)
+            {
+              continue;
+            }
+            m_isAfterSeparator = true;
+            outChar = c;
+            return true;
+          }
+
+          // 区切りの直後の"./"は読み飛ばす
+          if (c == '.' && m_isAfterSeparator && m_index < m_path.size() && (m_path[m_index] == '/' || m_path[m_index] == '\\'))
+          {
+            ++m_index;
+            continue;
+          }
+
+          m_isAfterSeparator = false;
+          outChar = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+          return true;
+        }
+
+        return false;
+      }
+
+    private:
+      std::string_view m_path;
+      size_t m_index;
+      bool m_isAfterSeparator;
+  };
+}
+
+namespace MFramework
+{
+  std::string AssetArchiveFormat::NormalizePath(std::string_view path)
+  {
+    std::string normalizedPath;
+    normalizedPath.reserve(path.size());
+
+    NormalizedPathReader reader(path);
+    char c = '\0';
+    while (reader.Next(c))
+    {
+      normalizedPath.push_back(c);
+    }
+
+    // 末尾の区切りは残さない
+    if (!normalizedPath.empty() && normalizedPath.back() == '/')
+    {
+      normalizedPath.pop_back();
+    }
+
+    return normalizedPath;
+  }
+
+  uint64_t AssetArchiveFormat::ComputePathHash(std::string_view path)
+  {
+    uint64_t hash = HashUtility::FNV_OFFSET_BASIS;
+    uint64_t pendingSeparators = 0;
+
+    NormalizedPathReader reader(path);
+    char c = '\0';
+    while (reader.Next(c))
+    {
+      // 末尾の区切りを含めないように、次の文字が来るまで保留する
+      if (c == '/')
+      {
+        ++pendingSeparators;
+        continue;
+      }
+
+      for (; pendingSeparators > 0; --pendingSeparators)
+      {
+        hash = (hash ^ static_cast<uint8_t>('/')) * HashUtility::FNV_PRIME;
+      }
+      hash = (hash ^ static_cast<uint8_t>(c)) * HashUtility::FNV_PRIME;
+    }
+
+    return hash;
+  }
+
+  bool AssetArchiveFormat::IsSamePath(std::string_view normalizedPath, std::string_view path)
+  {
+    NormalizedPathReader reader(path);
+    size_t index = 0;
+    char c = '\0';
+    while (reader.Next(c))
+    {
+      if (index < normalizedPath.size() && normalizedPath[index] == c)
+      {
+        ++index;
+        continue;
+      }
+
+      // 末尾の区切りだけが残っている場合は一致とみなす
+      return (c == '/') && (index == normalizedPath.size()) && !reader.Next(c);
+    }
+
+    return index == normalizedPath.size();
+  }
+}
@@ -0,0 +1,318 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Packed asset archive writer
+
+Update History: 2026/10/19 Create
+                2026/10/19 Per-entry block compression
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <AssetArchiveWriter.h>
+#include <HashUtil.h>
+#include <MappedFile.h>
+#include <ThreadPool.h>
+#include <Interfaces/ICompressionCodec.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  uint64_t AlignUp(uint64_t value, uint64_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  uint32_t ComputeBucketCount(size_t entryCount)
+  {
+    // 負荷率を0.5以下にして探索の長さを抑える
+    uint32_t bucketCount = 16;
+    while (bucketCount < entryCount * 2)
+    {
+      bucketCount <<= 1;
+    }
+
+    return bucketCount;
+  }
+}
+
+namespace MFramework
+{
+  AssetArchiveWriter::AssetArchiveWriter()
+    : m_assets()
+    , m_codec(nullptr)
+    , m_blockSize(ASSET_ARCHIVE_DEFAULT_BLOCK_SIZE)
+    , m_maxRatio(0.9f)
+  { }
+
+  AssetArchiveWriter::~AssetArchiveWriter()
+  {
+    Dispose();
+  }
+
+  bool AssetArchiveWriter::Add(std::string_view path, const void* data, size_t size, bool isAllowCompression)
+  {
+    std::string normalizedPath = AssetArchiveFormat::NormalizePath(path);
+    if (normalizedPath.empty() || (data == nullptr && size != 0))
+    {
+      return false;
+    }
+
+    auto it = m_assets.find(normalizedPath);
+    if (it != m_assets.end())
+    {
+      // 同じ内容なら重複として無視する
+      const std::vector<uint8_t>& existing = it->second.Data;
+      return (existing.size() == size) && (size == 0 || std::memcmp(existing.data(), data, size) == 0);
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_assets.emplace(std::move(normalizedPath), Asset{ std::vector<uint8_t>(bytes, bytes + size), isAllowCompression });
+    return true;
+  }
+
+  bool AssetArchiveWriter::AddFile(std::string_view path, const std::string& filePath, bool isAllowCompression)
+  {
+    // 空のファイルはマップできないので中身なしで追加する
+    std::error_code error;
+    if (std::filesystem::file_size(std::filesystem::path(std::u8string(filePath.begin(), filePath.end())), error) == 0 && !error)
+    {
+      return Add(path, nullptr, 0, isAllowCompression);
+    }
+
+    MappedFile file;
+    if (!file.Open(filePath))
+    {
+      return false;
+    }
+
+    return Add(path, file.GetData(), file.GetSize(), isAllowCompression);
+  }
+
+  void AssetArchiveWriter::SetCompression(const ICompressionCodec* codec, uint32_t blockSize, float maxRatio)
+  {
+    m_codec = codec;
+    m_blockSize = blockSize;
+    m_maxRatio = maxRatio;
+  }
+
+  bool AssetArchiveWriter::WriteToFile(const std::string& filePath, uint32_t dataAlignment, ThreadPool* threadPool) const
+  {
+    if (dataAlignment == 0 || (dataAlignment & (dataAlignment - 1)) != 0 || (m_codec != nullptr && m_blockSize == 0))
+    {
+      return false;
+    }
+
+    // 圧縮はエントリーごと、その中でブロックごとに分担する(ParallelForは入れ子にできる)
+    std::vector<const Asset*> assets;
+    assets.reserve(m_assets.size());
+    for (const auto& [path, asset] : m_assets)
+    {
+      assets.emplace_back(&asset);
+    }
+
+    std::vector<std::vector<uint8_t>> compressedData(assets.size());
+    std::vector<uint8_t> isCompressed(assets.size(), 0);
+    if (m_codec != nullptr)
+    {
+      auto compressAssets = [&](size_t begin, size_t end)
+                            {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                isCompressed[i] = compress(*assets[i], compressedData[i], threadPool) ? 1 : 0;
+                              }
+                            };
+
+      if (threadPool != nullptr)
+      {
+        threadPool->ParallelFor(assets.size(), compressAssets);
+      }
+      else
+      {
+        compressAssets(0, assets.size());
+      }
+    }
+
+    // 配置を先に決める
+    const uint32_t bucketCount = ComputeBucketCount(m_assets.size());
+    std::vector<AssetArchiveBucket> buckets(bucketCount, AssetArchiveBucket{ 0, ASSET_ARCHIVE_EMPTY_BUCKET, 0 });
+    std::vector<AssetArchiveEntry> entries;
+    entries.reserve(m_assets.size());
+
+    std::string paths;
+    for (const auto& [path, asset] : m_assets)
+    {
+      const size_t assetIndex = entries.size();
+      const std::vector<uint8_t>& stored = isCompressed[assetIndex] ? compressedData[assetIndex] : asset.Data;
+
+      AssetArchiveEntry entry{};
+      entry.PathHash = AssetArchiveFormat::ComputePathHash(path);
+      entry.Size = static_cast<uint64_t>(asset.Data.size());
+      entry.StoredSize = static_cast<uint64_t>(stored.size());
+      entry.DataHash = HashUtility::Fnv1a64(stored.data(), stored.size());
+      entry.Codec = isCompressed[assetIndex] ? m_codec->GetId() : COMPRESSION_CODEC_NONE;
+      entry.BlockCount = isCompressed[assetIndex] ? static_cast<uint32_t>((asset.Data.size() + m_blockSize - 1) / m_blockSize) : 0;
+      entry.PathOffset = static_cast<uint32_t>(paths.size());
+      entry.PathLength = static_cast<uint32_t>(path.size());
+      paths += path;
+
+      // 線形探索で空きバケットに入れる
+      const uint32_t entryIndex = static_cast<uint32_t>(entries.size());
+      uint32_t bucketIndex = static_cast<uint32_t>(entry.PathHash) & (bucketCount - 1);
+      while (buckets[bucketIndex].EntryIndex != ASSET_ARCHIVE_EMPTY_BUCKET)
+      {
+        bucketIndex = (bucketIndex + 1) & (bucketCount - 1);
+      }
+      buckets[bucketIndex] = AssetArchiveBucket{ entry.PathHash, entryIndex, 0 };
+
+      entries.emplace_back(entry);
+    }
+
+    const uint64_t bucketOffset = sizeof(AssetArchiveHeader);
+    const uint64_t entryOffset = bucketOffset + sizeof(AssetArchiveBucket) * buckets.size();
+    const uint64_t pathOffset = entryOffset + sizeof(AssetArchiveEntry) * entries.size();
+    uint64_t offset = pathOffset + paths.size();
+    for (AssetArchiveEntry& entry : entries)
+    {
+      offset = AlignUp(offset, dataAlignment);
+      entry.Offset = offset;
+      offset += entry.StoredSize;
+    }
+
+    AssetArchiveHeader header{};
+    header.Magic = ASSET_ARCHIVE_MAGIC;
+    header.Version = ASSET_ARCHIVE_VERSION;
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+    header.BucketCount = bucketCount;
+    header.DataAlignment = dataAlignment;
+    header.BlockSize = (m_codec != nullptr) ? m_blockSize : 0;
+    header.BucketOffset = bucketOffset;
+    header.EntryOffset = entryOffset;
+    header.PathOffset = pathOffset;
+    header.PathSize = static_cast<uint64_t>(paths.size());
+    header.FileSize = offset;
+
+    // 一時ファイルに書いてから置き換え、実行中のアプリが中途半端なファイルをマップしないようにする
+    const std::string tempPath = filePath + ".tmp";
+    {
+      std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+      if (!file.is_open())
+      {
+        return false;
+      }
+
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(buckets.data()), static_cast<std::streamsize>(sizeof(AssetArchiveBucket) * buckets.size()));
+      file.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(sizeof(AssetArchiveEntry) * entries.size()));
+      file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+
+      const std::vector<char> padding(dataAlignment, 0);
+      uint64_t written = pathOffset + paths.size();
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+        const AssetArchiveEntry& entry = entries[i];
+        const std::vector<uint8_t>& stored = isCompressed[i] ? compressedData[i] : assets[i]->Data;
+        file.write(padding.data(), static_cast<std::streamsize>(entry.Offset - written));
+        file.write(reinterpret_cast<const char*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+        written = entry.Offset + entry.StoredSize;
+      }
+
+      if (!file.good())
+      {
+        return false;
+      }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error)
+    {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    return true;
+  }
+
+  void AssetArchiveWriter::Dispose() noexcept
+  {
+    m_assets.clear();
+  }
+
+  bool AssetArchiveWriter::compress(const Asset& asset, std::vector<uint8_t>& outStored, ThreadPool* threadPool) const
+  {
+    const size_t size = asset.Data.size();
+    if (!asset.IsAllowCompression || size == 0)
+    {
+      return false;
+    }
+
+    // ブロックごとに最大サイズの領域で圧縮してから詰める
+    const size_t blockCount = (size + m_blockSize - 1) / m_blockSize;
+    const size_t maxBlockSize = m_codec->GetMaxCompressedSize(m_blockSize);
+    std::vector<uint8_t> blockBuffer(maxBlockSize * blockCount);
+    std::vector<uint32_t> blockSizes(blockCount, 0);
+
+    auto compressBlocks = [&](size_t begin, size_t end)
+                          {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                              const size_t rawOffset = i * m_blockSize;
+                              const size_t rawSize = std::min<size_t>(m_blockSize, size - rawOffset);
+                              uint8_t* dst = blockBuffer.data() + maxBlockSize * i;
+                              const size_t compressedSize = m_codec->Compress(asset.Data.data() + rawOffset, rawSize, dst, maxBlockSize);
+
+                              // 縮まないブロックはそのまま格納し、展開時はサイズで見分ける
+                              if (compressedSize == 0 || compressedSize >= rawSize)
+                              {
+                                std::memcpy(dst, asset.Data.data() + rawOffset, rawSize);
+                                blockSizes[i] = static_cast<uint32_t>(rawSize);
+                              }
+                              else
+                              {
+                                blockSizes[i] = static_cast<uint32_t>(compressedSize);
+                              }
+                            }
+                          };
+
+    if (threadPool != nullptr)
+    {
+      threadPool->ParallelFor(blockCount, compressBlocks);
+    }
+    else
+    {
+      compressBlocks(0, blockCount);
+    }
+
+    size_t storedSize = sizeof(uint32_t) * blockCount;
+    for (uint32_t blockSize : blockSizes)
+    {
+      storedSize += blockSize;
+    }
+
+    if (static_cast<double>(storedSize) > static_cast<double>(size) * m_maxRatio)
+    {
+      return false;
+    }
+
+    outStored.resize(storedSize);
+    std::memcpy(outStored.data(), blockSizes.data(), sizeof(uint32_t) * blockCount);
+    size_t offset = sizeof(uint32_t) * blockCount;
+    for (size_t i = 0; i < blockCount; ++i)
+    {
+      std::memcpy(outStored.data() + offset, blockBuffer.data() + maxBlockSize * i, blockSizes[i]);
+      offset += blockSizes[i];
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,639 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Asynchronous file read service with priorities and read coalescing
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <AsyncFileService.h>
+
+#include <IoUringFileBackend.h>
+#include <ThreadFileBackend.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+  // まとめる相手を探すときに見るキューの要素数(iovecの上限IOV_MAXも超えないようにする)
+  constexpr size_t COALESCE_SCAN_LIMIT = 256;
+
+  bool openNativeFile(const std::string& filePath, intptr_t& outFile, uint64_t& outSize)
+  {
+    #ifdef _WIN32
+      // パスはUTF-8として扱う
+      const int length = ::MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0);
+      if (length <= 0)
+      {
+        return false;
+      }
+      std::wstring widePath(static_cast<size_t>(length), L'\0');
+      ::MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, widePath.data(), length);
+
+      const HANDLE file = ::CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+      {
+        return false;
+      }
+
+      LARGE_INTEGER fileSize{};
+      if (!::GetFileSizeEx(file, &fileSize))
+      {
+        ::CloseHandle(file);
+        return false;
+      }
+
+      outFile = reinterpret_cast<intptr_t>(file);
+      outSize = static_cast<uint64_t>(fileSize.QuadPart);
+      return true;
+    #else
+      const int file = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+      if (file < 0)
+      {
+        return false;
+      }
+
+      struct stat fileStat{};
+      if (::fstat(file, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+      {
+        ::close(file);
+        return false;
+      }
+
+      outFile = static_cast<intptr_t>(file);
+      outSize = static_cast<uint64_t>(fileStat.st_size);
+      return true;
+    #endif
+  }
+
+  void closeNativeFile(intptr_t file)
+  {
+    #ifdef _WIN32
+      ::CloseHandle(reinterpret_cast<HANDLE>(file));
+    #else
+      ::close(static_cast<int>(file));
+    #endif
+  }
+}
+
+namespace MFramework
+{
+  AsyncFileService::AsyncFileService()
+    : m_backend()
+    , m_callbackPool(nullptr)
+    , m_desc()
+    , m_dispatcher()
+    , m_mutex()
+    , m_idleCondition()
+    , m_queues()
+    , m_files()
+    , m_nextRequestId(1)
+    , m_outstandingCount(0)
+    , m_stats()
+    , m_isStopping(false)
+  { }
+
+  AsyncFileService::~AsyncFileService()
+  {
+    Dispose();
+  }
+
+  bool AsyncFileService::Init(const AsyncFileServiceDesc& desc, ThreadPool* callbackPool)
+  {
+    if (m_backend != nullptr)
+    {
+      return false;
+    }
+
+    if (desc.IsPreferIoUring && desc.QueueDepth > 0)
+    {
+      std::unique_ptr<IoUringFileBackend> ioUringBackend = std::make_unique<IoUringFileBackend>();
+      if (ioUringBackend->Init(desc.QueueDepth))
+      {
+        m_backend = std::move(ioUringBackend);
+      }
+    }
+
+    if (m_backend == nullptr)
+    {
+      std::unique_ptr<ThreadFileBackend> threadBackend = std::make_unique<ThreadFileBackend>();
+      if (!threadBackend->Init(std::max<uint32_t>(desc.ThreadCount, 1)))
+      {
+        return false;
+      }
+      m_backend = std::move(threadBackend);
+    }
+
+    m_desc = desc;
+    m_callbackPool = callbackPool;
+    m_stats = AsyncFileServiceStats{};
+    m_isStopping = false;
+    m_dispatcher = std::thread(&AsyncFileService::dispatcherMain, this);
+    return true;
+  }
+
+  uint32_t AsyncFileService::OpenFile(const std::string& filePath)
+  {
+    intptr_t nativeFile = 0;
+    uint64_t fileSize = 0;
+    if (!openNativeFile(filePath, nativeFile, fileSize))
+    {
+      return INVALID_FILE_ID;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 閉じた枠を使い回す
+    for (size_t i = 0; i < m_files.size(); ++i)
+    {
+      if (!m_files[i].IsOpen)
+      {
+        m_files[i] = FileEntry{ nativeFile, fileSize, 0, true, false };
+        return static_cast<uint32_t>(i + 1);
+      }
+    }
+
+    m_files.emplace_back(FileEntry{ nativeFile, fileSize, 0, true, false });
+    return static_cast<uint32_t>(m_files.size());
+  }
+
+  void AsyncFileService::CloseFile(uint32_t file)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (file == INVALID_FILE_ID || file > m_files.size())
+    {
+      return;
+    }
+
+    FileEntry& entry = m_files[file - 1];
+    if (!entry.IsOpen || entry.IsClosing)
+    {
+      return;
+    }
+
+    if (entry.PendingCount == 0)
+    {
+      closeNativeFile(entry.NativeFile);
+      entry.IsOpen = false;
+    }
+    else
+    {
+      entry.IsClosing = true;
+    }
+  }
+
+  uint64_t AsyncFileService::GetFileSize(uint32_t file) const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (file == INVALID_FILE_ID || file > m_files.size() || !m_files[file - 1].IsOpen)
+    {
+      return 0;
+    }
+
+    return m_files[file - 1].Size;
+  }
+
+  uint64_t AsyncFileService::Read(uint32_t file, uint64_t offset, uint64_t size, void* buffer, AsyncFilePriority priority, Callback callback)
+  {
+    const size_t priorityIndex = static_cast<size_t>(priority);
+    if ((buffer == nullptr && size != 0) || !callback || priorityIndex >= ASYNC_FILE_PRIORITY_COUNT)
+    {
+      return INVALID_REQUEST_ID;
+    }
+
+    uint64_t requestId = INVALID_REQUEST_ID;
+    bool isQueued = false;
+    bool isIdle = true;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_backend == nullptr || m_isStopping || file == INVALID_FILE_ID || file > m_files.size())
+      {
+        return INVALID_REQUEST_ID;
+      }
+
+      FileEntry& entry = m_files[file - 1];
+      if (!entry.IsOpen || entry.IsClosing)
+      {
+        return INVALID_REQUEST_ID;
+      }
+
+      requestId = m_nextRequestId++;
+      ++m_outstandingCount;
+      ++m_stats.RequestCount;
+
+      if (size != 0)
+      {
+        for (const std::deque<Request>& queue : m_queues)
+        {
+          isIdle = isIdle && queue.empty();
+        }
+
+        ++entry.PendingCount;
+        m_queues[priorityIndex].emplace_back(Request{ requestId, file, offset, size, buffer, std::move(callback) });
+        isQueued = true;
+      }
+    }
+
+    // 0バイトの要求は読まずに完了する
+    if (!isQueued)
+    {
+      Request request{ requestId, file, offset, size, buffer, std::move(callback) };
+      completeRequest(request, AsyncFileResult{ requestId, buffer, 0, 0, true });
+      return requestId;
+    }
+
+    // キューが空でなければディスパッチスレッドは処理中か、完了を待っていてその後に取り出す
+    if (isIdle)
+    {
+      m_backend->Wake();
+    }
+
+    return requestId;
+  }
+
+  std::future<AsyncFileResult> AsyncFileService::ReadAsync(uint32_t file, uint64_t offset, uint64_t size, void* buffer, AsyncFilePriority priority)
+  {
+    std::shared_ptr<std::promise<AsyncFileResult>> promise = std::make_shared<std::promise<AsyncFileResult>>();
+    std::future<AsyncFileResult> future = promise->get_future();
+
+    const uint64_t requestId = Read(
+                                    file,
+                                    offset,
+                                    size,
+                                    buffer,
+                                    priority,
+                                    [promise](const AsyncFileResult& result)
+                                    {
+                                      promise->set_value(result);
+                                    }
+                                  );
+
+    if (requestId == INVALID_REQUEST_ID)
+    {
+      promise->set_value(AsyncFileResult{ INVALID_REQUEST_ID, buffer, size, 0, false });
+    }
+
+    return future;
+  }
+
+  void AsyncFileService::WaitIdle()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(
+                          lock,
+                          [this]()
+                          {
+                            return m_outstandingCount == 0;
+                          }
+                        );
+  }
+
+  const char* AsyncFileService::GetBackendName() const
+  {
+    return (m_backend != nullptr) ? m_backend->GetName() : "none";
+  }
+
+  AsyncFileServiceStats AsyncFileService::GetStats() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+  }
+
+  void AsyncFileService::Dispose() noexcept
+  {
+    if (m_backend == nullptr)
+    {
+      return;
+    }
+
+    // 新しい要求を断り、受け付けた分はすべて読み終えてから止める
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+
+    m_backend->Wake();
+    if (m_dispatcher.joinable())
+    {
+      m_dispatcher.join();
+    }
+
+    WaitIdle();
+    m_backend.reset();
+
+    for (FileEntry& entry : m_files)
+    {
+      if (entry.IsOpen)
+      {
+        closeNativeFile(entry.NativeFile);
+      }
+    }
+    m_files.clear();
+    m_callbackPool = nullptr;
+  }
+
+  void AsyncFileService::dispatcherMain()
+  {
+    const uint32_t queueDepth = m_backend->GetQueueDepth();
+    std::vector<AsyncFileCompletion> completions(queueDepth);
+    std::vector<std::unique_ptr<Batch>> freeBatches;
+    uint32_t inFlightCount = 0;
+
+    for (;;)
+    {
+      // 空いている分だけ取り出してまとめて発行する
+      while (inFlightCount < queueDepth)
+      {
+        std::unique_ptr<Batch> batch;
+        if (freeBatches.empty())
+        {
+          batch = std::make_unique<Batch>();
+        }
+        else
+        {
+          batch = std::move(freeBatches.back());
+          freeBatches.pop_back();
+        }
+
+        if (!popBatch(*batch))
+        {
+          freeBatches.emplace_back(std::move(batch));
+          break;
+        }
+
+        if (!submitBatch(*batch))
+        {
+          completeBatch(*batch, true);
+          freeBatches.emplace_back(std::move(batch));
+          continue;
+        }
+
+        batch.release();
+        ++inFlightCount;
+      }
+
+      m_backend->Flush();
+
+      if (inFlightCount == 0)
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        bool isEmpty = true;
+        for (const std::deque<Request>& queue : m_queues)
+        {
+          isEmpty = isEmpty && queue.empty();
+        }
+
+        if (m_isStopping && isEmpty)
+        {
+          return;
+        }
+      }
+
+      const size_t completionCount = m_backend->WaitCompletions(completions.data(), completions.size());
+      for (size_t i = 0; i < completionCount; ++i)
+      {
+        std::unique_ptr<Batch> batch(static_cast<Batch*>(completions[i].UserData));
+        const int64_t result = completions[i].Result;
+
+        if (result > 0)
+        {
+          batch->ReadSize += static_cast<uint64_t>(result);
+
+          // 短い読み込みは読めた分のバッファーを進めて続きを発行する(0なら終端)
+          if (batch->ReadSize < batch->Size)
+          {
+            uint64_t consumedSize = static_cast<uint64_t>(result);
+            while (consumedSize > 0 && consumedSize >= batch->Buffers[batch->FirstBuffer].Size)
+            {
+              consumedSize -= batch->Buffers[batch->FirstBuffer].Size;
+              ++batch->FirstBuffer;
+            }
+
+            AsyncFileBuffer& buffer = batch->Buffers[batch->FirstBuffer];
+            buffer.Data = static_cast<uint8_t*>(buffer.Data) + consumedSize;
+            buffer.Size -= static_cast<size_t>(consumedSize);
+
+            if (submitBatch(*batch))
+            {
+              batch.release();
+              continue;
+            }
+          }
+        }
+
+        completeBatch(*batch, result < 0);
+        freeBatches.emplace_back(std::move(batch));
+        --inFlightCount;
+      }
+    }
+  }
+
+  bool AsyncFileService::popBatch(Batch& batch)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (std::deque<Request>& queue : m_queues)
+    {
+      if (queue.empty())
+      {
+        continue;
+      }
+
+      batch.Requests.clear();
+      batch.Buffers.clear();
+      batch.Requests.emplace_back(std::move(queue.front()));
+      queue.pop_front();
+
+      // batch.Requestsへの追加で参照が無効になるので値で持つ
+      const uint32_t file = batch.Requests.front().File;
+      uint64_t begin = batch.Requests.front().Offset;
+      uint64_t end = begin + batch.Requests.front().Size;
+
+      // 同じ優先度で同じファイルの要求から、間がMaxCoalesceGap以内で重ならない範囲を前後に広げていく
+      std::vector<size_t> candidates;
+      const size_t scanCount = std::min(queue.size(), COALESCE_SCAN_LIMIT);
+      for (size_t i = 0; i < scanCount; ++i)
+      {
+        if (queue[i].File == file)
+        {
+          candidates.emplace_back(i);
+        }
+      }
+
+      std::vector<size_t> taken;
+      bool isExtended = !candidates.empty();
+      while (isExtended)
+      {
+        isExtended = false;
+        for (size_t& candidate : candidates)
+        {
+          if (candidate == SIZE_MAX)
+          {
+            continue;
+          }
+
+          const Request& request = queue[candidate];
+          const uint64_t requestEnd = request.Offset + request.Size;
+          const bool isAfter = (request.Offset >= end) && (request.Offset - end <= m_desc.MaxCoalesceGap) && (requestEnd - begin <= m_desc.MaxCoalesceSize);
+          const bool isBefore = (requestEnd <= begin) && (begin - requestEnd <= m_desc.MaxCoalesceGap) && (end - request.Offset <= m_desc.MaxCoalesceSize);
+          if (!isAfter && !isBefore)
+          {
+            continue;
+          }
+
+          begin = std::min(begin, request.Offset);
+          end = std::max(end, requestEnd);
+          taken.emplace_back(candidate);
+          candidate = SIZE_MAX;
+          isExtended = true;
+        }
+      }
+
+      // 後ろから取り除いて添字がずれないようにする
+      std::sort(taken.begin(), taken.end(), std::greater<size_t>());
+      for (const size_t index : taken)
+      {
+        batch.Requests.emplace_back(std::move(queue[index]));
+        queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(index));
+      }
+
+      std::sort(
+                batch.Requests.begin(),
+                batch.Requests.end(),
+                [](const Request& a, const Request& b)
+                {
+                  return a.Offset < b.Offset;
+                }
+              );
+
+      // 間は一つのバッファーに読み捨てる(同じ場所に何度読んでもよい)
+      uint64_t maxGapSize = 0;
+      uint64_t cursor = begin;
+      for (const Request& request : batch.Requests)
+      {
+        maxGapSize = std::max(maxGapSize, request.Offset - cursor);
+        cursor = request.Offset + request.Size;
+      }
+      batch.GapBuffer.resize(static_cast<size_t>(maxGapSize));
+
+      cursor = begin;
+      for (const Request& request : batch.Requests)
+      {
+        if (request.Offset > cursor)
+        {
+          batch.Buffers.emplace_back(AsyncFileBuffer{ batch.GapBuffer.data(), static_cast<size_t>(request.Offset - cursor) });
+        }
+        batch.Buffers.emplace_back(AsyncFileBuffer{ request.Buffer, static_cast<size_t>(request.Size) });
+        cursor = request.Offset + request.Size;
+      }
+
+      batch.NativeFile = m_files[file - 1].NativeFile;
+      batch.Offset = begin;
+      batch.Size = end - begin;
+      batch.ReadSize = 0;
+      batch.FirstBuffer = 0;
+
+      ++m_stats.ReadCount;
+      if (batch.Requests.size() > 1)
+      {
+        m_stats.CoalescedCount += batch.Requests.size();
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+  bool AsyncFileService::submitBatch(Batch& batch)
+  {
+    const AsyncFileOperation operation
+    {
+      batch.NativeFile,
+      batch.Offset + batch.ReadSize,
+      batch.Buffers.data() + batch.FirstBuffer,
+      static_cast<uint32_t>(batch.Buffers.size() - batch.FirstBuffer),
+      &batch,
+    };
+
+    return m_backend->Submit(operation);
+  }
+
+  void AsyncFileService::completeBatch(Batch& batch, bool isFailed)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stats.ReadBytes += batch.ReadSize;
+      for (const Request& request : batch.Requests)
+      {
+        releaseFile(request.File);
+      }
+    }
+
+    for (Request& request : batch.Requests)
+    {
+      // まとめた範囲のうち、この要求の分まで読めたか
+      const uint64_t relativeOffset = request.Offset - batch.Offset;
+      const uint64_t readSize = (batch.ReadSize > relativeOffset) ? std::min(request.Size, batch.ReadSize - relativeOffset) : 0;
+      completeRequest(request, AsyncFileResult{ request.Id, request.Buffer, request.Size, readSize, !isFailed && readSize == request.Size });
+    }
+
+    batch.Requests.clear();
+  }
+
+  void AsyncFileService::completeRequest(Request& request, const AsyncFileResult& result)
+  {
+    if (m_callbackPool == nullptr)
+    {
+      request.OnComplete(result);
+      finishRequest();
+      return;
+    }
+
+    m_callbackPool->Submit(
+                            [this, callback = std::move(request.OnComplete), result]()
+                            {
+                              callback(result);
+                              finishRequest();
+                            }
+                          );
+  }
+
+  void AsyncFileService::finishRequest()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_outstandingCount;
+    if (m_outstandingCount == 0)
+    {
+      m_idleCondition.notify_all();
+    }
+  }
+
+  void AsyncFileService::releaseFile(uint32_t file)
+  {
+    FileEntry& entry = m_files[file - 1];
+    --entry.PendingCount;
+    if (entry.PendingCount == 0 && entry.IsClosing)
+    {
+      closeNativeFile(entry.NativeFile);
+      entry.IsOpen = false;
+      entry.IsClosing = false;
+    }
+  }
+}
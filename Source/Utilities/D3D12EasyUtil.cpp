@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : D3D12Library Easy Utilities
 
 Update History: 2024/11/19 Create
+                2026/10/19 Fix AlignmentedSize for already aligned sizes
 
 Version : alpha_1.0.0
 
@@ -15,10 +16,15 @@ Encoding : UTF-8
 
 #include <D3D12EasyUtil.h>
 
+#include <cassert>
+
 namespace MFramework
 {
   size_t D3D12EasyUtility::AlignmentedSize(size_t size, size_t alignment)
   {
-    return size + alignment - size % alignment;
+    assert(alignment != 0);
+
+    // すでに揃っているサイズはそのまま返す
+    return (size + alignment - 1) / alignment * alignment;
   }
 }
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by an OS directory
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <DirectoryFileMount.h>
+
+#include <AssetArchiveFormat.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  // パスはUTF-8として扱う(MappedFileと同じ)
+  std::filesystem::path toPath(const std::string& utf8Path)
+  {
+    return std::filesystem::path(std::u8string(utf8Path.begin(), utf8Path.end()));
+  }
+
+  std::string toUtf8(const std::filesystem::path& path)
+  {
+    const std::u8string utf8Path = path.generic_u8string();
+    return std::string(utf8Path.begin(), utf8Path.end());
+  }
+}
+
+namespace MFramework
+{
+  DirectoryFileMount::DirectoryFileMount()
+    : m_directoryPath()
+    , m_entries()
+    , m_index()
+  { }
+
+  DirectoryFileMount::~DirectoryFileMount()
+  {
+    Dispose();
+  }
+
+  bool DirectoryFileMount::Init(const std::string& directoryPath, bool isRecursive)
+  {
+    Dispose();
+
+    const std::filesystem::path directory = toPath(directoryPath);
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error))
+    {
+      return false;
+    }
+
+    auto addEntry = [this, &directory](const std::filesystem::directory_entry& entry)
+                    {
+                      std::error_code entryError;
+                      if (!entry.is_regular_file(entryError))
+                      {
+                        return;
+                      }
+
+                      const uint64_t size = entry.file_size(entryError);
+                      if (entryError)
+                      {
+                        return;
+                      }
+
+                      m_entries.emplace_back(Entry{ AssetArchiveFormat::NormalizePath(toUtf8(entry.path().lexically_relative(directory))), toUtf8(entry.path()), size });
+                    };
+
+    if (isRecursive)
+    {
+      for (std::filesystem::recursive_directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, error), end; !error && it != end; it.increment(error))
+      {
+        addEntry(*it);
+      }
+    }
+    else
+    {
+      for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+      {
+        addEntry(*it);
+      }
+    }
+
+    if (error)
+    {
+      Dispose();
+      return false;
+    }
+
+    // 走査の順番はOSによって違うのでパス順にそろえる(同じパスになったものは先の一つだけ残す)
+    std::stable_sort(
+                      m_entries.begin(),
+                      m_entries.end(),
+                      [](const Entry& a, const Entry& b)
+                      {
+                        return (a.Path != b.Path) ? (a.Path < b.Path) : (a.NativePath < b.NativePath);
+                      }
+                    );
+    m_entries.erase(
+                    std::unique(
+                                m_entries.begin(),
+                                m_entries.end(),
+                                [](const Entry& a, const Entry& b)
+                                {
+                                  return a.Path == b.Path;
+                                }
+                              ),
+                    m_entries.end()
+                  );
+
+    m_index.reserve(m_entries.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); ++i)
+    {
+      m_index.emplace(AssetArchiveFormat::ComputePathHash(m_entries[i].Path), i);
+    }
+
+    m_directoryPath = directoryPath;
+    return true;
+  }
+
+  uint32_t DirectoryFileMount::Find(std::string_view normalizedPath, uint64_t pathHash) const
+  {
+    const auto range = m_index.equal_range(pathHash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (m_entries[it->second].Path == normalizedPath)
+      {
+        return it->second;
+      }
+    }
+
+    return INVALID_INDEX;
+  }
+
+  uint32_t DirectoryFileMount::GetCount() const
+  {
+    return static_cast<uint32_t>(m_entries.size());
+  }
+
+  std::string_view DirectoryFileMount::GetPath(uint32_t index) const
+  {
+    return (index < m_entries.size()) ? std::string_view(m_entries[index].Path) : std::string_view();
+  }
+
+  uint64_t DirectoryFileMount::GetSize(uint32_t index) const
+  {
+    return (index < m_entries.size()) ? m_entries[index].Size : 0;
+  }
+
+  AssetView DirectoryFileMount::GetView(uint32_t) const
+  {
+    return AssetView{ nullptr, 0 };
+  }
+
+  bool DirectoryFileMount::Read(uint32_t index, uint8_t* dst, size_t dstSize) const
+  {
+    if (index >= m_entries.size() || dstSize < m_entries[index].Size || (dst == nullptr && m_entries[index].Size != 0))
+    {
+      return false;
+    }
+
+    std::ifstream stream(toPath(m_entries[index].NativePath), std::ios::binary);
+    if (!stream.is_open())
+    {
+      return false;
+    }
+
+    stream.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(m_entries[index].Size));
+    return static_cast<uint64_t>(stream.gcount()) == m_entries[index].Size;
+  }
+
+  bool DirectoryFileMount::GetNativePath(uint32_t index, std::string& outPath) const
+  {
+    if (index >= m_entries.size())
+    {
+      return false;
+    }
+
+    outPath = m_entries[index].NativePath;
+    return true;
+  }
+
+  void DirectoryFileMount::Dispose() noexcept
+  {
+    m_directoryPath.clear();
+    m_entries.clear();
+    m_index.clear();
+  }
+}
@@ -6,6 +6,7 @@ Author : MAI ZHICONG
 Description : File Utilities
 
 Update History: 2024/11/10 Create
+                2026/10/19 Cache resolved paths and drop Shlwapi
 
 Version : alpha_1.0.0
 
@@ -15,20 +16,62 @@ Encoding : UTF-8
 
 #include <FileUtil.h>
 
-#include <wchar.h>
-#include <Shlwapi.h>
-#pragma comment(lib, "shlwapi.lib")
+#include <filesystem>
+#include <mutex>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#endif
 
 namespace
 {
-  constexpr int DESTINATION_PATH_BUFFER_LENGTH = 520;
-  const wchar_t FILE_ROOT_PATH[][520] =
+  constexpr size_t INITIAL_MODULE_PATH_LENGTH = 260;
+
+  // 実行ファイルのディレクトリからの相対パス(空なら渡されたパスをそのまま使う)
+  const wchar_t* const FILE_ROOT_PATH[] =
   {
+    nullptr,
     L"",
-    L"%s\\%s",
-    L"%s\\..\\..\\%s",
-    L"%s\\..\\..\\Assets\\Images\\%s",
+    L"../..",
+    L"../../Assets/Images",
   };
+
+  std::mutex g_searchCacheMutex;
+  std::unordered_map<std::wstring, std::wstring> g_searchCache;
+
+  std::filesystem::path getExecutablePath()
+  {
+    #ifdef _WIN32
+      // MAX_PATHを超えるパスでは切り詰められるので、収まるまでバッファーを広げる
+      std::vector<wchar_t> buffer(INITIAL_MODULE_PATH_LENGTH);
+      for (;;)
+      {
+        const DWORD length = ::GetModuleFileNameW(nullptr, buffer.data(), static_cast<DWORD>(buffer.size()));
+        if (length == 0)
+        {
+          return {};
+        }
+        if (length < buffer.size())
+        {
+          return std::filesystem::path(std::wstring(buffer.data(), length));
+        }
+        buffer.resize(buffer.size() * 2);
+      }
+    #else
+      std::error_code errorCode;
+      const std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", errorCode);
+      return errorCode ? std::filesystem::path() : path;
+    #endif
+  }
+
+  bool isFileExists(const std::filesystem::path& path)
+  {
+    std::error_code errorCode;
+    return std::filesystem::exists(path, errorCode);
+  }
 }
 
 namespace MFramework
@@ -40,58 +83,50 @@ namespace MFramework
       return false;
     }
 
-    if (wcscmp(fileName, L"") == 0 || (fileName[0] == (L" "[0])))
+    if (fileName[0] == L'\0' || fileName[0] == L' ')
     {
       return false;
     }
 
-    wchar_t exePath[DESTINATION_PATH_BUFFER_LENGTH] = {};
-    GetModuleFileName(nullptr, exePath, DESTINATION_PATH_BUFFER_LENGTH);
-    exePath[DESTINATION_PATH_BUFFER_LENGTH - 1] = L'\0';
-    PathRemoveFileSpec(exePath);
-
-    wchar_t destPath[DESTINATION_PATH_BUFFER_LENGTH] = {};
+    const std::wstring key(fileName);
 
-    for (const auto rootPath : FILE_ROOT_PATH)
     {
-      swprintf_s(destPath, rootPath, exePath, fileName);
-      if (PathFileExists(destPath))
+      std::lock_guard<std::mutex> lock(g_searchCacheMutex);
+      const auto it = g_searchCache.find(key);
+      if (it != g_searchCache.end())
       {
-        filePath = destPath;
+        filePath = it->second;
         return true;
       }
     }
 
-    // wcscpy_s(destPath, fileName);
-    // if (PathFileExists(destPath))
-    // {
-    //   filePath = destPath;
-    //   return true;
-    // }
-    
-    // swprintf_s(destPath, L"%s\\%s", exePath, fileName);
-    // if (PathFileExists(destPath))
-    // {
-    //   filePath = destPath;
-    //   return true;
-    // }
-
-    // swprintf_s(destPath, L"%s\\..\\..\\%s", exePath, fileName);
-    // if (PathFileExists(destPath)) 
-    // {
-    //   filePath = destPath;
-    //   return true;
-    // }
-
-    // swprintf_s(destPath, L"%s\\..\\..\\Assets\\Images\\%s", exePath, fileName);
-    // if (PathFileExists(destPath)) 
-    // {
-    //   filePath = destPath;
-    //   return true;
-    // }
+    // 見つからなかった結果は残さない(後から作られるファイルを探す場合があるため)
+    const std::filesystem::path exeDirectory(GetExecutableDirectory());
+    for (const wchar_t* rootPath : FILE_ROOT_PATH)
+    {
+      const std::filesystem::path candidate = (rootPath == nullptr) ? std::filesystem::path(key) : (exeDirectory / rootPath / key);
+      if (isFileExists(candidate))
+      {
+        filePath = candidate.lexically_normal().make_preferred().wstring();
+
+        std::lock_guard<std::mutex> lock(g_searchCacheMutex);
+        g_searchCache.insert_or_assign(key, filePath);
+        return true;
+      }
+    }
 
     return false;
+  }
 
+  void FileUtility::ClearSearchCache()
+  {
+    std::lock_guard<std::mutex> lock(g_searchCacheMutex);
+    g_searchCache.clear();
   }
 
-}
\ No newline at end of file
+  const std::wstring& FileUtility::GetExecutableDirectory()
+  {
+    static const std::wstring exeDirectory = getExecutablePath().parent_path().wstring();
+    return exeDirectory;
+  }
+}
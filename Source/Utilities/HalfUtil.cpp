@@ -0,0 +1,110 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Half float Utilities
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <HalfUtil.h>
+
+#include <cstring>
+
+namespace MFramework
+{
+  uint16_t HalfUtility::FloatToHalf(float value)
+  {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t absBits = bits & 0x7fffffffu;
+
+    // NaNと無限大
+    if (absBits >= 0x7f800000u)
+    {
+      return static_cast<uint16_t>(sign | 0x7c00u | (absBits > 0x7f800000u ? 0x0200u : 0u));
+    }
+
+    // 半精度で表せない大きさは無限大にする(65520以上は丸めると溢れる)
+    if (absBits >= 0x477ff000u)
+    {
+      return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+
+    // 半精度の非正規化数になる範囲
+    if (absBits < 0x38800000u)
+    {
+      // 非正規化数の最小値の半分未満は0
+      if (absBits < 0x33000000u)
+      {
+        return sign;
+      }
+
+      const uint32_t exponent = absBits >> 23;
+      const uint32_t mantissa = (absBits & 0x007fffffu) | 0x00800000u;
+      const uint32_t shift = 126u - exponent;     // 2^-24単位に合わせるシフト量
+      uint32_t half = mantissa >> shift;
+      const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+      const uint32_t halfway = 1u << (shift - 1u);
+      if (remainder > halfway || (remainder == halfway && (half & 1u) != 0))
+      {
+        ++half;
+      }
+      return static_cast<uint16_t>(sign | half);
+    }
+
+    // 正規化数(指数のバイアスを付け替えて仮数を13bit落とす)
+    uint32_t half = ((absBits - 0x38000000u) >> 13);
+    const uint32_t remainder = absBits & 0x1fffu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u) != 0))
+    {
+      ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+  }
+
+  float HalfUtility::HalfToFloat(uint16_t value)
+  {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x03ffu;
+
+    uint32_t bits = 0;
+    if (exponent == 0x1fu)
+    {
+      // NaNと無限大
+      bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+      bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0)
+    {
+      // 非正規化数を正規化する
+      exponent = 113u;
+      while ((mantissa & 0x0400u) == 0)
+      {
+        mantissa <<= 1;
+        --exponent;
+      }
+      bits = sign | (exponent << 23) | ((mantissa & 0x03ffu) << 13);
+    }
+    else
+    {
+      bits = sign;
+    }
+
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+}
@@ -0,0 +1,111 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Hash Utilities
+
+Update History: 2026/10/19 Create
+                2026/10/19 Add Crc32
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <HashUtil.h>
+
+namespace
+{
+  struct Crc32Table
+  {
+    uint32_t Values[256];
+  };
+
+  const Crc32Table& getCrc32Table()
+  {
+    static const Crc32Table table = []()
+    {
+      Crc32Table result{};
+      for (uint32_t i = 0; i < 256; ++i)
+      {
+        uint32_t value = i;
+        for (uint32_t bit = 0; bit < 8; ++bit)
+        {
+          value = (value & 1u) ? (0xedb88320u ^ (value >> 1)) : (value >> 1);
+        }
+        result.Values[i] = value;
+      }
+      return result;
+    }();
+
+    return table;
+  }
+}
+
+namespace MFramework
+{
+  uint64_t HashUtility::Fnv1a64(const void* data, size_t size, uint64_t seed)
+  {
+    if (data == nullptr)
+    {
+      return seed;
+    }
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= FNV_PRIME;
+    }
+
+    return hash;
+  }
+
+  uint64_t HashUtility::Fnv1a64String(const char* str, uint64_t seed)
+  {
+    if (str == nullptr)
+    {
+      return seed;
+    }
+
+    uint64_t hash = seed;
+
+    for (; *str != '\0'; ++str)
+    {
+      hash ^= static_cast<uint8_t>(*str);
+      hash *= FNV_PRIME;
+    }
+
+    return hash;
+  }
+
+  uint32_t HashUtility::Crc32(const void* data, size_t size, uint32_t crc)
+  {
+    if (data == nullptr)
+    {
+      return crc;
+    }
+
+    const Crc32Table& table = getCrc32Table();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t value = ~crc;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      value = table.Values[(value ^ bytes[i]) & 0xffu] ^ (value >> 8);
+    }
+
+    return ~value;
+  }
+
+  uint64_t HashUtility::Combine(uint64_t seed, uint64_t value)
+  {
+    // boost::hash_combineの64bit版
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 12) + (seed >> 4);
+    return seed;
+  }
+}
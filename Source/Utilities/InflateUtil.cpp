@@ -0,0 +1,593 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Deflate decompression Utilities
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <InflateUtil.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  constexpr uint32_t MAX_CODE_LENGTH = 15;
+  constexpr uint32_t FAST_BITS = 10;              // 一回の表引きで解決する符号長
+  constexpr uint32_t LITERAL_LENGTH_CODE_COUNT = 288;
+  constexpr uint32_t DISTANCE_CODE_COUNT = 32;
+  constexpr uint32_t CODE_LENGTH_CODE_COUNT = 19;
+  constexpr uint32_t END_OF_BLOCK = 256;
+  constexpr uint32_t WINDOW_SIZE = 32768;
+  constexpr uint32_t ADLER_MODULO = 65521;
+  constexpr size_t ADLER_BLOCK_SIZE = 5552;       // 32bitで溢れない最大の回数
+
+  constexpr uint16_t LENGTH_BASE[29] =
+  {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+  };
+  constexpr uint8_t LENGTH_EXTRA_BITS[29] =
+  {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+  };
+  constexpr uint16_t DISTANCE_BASE[30] =
+  {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+  };
+  constexpr uint8_t DISTANCE_EXTRA_BITS[30] =
+  {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+  };
+  constexpr uint8_t CODE_LENGTH_ORDER[CODE_LENGTH_CODE_COUNT] =
+  {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+  };
+
+  /// @brief
+  /// 下位ビットから読むビットリーダー
+  /// 終端を越えた分は0として読み、越えたかどうかは最後にまとめて確認する
+  class BitReader
+  {
+    public:
+      BitReader(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+        , m_position(0)
+        , m_buffer(0)
+        , m_bitCount(0)
+        , m_consumedBits(0)
+      { }
+
+      uint32_t Peek(uint32_t count)
+      {
+        if (m_bitCount < count)
+        {
+          refill();
+        }
+        return static_cast<uint32_t>(m_buffer & ((1ull << count) - 1));
+      }
+
+      void Consume(uint32_t count)
+      {
+        m_buffer >>= count;
+        m_bitCount -= count;
+        m_consumedBits += count;
+      }
+
+      uint32_t Read(uint32_t count)
+      {
+        if (count == 0)
+        {
+          return 0;
+        }
+
+        const uint32_t value = Peek(count);
+        Consume(count);
+        return value;
+      }
+
+      void AlignToByte()
+      {
+        Consume(static_cast<uint32_t>(m_consumedBits % 8 == 0 ? 0 : 8 - m_consumedBits % 8));
+      }
+
+      bool IsOverrun() const
+      {
+        return m_consumedBits > static_cast<uint64_t>(m_size) * 8;
+      }
+
+      size_t GetConsumedBytes() const
+      {
+        return static_cast<size_t>((m_consumedBits + 7) / 8);
+      }
+
+    private:
+      void refill()
+      {
+        while (m_bitCount <= 56)
+        {
+          const uint64_t byte = (m_position < m_size) ? m_data[m_position] : 0;
+          ++m_position;
+          m_buffer |= byte << m_bitCount;
+          m_bitCount += 8;
+        }
+      }
+
+    private:
+      const uint8_t* m_data;
+      size_t m_size;
+      size_t m_position;
+      uint64_t m_buffer;
+      uint32_t m_bitCount;
+      uint64_t m_consumedBits;
+  };
+
+  /// @brief
+  /// 符号長から作るカノニカルハフマン表
+  /// 短い符号は表引き、長い符号は一ビットずつ調べる
+  struct HuffmanTable
+  {
+    uint16_t Fast[1u << FAST_BITS];     // (符号長 << 9) | シンボル、0なら表にない
+    uint16_t Counts[MAX_CODE_LENGTH + 1];
+    uint16_t Symbols[LITERAL_LENGTH_CODE_COUNT];
+
+    bool Build(const uint8_t* lengths, uint32_t count)
+    {
+      std::memset(Fast, 0, sizeof(Fast));
+      std::memset(Counts, 0, sizeof(Counts));
+
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        ++Counts[lengths[i]];
+      }
+      Counts[0] = 0;
+
+      // 符号が足りすぎていないか(足りない分は使われない符号として許す)
+      int32_t remaining = 1;
+      for (uint32_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+      {
+        remaining = (remaining << 1) - Counts[length];
+        if (remaining < 0)
+        {
+          return false;
+        }
+      }
+
+      uint16_t offsets[MAX_CODE_LENGTH + 2] = {};
+      for (uint32_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+      {
+        offsets[length + 1] = static_cast<uint16_t>(offsets[length] + Counts[length]);
+      }
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        if (lengths[i] != 0)
+        {
+          Symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+        }
+      }
+
+      // 表引き用(符号は上位ビットから詰まっているので反転して下位から読めるようにする)
+      uint32_t code = 0;
+      uint32_t index = 0;
+      for (uint32_t length = 1; length <= FAST_BITS; ++length)
+      {
+        for (uint32_t i = 0; i < Counts[length]; ++i, ++code, ++index)
+        {
+          uint32_t reversed = 0;
+          for (uint32_t bit = 0; bit < length; ++bit)
+          {
+            reversed |= ((code >> bit) & 1u) << (length - 1 - bit);
+          }
+          const uint16_t entry = static_cast<uint16_t>((length << 9) | Symbols[index]);
+          for (uint32_t j = reversed; j < (1u << FAST_BITS); j += (1u << length))
+          {
+            Fast[j] = entry;
+          }
+        }
+        code <<= 1;
+      }
+
+      return true;
+    }
+
+    /// @return シンボル(符号が不正なら-1)
+    int32_t Decode(BitReader& reader) const
+    {
+      const uint16_t entry = Fast[reader.Peek(FAST_BITS)];
+      if (entry != 0)
+      {
+        reader.Consume(entry >> 9);
+        return entry & 0x1ff;
+      }
+
+      // 長い符号
+      int32_t code = 0;
+      int32_t first = 0;
+      int32_t index = 0;
+      for (uint32_t length = 1; length <= MAX_CODE_LENGTH; ++length)
+      {
+        code |= static_cast<int32_t>(reader.Read(1));
+        const int32_t count = Counts[length];
+        if (code - first < count)
+        {
+          return Symbols[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+      }
+
+      return -1;
+    }
+  };
+
+  /// @brief
+  /// 展開先(必要に応じて倍に伸ばす)
+  class OutputBuffer
+  {
+    public:
+      OutputBuffer(std::vector<uint8_t>& data, size_t expectedSize)
+        : m_data(data)
+        , m_size(0)
+      {
+        m_data.resize(expectedSize > 0 ? expectedSize : WINDOW_SIZE);
+      }
+
+      void Reserve(size_t count)
+      {
+        if (m_size + count > m_data.size())
+        {
+          m_data.resize(std::max(m_data.size() * 2, m_size + count));
+        }
+      }
+
+      void Put(uint8_t value)
+      {
+        Reserve(1);
+        m_data[m_size++] = value;
+      }
+
+      bool Copy(uint32_t distance, uint32_t length)
+      {
+        if (distance > m_size)
+        {
+          return false;
+        }
+
+        Reserve(length);
+        uint8_t* dst = m_data.data() + m_size;
+        const uint8_t* src = dst - distance;
+        if (distance >= length)
+        {
+          std::memcpy(dst, src, length);
+        }
+        else
+        {
+          // 重なっている場合は一バイトずつ(繰り返しパターンになる)
+          for (uint32_t i = 0; i < length; ++i)
+          {
+            dst[i] = src[i];
+          }
+        }
+        m_size += length;
+        return true;
+      }
+
+      void Finish()
+      {
+        m_data.resize(m_size);
+      }
+
+    private:
+      std::vector<uint8_t>& m_data;
+      size_t m_size;
+  };
+
+  bool decodeBlock(BitReader& reader, const HuffmanTable& literalTable, const HuffmanTable& distanceTable, OutputBuffer& output, std::string& outError)
+  {
+    for (;;)
+    {
+      const int32_t symbol = literalTable.Decode(reader);
+      if (symbol < 0)
+      {
+        outError = "invalid literal/length code";
+        return false;
+      }
+
+      if (symbol < static_cast<int32_t>(END_OF_BLOCK))
+      {
+        output.Put(static_cast<uint8_t>(symbol));
+        continue;
+      }
+
+      if (symbol == static_cast<int32_t>(END_OF_BLOCK))
+      {
+        return true;
+      }
+
+      const uint32_t lengthIndex = static_cast<uint32_t>(symbol) - 257;
+      if (lengthIndex >= 29)
+      {
+        outError = "invalid length symbol";
+        return false;
+      }
+      const uint32_t length = LENGTH_BASE[lengthIndex] + reader.Read(LENGTH_EXTRA_BITS[lengthIndex]);
+
+      const int32_t distanceSymbol = distanceTable.Decode(reader);
+      if (distanceSymbol < 0 || distanceSymbol >= 30)
+      {
+        outError = "invalid distance code";
+        return false;
+      }
+      const uint32_t distance = DISTANCE_BASE[distanceSymbol] + reader.Read(DISTANCE_EXTRA_BITS[distanceSymbol]);
+
+      if (!output.Copy(distance, length))
+      {
+        outError = "distance too far back";
+        return false;
+      }
+
+      if (reader.IsOverrun())
+      {
+        outError = "unexpected end of data";
+        return false;
+      }
+    }
+  }
+
+  bool readDynamicTables(BitReader& reader, HuffmanTable& outLiteralTable, HuffmanTable& outDistanceTable, std::string& outError)
+  {
+    const uint32_t literalCount = reader.Read(5) + 257;
+    const uint32_t distanceCount = reader.Read(5) + 1;
+    const uint32_t codeLengthCount = reader.Read(4) + 4;
+    if (literalCount > 286 || distanceCount > 30)
+    {
+      outError = "invalid dynamic block header";
+      return false;
+    }
+
+    uint8_t codeLengthLengths[CODE_LENGTH_CODE_COUNT] = {};
+    for (uint32_t i = 0; i < codeLengthCount; ++i)
+    {
+      codeLengthLengths[CODE_LENGTH_ORDER[i]] = static_cast<uint8_t>(reader.Read(3));
+    }
+
+    HuffmanTable codeLengthTable{};
+    if (!codeLengthTable.Build(codeLengthLengths, CODE_LENGTH_CODE_COUNT))
+    {
+      outError = "invalid code length table";
+      return false;
+    }
+
+    // 符号長とリピート(16 : 直前を3-6回、17 : 0を3-10回、18 : 0を11-138回)
+    uint8_t lengths[LITERAL_LENGTH_CODE_COUNT + DISTANCE_CODE_COUNT] = {};
+    uint32_t index = 0;
+    while (index < literalCount + distanceCount)
+    {
+      const int32_t symbol = codeLengthTable.Decode(reader);
+      if (symbol < 0 || reader.IsOverrun())
+      {
+        outError = "invalid code length";
+        return false;
+      }
+
+      if (symbol < 16)
+      {
+        lengths[index++] = static_cast<uint8_t>(symbol);
+        continue;
+      }
+
+      uint8_t value = 0;
+      uint32_t repeat = 0;
+      if (symbol == 16)
+      {
+        if (index == 0)
+        {
+          outError = "repeat without previous length";
+          return false;
+        }
+        value = lengths[index - 1];
+        repeat = 3 + reader.Read(2);
+      }
+      else if (symbol == 17)
+      {
+        repeat = 3 + reader.Read(3);
+      }
+      else
+      {
+        repeat = 11 + reader.Read(7);
+      }
+
+      if (index + repeat > literalCount + distanceCount)
+      {
+        outError = "code lengths overflow";
+        return false;
+      }
+      std::memset(lengths + index, value, repeat);
+      index += repeat;
+    }
+
+    if (lengths[END_OF_BLOCK] == 0)
+    {
+      outError = "missing end of block code";
+      return false;
+    }
+
+    if (!outLiteralTable.Build(lengths, literalCount) || !outDistanceTable.Build(lengths + literalCount, distanceCount))
+    {
+      outError = "invalid huffman table";
+      return false;
+    }
+
+    return true;
+  }
+
+  void buildFixedTables(HuffmanTable& outLiteralTable, HuffmanTable& outDistanceTable)
+  {
+    uint8_t lengths[LITERAL_LENGTH_CODE_COUNT] = {};
+    std::memset(lengths, 8, 144);
+    std::memset(lengths + 144, 9, 112);
+    std::memset(lengths + 256, 7, 24);
+    std::memset(lengths + 280, 8, 8);
+    outLiteralTable.Build(lengths, LITERAL_LENGTH_CODE_COUNT);
+
+    std::memset(lengths, 5, DISTANCE_CODE_COUNT);
+    outDistanceTable.Build(lengths, DISTANCE_CODE_COUNT);
+  }
+}
+
+namespace MFramework
+{
+  bool InflateUtility::DecompressZlib(const uint8_t* src, size_t size, std::vector<uint8_t>& outData, std::string& outError, size_t expectedSize)
+  {
+    if (src == nullptr || size < 6)
+    {
+      outError = "zlib stream too short";
+      return false;
+    }
+
+    // CMF/FLG(圧縮方式8、ヘッダーのチェックサム、辞書なし)
+    const uint32_t cmf = src[0];
+    const uint32_t flags = src[1];
+    if ((cmf & 0x0f) != 8 || ((cmf << 8) | flags) % 31 != 0 || (flags & 0x20) != 0)
+    {
+      outError = "unsupported zlib header";
+      return false;
+    }
+
+    size_t consumed = 0;
+    if (!Decompress(src + 2, size - 2, outData, outError, expectedSize, &consumed))
+    {
+      return false;
+    }
+
+    const size_t adlerOffset = 2 + consumed;
+    if (adlerOffset + 4 > size)
+    {
+      outError = "missing adler32";
+      return false;
+    }
+
+    const uint32_t expectedAdler = (static_cast<uint32_t>(src[adlerOffset]) << 24) |
+                                   (static_cast<uint32_t>(src[adlerOffset + 1]) << 16) |
+                                   (static_cast<uint32_t>(src[adlerOffset + 2]) << 8) |
+                                   static_cast<uint32_t>(src[adlerOffset + 3]);
+    if (Adler32(outData.data(), outData.size()) != expectedAdler)
+    {
+      outError = "adler32 mismatch";
+      return false;
+    }
+
+    return true;
+  }
+
+  bool InflateUtility::Decompress(const uint8_t* src, size_t size, std::vector<uint8_t>& outData, std::string& outError, size_t expectedSize, size_t* outConsumedSize)
+  {
+    if (src == nullptr)
+    {
+      outError = "null source";
+      return false;
+    }
+
+    BitReader reader(src, size);
+    OutputBuffer output(outData, expectedSize);
+    HuffmanTable literalTable{};
+    HuffmanTable distanceTable{};
+
+    bool isFinal = false;
+    while (!isFinal)
+    {
+      isFinal = (reader.Read(1) != 0);
+      const uint32_t type = reader.Read(2);
+
+      if (type == 0)
+      {
+        // 非圧縮ブロック
+        reader.AlignToByte();
+        const uint32_t length = reader.Read(16);
+        const uint32_t inverted = reader.Read(16);
+        if ((length ^ 0xffffu) != inverted)
+        {
+          outError = "stored block length mismatch";
+          return false;
+        }
+
+        output.Reserve(length);
+        for (uint32_t i = 0; i < length; ++i)
+        {
+          output.Put(static_cast<uint8_t>(reader.Read(8)));
+        }
+      }
+      else if (type == 1 || type == 2)
+      {
+        if (type == 1)
+        {
+          buildFixedTables(literalTable, distanceTable);
+        }
+        else if (!readDynamicTables(reader, literalTable, distanceTable, outError))
+        {
+          return false;
+        }
+
+        if (!decodeBlock(reader, literalTable, distanceTable, output, outError))
+        {
+          return false;
+        }
+      }
+      else
+      {
+        outError = "invalid block type";
+        return false;
+      }
+
+      if (reader.IsOverrun())
+      {
+        outError = "unexpected end of data";
+        return false;
+      }
+    }
+
+    output.Finish();
+
+    if (outConsumedSize != nullptr)
+    {
+      *outConsumedSize = reader.GetConsumedBytes();
+    }
+
+    return true;
+  }
+
+  uint32_t InflateUtility::Adler32(const uint8_t* data, size_t size, uint32_t adler)
+  {
+    uint32_t a = adler & 0xffffu;
+    uint32_t b = adler >> 16;
+
+    while (size > 0)
+    {
+      const size_t blockSize = (size < ADLER_BLOCK_SIZE) ? size : ADLER_BLOCK_SIZE;
+      for (size_t i = 0; i < blockSize; ++i)
+      {
+        a += data[i];
+        b += a;
+      }
+      a %= ADLER_MODULO;
+      b %= ADLER_MODULO;
+      data += blockSize;
+      size -= blockSize;
+    }
+
+    return (b << 16) | a;
+  }
+}
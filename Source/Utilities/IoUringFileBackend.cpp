@@ -0,0 +1,382 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : io_uring asynchronous file read backend (Linux)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <IoUringFileBackend.h>
+
+#ifdef __linux__
+  #include <atomic>
+  #include <cerrno>
+  #include <cstring>
+
+  #include <linux/io_uring.h>
+  #include <poll.h>
+  #include <sys/eventfd.h>
+  #include <sys/mman.h>
+  #include <sys/syscall.h>
+  #include <sys/uio.h>
+  #include <unistd.h>
+#endif
+
+#ifdef __linux__
+
+namespace
+{
+  // Wake用のPOLL_ADDの完了を見分ける値(読み込みのUserDataはポインターなので重ならない)
+  constexpr uint64_t WAKE_USER_DATA = ~0ULL;
+
+  static_assert(sizeof(MFramework::AsyncFileBuffer) == sizeof(iovec), "AsyncFileBuffer must match iovec");
+  static_assert(offsetof(MFramework::AsyncFileBuffer, Size) == offsetof(iovec, iov_len), "AsyncFileBuffer must match iovec");
+
+  int ioUringSetup(uint32_t entryCount, io_uring_params* params)
+  {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entryCount, params));
+  }
+
+  int ioUringEnter(int ringDescriptor, uint32_t submitCount, uint32_t minComplete, uint32_t flags)
+  {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ringDescriptor, submitCount, minComplete, flags, nullptr, 0));
+  }
+
+  // リングのヘッドとテイルはカーネルと共有しているので、相手側が書く値は獲得、自分が書く値は解放で読み書きする
+  uint32_t loadAcquire(uint32_t* value)
+  {
+    return std::atomic_ref<uint32_t>(*value).load(std::memory_order_acquire);
+  }
+
+  void storeRelease(uint32_t* value, uint32_t newValue)
+  {
+    std::atomic_ref<uint32_t>(*value).store(newValue, std::memory_order_release);
+  }
+
+  void* mapRing(int ringDescriptor, size_t size, off_t offset)
+  {
+    void* ring = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringDescriptor, offset);
+    return (ring == MAP_FAILED) ? nullptr : ring;
+  }
+}
+
+#endif
+
+namespace MFramework
+{
+  IoUringFileBackend::IoUringFileBackend()
+    : m_ringDescriptor(-1)
+    , m_wakeDescriptor(-1)
+    , m_queueDepth(0)
+    , m_pendingSubmitCount(0)
+    , m_submitRing(nullptr)
+    , m_submitRingSize(0)
+    , m_completeRing(nullptr)
+    , m_completeRingSize(0)
+    , m_submitEntries(nullptr)
+    , m_submitEntriesSize(0)
+    , m_submitHead(nullptr)
+    , m_submitTail(nullptr)
+    , m_submitMask(0)
+    , m_submitEntryCount(0)
+    , m_submitArray(nullptr)
+    , m_completeHead(nullptr)
+    , m_completeTail(nullptr)
+    , m_completeMask(0)
+    , m_completeEntries(nullptr)
+  { }
+
+  IoUringFileBackend::~IoUringFileBackend()
+  {
+    Dispose();
+  }
+
+  const char* IoUringFileBackend::GetName() const
+  {
+    return "io_uring";
+  }
+
+  uint32_t IoUringFileBackend::GetQueueDepth() const
+  {
+    return m_queueDepth;
+  }
+
+  #ifdef __linux__
+
+  bool IoUringFileBackend::Init(uint32_t queueDepth)
+  {
+    if (m_ringDescriptor >= 0 || queueDepth == 0)
+    {
+      return false;
+    }
+
+    // Wake用のPOLL_ADDの分を一つ多く取る
+    io_uring_params params{};
+    m_ringDescriptor = ioUringSetup(queueDepth + 1, &params);
+    if (m_ringDescriptor < 0)
+    {
+      m_ringDescriptor = -1;
+      return false;
+    }
+
+    m_submitRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    m_completeRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_submitEntriesSize = params.sq_entries * sizeof(io_uring_sqe);
+
+    // 古いカーネルでは送信側と完了側のリングを別々にマップする
+    const bool isSingleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (isSingleMap)
+    {
+      m_submitRingSize = (m_submitRingSize > m_completeRingSize) ? m_submitRingSize : m_completeRingSize;
+      m_completeRingSize = 0;
+    }
+
+    m_submitRing = mapRing(m_ringDescriptor, m_submitRingSize, IORING_OFF_SQ_RING);
+    m_completeRing = isSingleMap ? m_submitRing : mapRing(m_ringDescriptor, m_completeRingSize, IORING_OFF_CQ_RING);
+    m_submitEntries = mapRing(m_ringDescriptor, m_submitEntriesSize, IORING_OFF_SQES);
+    if (m_submitRing == nullptr || m_completeRing == nullptr || m_submitEntries == nullptr)
+    {
+      Dispose();
+      return false;
+    }
+
+    uint8_t* submitRing = static_cast<uint8_t*>(m_submitRing);
+    m_submitHead = reinterpret_cast<uint32_t*>(submitRing + params.sq_off.head);
+    m_submitTail = reinterpret_cast<uint32_t*>(submitRing + params.sq_off.tail);
+    m_submitMask = *reinterpret_cast<uint32_t*>(submitRing + params.sq_off.ring_mask);
+    m_submitEntryCount = params.sq_entries;
+    m_submitArray = reinterpret_cast<uint32_t*>(submitRing + params.sq_off.array);
+
+    uint8_t* completeRing = static_cast<uint8_t*>(m_completeRing);
+    m_completeHead = reinterpret_cast<uint32_t*>(completeRing + params.cq_off.head);
+    m_completeTail = reinterpret_cast<uint32_t*>(completeRing + params.cq_off.tail);
+    m_completeMask = *reinterpret_cast<uint32_t*>(completeRing + params.cq_off.ring_mask);
+    m_completeEntries = completeRing + params.cq_off.cqes;
+
+    m_wakeDescriptor = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    m_queueDepth = queueDepth;
+    if (m_wakeDescriptor < 0 || !armWakePoll())
+    {
+      Dispose();
+      return false;
+    }
+
+    Flush();
+    return true;
+  }
+
+  bool IoUringFileBackend::Submit(const AsyncFileOperation& operation)
+  {
+    if (m_ringDescriptor < 0)
+    {
+      return false;
+    }
+
+    // 送信リングのテイルを書くのはこのスレッドだけ
+    const uint32_t tail = *m_submitTail;
+    if (tail - loadAcquire(m_submitHead) >= m_submitEntryCount)
+    {
+      return false;
+    }
+
+    const uint32_t index = tail & m_submitMask;
+    io_uring_sqe* entry = static_cast<io_uring_sqe*>(m_submitEntries) + index;
+    std::memset(entry, 0, sizeof(*entry));
+    entry->opcode = IORING_OP_READV;
+    entry->fd = static_cast<int>(operation.File);
+    entry->addr = reinterpret_cast<uint64_t>(operation.Buffers);
+    entry->len = operation.BufferCount;
+    entry->off = operation.Offset;
+    entry->user_data = reinterpret_cast<uint64_t>(operation.UserData);
+
+    m_submitArray[index] = index;
+    storeRelease(m_submitTail, tail + 1);
+    ++m_pendingSubmitCount;
+    return true;
+  }
+
+  void IoUringFileBackend::Flush()
+  {
+    while (m_pendingSubmitCount > 0)
+    {
+      const int result = ioUringEnter(m_ringDescriptor, m_pendingSubmitCount, 0, 0);
+      if (result < 0)
+      {
+        // 一時的に受け付けられない場合は次のWaitCompletionsで発行する
+        if (errno != EINTR)
+        {
+          return;
+        }
+        continue;
+      }
+
+      m_pendingSubmitCount -= static_cast<uint32_t>(result);
+      if (result == 0)
+      {
+        return;
+      }
+    }
+  }
+
+  size_t IoUringFileBackend::WaitCompletions(AsyncFileCompletion* outCompletions, size_t maxCount)
+  {
+    if (m_ringDescriptor < 0)
+    {
+      return 0;
+    }
+
+    for (;;)
+    {
+      size_t count = 0;
+      bool isWoken = false;
+
+      // 完了リングのヘッドを書くのはこのスレッドだけ
+      uint32_t head = *m_completeHead;
+      const uint32_t tail = loadAcquire(m_completeTail);
+      while (head != tail && count < maxCount)
+      {
+        const io_uring_cqe& completion = static_cast<const io_uring_cqe*>(m_completeEntries)[head & m_completeMask];
+        if (completion.user_data == WAKE_USER_DATA)
+        {
+          isWoken = true;
+        }
+        else
+        {
+          outCompletions[count++] = AsyncFileCompletion{ reinterpret_cast<void*>(completion.user_data), static_cast<int64_t>(completion.res) };
+        }
+        ++head;
+      }
+      storeRelease(m_completeHead, head);
+
+      if (isWoken)
+      {
+        // カウンターを戻してから監視をやり直す
+        uint64_t value = 0;
+        [[maybe_unused]] const ssize_t readSize = ::read(m_wakeDescriptor, &value, sizeof(value));
+        armWakePoll();
+        Flush();
+      }
+
+      if (count > 0 || isWoken)
+      {
+        return count;
+      }
+
+      // 未発行の読み込みも一緒に発行して、完了が一つ来るまで眠る
+      const int result = ioUringEnter(m_ringDescriptor, m_pendingSubmitCount, 1, IORING_ENTER_GETEVENTS);
+      if (result > 0)
+      {
+        m_pendingSubmitCount -= static_cast<uint32_t>(result);
+      }
+      else if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+      {
+        return 0;
+      }
+    }
+  }
+
+  void IoUringFileBackend::Wake()
+  {
+    if (m_wakeDescriptor < 0)
+    {
+      return;
+    }
+
+    const uint64_t value = 1;
+    [[maybe_unused]] const ssize_t writeSize = ::write(m_wakeDescriptor, &value, sizeof(value));
+  }
+
+  void IoUringFileBackend::Dispose() noexcept
+  {
+    if (m_submitEntries != nullptr)
+    {
+      ::munmap(m_submitEntries, m_submitEntriesSize);
+      m_submitEntries = nullptr;
+    }
+    if (m_completeRing != nullptr && m_completeRing != m_submitRing)
+    {
+      ::munmap(m_completeRing, m_completeRingSize);
+    }
+    m_completeRing = nullptr;
+    if (m_submitRing != nullptr)
+    {
+      ::munmap(m_submitRing, m_submitRingSize);
+      m_submitRing = nullptr;
+    }
+    if (m_wakeDescriptor >= 0)
+    {
+      ::close(m_wakeDescriptor);
+      m_wakeDescriptor = -1;
+    }
+    if (m_ringDescriptor >= 0)
+    {
+      ::close(m_ringDescriptor);
+      m_ringDescriptor = -1;
+    }
+
+    m_queueDepth = 0;
+    m_pendingSubmitCount = 0;
+  }
+
+  bool IoUringFileBackend::armWakePoll()
+  {
+    const uint32_t tail = *m_submitTail;
+    if (tail - loadAcquire(m_submitHead) >= m_submitEntryCount)
+    {
+      return false;
+    }
+
+    const uint32_t index = tail & m_submitMask;
+    io_uring_sqe* entry = static_cast<io_uring_sqe*>(m_submitEntries) + index;
+    std::memset(entry, 0, sizeof(*entry));
+    entry->opcode = IORING_OP_POLL_ADD;
+    entry->fd = m_wakeDescriptor;
+    entry->poll_events = POLLIN;
+    entry->user_data = WAKE_USER_DATA;
+
+    m_submitArray[index] = index;
+    storeRelease(m_submitTail, tail + 1);
+    ++m_pendingSubmitCount;
+    return true;
+  }
+
+  #else
+
+  bool IoUringFileBackend::Init(uint32_t)
+  {
+    return false;
+  }
+
+  bool IoUringFileBackend::Submit(const AsyncFileOperation&)
+  {
+    return false;
+  }
+
+  void IoUringFileBackend::Flush()
+  { }
+
+  size_t IoUringFileBackend::WaitCompletions(AsyncFileCompletion*, size_t)
+  {
+    return 0;
+  }
+
+  void IoUringFileBackend::Wake()
+  { }
+
+  void IoUringFileBackend::Dispose() noexcept
+  { }
+
+  bool IoUringFileBackend::armWakePoll()
+  {
+    return false;
+  }
+
+  #endif
+}
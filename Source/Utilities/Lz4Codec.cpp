@@ -0,0 +1,349 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : LZ4 block format codec
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <Lz4Codec.h>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+  constexpr size_t MIN_MATCH = 4;
+  constexpr size_t LAST_LITERALS = 5;           // 最後の5バイトは必ずリテラル
+  constexpr size_t MATCH_FIND_LIMIT = 12;       // 最後の一致は終端の12バイト前までに始まる
+  constexpr size_t MAX_OFFSET = 65535;
+  constexpr uint32_t HASH_LOG = 14;
+  constexpr uint32_t SKIP_TRIGGER = 6;          // 一致しない間は探索の間隔を広げる
+  constexpr size_t COPY_CHUNK_SIZE = 8;
+
+  uint32_t read32(const uint8_t* ptr)
+  {
+    uint32_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+  }
+
+  /// @brief
+  /// 8バイト単位でコピーする(dstとsrcは末尾からさらに8バイト読み書きできること)
+  void copyChunks(uint8_t* dst, const uint8_t* src, size_t length)
+  {
+    uint8_t* const end = dst + length;
+    do
+    {
+      std::memcpy(dst, src, COPY_CHUNK_SIZE);
+      dst += COPY_CHUNK_SIZE;
+      src += COPY_CHUNK_SIZE;
+    } while (dst < end);
+  }
+
+  uint32_t hashSequence(uint32_t sequence)
+  {
+    return (sequence * 2654435761U) >> (32 - HASH_LOG);
+  }
+
+  /// @brief
+  /// 15以上の長さを255区切りで書き出す
+  bool writeLength(uint8_t*& op, const uint8_t* oend, size_t length)
+  {
+    for (; length >= 255; length -= 255)
+    {
+      if (op >= oend)
+      {
+        return false;
+      }
+      *op++ = 255;
+    }
+
+    if (op >= oend)
+    {
+      return false;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return true;
+  }
+
+  bool readLength(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+  {
+    uint8_t value = 0;
+    do
+    {
+      if (ip >= iend)
+      {
+        return false;
+      }
+      value = *ip++;
+      length += value;
+    } while (value == 255);
+
+    return true;
+  }
+
+  bool writeSequence(uint8_t*& op, const uint8_t* oend, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+  {
+    if (op >= oend)
+    {
+      return false;
+    }
+
+    uint8_t* token = op++;
+    *token = static_cast<uint8_t>(((literalLength >= 15) ? 15 : literalLength) << 4);
+    if (literalLength >= 15 && !writeLength(op, oend, literalLength - 15))
+    {
+      return false;
+    }
+
+    if (static_cast<size_t>(oend - op) < literalLength)
+    {
+      return false;
+    }
+    if (literalLength != 0)
+    {
+      std::memcpy(op, literals, literalLength);
+      op += literalLength;
+    }
+
+    // 最後のシーケンスはリテラルだけ
+    if (matchLength == 0)
+    {
+      return true;
+    }
+
+    if (oend - op < 2)
+    {
+      return false;
+    }
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+
+    const size_t extraLength = matchLength - MIN_MATCH;
+    *token |= static_cast<uint8_t>((extraLength >= 15) ? 15 : extraLength);
+    return extraLength < 15 || writeLength(op, oend, extraLength - 15);
+  }
+}
+
+namespace MFramework
+{
+  uint32_t Lz4Codec::GetId() const
+  {
+    return CODEC_ID;
+  }
+
+  size_t Lz4Codec::GetMaxCompressedSize(size_t srcSize) const
+  {
+    return srcSize + srcSize / 255 + 16;
+  }
+
+  size_t Lz4Codec::Compress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) const
+  {
+    if (dst == nullptr || (src == nullptr && srcSize != 0))
+    {
+      return 0;
+    }
+
+    uint8_t* op = dst;
+    const uint8_t* oend = dst + dstCapacity;
+    size_t anchor = 0;
+
+    if (srcSize > MATCH_FIND_LIMIT)
+    {
+      // 位置+1を入れる(0は空)
+      std::vector<uint32_t> hashTable(static_cast<size_t>(1) << HASH_LOG, 0);
+      const size_t matchLimit = srcSize - LAST_LITERALS;
+      const size_t positionLimit = srcSize - MATCH_FIND_LIMIT;
+
+      size_t position = 0;
+      while (position < positionLimit)
+      {
+        const uint32_t sequence = read32(src + position);
+        const uint32_t hash = hashSequence(sequence);
+        const size_t candidate = hashTable[hash];
+        hashTable[hash] = static_cast<uint32_t>(position + 1);
+
+        if (candidate == 0 || position - (candidate - 1) > MAX_OFFSET || read32(src + candidate - 1) != sequence)
+        {
+          position += 1 + ((position - anchor) >> SKIP_TRIGGER);
+          continue;
+        }
+
+        size_t matchPosition = candidate - 1;
+
+        // 後ろ向きに一致を伸ばす
+        while (position > anchor && matchPosition > 0 && src[position - 1] == src[matchPosition - 1])
+        {
+          --position;
+          --matchPosition;
+        }
+
+        // 前向きに一致を伸ばす
+        size_t matchLength = MIN_MATCH;
+        while (position + matchLength < matchLimit && src[position + matchLength] == src[matchPosition + matchLength])
+        {
+          ++matchLength;
+        }
+
+        if (!writeSequence(op, oend, src + anchor, position - anchor, position - matchPosition, matchLength))
+        {
+          return 0;
+        }
+
+        position += matchLength;
+        anchor = position;
+
+        // 一致の途中の位置も登録して次の一致を見つけやすくする
+        if (position < positionLimit)
+        {
+          hashTable[hashSequence(read32(src + position - 2))] = static_cast<uint32_t>(position - 1);
+        }
+      }
+    }
+
+    if (!writeSequence(op, oend, src + anchor, srcSize - anchor, 0, 0))
+    {
+      return 0;
+    }
+
+    return static_cast<size_t>(op - dst);
+  }
+
+  bool Lz4Codec::Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) const
+  {
+    if (src == nullptr || srcSize == 0 || (dst == nullptr && dstSize != 0))
+    {
+      return false;
+    }
+
+    const uint8_t* ip = src;
+    const uint8_t* const iend = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const oend = dst + dstSize;
+
+    while (true)
+    {
+      const uint8_t token = *ip++;
+
+      // 短いリテラルと短い一致は固定長のコピーで済ませる(ほとんどのシーケンスがここを通る)
+      // 入力が18バイト以上残っていれば、リテラルの後に必ずオフセットがあるので最後のシーケンスではない
+      if ((token >> 4) < 15 && (token & 15) < 15 && iend - ip >= 18 && oend - op >= 32)
+      {
+        const size_t literalLength = token >> 4;
+        std::memcpy(op, ip, 16);
+        ip += literalLength;
+        op += literalLength;
+
+        const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst))
+        {
+          return false;
+        }
+
+        const size_t matchLength = (token & 15) + MIN_MATCH;
+        const uint8_t* match = op - offset;
+        if (offset >= COPY_CHUNK_SIZE)
+        {
+          // 一致は最大18バイト、8バイト以上離れているので順にコピーすれば重ならない
+          std::memcpy(op, match, 8);
+          std::memcpy(op + 8, match + 8, 8);
+          std::memcpy(op + 16, match + 16, 2);
+        }
+        else if (offset == 1)
+        {
+          std::memset(op, *match, matchLength);
+        }
+        else
+        {
+          for (size_t i = 0; i < matchLength; ++i)
+          {
+            op[i] = match[i];
+          }
+        }
+        op += matchLength;
+        continue;
+      }
+
+      size_t literalLength = token >> 4;
+      if (literalLength == 15 && !readLength(ip, iend, literalLength))
+      {
+        return false;
+      }
+
+      if (static_cast<size_t>(iend - ip) < literalLength || static_cast<size_t>(oend - op) < literalLength)
+      {
+        return false;
+      }
+
+      // 余裕があれば8バイト単位でコピーする(はみ出した分は後で上書きされる)
+      if (static_cast<size_t>(iend - ip) >= literalLength + COPY_CHUNK_SIZE && static_cast<size_t>(oend - op) >= literalLength + COPY_CHUNK_SIZE)
+      {
+        copyChunks(op, ip, literalLength);
+      }
+      else if (literalLength != 0)
+      {
+        std::memcpy(op, ip, literalLength);
+      }
+      ip += literalLength;
+      op += literalLength;
+
+      // 入力の終端は最後のシーケンス(リテラルだけ)
+      if (ip == iend)
+      {
+        return op == oend;
+      }
+
+      if (iend - ip < 2)
+      {
+        return false;
+      }
+      const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+      ip += 2;
+      if (offset == 0 || offset > static_cast<size_t>(op - dst))
+      {
+        return false;
+      }
+
+      size_t matchLength = token & 15;
+      if (matchLength == 15 && !readLength(ip, iend, matchLength))
+      {
+        return false;
+      }
+      matchLength += MIN_MATCH;
+
+      if (static_cast<size_t>(oend - op) < matchLength || ip >= iend)
+      {
+        return false;
+      }
+
+      const uint8_t* match = op - offset;
+      if (offset >= COPY_CHUNK_SIZE && static_cast<size_t>(oend - op) >= matchLength + COPY_CHUNK_SIZE)
+      {
+        // 8バイト以上離れていれば、8バイトずつ順にコピーしても重ならない
+        copyChunks(op, match, matchLength);
+      }
+      else if (offset == 1)
+      {
+        std::memset(op, *match, matchLength);
+      }
+      else
+      {
+        // 近い位置の重なる一致は繰り返しのパターンなので一バイトずつ
+        for (size_t i = 0; i < matchLength; ++i)
+        {
+          op[i] = match[i];
+        }
+      }
+      op += matchLength;
+    }
+  }
+}
@@ -0,0 +1,158 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Read-only memory-mapped file
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <MappedFile.h>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace MFramework
+{
+  MappedFile::MappedFile()
+    : m_data(nullptr)
+    , m_size(0)
+    #ifdef _WIN32
+      , m_fileHandle(INVALID_HANDLE_VALUE)
+      , m_mappingHandle(nullptr)
+    #else
+      , m_fileDescriptor(-1)
+    #endif
+  { }
+
+  MappedFile::~MappedFile()
+  {
+    Dispose();
+  }
+
+  #ifdef _WIN32
+
+  bool MappedFile::Open(const std::string& filePath)
+  {
+    Dispose();
+
+    // パスはUTF-8として扱う
+    const int length = ::MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, nullptr, 0);
+    if (length <= 0)
+    {
+      return false;
+    }
+    std::wstring widePath(static_cast<size_t>(length), L'\0');
+    ::MultiByteToWideChar(CP_UTF8, 0, filePath.c_str(), -1, widePath.data(), length);
+
+    m_fileHandle = ::CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+
+    LARGE_INTEGER fileSize{};
+    if (!::GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+      Dispose();
+      return false;
+    }
+
+    m_mappingHandle = ::CreateFileMappingW(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr)
+    {
+      Dispose();
+      return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(::MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+      Dispose();
+      return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+  }
+
+  void MappedFile::Dispose() noexcept
+  {
+    if (m_data != nullptr)
+    {
+      ::UnmapViewOfFile(m_data);
+      m_data = nullptr;
+    }
+    if (m_mappingHandle != nullptr)
+    {
+      ::CloseHandle(m_mappingHandle);
+      m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle != INVALID_HANDLE_VALUE)
+    {
+      ::CloseHandle(m_fileHandle);
+      m_fileHandle = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+  }
+
+  #else
+
+  bool MappedFile::Open(const std::string& filePath)
+  {
+    Dispose();
+
+    m_fileDescriptor = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fileDescriptor < 0)
+    {
+      return false;
+    }
+
+    struct stat fileStat{};
+    if (::fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+      Dispose();
+      return false;
+    }
+
+    void* data = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+      Dispose();
+      return false;
+    }
+
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = static_cast<size_t>(fileStat.st_size);
+    return true;
+  }
+
+  void MappedFile::Dispose() noexcept
+  {
+    if (m_data != nullptr)
+    {
+      ::munmap(const_cast<uint8_t*>(m_data), m_size);
+      m_data = nullptr;
+    }
+    if (m_fileDescriptor >= 0)
+    {
+      ::close(m_fileDescriptor);
+      m_fileDescriptor = -1;
+    }
+    m_size = 0;
+  }
+
+  #endif
+}
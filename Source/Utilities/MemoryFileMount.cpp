@@ -0,0 +1,133 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system mount backed by memory
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <MemoryFileMount.h>
+
+#include <AssetArchiveFormat.h>
+
+#include <cstring>
+
+namespace MFramework
+{
+  MemoryFileMount::MemoryFileMount()
+    : m_entries()
+    , m_ownedData()
+    , m_index()
+  { }
+
+  MemoryFileMount::~MemoryFileMount()
+  {
+    Dispose();
+  }
+
+  bool MemoryFileMount::Add(std::string_view path, const uint8_t* data, size_t size)
+  {
+    if (data == nullptr && size != 0)
+    {
+      return false;
+    }
+
+    std::string normalizedPath = AssetArchiveFormat::NormalizePath(path);
+    const uint64_t pathHash = AssetArchiveFormat::ComputePathHash(normalizedPath);
+    if (normalizedPath.empty() || Find(normalizedPath, pathHash) != INVALID_INDEX)
+    {
+      return false;
+    }
+
+    m_index.emplace(pathHash, static_cast<uint32_t>(m_entries.size()));
+    m_entries.emplace_back(Entry{ std::move(normalizedPath), data, size });
+    return true;
+  }
+
+  bool MemoryFileMount::Add(std::string_view path, std::vector<uint8_t>&& data)
+  {
+    const std::string normalizedPath = AssetArchiveFormat::NormalizePath(path);
+    if (normalizedPath.empty() || Find(normalizedPath, AssetArchiveFormat::ComputePathHash(normalizedPath)) != INVALID_INDEX)
+    {
+      return false;
+    }
+
+    const std::vector<uint8_t>& ownedData = m_ownedData.emplace_back(std::move(data));
+    return Add(normalizedPath, ownedData.data(), ownedData.size());
+  }
+
+  uint32_t MemoryFileMount::Find(std::string_view normalizedPath, uint64_t pathHash) const
+  {
+    const auto range = m_index.equal_range(pathHash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      if (m_entries[it->second].Path == normalizedPath)
+      {
+        return it->second;
+      }
+    }
+
+    return INVALID_INDEX;
+  }
+
+  uint32_t MemoryFileMount::GetCount() const
+  {
+    return static_cast<uint32_t>(m_entries.size());
+  }
+
+  std::string_view MemoryFileMount::GetPath(uint32_t index) const
+  {
+    return (index < m_entries.size()) ? std::string_view(m_entries[index].Path) : std::string_view();
+  }
+
+  uint64_t MemoryFileMount::GetSize(uint32_t index) const
+  {
+    return (index < m_entries.size()) ? m_entries[index].Size : 0;
+  }
+
+  AssetView MemoryFileMount::GetView(uint32_t index) const
+  {
+    if (index >= m_entries.size())
+    {
+      return AssetView{ nullptr, 0 };
+    }
+
+    // 空のファイルも有効なビューとして返す
+    static const uint8_t EMPTY_DATA = 0;
+    const Entry& entry = m_entries[index];
+    return AssetView{ (entry.Data != nullptr) ? entry.Data : &EMPTY_DATA, entry.Size };
+  }
+
+  bool MemoryFileMount::Read(uint32_t index, uint8_t* dst, size_t dstSize) const
+  {
+    if (index >= m_entries.size() || dstSize < m_entries[index].Size || (dst == nullptr && m_entries[index].Size != 0))
+    {
+      return false;
+    }
+
+    if (m_entries[index].Size != 0)
+    {
+      std::memcpy(dst, m_entries[index].Data, m_entries[index].Size);
+    }
+    return true;
+  }
+
+  bool MemoryFileMount::GetNativePath(uint32_t, std::string&) const
+  {
+    return false;
+  }
+
+  void MemoryFileMount::Dispose() noexcept
+  {
+    m_entries.clear();
+    m_ownedData.clear();
+    m_index.clear();
+  }
+}
@@ -0,0 +1,183 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Multithreaded LSD radix sort
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <RadixSort.h>
+
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t DIGIT_BITS = 8;
+  constexpr uint32_t BUCKET_COUNT = 1u << DIGIT_BITS;
+  constexpr uint32_t PASS_COUNT = 64 / DIGIT_BITS;
+  // これより少なければ分けずに一つのスレッドで処理する
+  constexpr size_t PARALLEL_MIN_COUNT = 32 * 1024;
+  // 一つのブロックの最小要素数(数え上げの表を埋める手間に見合う大きさ)
+  constexpr size_t MIN_BLOCK_SIZE = 16 * 1024;
+  // スレッドごとのブロック数(ブロックごとの処理時間の偏りを減らす)
+  constexpr size_t BLOCKS_PER_THREAD = 2;
+
+  uint32_t getDigit(uint64_t key, uint32_t pass)
+  {
+    return static_cast<uint32_t>(key >> (pass * DIGIT_BITS)) & (BUCKET_COUNT - 1);
+  }
+
+  /// @brief
+  /// ブロックごとの処理(ブロックが一つなら呼び出したスレッドで、複数ならスレッドプールで並列に行う)
+  template<typename BlockFunc>
+  void forEachBlock(MFramework::ThreadPool* threadPool, size_t blockCount, const BlockFunc& func)
+  {
+    if (blockCount == 1)
+    {
+      func(0);
+      return;
+    }
+
+    threadPool->ParallelFor(
+                              blockCount,
+                              [&func](size_t begin, size_t end)
+                              {
+                                for (size_t block = begin; block < end; ++block)
+                                {
+                                  func(block);
+                                }
+                              }
+                            );
+  }
+}
+
+namespace MFramework
+{
+  void RadixSort::Sort(RadixSortItem* items, size_t count, RadixSortItem* tempItems, ThreadPool* threadPool)
+  {
+    if (count < 2 || items == nullptr || tempItems == nullptr)
+    {
+      return;
+    }
+
+    // ブロックに分ける(ブロックの境界はパスごとに変えないので、同じキーの順番が保たれる)
+    size_t blockCount = 1;
+    if (threadPool != nullptr && threadPool->GetThreadCount() > 0 && count >= PARALLEL_MIN_COUNT)
+    {
+      const size_t participantCount = static_cast<size_t>(threadPool->GetThreadCount()) + 1;
+      blockCount = std::clamp<size_t>(count / MIN_BLOCK_SIZE, 1, participantCount * BLOCKS_PER_THREAD);
+    }
+    const size_t blockSize = (count + blockCount - 1) / blockCount;
+    blockCount = (count + blockSize - 1) / blockSize;
+
+    // 最初は全部の桁をまとめて数える(全体の数は並び順によらないので、飛ばせる桁がここで分かる)
+    std::vector<size_t> blockHistograms(blockCount * PASS_COUNT * BUCKET_COUNT, 0);
+    forEachBlock(
+                  threadPool,
+                  blockCount,
+                  [&](size_t block)
+                  {
+                    size_t* histogram = blockHistograms.data() + block * PASS_COUNT * BUCKET_COUNT;
+                    const size_t end = std::min(count, (block + 1) * blockSize);
+                    for (size_t i = block * blockSize; i < end; ++i)
+                    {
+                      const uint64_t key = items[i].Key;
+                      for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+                      {
+                        ++histogram[pass * BUCKET_COUNT + getDigit(key, pass)];
+                      }
+                    }
+                  }
+                );
+
+    std::vector<size_t> blockOffsets(blockCount * BUCKET_COUNT);
+    RadixSortItem* src = items;
+    RadixSortItem* dst = tempItems;
+    bool isFirstSortedPass = true;
+
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+      // すべてのキーが同じ値の桁は並びが変わらない
+      bool isUniform = false;
+      for (uint32_t bucket = 0; bucket < BUCKET_COUNT && !isUniform; ++bucket)
+      {
+        size_t total = 0;
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+          total += blockHistograms[(block * PASS_COUNT + pass) * BUCKET_COUNT + bucket];
+        }
+        isUniform = (total == count);
+      }
+      if (isUniform)
+      {
+        continue;
+      }
+
+      // 前のパスで並びが変わったので、ブロックの中身に合わせて数え直す
+      if (!isFirstSortedPass)
+      {
+        forEachBlock(
+                      threadPool,
+                      blockCount,
+                      [&](size_t block)
+                      {
+                        size_t* histogram = blockHistograms.data() + (block * PASS_COUNT + pass) * BUCKET_COUNT;
+                        std::fill(histogram, histogram + BUCKET_COUNT, 0);
+                        const size_t end = std::min(count, (block + 1) * blockSize);
+                        for (size_t i = block * blockSize; i < end; ++i)
+                        {
+                          ++histogram[getDigit(src[i].Key, pass)];
+                        }
+                      }
+                    );
+      }
+      isFirstSortedPass = false;
+
+      // 桁の値ごとに、前のブロックの続きから書き出す
+      size_t offset = 0;
+      for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+      {
+        for (size_t block = 0; block < blockCount; ++block)
+        {
+          blockOffsets[block * BUCKET_COUNT + bucket] = offset;
+          offset += blockHistograms[(block * PASS_COUNT + pass) * BUCKET_COUNT + bucket];
+        }
+      }
+
+      forEachBlock(
+                    threadPool,
+                    blockCount,
+                    [&](size_t block)
+                    {
+                      size_t* offsets = blockOffsets.data() + block * BUCKET_COUNT;
+                      const size_t end = std::min(count, (block + 1) * blockSize);
+                      for (size_t i = block * blockSize; i < end; ++i)
+                      {
+                        const RadixSortItem item = src[i];
+                        dst[offsets[getDigit(item.Key, pass)]++] = item;
+                      }
+                    }
+                  );
+
+      std::swap(src, dst);
+    }
+
+    // 書き出したパスが奇数回なら結果は作業領域にある
+    if (src != items)
+    {
+      std::memcpy(items, src, count * sizeof(RadixSortItem));
+    }
+  }
+}
@@ -0,0 +1,251 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Thread based asynchronous file read backend
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <ThreadFileBackend.h>
+
+#include <algorithm>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <cerrno>
+  #include <sys/uio.h>
+  #include <unistd.h>
+#endif
+
+namespace
+{
+  // 一回のシステムコールで読む最大サイズ(ReadFileはDWORDまで)
+  constexpr uint64_t MAX_READ_CHUNK_SIZE = 1ULL << 30;
+
+  /// @brief
+  /// 位置を指定して一区間を読み込む
+  /// @return 読んだバイト数(負ならエラー、0なら終端)
+  int64_t readAt(intptr_t file, uint64_t offset, void* data, size_t size)
+  {
+    const size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(size, MAX_READ_CHUNK_SIZE));
+
+    #ifdef _WIN32
+      OVERLAPPED overlapped{};
+      overlapped.Offset = static_cast<DWORD>(offset & 0xffffffff);
+      overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+      DWORD readSize = 0;
+      if (!::ReadFile(reinterpret_cast<HANDLE>(file), data, static_cast<DWORD>(chunkSize), &readSize, &overlapped))
+      {
+        return (::GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+      }
+      return static_cast<int64_t>(readSize);
+    #else
+      ssize_t readSize = 0;
+      do
+      {
+        readSize = ::pread(static_cast<int>(file), data, chunkSize, static_cast<off_t>(offset));
+      } while (readSize < 0 && errno == EINTR);
+      return static_cast<int64_t>(readSize);
+    #endif
+  }
+
+  /// @brief
+  /// 操作の全区間を読み込む(短い読み込みは続きから読み直す)
+  int64_t readOperation(const MFramework::AsyncFileOperation& operation)
+  {
+    uint64_t offset = operation.Offset;
+    int64_t totalSize = 0;
+    for (uint32_t i = 0; i < operation.BufferCount; ++i)
+    {
+      uint8_t* data = static_cast<uint8_t*>(operation.Buffers[i].Data);
+      size_t remainingSize = operation.Buffers[i].Size;
+      while (remainingSize > 0)
+      {
+        const int64_t readSize = readAt(operation.File, offset, data, remainingSize);
+        if (readSize < 0)
+        {
+          return -1;
+        }
+        if (readSize == 0)
+        {
+          return totalSize;
+        }
+
+        data += readSize;
+        remainingSize -= static_cast<size_t>(readSize);
+        offset += static_cast<uint64_t>(readSize);
+        totalSize += readSize;
+      }
+    }
+
+    return totalSize;
+  }
+}
+
+namespace MFramework
+{
+  ThreadFileBackend::ThreadFileBackend()
+    : m_threads()
+    , m_operations()
+    , m_completions()
+    , m_mutex()
+    , m_operationCondition()
+    , m_completionCondition()
+    , m_isWakeRequested(false)
+    , m_isStopping(false)
+  { }
+
+  ThreadFileBackend::~ThreadFileBackend()
+  {
+    Dispose();
+  }
+
+  bool ThreadFileBackend::Init(uint32_t threadCount)
+  {
+    if (!m_threads.empty() || threadCount == 0)
+    {
+      return false;
+    }
+
+    m_isStopping = false;
+    m_isWakeRequested = false;
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+      m_threads.emplace_back(&ThreadFileBackend::workerMain, this);
+    }
+
+    return true;
+  }
+
+  const char* ThreadFileBackend::GetName() const
+  {
+    return "thread";
+  }
+
+  uint32_t ThreadFileBackend::GetQueueDepth() const
+  {
+    return static_cast<uint32_t>(m_threads.size());
+  }
+
+  bool ThreadFileBackend::Submit(const AsyncFileOperation& operation)
+  {
+    if (m_threads.empty())
+    {
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_operations.emplace_back(operation);
+    }
+
+    m_operationCondition.notify_one();
+    return true;
+  }
+
+  void ThreadFileBackend::Flush()
+  {
+    // Submitの時点でワーカーに渡している
+  }
+
+  size_t ThreadFileBackend::WaitCompletions(AsyncFileCompletion* outCompletions, size_t maxCount)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completionCondition.wait(
+                                lock,
+                                [this]()
+                                {
+                                  return m_isWakeRequested || !m_completions.empty();
+                                }
+                              );
+
+    m_isWakeRequested = false;
+
+    size_t count = 0;
+    while (count < maxCount && !m_completions.empty())
+    {
+      outCompletions[count++] = m_completions.front();
+      m_completions.pop_front();
+    }
+
+    return count;
+  }
+
+  void ThreadFileBackend::Wake()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isWakeRequested = true;
+    }
+
+    m_completionCondition.notify_one();
+  }
+
+  void ThreadFileBackend::Dispose() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+
+    m_operationCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+      if (thread.joinable())
+      {
+        thread.join();
+      }
+    }
+
+    m_threads.clear();
+    m_operations.clear();
+    m_completions.clear();
+  }
+
+  void ThreadFileBackend::workerMain()
+  {
+    for (;;)
+    {
+      AsyncFileOperation operation{};
+
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_operationCondition.wait(
+                                  lock,
+                                  [this]()
+                                  {
+                                    return m_isStopping || !m_operations.empty();
+                                  }
+                                );
+
+        if (m_isStopping)
+        {
+          return;
+        }
+
+        operation = m_operations.front();
+        m_operations.pop_front();
+      }
+
+      const int64_t result = readOperation(operation);
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_completions.emplace_back(AsyncFileCompletion{ operation.UserData, result });
+      }
+
+      m_completionCondition.notify_one();
+    }
+  }
+}
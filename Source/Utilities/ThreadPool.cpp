@@ -0,0 +1,253 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Fixed size worker thread pool
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace
+{
+  thread_local uint32_t s_workerIndex = MFramework::ThreadPool::INVALID_WORKER_INDEX;
+
+  // ParallelForの呼び出し一回分の共有状態
+  // 投げたタスクが呼び出し元より後に動いても安全なように共有ポインターで持つ
+  struct ParallelForState
+  {
+    const MFramework::ThreadPool::RangeFunc* Func;
+    size_t Count;
+    size_t ChunkSize;
+    size_t ChunkCount;
+    std::atomic<size_t> NextChunk;
+    std::atomic<size_t> CompletedChunks;
+    std::mutex Mutex;
+    std::condition_variable Condition;
+
+    // 残っているチャンクを取り出して処理する
+    void RunChunks()
+    {
+      for (;;)
+      {
+        const size_t chunk = NextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= ChunkCount)
+        {
+          return;
+        }
+
+        const size_t begin = chunk * ChunkSize;
+        const size_t end = std::min(begin + ChunkSize, Count);
+        (*Func)(begin, end);
+
+        if (CompletedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == ChunkCount)
+        {
+          std::lock_guard<std::mutex> lock(Mutex);
+          Condition.notify_all();
+        }
+      }
+    }
+  };
+}
+
+namespace MFramework
+{
+  ThreadPool::ThreadPool()
+    : m_threads()
+    , m_tasks()
+    , m_mutex()
+    , m_taskCondition()
+    , m_idleCondition()
+    , m_runningCount(0)
+    , m_isStopping(false)
+  { }
+
+  ThreadPool::~ThreadPool()
+  {
+    Dispose();
+  }
+
+  bool ThreadPool::Init(uint32_t threadCount)
+  {
+    if (!m_threads.empty())
+    {
+      return false;
+    }
+
+    if (threadCount == 0)
+    {
+      const uint32_t hardwareCount = std::thread::hardware_concurrency();
+      threadCount = (hardwareCount > 1) ? (hardwareCount - 1) : 1;
+    }
+
+    m_isStopping = false;
+    m_threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+      m_threads.emplace_back(&ThreadPool::workerMain, this, i);
+    }
+
+    return true;
+  }
+
+  void ThreadPool::Submit(Task task)
+  {
+    if (!task)
+    {
+      return;
+    }
+
+    // ワーカーがいなければその場で実行する
+    if (m_threads.empty())
+    {
+      task();
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.emplace_back(std::move(task));
+    }
+
+    m_taskCondition.notify_one();
+  }
+
+  void ThreadPool::ParallelFor(size_t count, const RangeFunc& func, size_t minChunkSize)
+  {
+    if (count == 0 || !func)
+    {
+      return;
+    }
+
+    minChunkSize = std::max<size_t>(minChunkSize, 1);
+
+    // 呼び出し元も含めたスレッド数より少し多めに分けて偏りを減らす
+    const size_t participantCount = static_cast<size_t>(m_threads.size()) + 1;
+    const size_t maxChunkCount = (count + minChunkSize - 1) / minChunkSize;
+    const size_t chunkCount = std::min(maxChunkCount, participantCount * 4);
+
+    if (chunkCount <= 1 || m_threads.empty())
+    {
+      func(0, count);
+      return;
+    }
+
+    std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+    state->Func = &func;
+    state->Count = count;
+    state->ChunkSize = (count + chunkCount - 1) / chunkCount;
+    state->ChunkCount = (count + state->ChunkSize - 1) / state->ChunkSize;
+    state->NextChunk.store(0, std::memory_order_relaxed);
+    state->CompletedChunks.store(0, std::memory_order_relaxed);
+
+    const size_t helperCount = std::min(static_cast<size_t>(m_threads.size()), state->ChunkCount - 1);
+    for (size_t i = 0; i < helperCount; ++i)
+    {
+      Submit([state]() { state->RunChunks(); });
+    }
+
+    state->RunChunks();
+
+    // 他のスレッドが処理中のチャンクを待つ
+    std::unique_lock<std::mutex> lock(state->Mutex);
+    state->Condition.wait(
+                          lock,
+                          [&state]()
+                          {
+                            return state->CompletedChunks.load(std::memory_order_acquire) == state->ChunkCount;
+                          }
+                        );
+  }
+
+  void ThreadPool::WaitIdle()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(
+                          lock,
+                          [this]()
+                          {
+                            return m_tasks.empty() && (m_runningCount == 0);
+                          }
+                        );
+  }
+
+  uint32_t ThreadPool::GetCurrentWorkerIndex()
+  {
+    return s_workerIndex;
+  }
+
+  void ThreadPool::Dispose() noexcept
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+
+    m_taskCondition.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+      if (thread.joinable())
+      {
+        thread.join();
+      }
+    }
+
+    m_threads.clear();
+    m_tasks.clear();
+    m_runningCount = 0;
+  }
+
+  void ThreadPool::workerMain(uint32_t workerIndex)
+  {
+    s_workerIndex = workerIndex;
+
+    for (;;)
+    {
+      Task task;
+
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taskCondition.wait(
+                              lock,
+                              [this]()
+                              {
+                                return m_isStopping || !m_tasks.empty();
+                              }
+                            );
+
+        // 停止時も残っているタスクは処理してから抜ける
+        if (m_tasks.empty())
+        {
+          return;
+        }
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+        ++m_runningCount;
+      }
+
+      task();
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_runningCount;
+        if (m_tasks.empty() && (m_runningCount == 0))
+        {
+          m_idleCondition.notify_all();
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,219 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Virtual file system with prioritized mounts and path resolution cache
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include <VirtualFileSystem.h>
+
+#include <ArchiveFileMount.h>
+#include <AssetArchiveFormat.h>
+#include <DirectoryFileMount.h>
+
+#include <mutex>
+
+namespace
+{
+  /// @brief
+  /// マウントポイントの下にあるパスなら、マウントポイントからの相対パスを取り出す
+  bool getMountRelativePath(std::string_view mountPoint, std::string_view normalizedPath, std::string_view& outPath)
+  {
+    if (mountPoint.empty())
+    {
+      outPath = normalizedPath;
+      return true;
+    }
+
+    if (normalizedPath.size() <= mountPoint.size() + 1 ||
+        normalizedPath.compare(0, mountPoint.size(), mountPoint) != 0 ||
+        normalizedPath[mountPoint.size()] != '/')
+    {
+      return false;
+    }
+
+    outPath = normalizedPath.substr(mountPoint.size() + 1);
+    return true;
+  }
+
+  MFramework::VirtualFile makeFile(const MFramework::IFileMount* mount, uint32_t index)
+  {
+    return MFramework::VirtualFile{ mount, index, (mount != nullptr) ? mount->GetSize(index) : 0 };
+  }
+}
+
+namespace MFramework
+{
+  VirtualFileSystem::VirtualFileSystem()
+    : m_mutex()
+    , m_mounts()
+    , m_cache()
+    , m_lookupCount(0)
+    , m_cacheHitCount(0)
+    , m_nextMountId(1)
+  { }
+
+  VirtualFileSystem::~VirtualFileSystem()
+  {
+    Dispose();
+  }
+
+  uint32_t VirtualFileSystem::Mount(std::unique_ptr<IFileMount> mount, int32_t priority, std::string_view mountPoint)
+  {
+    if (mount == nullptr)
+    {
+      return INVALID_MOUNT_ID;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    // 優先度の高い順に並べ、同じ優先度では新しいものを前に置く
+    auto position = m_mounts.begin();
+    while (position != m_mounts.end() && position->Priority > priority)
+    {
+      ++position;
+    }
+
+    const uint32_t mountId = m_nextMountId++;
+    m_mounts.insert(position, MountEntry{ mountId, priority, AssetArchiveFormat::NormalizePath(mountPoint), std::move(mount) });
+    m_cache.clear();
+    return mountId;
+  }
+
+  uint32_t VirtualFileSystem::MountDirectory(const std::string& directoryPath, int32_t priority, std::string_view mountPoint)
+  {
+    std::unique_ptr<DirectoryFileMount> mount = std::make_unique<DirectoryFileMount>();
+    if (!mount->Init(directoryPath))
+    {
+      return INVALID_MOUNT_ID;
+    }
+
+    return Mount(std::move(mount), priority, mountPoint);
+  }
+
+  uint32_t VirtualFileSystem::MountArchive(const std::string& archivePath, int32_t priority, std::string_view mountPoint, ThreadPool* threadPool)
+  {
+    std::unique_ptr<ArchiveFileMount> mount = std::make_unique<ArchiveFileMount>();
+    if (!mount->Init(archivePath, false, threadPool))
+    {
+      return INVALID_MOUNT_ID;
+    }
+
+    return Mount(std::move(mount), priority, mountPoint);
+  }
+
+  bool VirtualFileSystem::Unmount(uint32_t mountId)
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    for (auto it = m_mounts.begin(); it != m_mounts.end(); ++it)
+    {
+      if (it->Id == mountId)
+      {
+        m_mounts.erase(it);
+        m_cache.clear();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  VirtualFile VirtualFileSystem::Resolve(std::string_view path) const
+  {
+    // 正規化前のパスからそのままハッシュを求めて、キャッシュに当たれば文字列を作らない
+    const uint64_t pathHash = AssetArchiveFormat::ComputePathHash(path);
+    m_lookupCount.fetch_add(1, std::memory_order_relaxed);
+
+    {
+      std::shared_lock<std::shared_mutex> lock(m_mutex);
+      const auto it = m_cache.find(pathHash);
+      if (it != m_cache.end() && AssetArchiveFormat::IsSamePath(it->second.Path, path))
+      {
+        m_cacheHitCount.fetch_add(1, std::memory_order_relaxed);
+        return makeFile(it->second.Mount, it->second.Index);
+      }
+    }
+
+    std::string normalizedPath = AssetArchiveFormat::NormalizePath(path);
+    if (normalizedPath.empty())
+    {
+      return makeFile(nullptr, IFileMount::INVALID_INDEX);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+    const IFileMount* foundMount = nullptr;
+    uint32_t foundIndex = IFileMount::INVALID_INDEX;
+    for (const MountEntry& mount : m_mounts)
+    {
+      std::string_view relativePath;
+      if (!getMountRelativePath(mount.MountPoint, normalizedPath, relativePath))
+      {
+        continue;
+      }
+
+      const uint64_t relativeHash = mount.MountPoint.empty() ? pathHash : AssetArchiveFormat::ComputePathHash(relativePath);
+      const uint32_t index = mount.FileMount->Find(relativePath, relativeHash);
+      if (index != IFileMount::INVALID_INDEX)
+      {
+        foundMount = mount.FileMount.get();
+        foundIndex = index;
+        break;
+      }
+    }
+
+    // ハッシュが衝突した別のパスは上書きしない(そのパスは毎回ここを通るだけ)
+    m_cache.try_emplace(pathHash, CacheEntry{ std::move(normalizedPath), foundMount, foundIndex });
+    return makeFile(foundMount, foundIndex);
+  }
+
+  bool VirtualFileSystem::Exists(std::string_view path) const
+  {
+    return Resolve(path).IsValid();
+  }
+
+  AssetView VirtualFileSystem::GetView(std::string_view path) const
+  {
+    const VirtualFile file = Resolve(path);
+    return file.IsValid() ? file.Mount->GetView(file.Index) : AssetView{ nullptr, 0 };
+  }
+
+  bool VirtualFileSystem::ReadFile(std::string_view path, std::vector<uint8_t>& outData) const
+  {
+    const VirtualFile file = Resolve(path);
+    if (!file.IsValid())
+    {
+      return false;
+    }
+
+    outData.resize(static_cast<size_t>(file.Size));
+    return file.Mount->Read(file.Index, outData.data(), outData.size());
+  }
+
+  bool VirtualFileSystem::GetNativePath(std::string_view path, std::string& outPath) const
+  {
+    const VirtualFile file = Resolve(path);
+    return file.IsValid() && file.Mount->GetNativePath(file.Index, outPath);
+  }
+
+  VirtualFileSystemStats VirtualFileSystem::GetStats() const
+  {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return VirtualFileSystemStats{ m_lookupCount.load(std::memory_order_relaxed), m_cacheHitCount.load(std::memory_order_relaxed), m_cache.size() };
+  }
+
+  void VirtualFileSystem::Dispose() noexcept
+  {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_cache.clear();
+    m_mounts.clear();
+  }
+}
@@ -0,0 +1,620 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline asset archive packer
+
+Update History: 2026/10/19 Create
+                2026/10/19 Per-entry compression and decode benchmark
+                2026/10/19 Load inputs through AsyncFileService
+                2026/10/19 VirtualFileSystem resolve benchmark
+                2026/10/19 Count lookup hits with FindIndex
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+// 使い方
+// AssetPacker [--output <file>] [--root <dir>] [--alignment <n>] [--compress none|lz4]
+//             [--block-size <n>] [--jobs <n>] [--verify] [--benchmark] <dir or file>...
+//
+// 入力をまとめて一つのアーカイブ(.mpak)に書き出す
+// アーカイブ内のパスは--rootからの相対パス(省略時はディレクトリ入力ならそのディレクトリから、ファイル入力ならファイル名)
+// --compress lz4を指定するとエントリーごとにブロック単位で圧縮する(PNG/JPEGなど圧縮済みの形式は除く)
+// --benchmarkを指定すると書き出したアーカイブを開く時間と検索の時間を計測し、ファイルシステムへの問い合わせと比べる
+// 圧縮したエントリーがあれば、1スレッドとスレッドプールでの展開速度も計測する
+// 入力ファイルはAsyncFileServiceでまとめて読み込む(--benchmarkでは一つずつ同期で読む場合とも比べる)
+// --benchmarkではアーカイブをVirtualFileSystemにマウントして、パス解決のキャッシュの効果も計測する
+
+#include <AssetArchive.h>
+#include <AssetArchiveWriter.h>
+#include <AsyncFileService.h>
+#include <Lz4Codec.h>
+#include <ThreadPool.h>
+#include <VirtualFileSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t BENCHMARK_OPEN_COUNT = 200;
+  constexpr uint64_t BENCHMARK_LOOKUP_COUNT = 2000000;
+  constexpr uint64_t BENCHMARK_PROBE_COUNT = 20000;
+  constexpr uint64_t BENCHMARK_DECODE_BYTES = 256ULL * 1024 * 1024;
+  constexpr uint64_t BENCHMARK_LOAD_BYTES = 64ULL * 1024 * 1024;
+
+  // 一度に開いておくファイルの数
+  constexpr size_t LOAD_BATCH_FILE_COUNT = 256;
+
+  // 既に圧縮されていて縮まない形式
+  constexpr const char* PRECOMPRESSED_EXTENSIONS[] = { ".png", ".jpg", ".jpeg", ".mpak" };
+
+  struct PackerOptions
+  {
+    std::vector<std::string> InputPaths;
+    std::string OutputPath = "Assets.mpak";
+    std::string RootDir;
+    uint32_t DataAlignment = MFramework::ASSET_ARCHIVE_DEFAULT_ALIGNMENT;
+    uint32_t BlockSize = MFramework::ASSET_ARCHIVE_DEFAULT_BLOCK_SIZE;
+    uint32_t JobCount = 0;
+    bool IsCompress = false;
+    bool IsVerify = false;
+    bool IsBenchmark = false;
+  };
+
+  struct PackItem
+  {
+    std::string ArchivePath;
+    std::string FilePath;
+    std::vector<uint8_t> Data;
+    bool IsLoaded = false;
+  };
+
+  void PrintUsage()
+  {
+    std::printf("usage : AssetPacker [--output <file>] [--root <dir>] [--alignment <n>] [--compress none|lz4]\n"
+                "                    [--block-size <n>] [--jobs <n>] [--verify] [--benchmark] <dir or file>...\n");
+  }
+
+  bool ParseArguments(int argc, char** argv, PackerOptions& outOptions)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      const bool hasValue = (i + 1 < argc);
+
+      if (arg == "--output" && hasValue)
+      {
+        outOptions.OutputPath = argv[++i];
+      }
+      else if (arg == "--root" && hasValue)
+      {
+        outOptions.RootDir = argv[++i];
+      }
+      else if (arg == "--alignment" && hasValue)
+      {
+        outOptions.DataAlignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--compress" && hasValue)
+      {
+        const std::string codec = argv[++i];
+        if (codec == "none" || codec == "lz4")
+        {
+          outOptions.IsCompress = (codec == "lz4");
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--block-size" && hasValue)
+      {
+        outOptions.BlockSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--jobs" && hasValue)
+      {
+        outOptions.JobCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--verify")
+      {
+        outOptions.IsVerify = true;
+      }
+      else if (arg == "--benchmark")
+      {
+        outOptions.IsBenchmark = true;
+      }
+      else if (!arg.empty() && arg[0] != '-')
+      {
+        outOptions.InputPaths.emplace_back(arg);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return !outOptions.InputPaths.empty();
+  }
+
+  // パスはUTF-8として扱う(MappedFileと同じ)
+  std::filesystem::path ToPath(const std::string& utf8Path)
+  {
+    return std::filesystem::path(std::u8string(utf8Path.begin(), utf8Path.end()));
+  }
+
+  std::string ToUtf8(const std::filesystem::path& path)
+  {
+    const std::u8string utf8Path = path.generic_u8string();
+    return std::string(utf8Path.begin(), utf8Path.end());
+  }
+
+  bool IsPrecompressed(const std::string& path)
+  {
+    std::string extension = ToUtf8(ToPath(path).extension());
+    for (char& c : extension)
+    {
+      c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    for (const char* precompressedExtension : PRECOMPRESSED_EXTENSIONS)
+    {
+      if (extension == precompressedExtension)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  bool CollectItems(const PackerOptions& options, std::vector<PackItem>& outItems)
+  {
+    const std::filesystem::path rootDir = ToPath(options.RootDir);
+    for (const std::string& inputPath : options.InputPaths)
+    {
+      const std::filesystem::path input = ToPath(inputPath);
+      std::error_code error;
+      if (std::filesystem::is_directory(input, error))
+      {
+        const std::filesystem::path baseDir = options.RootDir.empty() ? input : rootDir;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(input, error))
+        {
+          if (entry.is_regular_file())
+          {
+            outItems.emplace_back(PackItem{ ToUtf8(entry.path().lexically_relative(baseDir)), ToUtf8(entry.path()), {} });
+          }
+        }
+      }
+      else if (std::filesystem::is_regular_file(input, error))
+      {
+        const std::filesystem::path archivePath = options.RootDir.empty() ? input.filename() : input.lexically_relative(rootDir);
+        outItems.emplace_back(PackItem{ ToUtf8(archivePath), inputPath, {} });
+      }
+      else
+      {
+        std::fprintf(stderr, "not found : %s\n", inputPath.c_str());
+        return false;
+      }
+    }
+
+    // ルートの外を指すパスはアーカイブに入れられない
+    for (const PackItem& item : outItems)
+    {
+      if (item.ArchivePath.empty() || item.ArchivePath.rfind("..", 0) == 0)
+      {
+        std::fprintf(stderr, "outside of root : %s\n", item.FilePath.c_str());
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void LoadItems(std::vector<PackItem>& items, MFramework::AsyncFileService& fileService)
+  {
+    using namespace MFramework;
+
+    // 開いたままのファイルが増えすぎないように区切って要求する(閉じるのは読み込みの完了後)
+    for (size_t begin = 0; begin < items.size(); begin += LOAD_BATCH_FILE_COUNT)
+    {
+      const size_t end = std::min(begin + LOAD_BATCH_FILE_COUNT, items.size());
+      for (size_t i = begin; i < end; ++i)
+      {
+        PackItem& item = items[i];
+        const uint32_t file = fileService.OpenFile(item.FilePath);
+        if (file == AsyncFileService::INVALID_FILE_ID)
+        {
+          continue;
+        }
+
+        item.Data.resize(static_cast<size_t>(fileService.GetFileSize(file)));
+        fileService.Read(
+                          file,
+                          0,
+                          item.Data.size(),
+                          item.Data.data(),
+                          AsyncFilePriority::Normal,
+                          [&item](const AsyncFileResult& result)
+                          {
+                            item.IsLoaded = result.IsSucceeded;
+                          }
+                        );
+        fileService.CloseFile(file);
+      }
+
+      fileService.WaitIdle();
+    }
+  }
+
+  double ElapsedNanoseconds(std::chrono::steady_clock::time_point startTime)
+  {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  void RunDecodeBenchmark(const MFramework::AssetArchive& archive, MFramework::ThreadPool& threadPool)
+  {
+    using namespace MFramework;
+
+    std::vector<uint32_t> compressedIndices;
+    uint64_t rawBytes = 0;
+    uint64_t storedBytes = 0;
+    uint64_t maxSize = 0;
+    for (uint32_t i = 0; i < archive.GetCount(); ++i)
+    {
+      if (archive.IsCompressed(i))
+      {
+        compressedIndices.emplace_back(i);
+        rawBytes += archive.GetSize(i);
+        storedBytes += archive.GetStoredData(i).Size;
+        maxSize = std::max(maxSize, archive.GetSize(i));
+      }
+    }
+
+    if (compressedIndices.empty() || rawBytes == 0)
+    {
+      std::printf("decode : no compressed entries\n");
+      return;
+    }
+
+    // ステージングバッファーの代わりに一つのバッファーへ繰り返し展開する
+    std::vector<uint8_t> buffer(static_cast<size_t>(maxSize));
+    const uint64_t rounds = std::max<uint64_t>(BENCHMARK_DECODE_BYTES / rawBytes, 1);
+    auto measure = [&](ThreadPool* pool)
+                   {
+                     const auto startTime = std::chrono::steady_clock::now();
+                     for (uint64_t round = 0; round < rounds; ++round)
+                     {
+                       for (uint32_t index : compressedIndices)
+                       {
+                         archive.Read(index, buffer.data(), buffer.size(), pool);
+                       }
+                     }
+                     return static_cast<double>(rawBytes * rounds) / ElapsedNanoseconds(startTime);   // バイト/ナノ秒 = GB/s
+                   };
+
+    const double singleThroughput = measure(nullptr);
+    const double poolThroughput = measure(&threadPool);
+    std::printf("decode : %zu entries, %llu -> %llu bytes (ratio %.3f)\n",
+                compressedIndices.size(),
+                static_cast<unsigned long long>(rawBytes),
+                static_cast<unsigned long long>(storedBytes),
+                static_cast<double>(storedBytes) / static_cast<double>(rawBytes));
+    std::printf("decode : %.2f GB/s per core, %.2f GB/s with %u threads\n", singleThroughput, poolThroughput, threadPool.GetThreadCount() + 1);
+  }
+
+  // 同じ入力を一つずつ同期で読む場合と、AsyncFileServiceに全部要求してから待つ場合を比べる
+  void RunLoadBenchmark(const std::vector<PackItem>& items, MFramework::AsyncFileService& fileService)
+  {
+    using namespace MFramework;
+
+    uint64_t totalBytes = 0;
+    std::vector<std::vector<uint8_t>> buffers(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+      // 追加した後のデータは解放しているので大きさはファイルから取る
+      std::error_code error;
+      buffers[i].resize(static_cast<size_t>(std::filesystem::file_size(ToPath(items[i].FilePath), error)));
+      totalBytes += buffers[i].size();
+    }
+
+    if (totalBytes == 0)
+    {
+      return;
+    }
+
+    const uint64_t rounds = std::max<uint64_t>(BENCHMARK_LOAD_BYTES / totalBytes, 1);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < rounds; ++round)
+    {
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+        std::ifstream stream(ToPath(items[i].FilePath), std::ios::binary);
+        stream.read(reinterpret_cast<char*>(buffers[i].data()), static_cast<std::streamsize>(buffers[i].size()));
+      }
+    }
+    const double syncTime = ElapsedNanoseconds(startTime) / static_cast<double>(rounds);
+
+    const AsyncFileServiceStats startStats = fileService.GetStats();
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < rounds; ++round)
+    {
+      for (size_t begin = 0; begin < items.size(); begin += LOAD_BATCH_FILE_COUNT)
+      {
+        const size_t end = std::min(begin + LOAD_BATCH_FILE_COUNT, items.size());
+        for (size_t i = begin; i < end; ++i)
+        {
+          const uint32_t file = fileService.OpenFile(items[i].FilePath);
+          fileService.Read(
+                            file,
+                            0,
+                            buffers[i].size(),
+                            buffers[i].data(),
+                            AsyncFilePriority::Normal,
+                            [](const AsyncFileResult&)
+                            { }
+                          );
+          fileService.CloseFile(file);
+        }
+        fileService.WaitIdle();
+      }
+    }
+    const double asyncTime = ElapsedNanoseconds(startTime) / static_cast<double>(rounds);
+    const AsyncFileServiceStats stats = fileService.GetStats();
+
+    std::printf("load   : %zu files %llu bytes, sync %.2f ms, async %.2f ms (%s, %llu reads)\n",
+                items.size(),
+                static_cast<unsigned long long>(totalBytes),
+                syncTime / 1000000.0,
+                asyncTime / 1000000.0,
+                fileService.GetBackendName(),
+                static_cast<unsigned long long>((stats.ReadCount - startStats.ReadCount) / rounds));
+  }
+
+  // 一回目の解決(マウントを探す)と、キャッシュに当たる二回目以降の解決を比べる
+  void RunVfsBenchmark(const std::string& archivePath, const std::vector<PackItem>& items, const std::vector<std::string>& missingPaths)
+  {
+    using namespace MFramework;
+
+    VirtualFileSystem fileSystem;
+    if (fileSystem.MountArchive(archivePath) == VirtualFileSystem::INVALID_MOUNT_ID)
+    {
+      std::fprintf(stderr, "cannot mount : %s\n", archivePath.c_str());
+      return;
+    }
+
+    uint64_t foundCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (const PackItem& item : items)
+    {
+      foundCount += fileSystem.Exists(item.ArchivePath) ? 1 : 0;
+    }
+    const double firstTime = ElapsedNanoseconds(startTime) / static_cast<double>(items.size());
+
+    const uint64_t lookupRounds = std::max<uint64_t>(BENCHMARK_LOOKUP_COUNT / items.size(), 1);
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < lookupRounds; ++round)
+    {
+      for (const PackItem& item : items)
+      {
+        foundCount += fileSystem.Exists(item.ArchivePath) ? 1 : 0;
+      }
+    }
+    const double hitTime = ElapsedNanoseconds(startTime) / static_cast<double>(lookupRounds * items.size());
+
+    // 見つからなかった結果もキャッシュしているので、二回目からはマウントを探さない
+    for (const std::string& path : missingPaths)
+    {
+      foundCount += fileSystem.Exists(path) ? 1 : 0;
+    }
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < lookupRounds; ++round)
+    {
+      for (const std::string& path : missingPaths)
+      {
+        foundCount += fileSystem.Exists(path) ? 1 : 0;
+      }
+    }
+    const double missTime = ElapsedNanoseconds(startTime) / static_cast<double>(lookupRounds * missingPaths.size());
+
+    const VirtualFileSystemStats stats = fileSystem.GetStats();
+    std::printf("vfs    : first %.1f ns, cached hit %.1f ns, cached miss %.1f ns (%llu found, %llu cache entries)\n",
+                firstTime,
+                hitTime,
+                missTime,
+                static_cast<unsigned long long>(foundCount),
+                static_cast<unsigned long long>(stats.CacheEntryCount));
+  }
+
+  void RunBenchmark(const std::string& archivePath, const std::vector<PackItem>& items, MFramework::ThreadPool& threadPool, MFramework::AsyncFileService& fileService)
+  {
+    using namespace MFramework;
+
+    // 一回目はページキャッシュの状態に左右されるので、二回目以降の平均と分けて表示する
+    auto startTime = std::chrono::steady_clock::now();
+    AssetArchive archive;
+    if (!archive.Open(archivePath))
+    {
+      std::fprintf(stderr, "cannot open : %s\n", archivePath.c_str());
+      return;
+    }
+    const double firstOpenTime = ElapsedNanoseconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < BENCHMARK_OPEN_COUNT; ++i)
+    {
+      AssetArchive reopened;
+      reopened.Open(archivePath);
+    }
+    const double openTime = ElapsedNanoseconds(startTime) / BENCHMARK_OPEN_COUNT;
+
+    if (items.empty())
+    {
+      std::printf("open   : first %.1f us, average %.1f us\n", firstOpenTime / 1000.0, openTime / 1000.0);
+      return;
+    }
+
+    // 見つかる場合と見つからない場合を別々に計測する
+    // Findは圧縮したエントリーで無効なビューを返すので、テーブルの検索だけをFindIndexで計る
+    std::vector<std::string> missingPaths;
+    missingPaths.reserve(items.size());
+    for (const PackItem& item : items)
+    {
+      missingPaths.emplace_back(item.ArchivePath + ".missing");
+    }
+
+    const uint64_t lookupRounds = std::max<uint64_t>(BENCHMARK_LOOKUP_COUNT / items.size(), 1);
+    uint64_t foundCount = 0;
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < lookupRounds; ++round)
+    {
+      for (const PackItem& item : items)
+      {
+        foundCount += (archive.FindIndex(item.ArchivePath) != ASSET_ARCHIVE_EMPTY_BUCKET) ? 1 : 0;
+      }
+    }
+    const double hitTime = ElapsedNanoseconds(startTime) / static_cast<double>(lookupRounds * items.size());
+
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < lookupRounds; ++round)
+    {
+      for (const std::string& path : missingPaths)
+      {
+        foundCount += (archive.FindIndex(path) != ASSET_ARCHIVE_EMPTY_BUCKET) ? 1 : 0;
+      }
+    }
+    const double missTime = ElapsedNanoseconds(startTime) / static_cast<double>(lookupRounds * items.size());
+
+    // FileUtility::SearchFilePathが一回の候補ごとに行うファイルの存在確認に相当する
+    const uint64_t probeRounds = std::max<uint64_t>(BENCHMARK_PROBE_COUNT / items.size(), 1);
+    uint64_t existCount = 0;
+    startTime = std::chrono::steady_clock::now();
+    for (uint64_t round = 0; round < probeRounds; ++round)
+    {
+      for (const PackItem& item : items)
+      {
+        std::error_code error;
+        existCount += std::filesystem::exists(ToPath(item.FilePath), error) ? 1 : 0;
+      }
+    }
+    const double probeTime = ElapsedNanoseconds(startTime) / static_cast<double>(probeRounds * items.size());
+
+    std::printf("open   : first %.1f us, average %.1f us (%u entries)\n", firstOpenTime / 1000.0, openTime / 1000.0, archive.GetCount());
+    std::printf("lookup : hit %.1f ns, miss %.1f ns (%llu found)\n", hitTime, missTime, static_cast<unsigned long long>(foundCount));
+    std::printf("probe  : filesystem exists %.1f ns (%llu found)\n", probeTime, static_cast<unsigned long long>(existCount));
+
+    RunVfsBenchmark(archivePath, items, missingPaths);
+    RunDecodeBenchmark(archive, threadPool);
+    RunLoadBenchmark(items, fileService);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MFramework;
+
+  PackerOptions options{};
+  if (!ParseArguments(argc, argv, options) || options.DataAlignment == 0 || (options.DataAlignment & (options.DataAlignment - 1)) != 0 || options.BlockSize == 0)
+  {
+    PrintUsage();
+    return 2;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  std::vector<PackItem> items;
+  if (!CollectItems(options, items))
+  {
+    return 1;
+  }
+
+  // 読み込みは非同期にまとめて要求し、追加は順番に行う(同じ入力なら同じファイルになる)
+  ThreadPool threadPool;
+  threadPool.Init(options.JobCount);
+  const uint32_t threadCount = threadPool.GetThreadCount() + 1;   // 呼び出したスレッドも参加する
+
+  AsyncFileService fileService;
+  if (!fileService.Init(AsyncFileServiceDesc{}))
+  {
+    std::fprintf(stderr, "cannot start file service\n");
+    return 1;
+  }
+  LoadItems(items, fileService);
+
+  const Lz4Codec lz4Codec;
+  AssetArchiveWriter writer;
+  if (options.IsCompress)
+  {
+    writer.SetCompression(&lz4Codec, options.BlockSize);
+  }
+
+  uint64_t totalSize = 0;
+  bool isSucceeded = true;
+  for (PackItem& item : items)
+  {
+    if (!item.IsLoaded)
+    {
+      std::fprintf(stderr, "cannot read : %s\n", item.FilePath.c_str());
+      isSucceeded = false;
+      continue;
+    }
+
+    if (!writer.Add(item.ArchivePath, item.Data.data(), item.Data.size(), !IsPrecompressed(item.ArchivePath)))
+    {
+      std::fprintf(stderr, "duplicate path with different content : %s\n", item.ArchivePath.c_str());
+      isSucceeded = false;
+    }
+
+    totalSize += item.Data.size();
+    item.Data = std::vector<uint8_t>();
+  }
+
+  if (!isSucceeded)
+  {
+    std::fprintf(stderr, "pack failed\n");
+    return 1;
+  }
+
+  if (!writer.WriteToFile(options.OutputPath, options.DataAlignment, &threadPool))
+  {
+    std::fprintf(stderr, "cannot write : %s\n", options.OutputPath.c_str());
+    return 1;
+  }
+
+  if (options.IsVerify)
+  {
+    AssetArchive archive;
+    if (!archive.Open(options.OutputPath, true))
+    {
+      std::fprintf(stderr, "verification failed : %s\n", options.OutputPath.c_str());
+      return 1;
+    }
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+  std::printf("%zu files, %llu bytes -> %s (%lld ms, %u threads)\n",
+              writer.GetCount(),
+              static_cast<unsigned long long>(totalSize),
+              options.OutputPath.c_str(),
+              static_cast<long long>(elapsed.count()),
+              threadCount);
+
+  if (options.IsBenchmark)
+  {
+    RunBenchmark(options.OutputPath, items, threadPool, fileService);
+  }
+
+  fileService.Dispose();
+  threadPool.Dispose();
+  return 0;
+}
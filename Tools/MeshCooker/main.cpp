@@ -0,0 +1,923 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline mesh cooker
+
+Update History: 2026/10/19 Create
+                2026/10/19 Quantized vertex formats
+                2026/10/19 Meshlets
+                2026/10/19 LOD chain
+                2026/10/19 Instance batching benchmark
+                2026/10/19 Draw packet sort benchmark
+                2026/10/19 Move instance batching benchmark to RenderBenchmark
+                2026/10/19 Move draw packet sort benchmark to RenderBenchmark
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+// 使い方
+// MeshCooker [--output <dir>] [--cache-size <n>] [--overdraw-threshold <f>] [--no-overdraw]
+//            [--vertex-format full|compact] [--no-meshlets] [--lods <n>] [--lod-error <f>] [--jobs <n>] [--benchmark] <input.obj|gltf|glb>...
+//
+// OBJ / glTFを読み込み、頂点の重複をまとめてから頂点キャッシュ(Forsyth)、オーバードロー、頂点フェッチの順に最適化して
+// 一つの入力ごとに.mmshとして書き出す
+// メッシュごとに最適化前(重複をまとめた直後の順番)と最適化後のACMR / ATVRを表示する(FIFOキャッシュ、--cache-sizeで大きさを変える)
+// --vertex-format compactでは頂点を量子化して16バイトにし、書き出したファイルから戻した頂点の最大誤差を表示する
+// 最適化後の三角形の順番でメッシュレット(頂点64、三角形124まで)を作ってファイルに含める(--no-meshletsで省く)
+// 二次誤差で三角形を半分ずつ減らしたLODを--lodsの数まで作り、それぞれ頂点キャッシュの順に並べて含める(--lods 0で省く)
+// --benchmarkを指定すると読み込んだメッシュで段階ごとの処理時間、1スレッドとスレッドプールの比較、キャッシュの大きさごとのACMR、
+// 頂点の形ごとの変換速度と誤差、メッシュレットの生成速度と大きさ、メッシュの周りを回るカメラでのカリング速度と残る三角形の割合、
+// LODの生成速度(1スレッドとスレッドプール)、レベルごとの誤差の見積もりと実測、距離ごとに選ばれるレベルを表示する
+
+#include <RenderSystem/Camera.h>
+#include <RenderSystem/CookedMeshFormat.h>
+#include <RenderSystem/GltfMeshImporter.h>
+#include <RenderSystem/MeshletBuilder.h>
+#include <RenderSystem/MeshletCuller.h>
+#include <RenderSystem/MeshLodSelector.h>
+#include <RenderSystem/MeshOptimizer.h>
+#include <RenderSystem/MeshSimplifier.h>
+#include <RenderSystem/ObjMeshImporter.h>
+#include <RenderSystem/VertexQuantizer.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr const char* COOKED_MESH_EXTENSION = ".mmsh";
+
+  // --benchmarkで比べるFIFOキャッシュの大きさ
+  constexpr uint32_t BENCHMARK_CACHE_SIZES[] = { 8, 16, 32 };
+
+  // --benchmarkで頂点の変換を繰り返す回数
+  constexpr uint32_t BENCHMARK_VERTEX_REPEAT_COUNT = 10;
+
+  // --benchmarkでメッシュの周りに置くカメラの数と、カメラの距離(バウンディングスフィアの半径の倍数)
+  constexpr uint32_t BENCHMARK_CULL_VIEW_COUNT = 64;
+  constexpr float BENCHMARK_CULL_VIEW_DISTANCE = 2.5f;
+  constexpr uint32_t BENCHMARK_CULL_REPEAT_COUNT = 20;
+
+  // 作るLODの数の上限
+  constexpr uint32_t MAX_LOD_COUNT = 8;
+
+  // --benchmarkでLODを選ぶ画面の高さと、カメラの距離(バウンディングスフィアの半径の倍数)
+  constexpr float BENCHMARK_LOD_VIEWPORT_HEIGHT = 1080.0f;
+  constexpr float BENCHMARK_LOD_DISTANCES[] = { 2.0f, 4.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f };
+
+  struct CookerOptions
+  {
+    std::vector<std::string> InputPaths;
+    std::string OutputDir;
+    uint32_t CacheSize = MFramework::MeshOptimizer::DEFAULT_FIFO_CACHE_SIZE;
+    float OverdrawThreshold = MFramework::MeshOptimizer::DEFAULT_OVERDRAW_THRESHOLD;
+    bool IsOptimizeOverdraw = true;
+    bool IsBuildMeshlets = true;
+    uint32_t LodCount = MFramework::MeshSimplifier::DEFAULT_LOD_OPTIONS.MaxLodCount;
+    float LodError = MFramework::MeshSimplifier::DEFAULT_LOD_OPTIONS.MaxError;
+    bool IsBenchmark = false;
+    MFramework::VertexFormatDesc VertexFormat = MFramework::VERTEX_FORMAT_FULL;
+    uint32_t JobCount = 0;
+  };
+
+  /// @brief
+  /// メッシュ一つの最適化結果
+  struct MeshCookStats
+  {
+    uint64_t ImportVertexCount;
+    uint64_t VertexCount;
+    uint64_t TriangleCount;
+    double MissCountBefore;         // 重複をまとめた直後の順番での頂点シェーダー実行回数
+    double MissCountAfter;
+    MFramework::VertexQuantizationError QuantizationError;   // ファイルから戻した頂点の最大誤差
+    uint64_t MeshletCount;
+    uint64_t MeshletVertexCount;    // メッシュレットごとの頂点数の合計(境界で重複する頂点を含む)
+    uint64_t LodTriangleCounts[MAX_LOD_COUNT];                // 元のメッシュを除いたレベルごとの三角形数
+    float LodError;                 // 最も粗いレベルの誤差の最大値(バウンディングボックスの対角線に対する割合)
+  };
+
+  /// @brief
+  /// 段階ごとの処理時間(ナノ秒)
+  struct StageTimes
+  {
+    double Deduplicate;
+    double VertexCache;
+    double Overdraw;
+    double VertexFetch;
+  };
+
+  void PrintUsage()
+  {
+    std::printf("usage : MeshCooker [--output <dir>] [--cache-size <n>] [--overdraw-threshold <f>] [--no-overdraw]\n"
+                "                   [--vertex-format full|compact] [--no-meshlets] [--lods <n>] [--lod-error <f>]\n"
+                "                   [--jobs <n>] [--benchmark] <input.obj|gltf|glb>...\n"
+                "        --cache-size sets the FIFO cache used to report ACMR (default 16)\n"
+                "        --overdraw-threshold is the ACMR growth allowed by cluster reordering (default 1.05)\n"
+                "        --vertex-format full keeps 32 byte float vertices (default), compact quantizes them to 16 bytes\n"
+                "        --no-meshlets skips building meshlets (64 vertices / 124 triangles) for mesh shader and cluster culling\n"
+                "        --lods sets the number of simplified levels, each with half the triangles (default 4, max 8, 0 disables)\n"
+                "        --lod-error is the largest simplification error allowed as a fraction of the bounds diagonal (default 0.05)\n");
+  }
+
+  bool ParseArguments(int argc, char** argv, CookerOptions& outOptions)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      const bool hasValue = (i + 1 < argc);
+
+      if (arg == "--output" && hasValue)
+      {
+        outOptions.OutputDir = argv[++i];
+      }
+      else if (arg == "--cache-size" && hasValue)
+      {
+        outOptions.CacheSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--overdraw-threshold" && hasValue)
+      {
+        outOptions.OverdrawThreshold = std::strtof(argv[++i], nullptr);
+      }
+      else if (arg == "--no-overdraw")
+      {
+        outOptions.IsOptimizeOverdraw = false;
+      }
+      else if (arg == "--no-meshlets")
+      {
+        outOptions.IsBuildMeshlets = false;
+      }
+      else if (arg == "--lods" && hasValue)
+      {
+        outOptions.LodCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--lod-error" && hasValue)
+      {
+        outOptions.LodError = std::strtof(argv[++i], nullptr);
+      }
+      else if (arg == "--vertex-format" && hasValue)
+      {
+        const std::string format = argv[++i];
+        if (format == "full")
+        {
+          outOptions.VertexFormat = MFramework::VERTEX_FORMAT_FULL;
+        }
+        else if (format == "compact")
+        {
+          outOptions.VertexFormat = MFramework::VERTEX_FORMAT_COMPACT;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--jobs" && hasValue)
+      {
+        outOptions.JobCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--benchmark")
+      {
+        outOptions.IsBenchmark = true;
+      }
+      else if (!arg.empty() && arg[0] != '-')
+      {
+        outOptions.InputPaths.emplace_back(arg);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return !outOptions.InputPaths.empty() && outOptions.CacheSize > 0 && outOptions.OverdrawThreshold >= 1.0f && outOptions.LodCount <= MAX_LOD_COUNT && outOptions.LodError > 0.0f;
+  }
+
+  // パスはUTF-8として扱う(MappedFileと同じ)
+  std::filesystem::path ToPath(const std::string& utf8Path)
+  {
+    return std::filesystem::path(std::u8string(utf8Path.begin(), utf8Path.end()));
+  }
+
+  std::string GetOutputPath(const std::string& inputPath, const std::string& outputDir)
+  {
+    std::filesystem::path path = ToPath(inputPath);
+    if (!outputDir.empty())
+    {
+      path = ToPath(outputDir) / path.filename();
+    }
+    path.replace_extension(COOKED_MESH_EXTENSION);
+
+    const std::u8string utf8Path = path.u8string();
+    return std::string(utf8Path.begin(), utf8Path.end());
+  }
+
+  /// @brief
+  /// 拡張子から読み込み方を選ぶ
+  const MFramework::IMeshImporter* GetImporter(const std::string& inputPath)
+  {
+    static const MFramework::ObjMeshImporter objImporter;
+    static const MFramework::GltfMeshImporter gltfImporter;
+
+    std::string extension = ToPath(inputPath).extension().string();
+    std::transform(
+                    extension.begin(),
+                    extension.end(),
+                    extension.begin(),
+                    [](char c)
+                    {
+                      return static_cast<char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+                    }
+                  );
+
+    if (extension == ".obj")
+    {
+      return &objImporter;
+    }
+    if (extension == ".gltf" || extension == ".glb")
+    {
+      return &gltfImporter;
+    }
+    return nullptr;
+  }
+
+  double ElapsedNanoseconds(std::chrono::steady_clock::time_point startTime)
+  {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  /// @brief
+  /// メッシュ一つを最適化する
+  /// @param outTimes nullptrでなければ段階ごとの処理時間を足す
+  void OptimizeMesh(MFramework::MeshData& mesh, const CookerOptions& options, MeshCookStats& outStats, StageTimes* outTimes)
+  {
+    using namespace MFramework;
+
+    outStats.ImportVertexCount = mesh.Vertices.size();
+    outStats.TriangleCount = mesh.Indices.size() / 3;
+
+    auto startTime = std::chrono::steady_clock::now();
+    MeshOptimizer::DeduplicateVertices(mesh);
+    if (!mesh.HasNormals)
+    {
+      MeshOptimizer::ComputeNormals(mesh);
+    }
+    const double deduplicateTime = ElapsedNanoseconds(startTime);
+
+    const VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size(), options.CacheSize);
+
+    startTime = std::chrono::steady_clock::now();
+    MeshOptimizer::OptimizeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size());
+    const double vertexCacheTime = ElapsedNanoseconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    if (options.IsOptimizeOverdraw)
+    {
+      MeshOptimizer::OptimizeOverdraw(mesh, options.CacheSize, options.OverdrawThreshold);
+    }
+    const double overdrawTime = ElapsedNanoseconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    MeshOptimizer::OptimizeVertexFetch(mesh);
+    const double vertexFetchTime = ElapsedNanoseconds(startTime);
+
+    const VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(mesh.Indices.data(), mesh.Indices.size(), mesh.Vertices.size(), options.CacheSize);
+
+    outStats.VertexCount = mesh.Vertices.size();
+    outStats.MissCountBefore = static_cast<double>(before.ACMR) * static_cast<double>(outStats.TriangleCount);
+    outStats.MissCountAfter = static_cast<double>(after.ACMR) * static_cast<double>(outStats.TriangleCount);
+
+    if (outTimes != nullptr)
+    {
+      outTimes->Deduplicate += deduplicateTime;
+      outTimes->VertexCache += vertexCacheTime;
+      outTimes->Overdraw += overdrawTime;
+      outTimes->VertexFetch += vertexFetchTime;
+    }
+  }
+
+  void MergeError(MFramework::VertexQuantizationError& total, const MFramework::VertexQuantizationError& error)
+  {
+    total.Position = std::max(total.Position, error.Position);
+    total.NormalDegrees = std::max(total.NormalDegrees, error.NormalDegrees);
+    total.TexCoord = std::max(total.TexCoord, error.TexCoord);
+  }
+
+  void AddStats(MeshCookStats& total, const MeshCookStats& stats)
+  {
+    total.ImportVertexCount += stats.ImportVertexCount;
+    total.VertexCount += stats.VertexCount;
+    total.TriangleCount += stats.TriangleCount;
+    total.MissCountBefore += stats.MissCountBefore;
+    total.MissCountAfter += stats.MissCountAfter;
+    MergeError(total.QuantizationError, stats.QuantizationError);
+    total.MeshletCount += stats.MeshletCount;
+    total.MeshletVertexCount += stats.MeshletVertexCount;
+    for (uint32_t i = 0; i < MAX_LOD_COUNT; ++i)
+    {
+      total.LodTriangleCounts[i] += stats.LodTriangleCounts[i];
+    }
+    total.LodError = std::max(total.LodError, stats.LodError);
+  }
+
+  float ComputeBoundsDiagonal(const MFramework::MeshData& mesh)
+  {
+    if (mesh.Vertices.empty())
+    {
+      return 0.0f;
+    }
+
+    float boundsMin[3] = { mesh.Vertices[0].Position[0], mesh.Vertices[0].Position[1], mesh.Vertices[0].Position[2] };
+    float boundsMax[3] = { boundsMin[0], boundsMin[1], boundsMin[2] };
+    for (const MFramework::MeshVertex& vertex : mesh.Vertices)
+    {
+      for (uint32_t axis = 0; axis < 3; ++axis)
+      {
+        boundsMin[axis] = std::min(boundsMin[axis], vertex.Position[axis]);
+        boundsMax[axis] = std::max(boundsMax[axis], vertex.Position[axis]);
+      }
+    }
+
+    const float extent[3] = { boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] };
+    return std::sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]);
+  }
+
+  /// @brief
+  /// 最適化後のメッシュからLODを作り、レベルごとに頂点キャッシュの順に並べる
+  void BuildLods(const MFramework::MeshData& mesh, const CookerOptions& options, std::vector<MFramework::MeshLod>& outLods, MeshCookStats& outStats)
+  {
+    using namespace MFramework;
+
+    MeshLodOptions lodOptions = MeshSimplifier::DEFAULT_LOD_OPTIONS;
+    lodOptions.MaxLodCount = options.LodCount;
+    lodOptions.MaxError = options.LodError;
+    MeshSimplifier::BuildLods(mesh, lodOptions, outLods);
+
+    for (size_t i = 0; i < outLods.size(); ++i)
+    {
+      MeshOptimizer::OptimizeVertexCache(outLods[i].Indices.data(), outLods[i].Indices.size(), mesh.Vertices.size());
+      outStats.LodTriangleCounts[i] = outLods[i].Indices.size() / 3;
+    }
+
+    const float diagonal = ComputeBoundsDiagonal(mesh);
+    if (!outLods.empty() && diagonal > 0.0f)
+    {
+      outStats.LodError = outLods.back().Error / diagonal;
+    }
+  }
+
+  void BuildMeshlets(const MFramework::MeshData& mesh, MFramework::MeshletData& outMeshlets, MeshCookStats& outStats)
+  {
+    MFramework::MeshletBuilder::Build(mesh, outMeshlets);
+
+    outStats.MeshletCount = outMeshlets.Meshlets.size();
+    outStats.MeshletVertexCount = outMeshlets.VertexIndices.size();
+  }
+
+  bool CookMeshFile(const std::string& inputPath, const std::string& outputPath, const CookerOptions& options, MFramework::ThreadPool& threadPool,
+                    MeshCookStats& outStats, uint64_t& outSize, std::vector<MFramework::MeshData>* outImportedMeshes, std::string& outError)
+  {
+    using namespace MFramework;
+
+    const IMeshImporter* importer = GetImporter(inputPath);
+    if (importer == nullptr)
+    {
+      outError = "unsupported file type";
+      return false;
+    }
+
+    std::vector<MeshData> meshes;
+    if (!importer->Import(inputPath, meshes, outError))
+    {
+      return false;
+    }
+
+    if (outImportedMeshes != nullptr)
+    {
+      *outImportedMeshes = meshes;
+    }
+
+    // メッシュ単位で並列に最適化する
+    std::vector<MeshCookStats> meshStats(meshes.size());
+    std::vector<MeshletData> meshlets(options.IsBuildMeshlets ? meshes.size() : 0);
+    std::vector<std::vector<MeshLod>> lods(meshes.size());
+    threadPool.ParallelFor(
+                            meshes.size(),
+                            [&](size_t begin, size_t end)
+                            {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                OptimizeMesh(meshes[i], options, meshStats[i], nullptr);
+                                if (!meshlets.empty())
+                                {
+                                  BuildMeshlets(meshes[i], meshlets[i], meshStats[i]);
+                                }
+                                BuildLods(meshes[i], options, lods[i], meshStats[i]);
+                              }
+                            }
+                          );
+
+    outStats = MeshCookStats{};
+    for (const MeshCookStats& stats : meshStats)
+    {
+      AddStats(outStats, stats);
+    }
+
+    std::vector<uint8_t> file;
+    if (!CookedMeshFormat::Serialize(meshes, meshlets, lods, options.VertexFormat, file, outError))
+    {
+      return false;
+    }
+
+    // 実行時と同じ検証を通ることを確認してから書き出す
+    CookedMeshView view{};
+    if (!CookedMeshFormat::Parse(file.data(), file.size(), view, outError, true))
+    {
+      return false;
+    }
+
+    // 書き出す内容から戻した頂点を最適化後の頂点と比べる
+    for (uint32_t i = 0; i < view.Header->MeshCount; ++i)
+    {
+      MeshData decoded{};
+      CookedMeshFormat::ReadMesh(view, i, decoded);
+      MergeError(outStats.QuantizationError, VertexQuantizer::MeasureError(meshes[i].Vertices.data(), decoded.Vertices.data(), decoded.Vertices.size()));
+    }
+
+    if (!CookedMeshFormat::WriteToFile(outputPath, file))
+    {
+      outError = "cannot write " + outputPath;
+      return false;
+    }
+
+    outSize = file.size();
+    return true;
+  }
+
+  double ComputeACMR(double missCount, uint64_t triangleCount)
+  {
+    return (triangleCount > 0) ? missCount / static_cast<double>(triangleCount) : 0.0;
+  }
+
+  /// @brief
+  /// 最適化後のメッシュでメッシュレットの生成とカリングを計る
+  void RunMeshletBenchmark(const std::vector<MFramework::MeshData>& meshes)
+  {
+    using namespace MFramework;
+
+    uint64_t triangleCount = 0;
+    uint64_t meshletCount = 0;
+    uint64_t meshletVertexCount = 0;
+    uint64_t coneCount = 0;                 // 裏面の判定ができるメッシュレットの数
+    double buildTime = 0.0;
+    double cullTime = 0.0;
+    MeshletCullStats cullStats{};
+    std::vector<uint32_t> visibleIndices;
+    for (const MeshData& mesh : meshes)
+    {
+      MeshletData meshlets{};
+      auto startTime = std::chrono::steady_clock::now();
+      MeshletBuilder::Build(mesh, meshlets);
+      buildTime += ElapsedNanoseconds(startTime);
+
+      triangleCount += mesh.Indices.size() / 3;
+      meshletCount += meshlets.Meshlets.size();
+      meshletVertexCount += meshlets.VertexIndices.size();
+      for (const MeshletBounds& bounds : meshlets.Bounds)
+      {
+        coneCount += (bounds.ConeCutoff < 1.0f) ? 1 : 0;
+      }
+
+      MeshletCullData cullData{};
+      MeshletCuller::Prepare(meshlets, cullData);
+
+      // メッシュのバウンディングスフィアを囲む円周上から中心を見る
+      float boundsMin[3] = { 0.0f, 0.0f, 0.0f };
+      float boundsMax[3] = { 0.0f, 0.0f, 0.0f };
+      for (size_t i = 0; i < mesh.Vertices.size(); ++i)
+      {
+        for (uint32_t axis = 0; axis < 3; ++axis)
+        {
+          boundsMin[axis] = (i == 0) ? mesh.Vertices[i].Position[axis] : std::min(boundsMin[axis], mesh.Vertices[i].Position[axis]);
+          boundsMax[axis] = (i == 0) ? mesh.Vertices[i].Position[axis] : std::max(boundsMax[axis], mesh.Vertices[i].Position[axis]);
+        }
+      }
+      const float center[3] = { (boundsMin[0] + boundsMax[0]) * 0.5f, (boundsMin[1] + boundsMax[1]) * 0.5f, (boundsMin[2] + boundsMax[2]) * 0.5f };
+      const float extent[3] = { boundsMax[0] - boundsMin[0], boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2] };
+      const float radius = std::max(0.5f * std::sqrt(extent[0] * extent[0] + extent[1] * extent[1] + extent[2] * extent[2]), 1.0e-3f);
+      const float up[3] = { 0.0f, 1.0f, 0.0f };
+
+      for (uint32_t view = 0; view < BENCHMARK_CULL_VIEW_COUNT; ++view)
+      {
+        // 半分は全体が入る距離から、半分は近づいて一部だけが入る距離から見る
+        const float angle = 6.2831853f * static_cast<float>(view) / static_cast<float>(BENCHMARK_CULL_VIEW_COUNT);
+        const float distance = radius * ((view % 2 == 0) ? BENCHMARK_CULL_VIEW_DISTANCE : 1.2f);
+        const float eye[3] = { center[0] + std::cos(angle) * distance, center[1] + radius * 0.3f, center[2] + std::sin(angle) * distance };
+
+        MGameEngine::Camera camera;
+        camera.SetLookAt(eye, center, up);
+        camera.SetPerspective(0.785398f, 16.0f / 9.0f, radius * 0.01f, radius * 10.0f);
+
+        MeshletCullStats stats{};
+        startTime = std::chrono::steady_clock::now();
+        for (uint32_t repeat = 0; repeat < BENCHMARK_CULL_REPEAT_COUNT; ++repeat)
+        {
+          stats = MeshletCuller::Cull(cullData, camera, visibleIndices);
+        }
+        cullTime += ElapsedNanoseconds(startTime);
+
+        cullStats.TestedCount += stats.TestedCount;
+        cullStats.FrustumCulledCount += stats.FrustumCulledCount;
+        cullStats.BackfaceCulledCount += stats.BackfaceCulledCount;
+        cullStats.VisibleCount += stats.VisibleCount;
+        cullStats.VisibleTriangleCount += stats.VisibleTriangleCount;
+      }
+    }
+
+    if (meshletCount == 0)
+    {
+      return;
+    }
+
+    const double testedCount = static_cast<double>(cullStats.TestedCount);
+    const double viewTriangleCount = static_cast<double>(triangleCount) * BENCHMARK_CULL_VIEW_COUNT;
+    std::printf("meshlet: %llu meshlets, %.1f vertices and %.1f triangles per meshlet, %.1f%% with normal cone, build %.2f Mtri/s\n",
+                static_cast<unsigned long long>(meshletCount),
+                static_cast<double>(meshletVertexCount) / static_cast<double>(meshletCount),
+                static_cast<double>(triangleCount) / static_cast<double>(meshletCount),
+                100.0 * static_cast<double>(coneCount) / static_cast<double>(meshletCount),
+                (buildTime > 0.0) ? static_cast<double>(triangleCount) / buildTime * 1.0e3 : 0.0);
+    std::printf("cull   : %u views, %.1f Mmeshlet/s, frustum culled %.1f%%, backface culled %.1f%%, visible triangles %.1f%%\n",
+                BENCHMARK_CULL_VIEW_COUNT,
+                (cullTime > 0.0) ? testedCount * BENCHMARK_CULL_REPEAT_COUNT / cullTime * 1.0e3 : 0.0,
+                100.0 * static_cast<double>(cullStats.FrustumCulledCount) / testedCount,
+                100.0 * static_cast<double>(cullStats.BackfaceCulledCount) / testedCount,
+                100.0 * static_cast<double>(cullStats.VisibleTriangleCount) / viewTriangleCount);
+  }
+
+  /// @brief
+  /// 最適化後のメッシュでLODの生成速度と品質、距離ごとに選ばれるレベルを計る
+  void RunLodBenchmark(const std::vector<MFramework::MeshData>& meshes, const CookerOptions& options, MFramework::ThreadPool& threadPool)
+  {
+    using namespace MFramework;
+
+    if (options.LodCount == 0)
+    {
+      return;
+    }
+
+    // 1スレッドとメッシュ単位のスレッドプールで作る
+    std::vector<std::vector<MeshLod>> lods(meshes.size());
+    std::vector<MeshCookStats> meshStats(meshes.size());
+    auto startTime = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+      BuildLods(meshes[i], options, lods[i], meshStats[i]);
+    }
+    const double singleTime = ElapsedNanoseconds(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    threadPool.ParallelFor(
+                            meshes.size(),
+                            [&](size_t begin, size_t end)
+                            {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                BuildLods(meshes[i], options, lods[i], meshStats[i]);
+                              }
+                            }
+                          );
+    const double poolTime = ElapsedNanoseconds(startTime);
+
+    uint64_t triangleCount = 0;
+    for (const MeshData& mesh : meshes)
+    {
+      triangleCount += mesh.Indices.size() / 3;
+    }
+    std::printf("lod    : build %.2f Mtri/s with 1 thread, %.2f Mtri/s with %u threads\n",
+                (singleTime > 0.0) ? static_cast<double>(triangleCount) / singleTime * 1.0e3 : 0.0,
+                (poolTime > 0.0) ? static_cast<double>(triangleCount) / poolTime * 1.0e3 : 0.0,
+                threadPool.GetThreadCount() + 1);
+
+    // レベルごとに誤差の見積もりと、元の頂点から減らした面までの実際の距離を比べる(対角線に対する割合の最大値)
+    for (uint32_t level = 0; level < options.LodCount; ++level)
+    {
+      uint64_t levelTriangleCount = 0;
+      uint64_t sourceTriangleCount = 0;
+      float maxError = 0.0f;
+      float maxDeviation = 0.0f;
+      for (size_t i = 0; i < meshes.size(); ++i)
+      {
+        if (level >= lods[i].size())
+        {
+          continue;
+        }
+
+        const float diagonal = std::max(ComputeBoundsDiagonal(meshes[i]), 1.0e-6f);
+        const MeshLod& lod = lods[i][level];
+        levelTriangleCount += lod.Indices.size() / 3;
+        sourceTriangleCount += meshes[i].Indices.size() / 3;
+        maxError = std::max(maxError, lod.Error / diagonal);
+        maxDeviation = std::max(maxDeviation, MeshSimplifier::MeasureDeviation(meshes[i], lod.Indices.data(), lod.Indices.size()) / diagonal);
+      }
+
+      if (sourceTriangleCount == 0)
+      {
+        break;
+      }
+
+      std::printf("lod    : level %u, %llu triangles (%.1f%%), error %.4f%% of diagonal, measured %.4f%%\n",
+                  level + 1,
+                  static_cast<unsigned long long>(levelTriangleCount),
+                  100.0 * static_cast<double>(levelTriangleCount) / static_cast<double>(sourceTriangleCount),
+                  100.0f * maxError,
+                  100.0f * maxDeviation);
+    }
+
+    // 最も大きいメッシュを遠ざけながら選ばれるレベルを見る
+    size_t largestIndex = 0;
+    for (size_t i = 1; i < meshes.size(); ++i)
+    {
+      if (meshes[i].Indices.size() > meshes[largestIndex].Indices.size())
+      {
+        largestIndex = i;
+      }
+    }
+
+    const MeshData& mesh = meshes[largestIndex];
+    std::vector<float> lodErrors(1, 0.0f);
+    std::vector<uint64_t> lodTriangleCounts(1, mesh.Indices.size() / 3);
+    for (const MeshLod& lod : lods[largestIndex])
+    {
+      lodErrors.emplace_back(lod.Error);
+      lodTriangleCounts.emplace_back(lod.Indices.size() / 3);
+    }
+
+    const float radius = std::max(ComputeBoundsDiagonal(mesh) * 0.5f, 1.0e-6f);
+    const float center[3] = { 0.0f, 0.0f, 0.0f };
+    const float up[3] = { 0.0f, 1.0f, 0.0f };
+    std::printf("lod    : select at %.0fp, %.1f px :", BENCHMARK_LOD_VIEWPORT_HEIGHT, MeshLodSelector::DEFAULT_MAX_PIXEL_ERROR);
+    for (const float distance : BENCHMARK_LOD_DISTANCES)
+    {
+      const float eye[3] = { 0.0f, 0.0f, -radius * distance };
+      MGameEngine::Camera camera;
+      camera.SetLookAt(eye, center, up);
+
+      const uint32_t level = MeshLodSelector::Select(lodErrors.data(), static_cast<uint32_t>(lodErrors.size()), center, radius, 1.0f, camera, BENCHMARK_LOD_VIEWPORT_HEIGHT);
+      std::printf(" %.0fr -> %u (%llu tri)", distance, level, static_cast<unsigned long long>(lodTriangleCounts[level]));
+    }
+    std::printf("\n");
+  }
+
+  void RunBenchmark(const std::vector<MFramework::MeshData>& importedMeshes, const CookerOptions& options, MFramework::ThreadPool& threadPool)
+  {
+    using namespace MFramework;
+
+    if (importedMeshes.empty())
+    {
+      return;
+    }
+
+    // 1スレッドで段階ごとの時間を計る
+    std::vector<MeshData> meshes = importedMeshes;
+    StageTimes stageTimes{};
+    MeshCookStats total{};
+    auto startTime = std::chrono::steady_clock::now();
+    for (MeshData& mesh : meshes)
+    {
+      MeshCookStats stats{};
+      OptimizeMesh(mesh, options, stats, &stageTimes);
+      AddStats(total, stats);
+    }
+    const double singleTime = ElapsedNanoseconds(startTime);
+
+    // メッシュ単位でスレッドプールに分ける
+    meshes = importedMeshes;
+    startTime = std::chrono::steady_clock::now();
+    threadPool.ParallelFor(
+                            meshes.size(),
+                            [&](size_t begin, size_t end)
+                            {
+                              for (size_t i = begin; i < end; ++i)
+                              {
+                                MeshCookStats stats{};
+                                OptimizeMesh(meshes[i], options, stats, nullptr);
+                              }
+                            }
+                          );
+    const double poolTime = ElapsedNanoseconds(startTime);
+
+    const double triangleCount = static_cast<double>(total.TriangleCount);
+    std::printf("stage  : dedup %.2f ms, vertex cache %.2f ms, overdraw %.2f ms, vertex fetch %.2f ms\n",
+                stageTimes.Deduplicate / 1.0e6,
+                stageTimes.VertexCache / 1.0e6,
+                stageTimes.Overdraw / 1.0e6,
+                stageTimes.VertexFetch / 1.0e6);
+    std::printf("speed  : %zu meshes, %llu triangles, %.2f Mtri/s with 1 thread, %.2f Mtri/s with %u threads\n",
+                meshes.size(),
+                static_cast<unsigned long long>(total.TriangleCount),
+                triangleCount / singleTime * 1.0e3,
+                triangleCount / poolTime * 1.0e3,
+                threadPool.GetThreadCount() + 1);
+
+    // 最適化は一つのキャッシュの大きさに合わせないので、大きさを変えても効果が残ることを確認する
+    for (const uint32_t cacheSize : BENCHMARK_CACHE_SIZES)
+    {
+      double missBefore = 0.0;
+      double missAfter = 0.0;
+      for (size_t i = 0; i < meshes.size(); ++i)
+      {
+        MeshData deduplicated = importedMeshes[i];
+        MeshOptimizer::DeduplicateVertices(deduplicated);
+
+        const VertexCacheStats before = MeshOptimizer::AnalyzeVertexCache(deduplicated.Indices.data(), deduplicated.Indices.size(), deduplicated.Vertices.size(), cacheSize);
+        const VertexCacheStats after = MeshOptimizer::AnalyzeVertexCache(meshes[i].Indices.data(), meshes[i].Indices.size(), meshes[i].Vertices.size(), cacheSize);
+        const double meshTriangleCount = static_cast<double>(meshes[i].Indices.size() / 3);
+        missBefore += before.ACMR * meshTriangleCount;
+        missAfter += after.ACMR * meshTriangleCount;
+      }
+
+      std::printf("acmr   : fifo %2u, %.3f -> %.3f\n", cacheSize, ComputeACMR(missBefore, total.TriangleCount), ComputeACMR(missAfter, total.TriangleCount));
+    }
+
+    // 頂点の形ごとに最適化後の頂点を変換して戻す
+    const VertexFormatDesc vertexFormats[] = { VERTEX_FORMAT_FULL, VERTEX_FORMAT_COMPACT };
+    for (const VertexFormatDesc& vertexFormat : vertexFormats)
+    {
+      VertexLayout layout{};
+      std::string error;
+      VertexFormat::CreateLayout(vertexFormat, layout, error);
+
+      uint64_t vertexCount = 0;
+      double encodeTime = 0.0;
+      double decodeTime = 0.0;
+      VertexQuantizationError maxError{};
+      for (const MeshData& mesh : meshes)
+      {
+        const VertexQuantization quantization = VertexQuantizer::ComputeQuantization(mesh.Vertices.data(), mesh.Vertices.size());
+        std::vector<uint8_t> encoded(static_cast<size_t>(layout.Stride) * mesh.Vertices.size());
+        std::vector<MeshVertex> decoded(mesh.Vertices.size());
+
+        startTime = std::chrono::steady_clock::now();
+        for (uint32_t repeat = 0; repeat < BENCHMARK_VERTEX_REPEAT_COUNT; ++repeat)
+        {
+          VertexQuantizer::Encode(mesh.Vertices.data(), mesh.Vertices.size(), layout, quantization, encoded.data());
+        }
+        encodeTime += ElapsedNanoseconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        for (uint32_t repeat = 0; repeat < BENCHMARK_VERTEX_REPEAT_COUNT; ++repeat)
+        {
+          VertexQuantizer::Decode(encoded.data(), mesh.Vertices.size(), layout, quantization, decoded.data());
+        }
+        decodeTime += ElapsedNanoseconds(startTime);
+
+        MergeError(maxError, VertexQuantizer::MeasureError(mesh.Vertices.data(), decoded.data(), decoded.size()));
+        vertexCount += mesh.Vertices.size();
+      }
+
+      const double convertedCount = static_cast<double>(vertexCount) * BENCHMARK_VERTEX_REPEAT_COUNT;
+      std::printf("vertex : %-7s %2u bytes, encode %.1f Mvert/s, decode %.1f Mvert/s, max error position %.2e of extent, normal %.4f deg, uv %.2e\n",
+                  (vertexFormat.Position == VertexElementFormat::Float3) ? "full" : "compact",
+                  layout.Stride,
+                  (encodeTime > 0.0) ? convertedCount / encodeTime * 1.0e3 : 0.0,
+                  (decodeTime > 0.0) ? convertedCount / decodeTime * 1.0e3 : 0.0,
+                  maxError.Position,
+                  maxError.NormalDegrees,
+                  maxError.TexCoord);
+    }
+
+    RunMeshletBenchmark(meshes);
+    RunLodBenchmark(meshes, options, threadPool);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MFramework;
+
+  CookerOptions options{};
+  if (!ParseArguments(argc, argv, options))
+  {
+    PrintUsage();
+    return 2;
+  }
+
+  if (!options.OutputDir.empty())
+  {
+    std::error_code error;
+    std::filesystem::create_directories(ToPath(options.OutputDir), error);
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  ThreadPool threadPool;
+  threadPool.Init(options.JobCount);
+  const uint32_t threadCount = threadPool.GetThreadCount() + 1;   // 呼び出したスレッドも参加する
+
+  // ファイル単位で並列に処理し、ファイルの中のメッシュも同じプールで分ける(ParallelForは入れ子にできる)
+  std::mutex logMutex;
+  std::atomic<uint32_t> failedCount = 0;
+  std::atomic<uint64_t> totalSize = 0;
+  MeshCookStats total{};
+  std::vector<MeshData> benchmarkMeshes;
+  threadPool.ParallelFor(
+                          options.InputPaths.size(),
+                          [&](size_t begin, size_t end)
+                          {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                              const std::string& inputPath = options.InputPaths[i];
+                              const std::string outputPath = GetOutputPath(inputPath, options.OutputDir);
+
+                              MeshCookStats stats{};
+                              uint64_t size = 0;
+                              std::vector<MeshData> importedMeshes;
+                              std::string error;
+                              const bool isSucceeded = CookMeshFile(inputPath, outputPath, options, threadPool, stats, size, options.IsBenchmark ? &importedMeshes : nullptr, error);
+
+                              std::lock_guard<std::mutex> lock(logMutex);
+                              if (isSucceeded)
+                              {
+                                totalSize += size;
+                                AddStats(total, stats);
+                                for (MeshData& mesh : importedMeshes)
+                                {
+                                  benchmarkMeshes.emplace_back(std::move(mesh));
+                                }
+
+                                std::printf("%s -> %s (%llu -> %llu vertices, %llu triangles, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %llu bytes)\n",
+                                            inputPath.c_str(),
+                                            outputPath.c_str(),
+                                            static_cast<unsigned long long>(stats.ImportVertexCount),
+                                            static_cast<unsigned long long>(stats.VertexCount),
+                                            static_cast<unsigned long long>(stats.TriangleCount),
+                                            ComputeACMR(stats.MissCountBefore, stats.TriangleCount),
+                                            ComputeACMR(stats.MissCountAfter, stats.TriangleCount),
+                                            (stats.VertexCount > 0) ? stats.MissCountBefore / static_cast<double>(stats.VertexCount) : 0.0,
+                                            (stats.VertexCount > 0) ? stats.MissCountAfter / static_cast<double>(stats.VertexCount) : 0.0,
+                                            static_cast<unsigned long long>(size));
+                                if (options.VertexFormat.Position != VertexElementFormat::Float3)
+                                {
+                                  std::printf("  quantized vertices : max error position %.2e of extent, normal %.4f deg, uv %.2e\n",
+                                              stats.QuantizationError.Position,
+                                              stats.QuantizationError.NormalDegrees,
+                                              stats.QuantizationError.TexCoord);
+                                }
+                                if (stats.LodTriangleCounts[0] > 0)
+                                {
+                                  std::printf("  lods : %llu", static_cast<unsigned long long>(stats.TriangleCount));
+                                  for (uint32_t lod = 0; lod < MAX_LOD_COUNT && stats.LodTriangleCounts[lod] > 0; ++lod)
+                                  {
+                                    std::printf(" -> %llu", static_cast<unsigned long long>(stats.LodTriangleCounts[lod]));
+                                  }
+                                  std::printf(" triangles, max error %.4f%% of diagonal\n", 100.0f * stats.LodError);
+                                }
+                                if (stats.MeshletCount > 0)
+                                {
+                                  std::printf("  meshlets : %llu (%.1f vertices, %.1f triangles per meshlet)\n",
+                                              static_cast<unsigned long long>(stats.MeshletCount),
+                                              static_cast<double>(stats.MeshletVertexCount) / static_cast<double>(stats.MeshletCount),
+                                              static_cast<double>(stats.TriangleCount) / static_cast<double>(stats.MeshletCount));
+                                }
+                              }
+                              else
+                              {
+                                ++failedCount;
+                                std::fprintf(stderr, "%s : %s\n", inputPath.c_str(), error.c_str());
+                              }
+                            }
+                          }
+                        );
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+  std::printf("%zu files (%u failed), %llu triangles, ACMR %.3f -> %.3f, %llu bytes (%lld ms, %u threads)\n",
+              options.InputPaths.size(),
+              failedCount.load(),
+              static_cast<unsigned long long>(total.TriangleCount),
+              ComputeACMR(total.MissCountBefore, total.TriangleCount),
+              ComputeACMR(total.MissCountAfter, total.TriangleCount),
+              static_cast<unsigned long long>(totalSize.load()),
+              static_cast<long long>(elapsed.count()),
+              threadCount);
+
+  if (options.IsBenchmark)
+  {
+    RunBenchmark(benchmarkMeshes, options, threadPool);
+  }
+
+  threadPool.Dispose();
+  return (failedCount.load() == 0) ? 0 : 1;
+}
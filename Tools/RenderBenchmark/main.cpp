@@ -0,0 +1,700 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Device independent render system benchmark
+
+Update History: 2026/10/19 Create
+                2026/10/19 Parallel recording benchmark
+                2026/10/19 Instance batching benchmark
+                2026/10/19 Draw packet sort benchmark
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+// 使い方
+// RenderBenchmark [--jobs <n>] [--graph] [--record] [--batch] [--sort]
+//
+// デバイスを使わずに計れるレンダーシステムの処理時間を計測する(何も指定しなければすべて)
+// --graphはパスの数ごとにレンダーグラフの宣言、初回のコンパイル、構造が変わらないときのキャッシュを使ったコンパイルの時間と、
+// 削除されたパスの数、バリアの数、一時リソースのヒープの大きさを表示する
+// --recordは描画をリストごとに分けてNullCommandListPoolのリストに記録し、1スレッドから--jobsのスレッド数までの記録速度を表示する
+// --batchはメッシュを並べたシーンでのオブジェクトごとの描画とインスタンス描画の回数と時間(Nullバックエンド)を表示する
+// --sortは描画パケットのソートキーの基数ソートの速度(1スレッドと--jobsのスレッド数、std::sortとの比較)と並べ替えの前後の状態の切り替え回数を表示する
+
+#include <RenderSystem/DrawPacketQueue.h>
+#include <RenderSystem/InstanceBatcher.h>
+#include <RenderSystem/NullCommandListPool.h>
+#include <RenderSystem/NullInstanceDrawBackend.h>
+#include <RenderSystem/RenderGraph.h>
+#include <RadixSort.h>
+#include <ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // --graphで作るグラフのパスの数と、一つの大きさで計測を繰り返す回数
+  constexpr uint32_t BENCHMARK_GRAPH_PASS_COUNTS[] = { 50, 100, 200, 500 };
+  constexpr uint32_t BENCHMARK_GRAPH_REPEAT_COUNT = 200;
+  // 前のパスに加えて何個前のパスの出力を読むかと、出力を誰も読まないパス(削除される)を足す間隔
+  constexpr uint32_t BENCHMARK_GRAPH_LONG_READ_DISTANCE = 4;
+  constexpr uint32_t BENCHMARK_GRAPH_UNUSED_PASS_INTERVAL = 10;
+
+  // --recordで記録する描画の数、一つのリストに記録する描画の数、計測するフレーム数
+  constexpr uint32_t BENCHMARK_RECORD_DRAW_COUNTS[] = { 2000, 10000, 50000 };
+  constexpr uint32_t BENCHMARK_RECORD_DRAWS_PER_LIST = 250;
+  constexpr uint32_t BENCHMARK_RECORD_FRAME_COUNT = 50;
+  // 記録する描画のルートシグネチャー、パイプラインステート、マテリアル、メッシュの種類の数
+  constexpr uint32_t BENCHMARK_RECORD_ROOT_SIGNATURE_COUNT = 4;
+  constexpr uint32_t BENCHMARK_RECORD_PIPELINE_STATE_COUNT = 64;
+  constexpr uint32_t BENCHMARK_RECORD_MATERIAL_COUNT = 1024;
+  constexpr uint32_t BENCHMARK_RECORD_MESH_COUNT = 256;
+  // GPUが何フレーム遅れてリストを返すか
+  constexpr uint64_t BENCHMARK_RECORD_FRAME_LATENCY = 2;
+
+  // --batchでメッシュを並べるシーンのオブジェクト数、メッシュ数、マテリアル数、フレーム数
+  constexpr uint32_t BENCHMARK_BATCH_OBJECT_COUNT = 100000;
+  constexpr uint32_t BENCHMARK_BATCH_MESH_COUNT = 64;
+  constexpr uint32_t BENCHMARK_BATCH_MATERIAL_COUNT = 16;
+  constexpr uint32_t BENCHMARK_BATCH_FRAME_COUNT = 20;
+
+  // --sortで並べ替える描画パケットの数と、パケット数によらず合計で並べ替えるキーの数(繰り返し回数を決める)
+  constexpr uint32_t BENCHMARK_SORT_PACKET_COUNTS[] = { 10000, 100000, 1000000 };
+  constexpr uint32_t BENCHMARK_SORT_TOTAL_KEY_COUNT = 5000000;
+  // 描画パケットのパス、ルートシグネチャー、パイプラインステート、マテリアル、メッシュの種類の数と半透明の割合(%)
+  constexpr uint32_t BENCHMARK_SORT_PASS_COUNT = 4;
+  constexpr uint32_t BENCHMARK_SORT_ROOT_SIGNATURE_COUNT = 4;
+  constexpr uint32_t BENCHMARK_SORT_PIPELINE_STATE_COUNT = 64;
+  constexpr uint32_t BENCHMARK_SORT_MATERIAL_COUNT = 1024;
+  constexpr uint32_t BENCHMARK_SORT_MESH_COUNT = 256;
+  constexpr uint32_t BENCHMARK_SORT_TRANSPARENT_PERCENT = 10;
+
+  // D3D12_RESOURCE_STATES / DXGI_FORMAT
+  constexpr MFramework::ResourceStates RESOURCE_STATE_PRESENT = 0x0;
+  constexpr MFramework::ResourceStates RESOURCE_STATE_RENDER_TARGET = 0x4;
+  constexpr MFramework::ResourceStates RESOURCE_STATE_PIXEL_SHADER_RESOURCE = 0x80;
+  constexpr uint32_t FORMAT_R16G16B16A16_FLOAT = 10;
+
+  struct BenchmarkOptions
+  {
+    bool IsGraph = false;
+    bool IsRecord = false;
+    bool IsBatch = false;
+    bool IsSort = false;
+    uint32_t JobCount = 0;
+  };
+
+  void PrintUsage()
+  {
+    std::printf("usage : RenderBenchmark [--jobs <n>] [--graph] [--record] [--batch] [--sort]\n"
+                "        runs every benchmark when none is selected\n"
+                "        --jobs sets the largest thread count measured, including the calling thread (default all hardware threads)\n"
+                "        --graph measures render graph declaration, cold compile and cached compile for 50 to 500 passes\n"
+                "        --record measures recording thousands of draws into pooled null command lists on 1 to --jobs threads\n"
+                "        --batch compares per object draws with draws batched by mesh and material on a null backend\n"
+                "        --sort measures radix sorting draw packet keys and the state changes before and after sorting\n");
+  }
+
+  bool ParseArguments(int argc, char** argv, BenchmarkOptions& outOptions)
+  {
+    bool isSelected = false;
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      const bool hasValue = (i + 1 < argc);
+
+      if (arg == "--jobs" && hasValue)
+      {
+        outOptions.JobCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--graph")
+      {
+        outOptions.IsGraph = true;
+        isSelected = true;
+      }
+      else if (arg == "--record")
+      {
+        outOptions.IsRecord = true;
+        isSelected = true;
+      }
+      else if (arg == "--batch")
+      {
+        outOptions.IsBatch = true;
+        isSelected = true;
+      }
+      else if (arg == "--sort")
+      {
+        outOptions.IsSort = true;
+        isSelected = true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    if (!isSelected)
+    {
+      outOptions.IsGraph = true;
+      outOptions.IsRecord = true;
+      outOptions.IsBatch = true;
+      outOptions.IsSort = true;
+    }
+
+    return true;
+  }
+
+  double ElapsedNanoseconds(std::chrono::steady_clock::time_point startTime)
+  {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+  }
+
+  /// @brief
+  /// ベンチマーク用のグラフで使う名前(宣言の時間に文字列の生成を含めないため先に作る)
+  struct GraphNames
+  {
+    std::vector<std::string> PassNames;
+    std::vector<std::string> ResourceNames;
+  };
+
+  GraphNames MakeGraphNames(uint32_t passCount)
+  {
+    GraphNames names{};
+    names.PassNames.reserve(passCount);
+    names.ResourceNames.reserve(passCount);
+    for (uint32_t i = 0; i < passCount; ++i)
+    {
+      names.PassNames.emplace_back("Pass" + std::to_string(i));
+      names.ResourceNames.emplace_back("Target" + std::to_string(i));
+    }
+
+    return names;
+  }
+
+  /// @brief
+  /// 一時レンダーターゲットをつないだグラフを宣言する
+  /// パスiは直前のパスとBENCHMARK_GRAPH_LONG_READ_DISTANCE個前のパスの出力を読んで自分のターゲットに書き込み、
+  /// 最後のパスがバックバッファに書き込む
+  /// BENCHMARK_GRAPH_UNUSED_PASS_INTERVALごとに、出力を誰も読まないパスを足す(コンパイルで削除される)
+  void DeclareGraph(MFramework::RenderGraph& graph, uint32_t passCount, const GraphNames& names)
+  {
+    using namespace MFramework;
+
+    const RenderGraphResourceHandle backBuffer = graph.ImportResource("BackBuffer", nullptr, RESOURCE_STATE_PRESENT, RESOURCE_STATE_PRESENT);
+
+    std::vector<RenderGraphResourceHandle> targets;
+    targets.reserve(passCount);
+    for (uint32_t i = 0; i < passCount; ++i)
+    {
+      // 大きさの違うターゲットを混ぜて配置を単純にしない
+      const uint32_t scale = 1u << (i % 3);
+      TransientResourceDesc desc{};
+      desc.Width = 1920 / scale;
+      desc.Height = 1080 / scale;
+      desc.Format = FORMAT_R16G16B16A16_FLOAT;
+      desc.Alignment = 65536;
+      desc.SizeInBytes = (static_cast<uint64_t>(desc.Width) * desc.Height * 8 + desc.Alignment - 1) / desc.Alignment * desc.Alignment;
+      targets.emplace_back(graph.CreateTransient(names.ResourceNames[i], desc));
+
+      const RenderGraphPassHandle pass = graph.AddPass(names.PassNames[i], {});
+      if (i > 0)
+      {
+        graph.Read(pass, targets[i - 1], RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+      }
+      if (i >= BENCHMARK_GRAPH_LONG_READ_DISTANCE)
+      {
+        graph.Read(pass, targets[i - BENCHMARK_GRAPH_LONG_READ_DISTANCE], RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+      }
+
+      if (i + 1 < passCount)
+      {
+        graph.Write(pass, targets[i], RESOURCE_STATE_RENDER_TARGET);
+      }
+      else
+      {
+        graph.Write(pass, backBuffer, RESOURCE_STATE_RENDER_TARGET);
+      }
+
+      if ((i % BENCHMARK_GRAPH_UNUSED_PASS_INTERVAL) == 0 && (i > 0))
+      {
+        const RenderGraphPassHandle unusedPass = graph.AddPass(names.PassNames[i], {});
+        graph.Read(unusedPass, targets[i - 1], RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        graph.Write(unusedPass, graph.CreateTransient(names.ResourceNames[i], desc), RESOURCE_STATE_RENDER_TARGET);
+      }
+    }
+  }
+
+  /// @brief
+  /// パスの数ごとにレンダーグラフの宣言と、初回(キャッシュなし)とキャッシュを使うコンパイルの時間を計る
+  void RunGraphBenchmark()
+  {
+    using namespace MFramework;
+
+    for (const uint32_t passCount : BENCHMARK_GRAPH_PASS_COUNTS)
+    {
+      const GraphNames names = MakeGraphNames(passCount);
+
+      // 毎回新しいグラフで宣言からコンパイルする
+      double coldDeclareTime = 0.0;
+      double coldCompileTime = 0.0;
+      bool isCompiled = true;
+      for (uint32_t repeat = 0; repeat < BENCHMARK_GRAPH_REPEAT_COUNT; ++repeat)
+      {
+        RenderGraph graph;
+        auto startTime = std::chrono::steady_clock::now();
+        DeclareGraph(graph, passCount, names);
+        coldDeclareTime += ElapsedNanoseconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        isCompiled &= graph.Compile();
+        coldCompileTime += ElapsedNanoseconds(startTime);
+      }
+
+      // 同じグラフで毎フレーム宣言し直す(構造が同じなのでコンパイルはキャッシュを使う)
+      RenderGraph graph;
+      DeclareGraph(graph, passCount, names);
+      isCompiled &= graph.Compile();
+      const CompiledRenderGraph compiled = graph.GetCompiled();
+
+      double cachedDeclareTime = 0.0;
+      double cachedCompileTime = 0.0;
+      for (uint32_t repeat = 0; repeat < BENCHMARK_GRAPH_REPEAT_COUNT; ++repeat)
+      {
+        graph.Reset();
+        auto startTime = std::chrono::steady_clock::now();
+        DeclareGraph(graph, passCount, names);
+        cachedDeclareTime += ElapsedNanoseconds(startTime);
+
+        startTime = std::chrono::steady_clock::now();
+        isCompiled &= graph.Compile();
+        cachedCompileTime += ElapsedNanoseconds(startTime);
+      }
+
+      std::printf("graph  : %3u passes, %3zu executed (%u culled), %u barriers, %u transients in %.1f MB\n",
+                  passCount,
+                  compiled.Passes.size(),
+                  compiled.CulledPassCount,
+                  compiled.BarrierCount,
+                  static_cast<uint32_t>(compiled.TransientAllocations.size()),
+                  static_cast<double>(compiled.TransientHeapSize) / (1024.0 * 1024.0));
+      std::printf("graph  : %3u passes, declare %.1f us, compile cold %.1f us, cached %.2f us (%llu / %u cache hits, declare %.1f us)%s\n",
+                  passCount,
+                  coldDeclareTime / BENCHMARK_GRAPH_REPEAT_COUNT / 1.0e3,
+                  coldCompileTime / BENCHMARK_GRAPH_REPEAT_COUNT / 1.0e3,
+                  cachedCompileTime / BENCHMARK_GRAPH_REPEAT_COUNT / 1.0e3,
+                  static_cast<unsigned long long>(graph.GetCacheHitCount()),
+                  BENCHMARK_GRAPH_REPEAT_COUNT,
+                  cachedDeclareTime / BENCHMARK_GRAPH_REPEAT_COUNT / 1.0e3,
+                  isCompiled ? "" : " (compile failed)");
+    }
+  }
+
+  /// @brief
+  /// 記録する描画一回分
+  struct RecordDraw
+  {
+    uint32_t RootSignature;
+    uint32_t PipelineState;
+    uint32_t Material;
+    uint32_t Mesh;
+    uint32_t InstanceCount;
+    uint64_t InstanceDataOffset;
+  };
+
+  /// @brief
+  /// [begin, end)の描画を一つのリストに記録する
+  /// リストは状態を引き継がないので、最初の描画ではすべて設定し、その後は変わったものだけ設定する
+  void RecordDraws(MFramework::NullCommandList& list, const std::vector<RecordDraw>& draws, size_t begin, size_t end)
+  {
+    const RecordDraw* previous = nullptr;
+    for (size_t i = begin; i < end; ++i)
+    {
+      const RecordDraw& draw = draws[i];
+      const bool isRootSignatureChanged = (previous == nullptr) || (draw.RootSignature != previous->RootSignature);
+      if (isRootSignatureChanged)
+      {
+        list.SetRootSignature(draw.RootSignature);
+      }
+      if (isRootSignatureChanged || (draw.PipelineState != previous->PipelineState))
+      {
+        list.SetPipelineState(draw.PipelineState);
+      }
+      if (isRootSignatureChanged || (draw.Material != previous->Material))
+      {
+        list.SetMaterial(draw.Material);
+      }
+      if ((previous == nullptr) || (draw.Mesh != previous->Mesh))
+      {
+        list.SetMesh(draw.Mesh);
+      }
+
+      list.Draw(draw.InstanceCount, draw.InstanceDataOffset);
+      previous = &draw;
+    }
+  }
+
+  /// @brief
+  /// 並べ替えた描画をBENCHMARK_RECORD_DRAWS_PER_LISTごとのリストに分け、スレッド数を変えて記録する時間を計る
+  /// リストはフレームの最後にフェンス値と一緒に退役させ、BENCHMARK_RECORD_FRAME_LATENCYフレーム後に再利用する
+  void RunRecordBenchmark(uint32_t maxThreadCount)
+  {
+    using namespace MFramework;
+
+    // 1, 2, 4, ...と最大のスレッド数
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+    {
+      threadCounts.emplace_back(threadCount);
+    }
+    threadCounts.emplace_back(maxThreadCount);
+
+    for (const uint32_t drawCount : BENCHMARK_RECORD_DRAW_COUNTS)
+    {
+      // マテリアルごとにパイプラインステート、パイプラインステートごとにルートシグネチャーが決まる
+      std::vector<RecordDraw> draws(drawCount);
+      uint32_t random = 1;
+      for (uint32_t i = 0; i < drawCount; ++i)
+      {
+        random = random * 1664525u + 1013904223u;
+        RecordDraw& draw = draws[i];
+        draw.Material = (random >> 8) % BENCHMARK_RECORD_MATERIAL_COUNT;
+        draw.PipelineState = draw.Material % BENCHMARK_RECORD_PIPELINE_STATE_COUNT;
+        draw.RootSignature = draw.PipelineState % BENCHMARK_RECORD_ROOT_SIGNATURE_COUNT;
+        random = random * 1664525u + 1013904223u;
+        draw.Mesh = (random >> 8) % BENCHMARK_RECORD_MESH_COUNT;
+        draw.InstanceCount = 1 + (random >> 28);
+        draw.InstanceDataOffset = static_cast<uint64_t>(i) * 256;
+      }
+
+      // 描画パケットを並べ替えた後と同じく、状態の順に並べてから記録する
+      std::sort(
+                draws.begin(),
+                draws.end(),
+                [](const RecordDraw& a, const RecordDraw& b)
+                {
+                  if (a.RootSignature != b.RootSignature)
+                  {
+                    return a.RootSignature < b.RootSignature;
+                  }
+                  if (a.PipelineState != b.PipelineState)
+                  {
+                    return a.PipelineState < b.PipelineState;
+                  }
+                  if (a.Material != b.Material)
+                  {
+                    return a.Material < b.Material;
+                  }
+
+                  return a.Mesh < b.Mesh;
+                }
+              );
+
+      const size_t listCount = (drawCount + BENCHMARK_RECORD_DRAWS_PER_LIST - 1) / BENCHMARK_RECORD_DRAWS_PER_LIST;
+      double singleTime = 0.0;
+      for (const uint32_t threadCount : threadCounts)
+      {
+        // 呼び出したスレッドも参加するので、ワーカーは一つ少なくする
+        ThreadPool threadPool;
+        if (threadCount > 1)
+        {
+          threadPool.Init(threadCount - 1);
+        }
+
+        NullCommandListPool listPool;
+        std::vector<NullCommandList*> lists(listCount, nullptr);
+        const auto recordLists = [&](size_t begin, size_t end)
+                                 {
+                                   for (size_t listIndex = begin; listIndex < end; ++listIndex)
+                                   {
+                                     const size_t drawBegin = listIndex * BENCHMARK_RECORD_DRAWS_PER_LIST;
+                                     const size_t drawEnd = std::min(drawBegin + BENCHMARK_RECORD_DRAWS_PER_LIST, draws.size());
+
+                                     NullCommandList* list = listPool.Acquire();
+                                     RecordDraws(*list, draws, drawBegin, drawEnd);
+                                     list->Close();
+
+                                     // リストの番号がそのまま実行順になる
+                                     lists[listIndex] = list;
+                                   }
+                                 };
+
+        uint64_t recordedDrawCount = 0;
+        size_t recordedSize = 0;
+        const auto startTime = std::chrono::steady_clock::now();
+        for (uint32_t frame = 0; frame < BENCHMARK_RECORD_FRAME_COUNT; ++frame)
+        {
+          // フレームframeはframe + 1をシグナルする
+          listPool.BeginFrame((frame >= BENCHMARK_RECORD_FRAME_LATENCY) ? frame - BENCHMARK_RECORD_FRAME_LATENCY + 1 : 0);
+          if (threadCount > 1)
+          {
+            threadPool.ParallelFor(listCount, recordLists);
+          }
+          else
+          {
+            recordLists(0, listCount);
+          }
+
+          // 実行順にサブミットしたとして数える
+          recordedDrawCount = 0;
+          recordedSize = 0;
+          for (const NullCommandList* list : lists)
+          {
+            recordedDrawCount += list->GetDrawCount();
+            recordedSize += list->GetSizeInBytes();
+          }
+          listPool.EndFrame(frame + 1);
+        }
+        const double frameTime = ElapsedNanoseconds(startTime) / BENCHMARK_RECORD_FRAME_COUNT;
+        if (threadCount == 1)
+        {
+          singleTime = frameTime;
+        }
+
+        std::printf("record : %5u draws in %3zu lists, %2u threads, %.3f ms/frame, %.1f Mdraw/s, x%.2f, %zu lists created, %.1f KB recorded%s\n",
+                    drawCount,
+                    listCount,
+                    threadCount,
+                    frameTime / 1.0e6,
+                    (frameTime > 0.0) ? drawCount / frameTime * 1.0e3 : 0.0,
+                    (frameTime > 0.0) ? singleTime / frameTime : 0.0,
+                    listPool.GetCreatedCount(),
+                    static_cast<double>(recordedSize) / 1024.0,
+                    (recordedDrawCount == drawCount) ? "" : " (draw count mismatch)");
+
+        threadPool.Dispose();
+      }
+    }
+  }
+
+  /// @brief
+  /// メッシュを並べたシーンで、オブジェクトごとの描画とメッシュとマテリアルでまとめた描画をNullバックエンドで比べる
+  void RunBatchBenchmark()
+  {
+    using namespace MFramework;
+
+    struct SceneObject
+    {
+      uint32_t Mesh;
+      uint32_t Material;
+      float World[16];
+    };
+
+    // シーンの走査順はメッシュやマテリアルと関係なく混ざっている
+    std::vector<SceneObject> objects(BENCHMARK_BATCH_OBJECT_COUNT);
+    uint32_t random = 1;
+    for (uint32_t i = 0; i < BENCHMARK_BATCH_OBJECT_COUNT; ++i)
+    {
+      random = random * 1664525u + 1013904223u;
+      SceneObject& object = objects[i];
+      object.Mesh = (random >> 8) % BENCHMARK_BATCH_MESH_COUNT;
+      object.Material = (random >> 20) % BENCHMARK_BATCH_MATERIAL_COUNT;
+
+      const float world[16] = {
+                                1.0f, 0.0f, 0.0f, 0.0f,
+                                0.0f, 1.0f, 0.0f, 0.0f,
+                                0.0f, 0.0f, 1.0f, 0.0f,
+                                static_cast<float>(i % 256), 0.0f, static_cast<float>(i / 256), 1.0f,
+                              };
+      std::copy(std::begin(world), std::end(world), object.World);
+    }
+
+    // 2フレーム分のインスタンスデータと、まとまりごとのアラインメントの余りが入る大きさにする
+    const uint64_t ringCapacity = 2ull * (BENCHMARK_BATCH_OBJECT_COUNT + BENCHMARK_BATCH_MESH_COUNT * BENCHMARK_BATCH_MATERIAL_COUNT) * sizeof(InstanceData);
+    NullInstanceDrawBackend backend;
+    backend.Init(ringCapacity);
+
+    // オブジェクトごとに描画する(インスタンス数1、データは同じリングに順に書く)
+    auto startTime = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < BENCHMARK_BATCH_FRAME_COUNT; ++frame)
+    {
+      backend.ResetCounters();
+      uint8_t* memory = backend.GetInstanceMemory() + (frame % 2) * (ringCapacity / 2);
+      for (uint32_t i = 0; i < BENCHMARK_BATCH_OBJECT_COUNT; ++i)
+      {
+        InstanceData* instance = reinterpret_cast<InstanceData*>(memory) + i;
+        std::copy(std::begin(objects[i].World), std::end(objects[i].World), instance->World);
+        instance->MaterialIndex = objects[i].Material;
+
+        const InstanceDrawCommand command = { objects[i].Mesh, objects[i].Material, 1, static_cast<uint64_t>(reinterpret_cast<uint8_t*>(instance) - backend.GetInstanceMemory()) };
+        backend.DrawInstanced(command);
+      }
+    }
+    const double directTime = ElapsedNanoseconds(startTime) / BENCHMARK_BATCH_FRAME_COUNT;
+    const uint64_t directDrawCount = backend.GetDrawCount();
+    const uint64_t directMeshChangeCount = backend.GetMeshChangeCount();
+    const uint64_t directMaterialChangeCount = backend.GetMaterialChangeCount();
+
+    // メッシュとマテリアルでまとめる(前のフレームのGPUは次のフレームの開始時に完了したとする)
+    InstanceBatcher batcher;
+    batcher.Init(&backend);
+    InstanceBatchStats batchStats{};
+    startTime = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < BENCHMARK_BATCH_FRAME_COUNT; ++frame)
+    {
+      backend.ResetCounters();
+      batcher.BeginFrame(frame);
+      for (const SceneObject& object : objects)
+      {
+        batcher.Submit(object.Mesh, object.Material, object.World, object.Material);
+      }
+      batchStats = batcher.Flush();
+      batcher.EndFrame(frame + 1);
+    }
+    const double batchTime = ElapsedNanoseconds(startTime) / BENCHMARK_BATCH_FRAME_COUNT;
+
+    std::printf("batch  : %u objects, %u meshes x %u materials, per object %llu draws, %llu mesh / %llu material changes, %.2f ms/frame\n",
+                BENCHMARK_BATCH_OBJECT_COUNT,
+                BENCHMARK_BATCH_MESH_COUNT,
+                BENCHMARK_BATCH_MATERIAL_COUNT,
+                static_cast<unsigned long long>(directDrawCount),
+                static_cast<unsigned long long>(directMeshChangeCount),
+                static_cast<unsigned long long>(directMaterialChangeCount),
+                directTime / 1.0e6);
+    std::printf("batch  : batched %llu draws (%u dropped), %llu mesh / %llu material changes, %.2f ms/frame (%.1f Minst/s)\n",
+                static_cast<unsigned long long>(backend.GetDrawCount()),
+                batchStats.DroppedCount,
+                static_cast<unsigned long long>(backend.GetMeshChangeCount()),
+                static_cast<unsigned long long>(backend.GetMaterialChangeCount()),
+                batchTime / 1.0e6,
+                (batchTime > 0.0) ? BENCHMARK_BATCH_OBJECT_COUNT / batchTime * 1.0e3 : 0.0);
+  }
+
+  /// @brief
+  /// ランダムな描画パケットのソートキーで基数ソートの速度を計り、並べ替えの前後で状態の切り替え回数をNullバックエンドで比べる
+  void RunSortBenchmark(MFramework::ThreadPool& threadPool)
+  {
+    using namespace MFramework;
+
+    for (const uint32_t packetCount : BENCHMARK_SORT_PACKET_COUNTS)
+    {
+      // マテリアルごとにパイプラインステート、パイプラインステートごとにルートシグネチャーが決まる
+      DrawPacketQueue queue;
+      queue.Reserve(packetCount);
+      std::vector<RadixSortItem> sourceItems(packetCount);
+      uint32_t random = 1;
+      for (uint32_t i = 0; i < packetCount; ++i)
+      {
+        random = random * 1664525u + 1013904223u;
+        const uint32_t material = (random >> 8) % BENCHMARK_SORT_MATERIAL_COUNT;
+        const uint32_t pipelineState = material % BENCHMARK_SORT_PIPELINE_STATE_COUNT;
+        const uint32_t pass = (random >> 20) % BENCHMARK_SORT_PASS_COUNT;
+        random = random * 1664525u + 1013904223u;
+        const DrawBucket bucket = ((random >> 8) % 100 < BENCHMARK_SORT_TRANSPARENT_PERCENT) ? DrawBucket::Transparent : DrawBucket::Opaque;
+        const uint32_t mesh = (random >> 16) % BENCHMARK_SORT_MESH_COUNT;
+        random = random * 1664525u + 1013904223u;
+        const float depth = static_cast<float>(random >> 8) / static_cast<float>(1u << 24);
+
+        const uint32_t rootSignature = pipelineState % BENCHMARK_SORT_ROOT_SIGNATURE_COUNT;
+        const uint64_t sortKey = DrawSortKey::Make(pass, bucket, rootSignature, pipelineState, material, depth);
+        sourceItems[i] = RadixSortItem{ sortKey, i, 0 };
+        queue.Submit(sortKey, DrawPacket{ rootSignature, pipelineState, material, mesh, 1, 0, 0 });
+      }
+
+      // 毎回同じ並びから並べ替える(元に戻すコピーは時間に含めない)
+      const uint32_t repeatCount = std::max(BENCHMARK_SORT_TOTAL_KEY_COUNT / packetCount, 1u);
+      std::vector<RadixSortItem> items(packetCount);
+      std::vector<RadixSortItem> tempItems(packetCount);
+      const auto measure = [&](const auto& sortFunc)
+                           {
+                             double time = 0.0;
+                             for (uint32_t repeat = 0; repeat < repeatCount; ++repeat)
+                             {
+                               std::copy(sourceItems.begin(), sourceItems.end(), items.begin());
+                               const auto startTime = std::chrono::steady_clock::now();
+                               sortFunc();
+                               time += ElapsedNanoseconds(startTime);
+                             }
+                             return (time > 0.0) ? static_cast<double>(packetCount) * repeatCount / time * 1.0e3 : 0.0;
+                           };
+
+      const double singleRate = measure([&]() { RadixSort::Sort(items.data(), items.size(), tempItems.data()); });
+      const double poolRate = measure([&]() { RadixSort::Sort(items.data(), items.size(), tempItems.data(), &threadPool); });
+      const std::vector<RadixSortItem> radixItems = items;
+      const double stdRate = measure(
+                                      [&]()
+                                      {
+                                        std::sort(items.begin(), items.end(), [](const RadixSortItem& a, const RadixSortItem& b) { return a.Key < b.Key; });
+                                      }
+                                    );
+      const bool isMatched = std::equal(items.begin(), items.end(), radixItems.begin(), [](const RadixSortItem& a, const RadixSortItem& b) { return a.Key == b.Key; });
+
+      std::printf("sort   : %7u packets, radix %.1f Mkey/s with 1 thread, %.1f Mkey/s with %u threads, std::sort %.1f Mkey/s%s\n",
+                  packetCount,
+                  singleRate,
+                  poolRate,
+                  threadPool.GetThreadCount() + 1,
+                  stdRate,
+                  isMatched ? "" : " (order mismatch)");
+
+      // Submitした順と並べ替えた後で、命令にするときの状態の切り替え回数を比べる
+      NullInstanceDrawBackend backend;
+      const DrawPacketStats unsortedStats = queue.Translate(backend);
+      queue.Sort(&threadPool);
+      const DrawPacketStats sortedStats = queue.Translate(backend);
+      std::printf("sort   : %7u packets, root signature / pso / material / mesh changes, submitted %u / %u / %u / %u, sorted %u / %u / %u / %u\n",
+                  packetCount,
+                  unsortedStats.RootSignatureChangeCount,
+                  unsortedStats.PipelineStateChangeCount,
+                  unsortedStats.MaterialChangeCount,
+                  unsortedStats.MeshChangeCount,
+                  sortedStats.RootSignatureChangeCount,
+                  sortedStats.PipelineStateChangeCount,
+                  sortedStats.MaterialChangeCount,
+                  sortedStats.MeshChangeCount);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MFramework;
+
+  BenchmarkOptions options{};
+  if (!ParseArguments(argc, argv, options))
+  {
+    PrintUsage();
+    return 2;
+  }
+
+  if (options.IsGraph)
+  {
+    RunGraphBenchmark();
+  }
+
+  const uint32_t maxThreadCount = (options.JobCount > 0) ? options.JobCount : std::max(std::thread::hardware_concurrency(), 1u);
+  if (options.IsRecord)
+  {
+    RunRecordBenchmark(maxThreadCount);
+  }
+
+  if (options.IsBatch)
+  {
+    RunBatchBenchmark();
+  }
+
+  if (options.IsSort)
+  {
+    // 呼び出したスレッドも参加するので、ワーカーは一つ少なくする
+    ThreadPool threadPool;
+    if (maxThreadCount > 1)
+    {
+      threadPool.Init(maxThreadCount - 1);
+    }
+
+    RunSortBenchmark(threadPool);
+    threadPool.Dispose();
+  }
+
+  return 0;
+}
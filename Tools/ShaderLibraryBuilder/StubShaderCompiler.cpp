@@ -0,0 +1,60 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Stand-in shader compiler for builds without FXC (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#include "StubShaderCompiler.h"
+
+#include <cstring>
+
+namespace
+{
+  constexpr uint32_t STUB_BYTECODE_MAGIC = 0x4254534d;    // "MSTB"
+
+  void AppendString(std::vector<uint8_t>& outBytes, const std::string& str)
+  {
+    outBytes.insert(outBytes.end(), str.begin(), str.end());
+    outBytes.push_back('\0');
+  }
+}
+
+namespace MFramework
+{
+  const char* StubShaderCompiler::GetName() const
+  {
+    return "stub";
+  }
+
+  bool StubShaderCompiler::Compile(const ShaderCompileDesc& desc, const PreprocessedShader& preprocessed, std::vector<uint8_t>& outBytecode, std::string& outError) const
+  {
+    // エントリーポイントがソースにない場合は本物のコンパイラーと同じく失敗させる
+    if (preprocessed.Source.find(desc.EntryPoint) == std::string::npos)
+    {
+      outError = "entry point not found : " + desc.EntryPoint;
+      return false;
+    }
+
+    outBytecode.resize(sizeof(STUB_BYTECODE_MAGIC));
+    std::memcpy(outBytecode.data(), &STUB_BYTECODE_MAGIC, sizeof(STUB_BYTECODE_MAGIC));
+
+    AppendString(outBytecode, desc.EntryPoint);
+    AppendString(outBytecode, desc.Target);
+    for (const ShaderDefine& define : desc.Defines)
+    {
+      AppendString(outBytecode, define.Name + "=" + define.Value);
+    }
+    AppendString(outBytecode, preprocessed.Source);
+
+    return true;
+  }
+}
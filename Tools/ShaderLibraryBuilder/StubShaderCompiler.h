@@ -0,0 +1,39 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Stand-in shader compiler for builds without FXC (Device independent)
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+#pragma once
+
+#ifndef M_STUB_SHADER_COMPILER
+#define M_STUB_SHADER_COMPILER
+
+#include <Interfaces/IShaderCompiler.h>
+
+namespace MFramework
+{
+  inline namespace MGraphics_DX12
+  {
+    /// @brief
+    /// 実際にはコンパイルせず、入力から決定的なバイト列を作る代替コンパイラー
+    /// FXCのない環境(Linuxなど)でビルドの流れとライブラリ形式を確認するために使う
+    class StubShaderCompiler final : public IShaderCompiler
+    {
+      public:
+        const char* GetName(void) const override;
+        bool Compile(const ShaderCompileDesc& desc, const PreprocessedShader& preprocessed, std::vector<uint8_t>& outBytecode, std::string& outError) const override;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,200 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline shader library builder
+
+Update History: 2026/10/19 Create
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+// 使い方
+// ShaderLibraryBuilder [--source <dir>] [--output <file>] [--include <dir>]...
+//                      [--cache <dir>] [--jobs <n>] [--compiler fxc|stub] [--debug]
+//
+// sourceディレクトリ以下の.hlslから//!宣言を読み取り、
+// パーミュテーションをすべて並列にコンパイルして一つのライブラリファイルに書き出す
+//   //! shader BasicVS vs_5_1
+//   //! permutation USE_FOG 0 1
+
+#include <Graphics_DX12/ShaderPermutationBuilder.h>
+#include <ThreadPool.h>
+
+#include "StubShaderCompiler.h"
+
+#ifdef _WIN32
+  #include <Graphics_DX12/D3DShaderCompiler.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr uint32_t D3DCOMPILE_DEBUG_FLAGS = (1 << 0) | (1 << 2);    // D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION
+  constexpr uint32_t D3DCOMPILE_RELEASE_FLAGS = (1 << 15);            // D3DCOMPILE_OPTIMIZATION_LEVEL3
+
+  struct BuilderOptions
+  {
+    std::string SourceDir = "Shaders/HLSLs";
+    std::string OutputPath = "Shaders/ShaderLibrary.bin";
+    std::vector<std::string> IncludeDirs;
+    std::string CacheDir;
+    std::string CompilerName;
+    uint32_t JobCount = 0;
+    bool IsDebug = false;
+  };
+
+  void PrintUsage()
+  {
+    std::printf("usage : ShaderLibraryBuilder [--source <dir>] [--output <file>] [--include <dir>]...\n"
+                "                             [--cache <dir>] [--jobs <n>] [--compiler fxc|stub] [--debug]\n");
+  }
+
+  bool ParseArguments(int argc, char** argv, BuilderOptions& outOptions)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      const bool hasValue = (i + 1 < argc);
+
+      if (arg == "--source" && hasValue)
+      {
+        outOptions.SourceDir = argv[++i];
+      }
+      else if (arg == "--output" && hasValue)
+      {
+        outOptions.OutputPath = argv[++i];
+      }
+      else if (arg == "--include" && hasValue)
+      {
+        outOptions.IncludeDirs.emplace_back(argv[++i]);
+      }
+      else if (arg == "--cache" && hasValue)
+      {
+        outOptions.CacheDir = argv[++i];
+      }
+      else if (arg == "--jobs" && hasValue)
+      {
+        outOptions.JobCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--compiler" && hasValue)
+      {
+        outOptions.CompilerName = argv[++i];
+      }
+      else if (arg == "--debug")
+      {
+        outOptions.IsDebug = true;
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  std::unique_ptr<MFramework::IShaderCompiler> CreateCompiler(const std::string& name)
+  {
+    #ifdef _WIN32
+      if (name.empty() || name == "fxc")
+      {
+        return std::make_unique<MFramework::D3DShaderCompiler>();
+      }
+    #endif
+
+    // FXCのない環境では代替コンパイラーを既定にする
+    if (name.empty() || name == "stub")
+    {
+      return std::make_unique<MFramework::StubShaderCompiler>();
+    }
+
+    return nullptr;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MFramework;
+
+  BuilderOptions options{};
+  if (!ParseArguments(argc, argv, options))
+  {
+    PrintUsage();
+    return 2;
+  }
+
+  std::unique_ptr<IShaderCompiler> compiler = CreateCompiler(options.CompilerName);
+  if (compiler == nullptr)
+  {
+    std::fprintf(stderr, "unknown compiler : %s\n", options.CompilerName.c_str());
+    return 2;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // ソースのディレクトリは常にインクルード対象にする
+  std::vector<std::string> includeDirs = options.IncludeDirs;
+  includeDirs.emplace_back(options.SourceDir);
+
+  ShaderCompileCache cache;
+  ShaderPermutationBuilder builder;
+  builder.SetIncludeDirs(includeDirs);
+  builder.SetCompileFlags(options.IsDebug ? D3DCOMPILE_DEBUG_FLAGS : D3DCOMPILE_RELEASE_FLAGS);
+  if (!options.CacheDir.empty() && cache.Init(options.CacheDir))
+  {
+    builder.SetCache(&cache);
+  }
+
+  // 宣言が不正なファイルがあってもほかのエラーをまとめて出すために最後まで続ける
+  bool isSucceeded = builder.ScanDirectory(options.SourceDir);
+
+  ThreadPool threadPool;
+  threadPool.Init(options.JobCount);
+  const uint32_t threadCount = threadPool.GetThreadCount() + 1;   // 呼び出したスレッドも参加する
+
+  ShaderLibraryWriter writer;
+  isSucceeded &= builder.Build(*compiler, &threadPool, writer);
+  threadPool.Dispose();
+
+  for (const std::string& error : builder.GetErrors())
+  {
+    std::fprintf(stderr, "%s\n", error.c_str());
+  }
+
+  if (!isSucceeded)
+  {
+    std::fprintf(stderr, "build failed\n");
+    return 1;
+  }
+
+  if (!writer.WriteToFile(options.OutputPath))
+  {
+    std::fprintf(stderr, "cannot write : %s\n", options.OutputPath.c_str());
+    return 1;
+  }
+
+  const ShaderLibraryBuildStats& stats = builder.GetStats();
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+  std::printf("%s : %u sources, %u permutations (%u compiled, %u cached) -> %s (%lld ms, %u threads)\n",
+              compiler->GetName(),
+              stats.SourceCount,
+              stats.PermutationCount,
+              stats.CompiledCount,
+              stats.CacheHitCount,
+              options.OutputPath.c_str(),
+              static_cast<long long>(elapsed.count()),
+              threadCount);
+
+  return 0;
+}
@@ -0,0 +1,370 @@
+/*
+
+MRenderFramework
+Author : MAI ZHICONG
+
+Description : Offline texture cooker
+
+Update History: 2026/10/19 Create
+                2026/10/19 Block compression (BC1/BC3/BC5/BC7) and DDS output
+
+Version : alpha_1.0.0
+
+Encoding : UTF-8 
+
+*/
+
+// 使い方
+// TextureCooker [--output <dir>] [--mips <n>] [--filter box|kaiser] [--srgb]
+//               [--alpha-coverage <ref>] [--compress bc1|bc3|bc5|bc7] [--quality fast|normal|high]
+//               [--container mtex|dds] [--psnr] [--jobs <n>] <input.png>...
+//
+// PNGを読み込んでミップチェーンを生成し、GetCopyableFootprintsの配置に並べた.mtexとして書き出す
+// 実行時はデータをアップロードバッファーへ一回コピーするだけでよい
+// --compressを指定するとミップ生成の後にブロック圧縮する(--psnrで圧縮前との誤差を表示する)
+// --container ddsにするとDirectXTexなど他のツールでも読める.ddsとして書き出す
+
+#include <RenderSystem/BlockCompressor.h>
+#include <RenderSystem/CookedTextureFormat.h>
+#include <RenderSystem/DdsFormat.h>
+#include <RenderSystem/MipGenerator.h>
+#include <RenderSystem/PngTextureDecoder.h>
+#include <ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr const char* COOKED_TEXTURE_EXTENSION = ".mtex";
+  constexpr const char* DDS_TEXTURE_EXTENSION = ".dds";
+
+  struct CookerOptions
+  {
+    std::vector<std::string> InputPaths;
+    std::string OutputDir;
+    MFramework::MipGenerateDesc MipDesc{};
+    MFramework::BlockCompressDesc CompressDesc{ MFramework::BlockCompressFormat::BC7, MFramework::BlockCompressQuality::Normal, false };
+    bool IsCompress = false;
+    bool IsDdsContainer = false;
+    bool IsPrintPSNR = false;
+    uint32_t JobCount = 0;
+  };
+
+  struct CookResult
+  {
+    uint64_t Size;
+    double CompressMilliseconds;
+    double PSNR;
+  };
+
+  void PrintUsage()
+  {
+    std::printf("usage : TextureCooker [--output <dir>] [--mips <n>] [--filter box|kaiser] [--srgb]\n"
+                "                      [--alpha-coverage <ref>] [--compress bc1|bc3|bc5|bc7] [--quality fast|normal|high]\n"
+                "                      [--container mtex|dds] [--psnr] [--jobs <n>] <input.png>...\n"
+                "        --mips 0 generates the full chain (default), 1 keeps only the top level\n"
+                "        --compress requires the top level width and height to be multiples of 4\n");
+  }
+
+  bool ParseArguments(int argc, char** argv, CookerOptions& outOptions)
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string arg = argv[i];
+      const bool hasValue = (i + 1 < argc);
+
+      if (arg == "--output" && hasValue)
+      {
+        outOptions.OutputDir = argv[++i];
+      }
+      else if (arg == "--mips" && hasValue)
+      {
+        outOptions.MipDesc.MipLevels = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (arg == "--filter" && hasValue)
+      {
+        const std::string filter = argv[++i];
+        if (filter == "box")
+        {
+          outOptions.MipDesc.Filter = MFramework::MipFilter::Box;
+        }
+        else if (filter == "kaiser")
+        {
+          outOptions.MipDesc.Filter = MFramework::MipFilter::Kaiser;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--srgb")
+      {
+        outOptions.MipDesc.IsSRGB = true;
+        outOptions.CompressDesc.IsSRGB = true;
+      }
+      else if (arg == "--alpha-coverage" && hasValue)
+      {
+        outOptions.MipDesc.IsPreserveAlphaCoverage = true;
+        outOptions.MipDesc.AlphaReference = std::strtof(argv[++i], nullptr);
+      }
+      else if (arg == "--compress" && hasValue)
+      {
+        const std::string format = argv[++i];
+        outOptions.IsCompress = true;
+        if (format == "bc1")
+        {
+          outOptions.CompressDesc.Format = MFramework::BlockCompressFormat::BC1;
+        }
+        else if (format == "bc3")
+        {
+          outOptions.CompressDesc.Format = MFramework::BlockCompressFormat::BC3;
+        }
+        else if (format == "bc5")
+        {
+          outOptions.CompressDesc.Format = MFramework::BlockCompressFormat::BC5;
+        }
+        else if (format == "bc7")
+        {
+          outOptions.CompressDesc.Format = MFramework::BlockCompressFormat::BC7;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--quality" && hasValue)
+      {
+        const std::string quality = argv[++i];
+        if (quality == "fast")
+        {
+          outOptions.CompressDesc.Quality = MFramework::BlockCompressQuality::Fast;
+        }
+        else if (quality == "normal")
+        {
+          outOptions.CompressDesc.Quality = MFramework::BlockCompressQuality::Normal;
+        }
+        else if (quality == "high")
+        {
+          outOptions.CompressDesc.Quality = MFramework::BlockCompressQuality::High;
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--container" && hasValue)
+      {
+        const std::string container = argv[++i];
+        if (container == "mtex" || container == "dds")
+        {
+          outOptions.IsDdsContainer = (container == "dds");
+        }
+        else
+        {
+          return false;
+        }
+      }
+      else if (arg == "--psnr")
+      {
+        outOptions.IsPrintPSNR = true;
+      }
+      else if (arg == "--jobs" && hasValue)
+      {
+        outOptions.JobCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+      }
+      else if (!arg.empty() && arg[0] != '-')
+      {
+        outOptions.InputPaths.emplace_back(arg);
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return !outOptions.InputPaths.empty();
+  }
+
+  // パスはUTF-8として扱う(MappedFileと同じ)
+  std::filesystem::path ToPath(const std::string& utf8Path)
+  {
+    return std::filesystem::path(std::u8string(utf8Path.begin(), utf8Path.end()));
+  }
+
+  std::string GetOutputPath(const std::string& inputPath, const std::string& outputDir, bool isDdsContainer)
+  {
+    std::filesystem::path path = ToPath(inputPath);
+    if (!outputDir.empty())
+    {
+      path = ToPath(outputDir) / path.filename();
+    }
+    path.replace_extension(isDdsContainer ? DDS_TEXTURE_EXTENSION : COOKED_TEXTURE_EXTENSION);
+
+    const std::u8string utf8Path = path.u8string();
+    return std::string(utf8Path.begin(), utf8Path.end());
+  }
+
+  bool CookTexture(const std::string& inputPath, const std::string& outputPath, const CookerOptions& options, MFramework::ThreadPool* threadPool, CookResult& outResult, std::string& outError)
+  {
+    using namespace MFramework;
+
+    const MipGenerateDesc& mipDesc = options.MipDesc;
+
+    TextureData source{};
+    if (!PngTextureDecoder{}.Decode(inputPath, source, outError))
+    {
+      return false;
+    }
+
+    TextureData mipData{};
+    const TextureData* cookSource = &source;
+    if (mipDesc.MipLevels != 1)
+    {
+      if (!MipGenerator::Generate(source, mipDesc, mipData, outError, threadPool))
+      {
+        return false;
+      }
+      cookSource = &mipData;
+    }
+
+    outResult.CompressMilliseconds = 0.0;
+    outResult.PSNR = 0.0;
+
+    // ミップはすべて圧縮前の画素から生成してから圧縮する(圧縮した画像を縮小すると誤差が重なる)
+    TextureData compressedData{};
+    if (options.IsCompress)
+    {
+      const auto compressStartTime = std::chrono::steady_clock::now();
+      if (!BlockCompressor::Compress(*cookSource, options.CompressDesc, compressedData, outError, threadPool))
+      {
+        return false;
+      }
+      outResult.CompressMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compressStartTime).count();
+
+      if (options.IsPrintPSNR && !BlockCompressor::ComputePSNR(*cookSource, compressedData, outResult.PSNR, outError))
+      {
+        return false;
+      }
+
+      cookSource = &compressedData;
+    }
+
+    std::vector<uint8_t> file;
+    if (options.IsDdsContainer)
+    {
+      if (!DdsFormat::Serialize(*cookSource, file, outError) || !DdsFormat::WriteToFile(outputPath, file))
+      {
+        outError = "cannot write " + outputPath + " " + outError;
+        return false;
+      }
+
+      outResult.Size = file.size();
+      return true;
+    }
+
+    if (!CookedTextureFormat::Serialize(*cookSource, file, outError))
+    {
+      return false;
+    }
+
+    // 実行時と同じ検証を通ることを確認してから書き出す
+    CookedTextureView view{};
+    if (!CookedTextureFormat::Parse(file.data(), file.size(), view, outError, true))
+    {
+      return false;
+    }
+
+    if (!CookedTextureFormat::WriteToFile(outputPath, file))
+    {
+      outError = "cannot write " + outputPath;
+      return false;
+    }
+
+    outResult.Size = file.size();
+    return true;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  using namespace MFramework;
+
+  CookerOptions options{};
+  if (!ParseArguments(argc, argv, options))
+  {
+    PrintUsage();
+    return 2;
+  }
+
+  if (!options.OutputDir.empty())
+  {
+    std::error_code error;
+    std::filesystem::create_directories(ToPath(options.OutputDir), error);
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+
+  ThreadPool threadPool;
+  threadPool.Init(options.JobCount);
+  const uint32_t threadCount = threadPool.GetThreadCount() + 1;   // 呼び出したスレッドも参加する
+
+  // ファイル単位で並列に処理し、ミップ生成の中でも同じプールを使う(ParallelForは入れ子にできる)
+  std::mutex logMutex;
+  std::atomic<uint32_t> failedCount = 0;
+  std::atomic<uint64_t> totalSize = 0;
+  threadPool.ParallelFor(
+                          options.InputPaths.size(),
+                          [&](size_t begin, size_t end)
+                          {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                              const std::string& inputPath = options.InputPaths[i];
+                              const std::string outputPath = GetOutputPath(inputPath, options.OutputDir, options.IsDdsContainer);
+
+                              CookResult result{};
+                              std::string error;
+                              const bool isSucceeded = CookTexture(inputPath, outputPath, options, &threadPool, result, error);
+
+                              std::lock_guard<std::mutex> lock(logMutex);
+                              if (isSucceeded)
+                              {
+                                totalSize += result.Size;
+                                std::printf("%s -> %s (%llu bytes)", inputPath.c_str(), outputPath.c_str(), static_cast<unsigned long long>(result.Size));
+                                if (options.IsCompress)
+                                {
+                                  std::printf(" encode %.1f ms", result.CompressMilliseconds);
+                                }
+                                if (options.IsCompress && options.IsPrintPSNR)
+                                {
+                                  std::printf(" PSNR %.2f dB", result.PSNR);
+                                }
+                                std::printf("\n");
+                              }
+                              else
+                              {
+                                ++failedCount;
+                                std::fprintf(stderr, "%s : %s\n", inputPath.c_str(), error.c_str());
+                              }
+                            }
+                          }
+                        );
+
+  threadPool.Dispose();
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+  std::printf("%zu textures (%u failed), %llu bytes (%lld ms, %u threads)\n",
+              options.InputPaths.size(),
+              failedCount.load(),
+              static_cast<unsigned long long>(totalSize.load()),
+              static_cast<long long>(elapsed.count()),
+              threadCount);
+
+  return (failedCount.load() == 0) ? 0 : 1;
+}